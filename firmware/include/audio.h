@@ -1,5 +1,6 @@
 #pragma once
 #include <Arduino.h>
+#include "plugin_api.h"
 
 bool audioInit();
 void audioSetPlaying(bool play);
@@ -7,4 +8,19 @@ bool audioIsPlaying();
 void audioSetVolume(int percent);
 int audioGetVolume();
 
+// Shared by the WAV/MP3 front-ends; playback itself runs on the audio engine task
+bool audioIsDecoderPlaying(const char* decoder);
+bool audioStartFirstUnderMusic(const char* extension);
+bool audioSkipNext();                   // Next file of the album playing under /Music
+void audioPoll();                       // Menu task: queues the album's next file after a track change
+void audioSetCrossfade(bool on);        // Fade between tracks instead of cutting
+bool audioGetCrossfade();
+const char* audioCycleReplayGain();    // off -> track -> album; returns the new mode
+bool audioStartLoudnessScan();          // Measure /Music tracks with no ReplayGain yet, between playback
 
+// Short synth sounds mixed over whatever plays; never stop the music
+bool audioBeep(uint16_t frequency, uint32_t durationMs);
+void audioClick();                      // Menu navigation tick
+
+// Output deadline monitor for plugins; reset starts a new window after the read
+bool audioGetDeadlineStats(plugin_audio_deadline_t* stats, bool reset);
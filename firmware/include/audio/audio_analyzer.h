@@ -0,0 +1,82 @@
+/*
+ * Audio Analyzer
+ * Spectrum, peak and RMS metering tapped from the engine's output blocks
+ *
+ * The audio task feeds every block: a mono downmix, decimated by an integer
+ * factor, goes into a small capture ring while peak and power accumulate.
+ * Only AUDIO_ANALYZER_RATE_HZ times a second does it window the newest
+ * fft_size samples, run a fixed-point radix-2 FFT and fold the bins into
+ * AUDIO_ANALYZER_BANDS log-spaced bands. Each result is published into one
+ * of two slots guarded by a sequence counter, so readers (the UI) never
+ * block the audio task and simply retry if a publish overtook them.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <atomic>
+
+#define AUDIO_ANALYZER_BANDS        32
+#define AUDIO_ANALYZER_MIN_FFT      64
+#define AUDIO_ANALYZER_MAX_FFT      1024
+#define AUDIO_ANALYZER_DEFAULT_FFT  512
+#define AUDIO_ANALYZER_RATE_HZ      30      // Spectra per second of audio
+#define AUDIO_ANALYZER_FLOOR_DB     -72.0f  // Band level 0.0; 0 dBFS is 1.0
+#define AUDIO_ANALYZER_LOW_HZ       40.0f   // Lower edge of the first band
+
+// One published analysis. Levels are 0.0-1.0: bands on a dB scale from
+// AUDIO_ANALYZER_FLOOR_DB, peak and RMS linear in full scale.
+typedef struct {
+    float bands[AUDIO_ANALYZER_BANDS];
+    float peak;
+    float rms;
+    uint32_t sequence;                      // Increments with every publish
+} audio_analyzer_frame_t;
+
+typedef struct {
+    uint32_t sample_rate;
+    uint32_t fft_size;                      // Power of two
+    uint32_t log2_size;
+    uint32_t decimation;                    // Input frames per captured sample
+    uint32_t frames_per_update;
+
+    // Audio task only
+    int16_t* capture;                       // fft_size mono samples, circular
+    uint32_t capture_pos;
+    int32_t decimate_sum;
+    uint32_t decimate_count;
+    uint32_t frames_until_update;
+    int32_t peak;
+    uint64_t power;                         // Sum of squares since the last publish
+    uint32_t power_count;
+    int16_t* window;                        // Hann, Q15
+    int32_t* twiddle;                       // fft_size / 2 cos/sin pairs, Q30
+    int32_t* re;
+    int32_t* im;
+    uint16_t band_lo[AUDIO_ANALYZER_BANDS]; // First FFT bin of each band
+    uint16_t band_hi[AUDIO_ANALYZER_BANDS]; // One past the last
+    uint32_t published;                     // Publishes so far
+
+    // Double buffer: slot (sequence & 1) holds the newest frame
+    audio_analyzer_frame_t slots[2];
+    std::atomic<uint32_t> slot_seq[2];      // Odd while the slot is being written
+    std::atomic<uint32_t> sequence;
+} audio_analyzer_t;
+
+// Lifecycle. fft_size is a power of two from MIN_FFT to MAX_FFT (0 = default);
+// decimation is 1 or more (0 = 1).
+bool audio_analyzer_init(audio_analyzer_t* an, uint32_t sample_rate, uint32_t fft_size, uint32_t decimation);
+void audio_analyzer_deinit(audio_analyzer_t* an);
+
+// Audio task
+void audio_analyzer_feed(audio_analyzer_t* an, const int16_t* frames, uint32_t frame_count);  // Stereo
+void audio_analyzer_analyze(audio_analyzer_t* an);      // Run and publish one analysis now
+void audio_analyzer_clear(audio_analyzer_t* an);        // Publish silence (playback stopped)
+
+// Any task; never blocks. False until the first publish.
+bool audio_analyzer_read(audio_analyzer_t* an, audio_analyzer_frame_t* frame);
+
+// In-place fixed-point FFT of n = 1 << log2_n points; output scaled by 1/n
+void audio_analyzer_fft(int32_t* re, int32_t* im, const int32_t* twiddle, uint32_t log2_n);
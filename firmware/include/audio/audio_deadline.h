@@ -0,0 +1,70 @@
+/*
+ * Audio Deadline Monitor
+ * Lock-free histograms of output refill timing, kept by the I2S feeder or host sink
+ *
+ * At every refill of the output (one DMA buffer on the ESP32, one period on
+ * host) the consumer records how much audio was still queued ahead of the DAC
+ * and how long it has been since the previous refill. A refill that comes
+ * after the DAC ran dry is a deadline miss. Both are binned on a log2 scale
+ * of microseconds, so a UI action that stalls the audio tasks shows up as a
+ * tail in the slack histogram long before it turns into an audible dropout.
+ *
+ * Only the consumer writes; any task may read or ask for a reset, which the
+ * consumer applies at its next refill. Nothing takes a lock.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <atomic>
+#include "hal/hal_audio.h"
+
+#define AUDIO_DEADLINE_BINS     HAL_AUDIO_DEADLINE_BINS
+#define AUDIO_DEADLINE_BIN0_US  HAL_AUDIO_DEADLINE_BIN0_US
+
+typedef struct {
+    uint32_t period_frames;                 // One refill's worth of audio
+    std::atomic<uint32_t> sample_rate;      // Follows the output clock
+
+    // Consumer writes, any task reads
+    std::atomic<uint32_t> periods;
+    std::atomic<uint32_t> misses;
+    std::atomic<uint32_t> min_slack_us;
+    std::atomic<uint32_t> max_interval_us;
+    std::atomic<uint32_t> slack_bins[AUDIO_DEADLINE_BINS];
+    std::atomic<uint32_t> interval_bins[AUDIO_DEADLINE_BINS];
+    std::atomic<bool> reset_request;
+
+    // Consumer only
+    uint64_t last_refill_us;
+    bool primed;                            // A refill since the output last went idle
+} audio_deadline_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void audio_deadline_init(audio_deadline_t* deadline, uint32_t sample_rate, uint32_t period_frames);
+void audio_deadline_set_rate(audio_deadline_t* deadline, uint32_t sample_rate);    // Any task
+
+// Consumer side. queued_frames is the audio ahead of the DAC at the refill,
+// the refill itself included; a missed refill counts as zero slack. The first
+// refill after audio_deadline_idle() starts a new stream: it can be neither
+// late nor the end of an interval.
+void audio_deadline_record(audio_deadline_t* deadline, uint64_t now_us, uint32_t queued_frames, bool missed);
+void audio_deadline_idle(audio_deadline_t* deadline);     // Output stopped or flushed
+
+// Any task
+void audio_deadline_reset(audio_deadline_t* deadline);
+void audio_deadline_read(const audio_deadline_t* deadline, hal_audio_deadline_stats_t* stats);
+uint32_t audio_deadline_bin(uint32_t us);
+uint32_t audio_deadline_bin_floor_us(uint32_t bin);         // Lower edge of a bin
+
+// Multi-line table for the serial console; returns the length written
+size_t audio_deadline_format(const hal_audio_deadline_stats_t* stats, char* out, size_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Audio Decoder Interface
+ * Pluggable sources (tone, memory PCM, WAV, FLAC, MP3) driven by the audio engine
+ *
+ * A decoder turns one source into interleaved stereo int16 frames at the
+ * source's own sample rate. The engine owns the decoder state memory
+ * (state_size bytes, zeroed before open) and calls every entry point from
+ * the engine task, so decoders need no locking of their own.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal/hal_audio.h"
+#include "hal/hal_storage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MP3 decoding uses libmad from ESP8266Audio, which only builds for the device
+#ifndef AUDIO_DECODER_MP3
+#ifdef PLATFORM_ESP32
+#define AUDIO_DECODER_MP3 1
+#else
+#define AUDIO_DECODER_MP3 0
+#endif
+#endif
+
+#define AUDIO_DECODER_MAX_PATH  HAL_STORAGE_MAX_PATH_LENGTH
+
+// Source kinds
+typedef enum {
+    AUDIO_SOURCE_NONE   = 0,
+    AUDIO_SOURCE_FILE   = 1,    // File on the card, decoder chosen by extension
+    AUDIO_SOURCE_MEMORY = 2,    // Raw PCM in memory (hal_audio_play_buffer)
+    AUDIO_SOURCE_TONE   = 3     // Sine generator
+} audio_source_kind_t;
+
+// What to play; copied by value into the engine command queue
+typedef struct {
+    audio_source_kind_t kind;
+    char path[AUDIO_DECODER_MAX_PATH];  // AUDIO_SOURCE_FILE
+    const void* data;                   // AUDIO_SOURCE_MEMORY, must outlive playback
+    size_t size;                        // AUDIO_SOURCE_MEMORY, bytes
+    hal_audio_format_t format;          // AUDIO_SOURCE_MEMORY, PCM formats only
+    uint32_t sample_rate;               // AUDIO_SOURCE_MEMORY / AUDIO_SOURCE_TONE
+    uint32_t tone_hz;                   // AUDIO_SOURCE_TONE
+} audio_source_t;
+
+// Stream properties reported by open()
+typedef struct {
+    uint32_t sample_rate;       // Rate of the frames decode() produces
+    uint16_t channels;          // Channels in the source (output is always stereo)
+    uint16_t bits_per_sample;   // Source sample width, 0 for compressed formats
+    uint64_t total_frames;      // 0 when unknown or endless
+    uint32_t bitrate_kbps;      // Average bitrate, 0 when unknown
+} audio_stream_info_t;
+
+// Decoder operations
+typedef struct {
+    const char* name;
+    size_t state_size;
+
+    bool (*accepts)(const audio_source_t* source);
+    bool (*open)(void* state, const audio_source_t* source, audio_stream_info_t* info);
+    // Writes up to max_frames stereo frames; returns 0 at end of stream or on error
+    uint32_t (*decode)(void* state, int16_t* out, uint32_t max_frames);
+    // Optional (NULL when the source cannot seek)
+    bool (*seek)(void* state, uint64_t frame);
+    void (*close)(void* state);
+    // Optional: stream info from headers and tags alone, without decoder state
+    bool (*probe)(const audio_source_t* source, audio_stream_info_t* info);
+} audio_decoder_ops_t;
+
+// Header-only description of a file, for library scans
+typedef struct {
+    const char* codec;          // Decoder name ("wav", "flac", "mp3")
+    audio_stream_info_t info;
+    uint32_t duration_ms;       // 0 when unknown
+} audio_probe_t;
+
+// Built-in decoders
+extern const audio_decoder_ops_t audio_decoder_tone;
+extern const audio_decoder_ops_t audio_decoder_pcm;
+extern const audio_decoder_ops_t audio_decoder_wav;
+extern const audio_decoder_ops_t audio_decoder_flac;
+#if AUDIO_DECODER_MP3
+extern const audio_decoder_ops_t audio_decoder_mp3;
+#endif
+
+// Registry
+const audio_decoder_ops_t* audio_decoder_find(const audio_source_t* source);
+size_t audio_decoder_max_state_size(void);
+
+// Reads a few KB of headers at most and never decodes. MP3 is probed even on
+// builds that cannot play it, since its headers parse without libmad.
+bool audio_decoder_probe(const audio_source_t* source, audio_probe_t* probe);
+bool audio_decoder_probe_file(const char* path, audio_probe_t* probe);
+
+// Source helpers
+void audio_source_file(audio_source_t* source, const char* path);
+void audio_source_tone(audio_source_t* source, uint32_t tone_hz, uint32_t sample_rate);
+void audio_source_memory(audio_source_t* source, const void* data, size_t size,
+                         hal_audio_format_t format, uint32_t sample_rate);
+bool audio_source_has_extension(const audio_source_t* source, const char* extension);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Audio DSP Kernels
+ * Fixed-point sample loops shared by the decoders and the engine
+ *
+ * Every kernel is a flat loop over non-aliasing buffers with 32-bit
+ * intermediates and branch-free saturation, so GCC auto-vectorizes it on the
+ * host and the Xtensa core gets straight multiply/accumulate loops. Gains are
+ * Q15 multipliers computed once per parameter change, never per sample.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_DSP_Q15_ONE       32768           // Unity gain
+#define AUDIO_DSP_GAIN_MAX_Q15  (AUDIO_DSP_Q15_ONE * 8)   // +18 dB headroom for boosts
+
+// Gain multipliers
+int32_t audio_dsp_gain_from_percent(uint8_t percent);          // 0-100 linear volume
+int32_t audio_dsp_gain_from_db(float db);                       // Clamped to AUDIO_DSP_GAIN_MAX_Q15
+int32_t audio_dsp_gain_multiply(int32_t a_q15, int32_t b_q15);  // Combine two gains
+
+// Gain (in place; gains above unity saturate)
+void audio_dsp_gain_q15(int16_t* samples, size_t count, int32_t gain_q15);
+void audio_dsp_gain_q15_copy(const int16_t* in, int16_t* out, size_t count, int32_t gain_q15);
+
+// Channel layout
+void audio_dsp_upmix_mono(const int16_t* in, int16_t* out, size_t frames);        // out: interleaved stereo
+void audio_dsp_downmix_to_mono(const int16_t* in, int16_t* out, size_t frames);   // in: interleaved stereo
+
+// Mixing and saturation
+void audio_dsp_mix_sat(int16_t* acc, const int16_t* in, size_t count);            // acc += in
+void audio_dsp_mix_s32_sat(int16_t* acc, const int32_t* in, size_t count);        // acc += in; in must not come near 2^31
+void audio_dsp_saturate_s32(const int32_t* in, int16_t* out, size_t count, int shift);  // out = sat(in >> shift)
+
+// Equal-power crossfade. The curve is sin(pi/2 * pos/length) in Q15, from a
+// fixed-point polynomial (within 4 LSB); the outgoing side runs it backwards,
+// so the two gains always sum to unity power. audio_dsp_crossfade() mixes
+// frames stereo frames starting pos frames into a fade of length frames and
+// writes the result over incoming.
+int32_t audio_dsp_fade_gain_q15(uint32_t pos, uint32_t length);
+void audio_dsp_crossfade(int16_t* incoming, const int16_t* outgoing, size_t frames, uint32_t pos, uint32_t length);
+
+// Format conversion to int16
+void audio_dsp_u8_to_s16(const uint8_t* in, int16_t* out, size_t count);
+void audio_dsp_s24le_to_s16(const uint8_t* in, int16_t* out, size_t count);       // Packed 3-byte samples
+void audio_dsp_s32_to_s16(const int32_t* in, int16_t* out, size_t count);
+void audio_dsp_f32_to_s16(const float* in, int16_t* out, size_t count);           // Clips to [-1, 1)
+
+// Interleaved little-endian PCM layouts accepted by audio_dsp_pcm_to_stereo()
+typedef enum {
+    AUDIO_DSP_PCM_U8 = 0,
+    AUDIO_DSP_PCM_S16,
+    AUDIO_DSP_PCM_S24,                  // Packed 3-byte samples
+    AUDIO_DSP_PCM_S32,
+    AUDIO_DSP_PCM_F32
+} audio_dsp_pcm_format_t;
+
+#define AUDIO_DSP_MAX_CHANNELS  8
+
+// Any PCM layout straight to interleaved stereo int16 in one pass. Mono is
+// duplicated, stereo converted, and wider sources mixed with mix_q15
+// (channels x {left, right} weights). in must be aligned to the sample width.
+void audio_dsp_pcm_to_stereo(const void* in, int16_t* out, size_t frames, audio_dsp_pcm_format_t format,
+                             uint16_t channels, const int32_t* mix_q15);
+size_t audio_dsp_pcm_sample_bytes(audio_dsp_pcm_format_t format);
+
+// Stereo downmix weights for channels laid out by a WAVE speaker mask (FL, FR,
+// FC, LFE, BL, BR, ...; 0 = the default order). Centre channels go to both
+// sides at -3 dB, LFE is dropped, and each side is scaled so it cannot clip.
+void audio_dsp_downmix_matrix(uint32_t speaker_mask, uint16_t channels, int32_t* mix_q15);
+
+// Conversion from int16 (analysis, host sinks)
+void audio_dsp_s16_to_f32(const int16_t* in, float* out, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Audio Engine
+ * Single owner of audio output: runs the active decoder and feeds the HAL ring
+ *
+ * Control calls may come from any task; they are queued and executed in order
+ * on the engine task, which resamples every source to one fixed output rate.
+ * With start_task = false no task is created and the caller pulls PCM with
+ * audio_engine_render() instead (host render-to-memory, tests and benchmarks).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "audio/audio_decoder.h"
+#include "audio/audio_resampler.h"
+#include "audio/audio_analyzer.h"
+#include "audio/audio_readahead.h"
+#include "audio/audio_loudness.h"
+#include "audio/audio_synth.h"
+#include "hal/hal_audio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef AUDIO_SAMPLE_RATE
+#define AUDIO_SAMPLE_RATE HAL_AUDIO_DEFAULT_SAMPLE_RATE
+#endif
+
+#define AUDIO_ENGINE_BLOCK_FRAMES   256     // One I2S DMA buffer
+#define AUDIO_ENGINE_QUEUE_LENGTH   8
+#define AUDIO_ENGINE_TASK_STACK     8192
+#define AUDIO_ENGINE_MAX_CROSSFADE_MS   12000
+#define AUDIO_ENGINE_CLOCK_MARKS    8       // Track starts and seeks still in the output buffer
+
+// Engine configuration
+typedef struct {
+    bool start_task;            // false: no task, caller pulls with audio_engine_render()
+    uint32_t block_frames;      // Frames per render block (0 = AUDIO_ENGINE_BLOCK_FRAMES)
+    uint32_t output_rate;       // Rate of every rendered frame (0 = AUDIO_SAMPLE_RATE)
+    audio_resampler_quality_t resampler_quality;
+    uint32_t analyzer_fft_size; // Spectrum points, power of two (0 = AUDIO_ANALYZER_DEFAULT_FFT)
+    uint32_t readahead_chunk_bytes; // Card read size, multiple of 512 (0 = AUDIO_READAHEAD_DEFAULT_CHUNK)
+    uint32_t readahead_chunks;  // Read-ahead buffers per open file (0 = AUDIO_READAHEAD_DEFAULT_CHUNKS)
+    uint32_t crossfade_ms;      // Overlap between tracks (0 = cut, queued tracks splice gaplessly)
+    audio_replay_gain_mode_t replay_gain;   // Loudness normalization (OFF = play as mastered)
+    float replay_gain_preamp_db;            // Added to every ReplayGain gain
+    uint32_t synth_voices;      // UI sound polyphony (0 = AUDIO_SYNTH_DEFAULT_VOICES)
+} audio_engine_config_t;
+
+// Engine statistics
+typedef struct {
+    uint32_t tracks_opened;
+    uint32_t open_failures;
+    uint32_t blocks_rendered;
+    uint32_t commands_executed;
+    uint32_t gapless_splices;   // Queued tracks started without a gap
+    uint32_t crossfades;        // Tracks started over a fading one
+} audio_engine_stats_t;
+
+// Lifecycle: init allocates every decoder state, buffer and table the engine
+// uses, so play, pause, seek and track changes never allocate
+bool audio_engine_init(const audio_engine_config_t* config);
+void audio_engine_deinit(void);
+bool audio_engine_is_initialized(void);
+
+// Transport (queued; false if the source cannot be played or the queue is full)
+bool audio_engine_play(const audio_source_t* source);
+bool audio_engine_play_file(const char* path);
+bool audio_engine_play_tone(uint32_t tone_hz);
+void audio_engine_stop(void);
+void audio_engine_pause(void);
+void audio_engine_resume(void);
+bool audio_engine_seek_ms(uint32_t position_ms);
+
+// Gapless queue: one source that starts when the current one ends, or fades
+// in over its last crossfade_ms when its length is known. Play and stop drop
+// it; loop takes precedence over it.
+bool audio_engine_queue_next(const audio_source_t* source);
+bool audio_engine_queue_next_file(const char* path);
+void audio_engine_clear_next(void);
+bool audio_engine_has_next(void);           // Queued and not yet started
+
+// UI sounds and plugin beeps (audio_synth.h), mixed over whatever plays at
+// the current volume; they sound while stopped or paused too. The notes of
+// one call start together, their delays counted from the same frame.
+bool audio_engine_play_notes(const audio_synth_note_t* notes, size_t count);
+bool audio_engine_beep(uint32_t frequency_hz, uint32_t duration_ms);
+
+// State (safe from any task)
+hal_audio_state_t audio_engine_get_state(void);
+audio_source_kind_t audio_engine_get_source_kind(void);
+const char* audio_engine_get_decoder_name(void);    // "" when idle
+hal_audio_error_t audio_engine_get_last_error(void);
+uint32_t audio_engine_get_sample_rate(void);    // Source rate of the current track
+uint32_t audio_engine_get_output_rate(void);    // Rate of the frames being rendered
+
+// Playback clock (any task, lock-free). Position and duration are those of the
+// frame the DAC is playing (in pull mode, the last one rendered), so they
+// trail decoding by the output buffer and change track when the listener does.
+uint32_t audio_engine_get_position_ms(void);
+uint32_t audio_engine_get_duration_ms(void);    // 0 when unknown
+float audio_engine_get_progress(void);          // 0.0-1.0, position and duration from one reading
+uint32_t audio_engine_get_frames_played(void);  // Output frames heard since init, wrapping
+
+// Output parameters
+void audio_engine_set_volume(uint8_t volume);   // 0-100
+uint8_t audio_engine_get_volume(void);
+void audio_engine_set_mute(bool muted);
+bool audio_engine_is_muted(void);
+void audio_engine_set_loop(bool loop);
+bool audio_engine_get_loop(void);
+
+// Crossfade length for later track changes, clamped to
+// AUDIO_ENGINE_MAX_CROSSFADE_MS. While a fade runs the outgoing track borrows
+// the gapless slot, so the track after the incoming one is opened once it ends.
+void audio_engine_set_crossfade_ms(uint32_t ms);
+uint32_t audio_engine_get_crossfade_ms(void);
+
+// ReplayGain: each file's gain comes from the loudness cache or its tags and
+// is applied from its first sample; a change reaches the playing track at the
+// next block. Tracks with neither play at unity.
+void audio_engine_set_replay_gain(audio_replay_gain_mode_t mode, float preamp_db);
+audio_replay_gain_mode_t audio_engine_get_replay_gain(void);
+
+// Equalizer (10 bands, 31 Hz-16 kHz, plus shelves; +/-12 dB). Coefficients
+// are computed on the calling task and picked up at the next block.
+void audio_engine_set_equalizer(const float* band_db, size_t band_count);
+void audio_engine_set_bass_boost(float db);
+void audio_engine_set_treble_boost(float db);
+void audio_engine_reset_effects(void);              // Flat
+
+// Spectrum, peak and RMS of the rendered output (any task, never blocks;
+// false until the first analysis)
+bool audio_engine_get_analysis(audio_analyzer_frame_t* frame);
+
+// Callbacks run on the engine task; set them while stopped
+void audio_engine_set_end_callback(hal_audio_callback_t callback, void* user_data);
+void audio_engine_set_data_callback(hal_audio_data_callback_t callback, void* user_data);
+void audio_engine_set_track_callback(hal_audio_callback_t callback, void* user_data);  // After each splice or fade into a queued track
+
+// Pull interface: runs queued commands, then renders up to frames stereo frames.
+// Returns fewer frames when the track ends or nothing is playing, unless a
+// synth note is sounding.
+uint32_t audio_engine_render(int16_t* out, uint32_t frames);
+
+void audio_engine_get_stats(audio_engine_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
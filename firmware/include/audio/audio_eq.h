@@ -0,0 +1,78 @@
+/*
+ * Audio Equalizer
+ * 10-band graphic EQ plus bass and treble shelves as a fixed-point biquad cascade
+ *
+ * Setters run on the calling (control) task: they design the RBJ biquads in
+ * float, quantize them to Q28 and publish the set through a lock-free triple
+ * buffer. The audio task picks up the newest set at the start of a block and
+ * never waits. Filters are Direct Form I with 64-bit accumulators and error
+ * feedback, so state survives a coefficient swap without a click, and stages
+ * at 0 dB are skipped entirely.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <atomic>
+
+#define AUDIO_EQ_BANDS          10          // 31 Hz to 16 kHz, one octave apart
+#define AUDIO_EQ_STAGES         (AUDIO_EQ_BANDS + 2)    // Bands, bass shelf, treble shelf
+#define AUDIO_EQ_CHANNELS       2
+#define AUDIO_EQ_COEF_SHIFT     28          // Coefficients in Q28: range +/-8
+#define AUDIO_EQ_MAX_GAIN_DB    12.0f
+#define AUDIO_EQ_BASS_HZ        120.0f      // Low shelf corner
+#define AUDIO_EQ_TREBLE_HZ      8000.0f     // High shelf corner
+
+typedef struct {
+    int32_t b0, b1, b2, a1, a2;             // a0 normalized to 1
+} audio_eq_biquad_t;
+
+// One published coefficient set; only active stages are run
+typedef struct {
+    audio_eq_biquad_t stage[AUDIO_EQ_STAGES];
+    uint8_t active[AUDIO_EQ_STAGES];        // Stage indices in processing order
+    uint8_t active_count;
+} audio_eq_coefs_t;
+
+typedef struct {
+    int32_t x1, x2, y1, y2;
+    int32_t error;                          // Fraction dropped by the last output (noise shaping)
+} audio_eq_state_t;
+
+typedef struct {
+    uint32_t sample_rate;
+
+    // Control side (setters, serialized by the caller)
+    float band_db[AUDIO_EQ_BANDS];
+    float bass_db;
+    float treble_db;
+    uint8_t back;                           // Slot being written
+
+    // Triple buffer: the writer fills back, swaps it into middle; the audio task swaps middle into front
+    audio_eq_coefs_t sets[3];
+    std::atomic<uint8_t> middle;            // Slot index, AUDIO_EQ_FRESH set when unread
+    uint8_t front;                          // Audio task only
+
+    // Audio task only
+    audio_eq_state_t state[AUDIO_EQ_STAGES][AUDIO_EQ_CHANNELS];
+    bool running[AUDIO_EQ_STAGES];          // Stage was active in the last block
+} audio_eq_t;
+
+#define AUDIO_EQ_FRESH  0x80
+
+// Lifecycle. Starts flat (every stage bypassed).
+void audio_eq_init(audio_eq_t* eq, uint32_t sample_rate);
+void audio_eq_reset_state(audio_eq_t* eq);              // Audio task: forget filter history
+
+// Control side: clamp to +/-AUDIO_EQ_MAX_GAIN_DB, redesign and publish
+void audio_eq_set_bands(audio_eq_t* eq, const float* band_db, size_t band_count);
+void audio_eq_set_bass(audio_eq_t* eq, float db);
+void audio_eq_set_treble(audio_eq_t* eq, float db);
+void audio_eq_set_flat(audio_eq_t* eq);
+float audio_eq_band_hz(size_t band);
+
+// Audio task: filters interleaved stereo in place
+void audio_eq_process(audio_eq_t* eq, int16_t* samples, uint32_t frames);
+bool audio_eq_is_flat(audio_eq_t* eq);                  // Audio task: nothing to run in the current set
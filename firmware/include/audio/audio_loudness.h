@@ -0,0 +1,128 @@
+/*
+ * Audio Loudness
+ * ReplayGain for playback: per-track and per-album gains to a common
+ * loudness, worked out once and cached on the card
+ *
+ * A track's gain comes from its REPLAYGAIN_* tags (FLAC Vorbis comments,
+ * ID3v2 TXXX frames) or from an EBU R128 integrated loudness measurement:
+ * K-weighting, 400 ms blocks every 100 ms, -70 LUFS absolute and -10 LU
+ * relative gates. Gated blocks go into a fixed histogram of 0.1 LU bins
+ * rather than a list, so a meter is a few KB whatever the track length, and
+ * an album's loudness is the sum of its tracks' histograms.
+ *
+ * The indexing job walks a directory tree and measures every track without a
+ * cache record, one slice of frames per step, on its own low-priority task
+ * that sleeps while the engine plays. Each directory is one album. Records
+ * are written per track, so a job stopped or rebooted half way resumes with
+ * the first track it had not finished. On the way it scans and caches the
+ * seek table of every untagged variable bitrate MP3 (audio_mp3_index.h).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal/hal_storage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_LOUDNESS_REFERENCE_LUFS   (-18.0f)    // ReplayGain 2.0 target
+#define AUDIO_LOUDNESS_FLOOR_LUFS       (-70.0f)    // Absolute gate; reported for silence
+#define AUDIO_LOUDNESS_HISTOGRAM_BINS   750         // 0.1 LU from -70 to +5 LUFS
+#define AUDIO_LOUDNESS_CACHE_DIR        "/System/loudness"
+#define AUDIO_LOUDNESS_DEFAULT_ROOT     "/Music"
+#define AUDIO_LOUDNESS_STEP_FRAMES      4096        // Source frames measured per job step
+#define AUDIO_LOUDNESS_MAX_DEPTH        4           // Directory levels below the root
+#define AUDIO_LOUDNESS_TASK_STACK       4096
+#define AUDIO_LOUDNESS_IDLE_POLL_MS     250         // Job recheck interval while the engine plays
+#define AUDIO_LOUDNESS_TAG_READ_BYTES   16384       // File head read for tags; frames past it are not seen
+
+typedef enum {
+    AUDIO_REPLAY_GAIN_OFF = 0,
+    AUDIO_REPLAY_GAIN_TRACK,
+    AUDIO_REPLAY_GAIN_ALBUM             // Falls back to the track gain for a track without one
+} audio_replay_gain_mode_t;
+
+// Gains to AUDIO_LOUDNESS_REFERENCE_LUFS and sample peaks (1.0 = full scale)
+typedef struct {
+    bool has_track;
+    bool has_album;
+    bool measured;                      // From the meter rather than from tags
+    float track_gain_db;
+    float track_peak;
+    float album_gain_db;
+    float album_peak;
+} audio_loudness_t;
+
+// Integrated loudness meter over interleaved stereo int16 (decoder output)
+typedef struct {
+    uint32_t sample_rate;
+    uint16_t channels;                  // 1: only the left channel of an upmixed mono source
+    float pre[5];                       // Head shelf: b0 b1 b2 a1 a2
+    float rlb[2];                       // High-pass a1 a2 (b is 1 -2 1)
+    float z[2][4];                      // Filter state per channel
+    uint32_t sub_frames;                // Frames per 100 ms
+    uint32_t sub_pos;
+    float sub_energy;                   // Running sum of the current 100 ms
+    float subs[4];                      // Last four 100 ms sums: one 400 ms block
+    uint32_t sub_count;
+    uint32_t peak;                      // Largest magnitude seen, 0-32768
+    uint32_t histogram[AUDIO_LOUDNESS_HISTOGRAM_BINS];
+} audio_loudness_meter_t;
+
+// Meter
+bool audio_loudness_meter_init(audio_loudness_meter_t* meter, uint32_t sample_rate, uint16_t channels);
+void audio_loudness_meter_feed(audio_loudness_meter_t* meter, const int16_t* stereo, size_t frames);
+float audio_loudness_meter_integrated(const audio_loudness_meter_t* meter);   // LUFS
+float audio_loudness_meter_peak(const audio_loudness_meter_t* meter);
+void audio_loudness_meter_merge(audio_loudness_meter_t* album, const audio_loudness_meter_t* track);
+
+// REPLAYGAIN_* tags of a FLAC or MP3 file; false when it carries no track gain.
+// One read of the file head into scratch (AUDIO_LOUDNESS_TAG_READ_BYTES, NULL
+// to allocate it), a second for FLAC behind a larger ID3 tag.
+bool audio_loudness_read_tags(const char* path, audio_loudness_t* loudness, uint8_t* scratch);
+
+// Cache record per track, keyed by its path and checked against its size.
+// meter (optional) keeps the track's histogram for album measurement.
+bool audio_loudness_load(const char* path, audio_loudness_t* loudness);
+bool audio_loudness_save(const char* path, const audio_loudness_t* loudness, const audio_loudness_meter_t* meter);
+
+// Cache record (one read), else tags (one or two); done on the engine task
+// when a track is opened, with scratch allocated up front
+bool audio_loudness_lookup(const char* path, audio_loudness_t* loudness, uint8_t* scratch);
+
+// Playback multiplier for mode plus preamp_db, lowered so the peak cannot
+// clip. Unity when off or nothing is known about the track.
+int32_t audio_loudness_gain_q15(const audio_loudness_t* loudness, audio_replay_gain_mode_t mode, float preamp_db);
+
+// Indexing job
+typedef struct {
+    const char* root;                   // Directory tree to index (NULL = AUDIO_LOUDNESS_DEFAULT_ROOT)
+    uint32_t step_frames;               // Frames per step (0 = AUDIO_LOUDNESS_STEP_FRAMES)
+    bool start_task;                    // false: the caller runs audio_loudness_job_step()
+} audio_loudness_job_config_t;
+
+typedef struct {
+    bool running;
+    bool waiting;                       // Held back while the engine plays
+    uint32_t measured;                  // Tracks measured this run
+    uint32_t tagged;                    // Tracks recorded from their tags
+    uint32_t cached;                    // Tracks that already had a record
+    uint32_t failed;                    // Tracks that would not decode
+    uint32_t seek_indexed;              // MP3 seek tables scanned this run
+    uint32_t albums;
+    char current[HAL_STORAGE_MAX_PATH_LENGTH];  // Track being measured
+} audio_loudness_progress_t;
+
+bool audio_loudness_job_start(const audio_loudness_job_config_t* config);
+void audio_loudness_job_stop(void);             // Keeps every record already written
+bool audio_loudness_job_step(void);             // One unit of work; false once finished
+bool audio_loudness_job_is_running(void);
+void audio_loudness_job_get_progress(audio_loudness_progress_t* progress);
+
+#ifdef __cplusplus
+}
+#endif
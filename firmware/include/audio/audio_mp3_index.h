@@ -0,0 +1,100 @@
+/*
+ * MP3 Seek Index
+ * Maps MPEG frame numbers to byte offsets so the MP3 decoder can seek
+ * without decoding from the start of the file
+ *
+ * Opening a file reads only its head: the ID3v2 tag is skipped and the first
+ * frame is checked for a Xing/Info or VBRI tag. That picks the cheapest exact
+ * enough index:
+ *   LINEAR  Constant bitrate (Info tag, Xing without TOC, or untagged files
+ *           whose leading frames agree): offset is frame * average length
+ *   XING    Variable bitrate with a Xing TOC: 100 points, interpolated
+ *   FRAMES  A sparse table with the offset of every stride-th frame, from a
+ *           VBRI TOC or from one header-only scan of the file. Scanned tables
+ *           are exact and are cached on the card next to the library index.
+ *   NONE    Variable bitrate without a TOC: located from the average bitrate
+ *           of the leading frames until a scanned table is cached. The scan
+ *           reads the whole file, so the loudness indexing job runs it, never
+ *           the playback path.
+ * Locating a frame lands on a verified frame header: LINEAR, XING and NONE
+ * jump and resynchronise, FRAMES jumps to the nearest point and walks at most
+ * stride - 1 headers forward through a small read buffer.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal/hal_storage.h"
+#include "audio/audio_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_MP3_INDEX_POINTS      2048    // FRAMES capacity; the stride doubles when full
+#define AUDIO_MP3_INDEX_STRIDE      16      // Initial frames between FRAMES points
+#define AUDIO_MP3_INDEX_TOC         100
+#define AUDIO_MP3_INDEX_CACHE_DIR   "/System/seek"
+
+// One parsed MPEG audio frame header
+typedef struct {
+    uint32_t sample_rate;
+    uint32_t bitrate_kbps;
+    uint16_t channels;
+    uint16_t samples;                       // PCM frames per MPEG frame
+    uint32_t bytes;                         // Frame length including the header
+} audio_mp3_header_t;
+
+typedef enum {
+    AUDIO_MP3_INDEX_NONE = 0,               // Variable bitrate without a TOC: estimates until scanned
+    AUDIO_MP3_INDEX_LINEAR,
+    AUDIO_MP3_INDEX_XING,
+    AUDIO_MP3_INDEX_FRAMES
+} audio_mp3_index_kind_t;
+
+typedef struct {
+    audio_mp3_index_kind_t kind;
+    uint32_t sample_rate;
+    uint32_t samples_per_frame;
+    uint16_t channels;
+    uint32_t bitrate_kbps;                  // Average
+    uint64_t file_bytes;
+    uint64_t data_start;                    // First audio frame, after ID3v2 and any tag frame
+    uint64_t data_bytes;                    // Audio frames only (no ID3v1 tail)
+    uint32_t total_frames;                  // MPEG frames, 0 when unknown
+    bool exact;                             // Located frames are exact, not estimates
+
+    uint8_t toc[AUDIO_MP3_INDEX_TOC];       // XING: percent of data_bytes in 1/256ths
+    uint32_t stride;                        // FRAMES: frames between points
+    uint32_t count;                         // FRAMES: points in use
+    uint32_t offsets[AUDIO_MP3_INDEX_POINTS];   // FRAMES: point i is frame i * stride, from data_start
+} audio_mp3_index_t;
+
+// Parses four header bytes; false for anything but MPEG 1/2/2.5 Layer III
+bool audio_mp3_parse_header(const uint8_t* bytes, audio_mp3_header_t* header);
+
+// Reads the head of an open file. kind is NONE when only a scan can index it.
+bool audio_mp3_index_open(audio_mp3_index_t* index, hal_storage_file_t file);
+
+// Walks every frame header from data_start and builds an exact FRAMES table.
+// Reads the whole file: background tasks only.
+bool audio_mp3_index_scan(audio_mp3_index_t* index, hal_storage_file_t file);
+
+// Finds the frame at or before `frame` to start decoding from. *located is the
+// frame number at *offset (an estimate unless index->exact).
+bool audio_mp3_index_locate(const audio_mp3_index_t* index, hal_storage_file_t file,
+                            uint32_t frame, uint64_t* offset, uint32_t* located);
+
+// Header-only stream info: duration from the tag, the cached table or, for
+// untagged variable bitrate, an estimate from the first frame's bitrate
+bool audio_mp3_probe(const char* path, audio_stream_info_t* info);
+
+// Scanned-table cache, keyed by the track path and checked against its size
+bool audio_mp3_index_load(audio_mp3_index_t* index, const char* path);
+bool audio_mp3_index_save(const audio_mp3_index_t* index, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
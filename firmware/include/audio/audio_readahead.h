@@ -0,0 +1,78 @@
+/*
+ * Audio Read-Ahead
+ * Keeps a few large card reads buffered ahead of each decoder, so an SD
+ * latency spike drains this buffer instead of the output ring
+ *
+ * Every open file gets a pool of chunk buffers (PSRAM when available). A
+ * single filesystem task fills them with sector-aligned reads of one chunk
+ * each, round-robin across the open files, while decoders take the bytes in
+ * place with acquire/release. Without the task (render mode, tests) a
+ * decoder that runs dry fills the next chunk itself.
+ *
+ * Pools belong to a fixed set of stream slots, allocated by init and kept
+ * across opens, so opening a file (changing tracks) never allocates.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_READAHEAD_MAX_STREAMS     3               // Playing, gapless next, one spare
+#define AUDIO_READAHEAD_DEFAULT_CHUNK   (32 * 1024)
+#define AUDIO_READAHEAD_DEFAULT_CHUNKS  3
+#define AUDIO_READAHEAD_MAX_CHUNKS      8
+#define AUDIO_READAHEAD_ALIGN           512             // One SD sector
+#define AUDIO_READAHEAD_TASK_STACK      4096
+#define AUDIO_READAHEAD_TIMEOUT_MS      2000            // A stream this late is treated as ended
+
+typedef struct audio_readahead audio_readahead_t;
+
+typedef struct {
+    uint32_t chunk_bytes;       // One card read, a multiple of AUDIO_READAHEAD_ALIGN (0 = default)
+    uint32_t chunks;            // Buffers per stream, 2 to AUDIO_READAHEAD_MAX_CHUNKS (0 = default)
+    bool start_task;            // false: decoders read on their own task when they run dry
+} audio_readahead_config_t;
+
+typedef struct {
+    uint32_t streams;           // Open files
+    uint32_t fill_bytes;        // Buffered ahead of the decoders, all streams
+    uint32_t capacity_bytes;
+    uint32_t min_fill_percent;  // Lowest fill of any stream once it had filled up, since reset
+    uint32_t reads;
+    uint64_t bytes_read;
+    uint32_t worst_read_us;     // Slowest single card read
+    uint32_t stalls;            // A filled-up stream ran dry and its decoder had to wait
+    uint32_t worst_stall_us;    // Longest such wait
+} audio_readahead_stats_t;
+
+// Lifecycle. Streams may be opened before init; they read synchronously.
+bool audio_readahead_init(const audio_readahead_config_t* config);
+void audio_readahead_deinit(void);
+
+// Streams (NULL when the file is missing or every slot is in use)
+audio_readahead_t* audio_readahead_open(const char* path);
+void audio_readahead_close(audio_readahead_t* ra);
+bool audio_readahead_seek(audio_readahead_t* ra, uint64_t offset);    // Drops what is buffered
+uint64_t audio_readahead_tell(const audio_readahead_t* ra);
+uint64_t audio_readahead_size(const audio_readahead_t* ra);
+
+// Zero-copy reads: acquire returns the contiguous bytes buffered at the read
+// position (blocking until the chunk arrives, 0 at end of file), release
+// consumes some or all of them
+uint32_t audio_readahead_acquire(audio_readahead_t* ra, const uint8_t** data);
+void audio_readahead_release(audio_readahead_t* ra, uint32_t bytes);
+// Copying read across chunk boundaries, for headers and split frames
+uint32_t audio_readahead_read(audio_readahead_t* ra, void* out, uint32_t bytes);
+
+void audio_readahead_get_stats(audio_readahead_stats_t* stats);
+void audio_readahead_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Audio Resampler
+ * Streaming polyphase windowed-sinc sample-rate converter for stereo int16
+ *
+ * The rate ratio is reduced to out/in = L/M. Each of the (up to
+ * AUDIO_RESAMPLER_MAX_PHASES) phases gets a Kaiser-windowed sinc row in Q14,
+ * so a 64-tap dot product stays inside 32 bits on the ESP32. Output frame n
+ * is centred on input time n * M / L: there is no start-up delay, and the
+ * last taps/2 input frames come out of audio_resampler_drain() at end of
+ * stream. Ratios with more than MAX_PHASES phases use the nearest phase.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_RESAMPLER_CHANNELS    2
+#define AUDIO_RESAMPLER_MAX_TAPS    64
+#define AUDIO_RESAMPLER_MAX_PHASES  512
+#define AUDIO_RESAMPLER_COEF_SHIFT  14
+
+// Quality tiers. Tap counts are for upsampling; downsampling by r uses ceil(r)
+// times as many, up to AUDIO_RESAMPLER_MAX_TAPS.
+typedef enum {
+    AUDIO_RESAMPLER_QUALITY_DEFAULT = 0,    // MEDIUM
+    AUDIO_RESAMPLER_QUALITY_LOW,            // 8 taps, ~50 dB stopband, 80% passband
+    AUDIO_RESAMPLER_QUALITY_MEDIUM,         // 16 taps, ~70 dB stopband, 88% passband
+    AUDIO_RESAMPLER_QUALITY_HIGH            // 32 taps, ~85 dB stopband, 92% passband
+} audio_resampler_quality_t;
+
+typedef struct {
+    uint32_t in_rate;
+    uint32_t out_rate;
+    audio_resampler_quality_t quality;
+    bool passthrough;                       // in_rate == out_rate: frames are copied
+
+    uint32_t taps;
+    uint32_t step_in;                       // M: input advances step_in / step_out frames per output
+    uint32_t step_out;                      // L
+    uint32_t phases;                        // Coefficient rows (L, or MAX_PHASES when L is larger)
+    int16_t* coefs;                         // phases * taps, Q14, oldest tap first
+    size_t coef_capacity;                   // Entries allocated
+
+    uint32_t position;                      // Output time between input frames, units of 1/L
+    uint32_t pending;                       // Input frames to take in before the next output
+    uint32_t drain_left;                    // Silent frames still to feed at end of stream
+    uint32_t history_pos;
+    int16_t history[AUDIO_RESAMPLER_CHANNELS][AUDIO_RESAMPLER_MAX_TAPS * 2];   // Doubled: windows never wrap
+} audio_resampler_t;
+
+// Lifecycle. The struct must be zeroed before the first init. init may be
+// called again to change rates; it keeps the coefficient buffer and skips the
+// filter design when rates and quality are unchanged.
+bool audio_resampler_init(audio_resampler_t* rs, uint32_t in_rate, uint32_t out_rate,
+                          audio_resampler_quality_t quality);
+void audio_resampler_deinit(audio_resampler_t* rs);
+
+// Sizes the coefficient buffer for the largest table any standard source rate
+// (8-192 kHz) needs into out_rate, so switching between them never allocates
+bool audio_resampler_reserve(audio_resampler_t* rs, uint32_t out_rate, audio_resampler_quality_t quality);
+void audio_resampler_reset(audio_resampler_t* rs);     // Forget history (seek, new stream)
+
+// Converts interleaved stereo frames. Stops when either side runs out;
+// *consumed reports the input frames taken.
+uint32_t audio_resampler_process(audio_resampler_t* rs, const int16_t* in, uint32_t in_frames,
+                                 uint32_t* consumed, int16_t* out, uint32_t out_frames);
+
+// End of stream: flushes the filter tail. Returns 0 once everything is out.
+uint32_t audio_resampler_drain(audio_resampler_t* rs, int16_t* out, uint32_t out_frames);
+
+// Output frames a stream of in_frames produces, including the drained tail
+uint64_t audio_resampler_output_frames(const audio_resampler_t* rs, uint64_t in_frames);
+uint32_t audio_resampler_taps(audio_resampler_quality_t quality, uint32_t in_rate, uint32_t out_rate);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Audio Ring Buffer
+ * Lock-free single-producer/single-consumer ring of interleaved stereo PCM frames
+ *
+ * One task (decoder/engine) writes, one task (I2S feeder or host sink) reads.
+ * Indices are free-running 32-bit frame counters, so the capacity must be a
+ * power of two. Storage may live in PSRAM; nothing here takes a lock.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <atomic>
+
+#define AUDIO_RING_CHANNELS 2
+
+typedef struct {
+    int16_t* samples;                       // capacity_frames * AUDIO_RING_CHANNELS samples
+    uint32_t capacity_frames;               // Power of two
+    uint32_t mask;                          // capacity_frames - 1
+    bool owns_storage;
+
+    std::atomic<uint32_t> write_index;      // Frames ever written (producer owned)
+    std::atomic<uint32_t> read_index;       // Frames ever read (consumer owned)
+
+    // Accounting
+    std::atomic<uint32_t> overruns;         // Writes rejected or truncated because the ring was full
+    std::atomic<uint32_t> underruns;        // Reads that ran dry while the stream was active
+    std::atomic<uint32_t> frames_dropped;   // Frames the producer could not store
+    std::atomic<uint32_t> frames_padded;    // Silence frames the consumer had to insert
+    std::atomic<bool> stream_active;        // Set by writes, cleared by audio_ring_end_stream()
+    bool consumer_starved;                  // Consumer side only: last read came up short
+} audio_ring_t;
+
+// Lifecycle
+bool audio_ring_init(audio_ring_t* ring, uint32_t capacity_frames, bool prefer_psram);
+bool audio_ring_init_with_storage(audio_ring_t* ring, int16_t* storage, uint32_t capacity_frames);
+void audio_ring_deinit(audio_ring_t* ring);
+void audio_ring_reset(audio_ring_t* ring);              // Only while both sides are idle
+void audio_ring_reset_stats(audio_ring_t* ring);
+
+// Occupancy (safe from either side; the value may be stale by the time it is used)
+uint32_t audio_ring_used_frames(const audio_ring_t* ring);
+uint32_t audio_ring_free_frames(const audio_ring_t* ring);
+
+// Producer side
+uint32_t audio_ring_write(audio_ring_t* ring, const int16_t* frames, uint32_t frame_count);
+bool audio_ring_write_all(audio_ring_t* ring, const int16_t* frames, uint32_t frame_count);
+uint32_t audio_ring_acquire_write(audio_ring_t* ring, int16_t** region);   // Contiguous free frames
+void audio_ring_commit_write(audio_ring_t* ring, uint32_t frame_count);
+void audio_ring_end_stream(audio_ring_t* ring);         // Remaining frames drain without counting underruns
+
+// Consumer side
+uint32_t audio_ring_read(audio_ring_t* ring, int16_t* out, uint32_t frame_count);
+uint32_t audio_ring_read_padded(audio_ring_t* ring, int16_t* out, uint32_t frame_count);
+uint32_t audio_ring_acquire_read(audio_ring_t* ring, const int16_t** region); // Contiguous used frames
+void audio_ring_commit_read(audio_ring_t* ring, uint32_t frame_count);
+void audio_ring_note_starved(audio_ring_t* ring, uint32_t padded_frames);
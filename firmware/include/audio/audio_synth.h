@@ -0,0 +1,129 @@
+/*
+ * Audio Synth
+ * Polyphonic tone generator for UI clicks and plugin beeps, mixed over the music
+ *
+ * Each voice is a 32-bit phase accumulator reading a wavetable with linear
+ * interpolation. Square, saw and triangle are summed from their harmonics at
+ * init, one table per octave holding only the harmonics that stay below
+ * Nyquist for the highest note of that octave, so no pitch aliases. Every
+ * voice has a linear ADSR envelope and starts at a scheduled output frame, so
+ * the notes of one call keep their spacing exactly whatever the caller's
+ * timing. Voices are mixed in 32 bits and saturated once onto the output; the
+ * render path is integer only and nothing allocates after init.
+ *
+ * Notes may be posted from any task: posters serialize on a mutex to append
+ * to a small ring, and the audio task picks the ring up at the start of each
+ * block without ever waiting.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <atomic>
+#include "hal/hal_system.h"
+
+#define AUDIO_SYNTH_MAX_VOICES      16
+#define AUDIO_SYNTH_DEFAULT_VOICES  8
+#define AUDIO_SYNTH_TABLE_BITS      8           // 256 points per cycle
+#define AUDIO_SYNTH_TABLE_SIZE      (1u << AUDIO_SYNTH_TABLE_BITS)
+#define AUDIO_SYNTH_OCTAVES         8           // Tables per band-limited waveform
+#define AUDIO_SYNTH_LOWEST_OCTAVE_HZ 160        // Top of the first table; a 256-point table holds no more harmonics below it
+#define AUDIO_SYNTH_QUEUE_LENGTH    32          // Notes posted and not yet started
+#define AUDIO_SYNTH_CHUNK_FRAMES    128         // Frames mixed per pass
+#define AUDIO_SYNTH_LEVEL_ONE       (1 << 30)   // Full envelope level
+
+typedef enum {
+    AUDIO_SYNTH_SINE = 0,
+    AUDIO_SYNTH_SQUARE,
+    AUDIO_SYNTH_SAW,
+    AUDIO_SYNTH_TRIANGLE,
+    AUDIO_SYNTH_WAVEFORMS
+} audio_synth_waveform_t;
+
+// One note. It sounds for duration_ms from its attack to the start of its
+// release; a note shorter than its attack and decay plays them out first.
+typedef struct {
+    audio_synth_waveform_t waveform;
+    uint32_t frequency_hz;              // Clamped below Nyquist
+    uint8_t volume;                     // 0-100 of full scale
+    int8_t pan;                         // -100 (left) to 100 (right), equal power
+    uint32_t delay_ms;                  // After the block the note is picked up in
+    uint32_t duration_ms;
+    uint16_t attack_ms;
+    uint16_t decay_ms;
+    uint8_t sustain;                    // 0-100 of the peak
+    uint16_t release_ms;
+} audio_synth_note_t;
+
+typedef enum {
+    AUDIO_SYNTH_STAGE_OFF = 0,
+    AUDIO_SYNTH_STAGE_DELAY,            // Scheduled, not started
+    AUDIO_SYNTH_STAGE_ATTACK,
+    AUDIO_SYNTH_STAGE_DECAY,
+    AUDIO_SYNTH_STAGE_SUSTAIN,
+    AUDIO_SYNTH_STAGE_RELEASE
+} audio_synth_stage_t;
+
+typedef struct {
+    const int16_t* table;               // AUDIO_SYNTH_TABLE_SIZE + 1 points (the first repeated)
+    uint32_t phase;
+    uint32_t phase_inc;
+    int32_t gain_left_q15;              // Volume and pan
+    int32_t gain_right_q15;
+    uint8_t stage;                      // audio_synth_stage_t
+    uint32_t stage_frames;              // Frames left in the stage
+    int32_t level;                      // Envelope, 0 to AUDIO_SYNTH_LEVEL_ONE
+    int32_t step;                       // Added per frame within the stage
+    int32_t sustain_level;
+    uint32_t attack_frames;
+    uint32_t decay_frames;
+    uint32_t sustain_frames;
+    uint32_t release_frames;
+} audio_synth_voice_t;
+
+typedef struct {
+    uint32_t sample_rate;
+    uint32_t max_voices;
+    int16_t* tables;                    // Sine, then each octave of square, saw and triangle
+    uint32_t octave_inc[AUDIO_SYNTH_OCTAVES];   // Highest phase increment each table is clean for
+
+    // Posted notes: producers append under lock, the audio task consumes
+    audio_synth_note_t queue[AUDIO_SYNTH_QUEUE_LENGTH];
+    std::atomic<uint32_t> queue_write;
+    std::atomic<uint32_t> queue_read;
+    hal_mutex_t lock;
+
+    // Audio task only
+    audio_synth_voice_t voices[AUDIO_SYNTH_MAX_VOICES];
+    uint32_t active_voices;
+    int32_t mix[AUDIO_SYNTH_CHUNK_FRAMES * 2];
+    uint32_t voice_steals;
+} audio_synth_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// max_voices 0 = AUDIO_SYNTH_DEFAULT_VOICES, clamped to AUDIO_SYNTH_MAX_VOICES
+bool audio_synth_init(audio_synth_t* synth, uint32_t sample_rate, uint32_t max_voices);
+void audio_synth_deinit(audio_synth_t* synth);
+
+// Any task. The notes of one call are picked up together, so their delays are
+// relative to the same frame. False when the queue cannot take them all.
+bool audio_synth_post(audio_synth_t* synth, const audio_synth_note_t* notes, size_t count);
+
+// Audio task. Starts posted notes, then adds frames of every voice, scaled by
+// gain_q15, to interleaved stereo out with saturation. A new note takes a free
+// voice, else the quietest releasing one, else the quietest.
+void audio_synth_render(audio_synth_t* synth, int16_t* out, uint32_t frames, int32_t gain_q15);
+bool audio_synth_is_active(const audio_synth_t* synth);    // Sounding, scheduled or posted
+void audio_synth_stop_all(audio_synth_t* synth);            // Audio task; drops the posted notes too
+
+// Defaults for a short UI beep: sine, 5 ms attack, full sustain, 20 ms release
+void audio_synth_note_beep(audio_synth_note_t* note, uint32_t frequency_hz, uint32_t duration_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +23,8 @@ extern "C" {
 #define HAL_AUDIO_DEFAULT_SAMPLE_RATE HAL_AUDIO_SAMPLE_RATE_44KHZ
 #define HAL_AUDIO_MAX_VOLUME         100
 #define HAL_AUDIO_DEFAULT_VOLUME     50
+#define HAL_AUDIO_CHANNELS           2      // Output is always interleaved stereo
+#define HAL_AUDIO_DEFAULT_BUFFER_FRAMES 4096 // ~93ms at 44.1kHz
 
 // Audio formats
 typedef enum {
@@ -54,7 +57,7 @@ typedef struct {
     hal_audio_format_t format;      // Audio format
     uint8_t volume;                 // Volume (0-100)
     bool loop;                      // Loop playback
-    uint16_t buffer_size;           // Buffer size in samples
+    uint16_t buffer_size;           // Buffer size in samples (0 = HAL_AUDIO_DEFAULT_BUFFER_FRAMES frames)
 } hal_audio_config_t;
 
 // Audio callback function types
@@ -107,10 +110,23 @@ void hal_audio_set_data_callback(hal_audio_data_callback_t callback, void* user_
 void hal_audio_clear_callbacks(void);
 
 // Buffer management for streaming
+// Counts are int16 samples of interleaved stereo (2 samples per frame). Writes are
+// all-or-nothing: a write that does not fit is rejected and counted as an overrun.
+// Only one task may write at a time.
 bool hal_audio_write_samples(const int16_t* samples, size_t count);
+bool hal_audio_wait_for_space(size_t count, uint32_t timeout_ms);  // Block until count samples fit
 size_t hal_audio_get_buffer_free_space(void);
 size_t hal_audio_get_buffer_used_space(void);
 void hal_audio_flush_buffer(void);
+void hal_audio_end_stream(void);               // Producer is done: the rest drains without counting an underrun
+
+// Playback clock: free-running stereo frame counts since init, wrapping at
+// 2^32 (compare by difference), lock-free from any task. Played advances as
+// the DAC finishes frames (DMA completions; the sink's reads on host), and a
+// flush counts the frames it drops as played, so it meets written whenever
+// the output drains. Unlike the stats, never reset.
+uint32_t hal_audio_get_frames_written(void);
+uint32_t hal_audio_get_frames_played(void);
 
 // Audio effects and processing
 void hal_audio_set_equalizer(const float* bands, size_t band_count);  // 10-band EQ
@@ -136,10 +152,31 @@ void hal_audio_set_deemphasis(bool enabled);   // De-emphasis filter
 void hal_audio_set_filter_mode(uint8_t mode);  // Digital filter mode
 
 // Performance and debugging
+// samples_played counts stereo frames handed to the DAC (or host sink)
 void hal_audio_get_stats(uint32_t* samples_played, uint32_t* underruns, uint32_t* overruns);
 void hal_audio_reset_stats(void);
 bool hal_audio_self_test(void);                // Hardware self-test
 
+// Output deadline monitor: every refill of the DAC (one DMA buffer; one sink
+// period on host) is timed while a stream plays in real time. Slack is the
+// audio still queued ahead of the DAC at the refill. Bin 0 counts values below
+// HAL_AUDIO_DEADLINE_BIN0_US, each next bin doubles, and the last is open.
+#define HAL_AUDIO_DEADLINE_BINS      12
+#define HAL_AUDIO_DEADLINE_BIN0_US   256
+
+typedef struct {
+    uint32_t period_us;                         // Audio per refill
+    uint32_t periods;                           // Refills recorded
+    uint32_t misses;                            // Refills that came after the DAC ran dry
+    uint32_t min_slack_us;                      // UINT32_MAX before the first refill
+    uint32_t max_interval_us;                   // Longest gap between two refills
+    uint32_t slack_bins[HAL_AUDIO_DEADLINE_BINS];
+    uint32_t interval_bins[HAL_AUDIO_DEADLINE_BINS];
+} hal_audio_deadline_stats_t;
+
+void hal_audio_get_deadline_stats(hal_audio_deadline_stats_t* stats);
+void hal_audio_reset_deadline_stats(void);
+
 // Error handling
 typedef enum {
     HAL_AUDIO_ERROR_NONE = 0,
@@ -155,6 +192,30 @@ typedef enum {
 hal_audio_error_t hal_audio_get_last_error(void);
 const char* hal_audio_get_error_string(hal_audio_error_t error);
 
+// Host emulation controls (PLATFORM_HOST only)
+// The sink thread hands every period to one of these instead of a DAC
+typedef enum {
+    HAL_AUDIO_HOST_SINK_NULL = 0,           // Discard (counted in the stats only)
+    HAL_AUDIO_HOST_SINK_MEMORY,             // Append to an in-memory buffer
+    HAL_AUDIO_HOST_SINK_WAV_FILE            // 16-bit stereo WAV at a host filesystem path
+} hal_audio_host_sink_t;
+
+// Defaults to a WAV file at $IZOD_AUDIO_WAV, else NULL. hal_audio_deinit() or the
+// next call finalizes a WAV file; memory contents are kept until cleared.
+bool hal_audio_host_set_sink(hal_audio_host_sink_t sink, const char* wav_path);
+hal_audio_host_sink_t hal_audio_host_get_sink(void);
+// Offline: the sink takes frames as fast as they are written instead of at the
+// sample clock, and waits for the producer rather than underrunning. Defaults
+// to $IZOD_AUDIO_OFFLINE.
+void hal_audio_host_set_offline(bool offline);
+bool hal_audio_host_is_offline(void);
+// Memory sink contents in int16 samples of interleaved stereo
+size_t hal_audio_host_get_memory_samples(void);
+size_t hal_audio_host_copy_memory(int16_t* out, size_t offset, size_t count);
+void hal_audio_host_clear_memory(void);
+// Blocks until the stream has ended and every written frame reached the sink
+bool hal_audio_host_wait_drained(uint32_t timeout_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,6 +16,7 @@ extern "C" {
 // Display configuration constants
 #define HAL_DISPLAY_WIDTH  240
 #define HAL_DISPLAY_HEIGHT 320
+#define HAL_DISPLAY_TILE_ROWS 32        // Full-width rows per offscreen tile; two are in use at once
 
 // Color definitions (16-bit RGB565)
 #define HAL_COLOR_BLACK   0x0000
@@ -98,16 +100,19 @@ void hal_display_draw_bitmap(int16_t x, int16_t y, const uint8_t* bitmap,
                             int16_t w, int16_t h, uint16_t color);
 void hal_display_draw_rgb_bitmap(int16_t x, int16_t y, const uint16_t* bitmap, int16_t w, int16_t h);
 
-// Buffer operations (for efficient updates)
+// Buffer operations (kept for callers; every call is buffered now)
 void hal_display_start_write(void);
 void hal_display_end_write(void);
 void hal_display_write_pixel(int16_t x, int16_t y, uint16_t color);
 void hal_display_write_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
 
 // Display refresh and synchronization
+// Drawing calls are recorded, not sent: update() renders what changed since the
+// last update into RAM tiles and queues each one for the panel while it renders
+// the next. Nothing reaches the panel before update().
 void hal_display_update(void);          // Push changes to display
-void hal_display_vsync(void);           // Wait for vertical sync
-bool hal_display_is_busy(void);         // Check if display is busy
+void hal_display_vsync(void);           // Wait until every queued tile is on the panel
+bool hal_display_is_busy(void);         // Tiles still being transferred
 
 // Color utilities
 uint16_t hal_display_color565(uint8_t r, uint8_t g, uint8_t b);
@@ -117,6 +122,21 @@ void hal_display_color565_to_rgb(uint16_t color, uint8_t* r, uint8_t* g, uint8_t
 void hal_display_get_stats(uint32_t* frames_rendered, uint32_t* pixels_drawn);
 void hal_display_reset_stats(void);
 
+typedef struct {
+    uint32_t frames;                    // Updates that sent anything
+    uint32_t tiles;                     // Tiles (address windows) sent
+    uint64_t bytes;                     // Pixel bytes sent
+    uint32_t last_frame_bytes;          // Bytes sent by the latest such update
+    uint32_t dropped_ops;               // Drawing calls that did not fit the display list
+} hal_display_tile_stats_t;
+
+void hal_display_get_tile_stats(hal_display_tile_stats_t* stats);
+void hal_display_reset_tile_stats(void);
+
+// Host emulation controls (PLATFORM_HOST only)
+// The in-memory panel, width * height pixels row-major; what it shows after hal_display_vsync()
+size_t hal_display_host_copy_panel(uint16_t* out, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -211,6 +211,13 @@ const char* hal_storage_get_error_string(hal_storage_error_t error);
 bool hal_storage_self_test(void);
 bool hal_storage_check_filesystem(bool repair);
 
+// Host emulation controls (PLATFORM_HOST only)
+// Card paths ("/Music/a.wav") resolve under this directory; defaults to $IZOD_SD_ROOT or ./sdcard
+void hal_storage_host_set_root(const char* directory);
+const char* hal_storage_host_get_root(void);
+// Added to every read, to emulate a slow card
+void hal_storage_host_set_read_latency_us(uint32_t latency_us);
+
 #ifdef __cplusplus
 }
 #endif
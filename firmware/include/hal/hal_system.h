@@ -136,6 +136,8 @@ void* hal_system_malloc(size_t size);
 void* hal_system_calloc(size_t num, size_t size);
 void* hal_system_realloc(void* ptr, size_t size);
 void hal_system_free(void* ptr);
+void* hal_system_malloc_psram(size_t size);     // Prefers PSRAM, falls back to internal heap
+uint32_t hal_system_get_alloc_count(void);      // Allocation calls above since boot (leak and churn checks)
 
 // System reset and power control
 void hal_system_reset(void);
@@ -166,7 +168,7 @@ hal_task_handle_t hal_system_create_task(hal_task_function_t function,
                                          uint32_t stack_size,
                                          void* parameters,
                                          hal_task_priority_t priority);
-void hal_system_delete_task(hal_task_handle_t task);
+void hal_system_delete_task(hal_task_handle_t task);   // NULL = calling task
 void hal_system_suspend_task(hal_task_handle_t task);
 void hal_system_resume_task(hal_task_handle_t task);
 void hal_system_yield(void);
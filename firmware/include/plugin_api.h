@@ -21,9 +21,9 @@ extern "C" {
 // Plugin System Version and Compatibility
 // =============================================================================
 #define PLUGIN_API_VERSION_MAJOR    1
-#define PLUGIN_API_VERSION_MINOR    0
+#define PLUGIN_API_VERSION_MINOR    1
 #define PLUGIN_API_VERSION_PATCH    0
-#define PLUGIN_API_VERSION_STRING   "1.0.0"
+#define PLUGIN_API_VERSION_STRING   "1.1.0"
 
 // Plugin compatibility flags
 #define PLUGIN_COMPAT_TOUCH_WHEEL   (1 << 0)
@@ -178,6 +178,21 @@ typedef struct {
     uint16_t height;
 } plugin_display_hal_t;
 
+// Audio output deadline monitor (API 1.1): timing of every DAC refill while
+// music plays. Slack is the audio still queued ahead of the DAC at a refill;
+// bin 0 counts values below 256 us and each next bin doubles, the last open.
+#define PLUGIN_AUDIO_DEADLINE_BINS  12
+
+typedef struct {
+    uint32_t period_us;            // Audio per refill
+    uint32_t periods;              // Refills recorded
+    uint32_t misses;               // Refills that came after the DAC ran dry
+    uint32_t min_slack_us;         // UINT32_MAX before the first refill
+    uint32_t max_interval_us;      // Longest gap between two refills
+    uint32_t slack_bins[PLUGIN_AUDIO_DEADLINE_BINS];
+    uint32_t interval_bins[PLUGIN_AUDIO_DEADLINE_BINS];
+} plugin_audio_deadline_t;
+
 // Audio HAL
 typedef struct {
     bool (*play_tone)(uint16_t frequency, uint32_t duration_ms);
@@ -189,6 +204,7 @@ typedef struct {
     void (*set_volume)(uint8_t volume);
     uint8_t (*get_volume)(void);
     bool (*is_playing)(void);
+    bool (*get_deadline_stats)(plugin_audio_deadline_t* stats, bool reset);  // API 1.1; reset starts a new window
 } plugin_audio_hal_t;
 
 // Storage HAL
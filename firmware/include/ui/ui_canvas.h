@@ -0,0 +1,62 @@
+/*
+ * UI Canvas
+ * Clipped RGB565 drawing into a RAM band that covers part of the screen
+ *
+ * The compositor paints a frame a band at a time. A canvas maps a rectangle
+ * of screen coordinates onto a pixel buffer and every primitive clips to it,
+ * so a screen draws everything in screen coordinates and only the pixels
+ * inside the band are touched. Text is laid out in the Adafruit GFX classic
+ * font's 6x8 cells scaled by an integer size, drawn without a background,
+ * so screens measure as they did when they drew on the panel directly. Size
+ * 1 is the classic 5x7 font; sizes with an atlas (ui/ui_font.h) draw its
+ * anti-aliased glyphs in the same cells instead of scaled-up pixels.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/ui_damage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_FONT_CELL_W  6                   // Glyph columns plus spacing, at size 1
+#define UI_FONT_CELL_H  8
+
+typedef struct {
+    uint16_t* pixels;                       // rect.w * rect.h, row-major
+    ui_rect_t rect;                         // Screen area the pixels hold
+} ui_canvas_t;
+
+void ui_canvas_init(ui_canvas_t* canvas, uint16_t* pixels, ui_rect_t rect);
+
+void ui_canvas_fill(ui_canvas_t* canvas, uint16_t color);
+void ui_canvas_fill_rect(ui_canvas_t* canvas, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+void ui_canvas_hline(ui_canvas_t* canvas, int16_t x, int16_t y, int16_t w, uint16_t color);
+void ui_canvas_vline(ui_canvas_t* canvas, int16_t x, int16_t y, int16_t h, uint16_t color);
+void ui_canvas_rect(ui_canvas_t* canvas, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);  // Outline
+void ui_canvas_pixel(ui_canvas_t* canvas, int16_t x, int16_t y, uint16_t color);
+
+// Same pixels as the Adafruit GFX primitives of the same names
+void ui_canvas_line(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+void ui_canvas_circle(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t r, uint16_t color);
+void ui_canvas_fill_circle(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t r, uint16_t color);
+void ui_canvas_triangle(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                        int16_t x2, int16_t y2, uint16_t color);
+void ui_canvas_fill_triangle(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                             int16_t x2, int16_t y2, uint16_t color);
+
+// 1-bit rows, MSB first and padded to a byte, set bits in color; RGB565 rows, row-major
+void ui_canvas_bitmap(ui_canvas_t* canvas, int16_t x, int16_t y, const uint8_t* bitmap,
+                      int16_t w, int16_t h, uint16_t color);
+void ui_canvas_rgb_bitmap(ui_canvas_t* canvas, int16_t x, int16_t y, const uint16_t* pixels, int16_t w, int16_t h);
+
+// Single line, stopping at a newline; returns the x just past the last cell
+int16_t ui_canvas_text(ui_canvas_t* canvas, int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size);
+ui_rect_t ui_text_bounds(int16_t x, int16_t y, const char* text, uint8_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,81 @@
+/*
+ * UI Compositor
+ * Repaints only the damaged parts of the screen, a RAM band at a time, and pushes them to the panel
+ *
+ * Screens no longer clear the panel and redraw everything for each change.
+ * A change invalidates the rectangles it affects; at the next flush the
+ * compositor takes the merged damage list and, for each rectangle, paints
+ * the scene into a band buffer and hands the finished pixels to the panel's
+ * push callback as one address window. Nothing outside the damage goes over
+ * SPI, and the panel never shows a cleared region waiting to be redrawn.
+ * A panel that transfers asynchronously (DMA, or a flush task) gets two
+ * bands: the compositor paints the next one while the last is in flight.
+ *
+ * Not thread-safe: the caller serializes invalidation and flushes, as it
+ * already does for panel access.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/ui_damage.h"
+#include "ui/ui_canvas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_COMPOSITOR_BAND_ROWS    16      // Full-width rows per band; narrower windows take more
+
+// Paints the whole scene in screen coordinates; the canvas clips it to the band
+typedef void (*ui_paint_fn_t)(ui_canvas_t* canvas, void* user_data);
+// Sends rect->w * rect->h pixels, row-major, to that window of the panel
+typedef void (*ui_push_fn_t)(const ui_rect_t* rect, const uint16_t* pixels, void* user_data);
+// Blocks until the oldest push still in flight is done with its pixels
+typedef void (*ui_wait_fn_t)(void* user_data);
+
+typedef struct {
+    ui_push_fn_t push;
+    ui_wait_fn_t wait;                      // NULL when push returns with the pixels sent
+    void* user_data;
+} ui_panel_t;
+
+typedef struct {
+    uint32_t frames;                        // Flushes that pushed anything
+    uint32_t windows;                       // Address windows pushed
+    uint64_t pixels;                        // Pixels pushed
+    uint32_t last_pixels;                   // Pixels pushed by the latest such flush
+} ui_compositor_stats_t;
+
+typedef struct {
+    ui_damage_t damage;
+    uint16_t* bands[2];                     // The second only for an asynchronous panel
+    bool in_flight[2];
+    uint32_t band_count;
+    uint32_t next_band;
+    uint32_t band_pixels;                   // Band capacity: width * band rows
+    uint16_t background;                    // Every band starts from this color
+    ui_panel_t panel;
+    ui_compositor_stats_t stats;
+} ui_compositor_t;
+
+bool ui_compositor_init(ui_compositor_t* compositor, int16_t width, int16_t height, uint16_t band_rows,
+                        uint16_t background, const ui_panel_t* panel);
+void ui_compositor_deinit(ui_compositor_t* compositor);         // Waits for the panel first
+
+void ui_compositor_invalidate(ui_compositor_t* compositor, ui_rect_t rect);
+void ui_compositor_invalidate_all(ui_compositor_t* compositor);
+bool ui_compositor_is_dirty(const ui_compositor_t* compositor);
+
+// Repaints and pushes the damage, then clears it; returns the pixels pushed.
+// The last bands may still be in flight on return.
+uint32_t ui_compositor_flush(ui_compositor_t* compositor, ui_paint_fn_t paint, void* paint_user_data);
+void ui_compositor_sync(ui_compositor_t* compositor);            // Waits for every push in flight
+
+void ui_compositor_get_stats(const ui_compositor_t* compositor, ui_compositor_stats_t* stats);
+void ui_compositor_reset_stats(ui_compositor_t* compositor);
+
+#ifdef __cplusplus
+}
+#endif
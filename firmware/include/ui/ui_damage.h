@@ -0,0 +1,53 @@
+/*
+ * UI Damage Tracking
+ * The screen rectangles invalidated since the last frame, merged into a few panel windows
+ *
+ * Whatever changes what part of the screen should show adds that part here,
+ * and the compositor repaints and transmits only the list. Two rectangles
+ * are merged as they are added when their bounding box costs no more than
+ * sending both, counting UI_DAMAGE_MERGE_SLACK_PX for the window saved, so
+ * overlapping ones in an L shape may stay apart. Once the list is full a new
+ * rectangle joins the one it grows least, so a frame never needs more than
+ * UI_DAMAGE_MAX_RECTS address windows however much changed.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_DAMAGE_MAX_RECTS        16
+#define UI_DAMAGE_MERGE_SLACK_PX   32      // Extra pixels worth sending to save a window setup
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+} ui_rect_t;
+
+bool ui_rect_is_empty(ui_rect_t rect);
+uint32_t ui_rect_area(ui_rect_t rect);
+ui_rect_t ui_rect_intersect(ui_rect_t a, ui_rect_t b);
+ui_rect_t ui_rect_union(ui_rect_t a, ui_rect_t b);         // Bounding box; an empty side is ignored
+
+typedef struct {
+    ui_rect_t screen;
+    ui_rect_t rects[UI_DAMAGE_MAX_RECTS];
+    uint32_t count;
+} ui_damage_t;
+
+void ui_damage_init(ui_damage_t* damage, int16_t width, int16_t height);
+void ui_damage_clear(ui_damage_t* damage);
+void ui_damage_add(ui_damage_t* damage, ui_rect_t rect);   // Clipped to the screen
+void ui_damage_add_screen(ui_damage_t* damage);
+bool ui_damage_is_empty(const ui_damage_t* damage);
+uint32_t ui_damage_area(const ui_damage_t* damage);        // Pixels the list repaints
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,98 @@
+/*
+ * UI Display List
+ * Drawing calls recorded since the last clear, replayed a tile at a time
+ *
+ * Immediate-mode drawing (the hal_display API) keeps no framebuffer: every
+ * call is recorded here with the screen area it can touch, and the tiled
+ * renderer repaints a tile by replaying the list clipped to it. A clear
+ * starts the list over. Before each flush the list is compared, call by
+ * call, with the one the panel last showed; a pixel can only change if some
+ * call that covers it differs, so the areas of the differing calls are the
+ * frame's damage. A plugin that clears and redraws every frame therefore
+ * sends only what actually moved. An opaque fill retires the earlier calls
+ * it covers, so an overlay redrawn in place without a clear does not grow
+ * the list.
+ *
+ * Text is copied into the list. Bitmaps are not: they are read whenever the
+ * list is replayed, so they must stay valid until the next clear (in
+ * practice, images in flash).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ui/ui_damage.h"
+#include "ui/ui_canvas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_DISPLAY_LIST_MAX_OPS     256
+#define UI_DISPLAY_LIST_TEXT_BYTES  2048
+
+typedef enum {
+    UI_OP_CLEAR = 0,
+    UI_OP_FILL_RECT,
+    UI_OP_RECT,
+    UI_OP_LINE,
+    UI_OP_CIRCLE,
+    UI_OP_FILL_CIRCLE,
+    UI_OP_TRIANGLE,
+    UI_OP_FILL_TRIANGLE,
+    UI_OP_TEXT,
+    UI_OP_BITMAP,
+    UI_OP_RGB_BITMAP
+} ui_op_kind_t;
+
+typedef struct {
+    uint8_t kind;                           // ui_op_kind_t
+    uint8_t size;                           // Text scale
+    uint16_t color;
+    int16_t v[6];                           // Coordinates, as the matching ui_canvas call takes them
+    ui_rect_t bounds;                       // Everything the call can touch
+    uint32_t hash;                          // Text and bitmap contents
+    const void* data;                       // Text in the list's arena, or the caller's bitmap
+} ui_op_t;
+
+typedef struct {
+    ui_op_t* ops;
+    uint32_t count;
+    uint32_t max_ops;
+    char* text;                             // Arena for copied text; NULL for a snapshot
+    uint32_t text_used;
+    uint32_t text_bytes;
+    uint32_t dropped;                       // Calls that did not fit since the last clear
+} ui_display_list_t;
+
+// A snapshot (for diffing only) takes no text arena: pass text_bytes 0
+bool ui_display_list_init(ui_display_list_t* list, uint32_t max_ops, uint32_t text_bytes);
+void ui_display_list_deinit(ui_display_list_t* list);
+
+// Recording; each returns false when the list is full and the call was dropped
+void ui_display_list_clear(ui_display_list_t* list, uint16_t color);
+bool ui_display_list_fill_rect(ui_display_list_t* list, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+bool ui_display_list_rect(ui_display_list_t* list, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+bool ui_display_list_line(ui_display_list_t* list, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+bool ui_display_list_circle(ui_display_list_t* list, int16_t x, int16_t y, int16_t r, uint16_t color, bool filled);
+bool ui_display_list_triangle(ui_display_list_t* list, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              int16_t x2, int16_t y2, uint16_t color, bool filled);
+bool ui_display_list_text(ui_display_list_t* list, int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size);
+bool ui_display_list_bitmap(ui_display_list_t* list, int16_t x, int16_t y, const uint8_t* bitmap,
+                            int16_t w, int16_t h, uint16_t color);
+bool ui_display_list_rgb_bitmap(ui_display_list_t* list, int16_t x, int16_t y, const uint16_t* pixels,
+                                int16_t w, int16_t h);
+
+// Replays every call, clipped to the canvas
+void ui_display_list_paint(const ui_display_list_t* list, ui_canvas_t* canvas);
+
+// Adds the areas where after can differ from before on screen
+void ui_display_list_diff(const ui_display_list_t* before, const ui_display_list_t* after, ui_damage_t* damage);
+// Copies the calls (not the text) for the next diff
+void ui_display_list_snapshot(const ui_display_list_t* from, ui_display_list_t* to);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,63 @@
+/*
+ * UI Font
+ * Pre-rasterized glyph atlases and the span blitter that draws them
+ *
+ * Fonts are converted offline by tools/font_atlas.py into packed 1, 2 or
+ * 4-bit alpha bitmaps, trimmed to each glyph's ink, with a compact metrics
+ * table. Drawing walks each glyph row as spans: transparent runs are
+ * skipped, fully covered runs are filled, and only edge pixels are blended
+ * with what is already in the canvas, so there is no per-pixel scaling as
+ * with the classic font at text size 2 and up.
+ *
+ * The built-in atlases are DejaVu Sans Mono in the classic font's cells at
+ * sizes 2 and 3 (12x16 and 18x24), so text measures exactly as before.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/ui_canvas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint16_t offset;                        // First byte in the atlas bitmap
+    uint8_t w, h;                           // Ink box; rows start on a byte
+    int8_t x, y;                            // Ink box from the pen position and the line top
+    uint8_t advance;
+} ui_glyph_t;
+
+typedef struct {
+    const uint8_t* bitmap;
+    const ui_glyph_t* glyphs;               // first..last
+    uint8_t first, last;
+    uint8_t bpp;                            // 1, 2 or 4
+    uint8_t line_height;
+    uint8_t baseline;                       // Row from the line top
+} ui_font_t;
+
+extern const ui_font_t ui_font_mono_16;     // Classic size 2 cells
+extern const ui_font_t ui_font_mono_24;     // Classic size 3 cells
+
+// Atlas that replaces the classic font at a text size; NULL to scale the classic font
+const ui_font_t* ui_font_for_size(uint8_t size);
+
+// Single line, stopping at a newline, blended over the canvas; returns the x past the last glyph
+int16_t ui_font_draw(ui_canvas_t* canvas, int16_t x, int16_t y, const char* text,
+                     const ui_font_t* font, uint16_t color);
+int16_t ui_font_text_width(const ui_font_t* font, const char* text);
+
+// RGB565 blend; alpha 0 (bg) to 32 (fg)
+static inline uint16_t ui_blend565(uint16_t fg, uint16_t bg, uint32_t alpha) {
+    uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81Fu;
+    uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81Fu;
+    uint32_t mix = ((f * alpha + b * (32 - alpha)) >> 5) & 0x07E0F81Fu;
+    return (uint16_t)((mix >> 16) | mix);
+}
+
+#ifdef __cplusplus
+}
+#endif
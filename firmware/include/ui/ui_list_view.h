@@ -0,0 +1,105 @@
+/*
+ * UI List View
+ * A virtualized list: only the rows in view, and a few either side, exist as pixels
+ *
+ * A library list can run to tens of thousands of rows, far more than can be
+ * kept as strings, let alone drawn. The view asks a data source for a row's
+ * label only when the row comes within the overscan window around what is
+ * shown, and renders it once into a row buffer. The buffers form a ring
+ * indexed by row number, so a buffer is recycled for the row entering on one
+ * side as a row leaves on the other. Painting copies finished rows into the
+ * band, so scrolling one row shifts the rows already rendered and draws only
+ * the one that came in, which the overscan has usually rendered ahead of time.
+ *
+ * Rows are drawn as a ui_list_t list draws them: background, the selection
+ * marker, then the label in size 1. The background should be the color the
+ * view sits on; past the last row the view leaves the band untouched.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/ui_canvas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_LIST_VIEW_TEXT_MAX   48          // Longest label kept, terminator included
+#define UI_LIST_VIEW_OVERSCAN   2           // Default rows rendered ahead on each side
+#define UI_LIST_VIEW_NO_ROW     UINT32_MAX
+
+// Writes the label of row `index` into text (UI_LIST_VIEW_TEXT_MAX bytes); rows are asked
+// for in ascending runs, so a source paging from an index can keep its current page
+typedef void (*ui_list_source_fn_t)(uint32_t index, char* text, void* user_data);
+
+typedef struct {
+    uint32_t index;                         // Row held; UI_LIST_VIEW_NO_ROW when free
+    bool selected;                          // As rendered
+    char text[UI_LIST_VIEW_TEXT_MAX];
+    uint16_t* pixels;                       // width * row_h, row-major
+} ui_list_slot_t;
+
+typedef struct {
+    uint32_t fetches;                       // Labels asked of the source
+    uint32_t renders;                       // Rows rendered into a buffer
+    uint32_t blits;                         // Row copies into bands
+    uint32_t scrolls;
+} ui_list_view_stats_t;
+
+typedef struct {
+    ui_list_source_fn_t source;
+    void* user_data;
+    uint32_t count;                         // Rows in the list
+    uint32_t top;                           // Row at the top edge
+    uint32_t selected;                      // UI_LIST_VIEW_NO_ROW for none
+
+    int16_t width;                          // View size in pixels
+    int16_t height;
+    int16_t row_h;
+    uint16_t visible_rows;                  // Rows the height touches
+    uint16_t overscan;
+    uint16_t slot_count;                    // Visible rows and the overscan on both sides
+
+    // Row look, as ui_list_t; set before the first paint or reset the rows after
+    int16_t marker_w;
+    int16_t marker_h;
+    int16_t text_x;
+    int16_t text_y;
+    uint16_t color;
+    uint16_t selected_color;
+    uint16_t background;
+
+    ui_list_slot_t* slots;                  // Ring indexed by row % slot_count; the pixels follow
+    ui_list_view_stats_t stats;
+} ui_list_view_t;
+
+bool ui_list_view_init(ui_list_view_t* view, int16_t width, int16_t height, int16_t row_h, uint16_t overscan,
+                       uint16_t color, uint16_t selected_color, uint16_t background);
+void ui_list_view_deinit(ui_list_view_t* view);
+
+// A new source or row count; drops every rendered row and scrolls back to the top
+void ui_list_view_set_source(ui_list_view_t* view, ui_list_source_fn_t source, void* user_data, uint32_t count);
+void ui_list_view_reset(ui_list_view_t* view);                  // Renders every row again when shown
+
+// Clamped so the last row can reach the bottom edge and no further; true when the top moved
+bool ui_list_view_scroll_to(ui_list_view_t* view, uint32_t top);
+// Selects a row and scrolls the least that shows it in full; true when the top moved
+bool ui_list_view_select(ui_list_view_t* view, uint32_t index);
+
+// Renders the rows of the overscan window not yet rendered, so the next scroll only copies
+void ui_list_view_prefetch(ui_list_view_t* view);
+
+// Copies the rows crossing the canvas, with the view's top left at (x, y)
+void ui_list_view_paint(ui_list_view_t* view, ui_canvas_t* canvas, int16_t x, int16_t y);
+
+// Where a row shows, relative to the view's top left; empty when it is out of view
+ui_rect_t ui_list_view_row_rect(const ui_list_view_t* view, uint32_t index);
+
+void ui_list_view_get_stats(const ui_list_view_t* view, ui_list_view_stats_t* stats);
+void ui_list_view_reset_stats(ui_list_view_t* view);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+/*
+ * UI Screens
+ * Splash, Home, Music and Now Playing layouts, painted through the compositor
+ *
+ * A screen is a model shown through a retained widget tree
+ * (ui/ui_widget.h). Showing a model sets the widgets from it, and each
+ * setter invalidates only what it changed: the two menu rows a selection
+ * moves between, the toast line, the elapsed time and the stretch of the
+ * progress bar that moved. Switching screens invalidates the whole panel.
+ * The selection is an accent marker and label rather than a filled bar
+ * across the row, so a menu step repaints the labels only. Labels are drawn
+ * through a text cache (ui/ui_text_cache.h), so a band that crosses them
+ * copies finished pixels instead of rasterizing them again.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/ui_compositor.h"
+#include "ui/ui_text_cache.h"
+#include "ui/ui_widget.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Colors
+#define UI_COLOR_BG      0x0000
+#define UI_COLOR_FG      0xFFFF
+#define UI_COLOR_HI      0x07E0
+#define UI_COLOR_ACCENT  0xFBE0
+
+#define UI_SCREEN_TEXT_MAX  48              // Longest line kept, terminator included
+
+typedef enum {
+    UI_SCREEN_NONE = 0,                     // Blank panel
+    UI_SCREEN_SPLASH,
+    UI_SCREEN_HOME,
+    UI_SCREEN_MUSIC,
+    UI_SCREEN_NOW_PLAYING
+} ui_screen_id_t;
+
+typedef struct {
+    ui_screen_id_t screen;
+    int selected;                           // Home and Music: highlighted row
+    char toast[UI_SCREEN_TEXT_MAX];         // Status line under the header, "" for none
+
+    // Now Playing
+    char title[UI_SCREEN_TEXT_MAX];
+    char artist[UI_SCREEN_TEXT_MAX];
+    uint32_t elapsed_s;
+    uint32_t duration_s;
+    float progress;                         // 0.0-1.0
+
+    // Splash
+    char company[UI_SCREEN_TEXT_MAX];
+    char firmware[UI_SCREEN_TEXT_MAX];
+    char version[UI_SCREEN_TEXT_MAX];
+    char badge[UI_SCREEN_TEXT_MAX];
+    uint16_t badge_color;
+} ui_screen_model_t;
+
+typedef struct {
+    ui_compositor_t* compositor;
+    ui_screen_model_t shown;                // What the panel shows
+    ui_text_cache_t text_cache;
+    ui_tree_t tree;
+
+    // Widgets, one container per layout
+    ui_widget_t root;
+    ui_widget_t header;
+    ui_widget_t toast;
+    ui_widget_t menu, menu_list, menu_art, menu_art_label;
+    ui_widget_t now_playing, np_art, np_art_label, np_title, np_artist, np_progress, np_elapsed, np_duration;
+    ui_widget_t splash, splash_company, splash_firmware, splash_version, splash_badge;
+} ui_screens_t;
+
+void ui_screens_init(ui_screens_t* screens, ui_compositor_t* compositor);
+void ui_screens_deinit(ui_screens_t* screens);
+
+// Sets the widgets from the model, then repaints what they invalidated; returns the pixels pushed
+uint32_t ui_screens_show(ui_screens_t* screens, const ui_screen_model_t* model);
+
+// Rows of a menu screen's list, 0 for other screens
+int ui_screens_menu_count(ui_screen_id_t screen);
+
+// Copies a string into a model field, truncating to fit
+void ui_screens_set_text(char* field, const char* text);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,82 @@
+/*
+ * UI Text Cache
+ * Recently drawn strings kept as ready-to-blit RGB565 runs
+ *
+ * Menu labels, headers and titles are drawn again every time a band they
+ * cross is repainted. The cache renders a string once, against the solid
+ * background it sits on, and keeps each row as runs of finished pixels:
+ * background gaps of a few pixels stay inside a run, longer ones split it.
+ * Drawing a cached string is then a clipped copy per run, with no glyph
+ * decoding or blending. Entries are evicted least recently used first when
+ * either the entry count or the byte budget runs out.
+ *
+ * A cached draw writes the background into the gaps inside its runs, so it
+ * is only for text over that solid background.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/ui_canvas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_TEXT_CACHE_ENTRIES    24
+#define UI_TEXT_CACHE_BYTES      (12 * 1024)   // Default budget for the runs of all entries
+#define UI_TEXT_CACHE_TEXT_MAX   48            // Longer strings are drawn directly
+#define UI_TEXT_CACHE_MAX_WIDTH  320           // As are wider ones
+#define UI_TEXT_CACHE_GAP_PX     4             // Shorter background gaps stay inside a run
+
+typedef struct {
+    int16_t x;                              // From the left of the string
+    uint16_t row;
+    uint16_t len;
+} ui_text_span_t;
+
+typedef struct {
+    char text[UI_TEXT_CACHE_TEXT_MAX];
+    uint16_t color;
+    uint16_t background;
+    uint8_t size;
+    bool used;
+    int16_t width;
+    uint32_t span_count;
+    ui_text_span_t* spans;                  // Row order; the pixels follow in one allocation
+    uint16_t* pixels;
+    uint32_t bytes;
+    uint32_t last_used;
+} ui_text_run_t;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;                        // Rendered and cached
+    uint32_t evictions;
+    uint32_t uncached;                      // Too long or wide, drawn directly
+    uint32_t bytes;                         // Held by the runs now
+} ui_text_cache_stats_t;
+
+typedef struct {
+    ui_text_run_t runs[UI_TEXT_CACHE_ENTRIES];
+    uint16_t* scratch;                      // One row of a string being cached
+    uint32_t budget;
+    uint32_t clock;                         // Draws so far, for the LRU order
+    ui_text_cache_stats_t stats;
+} ui_text_cache_t;
+
+bool ui_text_cache_init(ui_text_cache_t* cache, uint32_t budget_bytes);
+void ui_text_cache_deinit(ui_text_cache_t* cache);
+void ui_text_cache_clear(ui_text_cache_t* cache);
+
+// As ui_canvas_text over a background of that color, from the cache when it can be
+int16_t ui_text_cache_draw(ui_text_cache_t* cache, ui_canvas_t* canvas, int16_t x, int16_t y, const char* text,
+                           uint16_t color, uint16_t background, uint8_t size);
+
+void ui_text_cache_get_stats(const ui_text_cache_t* cache, ui_text_cache_stats_t* stats);
+void ui_text_cache_reset_stats(ui_text_cache_t* cache);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,49 @@
+/*
+ * UI Tiled Display
+ * Immediate-mode drawing rendered into RAM tiles and flushed to the panel on update
+ *
+ * The display HAL records each drawing call into a display list instead of
+ * sending it to the panel. An update compares the list with the one the
+ * panel last showed, renders the differing areas into full-width tiles with
+ * the compositor and pushes each finished tile while the next is rendered.
+ * Both display backends run this same path: the ESP32 one against the
+ * ST7789, the host one against an in-memory panel.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/ui_display_list.h"
+#include "ui/ui_compositor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    ui_display_list_t frame;                // Calls recorded since the last clear
+    ui_display_list_t shown;                // What the panel showed after the last update
+    ui_compositor_t compositor;
+    uint16_t tile_rows;
+    ui_panel_t panel;
+    bool full_repaint;                      // The panel content is unknown
+} ui_tiled_display_t;
+
+bool ui_tiled_display_init(ui_tiled_display_t* display, int16_t width, int16_t height, uint16_t tile_rows,
+                           const ui_panel_t* panel);
+void ui_tiled_display_deinit(ui_tiled_display_t* display);
+// New panel dimensions (a rotation); the next update repaints everything
+bool ui_tiled_display_resize(ui_tiled_display_t* display, int16_t width, int16_t height);
+
+// Sends what changed since the last update; returns the pixels pushed.
+// The last tiles may still be in flight on return.
+uint32_t ui_tiled_display_update(ui_tiled_display_t* display);
+void ui_tiled_display_sync(ui_tiled_display_t* display);
+
+// Color the recorded calls give the pixel, whether or not it was sent yet
+uint16_t ui_tiled_display_pixel(const ui_tiled_display_t* display, int16_t x, int16_t y);
+
+#ifdef __cplusplus
+}
+#endif
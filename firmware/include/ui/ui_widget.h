@@ -0,0 +1,193 @@
+/*
+ * UI Widgets
+ * A retained tree of boxes, labels, lists, progress bars, images and status bars
+ *
+ * Each widget keeps its screen bounds and the part of them it needs
+ * repainted. Setters change a property and record only the pixels it
+ * affects: a list selection invalidates the two rows it moves between, a
+ * progress bar the stretch its fill moved. A change of size or visibility
+ * marks the parent for layout, and the update lays out only the marked
+ * subtrees, invalidating the old and new bounds of whatever moved. The tree
+ * then paints through the compositor, and a band paints only the widgets it
+ * crosses, so nothing outside the damage is drawn.
+ *
+ * Widgets are caller-owned structs linked into the tree; the tree allocates
+ * nothing. It needs only a compositor, so the same tree renders headless on
+ * the host against an in-memory panel.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/ui_compositor.h"
+#include "ui/ui_text_cache.h"
+#include "ui/ui_list_view.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_WIDGET_TEXT_MAX      48          // Longest label kept, terminator included
+#define UI_WIDGET_DAMAGE_RECTS  2           // A list selection moves between two rows
+
+typedef enum {
+    UI_WIDGET_BOX = 0,                      // Container, optionally outlined
+    UI_WIDGET_LABEL,
+    UI_WIDGET_LIST,
+    UI_WIDGET_PROGRESS,
+    UI_WIDGET_IMAGE,
+    UI_WIDGET_STATUS_BAR,
+    UI_WIDGET_LIST_VIEW                     // A caller-owned virtualized list
+} ui_widget_type_t;
+
+typedef enum {
+    UI_LAYOUT_FIXED = 0,                    // Children at their frame offsets
+    UI_LAYOUT_COLUMN,                       // Top to bottom; frame.x indents, frame.y adds space above
+    UI_LAYOUT_ROW                           // Left to right; frame.y drops, frame.x adds space before
+} ui_layout_t;
+
+typedef enum {
+    UI_ALIGN_START = 0,
+    UI_ALIGN_CENTER,                        // Horizontally, in the parent's content
+    UI_ALIGN_END
+} ui_align_t;
+
+typedef struct {
+    bool outlined;
+    uint16_t color;
+} ui_box_t;
+
+typedef struct {
+    char text[UI_WIDGET_TEXT_MAX];
+    uint16_t color;
+    uint8_t size;
+} ui_label_t;
+
+typedef struct {
+    const char* const* items;
+    int count;
+    int selected;                           // -1 for none
+    int16_t row_h;
+    int16_t marker_w;                       // Accent bar left of the selected label
+    int16_t marker_h;
+    int16_t text_x;                         // Label offset from the left
+    int16_t text_y;
+    uint16_t color;
+    uint16_t selected_color;
+} ui_list_t;
+
+typedef struct {
+    float value;                            // 0.0-1.0
+    uint16_t color;                         // Outline
+    uint16_t fill_color;
+} ui_progress_t;
+
+typedef struct {
+    const uint16_t* pixels;                 // RGB565 w * h; NULL for an outlined placeholder
+    int16_t w;
+    int16_t h;
+    uint16_t color;                         // Placeholder outline
+} ui_image_t;
+
+typedef struct {
+    char title[UI_WIDGET_TEXT_MAX];         // Size 2, at the left
+    char info[UI_WIDGET_TEXT_MAX];          // Size 1, right-aligned
+    uint16_t color;
+    uint16_t rule_color;                    // Rule along the bottom row
+} ui_status_bar_t;
+
+typedef struct ui_widget ui_widget_t;
+
+struct ui_widget {
+    ui_widget_type_t type;
+    ui_widget_t* parent;
+    ui_widget_t* first_child;
+    ui_widget_t* next_sibling;
+
+    // Layout request, in the parent's content; a zero w or h takes the measured size
+    ui_rect_t frame;
+    ui_layout_t layout;                     // How the children are placed
+    ui_align_t align;
+    uint8_t padding;                        // Content inset on every side
+    uint8_t spacing;                        // Between children in a column or row
+    bool visible;
+
+    // Layout result and what needs doing at the next update
+    ui_rect_t bounds;                       // Screen pixels; empty while hidden
+    ui_rect_t damage[UI_WIDGET_DAMAGE_RECTS];   // Parts of the bounds to repaint
+    bool needs_layout;                      // Place the children again
+    bool child_dirty;                       // Layout or damage somewhere below
+
+    union {
+        ui_box_t box;
+        ui_label_t label;
+        ui_list_t list;
+        ui_progress_t progress;
+        ui_image_t image;
+        ui_status_bar_t status;
+        ui_list_view_t* list_view;
+    };
+};
+
+// Constructors: zero the widget and set its type, frame and look; visible, not yet in a tree
+void ui_widget_box(ui_widget_t* widget, ui_rect_t frame, ui_layout_t layout);
+void ui_widget_label(ui_widget_t* widget, ui_rect_t frame, const char* text, uint16_t color, uint8_t size);
+void ui_widget_list(ui_widget_t* widget, ui_rect_t frame, int16_t row_h, uint16_t color, uint16_t selected_color);
+void ui_widget_progress(ui_widget_t* widget, ui_rect_t frame, uint16_t color, uint16_t fill_color);
+void ui_widget_image(ui_widget_t* widget, ui_rect_t frame, const uint16_t* pixels, int16_t w, int16_t h,
+                     uint16_t color);
+void ui_widget_status_bar(ui_widget_t* widget, ui_rect_t frame, uint16_t color, uint16_t rule_color);
+void ui_widget_list_view(ui_widget_t* widget, ui_rect_t frame, ui_list_view_t* view);
+
+// Appends a child; the parent lays out again
+void ui_widget_add(ui_widget_t* parent, ui_widget_t* child);
+
+// Setters do nothing when the value is unchanged
+void ui_widget_set_visible(ui_widget_t* widget, bool visible);
+void ui_widget_set_frame(ui_widget_t* widget, ui_rect_t frame);
+void ui_widget_set_text(ui_widget_t* widget, const char* text);          // Label text, status bar title
+void ui_widget_set_info(ui_widget_t* widget, const char* text);          // Status bar
+void ui_widget_set_color(ui_widget_t* widget, uint16_t color);
+void ui_widget_set_items(ui_widget_t* widget, const char* const* items, int count);
+void ui_widget_set_selected(ui_widget_t* widget, int selected);
+void ui_widget_set_progress(ui_widget_t* widget, float value);
+void ui_widget_set_pixels(ui_widget_t* widget, const uint16_t* pixels);  // Image; invalidates all of it
+void ui_widget_invalidate(ui_widget_t* widget);                          // Repaint all of it
+
+// List view: a selection in view repaints two rows; a scroll repaints the view, copying the rows
+// it already holds, and renders the overscan ahead. Reload after changing the source or look.
+void ui_widget_list_view_select(ui_widget_t* widget, uint32_t index);
+void ui_widget_list_view_scroll(ui_widget_t* widget, uint32_t top);
+void ui_widget_list_view_reload(ui_widget_t* widget);
+
+// Screen area of one list row, marker and label, as it looks selected; empty outside the list
+ui_rect_t ui_widget_list_row_bounds(const ui_widget_t* widget, int row);
+
+typedef struct {
+    uint32_t updates;                       // Updates that pushed anything
+    uint32_t layouts;                       // Widgets placed
+    uint32_t moved;                         // Of those, widgets whose bounds changed
+    uint32_t paints;                        // Widgets painted, band by band
+    uint32_t last_paints;                   // By the latest update
+    uint32_t last_pixels;
+} ui_tree_stats_t;
+
+typedef struct {
+    ui_widget_t* root;                      // Its frame is its screen bounds
+    ui_compositor_t* compositor;
+    ui_text_cache_t* text_cache;            // Optional; for labels over the background
+    ui_tree_stats_t stats;
+} ui_tree_t;
+
+void ui_tree_init(ui_tree_t* tree, ui_widget_t* root, ui_compositor_t* compositor, ui_text_cache_t* text_cache);
+
+// Lays out the marked subtrees, invalidates the damage and flushes; returns the pixels pushed
+uint32_t ui_tree_update(ui_tree_t* tree);
+
+void ui_tree_get_stats(const ui_tree_t* tree, ui_tree_stats_t* stats);
+void ui_tree_reset_stats(ui_tree_t* tree);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,12 +3,7 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7789.h>
 #include "app_state.h"
-
-// Colors
-#define UI_COLOR_BG      0x0000
-#define UI_COLOR_FG      0xFFFF
-#define UI_COLOR_HI      0x07E0
-#define UI_COLOR_ACCENT  0xFBE0
+#include "ui/ui_screens.h"     // Colors, layouts and the compositor behind them
 
 void uiInit(Adafruit_ST7789* d, SemaphoreHandle_t* mtx);
 
@@ -19,4 +14,7 @@ void uiUpdateNowPlayingProgress();
 
 void uiToast(const char* msg);
 
+// Rows in the menu at the current level, as the screens lay it out
+int uiMenuItemCount();
+
 
@@ -33,6 +33,10 @@ typedef struct {
         uint32_t task_count;
     } metrics;
     
+    // Audio output deadlines since the window was last reset
+    plugin_audio_deadline_t deadline;
+    bool deadline_available;
+    
     // Performance history (last 60 samples)
     struct {
         uint32_t heap_history[60];
@@ -49,6 +53,7 @@ typedef struct {
         STATE_PERFORMANCE,
         STATE_HARDWARE,
         STATE_TASKS,
+        STATE_AUDIO,
         STATE_SETTINGS
     } ui_state;
     
@@ -68,11 +73,13 @@ static bool system_monitor_event_handler(plugin_context_t* ctx, uint32_t event,
 // Internal functions
 static void update_system_metrics(system_monitor_state_t* state);
 static void update_performance_history(system_monitor_state_t* state);
+static void update_audio_deadlines(system_monitor_state_t* state, const plugin_hal_t* hal, bool reset);
 static void draw_overview(system_monitor_state_t* state, const plugin_hal_t* hal);
 static void draw_memory_info(system_monitor_state_t* state, const plugin_hal_t* hal);
 static void draw_performance_graphs(system_monitor_state_t* state, const plugin_hal_t* hal);
 static void draw_hardware_info(system_monitor_state_t* state, const plugin_hal_t* hal);
 static void draw_task_info(system_monitor_state_t* state, const plugin_hal_t* hal);
+static void draw_audio_deadlines(system_monitor_state_t* state, const plugin_hal_t* hal);
 static void draw_settings(system_monitor_state_t* state, const plugin_hal_t* hal);
 static void draw_progress_bar(const plugin_hal_t* hal, int x, int y, int width, int height, 
                              int value, int max_value, uint16_t color);
@@ -161,6 +168,10 @@ static void system_monitor_run(plugin_context_t* ctx) {
             case STATE_TASKS:
                 draw_task_info(state, hal);
                 break;
+            case STATE_AUDIO:
+                update_audio_deadlines(state, hal, false);
+                draw_audio_deadlines(state, hal);
+                break;
             case STATE_SETTINGS:
                 draw_settings(state, hal);
                 break;
@@ -203,7 +214,7 @@ static bool system_monitor_event_handler(plugin_context_t* ctx, uint32_t event,
                 
             case PLUGIN_BUTTON_SELECT:
                 // Cycle through views
-                state->ui_state = (decltype(state->ui_state))((state->ui_state + 1) % 6);
+                state->ui_state = (decltype(state->ui_state))((state->ui_state + 1) % 7);
                 state->selected_item = 0;
                 break;
                 
@@ -250,6 +261,10 @@ static bool system_monitor_event_handler(plugin_context_t* ctx, uint32_t event,
                                 break;
                         }
                         break;
+                    case STATE_AUDIO:
+                        // Start a new measuring window
+                        update_audio_deadlines(state, plugin_get_hal(), true);
+                        break;
                     default:
                         // Toggle auto refresh
                         state->auto_refresh = !state->auto_refresh;
@@ -516,6 +531,11 @@ static void draw_hardware_info(system_monitor_state_t* state, const plugin_hal_t
     hal->display->text(10, 280, "Select: Next view", PLUGIN_COLOR_GRAY, 1);
 }
 
+static void update_audio_deadlines(system_monitor_state_t* state, const plugin_hal_t* hal, bool reset) {
+    state->deadline_available = hal && hal->audio && hal->audio->get_deadline_stats &&
+                                hal->audio->get_deadline_stats(&state->deadline, reset);
+}
+
 static void draw_task_info(system_monitor_state_t* state, const plugin_hal_t* hal) {
     hal->display->text(10, 10, "Task Information", PLUGIN_COLOR_WHITE, 2);
     
@@ -539,6 +559,61 @@ static void draw_task_info(system_monitor_state_t* state, const plugin_hal_t* ha
     hal->display->text(10, 280, "Select: Next view", PLUGIN_COLOR_GRAY, 1);
 }
 
+static void draw_audio_deadlines(system_monitor_state_t* state, const plugin_hal_t* hal) {
+    hal->display->text(10, 10, "Audio Deadlines", PLUGIN_COLOR_WHITE, 2);
+    
+    if (!state->deadline_available) {
+        hal->display->text(10, 50, "Audio output not running", PLUGIN_COLOR_GRAY, 1);
+        hal->display->text(10, 280, "Select: Next view", PLUGIN_COLOR_GRAY, 1);
+        return;
+    }
+    
+    const plugin_audio_deadline_t* dl = &state->deadline;
+    char line[40];
+    snprintf(line, sizeof(line), "Refills: %lu x %lu us", dl->periods, dl->period_us);
+    hal->display->text(10, 40, line, PLUGIN_COLOR_WHITE, 1);
+    
+    snprintf(line, sizeof(line), "Misses: %lu", dl->misses);
+    hal->display->text(10, 55, line, dl->misses ? PLUGIN_COLOR_RED : PLUGIN_COLOR_GREEN, 1);
+    
+    if (dl->periods > 0) {
+        // Under one DMA period of slack left a single late refill away from a dropout
+        uint16_t slack_color = dl->min_slack_us < dl->period_us ? PLUGIN_COLOR_RED :
+                               dl->min_slack_us < dl->period_us * 4 ? PLUGIN_COLOR_YELLOW : PLUGIN_COLOR_GREEN;
+        snprintf(line, sizeof(line), "Min slack: %lu.%lu ms", dl->min_slack_us / 1000, (dl->min_slack_us / 100) % 10);
+        hal->display->text(10, 70, line, slack_color, 1);
+        snprintf(line, sizeof(line), "Max gap: %lu.%lu ms", dl->max_interval_us / 1000, (dl->max_interval_us / 100) % 10);
+        hal->display->text(10, 85, line, PLUGIN_COLOR_YELLOW, 1);
+    }
+    
+    // One row per log2 bin: slack bars on the left, refill gaps on the right
+    hal->display->text(10, 105, "from", PLUGIN_COLOR_GRAY, 1);
+    hal->display->text(70, 105, "slack", PLUGIN_COLOR_CYAN, 1);
+    hal->display->text(155, 105, "gap", PLUGIN_COLOR_YELLOW, 1);
+    uint32_t max_count = 1;
+    for (int i = 0; i < PLUGIN_AUDIO_DEADLINE_BINS; i++) {
+        if (dl->slack_bins[i] > max_count) max_count = dl->slack_bins[i];
+        if (dl->interval_bins[i] > max_count) max_count = dl->interval_bins[i];
+    }
+    for (int i = 0; i < PLUGIN_AUDIO_DEADLINE_BINS; i++) {
+        int y = 120 + i * 12;
+        uint32_t from_us = i == 0 ? 0 : 256u << (i - 1);
+        snprintf(line, sizeof(line), from_us < 1000 ? "%luus" : "%lums",
+                 from_us < 1000 ? from_us : from_us / 1000);
+        hal->display->text(10, y, line, PLUGIN_COLOR_GRAY, 1);
+        // Any count at all gets a visible sliver: rare stalls are the point
+        if (dl->slack_bins[i]) {
+            hal->display->fill_rect(70, y, 1 + (dl->slack_bins[i] * 79) / max_count, 8, PLUGIN_COLOR_CYAN);
+        }
+        if (dl->interval_bins[i]) {
+            hal->display->fill_rect(155, y, 1 + (dl->interval_bins[i] * 79) / max_count, 8, PLUGIN_COLOR_YELLOW);
+        }
+    }
+    
+    hal->display->text(10, 280, "Play: New window", PLUGIN_COLOR_GRAY, 1);
+    hal->display->text(10, 295, "Select: Next view", PLUGIN_COLOR_GRAY, 1);
+}
+
 static void draw_settings(system_monitor_state_t* state, const plugin_hal_t* hal) {
     hal->display->text(10, 10, "Monitor Settings", PLUGIN_COLOR_WHITE, 2);
     
@@ -1,5 +1,6 @@
 #include "app_state.h"
 #include <Arduino.h>
+#include "hal/hal_audio.h"
 
 static volatile UIView s_currentView = UIView::VIEW_MENU;
 static volatile int s_menuLevel = 0;
@@ -27,7 +28,17 @@ void appSetMenuLevel(int level) { s_menuLevel = level; s_forceRedraw = true; }
 int appGetMenuSelected() { return s_menuSelected; }
 void appSetMenuSelected(int sel) { s_menuSelected = sel; s_forceRedraw = true; }
 
-int appGetNowPlayingSeconds() { return s_nowPlayingSeconds; }
+// The engine's position while it has a track; the mock counter otherwise
+int appGetNowPlayingSeconds() {
+    if (hal_audio_get_state() == HAL_AUDIO_STATE_STOPPED) return s_nowPlayingSeconds;
+    return (int)(hal_audio_get_position_ms() / 1000);
+}
+// 0.0-1.0 off the same clock, finer than whole seconds
+float appGetNowPlayingProgress() {
+    if (hal_audio_get_state() != HAL_AUDIO_STATE_STOPPED) return hal_audio_get_progress();
+    int duration = appGetCurrentTrackDurationSec();
+    return duration > 0 ? (float)(s_nowPlayingSeconds % duration) / (float)duration : 0.0f;
+}
 void appResetNowPlayingSeconds() { s_nowPlayingSeconds = 0; s_forceRedraw = true; }
 void appIncrementNowPlayingSecondsMod(int modSeconds) {
     if (modSeconds <= 0) return;
@@ -45,4 +56,7 @@ void appNextTrack() { s_trackIndex = (s_trackIndex + 1) % appGetTrackCount(); s_
 void appPrevTrack() { s_trackIndex = (s_trackIndex - 1 + appGetTrackCount()) % appGetTrackCount(); s_forceRedraw = true; appResetNowPlayingSeconds(); }
 const char* appGetCurrentTrackTitle() { return kTracks[s_trackIndex].title; }
 const char* appGetCurrentTrackArtist() { return kTracks[s_trackIndex].artist; }
-int appGetCurrentTrackDurationSec() { return kTracks[s_trackIndex].durationSec; }
+int appGetCurrentTrackDurationSec() {
+    uint32_t ms = hal_audio_get_state() == HAL_AUDIO_STATE_STOPPED ? 0 : hal_audio_get_duration_ms();
+    return ms ? (int)((ms + 999) / 1000) : kTracks[s_trackIndex].durationSec;
+}
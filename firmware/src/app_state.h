@@ -14,6 +14,7 @@ int appGetMenuSelected();
 void appSetMenuSelected(int sel);
 
 int appGetNowPlayingSeconds();
+float appGetNowPlayingProgress();
 void appResetNowPlayingSeconds();
 void appIncrementNowPlayingSecondsMod(int modSeconds);
 
@@ -1,92 +1,181 @@
 #include "audio.h"
-#include "driver/i2s.h"
-
-#ifndef I2S_BCLK
-#define I2S_BCLK 39
-#endif
-#ifndef I2S_WS
-#define I2S_WS 38
-#endif
-#ifndef I2S_DATA
-#define I2S_DATA 11
-#endif
-
-static const int kAudioSampleRateHz = 44100;
+#include "hal/hal_audio.h"
+#include "hal/hal_storage.h"
+#include "audio/audio_engine.h"
+#include "audio/audio_loudness.h"
+
+#include <atomic>
+
 static const int AUDIO_FREQ_HZ = 1000;  // 1 kHz tone
-static volatile bool s_audioPlaying = false;
-static volatile int s_audioVolume = 50;   // 0-100 (default 50%)
-static TaskHandle_t s_audioTaskHandle = NULL;
+static const uint32_t AUDIO_CLICK_HZ = 2400;        // UI click: a few ms of triangle
+static const uint32_t AUDIO_CROSSFADE_MS = 2000;    // When crossfading is switched on
+static volatile bool s_tonePlaying = false;
+
+// Album playback under /Music: the file after the current one is always queued gaplessly.
+// Owned by the menu task; the engine task only raises s_trackChanged.
+static char s_albumExt[16];
+static char s_albumQueued[HAL_STORAGE_MAX_PATH_LENGTH];
+static std::atomic<bool> s_trackChanged(false);
 
-static int16_t sineTable[256];
+// Finds the first file under /Music with the album extension that sorts after `after` ("" for the first)
+static bool audioFindUnderMusic(const char* after, char* path, size_t pathSize) {
+    hal_storage_dir_t dir = hal_storage_open_dir("/Music");
+    if (!dir) return false;
 
-static void buildSineTable() {
-    for (int i = 0; i < 256; i++) {
-        float phase = (2.0f * PI * i) / 256.0f;
-        sineTable[i] = (int16_t)(sin(phase) * 32767);
+    hal_storage_file_info_t info;
+    char ext[16];
+    bool found = false;
+    while (hal_storage_read_dir(dir, &info)) {
+        if (info.type != HAL_STORAGE_TYPE_FILE) continue;
+        if (!hal_storage_get_extension(info.name, ext, sizeof(ext)) || strcasecmp(ext, s_albumExt) != 0) continue;
+        if (strcmp(info.path, after) <= 0) continue;
+        if (!found || strcmp(info.path, path) < 0) {
+            strncpy(path, info.path, pathSize - 1);
+            path[pathSize - 1] = '\0';
+            found = true;
+        }
     }
+    hal_storage_close_dir(dir);
+    return found;
 }
 
-static void fillSineStereo(int16_t* buf, int frames, int freq_hz, int volume_percent) {
-    static uint32_t phase = 0;
-    const uint32_t phase_inc = (uint32_t)((uint64_t)freq_hz * 256ull / kAudioSampleRateHz * 65536ull);
-    const int32_t amp = (int32_t)(volume_percent * 32767 / 100);
-    for (int i = 0; i < frames; i++) {
-        phase += phase_inc;
-        uint8_t idx = (phase >> 16) & 0xFF;
-        int16_t s = (int16_t)((sineTable[idx] * amp) / 32767);
-        buf[i * 2 + 0] = s; // Left
-        buf[i * 2 + 1] = s; // Right
+static void audioQueueAfter(const char* current) {
+    char next[HAL_STORAGE_MAX_PATH_LENGTH];
+    s_albumQueued[0] = '\0';
+    if (audioFindUnderMusic(current, next, sizeof(next)) && audio_engine_queue_next_file(next)) {
+        strcpy(s_albumQueued, next);
     }
 }
 
-static void audioTask(void* pv) {
-    const int frames = 256;
-    int16_t buffer[frames * 2];
-    buildSineTable();
-    for (;;) {
-        if (s_audioPlaying) {
-            fillSineStereo(buffer, frames, AUDIO_FREQ_HZ, s_audioVolume);
-            size_t bytes_written = 0;
-            i2s_write(I2S_NUM_0, buffer, frames * 2 * sizeof(int16_t), &bytes_written, portMAX_DELAY);
-        } else {
-            vTaskDelay(pdMS_TO_TICKS(10));
-        }
+// Engine task, right after a splice or fade: the queued file is now playing.
+// No card access or logging here; audioPoll() queues the next file.
+static void audioOnTrackChange(void* userData) {
+    (void)userData;
+    s_trackChanged.store(true);
+}
+
+void audioPoll() {
+    if (!s_trackChanged.exchange(false)) return;
+    char current[HAL_STORAGE_MAX_PATH_LENGTH];
+    strcpy(current, s_albumQueued);
+    Serial.printf("Audio: now playing %s\n", current);
+    audioQueueAfter(current);
+}
+
+bool audioInit() {
+    // The HAL owns I2S_NUM_0 and the PCM ring; the engine task is the only producer
+    hal_audio_config_t cfg = {};
+    cfg.sample_rate = AUDIO_SAMPLE_RATE;
+    cfg.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+    cfg.volume = HAL_AUDIO_DEFAULT_VOLUME;
+    cfg.buffer_size = 0;
+    if (!hal_audio_init(&cfg)) return false;
+    hal_storage_init();
+
+    audio_engine_config_t engineCfg = {};
+    engineCfg.start_task = true;
+    // Folders under /Music play as albums; loose tracks fall back to their own gain
+    engineCfg.replay_gain = AUDIO_REPLAY_GAIN_ALBUM;
+    if (!audio_engine_init(&engineCfg)) return false;
+    audio_engine_set_track_callback(audioOnTrackChange, nullptr);
+    return true;
+}
+
+void audioSetPlaying(bool play) {
+    if (play) {
+        s_tonePlaying = audio_engine_play_tone(AUDIO_FREQ_HZ);
+    } else if (s_tonePlaying) {
+        s_tonePlaying = false;
+        audio_engine_stop();
     }
 }
 
-static bool initI2SOutput() {
-    i2s_config_t i2s_config = {
-        .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_TX),
-        .sample_rate = kAudioSampleRateHz,
-        .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
-        .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT,
-        .communication_format = I2S_COMM_FORMAT_STAND_I2S,
-        .intr_alloc_flags = 0,
-        .dma_buf_count = 8,
-        .dma_buf_len = 256,
-        .use_apll = true,
-        .tx_desc_auto_clear = true,
-        .fixed_mclk = 0
-    };
-    i2s_pin_config_t pin_config = {
-        .bck_io_num = I2S_BCLK,
-        .ws_io_num = I2S_WS,
-        .data_out_num = I2S_DATA,
-        .data_in_num = I2S_PIN_NO_CHANGE
-    };
-    if (i2s_driver_install(I2S_NUM_0, &i2s_config, 0, NULL) != ESP_OK) return false;
-    if (i2s_set_pin(I2S_NUM_0, &pin_config) != ESP_OK) return false;
-    if (i2s_set_clk(I2S_NUM_0, kAudioSampleRateHz, I2S_BITS_PER_SAMPLE_16BIT, I2S_CHANNEL_STEREO) != ESP_OK) return false;
+bool audioIsPlaying() { return s_tonePlaying; }
+
+void audioSetCrossfade(bool on) { audio_engine_set_crossfade_ms(on ? AUDIO_CROSSFADE_MS : 0); }
+bool audioGetCrossfade() { return audio_engine_get_crossfade_ms() > 0; }
+
+const char* audioCycleReplayGain() {
+    static const char* const names[] = { "off", "track", "album" };
+    int mode = (audio_engine_get_replay_gain() + 1) % 3;
+    audio_engine_set_replay_gain((audio_replay_gain_mode_t)mode, 0.0f);
+    return names[mode];
+}
+
+bool audioStartLoudnessScan() {
+    audio_loudness_job_config_t cfg = {};
+    cfg.start_task = true;      // Low priority; waits while anything plays
+    return audio_loudness_job_start(&cfg);
+}
+
+bool audioSkipNext() {
+    audioPoll();    // A splice not yet seen would leave the playing file queued
+    if (s_albumQueued[0] == '\0') return false;
+    char next[HAL_STORAGE_MAX_PATH_LENGTH];
+    strcpy(next, s_albumQueued);
+    // Play drops the queue; fades over the current track when crossfading is on
+    if (!audio_engine_play_file(next)) return false;
+    s_trackChanged.store(false);    // Play dropped the queue; nothing spliced from it
+    Serial.printf("Audio: skipped to %s\n", next);
+    audioQueueAfter(next);
     return true;
 }
 
-bool audioInit() {
-    if (!initI2SOutput()) return false;
-    xTaskCreatePinnedToCore(audioTask, "AudioTask", 4096, NULL, 2, &s_audioTaskHandle, 0);
+bool audioBeep(uint16_t frequency, uint32_t durationMs) {
+    return audio_engine_beep(frequency, durationMs);
+}
+
+void audioClick() {
+    audio_synth_note_t note;
+    audio_synth_note_beep(&note, AUDIO_CLICK_HZ, 0);
+    note.waveform = AUDIO_SYNTH_TRIANGLE;
+    note.volume = 30;
+    note.attack_ms = 1;
+    note.release_ms = 8;
+    audio_engine_play_notes(&note, 1);
+}
+
+bool audioGetDeadlineStats(plugin_audio_deadline_t* stats, bool reset) {
+    if (!stats || !hal_audio_is_initialized()) return false;
+    hal_audio_deadline_stats_t hal_stats;
+    hal_audio_get_deadline_stats(&hal_stats);
+    if (reset) hal_audio_reset_deadline_stats();
+
+    stats->period_us = hal_stats.period_us;
+    stats->periods = hal_stats.periods;
+    stats->misses = hal_stats.misses;
+    stats->min_slack_us = hal_stats.min_slack_us;
+    stats->max_interval_us = hal_stats.max_interval_us;
+    static_assert(PLUGIN_AUDIO_DEADLINE_BINS == HAL_AUDIO_DEADLINE_BINS, "deadline bins differ");
+    memcpy(stats->slack_bins, hal_stats.slack_bins, sizeof(stats->slack_bins));
+    memcpy(stats->interval_bins, hal_stats.interval_bins, sizeof(stats->interval_bins));
     return true;
 }
 
-void audioSetPlaying(bool play) { s_audioPlaying = play; }
-bool audioIsPlaying() { return s_audioPlaying; }
-void audioSetVolume(int percent) { s_audioVolume = constrain(percent, 0, 100); }
-int audioGetVolume() { return s_audioVolume; }
+void audioSetVolume(int percent) { audio_engine_set_volume((uint8_t)constrain(percent, 0, 100)); }
+int audioGetVolume() { return audio_engine_get_volume(); }
+
+bool audioIsDecoderPlaying(const char* decoder) {
+    return audio_engine_get_state() == HAL_AUDIO_STATE_PLAYING &&
+           strcmp(audio_engine_get_decoder_name(), decoder) == 0;
+}
+
+bool audioStartFirstUnderMusic(const char* extension) {
+    strncpy(s_albumExt, extension, sizeof(s_albumExt) - 1);
+    s_albumExt[sizeof(s_albumExt) - 1] = '\0';
+
+    char first[HAL_STORAGE_MAX_PATH_LENGTH];
+    bool ok = audioFindUnderMusic("", first, sizeof(first));
+    if (ok) {
+        audioSetPlaying(false); // stop tone
+        ok = audio_engine_play_file(first);
+    }
+    if (!ok) {
+        Serial.printf("Audio: no .%s found under /Music\n", extension);
+        return false;
+    }
+    s_trackChanged.store(false);
+    // Play the rest of the folder back to back
+    audioQueueAfter(first);
+    return true;
+}
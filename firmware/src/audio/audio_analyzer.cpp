@@ -0,0 +1,269 @@
+/*
+ * Audio Analyzer Implementation
+ * Decimating capture, Hann window, Q30 radix-2 FFT and seqlock publishing
+ */
+
+#include "audio/audio_analyzer.h"
+#include "hal/hal_system.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifdef PLATFORM_ESP32
+#include <esp_attr.h>
+#define ANALYZER_HOT IRAM_ATTR
+#else
+#define ANALYZER_HOT
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Windowed samples enter the FFT at Q15 << 12: 27 bits, leaving one bit of
+// butterfly growth per stage before the 1/2 scaling brings it back
+#define ANALYZER_INPUT_SHIFT    12
+#define ANALYZER_TWIDDLE_SHIFT  30
+
+static uint32_t analyzer_log2(uint32_t n) {
+    uint32_t bits = 0;
+    while ((1u << bits) < n) bits++;
+    return bits;
+}
+
+static void analyzer_bit_reverse(int32_t* re, int32_t* im, uint32_t n) {
+    for (uint32_t i = 1, j = 0; i < n; i++) {
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            int32_t t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+}
+
+// Log-spaced band edges from AUDIO_ANALYZER_LOW_HZ to the captured Nyquist
+static void analyzer_layout_bands(audio_analyzer_t* an) {
+    const float rate = (float)an->sample_rate / (float)an->decimation;
+    const float bins_per_hz = (float)an->fft_size / rate;
+    const float ratio = (rate * 0.5f) / AUDIO_ANALYZER_LOW_HZ;
+    const uint32_t last_bin = an->fft_size / 2;
+
+    for (uint32_t b = 0; b < AUDIO_ANALYZER_BANDS; b++) {
+        float lo_hz = AUDIO_ANALYZER_LOW_HZ * powf(ratio, (float)b / AUDIO_ANALYZER_BANDS);
+        float hi_hz = AUDIO_ANALYZER_LOW_HZ * powf(ratio, (float)(b + 1) / AUDIO_ANALYZER_BANDS);
+        uint32_t lo = (uint32_t)(lo_hz * bins_per_hz + 0.5f);
+        uint32_t hi = (uint32_t)(hi_hz * bins_per_hz + 0.5f);
+        if (lo < 1) lo = 1;                 // Skip DC
+        if (lo >= last_bin) lo = last_bin - 1;
+        if (hi <= lo) hi = lo + 1;          // Low bands narrower than a bin share it
+        if (hi > last_bin) hi = last_bin;
+        an->band_lo[b] = (uint16_t)lo;
+        an->band_hi[b] = (uint16_t)hi;
+    }
+}
+
+static void analyzer_publish(audio_analyzer_t* an, const float* bands, float peak, float rms) {
+    uint32_t seq = an->published + 1;
+    uint32_t slot = seq & 1;
+    an->slot_seq[slot].store(seq * 2 - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    audio_analyzer_frame_t* frame = &an->slots[slot];
+    memcpy(frame->bands, bands, sizeof(frame->bands));
+    frame->peak = peak;
+    frame->rms = rms;
+    frame->sequence = seq;
+
+    an->slot_seq[slot].store(seq * 2, std::memory_order_release);
+    an->sequence.store(seq, std::memory_order_release);
+    an->published = seq;
+}
+
+bool audio_analyzer_init(audio_analyzer_t* an, uint32_t sample_rate, uint32_t fft_size, uint32_t decimation) {
+    if (!an || sample_rate == 0) return false;
+    if (fft_size == 0) fft_size = AUDIO_ANALYZER_DEFAULT_FFT;
+    if (decimation == 0) decimation = 1;
+    if (fft_size < AUDIO_ANALYZER_MIN_FFT || fft_size > AUDIO_ANALYZER_MAX_FFT || (fft_size & (fft_size - 1))) {
+        return false;
+    }
+
+    memset(an->slots, 0, sizeof(an->slots));
+    an->sample_rate = sample_rate;
+    an->fft_size = fft_size;
+    an->log2_size = analyzer_log2(fft_size);
+    an->decimation = decimation;
+    an->frames_per_update = sample_rate / AUDIO_ANALYZER_RATE_HZ;
+    an->capture = (int16_t*)hal_system_malloc(fft_size * sizeof(int16_t));
+    an->window = (int16_t*)hal_system_malloc(fft_size * sizeof(int16_t));
+    an->twiddle = (int32_t*)hal_system_malloc(fft_size * sizeof(int32_t));
+    an->re = (int32_t*)hal_system_malloc(fft_size * sizeof(int32_t));
+    an->im = (int32_t*)hal_system_malloc(fft_size * sizeof(int32_t));
+    if (!an->capture || !an->window || !an->twiddle || !an->re || !an->im) {
+        audio_analyzer_deinit(an);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < fft_size; i++) {
+        double w = 0.5 - 0.5 * cos(2.0 * M_PI * i / fft_size);
+        an->window[i] = (int16_t)lrint(w * 32767.0);
+    }
+    const double one = (double)(1 << ANALYZER_TWIDDLE_SHIFT);
+    for (uint32_t k = 0; k < fft_size / 2; k++) {
+        an->twiddle[k * 2 + 0] = (int32_t)lrint(cos(2.0 * M_PI * k / fft_size) * one);
+        an->twiddle[k * 2 + 1] = (int32_t)lrint(-sin(2.0 * M_PI * k / fft_size) * one);
+    }
+    analyzer_layout_bands(an);
+
+    an->published = 0;
+    an->slot_seq[0].store(0, std::memory_order_relaxed);
+    an->slot_seq[1].store(0, std::memory_order_relaxed);
+    an->sequence.store(0, std::memory_order_relaxed);
+    memset(an->capture, 0, fft_size * sizeof(int16_t));
+    an->capture_pos = 0;
+    an->decimate_sum = 0;
+    an->decimate_count = 0;
+    an->frames_until_update = an->frames_per_update;
+    an->peak = 0;
+    an->power = 0;
+    an->power_count = 0;
+    return true;
+}
+
+void audio_analyzer_deinit(audio_analyzer_t* an) {
+    if (!an) return;
+    hal_system_free(an->capture);
+    hal_system_free(an->window);
+    hal_system_free(an->twiddle);
+    hal_system_free(an->re);
+    hal_system_free(an->im);
+    an->capture = nullptr;
+    an->window = nullptr;
+    an->twiddle = nullptr;
+    an->re = nullptr;
+    an->im = nullptr;
+    an->fft_size = 0;
+}
+
+ANALYZER_HOT void audio_analyzer_fft(int32_t* re, int32_t* im, const int32_t* twiddle, uint32_t log2_n) {
+    const uint32_t n = 1u << log2_n;
+    analyzer_bit_reverse(re, im, n);
+
+    for (uint32_t half = 1, step = n >> 1; half < n; half <<= 1, step >>= 1) {
+        for (uint32_t start = 0; start < n; start += half * 2) {
+            for (uint32_t k = 0; k < half; k++) {
+                const int32_t wr = twiddle[k * step * 2 + 0];
+                const int32_t wi = twiddle[k * step * 2 + 1];
+                const uint32_t i = start + k;
+                const uint32_t j = i + half;
+                const int32_t tr = (int32_t)(((int64_t)re[j] * wr - (int64_t)im[j] * wi) >> ANALYZER_TWIDDLE_SHIFT);
+                const int32_t ti = (int32_t)(((int64_t)re[j] * wi + (int64_t)im[j] * wr) >> ANALYZER_TWIDDLE_SHIFT);
+                re[j] = (re[i] - tr) >> 1;
+                im[j] = (im[i] - ti) >> 1;
+                re[i] = (re[i] + tr) >> 1;
+                im[i] = (im[i] + ti) >> 1;
+            }
+        }
+    }
+}
+
+void audio_analyzer_analyze(audio_analyzer_t* an) {
+    const uint32_t n = an->fft_size;
+    const uint32_t mask = n - 1;
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t s = an->capture[(an->capture_pos + i) & mask];
+        an->re[i] = (s * an->window[i]) >> (15 - ANALYZER_INPUT_SHIFT);
+        an->im[i] = 0;
+    }
+    audio_analyzer_fft(an->re, an->im, an->twiddle, an->log2_size);
+
+    // A full-scale sine lands at 2^15 << INPUT_SHIFT, halved by the Hann
+    // window's coherent gain and again by the one-sided spectrum
+    const float full_scale = (float)(1 << (15 + ANALYZER_INPUT_SHIFT - 2));
+    const float ref_db = 20.0f * log10f(full_scale);
+    float bands[AUDIO_ANALYZER_BANDS];
+    for (uint32_t b = 0; b < AUDIO_ANALYZER_BANDS; b++) {
+        int64_t strongest = 0;
+        for (uint32_t k = an->band_lo[b]; k < an->band_hi[b]; k++) {
+            int64_t p = (int64_t)an->re[k] * an->re[k] + (int64_t)an->im[k] * an->im[k];
+            if (p > strongest) strongest = p;
+        }
+        float level = 0.0f;
+        if (strongest > 0) {
+            float db = 10.0f * log10f((float)strongest) - ref_db;
+            level = 1.0f - db / AUDIO_ANALYZER_FLOOR_DB;
+            level = level < 0.0f ? 0.0f : (level > 1.0f ? 1.0f : level);
+        }
+        bands[b] = level;
+    }
+
+    float rms = an->power_count ? sqrtf((float)an->power / (float)an->power_count) / 32768.0f : 0.0f;
+    analyzer_publish(an, bands, (float)an->peak / 32768.0f, rms);
+    an->peak = 0;
+    an->power = 0;
+    an->power_count = 0;
+}
+
+ANALYZER_HOT void audio_analyzer_feed(audio_analyzer_t* an, const int16_t* frames, uint32_t frame_count) {
+    const uint32_t mask = an->fft_size - 1;
+    while (frame_count > 0) {
+        uint32_t n = frame_count < an->frames_until_update ? frame_count : an->frames_until_update;
+        int32_t peak = an->peak;
+        uint64_t power = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            const int32_t l = frames[i * 2];
+            const int32_t r = frames[i * 2 + 1];
+            const int32_t al = l < 0 ? -l : l;
+            const int32_t ar = r < 0 ? -r : r;
+            peak = al > peak ? al : peak;
+            peak = ar > peak ? ar : peak;
+            power += (uint64_t)(l * l) + (uint64_t)(r * r);
+
+            an->decimate_sum += l + r;
+            if (++an->decimate_count == an->decimation) {
+                an->capture[an->capture_pos] = (int16_t)(an->decimate_sum / (int32_t)(2 * an->decimation));
+                an->capture_pos = (an->capture_pos + 1) & mask;
+                an->decimate_sum = 0;
+                an->decimate_count = 0;
+            }
+        }
+        an->peak = peak;
+        an->power += power;
+        an->power_count += n * 2;
+
+        frames += (size_t)n * 2;
+        frame_count -= n;
+        an->frames_until_update -= n;
+        if (an->frames_until_update == 0) {
+            an->frames_until_update = an->frames_per_update;
+            audio_analyzer_analyze(an);
+        }
+    }
+}
+
+void audio_analyzer_clear(audio_analyzer_t* an) {
+    if (!an->capture) return;
+    memset(an->capture, 0, an->fft_size * sizeof(int16_t));
+    an->decimate_sum = 0;
+    an->decimate_count = 0;
+    an->frames_until_update = an->frames_per_update;
+    an->peak = 0;
+    an->power = 0;
+    an->power_count = 0;
+    const float silent[AUDIO_ANALYZER_BANDS] = {};
+    analyzer_publish(an, silent, 0.0f, 0.0f);
+}
+
+bool audio_analyzer_read(audio_analyzer_t* an, audio_analyzer_frame_t* frame) {
+    for (;;) {
+        uint32_t seq = an->sequence.load(std::memory_order_acquire);
+        if (seq == 0) return false;
+        const uint32_t slot = seq & 1;
+        uint32_t before = an->slot_seq[slot].load(std::memory_order_acquire);
+        if (before & 1) continue;           // Being rewritten two publishes later
+        memcpy(frame, &an->slots[slot], sizeof(*frame));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (an->slot_seq[slot].load(std::memory_order_relaxed) == before) return true;
+    }
+}
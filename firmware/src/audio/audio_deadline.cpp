@@ -0,0 +1,147 @@
+/*
+ * Audio Deadline Monitor Implementation
+ * Refill slack and interval histograms for the ESP32 feeder and the host sink
+ */
+
+#include "audio/audio_deadline.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// The consumer is the only writer, so a plain load and store publishes a count
+// without the read-modify-write an atomic add costs on the ESP32
+static inline void bump(std::atomic<uint32_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+static void clear_counters(audio_deadline_t* deadline) {
+    deadline->periods.store(0, std::memory_order_relaxed);
+    deadline->misses.store(0, std::memory_order_relaxed);
+    deadline->min_slack_us.store(UINT32_MAX, std::memory_order_relaxed);
+    deadline->max_interval_us.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < AUDIO_DEADLINE_BINS; i++) {
+        deadline->slack_bins[i].store(0, std::memory_order_relaxed);
+        deadline->interval_bins[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+static void apply_reset_request(audio_deadline_t* deadline) {
+    if (deadline->reset_request.load(std::memory_order_acquire)) {
+        clear_counters(deadline);
+        deadline->reset_request.store(false, std::memory_order_release);
+    }
+}
+
+void audio_deadline_init(audio_deadline_t* deadline, uint32_t sample_rate, uint32_t period_frames) {
+    if (!deadline) return;
+    deadline->period_frames = period_frames;
+    deadline->sample_rate.store(sample_rate, std::memory_order_relaxed);
+    clear_counters(deadline);
+    deadline->reset_request.store(false, std::memory_order_relaxed);
+    deadline->last_refill_us = 0;
+    deadline->primed = false;
+}
+
+void audio_deadline_set_rate(audio_deadline_t* deadline, uint32_t sample_rate) {
+    if (deadline) deadline->sample_rate.store(sample_rate, std::memory_order_relaxed);
+}
+
+uint32_t audio_deadline_bin(uint32_t us) {
+    uint32_t steps = us / AUDIO_DEADLINE_BIN0_US;
+    if (steps == 0) return 0;
+    uint32_t bin = 32 - (uint32_t)__builtin_clz(steps);
+    return bin < AUDIO_DEADLINE_BINS ? bin : AUDIO_DEADLINE_BINS - 1;
+}
+
+uint32_t audio_deadline_bin_floor_us(uint32_t bin) {
+    if (bin == 0) return 0;
+    if (bin >= AUDIO_DEADLINE_BINS) bin = AUDIO_DEADLINE_BINS - 1;
+    return (uint32_t)AUDIO_DEADLINE_BIN0_US << (bin - 1);
+}
+
+// Consumer side
+void audio_deadline_record(audio_deadline_t* deadline, uint64_t now_us, uint32_t queued_frames, bool missed) {
+    if (!deadline) return;
+    uint32_t sample_rate = deadline->sample_rate.load(std::memory_order_relaxed);
+    if (sample_rate == 0) return;
+    apply_reset_request(deadline);
+
+    if (!deadline->primed) missed = false;
+    uint64_t slack = missed ? 0 : (uint64_t)queued_frames * 1000000ull / sample_rate;
+    uint32_t slack_us = slack < UINT32_MAX ? (uint32_t)slack : UINT32_MAX - 1;
+
+    bump(deadline->periods);
+    if (missed) bump(deadline->misses);
+    bump(deadline->slack_bins[audio_deadline_bin(slack_us)]);
+    if (slack_us < deadline->min_slack_us.load(std::memory_order_relaxed)) {
+        deadline->min_slack_us.store(slack_us, std::memory_order_relaxed);
+    }
+
+    if (deadline->primed) {
+        uint64_t gap = now_us - deadline->last_refill_us;
+        uint32_t interval_us = gap < UINT32_MAX ? (uint32_t)gap : UINT32_MAX;
+        bump(deadline->interval_bins[audio_deadline_bin(interval_us)]);
+        if (interval_us > deadline->max_interval_us.load(std::memory_order_relaxed)) {
+            deadline->max_interval_us.store(interval_us, std::memory_order_relaxed);
+        }
+    }
+    deadline->last_refill_us = now_us;
+    deadline->primed = true;
+}
+
+void audio_deadline_idle(audio_deadline_t* deadline) {
+    if (!deadline) return;
+    apply_reset_request(deadline);
+    deadline->primed = false;
+}
+
+// Any task
+void audio_deadline_reset(audio_deadline_t* deadline) {
+    if (deadline) deadline->reset_request.store(true, std::memory_order_release);
+}
+
+void audio_deadline_read(const audio_deadline_t* deadline, hal_audio_deadline_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    stats->min_slack_us = UINT32_MAX;
+    if (!deadline) return;
+
+    uint32_t sample_rate = deadline->sample_rate.load(std::memory_order_relaxed);
+    if (sample_rate) stats->period_us = (uint32_t)((uint64_t)deadline->period_frames * 1000000ull / sample_rate);
+    // A reset the consumer has not picked up yet already reads as one
+    if (deadline->reset_request.load(std::memory_order_acquire)) return;
+
+    stats->periods = deadline->periods.load(std::memory_order_relaxed);
+    stats->misses = deadline->misses.load(std::memory_order_relaxed);
+    stats->min_slack_us = deadline->min_slack_us.load(std::memory_order_relaxed);
+    stats->max_interval_us = deadline->max_interval_us.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < AUDIO_DEADLINE_BINS; i++) {
+        stats->slack_bins[i] = deadline->slack_bins[i].load(std::memory_order_relaxed);
+        stats->interval_bins[i] = deadline->interval_bins[i].load(std::memory_order_relaxed);
+    }
+}
+
+size_t audio_deadline_format(const hal_audio_deadline_stats_t* stats, char* out, size_t out_size) {
+    if (!stats || !out || out_size == 0) return 0;
+    size_t len = 0;
+    auto append = [&](int n) {
+        if (n > 0) len += (size_t)n;
+        if (len >= out_size) len = out_size - 1;
+    };
+
+    append(snprintf(out, out_size, "Audio deadlines: %lu refills of %lu us, %lu missed\n",
+                    (unsigned long)stats->periods, (unsigned long)stats->period_us,
+                    (unsigned long)stats->misses));
+    if (stats->periods == 0) return len;
+
+    append(snprintf(out + len, out_size - len, "  min slack %lu us, max interval %lu us\n",
+                    (unsigned long)stats->min_slack_us, (unsigned long)stats->max_interval_us));
+    append(snprintf(out + len, out_size - len, "  from (us)      slack   interval\n"));
+    for (uint32_t i = 0; i < AUDIO_DEADLINE_BINS; i++) {
+        if (stats->slack_bins[i] == 0 && stats->interval_bins[i] == 0) continue;
+        append(snprintf(out + len, out_size - len, "  %9lu %10lu %10lu\n",
+                        (unsigned long)audio_deadline_bin_floor_us(i),
+                        (unsigned long)stats->slack_bins[i], (unsigned long)stats->interval_bins[i]));
+    }
+    return len;
+}
@@ -0,0 +1,102 @@
+/*
+ * Audio Decoder Registry
+ * Picks the decoder for a source and builds source descriptors
+ */
+
+#include "audio/audio_decoder.h"
+#include "audio/audio_mp3_index.h"
+
+#include <string.h>
+#include <ctype.h>
+
+// Probed in order; the first decoder that accepts the source wins
+static const audio_decoder_ops_t* const k_decoders[] = {
+    &audio_decoder_tone,
+    &audio_decoder_pcm,
+    &audio_decoder_wav,
+    &audio_decoder_flac,
+#if AUDIO_DECODER_MP3
+    &audio_decoder_mp3,
+#endif
+};
+
+#define DECODER_COUNT (sizeof(k_decoders) / sizeof(k_decoders[0]))
+
+const audio_decoder_ops_t* audio_decoder_find(const audio_source_t* source) {
+    if (!source) return nullptr;
+    for (size_t i = 0; i < DECODER_COUNT; i++) {
+        if (k_decoders[i]->accepts(source)) return k_decoders[i];
+    }
+    return nullptr;
+}
+
+size_t audio_decoder_max_state_size(void) {
+    size_t max_size = 0;
+    for (size_t i = 0; i < DECODER_COUNT; i++) {
+        if (k_decoders[i]->state_size > max_size) max_size = k_decoders[i]->state_size;
+    }
+    return max_size;
+}
+
+bool audio_decoder_probe(const audio_source_t* source, audio_probe_t* probe) {
+    if (!source || !probe) return false;
+    memset(probe, 0, sizeof(*probe));
+
+    bool ok = false;
+    const audio_decoder_ops_t* decoder = audio_decoder_find(source);
+    if (decoder && decoder->probe) {
+        probe->codec = decoder->name;
+        ok = decoder->probe(source, &probe->info);
+#if !AUDIO_DECODER_MP3
+    } else if (audio_source_has_extension(source, "mp3")) {
+        probe->codec = "mp3";
+        ok = audio_mp3_probe(source->path, &probe->info);
+#endif
+    }
+    if (!ok || probe->info.sample_rate == 0) return false;
+    probe->duration_ms = (uint32_t)(probe->info.total_frames * 1000ull / probe->info.sample_rate);
+    return true;
+}
+
+bool audio_decoder_probe_file(const char* path, audio_probe_t* probe) {
+    if (!path) return false;
+    audio_source_t source;
+    audio_source_file(&source, path);
+    return audio_decoder_probe(&source, probe);
+}
+
+void audio_source_file(audio_source_t* source, const char* path) {
+    memset(source, 0, sizeof(*source));
+    source->kind = AUDIO_SOURCE_FILE;
+    strncpy(source->path, path ? path : "", sizeof(source->path) - 1);
+}
+
+void audio_source_tone(audio_source_t* source, uint32_t tone_hz, uint32_t sample_rate) {
+    memset(source, 0, sizeof(*source));
+    source->kind = AUDIO_SOURCE_TONE;
+    source->tone_hz = tone_hz;
+    source->sample_rate = sample_rate;
+}
+
+void audio_source_memory(audio_source_t* source, const void* data, size_t size,
+                         hal_audio_format_t format, uint32_t sample_rate) {
+    memset(source, 0, sizeof(*source));
+    source->kind = AUDIO_SOURCE_MEMORY;
+    source->data = data;
+    source->size = size;
+    source->format = format;
+    source->sample_rate = sample_rate;
+}
+
+bool audio_source_has_extension(const audio_source_t* source, const char* extension) {
+    if (!source || source->kind != AUDIO_SOURCE_FILE || !extension) return false;
+    size_t path_len = strlen(source->path);
+    size_t ext_len = strlen(extension);
+    if (path_len <= ext_len || source->path[path_len - ext_len - 1] != '.') return false;
+
+    const char* p = source->path + path_len - ext_len;
+    for (size_t i = 0; i < ext_len; i++) {
+        if (tolower((unsigned char)p[i]) != tolower((unsigned char)extension[i])) return false;
+    }
+    return true;
+}
@@ -0,0 +1,776 @@
+/*
+ * FLAC Decoder
+ * Streaming decoder for mono and stereo FLAC at 4 to 24 bits, reading
+ * frames straight out of the read-ahead buffers (audio_readahead.h)
+ *
+ * Each frame is decoded whole into fixed per-channel sample blocks in the
+ * decoder state, so nothing is allocated after open, then handed out in
+ * output-sized pieces. Residuals are Rice-decoded from a 32-bit bit cache.
+ * Prediction runs in 32-bit fixed point with LPC orders up to 12 unrolled,
+ * and only falls back to 64-bit sums when a subframe's coefficients could
+ * overflow 32 bits. Every frame's header CRC-8 and CRC-16 are checked; a
+ * damaged frame plays as silence and decoding resumes at the next sync code.
+ *
+ * Seeking uses the SEEKTABLE when the file has one and otherwise bisects the
+ * file on frame headers, then decodes forward to the exact sample.
+ */
+
+#include "audio/audio_decoder.h"
+#include "audio/audio_readahead.h"
+
+#include <string.h>
+
+#define FLAC_MAX_BLOCK_SIZE     4608    // Subset limit up to 48 kHz; encoders default to 4096 at any rate
+#define FLAC_MAX_CHANNELS       2
+#define FLAC_MIN_BITS           4
+#define FLAC_MAX_BITS           24
+#define FLAC_MAX_LPC_ORDER      32
+#define FLAC_MAX_SEEK_POINTS    128     // Longer tables are thinned evenly
+#define FLAC_SYNC_LIMIT         65536   // Bytes searched for the next frame header
+#define FLAC_SEEK_LINEAR_BYTES  32768   // Bisection stops this close and decodes forward
+#define FLAC_SEEK_PROBES        24
+
+#define FLAC_BLOCK_STREAMINFO   0
+#define FLAC_BLOCK_SEEKTABLE    3
+#define FLAC_SEEK_PLACEHOLDER   0xFFFFFFFFFFFFFFFFull
+
+#define FLAC_CHANNELS_LEFT_SIDE     8
+#define FLAC_CHANNELS_RIGHT_SIDE    9
+#define FLAC_CHANNELS_MID_SIDE      10
+
+// CRC-16 (polynomial 0x8005) over a whole frame, one table step per byte
+struct flac_crc16_table {
+    uint16_t v[256];
+    constexpr flac_crc16_table() : v() {
+        for (int i = 0; i < 256; i++) {
+            uint16_t crc = (uint16_t)(i << 8);
+            for (int bit = 0; bit < 8; bit++) crc = (uint16_t)((crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1);
+            v[i] = crc;
+        }
+    }
+};
+static constexpr flac_crc16_table k_crc16{};
+
+static const uint8_t k_sample_bits[8] = { 0, 8, 12, 0, 16, 20, 24, 32 };
+
+// STREAMINFO and where the frames are: everything a probe needs
+typedef struct {
+    hal_storage_file_t file;
+    uint64_t first_frame;           // Offset of the first frame header
+    uint64_t file_size;
+    uint64_t total_samples;         // 0 when the encoder did not know
+    uint32_t sample_rate;
+    uint32_t max_block;
+    uint16_t channels;
+    uint16_t bits;
+} flac_header_t;
+
+typedef struct {
+    uint64_t sample;
+    uint64_t offset;                // From the first frame header
+} flac_seek_point_t;
+
+// MSB-first bit reader over read-ahead spans. The frame CRC-16 trails the
+// read position and catches up from the last few bytes loaded, so bytes the
+// cache has loaded ahead of a frame's end never count towards it.
+typedef struct {
+    audio_readahead_t* stream;
+    const uint8_t* span;            // Acquired bytes, released once all are loaded
+    const uint8_t* ptr;
+    const uint8_t* end;
+    uint32_t cache;                 // Next bits, MSB aligned; bits below count are zero
+    uint32_t count;
+    uint64_t loaded;                // File offset of the next byte to load
+    uint64_t crc_pos;               // Bytes before this are in crc
+    uint16_t crc;
+    uint8_t recent[8];              // Last bytes loaded, indexed by offset
+    bool error;                     // Ran out of data mid-read
+} flac_bits_t;
+
+typedef struct {
+    uint32_t block_size;
+    uint32_t channel_mode;          // 0-7 independent channels - 1, or a stereo decorrelation mode
+    uint32_t bits;
+    uint64_t first_sample;
+} flac_frame_header_t;
+
+typedef struct {
+    flac_header_t header;
+    flac_bits_t bits;
+    uint64_t frame_pos;             // Offset of the last frame header found
+    uint64_t frame_sample;          // First sample of the frame being played
+    uint64_t seek_target;           // Samples before this are decoded and dropped
+    uint32_t block_size;            // Samples in the frame being played
+    uint32_t block_pos;             // Already handed out
+    uint32_t errors;                // Frames played as silence
+    uint32_t seek_count;
+    flac_seek_point_t seek_points[FLAC_MAX_SEEK_POINTS];
+    int32_t samples[FLAC_MAX_CHANNELS][FLAC_MAX_BLOCK_SIZE];
+} flac_state_t;
+
+static uint32_t read_be(const uint8_t* p, int bytes) {
+    uint32_t v = 0;
+    for (int i = 0; i < bytes; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+static uint64_t read_be64(const uint8_t* p) {
+    return ((uint64_t)read_be(p, 4) << 32) | read_be(p + 4, 4);
+}
+
+static uint8_t crc8(const uint8_t* p, uint32_t n) {
+    uint8_t crc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        crc ^= p[i];
+        for (int bit = 0; bit < 8; bit++) crc = (uint8_t)((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+    return crc;
+}
+
+// Bit reader
+static void bits_seek(flac_bits_t* b, uint64_t offset) {
+    audio_readahead_seek(b->stream, offset);
+    b->span = b->ptr = b->end = nullptr;
+    b->cache = 0;
+    b->count = 0;
+    b->loaded = offset;
+    b->crc_pos = offset;
+    b->crc = 0;
+    b->error = false;
+}
+
+// Moves the read position back to an offset in the span being read, with no
+// new card read; false when the span no longer holds it
+static bool bits_rewind(flac_bits_t* b, uint64_t offset) {
+    if (!b->span || offset > b->loaded || b->loaded - offset > (uint64_t)(b->ptr - b->span)) return false;
+    b->ptr -= b->loaded - offset;
+    b->cache = 0;
+    b->count = 0;
+    b->loaded = offset;
+    b->crc_pos = offset;
+    b->crc = 0;
+    b->error = false;
+    return true;
+}
+
+// Offset of the next unread byte; valid on byte boundaries
+static uint64_t bits_tell(const flac_bits_t* b) {
+    return b->loaded - b->count / 8;
+}
+
+static void bits_crc_start(flac_bits_t* b, uint64_t offset) {
+    b->crc = 0;
+    b->crc_pos = offset;
+}
+
+// Folds every byte the reader has fully consumed into the CRC
+static void bits_crc_catch_up(flac_bits_t* b) {
+    const uint64_t consumed = b->loaded - (b->count + 7) / 8;
+    while (b->crc_pos < consumed) {
+        b->crc = (uint16_t)((b->crc << 8) ^ k_crc16.v[(b->crc >> 8) ^ b->recent[b->crc_pos & 7]]);
+        b->crc_pos++;
+    }
+}
+
+static bool bits_next_span(flac_bits_t* b) {
+    if (b->span) audio_readahead_release(b->stream, (uint32_t)(b->end - b->span));
+    const uint8_t* data = nullptr;
+    uint32_t n = audio_readahead_acquire(b->stream, &data);
+    b->span = n ? data : nullptr;
+    b->ptr = b->span;
+    b->end = b->span ? data + n : nullptr;
+    return n > 0;
+}
+
+// Tops the cache up to more than 24 bits, fewer only at end of file
+static void bits_refill(flac_bits_t* b) {
+    bits_crc_catch_up(b);
+    while (b->count <= 24) {
+        if (b->ptr == b->end && !bits_next_span(b)) return;
+        const uint8_t byte = *b->ptr++;
+        b->recent[b->loaded & 7] = byte;
+        b->loaded++;
+        b->cache |= (uint32_t)byte << (24 - b->count);
+        b->count += 8;
+    }
+}
+
+// Up to 24 bits
+static inline uint32_t bits_read(flac_bits_t* b, uint32_t n) {
+    if (n == 0) return 0;
+    if (b->count < n) {
+        bits_refill(b);
+        if (b->count < n) {
+            b->error = true;
+            b->cache = 0;
+            b->count = 0;
+            return 0;
+        }
+    }
+    const uint32_t v = b->cache >> (32 - n);
+    b->cache <<= n;
+    b->count -= n;
+    return v;
+}
+
+static inline uint32_t bits_read32(flac_bits_t* b, uint32_t n) {
+    if (n <= 24) return bits_read(b, n);
+    const uint32_t high = bits_read(b, n - 16);
+    return (high << 16) | bits_read(b, 16);
+}
+
+static inline int32_t bits_read_signed(flac_bits_t* b, uint32_t n) {
+    if (n == 0) return 0;
+    const uint32_t v = bits_read32(b, n);
+    return n < 32 ? (int32_t)(v << (32 - n)) >> (32 - n) : (int32_t)v;
+}
+
+// Zeros before the next one bit, consuming the one
+static inline uint32_t bits_read_unary(flac_bits_t* b) {
+    uint32_t q = 0;
+    while (b->cache == 0) {
+        q += b->count;
+        b->count = 0;
+        bits_refill(b);
+        if (b->count == 0) {
+            b->error = true;
+            return 0;
+        }
+    }
+    const uint32_t used = (uint32_t)__builtin_clz(b->cache) + 1;
+    q += used - 1;
+    b->cache = used < 32 ? b->cache << used : 0;
+    b->count -= used;
+    return q;
+}
+
+static void bits_align(flac_bits_t* b) {
+    const uint32_t n = b->count & 7;
+    b->cache <<= n;
+    b->count -= n;
+}
+
+// Metadata
+static bool flac_accepts(const audio_source_t* source) {
+    return audio_source_has_extension(source, "flac");
+}
+
+// Offset just past an ID3v2 tag, which some taggers put before "fLaC"
+static uint64_t flac_skip_id3v2(hal_storage_file_t file) {
+    uint8_t id3[10];
+    if (hal_storage_read(file, id3, sizeof(id3)) != sizeof(id3) || memcmp(id3, "ID3", 3) != 0) return 0;
+    uint64_t size = ((uint32_t)(id3[6] & 0x7F) << 21) | ((uint32_t)(id3[7] & 0x7F) << 14) |
+                    ((uint32_t)(id3[8] & 0x7F) << 7) | (id3[9] & 0x7F);
+    return 10 + size + ((id3[5] & 0x10) ? 10 : 0);
+}
+
+// Reads the seek points, keeping at most FLAC_MAX_SEEK_POINTS spread evenly
+static bool flac_read_seektable(flac_state_t* st, hal_storage_file_t file, uint32_t len) {
+    const uint32_t count = len / 18;
+    const uint32_t stride = (count + FLAC_MAX_SEEK_POINTS - 1) / FLAC_MAX_SEEK_POINTS;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t point[18];
+        if (hal_storage_read(file, point, sizeof(point)) != sizeof(point)) return false;
+        const uint64_t sample = read_be64(point);
+        if (sample == FLAC_SEEK_PLACEHOLDER || i % stride != 0 || st->seek_count == FLAC_MAX_SEEK_POINTS) continue;
+        st->seek_points[st->seek_count].sample = sample;
+        st->seek_points[st->seek_count].offset = read_be64(point + 8);
+        st->seek_count++;
+    }
+    const uint32_t rest = len - count * 18;
+    return rest == 0 || hal_storage_seek(file, rest, HAL_STORAGE_SEEK_CUR);
+}
+
+// Walks the metadata blocks up to the first frame; seek points go to st when given
+static bool flac_parse_header(flac_header_t* h, flac_state_t* st) {
+    const uint64_t start = flac_skip_id3v2(h->file);
+    uint8_t magic[4];
+    if (!hal_storage_seek(h->file, (int64_t)start, HAL_STORAGE_SEEK_SET) ||
+        hal_storage_read(h->file, magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, "fLaC", 4) != 0) {
+        return false;
+    }
+
+    bool have_streaminfo = false;
+    for (;;) {
+        uint8_t block[4];
+        if (hal_storage_read(h->file, block, sizeof(block)) != sizeof(block)) return false;
+        const bool last = (block[0] & 0x80) != 0;
+        const uint32_t type = block[0] & 0x7F;
+        const uint32_t len = read_be(block + 1, 3);
+
+        if (type == FLAC_BLOCK_STREAMINFO) {
+            uint8_t info[34];
+            if (len < sizeof(info) || hal_storage_read(h->file, info, sizeof(info)) != sizeof(info)) return false;
+            if (len > sizeof(info) && !hal_storage_seek(h->file, len - sizeof(info), HAL_STORAGE_SEEK_CUR)) {
+                return false;
+            }
+            // min block (16), max block (16), min/max frame (24 each), then rate (20),
+            // channels - 1 (3), bits - 1 (5) and total samples (36) packed together
+            h->max_block = read_be(info + 2, 2);
+            const uint64_t packed = read_be64(info + 10);
+            h->sample_rate = (uint32_t)(packed >> 44);
+            h->channels = (uint16_t)(((packed >> 41) & 0x7) + 1);
+            h->bits = (uint16_t)(((packed >> 36) & 0x1F) + 1);
+            h->total_samples = packed & 0xFFFFFFFFFull;
+            have_streaminfo = true;
+        } else if (type == FLAC_BLOCK_SEEKTABLE && st) {
+            if (!flac_read_seektable(st, h->file, len)) return false;
+        } else if (!hal_storage_seek(h->file, len, HAL_STORAGE_SEEK_CUR)) {
+            return false;
+        }
+        if (last) break;
+    }
+    h->first_frame = (uint64_t)hal_storage_tell(h->file);
+    h->file_size = hal_storage_get_file_size_handle(h->file);
+    return have_streaminfo;
+}
+
+// Opens the file and reads STREAMINFO, rejecting streams this decoder cannot play
+static bool flac_read_header(flac_header_t* h, flac_state_t* st, const char* path, audio_stream_info_t* info) {
+    h->file = hal_storage_open(path, HAL_STORAGE_MODE_READ);
+    if (!h->file) return false;
+
+    if (!flac_parse_header(h, st) || h->sample_rate == 0 || h->channels > FLAC_MAX_CHANNELS ||
+        h->bits < FLAC_MIN_BITS || h->bits > FLAC_MAX_BITS || h->max_block < 16 ||
+        h->max_block > FLAC_MAX_BLOCK_SIZE) {
+        hal_storage_close(h->file);
+        h->file = nullptr;
+        return false;
+    }
+    info->sample_rate = h->sample_rate;
+    info->channels = h->channels;
+    info->bits_per_sample = h->bits;
+    info->total_frames = h->total_samples;
+    info->bitrate_kbps = 0;
+    if (h->total_samples && h->file_size > h->first_frame) {
+        info->bitrate_kbps = (uint32_t)((h->file_size - h->first_frame) * 8 * h->sample_rate /
+                                        h->total_samples / 1000);
+    }
+    return true;
+}
+
+// Frames
+// Finds the next frame header at or after the read position and parses it;
+// the frame CRC-16 then runs from its first byte
+static bool flac_next_header(flac_state_t* st, flac_frame_header_t* fh, uint32_t limit) {
+    flac_bits_t* b = &st->bits;
+    bits_align(b);
+    const uint64_t start = bits_tell(b);
+    uint32_t prev = 0;
+    for (;;) {
+        const uint32_t byte = bits_read(b, 8);
+        if (b->error || bits_tell(b) - start > limit) return false;
+        // Sync code: 0xFFF8, or 0xFFF9 for variable block sizes
+        if (prev != 0xFF || (byte & 0xFE) != 0xF8) {
+            prev = byte;
+            continue;
+        }
+        const uint64_t pos = bits_tell(b) - 2;
+        bits_crc_start(b, pos);
+
+        uint8_t raw[16] = { 0xFF, (uint8_t)byte };
+        uint32_t n = 2;
+        raw[n++] = (uint8_t)bits_read(b, 8);
+        raw[n++] = (uint8_t)bits_read(b, 8);
+        const uint32_t bs_code = raw[2] >> 4, rate_code = raw[2] & 0xF;
+        const uint32_t channel_mode = raw[3] >> 4, bits_code = (raw[3] >> 1) & 0x7;
+        bool valid = bs_code != 0 && rate_code != 15 && channel_mode <= FLAC_CHANNELS_MID_SIDE &&
+                     bits_code != 3 && (raw[3] & 1) == 0;
+
+        // Frame or sample number, UTF-8 coded
+        raw[n] = (uint8_t)bits_read(b, 8);
+        uint32_t extra = 0;
+        uint64_t number = raw[n];
+        if (raw[n] >= 0x80) {
+            while (extra < 7 && (raw[n] & (0x40 >> extra))) extra++;
+            valid = valid && extra >= 1 && extra <= 6 && raw[n] != 0xFF;
+            number = raw[n] & (0x3F >> extra);
+        }
+        n++;
+        for (uint32_t i = 0; valid && i < extra; i++) {
+            raw[n] = (uint8_t)bits_read(b, 8);
+            valid = (raw[n] & 0xC0) == 0x80;
+            number = (number << 6) | (raw[n++] & 0x3F);
+        }
+
+        uint32_t block_size = 0;
+        if (bs_code == 1) {
+            block_size = 192;
+        } else if (bs_code <= 5) {
+            block_size = 576u << (bs_code - 2);
+        } else if (bs_code <= 7) {
+            const uint32_t bytes = bs_code - 5;
+            block_size = 1;
+            for (uint32_t i = 0; i < bytes; i++) {
+                raw[n] = (uint8_t)bits_read(b, 8);
+                block_size += (uint32_t)raw[n++] << (8 * (bytes - 1 - i));
+            }
+        } else {
+            block_size = 256u << (bs_code - 8);
+        }
+        // The rate is only checked, never used: the stream's rate comes from STREAMINFO
+        const uint32_t rate_bytes = rate_code == 12 ? 1 : (rate_code >= 13 ? 2 : 0);
+        for (uint32_t i = 0; i < rate_bytes; i++) raw[n++] = (uint8_t)bits_read(b, 8);
+        const uint8_t crc = (uint8_t)bits_read(b, 8);
+
+        const uint32_t bits = bits_code ? k_sample_bits[bits_code] : st->header.bits;
+        const uint32_t channels = channel_mode < FLAC_CHANNELS_LEFT_SIDE ? channel_mode + 1 : 2;
+        if (b->error) return false;
+        if (valid && crc == crc8(raw, n) && bits == st->header.bits && channels == st->header.channels &&
+            block_size <= FLAC_MAX_BLOCK_SIZE) {
+            fh->block_size = block_size;
+            fh->channel_mode = channel_mode;
+            fh->bits = bits;
+            // Fixed block size streams number frames, variable ones number samples
+            fh->first_sample = (raw[1] & 1) ? number : number * st->header.max_block;
+            st->frame_pos = pos;
+            return true;
+        }
+        // Not a frame after all: rescan from the byte after the false sync, out
+        // of the buffered span unless the header began in the one before
+        if (!bits_rewind(b, pos + 1)) bits_seek(b, pos + 1);
+        prev = 0;
+    }
+}
+
+static bool flac_read_residual(flac_bits_t* b, int32_t* s, uint32_t block_size, uint32_t order) {
+    const uint32_t method = bits_read(b, 2);
+    if (method > 1) return false;
+    const uint32_t param_bits = method ? 5 : 4;
+    const uint32_t escape = method ? 31 : 15;
+    const uint32_t partition_order = bits_read(b, 4);
+    const uint32_t partitions = 1u << partition_order;
+    const uint32_t partition_size = block_size >> partition_order;
+    if (partition_size << partition_order != block_size || partition_size < order) return false;
+
+    int32_t* out = s + order;
+    for (uint32_t p = 0; p < partitions && !b->error; p++) {
+        const uint32_t n = p == 0 ? partition_size - order : partition_size;
+        const uint32_t k = bits_read(b, param_bits);
+        if (k == escape) {
+            const uint32_t raw_bits = bits_read(b, 5);
+            for (uint32_t i = 0; i < n; i++) out[i] = bits_read_signed(b, raw_bits);
+        } else {
+            for (uint32_t i = 0; i < n; i++) {
+                const uint32_t q = bits_read_unary(b);
+                const uint32_t u = (q << k) | bits_read32(b, k);
+                out[i] = (int32_t)(u >> 1) ^ -(int32_t)(u & 1);
+            }
+        }
+        out += n;
+    }
+    return !b->error;
+}
+
+// Prediction wraps in unsigned arithmetic: a valid stream never overflows, and a
+// damaged frame must not rely on undefined signed overflow before its CRC rejects it
+static inline int32_t wrap_add(int32_t a, uint32_t b) {
+    return (int32_t)((uint32_t)a + b);
+}
+
+static void flac_restore_fixed(int32_t* s, uint32_t n, uint32_t order) {
+    const uint32_t* u = (const uint32_t*)s;
+    switch (order) {
+        case 1:
+            for (uint32_t i = 1; i < n; i++) s[i] = wrap_add(s[i], u[i - 1]);
+            break;
+        case 2:
+            for (uint32_t i = 2; i < n; i++) s[i] = wrap_add(s[i], 2 * u[i - 1] - u[i - 2]);
+            break;
+        case 3:
+            for (uint32_t i = 3; i < n; i++) s[i] = wrap_add(s[i], 3 * (u[i - 1] - u[i - 2]) + u[i - 3]);
+            break;
+        case 4:
+            for (uint32_t i = 4; i < n; i++) {
+                s[i] = wrap_add(s[i], 4 * (u[i - 1] + u[i - 3]) - 6 * u[i - 2] - u[i - 4]);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// The order is a template argument so the inner loop unrolls into a chain of
+// multiply-accumulates with the coefficients held in registers
+template <int ORDER>
+static void flac_restore_lpc_order(int32_t* s, uint32_t n, const int32_t* coef, uint32_t shift) {
+    uint32_t c[ORDER];
+    for (int j = 0; j < ORDER; j++) c[j] = (uint32_t)coef[j];
+    for (uint32_t i = ORDER; i < n; i++) {
+        uint32_t sum = 0;
+        for (int j = 0; j < ORDER; j++) sum += c[j] * (uint32_t)s[i - 1 - j];
+        s[i] = wrap_add(s[i], (uint32_t)((int32_t)sum >> shift));
+    }
+}
+
+static void flac_restore_lpc32(int32_t* s, uint32_t n, const int32_t* coef, uint32_t order, uint32_t shift) {
+    switch (order) {
+        case 1:  flac_restore_lpc_order<1>(s, n, coef, shift);  return;
+        case 2:  flac_restore_lpc_order<2>(s, n, coef, shift);  return;
+        case 3:  flac_restore_lpc_order<3>(s, n, coef, shift);  return;
+        case 4:  flac_restore_lpc_order<4>(s, n, coef, shift);  return;
+        case 5:  flac_restore_lpc_order<5>(s, n, coef, shift);  return;
+        case 6:  flac_restore_lpc_order<6>(s, n, coef, shift);  return;
+        case 7:  flac_restore_lpc_order<7>(s, n, coef, shift);  return;
+        case 8:  flac_restore_lpc_order<8>(s, n, coef, shift);  return;
+        case 9:  flac_restore_lpc_order<9>(s, n, coef, shift);  return;
+        case 10: flac_restore_lpc_order<10>(s, n, coef, shift); return;
+        case 11: flac_restore_lpc_order<11>(s, n, coef, shift); return;
+        case 12: flac_restore_lpc_order<12>(s, n, coef, shift); return;
+        default:
+            for (uint32_t i = order; i < n; i++) {
+                uint32_t sum = 0;
+                for (uint32_t j = 0; j < order; j++) sum += (uint32_t)coef[j] * (uint32_t)s[i - 1 - j];
+                s[i] = wrap_add(s[i], (uint32_t)((int32_t)sum >> shift));
+            }
+            return;
+    }
+}
+
+static void flac_restore_lpc64(int32_t* s, uint32_t n, const int32_t* coef, uint32_t order, uint32_t shift) {
+    for (uint32_t i = order; i < n; i++) {
+        int64_t sum = 0;
+        for (uint32_t j = 0; j < order; j++) sum += (int64_t)coef[j] * s[i - 1 - j];
+        s[i] = wrap_add(s[i], (uint32_t)(sum >> shift));
+    }
+}
+
+static bool flac_read_subframe(flac_bits_t* b, int32_t* s, uint32_t n, uint32_t bits) {
+    const uint32_t header = bits_read(b, 8);
+    if (header & 0x80) return false;
+    const uint32_t type = (header >> 1) & 0x3F;
+    uint32_t wasted = 0;
+    if (header & 1) {
+        wasted = bits_read_unary(b) + 1;
+        if (wasted >= bits) return false;
+        bits -= wasted;
+    }
+
+    if (type == 0) {
+        const int32_t v = bits_read_signed(b, bits);
+        for (uint32_t i = 0; i < n; i++) s[i] = v;
+    } else if (type == 1) {
+        for (uint32_t i = 0; i < n; i++) s[i] = bits_read_signed(b, bits);
+    } else if (type >= 8 && type <= 12) {
+        const uint32_t order = type - 8;
+        if (order > n) return false;
+        for (uint32_t i = 0; i < order; i++) s[i] = bits_read_signed(b, bits);
+        if (!flac_read_residual(b, s, n, order)) return false;
+        flac_restore_fixed(s, n, order);
+    } else if (type >= 32) {
+        const uint32_t order = type - 31;
+        if (order > n) return false;
+        for (uint32_t i = 0; i < order; i++) s[i] = bits_read_signed(b, bits);
+        const uint32_t precision = bits_read(b, 4) + 1;
+        const int32_t shift = bits_read_signed(b, 5);
+        if (precision == 16 || shift < 0) return false;
+        int32_t coef[FLAC_MAX_LPC_ORDER];
+        uint64_t coef_sum = 0;
+        for (uint32_t i = 0; i < order; i++) {
+            coef[i] = bits_read_signed(b, precision);
+            coef_sum += (uint64_t)(coef[i] < 0 ? -(int64_t)coef[i] : coef[i]);
+        }
+        if (!flac_read_residual(b, s, n, order)) return false;
+        // Samples fit in bits, so this bounds every partial sum of the prediction
+        if ((coef_sum << (bits - 1)) < 0x80000000ull) {
+            flac_restore_lpc32(s, n, coef, order, (uint32_t)shift);
+        } else {
+            flac_restore_lpc64(s, n, coef, order, (uint32_t)shift);
+        }
+    } else {
+        return false;
+    }
+    if (b->error) return false;
+
+    if (wasted) {
+        for (uint32_t i = 0; i < n; i++) s[i] = (int32_t)((uint32_t)s[i] << wasted);
+    }
+    return true;
+}
+
+// Decodes the next frame into the sample blocks. A frame that fails its CRC
+// or does not parse becomes silence of the length its header gave.
+static bool flac_read_frame(flac_state_t* st) {
+    const flac_header_t* h = &st->header;
+    const uint64_t next = st->frame_sample + st->block_size;
+    if (h->total_samples && next >= h->total_samples) return false;
+
+    flac_frame_header_t fh;
+    if (!flac_next_header(st, &fh, FLAC_SYNC_LIMIT)) return false;
+
+    flac_bits_t* b = &st->bits;
+    const uint32_t channels = h->channels;
+    bool ok = true;
+    for (uint32_t ch = 0; ok && ch < channels; ch++) {
+        // The side channel carries one extra bit
+        const bool side = (fh.channel_mode == FLAC_CHANNELS_LEFT_SIDE && ch == 1) ||
+                          (fh.channel_mode == FLAC_CHANNELS_RIGHT_SIDE && ch == 0) ||
+                          (fh.channel_mode == FLAC_CHANNELS_MID_SIDE && ch == 1);
+        ok = flac_read_subframe(b, st->samples[ch], fh.block_size, fh.bits + (side ? 1 : 0));
+    }
+    if (b->error) return false;     // Truncated: the stream ends here
+    if (ok) {
+        bits_align(b);
+        bits_read(b, 16);
+        bits_crc_catch_up(b);
+        ok = !b->error && b->crc == 0;
+    }
+
+    int32_t* s0 = st->samples[0];
+    int32_t* s1 = st->samples[1];
+    const uint32_t n = fh.block_size;
+    if (!ok) {
+        st->errors++;
+        memset(s0, 0, n * sizeof(int32_t));
+        memset(s1, 0, n * sizeof(int32_t));
+    } else if (fh.channel_mode == FLAC_CHANNELS_LEFT_SIDE) {
+        for (uint32_t i = 0; i < n; i++) s1[i] = wrap_add(s0[i], 0u - (uint32_t)s1[i]);
+    } else if (fh.channel_mode == FLAC_CHANNELS_RIGHT_SIDE) {
+        for (uint32_t i = 0; i < n; i++) s0[i] = wrap_add(s0[i], (uint32_t)s1[i]);
+    } else if (fh.channel_mode == FLAC_CHANNELS_MID_SIDE) {
+        for (uint32_t i = 0; i < n; i++) {
+            const int32_t side = s1[i];
+            const int32_t mid = (int32_t)((uint32_t)s0[i] << 1) | (side & 1);
+            s0[i] = wrap_add(mid, (uint32_t)side) >> 1;
+            s1[i] = wrap_add(mid, 0u - (uint32_t)side) >> 1;
+        }
+    }
+
+    st->frame_sample = fh.first_sample;
+    st->block_size = n;
+    st->block_pos = 0;
+    // Ignore anything the encoder wrote past the stated length
+    if (h->total_samples && st->frame_sample + n > h->total_samples) {
+        st->block_size = st->frame_sample < h->total_samples ? (uint32_t)(h->total_samples - st->frame_sample) : 0;
+    }
+    return true;
+}
+
+// Operations
+static bool flac_open(void* state, const audio_source_t* source, audio_stream_info_t* info) {
+    flac_state_t* st = (flac_state_t*)state;
+    if (!flac_read_header(&st->header, st, source->path, info)) return false;
+    // Metadata came through a plain handle; frames come through read-ahead
+    hal_storage_close(st->header.file);
+    st->header.file = nullptr;
+    st->bits.stream = audio_readahead_open(source->path);
+    if (!st->bits.stream) return false;
+    bits_seek(&st->bits, st->header.first_frame);
+    return true;
+}
+
+static uint32_t flac_decode(void* state, int16_t* out, uint32_t max_frames) {
+    flac_state_t* st = (flac_state_t*)state;
+    const uint32_t bits = st->header.bits;
+    const bool stereo = st->header.channels == 2;
+    uint32_t produced = 0;
+
+    while (produced < max_frames) {
+        if (st->block_pos >= st->block_size) {
+            if (!flac_read_frame(st)) break;
+            // Decoding forward after a seek: drop what comes before the target
+            if (st->seek_target > st->frame_sample) {
+                const uint64_t drop = st->seek_target - st->frame_sample;
+                st->block_pos = drop < st->block_size ? (uint32_t)drop : st->block_size;
+            }
+            if (st->block_pos < st->block_size) st->seek_target = 0;
+            continue;
+        }
+
+        uint32_t n = st->block_size - st->block_pos;
+        if (n > max_frames - produced) n = max_frames - produced;
+        const int32_t* left = st->samples[0] + st->block_pos;
+        const int32_t* right = stereo ? st->samples[1] + st->block_pos : left;
+        int16_t* dst = out + (size_t)produced * 2;
+        if (bits >= 16) {
+            const uint32_t shift = bits - 16;
+            for (uint32_t i = 0; i < n; i++) {
+                dst[i * 2] = (int16_t)(left[i] >> shift);
+                dst[i * 2 + 1] = (int16_t)(right[i] >> shift);
+            }
+        } else {
+            const uint32_t shift = 16 - bits;
+            for (uint32_t i = 0; i < n; i++) {
+                dst[i * 2] = (int16_t)((uint32_t)left[i] << shift);
+                dst[i * 2 + 1] = (int16_t)((uint32_t)right[i] << shift);
+            }
+        }
+        st->block_pos += n;
+        produced += n;
+    }
+    return produced;
+}
+
+// Narrows [lo, hi) by the sample numbers of frame headers found inside it
+static uint64_t flac_bisect(flac_state_t* st, uint64_t target) {
+    const flac_header_t* h = &st->header;
+    uint64_t lo = h->first_frame, lo_sample = 0;
+    uint64_t hi = h->file_size, hi_sample = h->total_samples;
+    for (int i = 0; i < FLAC_SEEK_PROBES && hi - lo > FLAC_SEEK_LINEAR_BYTES && hi_sample > lo_sample; i++) {
+        uint64_t guess = lo + (uint64_t)((double)(hi - lo) * (double)(target - lo_sample) / (double)(hi_sample - lo_sample));
+        if (guess < lo + FLAC_SEEK_LINEAR_BYTES / 2) guess = lo + FLAC_SEEK_LINEAR_BYTES / 2;
+        if (guess > hi - FLAC_SEEK_LINEAR_BYTES / 2) guess = hi - FLAC_SEEK_LINEAR_BYTES / 2;
+
+        bits_seek(&st->bits, guess);
+        flac_frame_header_t fh;
+        if (!flac_next_header(st, &fh, FLAC_SYNC_LIMIT) || st->frame_pos >= hi) {
+            hi = guess;
+        } else if (fh.first_sample <= target) {
+            lo = st->frame_pos;
+            lo_sample = fh.first_sample;
+            if (target < fh.first_sample + fh.block_size) break;
+        } else {
+            hi = guess;
+            hi_sample = fh.first_sample;
+        }
+    }
+    return lo;
+}
+
+static bool flac_seek(void* state, uint64_t frame) {
+    flac_state_t* st = (flac_state_t*)state;
+    const flac_header_t* h = &st->header;
+    if (h->total_samples && frame > h->total_samples) frame = h->total_samples;
+
+    uint64_t offset = h->first_frame;
+    if (st->seek_count > 0) {
+        for (uint32_t i = 0; i < st->seek_count && st->seek_points[i].sample <= frame; i++) {
+            if (h->first_frame + st->seek_points[i].offset < h->file_size) {
+                offset = h->first_frame + st->seek_points[i].offset;
+            }
+        }
+    } else if (h->total_samples) {
+        offset = flac_bisect(st, frame);
+    }
+
+    bits_seek(&st->bits, offset);
+    st->frame_sample = 0;
+    st->block_size = 0;
+    st->block_pos = 0;
+    st->seek_target = frame;
+    return true;
+}
+
+static void flac_close(void* state) {
+    flac_state_t* st = (flac_state_t*)state;
+    audio_readahead_close(st->bits.stream);
+    st->bits.stream = nullptr;
+}
+
+static bool flac_probe(const audio_source_t* source, audio_stream_info_t* info) {
+    flac_header_t header;
+    if (!flac_read_header(&header, nullptr, source->path, info)) return false;
+    hal_storage_close(header.file);
+    return true;
+}
+
+const audio_decoder_ops_t audio_decoder_flac = {
+    "flac",
+    sizeof(flac_state_t),
+    flac_accepts,
+    flac_open,
+    flac_decode,
+    flac_seek,
+    flac_close,
+    flac_probe,
+};
@@ -0,0 +1,271 @@
+/*
+ * MP3 Decoder
+ * Drives ESP8266Audio's libmad generator and captures its output frames
+ *
+ * The generator pushes one sample at a time into an AudioOutput; the capture
+ * output below writes straight into the engine's block and refuses samples
+ * once the block is full, which makes loop() return so decode() can hand the
+ * block back. The first decoded MPEG frame is primed during open() so the
+ * sample rate is known before the engine configures the output.
+ *
+ * Seeking goes through the frame index in audio_mp3_index.h: the generator is
+ * restarted a couple of frames before the target, so the bit reservoir is
+ * refilled, and the decoded frames up to the exact sample are discarded.
+ * Untagged variable bitrate files seek by estimate until the loudness
+ * indexing job has cached their scanned table; seeks never scan.
+ *
+ * Source, output and generator are constructed in place inside the decoder
+ * state, which the engine allocates once, and libmad works in an arena there
+ * too: opening, seeking and closing a track never touch the heap.
+ */
+
+#include "audio/audio_decoder.h"
+#include "audio/audio_mp3_index.h"
+#include "audio/audio_readahead.h"
+
+#if AUDIO_DECODER_MP3
+
+#include <new>
+#include <string.h>
+#include <AudioFileSource.h>
+#include <AudioGeneratorMP3.h>
+#include <AudioOutput.h>
+
+#define MP3_PRIME_FRAMES        1152    // One MPEG-1 Layer III frame
+#define MP3_PREROLL_FRAMES      2       // Decoded and dropped before a seek target
+#define MP3_ERROR_BADDATAPTR    0x0235  // libmad: frame needs reservoir bytes it never saw
+#define MP3_MAD_BYTES           AudioGeneratorMP3::preAllocSize()   // Input buffer, stream, frame and synth
+
+// Reads through the read-ahead buffers instead of the SD library directly,
+// so a slow card stalls the filesystem task rather than libmad
+class AudioFileSourceHal : public AudioFileSource {
+public:
+    bool open(const char* filename) override {
+        stream = audio_readahead_open(filename);
+        return stream != nullptr;
+    }
+    uint32_t read(void* data, uint32_t len) override {
+        return stream ? audio_readahead_read(stream, data, len) : 0;
+    }
+    bool seek(int32_t pos, int dir) override {
+        if (!stream) return false;
+        int64_t base = dir == HAL_STORAGE_SEEK_CUR ? (int64_t)audio_readahead_tell(stream)
+                     : dir == HAL_STORAGE_SEEK_END ? (int64_t)audio_readahead_size(stream) : 0;
+        return base + pos >= 0 && audio_readahead_seek(stream, (uint64_t)(base + pos));
+    }
+    bool close() override {
+        audio_readahead_close(stream);
+        stream = nullptr;
+        return true;
+    }
+    bool isOpen() override { return stream != nullptr; }
+    uint32_t getSize() override { return (uint32_t)audio_readahead_size(stream); }
+    uint32_t getPos() override { return (uint32_t)audio_readahead_tell(stream); }
+
+private:
+    audio_readahead_t* stream = nullptr;
+};
+
+// Collects stereo frames into a caller-provided block
+class AudioOutputCapture : public AudioOutput {
+public:
+    void target(int16_t* out, uint32_t max_frames) {
+        dst = out;
+        capacity = max_frames;
+        filled = 0;
+    }
+    uint32_t frames() const { return filled; }
+    int rate() const { return hertz; }
+
+    bool begin() override { return true; }
+    bool SetRate(int hz) override { hertz = hz; return true; }
+    bool ConsumeSample(int16_t sample[2]) override {
+        if (filled >= capacity) return false;
+        MakeSampleStereo16(sample);
+        dst[filled * 2 + 0] = sample[LEFTCHANNEL];
+        dst[filled * 2 + 1] = sample[RIGHTCHANNEL];
+        filled++;
+        return true;
+    }
+    bool stop() override { return true; }
+
+private:
+    int16_t* dst = nullptr;
+    uint32_t capacity = 0;
+    uint32_t filled = 0;
+};
+
+typedef struct {
+    AudioFileSourceHal* source;             // Built in the spaces below while open
+    AudioGeneratorMP3* generator;
+    AudioOutputCapture* output;
+    alignas(AudioFileSourceHal) uint8_t source_space[sizeof(AudioFileSourceHal)];
+    alignas(AudioGeneratorMP3) uint8_t generator_space[sizeof(AudioGeneratorMP3)];
+    alignas(AudioOutputCapture) uint8_t output_space[sizeof(AudioOutputCapture)];
+    alignas(8) uint8_t mad_space[MP3_MAD_BYTES];
+    int16_t prime[MP3_PRIME_FRAMES * 2];    // Also scratch for discarded pre-roll
+    uint32_t prime_frames;
+    uint32_t prime_pos;
+    uint32_t discard;                       // Frames still to drop after a seek
+    char path[AUDIO_DECODER_MAX_PATH];
+    audio_mp3_index_t index;
+} mp3_state_t;
+
+static bool mp3_accepts(const audio_source_t* source) {
+    return audio_source_has_extension(source, "mp3");
+}
+
+static void mp3_close(void* state) {
+    mp3_state_t* st = (mp3_state_t*)state;
+    if (st->generator) {
+        st->generator->stop();
+        st->generator->~AudioGeneratorMP3();
+    }
+    if (st->source) {
+        st->source->close();
+        st->source->~AudioFileSourceHal();
+    }
+    if (st->output) st->output->~AudioOutputCapture();
+    st->generator = nullptr;
+    st->source = nullptr;
+    st->output = nullptr;
+}
+
+// libmad drops a frame whose bit reservoir starts before the restart point.
+// It never reaches the output, so it no longer needs discarding.
+static void mp3_status(void* data, int code, const char* message) {
+    (void)message;
+    mp3_state_t* st = (mp3_state_t*)data;
+    if (code == MP3_ERROR_BADDATAPTR && st->discard >= st->index.samples_per_frame) {
+        st->discard -= st->index.samples_per_frame;
+    }
+}
+
+// Runs the generator until the capture block is full or the stream ends
+static uint32_t mp3_pump(mp3_state_t* st, int16_t* out, uint32_t max_frames) {
+    st->output->target(out, max_frames);
+    while (st->output->frames() < max_frames) {
+        if (!st->generator->isRunning() || !st->generator->loop()) break;
+    }
+    return st->output->frames();
+}
+
+static bool mp3_open(void* state, const audio_source_t* source, audio_stream_info_t* info) {
+    mp3_state_t* st = (mp3_state_t*)state;
+    st->source = new (st->source_space) AudioFileSourceHal();
+    st->output = new (st->output_space) AudioOutputCapture();
+    st->generator = new (st->generator_space) AudioGeneratorMP3(st->mad_space, sizeof(st->mad_space));
+    if (!st->source->open(source->path)) {
+        mp3_close(state);
+        return false;
+    }
+    strncpy(st->path, source->path, sizeof(st->path) - 1);
+
+    // Index from the file head. Decoding starts at the first audio frame, past
+    // ID3v2 (cover art) and the Xing/VBRI frame, so frame numbers match the index.
+    hal_storage_file_t file = hal_storage_open(st->path, HAL_STORAGE_MODE_READ);
+    if (file) {
+        if (audio_mp3_index_open(&st->index, file) && st->index.kind == AUDIO_MP3_INDEX_NONE) {
+            audio_mp3_index_load(&st->index, st->path);
+        }
+        hal_storage_close(file);
+    }
+    if (st->index.data_start && !st->source->seek((int32_t)st->index.data_start, HAL_STORAGE_SEEK_SET)) {
+        mp3_close(state);
+        return false;
+    }
+
+    st->output->SetChannels(2);
+    st->generator->RegisterStatusCB(mp3_status, st);
+    if (!st->generator->begin(st->source, st->output)) {
+        mp3_close(state);
+        return false;
+    }
+
+    st->prime_frames = mp3_pump(st, st->prime, MP3_PRIME_FRAMES);
+    st->prime_pos = 0;
+    if (st->prime_frames == 0 || st->output->rate() <= 0) {
+        mp3_close(state);
+        return false;
+    }
+
+    info->sample_rate = (uint32_t)st->output->rate();
+    info->channels = 2;
+    info->bits_per_sample = 0;
+    info->total_frames = (uint64_t)st->index.total_frames * st->index.samples_per_frame;
+    info->bitrate_kbps = st->index.bitrate_kbps;
+    return true;
+}
+
+static uint32_t mp3_decode(void* state, int16_t* out, uint32_t max_frames) {
+    mp3_state_t* st = (mp3_state_t*)state;
+    uint32_t produced = 0;
+
+    // Pre-roll after a seek: decode into the scratch block and drop it
+    while (st->discard > 0) {
+        uint32_t n = st->discard < MP3_PRIME_FRAMES ? st->discard : MP3_PRIME_FRAMES;
+        uint32_t got = mp3_pump(st, st->prime, n);
+        if (got == 0) return 0;
+        st->discard = got < st->discard ? st->discard - got : 0;
+    }
+
+    if (st->prime_pos < st->prime_frames) {
+        produced = st->prime_frames - st->prime_pos;
+        if (produced > max_frames) produced = max_frames;
+        memcpy(out, st->prime + (size_t)st->prime_pos * 2, (size_t)produced * 2 * sizeof(int16_t));
+        st->prime_pos += produced;
+    }
+    if (produced < max_frames) {
+        produced += mp3_pump(st, out + (size_t)produced * 2, max_frames - produced);
+    }
+    return produced;
+}
+
+static bool mp3_seek(void* state, uint64_t frame) {
+    mp3_state_t* st = (mp3_state_t*)state;
+    const uint32_t samples = st->index.samples_per_frame;
+    if (samples == 0) return false;
+
+    hal_storage_file_t file = hal_storage_open(st->path, HAL_STORAGE_MODE_READ);
+    if (!file) return false;
+    // Variable bitrate without a TOC: the table if the job cached it since open, else an estimate
+    if (st->index.kind == AUDIO_MP3_INDEX_NONE) audio_mp3_index_load(&st->index, st->path);
+    const uint32_t target = (uint32_t)(frame / samples);
+    uint64_t offset = 0;
+    uint32_t located = 0;
+    bool ok = audio_mp3_index_locate(&st->index, file,
+                                     target > MP3_PREROLL_FRAMES ? target - MP3_PREROLL_FRAMES : 0,
+                                     &offset, &located);
+    hal_storage_close(file);
+    if (!ok) return false;
+
+    // libmad keeps undecoded bytes and stop() closes the source, so the
+    // generator restarts on the reopened file at the new offset
+    st->generator->stop();
+    if (!st->source->open(st->path) || !st->source->seek((int32_t)offset, HAL_STORAGE_SEEK_SET) ||
+        !st->generator->begin(st->source, st->output)) {
+        return false;
+    }
+    const uint64_t first = (uint64_t)located * samples;
+    st->discard = frame > first ? (uint32_t)(frame - first) : 0;
+    st->prime_frames = 0;
+    st->prime_pos = 0;
+    return true;
+}
+
+static bool mp3_probe(const audio_source_t* source, audio_stream_info_t* info) {
+    return audio_mp3_probe(source->path, info);
+}
+
+const audio_decoder_ops_t audio_decoder_mp3 = {
+    "mp3",
+    sizeof(mp3_state_t),
+    mp3_accepts,
+    mp3_open,
+    mp3_decode,
+    mp3_seek,
+    mp3_close,
+    mp3_probe,
+};
+
+#endif // AUDIO_DECODER_MP3
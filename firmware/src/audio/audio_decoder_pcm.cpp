@@ -0,0 +1,105 @@
+/*
+ * PCM Memory Decoder
+ * Plays raw 8/16-bit mono/stereo PCM handed to hal_audio_play_buffer()
+ */
+
+#include "audio/audio_decoder.h"
+#include "audio/audio_dsp.h"
+
+#include <string.h>
+
+#define PCM_SCRATCH_SAMPLES 256
+
+typedef struct {
+    const uint8_t* data;
+    uint32_t total_frames;
+    uint32_t position;
+    uint16_t channels;
+    uint16_t bytes_per_sample;
+    int16_t scratch[PCM_SCRATCH_SAMPLES];   // Mono samples awaiting upmix
+} pcm_state_t;
+
+static bool pcm_format_layout(hal_audio_format_t format, uint16_t* channels, uint16_t* bytes_per_sample) {
+    switch (format) {
+        case HAL_AUDIO_FORMAT_PCM_8BIT_MONO:    *channels = 1; *bytes_per_sample = 1; return true;
+        case HAL_AUDIO_FORMAT_PCM_8BIT_STEREO:  *channels = 2; *bytes_per_sample = 1; return true;
+        case HAL_AUDIO_FORMAT_PCM_16BIT_MONO:   *channels = 1; *bytes_per_sample = 2; return true;
+        case HAL_AUDIO_FORMAT_PCM_16BIT_STEREO: *channels = 2; *bytes_per_sample = 2; return true;
+        default:                                return false;
+    }
+}
+
+static bool pcm_accepts(const audio_source_t* source) {
+    uint16_t channels, bytes_per_sample;
+    return source->kind == AUDIO_SOURCE_MEMORY &&
+           pcm_format_layout(source->format, &channels, &bytes_per_sample);
+}
+
+static bool pcm_open(void* state, const audio_source_t* source, audio_stream_info_t* info) {
+    pcm_state_t* st = (pcm_state_t*)state;
+    if (!source->data || source->sample_rate == 0) return false;
+    if (!pcm_format_layout(source->format, &st->channels, &st->bytes_per_sample)) return false;
+
+    st->data = (const uint8_t*)source->data;
+    st->total_frames = (uint32_t)(source->size / (st->channels * st->bytes_per_sample));
+    st->position = 0;
+
+    info->sample_rate = source->sample_rate;
+    info->channels = st->channels;
+    info->bits_per_sample = st->bytes_per_sample * 8;
+    info->total_frames = st->total_frames;
+    info->bitrate_kbps = source->sample_rate * st->channels * st->bytes_per_sample * 8 / 1000;
+    return true;
+}
+
+// Converts one run of source samples to int16; src may be unaligned
+static void pcm_convert(const pcm_state_t* st, const uint8_t* src, int16_t* out, size_t count) {
+    if (st->bytes_per_sample == 2) {
+        memcpy(out, src, count * sizeof(int16_t));
+    } else {
+        audio_dsp_u8_to_s16(src, out, count);
+    }
+}
+
+static uint32_t pcm_decode(void* state, int16_t* out, uint32_t max_frames) {
+    pcm_state_t* st = (pcm_state_t*)state;
+    uint32_t frames = st->total_frames - st->position;
+    if (frames > max_frames) frames = max_frames;
+
+    const size_t stride = st->channels * st->bytes_per_sample;
+    const uint8_t* src = st->data + (size_t)st->position * stride;
+    if (st->channels == 2) {
+        pcm_convert(st, src, out, (size_t)frames * 2);
+    } else {
+        for (uint32_t done = 0; done < frames; ) {
+            uint32_t n = frames - done;
+            if (n > PCM_SCRATCH_SAMPLES) n = PCM_SCRATCH_SAMPLES;
+            pcm_convert(st, src + (size_t)done * stride, st->scratch, n);
+            audio_dsp_upmix_mono(st->scratch, out + (size_t)done * 2, n);
+            done += n;
+        }
+    }
+    st->position += frames;
+    return frames;
+}
+
+static bool pcm_seek(void* state, uint64_t frame) {
+    pcm_state_t* st = (pcm_state_t*)state;
+    st->position = frame < st->total_frames ? (uint32_t)frame : st->total_frames;
+    return true;
+}
+
+static void pcm_close(void* state) {
+    (void)state;
+}
+
+const audio_decoder_ops_t audio_decoder_pcm = {
+    "pcm",
+    sizeof(pcm_state_t),
+    pcm_accepts,
+    pcm_open,
+    pcm_decode,
+    pcm_seek,
+    pcm_close,
+    nullptr,
+};
@@ -0,0 +1,83 @@
+/*
+ * Tone Decoder
+ * Endless full-scale sine from a 256-entry table with a 32-bit phase accumulator
+ */
+
+#include "audio/audio_decoder.h"
+
+#include <math.h>
+
+#define TONE_TABLE_SIZE 256
+
+typedef struct {
+    uint32_t phase;
+    uint32_t phase_inc;
+} tone_state_t;
+
+static int16_t s_sine_table[TONE_TABLE_SIZE];
+static bool s_table_ready = false;
+
+static void build_sine_table() {
+    if (s_table_ready) return;
+    for (int i = 0; i < TONE_TABLE_SIZE; i++) {
+        float phase = (2.0f * (float)M_PI * i) / TONE_TABLE_SIZE;
+        s_sine_table[i] = (int16_t)(sinf(phase) * 32767.0f);
+    }
+    s_table_ready = true;
+}
+
+static bool tone_accepts(const audio_source_t* source) {
+    return source->kind == AUDIO_SOURCE_TONE;
+}
+
+static bool tone_open(void* state, const audio_source_t* source, audio_stream_info_t* info) {
+    tone_state_t* st = (tone_state_t*)state;
+    if (source->tone_hz == 0 || source->sample_rate == 0 || source->tone_hz >= source->sample_rate / 2) {
+        return false;
+    }
+
+    build_sine_table();
+    st->phase = 0;
+    st->phase_inc = (uint32_t)(((uint64_t)source->tone_hz << 32) / source->sample_rate);
+
+    info->sample_rate = source->sample_rate;
+    info->channels = 1;
+    info->bits_per_sample = 16;
+    info->total_frames = 0;
+    info->bitrate_kbps = 0;
+    return true;
+}
+
+static uint32_t tone_decode(void* state, int16_t* out, uint32_t max_frames) {
+    tone_state_t* st = (tone_state_t*)state;
+    uint32_t phase = st->phase;
+    for (uint32_t i = 0; i < max_frames; i++) {
+        int16_t s = s_sine_table[phase >> 24];
+        out[i * 2 + 0] = s;
+        out[i * 2 + 1] = s;
+        phase += st->phase_inc;
+    }
+    st->phase = phase;
+    return max_frames;
+}
+
+static bool tone_seek(void* state, uint64_t frame) {
+    tone_state_t* st = (tone_state_t*)state;
+    st->phase = (uint32_t)(frame * st->phase_inc);
+    return true;
+}
+
+static void tone_close(void* state) {
+    (void)state;
+}
+
+const audio_decoder_ops_t audio_decoder_tone = {
+    "tone",
+    sizeof(tone_state_t),
+    tone_accepts,
+    tone_open,
+    tone_decode,
+    tone_seek,
+    tone_close,
+    nullptr,
+};
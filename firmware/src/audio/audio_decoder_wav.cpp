@@ -0,0 +1,233 @@
+/*
+ * WAV Decoder
+ * RIFF/WAVE reader for 8/16/24/32-bit PCM and 32-bit float, including
+ * WAVE_FORMAT_EXTENSIBLE and up to AUDIO_DSP_MAX_CHANNELS channels
+ *
+ * Samples come from the read-ahead buffers (audio_readahead.h) in place:
+ * stereo 16-bit is copied into the output block, every other layout is
+ * converted to stereo int16 in one pass by audio_dsp_pcm_to_stereo(); wider
+ * sources are downmixed by speaker mask. Only a frame split across two
+ * chunks, or samples the data chunk left misaligned, go through the state
+ * buffer first.
+ */
+
+#include "audio/audio_decoder.h"
+#include "audio/audio_dsp.h"
+#include "audio/audio_readahead.h"
+
+#include <string.h>
+
+#define WAV_READ_BUFFER_BYTES 2048
+
+#define WAV_FORMAT_PCM          0x0001
+#define WAV_FORMAT_IEEE_FLOAT   0x0003
+#define WAV_FORMAT_EXTENSIBLE   0xFFFE
+
+// Layout from the RIFF header: everything a probe needs
+typedef struct {
+    hal_storage_file_t file;
+    uint64_t data_offset;           // First byte of the data chunk
+    uint64_t data_bytes;            // Size of the data chunk, whole frames
+    uint16_t block_align;
+    uint16_t format_tag;            // PCM or IEEE float, after resolving EXTENSIBLE
+    uint32_t speaker_mask;          // EXTENSIBLE dwChannelMask, 0 when absent
+    audio_dsp_pcm_format_t format;
+} wav_header_t;
+
+typedef struct {
+    wav_header_t header;
+    audio_readahead_t* stream;
+    uint64_t data_remaining;
+    uint16_t channels;
+    int32_t mix_q15[AUDIO_DSP_MAX_CHANNELS * 2];
+    alignas(4) uint8_t buffer[WAV_READ_BUFFER_BYTES];
+} wav_state_t;
+
+static uint16_t read_le16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool wav_accepts(const audio_source_t* source) {
+    return audio_source_has_extension(source, "wav");
+}
+
+// Walks the chunk list, reads "fmt " and stops at the start of "data"
+static bool wav_parse_header(wav_header_t* h, audio_stream_info_t* info) {
+    uint8_t riff[12];
+    if (hal_storage_read(h->file, riff, sizeof(riff)) != sizeof(riff)) return false;
+    if (memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) return false;
+
+    bool have_fmt = false;
+    for (;;) {
+        uint8_t chunk[8];
+        if (hal_storage_read(h->file, chunk, sizeof(chunk)) != sizeof(chunk)) return false;
+        uint32_t len = read_le32(chunk + 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            // WAVEFORMATEX plus the EXTENSIBLE tail (valid bits, channel mask, sub-format GUID)
+            uint8_t fmt[40];
+            uint32_t fmt_len = len < sizeof(fmt) ? len : sizeof(fmt);
+            if (fmt_len < 16 || hal_storage_read(h->file, fmt, fmt_len) != fmt_len) return false;
+            h->format_tag = read_le16(fmt + 0);
+            info->channels = read_le16(fmt + 2);
+            info->sample_rate = read_le32(fmt + 4);
+            info->bitrate_kbps = read_le32(fmt + 8) * 8 / 1000;
+            h->block_align = read_le16(fmt + 12);
+            info->bits_per_sample = read_le16(fmt + 14);
+            h->speaker_mask = 0;
+            if (h->format_tag == WAV_FORMAT_EXTENSIBLE) {
+                if (fmt_len < sizeof(fmt)) return false;
+                h->speaker_mask = read_le32(fmt + 20);
+                // The first two GUID bytes carry the ordinary format tag
+                h->format_tag = read_le16(fmt + 24);
+            }
+            // Chunks are word aligned
+            uint32_t skip = len - fmt_len + (len & 1);
+            if (skip && !hal_storage_seek(h->file, skip, HAL_STORAGE_SEEK_CUR)) return false;
+            have_fmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!have_fmt) return false;
+            h->data_offset = (uint64_t)hal_storage_tell(h->file);
+            h->data_bytes = len;
+            // Streams that were never finalized carry a zero or oversized length
+            uint64_t file_size = hal_storage_get_file_size_handle(h->file);
+            if (len == 0 || h->data_offset + len > file_size) {
+                h->data_bytes = file_size - h->data_offset;
+            }
+            return true;
+        } else if (!hal_storage_seek(h->file, (int64_t)len + (len & 1), HAL_STORAGE_SEEK_CUR)) {
+            return false;
+        }
+    }
+}
+
+// Maps the format tag and container width to a sample layout
+static bool wav_sample_format(uint16_t format_tag, uint16_t bits, audio_dsp_pcm_format_t* format) {
+    if (format_tag == WAV_FORMAT_IEEE_FLOAT) {
+        *format = AUDIO_DSP_PCM_F32;
+        return bits == 32;
+    }
+    if (format_tag != WAV_FORMAT_PCM) return false;
+    switch (bits) {
+        case 8:  *format = AUDIO_DSP_PCM_U8;  return true;
+        case 16: *format = AUDIO_DSP_PCM_S16; return true;
+        case 24: *format = AUDIO_DSP_PCM_S24; return true;
+        case 32: *format = AUDIO_DSP_PCM_S32; return true;
+        default: return false;
+    }
+}
+
+// Opens the file and reads its layout, leaving it at the first sample
+static bool wav_read_header(wav_header_t* h, const char* path, audio_stream_info_t* info) {
+    h->file = hal_storage_open(path, HAL_STORAGE_MODE_READ);
+    if (!h->file) return false;
+
+    if (!wav_parse_header(h, info) || !wav_sample_format(h->format_tag, info->bits_per_sample, &h->format) ||
+        info->channels == 0 || info->channels > AUDIO_DSP_MAX_CHANNELS || info->sample_rate == 0 ||
+        h->block_align != info->channels * audio_dsp_pcm_sample_bytes(h->format)) {
+        hal_storage_close(h->file);
+        h->file = nullptr;
+        return false;
+    }
+    h->data_bytes -= h->data_bytes % h->block_align;
+    info->total_frames = h->data_bytes / h->block_align;
+    return true;
+}
+
+static bool wav_open(void* state, const audio_source_t* source, audio_stream_info_t* info) {
+    wav_state_t* st = (wav_state_t*)state;
+    if (!wav_read_header(&st->header, source->path, info)) return false;
+    // The header came through a plain handle; samples come through read-ahead
+    hal_storage_close(st->header.file);
+    st->header.file = nullptr;
+    st->stream = audio_readahead_open(source->path);
+    if (!st->stream || !audio_readahead_seek(st->stream, st->header.data_offset)) {
+        audio_readahead_close(st->stream);
+        st->stream = nullptr;
+        return false;
+    }
+
+    st->channels = info->channels;
+    if (st->channels > 2) audio_dsp_downmix_matrix(st->header.speaker_mask, st->channels, st->mix_q15);
+    st->data_remaining = st->header.data_bytes;
+    return true;
+}
+
+static uint32_t wav_decode(void* state, int16_t* out, uint32_t max_frames) {
+    wav_state_t* st = (wav_state_t*)state;
+    const wav_header_t* h = &st->header;
+    const bool direct = h->format == AUDIO_DSP_PCM_S16 && st->channels == 2;
+    const size_t sample_bytes = audio_dsp_pcm_sample_bytes(h->format);
+    uint32_t produced = 0;
+
+    while (produced < max_frames && st->data_remaining > 0) {
+        uint32_t frames = max_frames - produced;
+        if (frames > st->data_remaining / h->block_align) frames = (uint32_t)(st->data_remaining / h->block_align);
+
+        const uint8_t* src = nullptr;
+        uint32_t available = audio_readahead_acquire(st->stream, &src);
+        if (available / h->block_align < frames) frames = available / h->block_align;
+        bool in_place = frames > 0 && (direct || (uintptr_t)src % (sample_bytes == 3 ? 1 : sample_bytes) == 0);
+        if (!in_place && available > 0) {
+            // Split across chunks or misaligned for the converter: copy through the state buffer
+            frames = max_frames - produced;
+            if (frames > st->data_remaining / h->block_align) frames = (uint32_t)(st->data_remaining / h->block_align);
+            if (frames > WAV_READ_BUFFER_BYTES / h->block_align) frames = WAV_READ_BUFFER_BYTES / h->block_align;
+            frames = audio_readahead_read(st->stream, st->buffer, frames * h->block_align) / h->block_align;
+            src = st->buffer;
+        }
+        if (frames == 0) {
+            st->data_remaining = 0;     // Truncated file
+            break;
+        }
+        st->data_remaining -= (uint64_t)frames * h->block_align;
+
+        int16_t* dst = out + (size_t)produced * 2;
+        if (direct) {
+            memcpy(dst, src, (size_t)frames * h->block_align);
+        } else {
+            audio_dsp_pcm_to_stereo(src, dst, frames, h->format, st->channels, st->mix_q15);
+        }
+        if (in_place) audio_readahead_release(st->stream, frames * h->block_align);
+        produced += frames;
+    }
+    return produced;
+}
+
+static bool wav_seek(void* state, uint64_t frame) {
+    wav_state_t* st = (wav_state_t*)state;
+    const wav_header_t* h = &st->header;
+    uint64_t offset = frame * h->block_align;
+    if (offset > h->data_bytes) offset = h->data_bytes;
+    if (!audio_readahead_seek(st->stream, h->data_offset + offset)) return false;
+    st->data_remaining = h->data_bytes - offset;
+    return true;
+}
+
+static void wav_close(void* state) {
+    wav_state_t* st = (wav_state_t*)state;
+    audio_readahead_close(st->stream);
+    st->stream = nullptr;
+}
+
+static bool wav_probe(const audio_source_t* source, audio_stream_info_t* info) {
+    wav_header_t header;
+    if (!wav_read_header(&header, source->path, info)) return false;
+    hal_storage_close(header.file);
+    return true;
+}
+
+const audio_decoder_ops_t audio_decoder_wav = {
+    "wav",
+    sizeof(wav_state_t),
+    wav_accepts,
+    wav_open,
+    wav_decode,
+    wav_seek,
+    wav_close,
+    wav_probe,
+};
@@ -0,0 +1,295 @@
+/*
+ * Audio DSP Kernels
+ * Q15 gain, channel layout, saturation and sample format conversion
+ *
+ * Loops are kept in the shape both compilers handle best: a single counted
+ * loop, restrict-qualified buffers, 32-bit math and min/max clamping. GCC
+ * vectorizes them on the host; on the ESP32 they lower to MUL16/MULL inside
+ * zero-overhead LOOP blocks and live in IRAM so a flash cache miss never
+ * stalls the audio task.
+ */
+
+#include "audio/audio_dsp.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifdef PLATFORM_ESP32
+#include <esp_attr.h>
+#define DSP_HOT IRAM_ATTR
+#else
+#define DSP_HOT
+#endif
+
+#define DSP_RESTRICT __restrict__
+
+// Both targets are little endian, so LE16 data is already native int16
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "audio_dsp assumes a little-endian target"
+#endif
+
+static inline int32_t dsp_clamp16(int32_t v) {
+    v = v < -32768 ? -32768 : v;
+    return v > 32767 ? 32767 : v;
+}
+
+// Splits a Q15 gain into a multiplier below 2^16 and a right shift so that
+// sample * multiplier always fits in 32 bits
+static inline int dsp_gain_shift(int32_t* gain) {
+    int shift = 15;
+    while (*gain > 0xFFFF) {
+        *gain >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+int32_t audio_dsp_gain_from_percent(uint8_t percent) {
+    if (percent >= 100) return AUDIO_DSP_Q15_ONE;
+    return (int32_t)percent * AUDIO_DSP_Q15_ONE / 100;
+}
+
+int32_t audio_dsp_gain_from_db(float db) {
+    float gain = powf(10.0f, db / 20.0f) * (float)AUDIO_DSP_Q15_ONE + 0.5f;
+    if (gain >= (float)AUDIO_DSP_GAIN_MAX_Q15) return AUDIO_DSP_GAIN_MAX_Q15;
+    return gain > 0.0f ? (int32_t)gain : 0;
+}
+
+int32_t audio_dsp_gain_multiply(int32_t a_q15, int32_t b_q15) {
+    int64_t gain = ((int64_t)a_q15 * b_q15) >> 15;
+    if (gain < 0) return 0;
+    return gain > AUDIO_DSP_GAIN_MAX_Q15 ? AUDIO_DSP_GAIN_MAX_Q15 : (int32_t)gain;
+}
+
+DSP_HOT void audio_dsp_gain_q15(int16_t* samples, size_t count, int32_t gain_q15) {
+    if (gain_q15 == AUDIO_DSP_Q15_ONE) return;
+    if (gain_q15 <= 0) {
+        memset(samples, 0, count * sizeof(int16_t));
+        return;
+    }
+    const int shift = dsp_gain_shift(&gain_q15);
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = (int16_t)dsp_clamp16(((int32_t)samples[i] * gain_q15) >> shift);
+    }
+}
+
+DSP_HOT void audio_dsp_gain_q15_copy(const int16_t* DSP_RESTRICT in, int16_t* DSP_RESTRICT out,
+                                     size_t count, int32_t gain_q15) {
+    if (gain_q15 == AUDIO_DSP_Q15_ONE) {
+        memcpy(out, in, count * sizeof(int16_t));
+        return;
+    }
+    if (gain_q15 <= 0) {
+        memset(out, 0, count * sizeof(int16_t));
+        return;
+    }
+    const int shift = dsp_gain_shift(&gain_q15);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (int16_t)dsp_clamp16(((int32_t)in[i] * gain_q15) >> shift);
+    }
+}
+
+DSP_HOT void audio_dsp_upmix_mono(const int16_t* DSP_RESTRICT in, int16_t* DSP_RESTRICT out, size_t frames) {
+    for (size_t i = 0; i < frames; i++) {
+        out[i * 2 + 0] = in[i];
+        out[i * 2 + 1] = in[i];
+    }
+}
+
+DSP_HOT void audio_dsp_downmix_to_mono(const int16_t* DSP_RESTRICT in, int16_t* DSP_RESTRICT out, size_t frames) {
+    for (size_t i = 0; i < frames; i++) {
+        out[i] = (int16_t)(((int32_t)in[i * 2 + 0] + in[i * 2 + 1]) >> 1);
+    }
+}
+
+DSP_HOT void audio_dsp_mix_sat(int16_t* DSP_RESTRICT acc, const int16_t* DSP_RESTRICT in, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        acc[i] = (int16_t)dsp_clamp16((int32_t)acc[i] + in[i]);
+    }
+}
+
+DSP_HOT void audio_dsp_mix_s32_sat(int16_t* DSP_RESTRICT acc, const int32_t* DSP_RESTRICT in, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        acc[i] = (int16_t)dsp_clamp16((int32_t)acc[i] + in[i]);
+    }
+}
+
+DSP_HOT void audio_dsp_saturate_s32(const int32_t* DSP_RESTRICT in, int16_t* DSP_RESTRICT out,
+                                    size_t count, int shift) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (int16_t)dsp_clamp16(in[i] >> shift);
+    }
+}
+
+// sin(pi/2 * x) for x in [0, 1] as Q15, odd polynomial fitted with f(1) = 1
+static inline int32_t dsp_quarter_sine_q15(int32_t x) {
+    const int32_t x2 = (x * x) >> 15;
+    int32_t t = (2340 * x2) >> 15;
+    t = ((21026 - t) * x2) >> 15;
+    t = ((51454 - t) * x) >> 15;
+    return t > AUDIO_DSP_Q15_ONE ? AUDIO_DSP_Q15_ONE : t;
+}
+
+int32_t audio_dsp_fade_gain_q15(uint32_t pos, uint32_t length) {
+    if (pos >= length) return AUDIO_DSP_Q15_ONE;
+    return dsp_quarter_sine_q15((int32_t)(((uint64_t)pos << 15) / length));
+}
+
+DSP_HOT void audio_dsp_crossfade(int16_t* DSP_RESTRICT incoming, const int16_t* DSP_RESTRICT outgoing,
+                                 size_t frames, uint32_t pos, uint32_t length) {
+    // Fade position in Q31 of the whole fade, stepped per frame instead of divided
+    const uint32_t step = length ? (uint32_t)((1ull << 31) / length) : 0;
+    uint32_t x = length ? (uint32_t)(((uint64_t)(pos < length ? pos : length) << 31) / length) : 1u << 31;
+    for (size_t i = 0; i < frames; i++) {
+        const int32_t t = (int32_t)(x >> 16);
+        const int32_t in_gain = dsp_quarter_sine_q15(t);
+        const int32_t out_gain = dsp_quarter_sine_q15(AUDIO_DSP_Q15_ONE - t);
+        // Both products are at most 2^30 in magnitude, so the sum fits in 32 bits
+        incoming[i * 2 + 0] = (int16_t)dsp_clamp16(((int32_t)incoming[i * 2 + 0] * in_gain +
+                                                    (int32_t)outgoing[i * 2 + 0] * out_gain) >> 15);
+        incoming[i * 2 + 1] = (int16_t)dsp_clamp16(((int32_t)incoming[i * 2 + 1] * in_gain +
+                                                    (int32_t)outgoing[i * 2 + 1] * out_gain) >> 15);
+        x += step;
+        if (x > 1u << 31) x = 1u << 31;
+    }
+}
+
+DSP_HOT void audio_dsp_u8_to_s16(const uint8_t* DSP_RESTRICT in, int16_t* DSP_RESTRICT out, size_t count) {
+    // 8-bit PCM is unsigned with a 128 midpoint
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (int16_t)(((int32_t)in[i] - 128) * 256);
+    }
+}
+
+DSP_HOT void audio_dsp_s24le_to_s16(const uint8_t* DSP_RESTRICT in, int16_t* DSP_RESTRICT out, size_t count) {
+    // Keep the top two bytes of each packed sample
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (int16_t)(in[i * 3 + 1] | (in[i * 3 + 2] << 8));
+    }
+}
+
+DSP_HOT void audio_dsp_s32_to_s16(const int32_t* DSP_RESTRICT in, int16_t* DSP_RESTRICT out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (int16_t)(in[i] >> 16);
+    }
+}
+
+DSP_HOT void audio_dsp_f32_to_s16(const float* DSP_RESTRICT in, int16_t* DSP_RESTRICT out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float v = in[i] * 32768.0f;
+        v = v < -32768.0f ? -32768.0f : v;
+        v = v > 32767.0f ? 32767.0f : v;
+        out[i] = (int16_t)v;
+    }
+}
+
+// Per-format sample loaders for the one-pass layout converter
+static inline int32_t dsp_load_u8(const uint8_t* p, size_t i) {
+    return ((int32_t)p[i] - 128) * 256;
+}
+
+static inline int32_t dsp_load_s16(const uint8_t* p, size_t i) {
+    return ((const int16_t*)p)[i];
+}
+
+static inline int32_t dsp_load_s24(const uint8_t* p, size_t i) {
+    return (int16_t)(p[i * 3 + 1] | (p[i * 3 + 2] << 8));
+}
+
+static inline int32_t dsp_load_s32(const uint8_t* p, size_t i) {
+    return ((const int32_t*)p)[i] >> 16;
+}
+
+static inline int32_t dsp_load_f32(const uint8_t* p, size_t i) {
+    float v = ((const float*)p)[i] * 32768.0f;
+    v = v < -32768.0f ? -32768.0f : v;
+    v = v > 32767.0f ? 32767.0f : v;
+    return (int32_t)v;
+}
+
+template <int32_t (*Load)(const uint8_t*, size_t)>
+static DSP_HOT void dsp_pcm_to_stereo(const uint8_t* DSP_RESTRICT in, int16_t* DSP_RESTRICT out, size_t frames,
+                                      uint16_t channels, const int32_t* DSP_RESTRICT mix_q15) {
+    if (channels == 1) {
+        for (size_t i = 0; i < frames; i++) {
+            int16_t s = (int16_t)Load(in, i);
+            out[i * 2 + 0] = s;
+            out[i * 2 + 1] = s;
+        }
+    } else if (channels == 2) {
+        for (size_t i = 0; i < frames * 2; i++) out[i] = (int16_t)Load(in, i);
+    } else {
+        for (size_t i = 0; i < frames; i++) {
+            int32_t left = 1 << 14, right = 1 << 14;
+            for (uint16_t c = 0; c < channels; c++) {
+                int32_t s = Load(in, i * channels + c);
+                left += s * mix_q15[c * 2 + 0];
+                right += s * mix_q15[c * 2 + 1];
+            }
+            out[i * 2 + 0] = (int16_t)dsp_clamp16(left >> 15);
+            out[i * 2 + 1] = (int16_t)dsp_clamp16(right >> 15);
+        }
+    }
+}
+
+void audio_dsp_pcm_to_stereo(const void* in, int16_t* out, size_t frames, audio_dsp_pcm_format_t format,
+                             uint16_t channels, const int32_t* mix_q15) {
+    const uint8_t* src = (const uint8_t*)in;
+    switch (format) {
+        case AUDIO_DSP_PCM_U8:  dsp_pcm_to_stereo<dsp_load_u8>(src, out, frames, channels, mix_q15); break;
+        case AUDIO_DSP_PCM_S16: dsp_pcm_to_stereo<dsp_load_s16>(src, out, frames, channels, mix_q15); break;
+        case AUDIO_DSP_PCM_S24: dsp_pcm_to_stereo<dsp_load_s24>(src, out, frames, channels, mix_q15); break;
+        case AUDIO_DSP_PCM_S32: dsp_pcm_to_stereo<dsp_load_s32>(src, out, frames, channels, mix_q15); break;
+        case AUDIO_DSP_PCM_F32: dsp_pcm_to_stereo<dsp_load_f32>(src, out, frames, channels, mix_q15); break;
+    }
+}
+
+size_t audio_dsp_pcm_sample_bytes(audio_dsp_pcm_format_t format) {
+    switch (format) {
+        case AUDIO_DSP_PCM_U8:  return 1;
+        case AUDIO_DSP_PCM_S16: return 2;
+        case AUDIO_DSP_PCM_S24: return 3;
+        default:                return 4;
+    }
+}
+
+void audio_dsp_downmix_matrix(uint32_t speaker_mask, uint16_t channels, int32_t* mix_q15) {
+    // WAVE speaker bits by side: FL, BL, FLC, SL, TFL, TBL / FR, BR, FRC, SR, TFR, TBR
+    const uint32_t left_bits = 0x00001 | 0x00010 | 0x00040 | 0x00200 | 0x01000 | 0x08000;
+    const uint32_t right_bits = 0x00002 | 0x00020 | 0x00080 | 0x00400 | 0x04000 | 0x20000;
+    const uint32_t lfe_bit = 0x00008;
+    const float centre = 0.70710678f;
+
+    float weights[AUDIO_DSP_MAX_CHANNELS * 2];
+    float sum_left = 0.0f, sum_right = 0.0f;
+    uint32_t bit = 1;
+    for (uint16_t c = 0; c < channels && c < AUDIO_DSP_MAX_CHANNELS; c++) {
+        // Channels are stored in mask bit order; unnamed ones take the default order
+        while (speaker_mask && bit && !(speaker_mask & bit)) bit <<= 1;
+        uint32_t speaker = speaker_mask && bit ? bit : (1u << c);
+        bit <<= 1;
+
+        float left = 0.0f, right = 0.0f;
+        if (speaker & left_bits) left = 1.0f;
+        else if (speaker & right_bits) right = 1.0f;
+        else if (!(speaker & lfe_bit)) left = right = centre;
+        weights[c * 2 + 0] = left;
+        weights[c * 2 + 1] = right;
+        sum_left += left;
+        sum_right += right;
+    }
+
+    float scale_left = sum_left > 1.0f ? 1.0f / sum_left : 1.0f;
+    float scale_right = sum_right > 1.0f ? 1.0f / sum_right : 1.0f;
+    for (uint16_t c = 0; c < channels && c < AUDIO_DSP_MAX_CHANNELS; c++) {
+        mix_q15[c * 2 + 0] = (int32_t)(weights[c * 2 + 0] * scale_left * AUDIO_DSP_Q15_ONE + 0.5f);
+        mix_q15[c * 2 + 1] = (int32_t)(weights[c * 2 + 1] * scale_right * AUDIO_DSP_Q15_ONE + 0.5f);
+    }
+}
+
+void audio_dsp_s16_to_f32(const int16_t* DSP_RESTRICT in, float* DSP_RESTRICT out, size_t count) {
+    const float scale = 1.0f / 32768.0f;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (float)in[i] * scale;
+    }
+}
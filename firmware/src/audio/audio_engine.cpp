@@ -0,0 +1,1222 @@
+/*
+ * Audio Engine Implementation
+ * One task, one current decoder plus one fading out, commands through a queue
+ */
+
+#include "audio/audio_engine.h"
+#include "audio/audio_dsp.h"
+#include "audio/audio_resampler.h"
+#include "audio/audio_eq.h"
+#include "audio/audio_analyzer.h"
+#include "audio/audio_synth.h"
+#include "hal/hal_audio.h"
+#include "hal/hal_system.h"
+#include "hal/hal_storage.h"
+
+#include <atomic>
+#include <utility>
+#include <string.h>
+
+typedef enum {
+    ENGINE_CMD_PLAY = 0,
+    ENGINE_CMD_STOP,
+    ENGINE_CMD_PAUSE,
+    ENGINE_CMD_RESUME,
+    ENGINE_CMD_SEEK,
+    ENGINE_CMD_QUEUE_NEXT,
+    ENGINE_CMD_CLEAR_NEXT,
+    ENGINE_CMD_WAKE,                        // Notes were posted to the synth
+    ENGINE_CMD_QUIT
+} engine_cmd_type_t;
+
+typedef struct {
+    engine_cmd_type_t type;
+    uint32_t position_ms;
+    audio_source_t source;
+} engine_cmd_t;
+
+// One decoding source and its conversion to the fixed output rate
+typedef struct {
+    const audio_decoder_ops_t* decoder;
+    void* state;
+    audio_source_t source;
+    audio_stream_info_t info;
+    int16_t* head;                          // Frames pre-decoded before the track started
+    uint32_t head_frames;
+    uint32_t head_pos;
+
+    audio_resampler_t resampler;
+    int16_t* staging;                       // Source-rate frames waiting for the resampler
+    uint32_t staging_frames;
+    uint32_t staging_pos;
+    bool draining;                          // Source ended; flushing the filter tail
+
+    audio_loudness_t loudness;              // Looked up when the track was opened
+    int32_t replay_gain_q15;                // Its gain under the current mode
+} engine_voice_t;
+
+// Output frame from which the track position is known; the clock counts on from it
+typedef struct {
+    uint32_t out_frame;                     // In frames rendered since init
+    uint32_t track_frame;                   // Source frame playing there
+    uint32_t sample_rate;                   // Source rate; 0 when nothing plays from here
+    uint32_t duration_ms;
+    bool held;                              // Paused: the track stays at track_frame
+} engine_mark_t;
+
+// A mark as published: rewritten in place under a sequence count, so readers
+// never wait and skip a slot they catch half written
+typedef struct {
+    std::atomic<uint32_t> sequence;         // Odd while being rewritten
+    std::atomic<uint32_t> out_frame;
+    std::atomic<uint32_t> track_frame;
+    std::atomic<uint32_t> sample_rate;
+    std::atomic<uint32_t> duration_ms;
+    std::atomic<bool> held;
+} engine_mark_slot_t;
+
+// Engine state
+static struct {
+    bool initialized;
+    bool task_mode;
+    uint32_t block_frames;
+    hal_queue_t commands;
+    hal_task_handle_t task;
+    hal_semaphore_t task_done;
+    bool quit;                              // Engine task only
+
+    // Current source (engine task only)
+    engine_voice_t voice;
+    int16_t* block;
+    uint32_t render_pos;                    // Frames already rendered into the current block
+    uint32_t position_frames;               // Source frames decoded from the current track
+    size_t decoder_state_size;
+    uint32_t output_rate;
+    audio_resampler_quality_t resampler_quality;
+
+    // Previous track fading out under the current one (engine task only). It
+    // keeps its own staging and resampler but runs on the decoder state and
+    // head borrowed from the gapless slot, which prefetches nothing meanwhile.
+    engine_voice_t outgoing;
+    int16_t* mix;                           // One block of the outgoing voice
+    uint8_t* tags;                          // Loudness tag read at track open (engine task only)
+    uint32_t fade_frames;                   // Output frames in the running fade, 0 when none
+    uint32_t fade_pos;
+
+    // Equalizer: designed on the caller's task, swapped in lock-free at block start
+    audio_eq_t eq;
+    hal_mutex_t eq_lock;                    // Serializes setters; the engine task never takes it
+
+    // Metering of the rendered output, read lock-free by the UI
+    audio_analyzer_t analyzer;
+
+    // UI sounds over the music; they keep the task rendering while nothing plays
+    audio_synth_t synth;
+    std::atomic<bool> synth_wake;           // A wake command is queued and not yet run
+
+    // Track queued to follow the current one, opened ahead for a gapless splice (engine task only)
+    struct {
+        bool pending;                       // Queued; decoder is set once opened
+        const audio_decoder_ops_t* decoder;
+        void* state;
+        audio_source_t source;
+        audio_stream_info_t info;
+        int16_t* head;
+        uint32_t head_frames;
+        audio_loudness_t loudness;
+    } next;
+
+    // Published to other tasks
+    std::atomic<int> state;                 // hal_audio_state_t
+    std::atomic<int> source_kind;           // audio_source_kind_t
+    std::atomic<const char*> decoder_name;
+    std::atomic<int> last_error;            // hal_audio_error_t
+    std::atomic<uint32_t> sample_rate;      // Source rate of the current track
+    std::atomic<uint32_t> duration_ms;
+    std::atomic<uint8_t> volume;
+    std::atomic<bool> muted;
+    std::atomic<int32_t> gain_q15;          // Volume and mute folded into one multiplier
+    std::atomic<bool> loop;
+    std::atomic<uint32_t> crossfade_ms;
+    std::atomic<int> replay_gain_mode;      // audio_replay_gain_mode_t
+    std::atomic<float> replay_gain_preamp_db;
+    std::atomic<uint32_t> replay_gain_serial;   // Bumped by every setting change
+    uint32_t replay_gain_applied;           // Serial the voices' gains were computed for (engine task only)
+
+    std::atomic<bool> next_queued;
+
+    // Playback clock
+    engine_mark_slot_t marks[AUDIO_ENGINE_CLOCK_MARKS];
+    std::atomic<uint32_t> marks_written;
+    std::atomic<uint32_t> frames_rendered;  // Output frames produced since init
+    std::atomic<uint32_t> clock_offset;     // HAL frames written minus frames_rendered (task mode)
+
+    hal_audio_callback_t end_callback;
+    void* end_user_data;
+    hal_audio_callback_t track_callback;
+    void* track_user_data;
+    hal_audio_data_callback_t data_callback;
+    void* data_user_data;
+
+    audio_engine_stats_t stats;
+} g_engine;
+
+// Recomputes the Q15 output gain; called on volume/mute changes, never per block
+static void engine_update_gain() {
+    int32_t gain = 0;
+    if (!g_engine.muted.load(std::memory_order_relaxed)) {
+        uint32_t volume = g_engine.volume.load(std::memory_order_relaxed);
+        gain = audio_dsp_gain_from_percent((uint8_t)(volume * 100 / HAL_AUDIO_MAX_VOLUME));
+    }
+    g_engine.gain_q15.store(gain, std::memory_order_relaxed);
+}
+
+// A file's loudness: cache record or tags. Generated and memory sources have none.
+static void engine_lookup_loudness(const audio_source_t* source, audio_loudness_t* loudness) {
+    if (source->kind != AUDIO_SOURCE_FILE || !audio_loudness_lookup(source->path, loudness, g_engine.tags)) {
+        memset(loudness, 0, sizeof(*loudness));
+    }
+}
+
+static void engine_update_replay_gain(engine_voice_t* voice) {
+    voice->replay_gain_q15 = audio_loudness_gain_q15(
+        &voice->loudness, (audio_replay_gain_mode_t)g_engine.replay_gain_mode.load(std::memory_order_relaxed),
+        g_engine.replay_gain_preamp_db.load(std::memory_order_relaxed));
+}
+
+static void engine_close_voice(engine_voice_t* voice) {
+    if (voice->decoder) {
+        voice->decoder->close(voice->state);
+        voice->decoder = nullptr;
+    }
+    voice->head_frames = 0;
+    voice->head_pos = 0;
+}
+
+static void engine_close_decoder() {
+    engine_close_voice(&g_engine.voice);
+    g_engine.source_kind = AUDIO_SOURCE_NONE;
+    g_engine.decoder_name = "";
+}
+
+static void engine_clear_next() {
+    if (g_engine.next.decoder) g_engine.next.decoder->close(g_engine.next.state);
+    g_engine.next.decoder = nullptr;
+    g_engine.next.pending = false;
+    g_engine.next.head_frames = 0;
+    g_engine.next_queued = false;
+}
+
+// Closes the outgoing track and returns its buffers to the gapless slot
+static void engine_end_fade() {
+    if (!g_engine.fade_frames) return;
+    engine_close_voice(&g_engine.outgoing);
+    std::swap(g_engine.outgoing.state, g_engine.next.state);
+    std::swap(g_engine.outgoing.head, g_engine.next.head);
+    g_engine.fade_frames = 0;
+    g_engine.fade_pos = 0;
+}
+
+// Moves the current track to the outgoing voice, to fade out over frames
+// output frames. The current voice is left closed and without a decoder state
+// or head; the caller gives it the gapless slot's.
+static void engine_fade_out_current(uint32_t frames) {
+    engine_end_fade();
+    std::swap(g_engine.voice, g_engine.outgoing);
+    g_engine.fade_frames = frames;
+    g_engine.fade_pos = 0;
+    g_engine.stats.crossfades++;
+}
+
+// Output frames in a crossfade of the configured length, 0 when crossfading is off
+static uint32_t engine_crossfade_frames() {
+    return (uint32_t)((uint64_t)g_engine.crossfade_ms.load(std::memory_order_relaxed) * g_engine.output_rate / 1000);
+}
+
+static hal_audio_error_t engine_open_error(const audio_source_t* source) {
+    return source->kind == AUDIO_SOURCE_FILE && !hal_storage_file_exists(source->path)
+         ? HAL_AUDIO_ERROR_FILE_NOT_FOUND : HAL_AUDIO_ERROR_DECODE_FAILED;
+}
+
+// Stamps the output frame being rendered now with the current track at
+// track_frame, or with silence when playing is false. A held mark stays at
+// track_frame: the synth can go on rendering while the track is paused.
+static void engine_write_mark(uint32_t track_frame, bool playing, bool held) {
+    uint32_t index = g_engine.marks_written.load(std::memory_order_relaxed);
+    engine_mark_slot_t* slot = &g_engine.marks[index % AUDIO_ENGINE_CLOCK_MARKS];
+    uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->out_frame.store(g_engine.frames_rendered.load(std::memory_order_relaxed) + g_engine.render_pos,
+                          std::memory_order_relaxed);
+    slot->track_frame.store(track_frame, std::memory_order_relaxed);
+    slot->sample_rate.store(playing ? g_engine.voice.info.sample_rate : 0, std::memory_order_relaxed);
+    slot->duration_ms.store(playing ? g_engine.duration_ms.load(std::memory_order_relaxed) : 0,
+                            std::memory_order_relaxed);
+    slot->held.store(held, std::memory_order_relaxed);
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    g_engine.marks_written.store(index + 1, std::memory_order_release);
+}
+
+static void engine_mark(uint32_t track_frame, bool playing) {
+    engine_write_mark(track_frame, playing, false);
+}
+
+// Holds the track where the output being rendered now has it (pause), or lets
+// it run on from there (resume)
+static void engine_hold_mark(bool held) {
+    uint32_t written = g_engine.marks_written.load(std::memory_order_relaxed);
+    if (written == 0) return;
+    const engine_mark_slot_t* slot = &g_engine.marks[(written - 1) % AUDIO_ENGINE_CLOCK_MARKS];
+    uint32_t sample_rate = slot->sample_rate.load(std::memory_order_relaxed);
+    if (sample_rate == 0 || slot->held.load(std::memory_order_relaxed) == held) return;
+    uint32_t track_frame = slot->track_frame.load(std::memory_order_relaxed);
+    if (!slot->held.load(std::memory_order_relaxed)) {
+        uint32_t out_frame = g_engine.frames_rendered.load(std::memory_order_relaxed) + g_engine.render_pos;
+        track_frame += (uint32_t)((uint64_t)(out_frame - slot->out_frame.load(std::memory_order_relaxed)) *
+                                  sample_rate / g_engine.output_rate);
+    }
+    engine_write_mark(track_frame, true, held);
+}
+
+// Output frames the listener has heard: the DAC's count in task mode, the
+// caller's reads in pull mode
+static uint32_t engine_frames_played() {
+    uint32_t rendered = g_engine.frames_rendered.load(std::memory_order_acquire);
+    if (!g_engine.task_mode) return rendered;
+    uint32_t played = hal_audio_get_frames_played() - g_engine.clock_offset.load(std::memory_order_acquire);
+    // Another writer on the HAL ring puts the counts out of step until the next block
+    return (int32_t)(rendered - played) < 0 ? rendered : played;
+}
+
+// Latest mark the listener has reached; false before the first
+static bool engine_find_mark(uint32_t played, engine_mark_t* mark) {
+    uint32_t written = g_engine.marks_written.load(std::memory_order_acquire);
+    uint32_t count = written < AUDIO_ENGINE_CLOCK_MARKS ? written : AUDIO_ENGINE_CLOCK_MARKS;
+    for (uint32_t i = 1; i <= count; i++) {
+        const engine_mark_slot_t* slot = &g_engine.marks[(written - i) % AUDIO_ENGINE_CLOCK_MARKS];
+        uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        mark->out_frame = slot->out_frame.load(std::memory_order_relaxed);
+        mark->track_frame = slot->track_frame.load(std::memory_order_relaxed);
+        mark->sample_rate = slot->sample_rate.load(std::memory_order_relaxed);
+        mark->duration_ms = slot->duration_ms.load(std::memory_order_relaxed);
+        mark->held = slot->held.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Only the oldest slot is ever reused, and anything older has been heard
+        if ((sequence & 1) || slot->sequence.load(std::memory_order_relaxed) != sequence) continue;
+        if ((int32_t)(played - mark->out_frame) >= 0) return true;
+    }
+    return false;
+}
+
+// Position and duration of the frame being heard, from a single mark
+static void engine_read_clock(uint32_t* position_ms, uint32_t* duration_ms) {
+    uint32_t played = engine_frames_played();
+    engine_mark_t mark;
+    *position_ms = 0;
+    *duration_ms = g_engine.duration_ms.load(std::memory_order_relaxed);
+    if (!engine_find_mark(played, &mark) || mark.sample_rate == 0) return;
+
+    uint64_t frame = mark.track_frame;
+    if (!mark.held) frame += (uint64_t)(played - mark.out_frame) * mark.sample_rate / g_engine.output_rate;
+    uint64_t ms = frame * 1000 / mark.sample_rate;
+    *duration_ms = mark.duration_ms;
+    *position_ms = mark.duration_ms && ms > mark.duration_ms ? mark.duration_ms : (uint32_t)ms;
+}
+
+// Publishes the properties of the track that just became current
+static void engine_publish_track() {
+    const engine_voice_t* voice = &g_engine.voice;
+    g_engine.source_kind = voice->source.kind;
+    g_engine.decoder_name = voice->decoder->name;
+    g_engine.sample_rate = voice->info.sample_rate;
+    g_engine.position_frames = 0;
+    g_engine.duration_ms = voice->info.total_frames
+                         ? (uint32_t)(voice->info.total_frames * 1000ull / voice->info.sample_rate)
+                         : 0;
+    engine_mark(0, true);
+    g_engine.stats.tracks_opened++;
+}
+
+static void engine_set_state(hal_audio_state_t state) {
+    hal_audio_state_t previous = (hal_audio_state_t)g_engine.state.exchange(state, std::memory_order_acq_rel);
+    // Meters fall to zero once nothing is playing
+    bool idle = state == HAL_AUDIO_STATE_STOPPED || state == HAL_AUDIO_STATE_ERROR;
+    if (idle && previous != state) audio_analyzer_clear(&g_engine.analyzer);
+}
+
+// Drops queued output so a new source or position is heard immediately
+static void engine_discard_output() {
+    if (g_engine.task_mode) hal_audio_flush_buffer();
+}
+
+// Points a voice's resampler at a new source rate. A continuous join (gapless
+// splice at the same rate) keeps the filter history, so it is as smooth as mid-track.
+static bool engine_configure_resampler(engine_voice_t* voice, uint32_t source_rate, bool continuous) {
+    voice->staging_frames = 0;
+    voice->staging_pos = 0;
+    if (continuous && !voice->draining && voice->resampler.in_rate == source_rate) return true;
+    voice->draining = false;
+    return audio_resampler_init(&voice->resampler, source_rate, g_engine.output_rate,
+                                g_engine.resampler_quality);
+}
+
+// Opens a source as the current track. With fade_frames the playing track
+// fades out under it instead of stopping; the queued output is kept, so the
+// fade starts where the listener is.
+static bool engine_open(const audio_source_t* source, uint32_t fade_frames) {
+    if (fade_frames) {
+        engine_fade_out_current(fade_frames);
+        std::swap(g_engine.voice.state, g_engine.next.state);
+        std::swap(g_engine.voice.head, g_engine.next.head);
+    } else {
+        engine_close_decoder();
+        engine_end_fade();
+        engine_discard_output();
+    }
+    g_engine.position_frames = 0;
+    g_engine.duration_ms = 0;
+
+    engine_voice_t* voice = &g_engine.voice;
+    const audio_decoder_ops_t* decoder = audio_decoder_find(source);
+    bool opened = decoder && decoder->state_size <= g_engine.decoder_state_size;
+    if (!opened) {
+        g_engine.last_error = HAL_AUDIO_ERROR_INVALID_FORMAT;
+    } else {
+        memset(voice->state, 0, decoder->state_size);
+        memset(&voice->info, 0, sizeof(voice->info));
+        opened = decoder->open(voice->state, source, &voice->info) && voice->info.sample_rate != 0;
+        if (!opened) {
+            g_engine.last_error = engine_open_error(source);
+        } else if (!engine_configure_resampler(voice, voice->info.sample_rate, false)) {
+            decoder->close(voice->state);
+            g_engine.last_error = HAL_AUDIO_ERROR_INIT_FAILED;
+            opened = false;
+        }
+    }
+    if (!opened) {
+        engine_end_fade();
+        engine_mark(0, false);
+        g_engine.stats.open_failures++;
+        return false;
+    }
+
+    voice->decoder = decoder;
+    voice->source = *source;
+    engine_lookup_loudness(source, &voice->loudness);
+    engine_update_replay_gain(voice);
+    engine_publish_track();
+
+    g_engine.last_error = HAL_AUDIO_ERROR_NONE;
+    return true;
+}
+
+// Opens the queued track and decodes its first block, so the splice itself
+// does no I/O. Waits while a fade has the slot's buffers.
+static void engine_prefetch_next() {
+    if (!g_engine.next.pending || g_engine.next.decoder || g_engine.fade_frames) return;
+
+    const audio_source_t* source = &g_engine.next.source;
+    const audio_decoder_ops_t* decoder = audio_decoder_find(source);
+    memset(&g_engine.next.info, 0, sizeof(g_engine.next.info));
+    bool opened = decoder && decoder->state_size <= g_engine.decoder_state_size;
+    if (opened) {
+        memset(g_engine.next.state, 0, decoder->state_size);
+        opened = decoder->open(g_engine.next.state, source, &g_engine.next.info) &&
+                 g_engine.next.info.sample_rate != 0;
+    }
+    if (!opened) {
+        g_engine.last_error = decoder ? engine_open_error(source) : HAL_AUDIO_ERROR_INVALID_FORMAT;
+        g_engine.stats.open_failures++;
+        engine_clear_next();
+        return;
+    }
+
+    g_engine.next.decoder = decoder;
+    g_engine.next.head_frames = decoder->decode(g_engine.next.state, g_engine.next.head, g_engine.block_frames);
+    engine_lookup_loudness(source, &g_engine.next.loudness);
+}
+
+// Makes the prefetched track current. A gapless splice starts it at the sample
+// where the previous one ended; with fade_frames the current track is still
+// playing and fades out under it.
+static bool engine_splice_next(uint32_t fade_frames) {
+    if (!g_engine.next.pending) return false;
+    engine_end_fade();
+    engine_prefetch_next();
+    if (!g_engine.next.decoder) return false;
+    // A fade starts the new track on the idle voice's filter
+    engine_voice_t* target = fade_frames ? &g_engine.outgoing : &g_engine.voice;
+    if (!engine_configure_resampler(target, g_engine.next.info.sample_rate, !fade_frames)) {
+        g_engine.last_error = HAL_AUDIO_ERROR_INIT_FAILED;
+        engine_clear_next();
+        return false;
+    }
+
+    if (fade_frames) {
+        engine_fade_out_current(fade_frames);
+    } else {
+        engine_close_voice(&g_engine.voice);
+    }
+    engine_voice_t* voice = &g_engine.voice;
+    std::swap(voice->state, g_engine.next.state);
+    std::swap(voice->head, g_engine.next.head);
+    voice->head_frames = g_engine.next.head_frames;
+    voice->head_pos = 0;
+    voice->decoder = g_engine.next.decoder;
+    voice->source = g_engine.next.source;
+    voice->info = g_engine.next.info;
+    voice->loudness = g_engine.next.loudness;
+    engine_update_replay_gain(voice);
+    g_engine.next.decoder = nullptr;
+    engine_clear_next();
+
+    engine_publish_track();
+    if (!fade_frames) g_engine.stats.gapless_splices++;
+    if (g_engine.track_callback) g_engine.track_callback(g_engine.track_user_data);
+    return true;
+}
+
+// Starts fading into the queued track once the current one is within the
+// crossfade length of its end. Tracks of unknown length splice gaplessly.
+static void engine_fade_into_next() {
+    const engine_voice_t* voice = &g_engine.voice;
+    uint32_t crossfade_ms = g_engine.crossfade_ms.load(std::memory_order_relaxed);
+    if (crossfade_ms == 0 || g_engine.fade_frames || !g_engine.next.pending || g_engine.loop.load() ||
+        !voice->decoder || voice->info.total_frames == 0) {
+        return;
+    }
+    uint64_t position = g_engine.position_frames;
+    if (position >= voice->info.total_frames) return;
+    uint64_t remaining = voice->info.total_frames - position;
+    if (remaining * 1000 > (uint64_t)crossfade_ms * voice->info.sample_rate) return;
+    uint32_t frames = (uint32_t)(remaining * g_engine.output_rate / voice->info.sample_rate);
+    if (frames > 0) engine_splice_next(frames);
+}
+
+// Source frames: the prefetched head first, then the decoder
+static uint32_t engine_decode(engine_voice_t* voice, int16_t* out, uint32_t max_frames) {
+    uint32_t n;
+    if (voice->head_pos < voice->head_frames) {
+        n = voice->head_frames - voice->head_pos;
+        if (n > max_frames) n = max_frames;
+        memcpy(out, voice->head + (size_t)voice->head_pos * HAL_AUDIO_CHANNELS,
+               (size_t)n * HAL_AUDIO_CHANNELS * sizeof(int16_t));
+        voice->head_pos += n;
+    } else {
+        n = voice->decoder->decode(voice->state, out, max_frames);
+    }
+    if (voice == &g_engine.voice) g_engine.position_frames += n;
+    return n;
+}
+
+// Whether the frames after this track follow on at the same rate (loop or a matching splice)
+static bool engine_continues_at_same_rate() {
+    if (g_engine.loop.load()) return true;
+    engine_prefetch_next();
+    return g_engine.next.decoder && g_engine.next.info.sample_rate == g_engine.voice.info.sample_rate;
+}
+
+// Output-rate frames through the resampler. Returns 0 once the source has
+// ended and, unless the next frames continue at this rate, the tail is out.
+static uint32_t engine_resample(engine_voice_t* voice, int16_t* out, uint32_t max_frames) {
+    uint32_t produced = 0;
+    while (produced < max_frames) {
+        int16_t* dst = out + (size_t)produced * HAL_AUDIO_CHANNELS;
+        if (voice->draining) {
+            uint32_t n = audio_resampler_drain(&voice->resampler, dst, max_frames - produced);
+            if (n == 0) break;
+            produced += n;
+            continue;
+        }
+        if (voice->staging_pos == voice->staging_frames) {
+            voice->staging_pos = 0;
+            voice->staging_frames = engine_decode(voice, voice->staging, g_engine.block_frames);
+            if (voice->staging_frames == 0) {
+                if (voice == &g_engine.voice && engine_continues_at_same_rate()) break;
+                voice->draining = true;
+                continue;
+            }
+        }
+        uint32_t consumed = 0;
+        produced += audio_resampler_process(&voice->resampler,
+                                            voice->staging + (size_t)voice->staging_pos * HAL_AUDIO_CHANNELS,
+                                            voice->staging_frames - voice->staging_pos, &consumed,
+                                            dst, max_frames - produced);
+        voice->staging_pos += consumed;
+    }
+    return produced;
+}
+
+static uint32_t engine_voice_render(engine_voice_t* voice, int16_t* out, uint32_t max_frames) {
+    return voice->resampler.passthrough ? engine_decode(voice, out, max_frames)
+                                        : engine_resample(voice, out, max_frames);
+}
+
+// Part of base_q15 that brings a voice to its own gain (unity or less)
+static int32_t engine_gain_ratio(int32_t gain_q15, int32_t base_q15) {
+    return base_q15 > 0 ? (int32_t)((int64_t)gain_q15 * AUDIO_DSP_Q15_ONE / base_q15) : AUDIO_DSP_Q15_ONE;
+}
+
+// Mixes the outgoing voice into the first frames of out along the fade curve.
+// A track that ends before its fade does is faded against silence. The two
+// tracks' ReplayGains differ, so the quieter one is scaled down to match the
+// louder and that one's gain is returned for the output multiplier.
+static int32_t engine_mix_outgoing(int16_t* out, uint32_t frames) {
+    int32_t incoming_q15 = g_engine.voice.replay_gain_q15;
+    int32_t outgoing_q15 = g_engine.outgoing.replay_gain_q15;
+    int32_t base_q15 = incoming_q15 > outgoing_q15 ? incoming_q15 : outgoing_q15;
+    audio_dsp_gain_q15(out, (size_t)frames * HAL_AUDIO_CHANNELS, engine_gain_ratio(incoming_q15, base_q15));
+    outgoing_q15 = engine_gain_ratio(outgoing_q15, base_q15);
+
+    while (frames > 0 && g_engine.fade_frames) {
+        uint32_t n = g_engine.fade_frames - g_engine.fade_pos;
+        if (n > frames) n = frames;
+        if (n > g_engine.block_frames) n = g_engine.block_frames;
+        uint32_t got = 0;
+        while (got < n && g_engine.outgoing.decoder) {
+            uint32_t m = engine_voice_render(&g_engine.outgoing, g_engine.mix + (size_t)got * HAL_AUDIO_CHANNELS,
+                                             n - got);
+            if (m == 0) engine_close_voice(&g_engine.outgoing);
+            got += m;
+        }
+        memset(g_engine.mix + (size_t)got * HAL_AUDIO_CHANNELS, 0,
+               (size_t)(n - got) * HAL_AUDIO_CHANNELS * sizeof(int16_t));
+        audio_dsp_gain_q15(g_engine.mix, (size_t)n * HAL_AUDIO_CHANNELS, outgoing_q15);
+        audio_dsp_crossfade(out, g_engine.mix, n, g_engine.fade_pos, g_engine.fade_frames);
+
+        g_engine.fade_pos += n;
+        if (g_engine.fade_pos == g_engine.fade_frames) engine_end_fade();
+        out += (size_t)n * HAL_AUDIO_CHANNELS;
+        frames -= n;
+    }
+    return base_q15;
+}
+
+static void engine_stop() {
+    engine_clear_next();
+    engine_close_decoder();
+    engine_end_fade();
+    engine_discard_output();
+    g_engine.position_frames = 0;
+    engine_mark(0, false);
+    engine_set_state(HAL_AUDIO_STATE_STOPPED);
+}
+
+static void engine_execute(const engine_cmd_t* cmd) {
+    g_engine.stats.commands_executed++;
+    hal_audio_state_t state = (hal_audio_state_t)g_engine.state.load();
+
+    switch (cmd->type) {
+        case ENGINE_CMD_PLAY: {
+            engine_clear_next();
+            // Only a track that is audible now fades out
+            uint32_t fade_frames = state == HAL_AUDIO_STATE_PLAYING && g_engine.voice.decoder
+                                 ? engine_crossfade_frames() : 0;
+            engine_set_state(engine_open(&cmd->source, fade_frames) ? HAL_AUDIO_STATE_PLAYING
+                                                                    : HAL_AUDIO_STATE_ERROR);
+            break;
+        }
+        case ENGINE_CMD_STOP:
+            engine_stop();
+            break;
+        case ENGINE_CMD_PAUSE:
+            if (state == HAL_AUDIO_STATE_PLAYING) {
+                engine_set_state(HAL_AUDIO_STATE_PAUSED);
+                engine_hold_mark(true);
+                if (g_engine.task_mode && !audio_synth_is_active(&g_engine.synth)) hal_audio_end_stream();
+            }
+            break;
+        case ENGINE_CMD_RESUME:
+            if (state == HAL_AUDIO_STATE_PAUSED) {
+                engine_set_state(HAL_AUDIO_STATE_PLAYING);
+                engine_hold_mark(false);
+            }
+            break;
+        case ENGINE_CMD_SEEK: {
+            engine_voice_t* voice = &g_engine.voice;
+            if (voice->decoder && voice->decoder->seek) {
+                uint64_t frame = (uint64_t)cmd->position_ms * voice->info.sample_rate / 1000;
+                if (voice->info.total_frames && frame > voice->info.total_frames) {
+                    frame = voice->info.total_frames;
+                }
+                if (voice->decoder->seek(voice->state, frame)) {
+                    voice->head_frames = 0;
+                    voice->head_pos = 0;
+                    voice->staging_frames = 0;
+                    voice->staging_pos = 0;
+                    voice->draining = false;
+                    audio_resampler_reset(&voice->resampler);
+                    engine_discard_output();
+                    g_engine.position_frames = (uint32_t)frame;
+                    engine_write_mark((uint32_t)frame, true, state == HAL_AUDIO_STATE_PAUSED);
+                }
+            }
+            break;
+        }
+        case ENGINE_CMD_QUEUE_NEXT:
+            engine_clear_next();
+            g_engine.next.source = cmd->source;
+            g_engine.next.pending = true;
+            g_engine.next_queued = true;
+            break;
+        case ENGINE_CMD_CLEAR_NEXT:
+            engine_clear_next();
+            break;
+        case ENGINE_CMD_WAKE:
+            // The notes are picked up by the next render
+            g_engine.synth_wake = false;
+            break;
+        case ENGINE_CMD_QUIT:
+            engine_stop();
+            audio_synth_stop_all(&g_engine.synth);
+            g_engine.quit = true;
+            break;
+    }
+}
+
+static void engine_drain_commands() {
+    engine_cmd_t cmd;
+    while (hal_system_queue_receive(g_engine.commands, &cmd, 0)) {
+        engine_execute(&cmd);
+    }
+}
+
+// End of the current source: loop it, splice in the queued track, or stop and notify
+static bool engine_handle_end_of_track() {
+    engine_voice_t* voice = &g_engine.voice;
+    if (g_engine.loop.load() && voice->decoder) {
+        bool rewound = voice->decoder->seek
+                     ? voice->decoder->seek(voice->state, 0)
+                     : false;
+        if (!rewound) {
+            audio_source_t source = voice->source;
+            voice->decoder->close(voice->state);
+            voice->decoder = nullptr;
+            memset(voice->state, 0, g_engine.decoder_state_size);
+            const audio_decoder_ops_t* decoder = audio_decoder_find(&source);
+            rewound = decoder && decoder->open(voice->state, &source, &voice->info);
+            if (rewound) voice->decoder = decoder;
+        }
+        if (rewound) {
+            voice->head_frames = 0;
+            voice->head_pos = 0;
+            g_engine.position_frames = 0;
+            engine_mark(0, true);
+            return true;
+        }
+    }
+    if (engine_splice_next(0)) return true;
+
+    engine_close_decoder();
+    engine_end_fade();
+    g_engine.position_frames = 0;
+    // The tail is still queued: the position runs on until it has played
+    engine_mark(0, false);
+    engine_set_state(HAL_AUDIO_STATE_STOPPED);
+    if (g_engine.end_callback) g_engine.end_callback(g_engine.end_user_data);
+    return false;
+}
+
+// Renders from the current decoder, mixing in a fading track, then the synth
+// over it; stops early at end of track unless a synth voice is sounding
+static uint32_t engine_render_frames(int16_t* out, uint32_t frames) {
+    uint32_t serial = g_engine.replay_gain_serial.load(std::memory_order_acquire);
+    if (serial != g_engine.replay_gain_applied) {
+        g_engine.replay_gain_applied = serial;
+        engine_update_replay_gain(&g_engine.voice);
+        engine_update_replay_gain(&g_engine.outgoing);
+    }
+    engine_fade_into_next();
+    uint32_t produced = 0;
+    while (produced < frames && g_engine.state.load() == HAL_AUDIO_STATE_PLAYING && g_engine.voice.decoder) {
+        int16_t* dst = out + (size_t)produced * HAL_AUDIO_CHANNELS;
+        uint32_t n = engine_voice_render(&g_engine.voice, dst, frames - produced);
+        if (n == 0) {
+            g_engine.render_pos = produced;     // Where a splice or the end is marked
+            if (!engine_handle_end_of_track()) break;
+            continue;
+        }
+        produced += n;
+    }
+    g_engine.render_pos = 0;
+
+    int32_t gain_q15 = g_engine.gain_q15.load(std::memory_order_relaxed);
+    if (produced > 0) {
+        int32_t replay_gain_q15 = g_engine.fade_frames ? engine_mix_outgoing(out, produced)
+                                                       : g_engine.voice.replay_gain_q15;
+        // ReplayGain rides on the volume multiplier: still one pass over the block
+        audio_dsp_gain_q15(out, produced * HAL_AUDIO_CHANNELS, audio_dsp_gain_multiply(gain_q15, replay_gain_q15));
+        // After the volume, so boosts at low volume have headroom
+        audio_eq_process(&g_engine.eq, out, produced);
+    }
+    // UI sounds follow the volume but not the track's gain or the EQ; a note
+    // sounding past the end of the music fills the block out with silence
+    uint32_t rendered = produced;
+    if (audio_synth_is_active(&g_engine.synth)) {
+        memset(out + (size_t)produced * HAL_AUDIO_CHANNELS, 0,
+               (size_t)(frames - produced) * HAL_AUDIO_CHANNELS * sizeof(int16_t));
+        rendered = frames;
+        audio_synth_render(&g_engine.synth, out, frames, gain_q15);
+    }
+    if (rendered > 0) {
+        audio_analyzer_feed(&g_engine.analyzer, out, rendered);
+        if (g_engine.data_callback) {
+            g_engine.data_callback(out, rendered * HAL_AUDIO_CHANNELS, g_engine.data_user_data);
+        }
+        g_engine.stats.blocks_rendered++;
+    }
+    g_engine.frames_rendered.fetch_add(rendered, std::memory_order_release);
+    return rendered;
+}
+
+// Whether the task has anything to write: a playing track or a synth note
+static bool engine_has_output() {
+    return g_engine.state.load() == HAL_AUDIO_STATE_PLAYING || audio_synth_is_active(&g_engine.synth);
+}
+
+static void engine_task(void* parameters) {
+    (void)parameters;
+    const uint32_t block_samples = g_engine.block_frames * HAL_AUDIO_CHANNELS;
+
+    while (!g_engine.quit) {
+        engine_cmd_t cmd;
+        if (!engine_has_output()) {
+            // Nothing to render: sleep on the queue instead of polling
+            if (hal_system_queue_receive(g_engine.commands, &cmd, UINT32_MAX)) engine_execute(&cmd);
+            continue;
+        }
+
+        engine_drain_commands();
+        if (!engine_has_output()) continue;
+
+        // Bounded wait so transport commands are picked up while the ring is full
+        if (!hal_audio_wait_for_space(block_samples, 50)) continue;
+
+        // Maps the DAC's clock onto frames_rendered; this task is the ring's only writer
+        g_engine.clock_offset.store(hal_audio_get_frames_written() - g_engine.frames_rendered.load(),
+                                    std::memory_order_release);
+        uint32_t frames = engine_render_frames(g_engine.block, g_engine.block_frames);
+        if (frames > 0) {
+            hal_audio_write_samples(g_engine.block, frames * HAL_AUDIO_CHANNELS);
+        }
+        // Ended inside this block: close the stream only once its tail is queued,
+        // or the write above would reopen it and the drain would count underruns
+        if (!engine_has_output()) hal_audio_end_stream();
+        // The ring now holds a full buffer of lead time to open the next track in
+        engine_prefetch_next();
+    }
+
+    hal_system_give_semaphore(g_engine.task_done);
+    hal_system_delete_task(nullptr);
+}
+
+static bool engine_post(const engine_cmd_t* cmd) {
+    if (!g_engine.initialized) return false;
+    return hal_system_queue_send(g_engine.commands, cmd, 100);
+}
+
+static void engine_post_simple(engine_cmd_type_t type) {
+    engine_cmd_t cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = type;
+    engine_post(&cmd);
+}
+
+static bool engine_post_source(engine_cmd_type_t type, const audio_source_t* source) {
+    if (!source) return false;
+    // Reject what can be checked up front so callers get an immediate answer
+    if (!audio_decoder_find(source)) {
+        g_engine.last_error = HAL_AUDIO_ERROR_INVALID_FORMAT;
+        return false;
+    }
+    if (source->kind == AUDIO_SOURCE_FILE && !hal_storage_file_exists(source->path)) {
+        g_engine.last_error = HAL_AUDIO_ERROR_FILE_NOT_FOUND;
+        return false;
+    }
+
+    engine_cmd_t cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = type;
+    cmd.source = *source;
+    return engine_post(&cmd);
+}
+
+extern "C" {
+
+// Lifecycle
+bool audio_engine_init(const audio_engine_config_t* config) {
+    if (g_engine.initialized) return true;
+
+    g_engine.task_mode = config ? config->start_task : true;
+    g_engine.block_frames = (config && config->block_frames) ? config->block_frames : AUDIO_ENGINE_BLOCK_FRAMES;
+    g_engine.output_rate = (config && config->output_rate) ? config->output_rate : AUDIO_SAMPLE_RATE;
+    g_engine.resampler_quality = config ? config->resampler_quality : AUDIO_RESAMPLER_QUALITY_DEFAULT;
+    if (g_engine.task_mode && !hal_audio_is_initialized()) return false;
+    // The DAC clock is set once; every source is converted to it
+    if (g_engine.task_mode && hal_audio_get_sample_rate() != g_engine.output_rate &&
+        !hal_audio_set_sample_rate(g_engine.output_rate)) {
+        return false;
+    }
+
+    g_engine.decoder_state_size = audio_decoder_max_state_size();
+    const size_t block_bytes = g_engine.block_frames * HAL_AUDIO_CHANNELS * sizeof(int16_t);
+    g_engine.voice.state = hal_system_malloc(g_engine.decoder_state_size);
+    g_engine.next.state = hal_system_malloc(g_engine.decoder_state_size);
+    g_engine.block = (int16_t*)hal_system_malloc(block_bytes);
+    g_engine.voice.head = (int16_t*)hal_system_malloc(block_bytes);
+    g_engine.next.head = (int16_t*)hal_system_malloc(block_bytes);
+    g_engine.voice.staging = (int16_t*)hal_system_malloc(block_bytes);
+    g_engine.outgoing.staging = (int16_t*)hal_system_malloc(block_bytes);
+    g_engine.mix = (int16_t*)hal_system_malloc(block_bytes);
+    g_engine.tags = (uint8_t*)hal_system_malloc_psram(AUDIO_LOUDNESS_TAG_READ_BYTES);
+    g_engine.commands = hal_system_create_queue(AUDIO_ENGINE_QUEUE_LENGTH, sizeof(engine_cmd_t));
+    g_engine.eq_lock = hal_system_create_mutex();
+    audio_readahead_config_t readahead_config = {};
+    readahead_config.chunk_bytes = config ? config->readahead_chunk_bytes : 0;
+    readahead_config.chunks = config ? config->readahead_chunks : 0;
+    readahead_config.start_task = g_engine.task_mode;
+    bool readahead_ok = audio_readahead_init(&readahead_config);
+    // Every standard rate's filter fits from the start, so no track change allocates
+    bool resampler_ok =
+        audio_resampler_reserve(&g_engine.voice.resampler, g_engine.output_rate, g_engine.resampler_quality) &&
+        audio_resampler_reserve(&g_engine.outgoing.resampler, g_engine.output_rate, g_engine.resampler_quality);
+    // Capture near 22 kHz: the bands then span 40 Hz to about 11 kHz at display resolution
+    uint32_t decimation = g_engine.output_rate >= 64000 ? 4 : (g_engine.output_rate >= 32000 ? 2 : 1);
+    bool analyzer_ok = audio_analyzer_init(&g_engine.analyzer, g_engine.output_rate,
+                                           config ? config->analyzer_fft_size : 0, decimation);
+    bool synth_ok = audio_synth_init(&g_engine.synth, g_engine.output_rate, config ? config->synth_voices : 0);
+    if (!g_engine.voice.state || !g_engine.next.state || !g_engine.block || !g_engine.voice.head ||
+        !g_engine.next.head || !g_engine.voice.staging || !g_engine.outgoing.staging || !g_engine.mix ||
+        !g_engine.tags || !g_engine.commands || !g_engine.eq_lock || !analyzer_ok || !synth_ok ||
+        !readahead_ok || !resampler_ok) {
+        audio_engine_deinit();
+        return false;
+    }
+
+    g_engine.voice.decoder = nullptr;
+    g_engine.voice.head_frames = 0;
+    g_engine.voice.head_pos = 0;
+    g_engine.voice.staging_frames = 0;
+    g_engine.voice.staging_pos = 0;
+    g_engine.voice.draining = false;
+    g_engine.outgoing.decoder = nullptr;
+    g_engine.fade_frames = 0;
+    g_engine.fade_pos = 0;
+    g_engine.next.decoder = nullptr;
+    g_engine.next.pending = false;
+    g_engine.next_queued = false;
+    g_engine.synth_wake = false;
+    g_engine.quit = false;
+    g_engine.state = HAL_AUDIO_STATE_STOPPED;
+    g_engine.source_kind = AUDIO_SOURCE_NONE;
+    g_engine.decoder_name = "";
+    g_engine.last_error = HAL_AUDIO_ERROR_NONE;
+    g_engine.sample_rate = g_engine.output_rate;
+    g_engine.position_frames = 0;
+    g_engine.duration_ms = 0;
+    g_engine.render_pos = 0;
+    g_engine.marks_written = 0;
+    g_engine.frames_rendered = 0;
+    g_engine.clock_offset = g_engine.task_mode ? hal_audio_get_frames_written() : 0;
+    g_engine.volume = HAL_AUDIO_DEFAULT_VOLUME;
+    g_engine.muted = false;
+    audio_engine_set_crossfade_ms(config ? config->crossfade_ms : 0);
+    audio_engine_set_replay_gain(config ? config->replay_gain : AUDIO_REPLAY_GAIN_OFF,
+                                 config ? config->replay_gain_preamp_db : 0.0f);
+    g_engine.replay_gain_applied = g_engine.replay_gain_serial.load();
+    g_engine.voice.replay_gain_q15 = AUDIO_DSP_Q15_ONE;
+    g_engine.outgoing.replay_gain_q15 = AUDIO_DSP_Q15_ONE;
+    engine_update_gain();
+    audio_eq_init(&g_engine.eq, g_engine.output_rate);
+    memset(&g_engine.stats, 0, sizeof(g_engine.stats));
+    g_engine.initialized = true;
+
+    if (g_engine.task_mode) {
+        g_engine.task_done = hal_system_create_semaphore(1, 0);
+        g_engine.task = hal_system_create_task(engine_task, "AudioEngine", AUDIO_ENGINE_TASK_STACK,
+                                               nullptr, HAL_TASK_PRIORITY_HIGH);
+        if (!g_engine.task) {
+            audio_engine_deinit();
+            return false;
+        }
+    }
+    return true;
+}
+
+void audio_engine_deinit(void) {
+    if (g_engine.task) {
+        engine_post_simple(ENGINE_CMD_QUIT);
+        hal_system_take_semaphore(g_engine.task_done, UINT32_MAX);
+        g_engine.task = nullptr;
+    } else if (g_engine.initialized) {
+        engine_stop();
+    }
+    if (g_engine.task_done) {
+        hal_system_delete_semaphore(g_engine.task_done);
+        g_engine.task_done = nullptr;
+    }
+    if (g_engine.commands) {
+        hal_system_delete_queue(g_engine.commands);
+        g_engine.commands = nullptr;
+    }
+    if (g_engine.eq_lock) {
+        hal_system_delete_mutex(g_engine.eq_lock);
+        g_engine.eq_lock = nullptr;
+    }
+    hal_system_free(g_engine.voice.state);
+    hal_system_free(g_engine.next.state);
+    hal_system_free(g_engine.block);
+    hal_system_free(g_engine.voice.head);
+    hal_system_free(g_engine.next.head);
+    hal_system_free(g_engine.voice.staging);
+    hal_system_free(g_engine.outgoing.staging);
+    hal_system_free(g_engine.mix);
+    hal_system_free(g_engine.tags);
+    audio_resampler_deinit(&g_engine.voice.resampler);
+    audio_resampler_deinit(&g_engine.outgoing.resampler);
+    audio_analyzer_deinit(&g_engine.analyzer);
+    audio_synth_deinit(&g_engine.synth);
+    // After engine_stop: the decoders have closed their streams
+    audio_readahead_deinit();
+    g_engine.voice.state = nullptr;
+    g_engine.next.state = nullptr;
+    g_engine.block = nullptr;
+    g_engine.voice.head = nullptr;
+    g_engine.next.head = nullptr;
+    g_engine.voice.staging = nullptr;
+    g_engine.outgoing.staging = nullptr;
+    g_engine.mix = nullptr;
+    g_engine.tags = nullptr;
+    g_engine.initialized = false;
+}
+
+bool audio_engine_is_initialized(void) {
+    return g_engine.initialized;
+}
+
+// Transport
+bool audio_engine_play(const audio_source_t* source) {
+    return engine_post_source(ENGINE_CMD_PLAY, source);
+}
+
+bool audio_engine_play_file(const char* path) {
+    if (!path) return false;
+    audio_source_t source;
+    audio_source_file(&source, path);
+    return audio_engine_play(&source);
+}
+
+bool audio_engine_play_tone(uint32_t tone_hz) {
+    audio_source_t source;
+    audio_source_tone(&source, tone_hz, AUDIO_SAMPLE_RATE);
+    return audio_engine_play(&source);
+}
+
+void audio_engine_stop(void) {
+    engine_post_simple(ENGINE_CMD_STOP);
+}
+
+void audio_engine_pause(void) {
+    engine_post_simple(ENGINE_CMD_PAUSE);
+}
+
+void audio_engine_resume(void) {
+    engine_post_simple(ENGINE_CMD_RESUME);
+}
+
+bool audio_engine_seek_ms(uint32_t position_ms) {
+    engine_cmd_t cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = ENGINE_CMD_SEEK;
+    cmd.position_ms = position_ms;
+    return engine_post(&cmd);
+}
+
+// Gapless queue
+bool audio_engine_queue_next(const audio_source_t* source) {
+    return engine_post_source(ENGINE_CMD_QUEUE_NEXT, source);
+}
+
+bool audio_engine_queue_next_file(const char* path) {
+    if (!path) return false;
+    audio_source_t source;
+    audio_source_file(&source, path);
+    return audio_engine_queue_next(&source);
+}
+
+void audio_engine_clear_next(void) {
+    engine_post_simple(ENGINE_CMD_CLEAR_NEXT);
+}
+
+bool audio_engine_has_next(void) {
+    return g_engine.next_queued.load();
+}
+
+// UI sounds
+bool audio_engine_play_notes(const audio_synth_note_t* notes, size_t count) {
+    if (!g_engine.initialized || !audio_synth_post(&g_engine.synth, notes, count)) return false;
+    // An idle task sleeps on the command queue; one wake at a time is enough
+    if (!g_engine.synth_wake.exchange(true)) engine_post_simple(ENGINE_CMD_WAKE);
+    return true;
+}
+
+bool audio_engine_beep(uint32_t frequency_hz, uint32_t duration_ms) {
+    audio_synth_note_t note;
+    audio_synth_note_beep(&note, frequency_hz, duration_ms);
+    return audio_engine_play_notes(&note, 1);
+}
+
+// State
+hal_audio_state_t audio_engine_get_state(void) {
+    return (hal_audio_state_t)g_engine.state.load(std::memory_order_acquire);
+}
+
+audio_source_kind_t audio_engine_get_source_kind(void) {
+    return (audio_source_kind_t)g_engine.source_kind.load();
+}
+
+const char* audio_engine_get_decoder_name(void) {
+    const char* name = g_engine.decoder_name.load();
+    return name ? name : "";
+}
+
+hal_audio_error_t audio_engine_get_last_error(void) {
+    return (hal_audio_error_t)g_engine.last_error.load();
+}
+
+uint32_t audio_engine_get_sample_rate(void) {
+    return g_engine.sample_rate.load();
+}
+
+uint32_t audio_engine_get_output_rate(void) {
+    return g_engine.output_rate;
+}
+
+// Playback clock
+uint32_t audio_engine_get_position_ms(void) {
+    uint32_t position_ms, duration_ms;
+    engine_read_clock(&position_ms, &duration_ms);
+    return position_ms;
+}
+
+uint32_t audio_engine_get_duration_ms(void) {
+    uint32_t position_ms, duration_ms;
+    engine_read_clock(&position_ms, &duration_ms);
+    return duration_ms;
+}
+
+float audio_engine_get_progress(void) {
+    uint32_t position_ms, duration_ms;
+    engine_read_clock(&position_ms, &duration_ms);
+    return duration_ms ? (float)position_ms / (float)duration_ms : 0.0f;
+}
+
+uint32_t audio_engine_get_frames_played(void) {
+    return engine_frames_played();
+}
+
+// Output parameters
+void audio_engine_set_volume(uint8_t volume) {
+    g_engine.volume = volume > HAL_AUDIO_MAX_VOLUME ? HAL_AUDIO_MAX_VOLUME : volume;
+    engine_update_gain();
+}
+
+uint8_t audio_engine_get_volume(void) {
+    return g_engine.volume.load();
+}
+
+void audio_engine_set_mute(bool muted) {
+    g_engine.muted = muted;
+    engine_update_gain();
+}
+
+bool audio_engine_is_muted(void) {
+    return g_engine.muted.load();
+}
+
+void audio_engine_set_loop(bool loop) {
+    g_engine.loop = loop;
+}
+
+bool audio_engine_get_loop(void) {
+    return g_engine.loop.load();
+}
+
+void audio_engine_set_crossfade_ms(uint32_t ms) {
+    g_engine.crossfade_ms = ms > AUDIO_ENGINE_MAX_CROSSFADE_MS ? AUDIO_ENGINE_MAX_CROSSFADE_MS : ms;
+}
+
+uint32_t audio_engine_get_crossfade_ms(void) {
+    return g_engine.crossfade_ms.load();
+}
+
+void audio_engine_set_replay_gain(audio_replay_gain_mode_t mode, float preamp_db) {
+    g_engine.replay_gain_mode = mode;
+    g_engine.replay_gain_preamp_db = preamp_db;
+    g_engine.replay_gain_serial.fetch_add(1, std::memory_order_release);
+}
+
+audio_replay_gain_mode_t audio_engine_get_replay_gain(void) {
+    return (audio_replay_gain_mode_t)g_engine.replay_gain_mode.load();
+}
+
+// Equalizer: the redesign runs here, on the caller's task
+void audio_engine_set_equalizer(const float* band_db, size_t band_count) {
+    if (!g_engine.initialized || !hal_system_take_mutex(g_engine.eq_lock, UINT32_MAX)) return;
+    audio_eq_set_bands(&g_engine.eq, band_db, band_count);
+    hal_system_give_mutex(g_engine.eq_lock);
+}
+
+void audio_engine_set_bass_boost(float db) {
+    if (!g_engine.initialized || !hal_system_take_mutex(g_engine.eq_lock, UINT32_MAX)) return;
+    audio_eq_set_bass(&g_engine.eq, db);
+    hal_system_give_mutex(g_engine.eq_lock);
+}
+
+void audio_engine_set_treble_boost(float db) {
+    if (!g_engine.initialized || !hal_system_take_mutex(g_engine.eq_lock, UINT32_MAX)) return;
+    audio_eq_set_treble(&g_engine.eq, db);
+    hal_system_give_mutex(g_engine.eq_lock);
+}
+
+// Metering
+bool audio_engine_get_analysis(audio_analyzer_frame_t* frame) {
+    if (!g_engine.initialized) return false;
+    return audio_analyzer_read(&g_engine.analyzer, frame);
+}
+
+void audio_engine_reset_effects(void) {
+    if (!g_engine.initialized || !hal_system_take_mutex(g_engine.eq_lock, UINT32_MAX)) return;
+    audio_eq_set_flat(&g_engine.eq);
+    hal_system_give_mutex(g_engine.eq_lock);
+}
+
+void audio_engine_set_end_callback(hal_audio_callback_t callback, void* user_data) {
+    g_engine.end_callback = callback;
+    g_engine.end_user_data = user_data;
+}
+
+void audio_engine_set_data_callback(hal_audio_data_callback_t callback, void* user_data) {
+    g_engine.data_callback = callback;
+    g_engine.data_user_data = user_data;
+}
+
+void audio_engine_set_track_callback(hal_audio_callback_t callback, void* user_data) {
+    g_engine.track_callback = callback;
+    g_engine.track_user_data = user_data;
+}
+
+// Pull interface
+uint32_t audio_engine_render(int16_t* out, uint32_t frames) {
+    if (!g_engine.initialized || !out) return 0;
+    engine_drain_commands();
+    engine_prefetch_next();
+    return engine_render_frames(out, frames);
+}
+
+void audio_engine_get_stats(audio_engine_stats_t* stats) {
+    if (stats) *stats = g_engine.stats;
+}
+
+} // extern "C"
@@ -0,0 +1,230 @@
+/*
+ * Audio Equalizer Implementation
+ * RBJ cookbook peaking and shelving biquads, run as a Q28 Direct Form I cascade
+ */
+
+#include "audio/audio_eq.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifdef PLATFORM_ESP32
+#include <esp_attr.h>
+#define EQ_HOT IRAM_ATTR
+#else
+#define EQ_HOT
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define EQ_CHUNK_FRAMES     64              // Work buffer size; keeps the stack small
+#define EQ_BAND_Q           1.41            // One octave bandwidth
+#define EQ_BYPASS_DB        0.05f
+#define EQ_STAGE_BASS       AUDIO_EQ_BANDS
+#define EQ_STAGE_TREBLE     (AUDIO_EQ_BANDS + 1)
+
+static const float k_band_hz[AUDIO_EQ_BANDS] = {
+    31.25f, 62.5f, 125.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f
+};
+
+static float eq_clamp_db(float db) {
+    if (!(db == db)) return 0.0f;   // NaN
+    if (db > AUDIO_EQ_MAX_GAIN_DB) return AUDIO_EQ_MAX_GAIN_DB;
+    return db < -AUDIO_EQ_MAX_GAIN_DB ? -AUDIO_EQ_MAX_GAIN_DB : db;
+}
+
+static int32_t eq_quantize(double c) {
+    return (int32_t)lrint(c * (double)(1 << AUDIO_EQ_COEF_SHIFT));
+}
+
+static void eq_store(audio_eq_biquad_t* q, double b0, double b1, double b2, double a0, double a1, double a2) {
+    q->b0 = eq_quantize(b0 / a0);
+    q->b1 = eq_quantize(b1 / a0);
+    q->b2 = eq_quantize(b2 / a0);
+    q->a1 = eq_quantize(a1 / a0);
+    q->a2 = eq_quantize(a2 / a0);
+}
+
+enum eq_shape { EQ_PEAK, EQ_LOW_SHELF, EQ_HIGH_SHELF };
+
+// Designed in double: at 31 Hz the poles sit within 1e-3 of the unit circle,
+// closer than float resolves once quantized to Q28
+
+static void eq_design(audio_eq_biquad_t* q, eq_shape shape, double hz, double db, double rate) {
+    const double A = pow(10.0, db / 40.0);
+    const double w0 = 2.0 * M_PI * hz / rate;
+    const double cw = cos(w0);
+    const double sw = sin(w0);
+
+    if (shape == EQ_PEAK) {
+        const double alpha = sw / (2.0 * EQ_BAND_Q);
+        eq_store(q, 1.0 + alpha * A, -2.0 * cw, 1.0 - alpha * A, 1.0 + alpha / A, -2.0 * cw, 1.0 - alpha / A);
+        return;
+    }
+
+    // Shelf slope S = 1
+    const double alpha = sw / 2.0 * sqrt(2.0);
+    const double two_sqrt_a_alpha = 2.0 * sqrt(A) * alpha;
+    if (shape == EQ_LOW_SHELF) {
+        eq_store(q,
+                 A * ((A + 1.0) - (A - 1.0) * cw + two_sqrt_a_alpha),
+                 2.0 * A * ((A - 1.0) - (A + 1.0) * cw),
+                 A * ((A + 1.0) - (A - 1.0) * cw - two_sqrt_a_alpha),
+                 (A + 1.0) + (A - 1.0) * cw + two_sqrt_a_alpha,
+                 -2.0 * ((A - 1.0) + (A + 1.0) * cw),
+                 (A + 1.0) + (A - 1.0) * cw - two_sqrt_a_alpha);
+    } else {
+        eq_store(q,
+                 A * ((A + 1.0) + (A - 1.0) * cw + two_sqrt_a_alpha),
+                 -2.0 * A * ((A - 1.0) + (A + 1.0) * cw),
+                 A * ((A + 1.0) + (A - 1.0) * cw - two_sqrt_a_alpha),
+                 (A + 1.0) - (A - 1.0) * cw + two_sqrt_a_alpha,
+                 2.0 * ((A - 1.0) - (A + 1.0) * cw),
+                 (A + 1.0) - (A - 1.0) * cw - two_sqrt_a_alpha);
+    }
+}
+
+// Rebuilds the back set from the control parameters and publishes it
+static void eq_publish(audio_eq_t* eq) {
+    audio_eq_coefs_t* set = &eq->sets[eq->back];
+    const double rate = (double)eq->sample_rate;
+    set->active_count = 0;
+
+    // Bass shelf first, then the bands low to high, then the treble shelf
+    if (fabsf(eq->bass_db) >= EQ_BYPASS_DB && AUDIO_EQ_BASS_HZ < 0.45 * rate) {
+        eq_design(&set->stage[EQ_STAGE_BASS], EQ_LOW_SHELF, AUDIO_EQ_BASS_HZ, eq->bass_db, rate);
+        set->active[set->active_count++] = EQ_STAGE_BASS;
+    }
+    for (uint8_t b = 0; b < AUDIO_EQ_BANDS; b++) {
+        // Bands too close to Nyquist for this rate are left out
+        if (fabsf(eq->band_db[b]) < EQ_BYPASS_DB || k_band_hz[b] >= 0.45 * rate) continue;
+        eq_design(&set->stage[b], EQ_PEAK, k_band_hz[b], eq->band_db[b], rate);
+        set->active[set->active_count++] = b;
+    }
+    if (fabsf(eq->treble_db) >= EQ_BYPASS_DB && AUDIO_EQ_TREBLE_HZ < 0.45 * rate) {
+        eq_design(&set->stage[EQ_STAGE_TREBLE], EQ_HIGH_SHELF, AUDIO_EQ_TREBLE_HZ, eq->treble_db, rate);
+        set->active[set->active_count++] = EQ_STAGE_TREBLE;
+    }
+
+    uint8_t old = eq->middle.exchange(eq->back | AUDIO_EQ_FRESH, std::memory_order_acq_rel);
+    eq->back = old & ~AUDIO_EQ_FRESH;
+}
+
+// Audio task: takes the newest published set, if any
+static const audio_eq_coefs_t* eq_acquire(audio_eq_t* eq) {
+    if (eq->middle.load(std::memory_order_relaxed) & AUDIO_EQ_FRESH) {
+        uint8_t fresh = eq->middle.exchange(eq->front, std::memory_order_acq_rel);
+        eq->front = fresh & ~AUDIO_EQ_FRESH;
+
+        // Stages switching on start from silence rather than stale history
+        bool now[AUDIO_EQ_STAGES] = {};
+        const audio_eq_coefs_t* set = &eq->sets[eq->front];
+        for (uint8_t i = 0; i < set->active_count; i++) now[set->active[i]] = true;
+        for (uint8_t s = 0; s < AUDIO_EQ_STAGES; s++) {
+            if (now[s] && !eq->running[s]) memset(eq->state[s], 0, sizeof(eq->state[s]));
+            eq->running[s] = now[s];
+        }
+    }
+    return &eq->sets[eq->front];
+}
+
+// One biquad over one channel of an interleaved chunk
+static EQ_HOT void eq_biquad(const audio_eq_biquad_t* c, audio_eq_state_t* st, int32_t* x, uint32_t frames) {
+    const int32_t b0 = c->b0, b1 = c->b1, b2 = c->b2, a1 = c->a1, a2 = c->a2;
+    int32_t x1 = st->x1, x2 = st->x2, y1 = st->y1, y2 = st->y2;
+    int64_t error = st->error;
+    for (uint32_t i = 0; i < frames; i++) {
+        const int32_t in = x[i * AUDIO_EQ_CHANNELS];
+        int64_t acc = (int64_t)b0 * in + (int64_t)b1 * x1 + (int64_t)b2 * x2
+                    - (int64_t)a1 * y1 - (int64_t)a2 * y2 + error;
+        const int32_t out = (int32_t)(acc >> AUDIO_EQ_COEF_SHIFT);
+        error = acc - (int64_t)out * ((int64_t)1 << AUDIO_EQ_COEF_SHIFT);
+        x2 = x1;
+        x1 = in;
+        y2 = y1;
+        y1 = out;
+        x[i * AUDIO_EQ_CHANNELS] = out;
+    }
+    st->x1 = x1;
+    st->x2 = x2;
+    st->y1 = y1;
+    st->y2 = y2;
+    st->error = (int32_t)error;
+}
+
+void audio_eq_init(audio_eq_t* eq, uint32_t sample_rate) {
+    memset(eq->sets, 0, sizeof(eq->sets));
+    memset(eq->state, 0, sizeof(eq->state));
+    memset(eq->running, 0, sizeof(eq->running));
+    memset(eq->band_db, 0, sizeof(eq->band_db));
+    eq->sample_rate = sample_rate;
+    eq->bass_db = 0.0f;
+    eq->treble_db = 0.0f;
+    eq->back = 0;
+    eq->middle.store(1, std::memory_order_relaxed);
+    eq->front = 2;
+}
+
+void audio_eq_reset_state(audio_eq_t* eq) {
+    memset(eq->state, 0, sizeof(eq->state));
+}
+
+void audio_eq_set_bands(audio_eq_t* eq, const float* band_db, size_t band_count) {
+    for (size_t b = 0; b < AUDIO_EQ_BANDS; b++) {
+        eq->band_db[b] = band_db && b < band_count ? eq_clamp_db(band_db[b]) : 0.0f;
+    }
+    eq_publish(eq);
+}
+
+void audio_eq_set_bass(audio_eq_t* eq, float db) {
+    eq->bass_db = eq_clamp_db(db);
+    eq_publish(eq);
+}
+
+void audio_eq_set_treble(audio_eq_t* eq, float db) {
+    eq->treble_db = eq_clamp_db(db);
+    eq_publish(eq);
+}
+
+void audio_eq_set_flat(audio_eq_t* eq) {
+    memset(eq->band_db, 0, sizeof(eq->band_db));
+    eq->bass_db = 0.0f;
+    eq->treble_db = 0.0f;
+    eq_publish(eq);
+}
+
+float audio_eq_band_hz(size_t band) {
+    return band < AUDIO_EQ_BANDS ? k_band_hz[band] : 0.0f;
+}
+
+EQ_HOT void audio_eq_process(audio_eq_t* eq, int16_t* samples, uint32_t frames) {
+    const audio_eq_coefs_t* set = eq_acquire(eq);
+    if (set->active_count == 0) return;
+
+    int32_t work[EQ_CHUNK_FRAMES * AUDIO_EQ_CHANNELS];
+    for (uint32_t done = 0; done < frames; ) {
+        uint32_t n = frames - done;
+        if (n > EQ_CHUNK_FRAMES) n = EQ_CHUNK_FRAMES;
+        int16_t* chunk = samples + (size_t)done * AUDIO_EQ_CHANNELS;
+
+        for (uint32_t i = 0; i < n * AUDIO_EQ_CHANNELS; i++) work[i] = chunk[i];
+        for (uint8_t i = 0; i < set->active_count; i++) {
+            const uint8_t s = set->active[i];
+            for (int ch = 0; ch < AUDIO_EQ_CHANNELS; ch++) {
+                eq_biquad(&set->stage[s], &eq->state[s][ch], work + ch, n);
+            }
+        }
+        for (uint32_t i = 0; i < n * AUDIO_EQ_CHANNELS; i++) {
+            int32_t v = work[i];
+            v = v < -32768 ? -32768 : v;
+            chunk[i] = (int16_t)(v > 32767 ? 32767 : v);
+        }
+        done += n;
+    }
+}
+
+bool audio_eq_is_flat(audio_eq_t* eq) {
+    return eq_acquire(eq)->active_count == 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Audio HAL Playback API
+ * Platform-independent hal_audio_* transport calls, routed to the audio engine
+ *
+ * The platform backends (hal_audio_esp32.cpp / hal_audio_host.cpp) only own
+ * the output ring and the DAC; everything about what is playing lives here.
+ */
+
+#include "hal/hal_audio.h"
+#include "audio/audio_engine.h"
+
+extern "C" {
+
+// Volume control
+void hal_audio_set_volume(uint8_t volume) {
+    audio_engine_set_volume(volume);
+}
+
+uint8_t hal_audio_get_volume(void) {
+    return audio_engine_get_volume();
+}
+
+void hal_audio_set_mute(bool muted) {
+    audio_engine_set_mute(muted);
+}
+
+bool hal_audio_is_muted(void) {
+    return audio_engine_is_muted();
+}
+
+// Playback control
+bool hal_audio_play_buffer(const void* buffer, size_t size, hal_audio_format_t format) {
+    audio_source_t source;
+    audio_source_memory(&source, buffer, size, format, AUDIO_SAMPLE_RATE);
+    return audio_engine_play(&source);
+}
+
+bool hal_audio_play_file(const char* filename) {
+    return audio_engine_play_file(filename);
+}
+
+bool hal_audio_play_stream(const char* url) {
+    (void)url;
+    return false;   // No network sources
+}
+
+void hal_audio_stop(void) {
+    audio_engine_stop();
+}
+
+void hal_audio_pause(void) {
+    audio_engine_pause();
+}
+
+void hal_audio_resume(void) {
+    audio_engine_resume();
+}
+
+// Playback state
+hal_audio_state_t hal_audio_get_state(void) {
+    return audio_engine_get_state();
+}
+
+bool hal_audio_is_playing(void) {
+    return audio_engine_get_state() == HAL_AUDIO_STATE_PLAYING;
+}
+
+bool hal_audio_is_paused(void) {
+    return audio_engine_get_state() == HAL_AUDIO_STATE_PAUSED;
+}
+
+// Position and timing
+uint32_t hal_audio_get_position_ms(void) {
+    return audio_engine_get_position_ms();
+}
+
+uint32_t hal_audio_get_duration_ms(void) {
+    return audio_engine_get_duration_ms();
+}
+
+bool hal_audio_seek_to_ms(uint32_t position_ms) {
+    return audio_engine_seek_ms(position_ms);
+}
+
+float hal_audio_get_progress(void) {
+    return audio_engine_get_progress();
+}
+
+// Loop control
+void hal_audio_set_loop(bool loop) {
+    audio_engine_set_loop(loop);
+}
+
+bool hal_audio_get_loop(void) {
+    return audio_engine_get_loop();
+}
+
+// Callback management
+void hal_audio_set_end_callback(hal_audio_callback_t callback, void* user_data) {
+    audio_engine_set_end_callback(callback, user_data);
+}
+
+void hal_audio_set_data_callback(hal_audio_data_callback_t callback, void* user_data) {
+    audio_engine_set_data_callback(callback, user_data);
+}
+
+void hal_audio_clear_callbacks(void) {
+    audio_engine_set_end_callback(nullptr, nullptr);
+    audio_engine_set_data_callback(nullptr, nullptr);
+}
+
+// Audio effects and processing
+void hal_audio_set_equalizer(const float* bands, size_t band_count) {
+    audio_engine_set_equalizer(bands, band_count);
+}
+
+void hal_audio_set_bass_boost(float boost) {
+    audio_engine_set_bass_boost(boost);
+}
+
+void hal_audio_set_treble_boost(float boost) {
+    audio_engine_set_treble_boost(boost);
+}
+
+void hal_audio_reset_effects(void) {
+    audio_engine_reset_effects();
+}
+
+// Audio analysis (published at display rate by the engine; these never block)
+float hal_audio_get_peak_level(void) {
+    audio_analyzer_frame_t frame;
+    return audio_engine_get_analysis(&frame) ? frame.peak : 0.0f;
+}
+
+float hal_audio_get_rms_level(void) {
+    audio_analyzer_frame_t frame;
+    return audio_engine_get_analysis(&frame) ? frame.rms : 0.0f;
+}
+
+void hal_audio_get_spectrum(float* spectrum, size_t bins) {
+    if (!spectrum || bins == 0) return;
+    audio_analyzer_frame_t frame;
+    if (!audio_engine_get_analysis(&frame)) {
+        for (size_t i = 0; i < bins; i++) spectrum[i] = 0.0f;
+        return;
+    }
+    // Regroup the log bands onto the requested count, keeping the loudest of each group
+    for (size_t i = 0; i < bins; i++) {
+        size_t lo = i * AUDIO_ANALYZER_BANDS / bins;
+        size_t hi = (i + 1) * AUDIO_ANALYZER_BANDS / bins;
+        if (hi <= lo) hi = lo + 1;
+        float level = 0.0f;
+        for (size_t b = lo; b < hi; b++) level = frame.bands[b] > level ? frame.bands[b] : level;
+        spectrum[i] = level;
+    }
+}
+
+} // extern "C"
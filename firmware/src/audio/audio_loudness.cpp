@@ -0,0 +1,817 @@
+/*
+ * Audio Loudness Implementation
+ * R128 meter, ReplayGain tag reader, per-track cache and the indexing job
+ */
+
+#include "audio/audio_loudness.h"
+#include "audio/audio_decoder.h"
+#include "audio/audio_dsp.h"
+#include "audio/audio_engine.h"
+#include "audio/audio_mp3_index.h"
+#include "hal/hal_system.h"
+
+#include <atomic>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define LND_CACHE_MAGIC     0x31444E4Cu     // "LND1"
+#define LND_TAG_MAX         256             // Longer tag frames and comments are not ReplayGain
+#define LND_MAX_BLOCKS      64              // FLAC metadata blocks walked before giving up
+#define JOB_PCM_FRAMES      1024
+
+#define LND_FLAG_TRACK      0x01
+#define LND_FLAG_ALBUM      0x02
+#define LND_FLAG_MEASURED   0x04
+
+// Cache record header; the non-empty span of the histogram follows
+typedef struct {
+    uint32_t magic;
+    uint32_t flags;
+    uint64_t file_bytes;
+    float track_gain_db;
+    float track_peak;
+    float album_gain_db;
+    float album_peak;
+    uint16_t histogram_first;
+    uint16_t histogram_count;
+    uint32_t reserved;
+} lnd_cache_header_t;
+
+// Meter
+
+// Loudness of a mean square energy summed over channels
+static float lnd_lufs(double energy) {
+    return -0.691f + 10.0f * (float)log10(energy);
+}
+
+// Energy at the centre of a histogram bin
+static double lnd_bin_energy(size_t bin) {
+    double lufs = AUDIO_LOUDNESS_FLOOR_LUFS + ((double)bin + 0.5) * 0.1;
+    return pow(10.0, (lufs + 0.691) / 10.0);
+}
+
+bool audio_loudness_meter_init(audio_loudness_meter_t* meter, uint32_t sample_rate, uint16_t channels) {
+    if (!meter || sample_rate < 8000) return false;
+    memset(meter, 0, sizeof(*meter));
+    meter->sample_rate = sample_rate;
+    meter->channels = channels == 1 ? 1 : 2;
+    meter->sub_frames = sample_rate / 10;
+
+    // BS.1770 K-weighting for any rate (the published coefficients are 48 kHz only)
+    const double pi = 3.14159265358979323846;
+    double k = tan(pi * 1681.974450955533 / sample_rate);
+    double q = 0.7071752369554196;
+    double vh = pow(10.0, 3.999843853973347 / 20.0);
+    double vb = pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    meter->pre[0] = (float)((vh + vb * k / q + k * k) / a0);
+    meter->pre[1] = (float)(2.0 * (k * k - vh) / a0);
+    meter->pre[2] = (float)((vh - vb * k / q + k * k) / a0);
+    meter->pre[3] = (float)(2.0 * (k * k - 1.0) / a0);
+    meter->pre[4] = (float)((1.0 - k / q + k * k) / a0);
+
+    k = tan(pi * 38.13547087602444 / sample_rate);
+    q = 0.5003270373238773;
+    a0 = 1.0 + k / q + k * k;
+    meter->rlb[0] = (float)(2.0 * (k * k - 1.0) / a0);
+    meter->rlb[1] = (float)((1.0 - k / q + k * k) / a0);
+    return true;
+}
+
+// Closes one 100 ms step; from the fourth on, each completes a 400 ms block
+static void lnd_end_sub_block(audio_loudness_meter_t* meter) {
+    meter->subs[meter->sub_count % 4] = meter->sub_energy;
+    meter->sub_count++;
+    meter->sub_energy = 0.0f;
+    meter->sub_pos = 0;
+    if (meter->sub_count < 4) return;
+
+    float sum = meter->subs[0] + meter->subs[1] + meter->subs[2] + meter->subs[3];
+    if (sum <= 0.0f) return;
+    float lufs = lnd_lufs((double)sum / (4.0 * meter->sub_frames));
+    if (lufs <= AUDIO_LOUDNESS_FLOOR_LUFS) return;
+    uint32_t bin = (uint32_t)((lufs - AUDIO_LOUDNESS_FLOOR_LUFS) * 10.0f);
+    if (bin >= AUDIO_LOUDNESS_HISTOGRAM_BINS) bin = AUDIO_LOUDNESS_HISTOGRAM_BINS - 1;
+    meter->histogram[bin]++;
+}
+
+void audio_loudness_meter_feed(audio_loudness_meter_t* meter, const int16_t* stereo, size_t frames) {
+    if (!meter || !stereo) return;
+    const float b0 = meter->pre[0], b1 = meter->pre[1], b2 = meter->pre[2];
+    const float a1 = meter->pre[3], a2 = meter->pre[4];
+    const float r1 = meter->rlb[0], r2 = meter->rlb[1];
+    const float scale = 1.0f / 32768.0f;
+
+    while (frames > 0) {
+        size_t n = meter->sub_frames - meter->sub_pos;
+        if (n > frames) n = frames;
+        float energy = 0.0f;
+        for (uint16_t c = 0; c < meter->channels; c++) {
+            float* z = meter->z[c];
+            float z0 = z[0], z1 = z[1], z2 = z[2], z3 = z[3];
+            uint32_t peak = meter->peak;
+            for (size_t i = 0; i < n; i++) {
+                int32_t s = stereo[i * 2 + c];
+                uint32_t mag = (uint32_t)(s < 0 ? -s : s);
+                if (mag > peak) peak = mag;
+                // Transposed direct form II: head shelf, then the RLB high-pass
+                float x = (float)s * scale;
+                float y = b0 * x + z0;
+                z0 = b1 * x - a1 * y + z1;
+                z1 = b2 * x - a2 * y;
+                float w = y + z2;
+                z2 = -2.0f * y - r1 * w + z3;
+                z3 = y - r2 * w;
+                energy += w * w;
+            }
+            z[0] = z0; z[1] = z1; z[2] = z2; z[3] = z3;
+            meter->peak = peak;
+        }
+        meter->sub_energy += energy;
+        meter->sub_pos += (uint32_t)n;
+        if (meter->sub_pos == meter->sub_frames) lnd_end_sub_block(meter);
+        stereo += n * 2;
+        frames -= n;
+    }
+}
+
+float audio_loudness_meter_integrated(const audio_loudness_meter_t* meter) {
+    if (!meter) return AUDIO_LOUDNESS_FLOOR_LUFS;
+    double energy = 0.0;
+    uint64_t blocks = 0;
+    for (size_t i = 0; i < AUDIO_LOUDNESS_HISTOGRAM_BINS; i++) {
+        if (!meter->histogram[i]) continue;
+        energy += meter->histogram[i] * lnd_bin_energy(i);
+        blocks += meter->histogram[i];
+    }
+    if (blocks == 0) return AUDIO_LOUDNESS_FLOOR_LUFS;
+
+    // Relative gate: blocks within 10 LU of the absolutely gated loudness
+    float gate = lnd_lufs(energy / blocks) - 10.0f;
+    double first_bin = ceil((gate - AUDIO_LOUDNESS_FLOOR_LUFS) * 10.0 - 0.5);
+    size_t first = first_bin > 0.0 ? (size_t)first_bin : 0;
+    energy = 0.0;
+    blocks = 0;
+    for (size_t i = first; i < AUDIO_LOUDNESS_HISTOGRAM_BINS; i++) {
+        if (!meter->histogram[i]) continue;
+        energy += meter->histogram[i] * lnd_bin_energy(i);
+        blocks += meter->histogram[i];
+    }
+    return blocks ? lnd_lufs(energy / blocks) : AUDIO_LOUDNESS_FLOOR_LUFS;
+}
+
+float audio_loudness_meter_peak(const audio_loudness_meter_t* meter) {
+    return meter ? (float)meter->peak / 32768.0f : 0.0f;
+}
+
+void audio_loudness_meter_merge(audio_loudness_meter_t* album, const audio_loudness_meter_t* track) {
+    if (!album || !track) return;
+    for (size_t i = 0; i < AUDIO_LOUDNESS_HISTOGRAM_BINS; i++) album->histogram[i] += track->histogram[i];
+    if (track->peak > album->peak) album->peak = track->peak;
+}
+
+// Tags
+
+static void lnd_apply_tag(audio_loudness_t* loudness, const char* key, const char* value) {
+    if (strncasecmp(key, "REPLAYGAIN_", 11) != 0) return;
+    key += 11;
+    char* end;
+    float x = strtof(value, &end);
+    if (end == value) return;
+    if (strcasecmp(key, "TRACK_GAIN") == 0) {
+        loudness->track_gain_db = x;
+        loudness->has_track = true;
+    } else if (strcasecmp(key, "TRACK_PEAK") == 0) {
+        loudness->track_peak = x;
+    } else if (strcasecmp(key, "ALBUM_GAIN") == 0) {
+        loudness->album_gain_db = x;
+        loudness->has_album = true;
+    } else if (strcasecmp(key, "ALBUM_PEAK") == 0) {
+        loudness->album_peak = x;
+    }
+}
+
+static uint32_t lnd_synchsafe(const uint8_t* b) {
+    return ((uint32_t)(b[0] & 0x7F) << 21) | ((uint32_t)(b[1] & 0x7F) << 14) |
+           ((uint32_t)(b[2] & 0x7F) << 7) | (b[3] & 0x7F);
+}
+
+// One ID3v2 string of encoding enc as ASCII; returns the bytes it took,
+// terminator included. UTF-16 keeps the ASCII code units, which is all
+// ReplayGain keys and values use.
+static size_t lnd_id3_text(const uint8_t* p, size_t n, uint8_t enc, char* out, size_t out_size) {
+    size_t len = 0, i = 0;
+    if (enc == 1 || enc == 2) {
+        for (; i + 1 < n; i += 2) {
+            if (p[i] == 0 && p[i + 1] == 0) { i += 2; break; }
+            if ((p[i] == 0xFF && p[i + 1] == 0xFE) || (p[i] == 0xFE && p[i + 1] == 0xFF)) continue;
+            if (len + 1 < out_size) out[len++] = (char)(p[i] ? p[i] : p[i + 1]);
+        }
+    } else {
+        for (; i < n; i++) {
+            if (p[i] == 0) { i++; break; }
+            if (len + 1 < out_size) out[len++] = (char)p[i];
+        }
+    }
+    out[len] = '\0';
+    return i;
+}
+
+// TXXX frames of an ID3v2.3/2.4 tag at the start of the n bytes read from
+// the file head. Returns the offset just past the tag (0 without one), which
+// may lie beyond n; frames past n are not seen.
+static uint64_t lnd_parse_id3(const uint8_t* p, size_t n, audio_loudness_t* loudness) {
+    if (n < 10 || memcmp(p, "ID3", 3) != 0) return 0;
+    uint8_t version = p[3];
+    uint64_t end = 10 + (uint64_t)lnd_synchsafe(p + 6) + ((p[5] & 0x10) ? 10 : 0);
+    // Whole-tag unsynchronisation would need undoing first; it predates ReplayGain taggers
+    if (version < 3 || version > 4 || (p[5] & 0x80)) return end;
+
+    uint64_t pos = 10;
+    if (p[5] & 0x40) {
+        if (n < 14) return end;
+        const uint8_t* ext = p + 10;
+        pos += version == 4 ? lnd_synchsafe(ext)
+                            : 4 + (((uint32_t)ext[0] << 24) | ((uint32_t)ext[1] << 16) | ((uint32_t)ext[2] << 8) | ext[3]);
+    }
+
+    uint64_t limit = end < n ? end : n;
+    char key[64], value[32];
+    while (pos + 10 <= limit) {
+        const uint8_t* f = p + pos;
+        if (f[0] == 0) break;       // Padding
+        uint32_t size = version == 4 ? lnd_synchsafe(f + 4)
+                                     : ((uint32_t)f[4] << 24) | ((uint32_t)f[5] << 16) | ((uint32_t)f[6] << 8) | f[7];
+        if (pos + 10 + size > limit) break;
+        if (memcmp(f, "TXXX", 4) == 0 && size > 1 && size <= LND_TAG_MAX) {
+            const uint8_t* body = f + 10;
+            size_t used = 1 + lnd_id3_text(body + 1, size - 1, body[0], key, sizeof(key));
+            if (used < size) {
+                lnd_id3_text(body + used, size - used, body[0], value, sizeof(value));
+                lnd_apply_tag(loudness, key, value);
+            }
+        }
+        pos += 10 + size;
+    }
+    return end;
+}
+
+static uint32_t lnd_le32(const uint8_t* b) {
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+// VORBIS_COMMENT block of a FLAC stream at the start of the n bytes read
+static void lnd_parse_flac(const uint8_t* p, size_t n, audio_loudness_t* loudness) {
+    if (n < 4 || memcmp(p, "fLaC", 4) != 0) return;
+    size_t pos = 4;
+    for (int b = 0;; b++) {
+        if (b == LND_MAX_BLOCKS || pos + 4 > n) return;
+        const uint8_t* h = p + pos;
+        uint32_t length = ((uint32_t)h[1] << 16) | ((uint32_t)h[2] << 8) | h[3];
+        pos += 4;
+        if ((h[0] & 0x7F) == 4) {
+            if (length < n - pos) n = pos + length;
+            break;
+        }
+        if (h[0] & 0x80) return;
+        pos += length;
+    }
+
+    // Vendor string, then count and the KEY=value comments, all little-endian lengths
+    if (pos + 4 > n || lnd_le32(p + pos) > n - pos - 4) return;
+    pos += 4 + lnd_le32(p + pos);
+    if (pos + 4 > n) return;
+    uint32_t count = lnd_le32(p + pos);
+    pos += 4;
+    char comment[LND_TAG_MAX];
+    for (uint32_t i = 0; i < count && pos + 4 <= n; i++) {
+        uint32_t length = lnd_le32(p + pos);
+        pos += 4;
+        if (length > n - pos) return;
+        if (length < sizeof(comment)) {
+            memcpy(comment, p + pos, length);
+            comment[length] = '\0';
+            char* eq = strchr(comment, '=');
+            if (eq) {
+                *eq = '\0';
+                lnd_apply_tag(loudness, comment, eq + 1);
+            }
+        }
+        pos += length;
+    }
+}
+
+// One read of up to AUDIO_LOUDNESS_TAG_READ_BYTES at offset
+static size_t lnd_read_head(hal_storage_file_t file, uint64_t offset, uint8_t* buffer) {
+    if (offset && !hal_storage_seek(file, (int64_t)offset, HAL_STORAGE_SEEK_SET)) return 0;
+    return hal_storage_read(file, buffer, AUDIO_LOUDNESS_TAG_READ_BYTES);
+}
+
+bool audio_loudness_read_tags(const char* path, audio_loudness_t* loudness, uint8_t* scratch) {
+    if (!path || !loudness) return false;
+    memset(loudness, 0, sizeof(*loudness));
+    uint8_t* buffer = scratch ? scratch : (uint8_t*)hal_system_malloc_psram(AUDIO_LOUDNESS_TAG_READ_BYTES);
+    if (!buffer) return false;
+    hal_storage_file_t file = hal_storage_open(path, HAL_STORAGE_MODE_READ);
+    if (!file) {
+        if (!scratch) hal_system_free(buffer);
+        return false;
+    }
+
+    size_t n = lnd_read_head(file, 0, buffer);
+    uint64_t offset = lnd_parse_id3(buffer, n, loudness);
+    audio_source_t source;
+    audio_source_file(&source, path);
+    if (audio_source_has_extension(&source, "flac")) {
+        // Metadata after an ID3 tag is usually still in the first read; a second when the tag filled it
+        if (offset + 4 <= n) {
+            lnd_parse_flac(buffer + offset, n - (size_t)offset, loudness);
+        } else {
+            n = lnd_read_head(file, offset, buffer);
+            lnd_parse_flac(buffer, n, loudness);
+        }
+    }
+    hal_storage_close(file);
+    if (!scratch) hal_system_free(buffer);
+
+    if (!loudness->has_track) return false;
+    // Taggers omit the album peak on single tracks; the track's is the safe bound
+    if (loudness->has_album && loudness->album_peak <= 0.0f) loudness->album_peak = loudness->track_peak;
+    return true;
+}
+
+// Cache
+
+// Record file named by a hash of the track path
+static void lnd_cache_path(const char* path, char* out, size_t out_size) {
+    uint32_t hash = 2166136261u;            // FNV-1a
+    for (const char* c = path; *c; c++) hash = (hash ^ (uint8_t)*c) * 16777619u;
+    snprintf(out, out_size, "%s/%08x.lnd", AUDIO_LOUDNESS_CACHE_DIR, (unsigned)hash);
+}
+
+// Reads a record and, into meter when given, its histogram
+static bool lnd_read_record(const char* path, audio_loudness_t* loudness, audio_loudness_meter_t* meter) {
+    uint64_t file_bytes = hal_storage_get_file_size(path);
+    if (file_bytes == 0) return false;
+    char cache[HAL_STORAGE_MAX_PATH_LENGTH];
+    lnd_cache_path(path, cache, sizeof(cache));
+    hal_storage_file_t file = hal_storage_open(cache, HAL_STORAGE_MODE_READ);
+    if (!file) return false;
+
+    lnd_cache_header_t h;
+    bool ok = hal_storage_read(file, &h, sizeof(h)) == sizeof(h)
+           && h.magic == LND_CACHE_MAGIC
+           && h.file_bytes == file_bytes
+           && (uint32_t)h.histogram_first + h.histogram_count <= AUDIO_LOUDNESS_HISTOGRAM_BINS;
+    if (ok && meter) {
+        memset(meter->histogram, 0, sizeof(meter->histogram));
+        meter->peak = (uint32_t)(h.track_peak * 32768.0f + 0.5f);
+        size_t bytes = h.histogram_count * sizeof(uint32_t);
+        ok = hal_storage_read(file, meter->histogram + h.histogram_first, bytes) == bytes;
+    }
+    hal_storage_close(file);
+    if (!ok) return false;
+
+    memset(loudness, 0, sizeof(*loudness));
+    loudness->has_track = (h.flags & LND_FLAG_TRACK) != 0;
+    loudness->has_album = (h.flags & LND_FLAG_ALBUM) != 0;
+    loudness->measured = (h.flags & LND_FLAG_MEASURED) != 0;
+    loudness->track_gain_db = h.track_gain_db;
+    loudness->track_peak = h.track_peak;
+    loudness->album_gain_db = h.album_gain_db;
+    loudness->album_peak = h.album_peak;
+    return true;
+}
+
+bool audio_loudness_load(const char* path, audio_loudness_t* loudness) {
+    if (!path || !loudness) return false;
+    return lnd_read_record(path, loudness, nullptr);
+}
+
+bool audio_loudness_save(const char* path, const audio_loudness_t* loudness, const audio_loudness_meter_t* meter) {
+    if (!path || !loudness) return false;
+    if (!hal_storage_dir_exists("/System")) hal_storage_create_dir("/System");
+    if (!hal_storage_dir_exists(AUDIO_LOUDNESS_CACHE_DIR) && !hal_storage_create_dir(AUDIO_LOUDNESS_CACHE_DIR)) {
+        return false;
+    }
+
+    lnd_cache_header_t h;
+    memset(&h, 0, sizeof(h));
+    h.magic = LND_CACHE_MAGIC;
+    h.flags = (loudness->has_track ? LND_FLAG_TRACK : 0) | (loudness->has_album ? LND_FLAG_ALBUM : 0) |
+              (loudness->measured ? LND_FLAG_MEASURED : 0);
+    h.file_bytes = hal_storage_get_file_size(path);
+    h.track_gain_db = loudness->track_gain_db;
+    h.track_peak = loudness->track_peak;
+    h.album_gain_db = loudness->album_gain_db;
+    h.album_peak = loudness->album_peak;
+    if (h.file_bytes == 0) return false;
+    if (meter) {
+        size_t first = 0, last = AUDIO_LOUDNESS_HISTOGRAM_BINS;
+        while (first < last && !meter->histogram[first]) first++;
+        while (last > first && !meter->histogram[last - 1]) last--;
+        h.histogram_first = (uint16_t)first;
+        h.histogram_count = (uint16_t)(last - first);
+    }
+
+    char cache[HAL_STORAGE_MAX_PATH_LENGTH];
+    lnd_cache_path(path, cache, sizeof(cache));
+    hal_storage_file_t file = hal_storage_open(cache, (hal_storage_mode_t)(HAL_STORAGE_MODE_WRITE | HAL_STORAGE_MODE_CREATE |
+                                                                            HAL_STORAGE_MODE_TRUNCATE));
+    if (!file) return false;
+    size_t bytes = h.histogram_count * sizeof(uint32_t);
+    bool ok = hal_storage_write(file, &h, sizeof(h)) == sizeof(h)
+           && (bytes == 0 || hal_storage_write(file, meter->histogram + h.histogram_first, bytes) == bytes);
+    hal_storage_close(file);
+    if (!ok) hal_storage_delete_file(cache);
+    return ok;
+}
+
+bool audio_loudness_lookup(const char* path, audio_loudness_t* loudness, uint8_t* scratch) {
+    if (!path || !loudness) return false;
+    if (lnd_read_record(path, loudness, nullptr)) return loudness->has_track;
+    return audio_loudness_read_tags(path, loudness, scratch);
+}
+
+int32_t audio_loudness_gain_q15(const audio_loudness_t* loudness, audio_replay_gain_mode_t mode, float preamp_db) {
+    if (mode == AUDIO_REPLAY_GAIN_OFF || !loudness || !loudness->has_track) return AUDIO_DSP_Q15_ONE;
+    bool album = mode == AUDIO_REPLAY_GAIN_ALBUM && loudness->has_album;
+    float db = (album ? loudness->album_gain_db : loudness->track_gain_db) + preamp_db;
+    float peak = album ? loudness->album_peak : loudness->track_peak;
+    // Clip prevention: the loudest sample may reach full scale, no further
+    if (peak > 0.0f) {
+        float headroom_db = -20.0f * log10f(peak);
+        if (db > headroom_db) db = headroom_db;
+    }
+    return audio_dsp_gain_from_db(db);
+}
+
+// Indexing job
+
+typedef enum {
+    JOB_SCAN = 0,                           // Next entry of the innermost directory
+    JOB_MEASURE,                            // Decoding and metering a track
+    JOB_ALBUM_SUM,                          // Summing the directory's histograms
+    JOB_ALBUM_WRITE,                        // Writing the album gain into its records
+    JOB_DONE
+} job_phase_t;
+
+typedef struct {
+    hal_storage_dir_t dir;
+    char path[HAL_STORAGE_MAX_PATH_LENGTH];
+    bool changed;                           // A record here needs its album gain
+} job_level_t;
+
+// Job state (job task, or the caller of audio_loudness_job_step())
+static struct {
+    bool active;
+    job_phase_t phase;
+    uint32_t step_frames;
+    job_level_t levels[AUDIO_LOUDNESS_MAX_DEPTH + 1];
+    uint32_t depth;                         // Levels open
+
+    const audio_decoder_ops_t* decoder;     // Track being measured
+    void* state;
+    int16_t* pcm;
+    uint8_t* tags;                          // Tag read scratch
+    audio_mp3_index_t* seek;                // Seek table scan scratch
+    audio_loudness_meter_t meter;
+
+    hal_storage_dir_t album_dir;
+    audio_loudness_meter_t album;
+    uint32_t album_tracks;                  // Measured tracks in the directory
+
+    hal_task_handle_t task;
+    hal_semaphore_t task_done;
+    std::atomic<bool> quit;
+    hal_mutex_t lock;                       // Guards progress
+    audio_loudness_progress_t progress;
+} g_job;
+
+static void job_lock() {
+    if (g_job.lock) hal_system_take_mutex(g_job.lock, UINT32_MAX);
+}
+
+static void job_unlock() {
+    if (g_job.lock) hal_system_give_mutex(g_job.lock);
+}
+
+static void job_set_current(const char* path) {
+    job_lock();
+    strncpy(g_job.progress.current, path, sizeof(g_job.progress.current) - 1);
+    g_job.progress.current[sizeof(g_job.progress.current) - 1] = '\0';
+    job_unlock();
+}
+
+// Bumps one progress counter
+static void job_count(uint32_t audio_loudness_progress_t::*counter) {
+    job_lock();
+    g_job.progress.*counter += 1;
+    job_unlock();
+}
+
+static bool job_push(const char* path) {
+    if (g_job.depth > AUDIO_LOUDNESS_MAX_DEPTH) return false;
+    hal_storage_dir_t dir = hal_storage_open_dir(path);
+    if (!dir) return false;
+    job_level_t* level = &g_job.levels[g_job.depth++];
+    level->dir = dir;
+    strncpy(level->path, path, sizeof(level->path) - 1);
+    level->path[sizeof(level->path) - 1] = '\0';
+    level->changed = false;
+    return true;
+}
+
+static void job_close_track() {
+    if (g_job.decoder) g_job.decoder->close(g_job.state);
+    g_job.decoder = nullptr;
+}
+
+// Closes everything the job holds; records already written stay
+static void job_release() {
+    job_close_track();
+    while (g_job.depth > 0) {
+        job_level_t* level = &g_job.levels[--g_job.depth];
+        if (level->dir) hal_storage_close_dir(level->dir);
+        level->dir = nullptr;
+    }
+    if (g_job.album_dir) hal_storage_close_dir(g_job.album_dir);
+    g_job.album_dir = nullptr;
+    hal_system_free(g_job.state);
+    hal_system_free(g_job.pcm);
+    hal_system_free(g_job.tags);
+    hal_system_free(g_job.seek);
+    g_job.state = nullptr;
+    g_job.pcm = nullptr;
+    g_job.tags = nullptr;
+    g_job.seek = nullptr;
+    g_job.phase = JOB_DONE;
+    g_job.active = false;
+    job_lock();
+    g_job.progress.running = false;
+    g_job.progress.waiting = false;
+    g_job.progress.current[0] = '\0';
+    job_unlock();
+}
+
+// Track files: anything a decoder takes by name
+static bool job_is_track(const hal_storage_file_info_t* info) {
+    if (info->type != HAL_STORAGE_TYPE_FILE) return false;
+    audio_source_t source;
+    audio_source_file(&source, info->path);
+    return audio_decoder_find(&source) != nullptr;
+}
+
+// Untagged variable bitrate MP3: scans and caches the seek table that the
+// decoder would otherwise estimate from. The scan reads the whole file.
+static void job_index_seek(const hal_storage_file_info_t* info) {
+    audio_source_t source;
+    audio_source_file(&source, info->path);
+    if (info->type != HAL_STORAGE_TYPE_FILE || !audio_source_has_extension(&source, "mp3")) return;
+    hal_storage_file_t file = hal_storage_open(info->path, HAL_STORAGE_MODE_READ);
+    if (!file) return;
+    if (audio_mp3_index_open(g_job.seek, file) && g_job.seek->kind == AUDIO_MP3_INDEX_NONE &&
+        !audio_mp3_index_load(g_job.seek, info->path) && audio_mp3_index_scan(g_job.seek, file) &&
+        audio_mp3_index_save(g_job.seek, info->path)) {
+        job_count(&audio_loudness_progress_t::seek_indexed);
+    }
+    hal_storage_close(file);
+}
+
+// Starts on a track: skipped when it has a record, recorded from its tags
+// when they carry both gains, measured otherwise
+static void job_begin_track(job_level_t* level, const char* path) {
+    audio_loudness_t loudness;
+    if (audio_loudness_load(path, &loudness)) {
+        if (loudness.measured && !loudness.has_album) level->changed = true;
+        job_count(&audio_loudness_progress_t::cached);
+        return;
+    }
+    if (audio_loudness_read_tags(path, &loudness, g_job.tags) && loudness.has_album) {
+        audio_loudness_save(path, &loudness, nullptr);
+        job_count(&audio_loudness_progress_t::tagged);
+        return;
+    }
+
+    audio_source_t source;
+    audio_source_file(&source, path);
+    const audio_decoder_ops_t* decoder = audio_decoder_find(&source);
+    audio_stream_info_t info;
+    memset(&info, 0, sizeof(info));
+    memset(g_job.state, 0, decoder->state_size);
+    if (!decoder->open(g_job.state, &source, &info)) {
+        job_count(&audio_loudness_progress_t::failed);
+        return;
+    }
+    if (!audio_loudness_meter_init(&g_job.meter, info.sample_rate, info.channels)) {
+        decoder->close(g_job.state);
+        job_count(&audio_loudness_progress_t::failed);
+        return;
+    }
+    g_job.decoder = decoder;
+    g_job.phase = JOB_MEASURE;
+    job_set_current(path);
+}
+
+static void job_end_track() {
+    const char* path = g_job.progress.current;     // Written only by this task
+    audio_loudness_t loudness;
+    memset(&loudness, 0, sizeof(loudness));
+    loudness.has_track = true;
+    loudness.measured = true;
+    float lufs = audio_loudness_meter_integrated(&g_job.meter);
+    // Silence keeps unity gain
+    loudness.track_gain_db = lufs > AUDIO_LOUDNESS_FLOOR_LUFS ? AUDIO_LOUDNESS_REFERENCE_LUFS - lufs : 0.0f;
+    loudness.track_peak = audio_loudness_meter_peak(&g_job.meter);
+    job_close_track();
+    if (audio_loudness_save(path, &loudness, &g_job.meter)) {
+        g_job.levels[g_job.depth - 1].changed = true;
+        job_count(&audio_loudness_progress_t::measured);
+    } else {
+        job_count(&audio_loudness_progress_t::failed);
+    }
+    job_set_current("");
+    g_job.phase = JOB_SCAN;
+}
+
+static void job_measure() {
+    uint32_t frames = 0;
+    while (frames < g_job.step_frames) {
+        uint32_t n = g_job.decoder->decode(g_job.state, g_job.pcm, JOB_PCM_FRAMES);
+        if (n == 0) {
+            job_end_track();
+            return;
+        }
+        audio_loudness_meter_feed(&g_job.meter, g_job.pcm, n);
+        frames += n;
+    }
+}
+
+static void job_scan() {
+    job_level_t* level = &g_job.levels[g_job.depth - 1];
+    hal_storage_file_info_t info;
+    if (!hal_storage_read_dir(level->dir, &info)) {
+        hal_storage_close_dir(level->dir);
+        level->dir = nullptr;
+        if (level->changed) {
+            g_job.album_dir = hal_storage_open_dir(level->path);
+            memset(g_job.album.histogram, 0, sizeof(g_job.album.histogram));
+            g_job.album.peak = 0;
+            g_job.album_tracks = 0;
+            if (g_job.album_dir) {
+                g_job.phase = JOB_ALBUM_SUM;
+                return;
+            }
+        }
+        g_job.depth--;
+        return;
+    }
+    if (info.name[0] == '.' || strcmp(info.path, "/System") == 0) return;
+    if (info.type == HAL_STORAGE_TYPE_DIRECTORY) {
+        job_push(info.path);
+    } else {
+        job_index_seek(&info);
+        if (job_is_track(&info)) job_begin_track(level, info.path);
+    }
+}
+
+// Album pass, one track per step: sum the measured histograms, then write the
+// result into every measured record of the directory
+static void job_album() {
+    hal_storage_file_info_t info;
+    if (!hal_storage_read_dir(g_job.album_dir, &info)) {
+        if (g_job.phase == JOB_ALBUM_SUM && g_job.album_tracks > 0) {
+            hal_storage_rewind_dir(g_job.album_dir);
+            g_job.phase = JOB_ALBUM_WRITE;
+            return;
+        }
+        if (g_job.album_tracks > 0) job_count(&audio_loudness_progress_t::albums);
+        hal_storage_close_dir(g_job.album_dir);
+        g_job.album_dir = nullptr;
+        g_job.depth--;
+        g_job.phase = JOB_SCAN;
+        return;
+    }
+    audio_loudness_t loudness;
+    if (!job_is_track(&info) || !lnd_read_record(info.path, &loudness, &g_job.meter) || !loudness.measured) return;
+
+    if (g_job.phase == JOB_ALBUM_SUM) {
+        audio_loudness_meter_merge(&g_job.album, &g_job.meter);
+        g_job.album_tracks++;
+        return;
+    }
+    float lufs = audio_loudness_meter_integrated(&g_job.album);
+    float gain_db = lufs > AUDIO_LOUDNESS_FLOOR_LUFS ? AUDIO_LOUDNESS_REFERENCE_LUFS - lufs : 0.0f;
+    float peak = audio_loudness_meter_peak(&g_job.album);
+    if (loudness.has_album && loudness.album_gain_db == gain_db && loudness.album_peak == peak) return;
+    loudness.has_album = true;
+    loudness.album_gain_db = gain_db;
+    loudness.album_peak = peak;
+    audio_loudness_save(info.path, &loudness, &g_job.meter);
+}
+
+static void job_task(void* parameters) {
+    (void)parameters;
+    while (!g_job.quit.load()) {
+        // Playback has the card and the CPU; measure only in the gaps
+        bool playing = audio_engine_get_state() == HAL_AUDIO_STATE_PLAYING;
+        if (g_job.progress.waiting != playing) {
+            job_lock();
+            g_job.progress.waiting = playing;
+            job_unlock();
+        }
+        if (playing) {
+            hal_system_delay_ms(AUDIO_LOUDNESS_IDLE_POLL_MS);
+            continue;
+        }
+        if (!audio_loudness_job_step()) break;
+        // Lets the idle task run between steps
+        hal_system_delay_ms(1);
+    }
+    hal_system_give_semaphore(g_job.task_done);
+    hal_system_delete_task(nullptr);
+}
+
+extern "C" {
+
+bool audio_loudness_job_start(const audio_loudness_job_config_t* config) {
+    audio_loudness_job_stop();
+
+    const char* root = (config && config->root) ? config->root : AUDIO_LOUDNESS_DEFAULT_ROOT;
+    g_job.step_frames = (config && config->step_frames) ? config->step_frames : AUDIO_LOUDNESS_STEP_FRAMES;
+    g_job.state = hal_system_malloc_psram(audio_decoder_max_state_size());
+    g_job.pcm = (int16_t*)hal_system_malloc(JOB_PCM_FRAMES * 2 * sizeof(int16_t));
+    g_job.tags = (uint8_t*)hal_system_malloc_psram(AUDIO_LOUDNESS_TAG_READ_BYTES);
+    g_job.seek = (audio_mp3_index_t*)hal_system_malloc_psram(sizeof(audio_mp3_index_t));
+    if (!g_job.lock) g_job.lock = hal_system_create_mutex();
+    memset(&g_job.progress, 0, sizeof(g_job.progress));
+    g_job.phase = JOB_SCAN;
+    g_job.depth = 0;
+    if (!g_job.state || !g_job.pcm || !g_job.tags || !g_job.seek || !g_job.lock || !job_push(root)) {
+        job_release();
+        return false;
+    }
+    g_job.active = true;
+    g_job.progress.running = true;
+
+    if (config && config->start_task) {
+        g_job.quit = false;
+        g_job.task_done = hal_system_create_semaphore(1, 0);
+        g_job.task = hal_system_create_task(job_task, "Loudness", AUDIO_LOUDNESS_TASK_STACK, nullptr,
+                                            HAL_TASK_PRIORITY_LOW);
+        if (!g_job.task_done || !g_job.task) {
+            audio_loudness_job_stop();
+            return false;
+        }
+    }
+    return true;
+}
+
+void audio_loudness_job_stop(void) {
+    if (g_job.task) {
+        g_job.quit = true;
+        hal_system_take_semaphore(g_job.task_done, UINT32_MAX);
+        g_job.task = nullptr;
+    }
+    if (g_job.task_done) {
+        hal_system_delete_semaphore(g_job.task_done);
+        g_job.task_done = nullptr;
+    }
+    job_release();
+}
+
+bool audio_loudness_job_step(void) {
+    if (!g_job.active) return false;
+    switch (g_job.phase) {
+        case JOB_SCAN:
+            job_scan();
+            break;
+        case JOB_MEASURE:
+            job_measure();
+            break;
+        case JOB_ALBUM_SUM:
+        case JOB_ALBUM_WRITE:
+            job_album();
+            break;
+        case JOB_DONE:
+            break;
+    }
+    if (g_job.depth == 0 && g_job.phase == JOB_SCAN) job_release();
+    return g_job.active;
+}
+
+bool audio_loudness_job_is_running(void) {
+    return g_job.active;
+}
+
+void audio_loudness_job_get_progress(audio_loudness_progress_t* progress) {
+    if (!progress) return;
+    job_lock();
+    *progress = g_job.progress;
+    job_unlock();
+}
+
+} // extern "C"
@@ -0,0 +1,444 @@
+/*
+ * MP3 Seek Index Implementation
+ * Header parsing, Xing/Info/VBRI tags, header-only scanning and the table cache
+ */
+
+#include "audio/audio_mp3_index.h"
+#include "hal/hal_system.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define MP3_READ_BYTES          4096    // Reader window; several frames per SD read
+#define MP3_SYNC_LIMIT          8192    // Bytes searched for a header after a jump
+#define MP3_HEAD_LIMIT          65536   // Junk tolerated between the tags and the first frame
+#define MP3_CBR_PROBE_FRAMES    8       // Untagged files are constant bitrate if these agree
+#define MP3_CACHE_MAGIC         0x3158504Du     // "MPX1"
+
+static const uint16_t k_bitrates_v1[16] = {
+    0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0
+};
+static const uint16_t k_bitrates_v2[16] = {
+    0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0
+};
+static const uint32_t k_rates_v1[3] = { 44100, 48000, 32000 };
+
+// Cached table header; the offsets follow
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+    uint64_t file_bytes;
+    uint64_t data_start;
+    uint64_t data_bytes;
+    uint32_t total_frames;
+    uint32_t sample_rate;
+    uint32_t samples_per_frame;
+    uint32_t bitrate_kbps;
+    uint32_t stride;
+    uint32_t reserved;
+} mp3_cache_header_t;
+
+// Windowed reader so walking headers costs one SD read per few frames
+typedef struct {
+    hal_storage_file_t file;
+    uint64_t base;
+    uint32_t length;
+    uint8_t* buffer;
+} mp3_reader_t;
+
+static bool mp3_reader_open(mp3_reader_t* r, hal_storage_file_t file) {
+    r->file = file;
+    r->base = 0;
+    r->length = 0;
+    r->buffer = (uint8_t*)hal_system_malloc(MP3_READ_BYTES);
+    return r->buffer != nullptr;
+}
+
+static void mp3_reader_close(mp3_reader_t* r) {
+    hal_system_free(r->buffer);
+    r->buffer = nullptr;
+}
+
+// Returns `need` bytes at `offset`, refilling the window when they are outside it
+static const uint8_t* mp3_reader_at(mp3_reader_t* r, uint64_t offset, uint32_t need) {
+    if (offset >= r->base && offset + need <= r->base + r->length) return r->buffer + (offset - r->base);
+    if (!hal_storage_seek(r->file, (int64_t)offset, HAL_STORAGE_SEEK_SET)) return nullptr;
+    r->base = offset;
+    r->length = (uint32_t)hal_storage_read(r->file, r->buffer, MP3_READ_BYTES);
+    return r->length >= need ? r->buffer : nullptr;
+}
+
+static uint32_t read_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint16_t read_be16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+bool audio_mp3_parse_header(const uint8_t* b, audio_mp3_header_t* header) {
+    if (b[0] != 0xFF || (b[1] & 0xE0) != 0xE0) return false;
+    const uint32_t version = (b[1] >> 3) & 3;   // 0 = 2.5, 2 = 2, 3 = 1
+    const uint32_t layer = (b[1] >> 1) & 3;     // 1 = Layer III
+    const uint32_t bitrate_index = b[2] >> 4;
+    const uint32_t rate_index = (b[2] >> 2) & 3;
+    if (version == 1 || layer != 1 || bitrate_index == 0 || bitrate_index == 15 || rate_index == 3) return false;
+
+    const bool mpeg1 = version == 3;
+    header->bitrate_kbps = mpeg1 ? k_bitrates_v1[bitrate_index] : k_bitrates_v2[bitrate_index];
+    header->sample_rate = k_rates_v1[rate_index] >> (mpeg1 ? 0 : (version == 2 ? 1 : 2));
+    header->channels = (b[3] >> 6) == 3 ? 1 : 2;
+    header->samples = mpeg1 ? 1152 : 576;
+    header->bytes = header->samples / 8 * header->bitrate_kbps * 1000 / header->sample_rate + ((b[2] >> 1) & 1);
+    return true;
+}
+
+// A header counts only when the next frame starts where it says, with the same
+// version, layer and rate; a lone 0xFFE in the payload is not enough
+static bool mp3_header_at(mp3_reader_t* r, uint64_t offset, audio_mp3_header_t* header) {
+    const uint8_t* p = mp3_reader_at(r, offset, 4);
+    if (!p || !audio_mp3_parse_header(p, header)) return false;
+    const uint8_t b1 = p[1], rate = p[2] & 0x0C;
+    const uint8_t* next = mp3_reader_at(r, offset + header->bytes, 4);
+    if (!next) return true;                 // Last frame of the file
+    audio_mp3_header_t unused;
+    return audio_mp3_parse_header(next, &unused) && next[1] == b1 && (next[2] & 0x0C) == rate;
+}
+
+// First verified header in [offset, offset + limit)
+static bool mp3_sync(mp3_reader_t* r, uint64_t offset, uint32_t limit, uint64_t* found, audio_mp3_header_t* header) {
+    for (uint64_t pos = offset; pos < offset + limit; pos++) {
+        const uint8_t* p = mp3_reader_at(r, pos, 1);
+        if (!p) return false;
+        if (*p == 0xFF && mp3_header_at(r, pos, header)) {
+            *found = pos;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Appends frame `frame` at `offset` when it falls on the stride; halves the
+// table when it is full
+static void mp3_index_add(audio_mp3_index_t* index, uint32_t frame, uint64_t offset) {
+    if (frame % index->stride) return;
+    if (frame / index->stride != index->count) return;
+    if (index->count == AUDIO_MP3_INDEX_POINTS) {
+        for (uint32_t i = 0; i < AUDIO_MP3_INDEX_POINTS / 2; i++) index->offsets[i] = index->offsets[i * 2];
+        index->count = AUDIO_MP3_INDEX_POINTS / 2;
+        index->stride *= 2;
+        if (frame % index->stride) return;
+    }
+    index->offsets[index->count++] = (uint32_t)(offset - index->data_start);
+}
+
+static uint64_t mp3_skip_id3v2(mp3_reader_t* r) {
+    uint64_t offset = 0;
+    for (;;) {
+        const uint8_t* p = mp3_reader_at(r, offset, 10);
+        if (!p || memcmp(p, "ID3", 3) != 0) return offset;
+        uint32_t size = ((uint32_t)(p[6] & 0x7F) << 21) | ((uint32_t)(p[7] & 0x7F) << 14)
+                      | ((uint32_t)(p[8] & 0x7F) << 7) | (uint32_t)(p[9] & 0x7F);
+        offset += 10 + size + ((p[5] & 0x10) ? 10 : 0);     // Optional footer
+    }
+}
+
+// Xing/Info tag in the first frame. Returns false when there is none.
+static bool mp3_read_xing(audio_mp3_index_t* index, mp3_reader_t* r, uint64_t first,
+                          const audio_mp3_header_t* header, bool mpeg1) {
+    uint32_t side = mpeg1 ? (header->channels == 1 ? 17 : 32) : (header->channels == 1 ? 9 : 17);
+    const uint8_t* p = mp3_reader_at(r, first + 4 + side, 8 + 8 + AUDIO_MP3_INDEX_TOC);
+    if (!p || (memcmp(p, "Xing", 4) != 0 && memcmp(p, "Info", 4) != 0)) return false;
+
+    const bool info = p[0] == 'I';
+    const uint32_t flags = read_be32(p + 4);
+    const uint8_t* field = p + 8;
+    uint32_t frames = 0, bytes = 0;
+    if (flags & 1) { frames = read_be32(field); field += 4; }
+    if (flags & 2) { bytes = read_be32(field); field += 4; }
+
+    index->data_start = first + header->bytes;
+    if (bytes > header->bytes && first + bytes <= index->file_bytes) index->data_bytes = bytes - header->bytes;
+    index->total_frames = frames;
+    if ((flags & 4) && !info && frames) {
+        memcpy(index->toc, field, AUDIO_MP3_INDEX_TOC);
+        index->kind = AUDIO_MP3_INDEX_XING;
+    } else if (info) {
+        // LAME writes Info instead of Xing only for constant bitrate
+        index->kind = AUDIO_MP3_INDEX_LINEAR;
+        index->exact = true;
+        index->bitrate_kbps = header->bitrate_kbps;
+    } else if (frames) {
+        index->kind = AUDIO_MP3_INDEX_LINEAR;   // Average frame length only
+    }
+    return true;
+}
+
+// Fraunhofer VBRI tag: a TOC of segment sizes, turned into FRAMES points
+static bool mp3_read_vbri(audio_mp3_index_t* index, mp3_reader_t* r, uint64_t first,
+                          const audio_mp3_header_t* header) {
+    const uint8_t* p = mp3_reader_at(r, first + 4 + 32, 26);
+    if (!p || memcmp(p, "VBRI", 4) != 0) return false;
+
+    const uint32_t bytes = read_be32(p + 10);
+    const uint32_t frames = read_be32(p + 14);
+    const uint32_t entries = read_be16(p + 18);
+    const uint32_t scale = read_be16(p + 20);
+    const uint32_t entry_bytes = read_be16(p + 22);
+    const uint32_t frames_per_entry = read_be16(p + 24);
+    if (entry_bytes < 1 || entry_bytes > 4 || frames_per_entry == 0) return false;
+
+    index->data_start = first + header->bytes;
+    if (bytes > header->bytes && first + bytes <= index->file_bytes) index->data_bytes = bytes - header->bytes;
+    index->total_frames = frames;
+    index->stride = frames_per_entry;
+    index->count = 0;
+
+    // Segment sizes run from the tag frame; point 0 is the first audio frame
+    uint64_t toc_pos = first + 4 + 32 + 26;
+    uint64_t position = first;
+    mp3_index_add(index, 0, index->data_start);
+    for (uint32_t i = 0; i + 1 < entries; i++) {
+        const uint8_t* e = mp3_reader_at(r, toc_pos + (uint64_t)i * entry_bytes, entry_bytes);
+        if (!e) return false;
+        uint32_t size = 0;
+        for (uint32_t k = 0; k < entry_bytes; k++) size = (size << 8) | e[k];
+        position += (uint64_t)size * scale;
+        uint64_t offset = position > index->data_start ? position : index->data_start;
+        mp3_index_add(index, (i + 1) * frames_per_entry, offset);
+    }
+    index->kind = AUDIO_MP3_INDEX_FRAMES;
+    index->exact = false;                   // Scaled sizes: resync at every point
+    return true;
+}
+
+bool audio_mp3_index_open(audio_mp3_index_t* index, hal_storage_file_t file) {
+    memset(index, 0, sizeof(*index));
+    index->file_bytes = hal_storage_get_file_size_handle(file);
+    index->stride = AUDIO_MP3_INDEX_STRIDE;
+
+    mp3_reader_t r;
+    if (!mp3_reader_open(&r, file)) return false;
+
+    audio_mp3_header_t header;
+    uint64_t first = 0;
+    bool ok = mp3_sync(&r, mp3_skip_id3v2(&r), MP3_HEAD_LIMIT, &first, &header);
+    if (ok) {
+        const uint8_t* p = mp3_reader_at(&r, first, 4);
+        const bool mpeg1 = p && ((p[1] >> 3) & 3) == 3;
+
+        index->sample_rate = header.sample_rate;
+        index->samples_per_frame = header.samples;
+        index->channels = header.channels;
+        index->data_start = first;
+        if (!mp3_read_xing(index, &r, first, &header, mpeg1) && !mp3_read_vbri(index, &r, first, &header)) {
+            // Untagged: constant bitrate when the leading frames agree, else
+            // their average bitrate stands in until a scan
+            audio_mp3_header_t next;
+            uint64_t pos = first + header.bytes;
+            uint32_t frames = 1, kbps_sum = header.bitrate_kbps;
+            bool agree = true;
+            while (frames < MP3_CBR_PROBE_FRAMES && mp3_header_at(&r, pos, &next)) {
+                agree = agree && next.bitrate_kbps == header.bitrate_kbps;
+                kbps_sum += next.bitrate_kbps;
+                pos += next.bytes;
+                frames++;
+            }
+            index->kind = agree && frames == MP3_CBR_PROBE_FRAMES ? AUDIO_MP3_INDEX_LINEAR : AUDIO_MP3_INDEX_NONE;
+            index->exact = index->kind == AUDIO_MP3_INDEX_LINEAR;
+            index->bitrate_kbps = index->exact ? header.bitrate_kbps : (kbps_sum + frames / 2) / frames;
+        }
+        // ID3v1 tail, read last so the head above came from one window
+        const uint8_t* tail = index->file_bytes >= 128 ? mp3_reader_at(&r, index->file_bytes - 128, 3) : nullptr;
+        const uint64_t end = index->file_bytes - (tail && memcmp(tail, "TAG", 3) == 0 ? 128 : 0);
+        if (index->data_bytes == 0 || index->data_start + index->data_bytes > end) {
+            index->data_bytes = end > index->data_start ? end - index->data_start : 0;
+        }
+        if (index->kind == AUDIO_MP3_INDEX_LINEAR && index->total_frames == 0 && index->bitrate_kbps) {
+            const uint64_t frame_bits = (uint64_t)index->bitrate_kbps * 1000 * header.samples;
+            index->total_frames = (uint32_t)((index->data_bytes * 8 * header.sample_rate + frame_bits / 2) / frame_bits);
+        }
+        if (index->total_frames && !index->bitrate_kbps) {
+            index->bitrate_kbps = (uint32_t)(index->data_bytes * 8 * header.sample_rate
+                                             / ((uint64_t)index->total_frames * header.samples * 1000));
+        }
+    }
+    mp3_reader_close(&r);
+    return ok;
+}
+
+bool audio_mp3_index_scan(audio_mp3_index_t* index, hal_storage_file_t file) {
+    mp3_reader_t r;
+    if (!mp3_reader_open(&r, file)) return false;
+
+    const uint64_t end = index->data_start + index->data_bytes;
+    index->stride = AUDIO_MP3_INDEX_STRIDE;
+    index->count = 0;
+    uint32_t frame = 0;
+    uint64_t pos = index->data_start;
+    audio_mp3_header_t header;
+    while (pos + 4 <= end) {
+        if (!mp3_header_at(&r, pos, &header) && !mp3_sync(&r, pos, MP3_HEAD_LIMIT, &pos, &header)) break;
+        if (pos + header.bytes > end) break;
+        mp3_index_add(index, frame, pos);
+        pos += header.bytes;
+        frame++;
+    }
+    mp3_reader_close(&r);
+    if (frame == 0) return false;
+
+    index->total_frames = frame;
+    index->bitrate_kbps = (uint32_t)(index->data_bytes * 8 * index->sample_rate
+                                     / ((uint64_t)frame * index->samples_per_frame * 1000));
+    index->kind = AUDIO_MP3_INDEX_FRAMES;
+    index->exact = true;
+    return true;
+}
+
+bool audio_mp3_index_locate(const audio_mp3_index_t* index, hal_storage_file_t file,
+                            uint32_t frame, uint64_t* offset, uint32_t* located) {
+    if (index->kind == AUDIO_MP3_INDEX_NONE && !index->bitrate_kbps) return false;
+    if (frame == 0) {
+        *offset = index->data_start;
+        *located = 0;
+        return true;
+    }
+    if (index->total_frames && frame >= index->total_frames) {
+        *offset = index->data_start + index->data_bytes;
+        *located = index->total_frames;
+        return true;
+    }
+
+    mp3_reader_t r;
+    if (!mp3_reader_open(&r, file)) return false;
+
+    audio_mp3_header_t header;
+    uint64_t pos = index->data_start;
+    uint32_t at = frame;
+    bool ok = false;
+    if (index->kind == AUDIO_MP3_INDEX_FRAMES) {
+        uint32_t point = frame / index->stride;
+        if (point >= index->count) point = index->count - 1;
+        pos = index->data_start + index->offsets[point];
+        at = point * index->stride;
+        ok = index->exact ? mp3_header_at(&r, pos, &header) : mp3_sync(&r, pos, MP3_SYNC_LIMIT, &pos, &header);
+        while (ok && at < frame) {
+            audio_mp3_header_t next;
+            if (!mp3_header_at(&r, pos + header.bytes, &next)) break;
+            pos += header.bytes;
+            header = next;
+            at++;
+        }
+    } else {
+        double target;
+        if (index->kind == AUDIO_MP3_INDEX_XING) {
+            double percent = (double)frame * AUDIO_MP3_INDEX_TOC / index->total_frames;
+            uint32_t i = (uint32_t)percent;
+            double lo = index->toc[i];
+            double hi = i + 1 < AUDIO_MP3_INDEX_TOC ? index->toc[i + 1] : 256.0;
+            target = (lo + (hi - lo) * (percent - i)) / 256.0 * (double)index->data_bytes;
+        } else {
+            // Constant bitrate uses the nominal length, which padding tracks to the
+            // byte; otherwise the average from the tag's byte and frame counts,
+            // or from the leading frames' bitrate when there are no counts
+            double frame_bytes = index->exact || !index->total_frames
+                               ? (double)index->samples_per_frame / 8 * index->bitrate_kbps * 1000 / index->sample_rate
+                               : (double)index->data_bytes / index->total_frames;
+            // Half a frame early, so the first header found is the frame itself
+            target = frame * frame_bytes - frame_bytes / 2;
+        }
+        pos = index->data_start + (uint64_t)(target > 0.0 ? target : 0.0);
+        ok = mp3_sync(&r, pos, MP3_SYNC_LIMIT, &pos, &header);
+    }
+    mp3_reader_close(&r);
+    if (!ok) return false;
+
+    *offset = pos;
+    *located = at;
+    return true;
+}
+
+bool audio_mp3_probe(const char* path, audio_stream_info_t* info) {
+    hal_storage_file_t file = hal_storage_open(path, HAL_STORAGE_MODE_READ);
+    if (!file) return false;
+    audio_mp3_index_t* index = (audio_mp3_index_t*)hal_system_malloc(sizeof(audio_mp3_index_t));
+    bool ok = index && audio_mp3_index_open(index, file);
+    hal_storage_close(file);
+    if (ok) {
+        if (index->kind == AUDIO_MP3_INDEX_NONE && !audio_mp3_index_load(index, path) && index->bitrate_kbps) {
+            const uint64_t frame_bits = (uint64_t)index->bitrate_kbps * 1000 * index->samples_per_frame;
+            index->total_frames = (uint32_t)(index->data_bytes * 8 * index->sample_rate / frame_bits);
+        }
+        memset(info, 0, sizeof(*info));
+        info->sample_rate = index->sample_rate;
+        info->channels = index->channels;
+        info->total_frames = (uint64_t)index->total_frames * index->samples_per_frame;
+        info->bitrate_kbps = index->bitrate_kbps;
+    }
+    hal_system_free(index);
+    return ok;
+}
+
+// Cache file named by a hash of the track path
+static void mp3_cache_path(const char* path, char* out, size_t out_size) {
+    uint32_t hash = 2166136261u;            // FNV-1a
+    for (const char* c = path; *c; c++) hash = (hash ^ (uint8_t)*c) * 16777619u;
+    snprintf(out, out_size, "%s/%08x.idx", AUDIO_MP3_INDEX_CACHE_DIR, (unsigned)hash);
+}
+
+bool audio_mp3_index_load(audio_mp3_index_t* index, const char* path) {
+    char cache[HAL_STORAGE_MAX_PATH_LENGTH];
+    mp3_cache_path(path, cache, sizeof(cache));
+    hal_storage_file_t file = hal_storage_open(cache, HAL_STORAGE_MODE_READ);
+    if (!file) return false;
+
+    mp3_cache_header_t h;
+    bool ok = hal_storage_read(file, &h, sizeof(h)) == sizeof(h)
+           && h.magic == MP3_CACHE_MAGIC
+           && h.file_bytes == index->file_bytes
+           && h.data_start == index->data_start
+           && h.count > 0 && h.count <= AUDIO_MP3_INDEX_POINTS && h.stride > 0
+           && hal_storage_read(file, index->offsets, h.count * sizeof(uint32_t)) == h.count * sizeof(uint32_t);
+    hal_storage_close(file);
+    if (!ok) return false;
+
+    index->kind = AUDIO_MP3_INDEX_FRAMES;
+    index->exact = true;
+    index->data_bytes = h.data_bytes;
+    index->total_frames = h.total_frames;
+    index->bitrate_kbps = h.bitrate_kbps;
+    index->stride = h.stride;
+    index->count = h.count;
+    return true;
+}
+
+bool audio_mp3_index_save(const audio_mp3_index_t* index, const char* path) {
+    if (index->kind != AUDIO_MP3_INDEX_FRAMES || !index->exact) return false;
+    if (!hal_storage_dir_exists(AUDIO_MP3_INDEX_CACHE_DIR) && !hal_storage_create_dir(AUDIO_MP3_INDEX_CACHE_DIR)) {
+        return false;
+    }
+
+    char cache[HAL_STORAGE_MAX_PATH_LENGTH];
+    mp3_cache_path(path, cache, sizeof(cache));
+    hal_storage_file_t file = hal_storage_open(cache, (hal_storage_mode_t)(HAL_STORAGE_MODE_WRITE | HAL_STORAGE_MODE_CREATE |
+                                                                            HAL_STORAGE_MODE_TRUNCATE));
+    if (!file) return false;
+
+    mp3_cache_header_t h;
+    memset(&h, 0, sizeof(h));
+    h.magic = MP3_CACHE_MAGIC;
+    h.count = index->count;
+    h.file_bytes = index->file_bytes;
+    h.data_start = index->data_start;
+    h.data_bytes = index->data_bytes;
+    h.total_frames = index->total_frames;
+    h.sample_rate = index->sample_rate;
+    h.samples_per_frame = index->samples_per_frame;
+    h.bitrate_kbps = index->bitrate_kbps;
+    h.stride = index->stride;
+    bool ok = hal_storage_write(file, &h, sizeof(h)) == sizeof(h)
+           && hal_storage_write(file, index->offsets, index->count * sizeof(uint32_t)) == index->count * sizeof(uint32_t);
+    hal_storage_close(file);
+    if (!ok) hal_storage_delete_file(cache);
+    return ok;
+}
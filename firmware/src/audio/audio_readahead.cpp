@@ -0,0 +1,413 @@
+/*
+ * Audio Read-Ahead
+ * Stream slots, chunk pools and the filesystem task that fills them
+ *
+ * Each stream's chunks form a ring: the filler (the task, or the decoder
+ * when there is none) reads into the slot after the last filled one, the
+ * decoder consumes from the oldest. Only the filler touches the file and
+ * only the decoder moves the read side. A seek bumps the generation under
+ * the stream lock, so a read that was in flight when it happened is dropped.
+ */
+
+#include "audio/audio_readahead.h"
+#include "hal/hal_storage.h"
+#include "hal/hal_system.h"
+
+#include <atomic>
+#include <string.h>
+
+typedef struct {
+    uint64_t offset;                        // File offset of the chunk's first byte
+    uint32_t bytes;                         // Short only at end of file
+} readahead_chunk_t;
+
+struct audio_readahead {
+    bool in_use;
+    hal_storage_file_t file;
+    uint64_t file_size;
+    uint8_t* pool;                          // chunks * chunk_bytes, kept across opens
+    uint32_t chunk_bytes;
+    uint32_t chunks;
+    readahead_chunk_t chunk[AUDIO_READAHEAD_MAX_CHUNKS];
+    hal_mutex_t lock;                       // Filler commit vs. seek
+    hal_semaphore_t data_ready;             // Filler -> decoder
+
+    // Filler side
+    uint32_t write_slot;
+    uint64_t next_offset;                   // Aligned offset of the next read
+    uint64_t file_pos;                      // Where the handle is, to skip redundant seeks
+    uint32_t generation;
+    std::atomic<uint32_t> filled;           // Chunks ready for the decoder
+    std::atomic<bool> eof;                  // The last chunk is in (or the card failed)
+
+    // Decoder side
+    uint32_t read_slot;
+    uint32_t consumed;                      // Bytes of the read chunk already taken
+    uint64_t position;
+    bool primed;                            // Filled up since open/seek, so running dry is a stall
+};
+
+static struct {
+    audio_readahead slots[AUDIO_READAHEAD_MAX_STREAMS];
+    uint32_t chunk_bytes;
+    uint32_t chunks;
+    bool initialized;
+
+    hal_mutex_t lock;                       // Slot ownership vs. the task
+    hal_semaphore_t wake;                   // Decoders -> task: a chunk was freed
+    hal_semaphore_t task_done;
+    hal_task_handle_t task;
+    std::atomic<bool> run;
+    std::atomic<audio_readahead*> busy;     // Stream the task is reading for
+
+    std::atomic<uint32_t> reads;
+    std::atomic<uint64_t> bytes_read;
+    std::atomic<uint32_t> worst_read_us;
+    std::atomic<uint32_t> stalls;
+    std::atomic<uint32_t> worst_stall_us;
+    std::atomic<uint32_t> max_drain_percent;  // 100 - lowest fill, so zero means untouched
+} g_ra;
+
+static void lock(hal_mutex_t mutex) {
+    if (mutex) hal_system_take_mutex(mutex, UINT32_MAX);
+}
+
+static void unlock(hal_mutex_t mutex) {
+    if (mutex) hal_system_give_mutex(mutex);
+}
+
+static void raise_to(std::atomic<uint32_t>& value, uint32_t x) {
+    uint32_t seen = value.load(std::memory_order_relaxed);
+    while (x > seen && !value.compare_exchange_weak(seen, x, std::memory_order_relaxed)) {
+    }
+}
+
+static void wake_task(void) {
+    if (g_ra.wake) hal_system_give_semaphore(g_ra.wake);
+}
+
+// Reads the next chunk of one stream; false when it is full or finished
+static bool readahead_fill(audio_readahead_t* ra) {
+    lock(ra->lock);
+    if (!ra->file || ra->eof.load() || ra->filled.load() >= ra->chunks) {
+        unlock(ra->lock);
+        return false;
+    }
+    const uint32_t slot = ra->write_slot;
+    const uint64_t offset = ra->next_offset;
+    const uint32_t generation = ra->generation;
+    unlock(ra->lock);
+
+    // The slot is outside the filled range, so the decoder is not reading it
+    uint64_t start = hal_system_get_time_us();
+    bool positioned = ra->file_pos == offset || hal_storage_seek(ra->file, (int64_t)offset, HAL_STORAGE_SEEK_SET);
+    uint32_t got = positioned ? (uint32_t)hal_storage_read(ra->file, ra->pool + (size_t)slot * ra->chunk_bytes,
+                                                           ra->chunk_bytes) : 0;
+    ra->file_pos = positioned ? offset + got : UINT64_MAX;
+    uint32_t elapsed = (uint32_t)(hal_system_get_time_us() - start);
+    g_ra.reads.fetch_add(1, std::memory_order_relaxed);
+    g_ra.bytes_read.fetch_add(got, std::memory_order_relaxed);
+    raise_to(g_ra.worst_read_us, elapsed);
+
+    lock(ra->lock);
+    if (generation == ra->generation) {
+        ra->chunk[slot].offset = offset;
+        ra->chunk[slot].bytes = got;
+        ra->write_slot = (slot + 1) % ra->chunks;
+        ra->next_offset = offset + got;
+        if (got < ra->chunk_bytes) ra->eof = true;
+        if (got > 0) ra->filled.fetch_add(1, std::memory_order_release);
+    }
+    unlock(ra->lock);
+    if (ra->data_ready) hal_system_give_semaphore(ra->data_ready);
+    return true;
+}
+
+static void readahead_task(void* parameters) {
+    (void)parameters;
+    uint32_t first = 0;
+    while (g_ra.run.load()) {
+        // One chunk per stream per pass, starting from a different one each time
+        bool worked = false;
+        for (uint32_t i = 0; i < AUDIO_READAHEAD_MAX_STREAMS; i++) {
+            audio_readahead_t* ra = &g_ra.slots[(first + i) % AUDIO_READAHEAD_MAX_STREAMS];
+            lock(g_ra.lock);
+            bool open = ra->in_use;
+            if (open) g_ra.busy = ra;
+            unlock(g_ra.lock);
+            if (!open) continue;
+            worked |= readahead_fill(ra);
+            g_ra.busy = nullptr;
+        }
+        first = (first + 1) % AUDIO_READAHEAD_MAX_STREAMS;
+        if (!worked) hal_system_take_semaphore(g_ra.wake, 100);
+    }
+
+    hal_system_give_semaphore(g_ra.task_done);
+    hal_system_delete_task(nullptr);
+}
+
+// The decoder is done with the oldest chunk: hand it back to the filler
+static void readahead_next_chunk(audio_readahead_t* ra) {
+    ra->read_slot = (ra->read_slot + 1) % ra->chunks;
+    ra->consumed = 0;
+    ra->filled.fetch_sub(1, std::memory_order_release);
+    wake_task();
+}
+
+static void readahead_note_fill(audio_readahead_t* ra, uint32_t filled) {
+    if (filled == ra->chunks) ra->primed = true;
+    if (!ra->primed || ra->eof.load()) return;     // The tail of a file drains by design
+    uint32_t capacity = ra->chunks * ra->chunk_bytes;
+    uint32_t fill = filled * ra->chunk_bytes - ra->consumed;
+    raise_to(g_ra.max_drain_percent, 100 - (uint32_t)((uint64_t)fill * 100 / capacity));
+}
+
+extern "C" {
+
+// Lifecycle
+bool audio_readahead_init(const audio_readahead_config_t* config) {
+    if (g_ra.initialized) return true;
+
+    uint32_t chunk_bytes = config && config->chunk_bytes ? config->chunk_bytes : AUDIO_READAHEAD_DEFAULT_CHUNK;
+    uint32_t chunks = config && config->chunks ? config->chunks : AUDIO_READAHEAD_DEFAULT_CHUNKS;
+    if (chunk_bytes % AUDIO_READAHEAD_ALIGN != 0 || chunks < 2 || chunks > AUDIO_READAHEAD_MAX_CHUNKS) return false;
+    g_ra.chunk_bytes = chunk_bytes;
+    g_ra.chunks = chunks;
+    audio_readahead_reset_stats();
+
+    for (audio_readahead_t& ra : g_ra.slots) {
+        if (ra.pool && (ra.chunk_bytes != chunk_bytes || ra.chunks != chunks)) {
+            hal_system_free(ra.pool);
+            ra.pool = nullptr;
+        }
+        if (!ra.pool) ra.pool = (uint8_t*)hal_system_malloc_psram((size_t)chunk_bytes * chunks);
+        if (!ra.lock) ra.lock = hal_system_create_mutex();
+        if (!ra.data_ready) ra.data_ready = hal_system_create_semaphore(1, 0);
+        ra.chunk_bytes = chunk_bytes;
+        ra.chunks = chunks;
+        if (!ra.pool || !ra.lock || !ra.data_ready) {
+            g_ra.initialized = true;
+            audio_readahead_deinit();
+            return false;
+        }
+    }
+
+    if (config && config->start_task) {
+        g_ra.lock = hal_system_create_mutex();
+        g_ra.wake = hal_system_create_semaphore(1, 0);
+        g_ra.task_done = hal_system_create_semaphore(1, 0);
+        g_ra.run = true;
+        // High priority: the task mostly waits on the card, and a late read is a dropout
+        g_ra.task = g_ra.lock && g_ra.wake && g_ra.task_done
+                  ? hal_system_create_task(readahead_task, "AudioReadAhead", AUDIO_READAHEAD_TASK_STACK,
+                                           nullptr, HAL_TASK_PRIORITY_HIGH)
+                  : nullptr;
+        if (!g_ra.task) {
+            g_ra.initialized = true;
+            audio_readahead_deinit();
+            return false;
+        }
+    }
+    g_ra.initialized = true;
+    return true;
+}
+
+void audio_readahead_deinit(void) {
+    if (!g_ra.initialized) return;
+
+    if (g_ra.task) {
+        g_ra.run = false;
+        wake_task();
+        hal_system_take_semaphore(g_ra.task_done, UINT32_MAX);
+        g_ra.task = nullptr;
+    }
+    if (g_ra.task_done) hal_system_delete_semaphore(g_ra.task_done);
+    if (g_ra.wake) hal_system_delete_semaphore(g_ra.wake);
+    if (g_ra.lock) hal_system_delete_mutex(g_ra.lock);
+    g_ra.task_done = nullptr;
+    g_ra.wake = nullptr;
+    g_ra.lock = nullptr;
+
+    for (audio_readahead_t& ra : g_ra.slots) {
+        if (ra.in_use) audio_readahead_close(&ra);
+        if (ra.pool) hal_system_free(ra.pool);
+        if (ra.lock) hal_system_delete_mutex(ra.lock);
+        if (ra.data_ready) hal_system_delete_semaphore(ra.data_ready);
+        ra.pool = nullptr;
+        ra.lock = nullptr;
+        ra.data_ready = nullptr;
+    }
+    g_ra.initialized = false;
+}
+
+// Streams
+audio_readahead_t* audio_readahead_open(const char* path) {
+    const uint32_t chunk_bytes = g_ra.chunk_bytes ? g_ra.chunk_bytes : AUDIO_READAHEAD_DEFAULT_CHUNK;
+    const uint32_t chunks = g_ra.chunks ? g_ra.chunks : AUDIO_READAHEAD_DEFAULT_CHUNKS;
+
+    // Under the slot lock throughout, so the task never sees a half-open stream
+    lock(g_ra.lock);
+    audio_readahead_t* ra = nullptr;
+    for (audio_readahead_t& slot : g_ra.slots) {
+        if (!slot.in_use) {
+            ra = &slot;
+            break;
+        }
+    }
+    if (ra && ra->pool && (ra->chunk_bytes != chunk_bytes || ra->chunks != chunks)) {
+        hal_system_free(ra->pool);
+        ra->pool = nullptr;
+    }
+    if (ra && !ra->pool) ra->pool = (uint8_t*)hal_system_malloc_psram((size_t)chunk_bytes * chunks);
+    if (ra && !ra->lock) ra->lock = hal_system_create_mutex();
+    if (ra && !ra->data_ready) ra->data_ready = hal_system_create_semaphore(1, 0);
+    hal_storage_file_t file = ra && ra->pool && ra->lock && ra->data_ready
+                            ? hal_storage_open(path, HAL_STORAGE_MODE_READ) : nullptr;
+    if (!file) {
+        unlock(g_ra.lock);
+        return nullptr;
+    }
+
+    ra->chunk_bytes = chunk_bytes;
+    ra->chunks = chunks;
+    ra->file = file;
+    ra->file_size = hal_storage_get_file_size_handle(file);
+    ra->file_pos = 0;
+    while (hal_system_take_semaphore(ra->data_ready, 0)) {
+    }
+    audio_readahead_seek(ra, 0);
+    ra->in_use = true;
+    unlock(g_ra.lock);
+    return ra;
+}
+
+void audio_readahead_close(audio_readahead_t* ra) {
+    if (!ra || !ra->in_use) return;
+    lock(g_ra.lock);
+    ra->in_use = false;
+    unlock(g_ra.lock);
+    // Let a read in flight for this stream finish before the file goes away
+    while (g_ra.busy.load() == ra) hal_system_delay_ms(1);
+
+    lock(ra->lock);
+    if (ra->file) hal_storage_close(ra->file);
+    ra->file = nullptr;
+    ra->generation++;
+    unlock(ra->lock);
+}
+
+bool audio_readahead_seek(audio_readahead_t* ra, uint64_t offset) {
+    if (!ra || !ra->file) return false;
+    if (offset > ra->file_size) offset = ra->file_size;
+    const uint64_t aligned = offset - offset % AUDIO_READAHEAD_ALIGN;
+
+    lock(ra->lock);
+    ra->generation++;
+    ra->filled = 0;
+    ra->write_slot = 0;
+    ra->next_offset = aligned;
+    ra->eof = false;
+    unlock(ra->lock);
+
+    ra->read_slot = 0;
+    ra->consumed = (uint32_t)(offset - aligned);    // Skipped once the first chunk is in
+    ra->position = offset;
+    ra->primed = false;
+    wake_task();
+    return true;
+}
+
+uint64_t audio_readahead_tell(const audio_readahead_t* ra) {
+    return ra ? ra->position : 0;
+}
+
+uint64_t audio_readahead_size(const audio_readahead_t* ra) {
+    return ra ? ra->file_size : 0;
+}
+
+uint32_t audio_readahead_acquire(audio_readahead_t* ra, const uint8_t** data) {
+    if (!ra || !ra->file || !data) return 0;
+
+    for (;;) {
+        uint32_t filled = ra->filled.load(std::memory_order_acquire);
+        if (filled > 0) {
+            const readahead_chunk_t* c = &ra->chunk[ra->read_slot];
+            if (ra->consumed < c->bytes) {
+                readahead_note_fill(ra, filled);
+                *data = ra->pool + (size_t)ra->read_slot * ra->chunk_bytes + ra->consumed;
+                return c->bytes - ra->consumed;
+            }
+            readahead_next_chunk(ra);
+            continue;
+        }
+        if (ra->eof.load()) return 0;
+
+        if (!g_ra.task) {
+            readahead_fill(ra);
+            continue;
+        }
+
+        // Ran dry: wait for the task, and count it if the stream had been full
+        wake_task();
+        uint64_t start = hal_system_get_time_us();
+        bool arrived = hal_system_take_semaphore(ra->data_ready, AUDIO_READAHEAD_TIMEOUT_MS);
+        if (ra->primed) {
+            g_ra.stalls.fetch_add(1, std::memory_order_relaxed);
+            raise_to(g_ra.worst_stall_us, (uint32_t)(hal_system_get_time_us() - start));
+            ra->primed = false;     // One stall per dropout, not per wakeup
+        }
+        if (!arrived && ra->filled.load() == 0) return 0;
+    }
+}
+
+void audio_readahead_release(audio_readahead_t* ra, uint32_t bytes) {
+    if (!ra || ra->filled.load(std::memory_order_acquire) == 0) return;
+    ra->consumed += bytes;
+    ra->position += bytes;
+    if (ra->consumed >= ra->chunk[ra->read_slot].bytes) readahead_next_chunk(ra);
+}
+
+uint32_t audio_readahead_read(audio_readahead_t* ra, void* out, uint32_t bytes) {
+    uint8_t* dst = (uint8_t*)out;
+    uint32_t done = 0;
+    while (done < bytes) {
+        const uint8_t* src = nullptr;
+        uint32_t n = audio_readahead_acquire(ra, &src);
+        if (n == 0) break;
+        if (n > bytes - done) n = bytes - done;
+        memcpy(dst + done, src, n);
+        audio_readahead_release(ra, n);
+        done += n;
+    }
+    return done;
+}
+
+void audio_readahead_get_stats(audio_readahead_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    for (const audio_readahead_t& ra : g_ra.slots) {
+        if (!ra.in_use || !ra.file) continue;
+        uint32_t filled = ra.filled.load();
+        stats->streams++;
+        stats->capacity_bytes += ra.chunks * ra.chunk_bytes;
+        stats->fill_bytes += filled ? filled * ra.chunk_bytes - ra.consumed : 0;
+    }
+    stats->min_fill_percent = 100 - g_ra.max_drain_percent.load();
+    stats->reads = g_ra.reads.load();
+    stats->bytes_read = g_ra.bytes_read.load();
+    stats->worst_read_us = g_ra.worst_read_us.load();
+    stats->stalls = g_ra.stalls.load();
+    stats->worst_stall_us = g_ra.worst_stall_us.load();
+}
+
+void audio_readahead_reset_stats(void) {
+    g_ra.reads = 0;
+    g_ra.bytes_read = 0;
+    g_ra.worst_read_us = 0;
+    g_ra.stalls = 0;
+    g_ra.worst_stall_us = 0;
+    g_ra.max_drain_percent = 0;
+}
+
+} // extern "C"
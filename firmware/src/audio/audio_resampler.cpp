@@ -0,0 +1,264 @@
+/*
+ * Audio Resampler Implementation
+ * Rational polyphase conversion with a Kaiser-windowed sinc per phase
+ */
+
+#include "audio/audio_resampler.h"
+#include "hal/hal_system.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef PLATFORM_ESP32
+#include <esp_attr.h>
+#define RESAMPLER_HOT IRAM_ATTR
+#else
+#define RESAMPLER_HOT
+#endif
+
+typedef struct {
+    uint32_t taps;
+    float kaiser_beta;
+    float passband;             // Fraction of the lower Nyquist frequency kept flat
+} resampler_tier_t;
+
+static const resampler_tier_t k_tiers[] = {
+    { 16, 7.0f, 0.88f },        // DEFAULT
+    {  8, 5.0f, 0.80f },        // LOW
+    { 16, 7.0f, 0.88f },        // MEDIUM
+    { 32, 9.0f, 0.92f },        // HIGH
+};
+
+static const resampler_tier_t* resampler_tier(audio_resampler_quality_t quality) {
+    if ((unsigned)quality >= sizeof(k_tiers) / sizeof(k_tiers[0])) quality = AUDIO_RESAMPLER_QUALITY_DEFAULT;
+    return &k_tiers[quality];
+}
+
+static uint32_t resampler_gcd(uint32_t a, uint32_t b) {
+    while (b) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Zeroth-order modified Bessel function, for the Kaiser window
+static float resampler_bessel_i0(float x) {
+    float sum = 1.0f, term = 1.0f;
+    const float q = x * x * 0.25f;
+    for (int k = 1; k < 32 && term > sum * 1e-8f; k++) {
+        term *= q / (float)(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+// Fills one Q14 row for output offset frac (0..1) past the window's reference tap
+static void resampler_design_row(int16_t* row, uint32_t taps, float frac, float cutoff, float beta) {
+    float h[AUDIO_RESAMPLER_MAX_TAPS];
+    const float half = (float)(taps / 2);
+    const float i0_beta = resampler_bessel_i0(beta);
+    float sum = 0.0f;
+    for (uint32_t j = 0; j < taps; j++) {
+        float tau = half - 1.0f + frac - (float)j;
+        float x = tau / half;
+        float window = x <= -1.0f || x >= 1.0f ? 0.0f : resampler_bessel_i0(beta * sqrtf(1.0f - x * x)) / i0_beta;
+        float arg = 2.0f * cutoff * tau;
+        float sinc = fabsf(arg) < 1e-6f ? 1.0f : sinf((float)M_PI * arg) / ((float)M_PI * arg);
+        h[j] = 2.0f * cutoff * sinc * window;
+        sum += h[j];
+    }
+
+    // Unity DC gain for every phase, then put the rounding residue on the largest tap
+    const float one = (float)(1 << AUDIO_RESAMPLER_COEF_SHIFT);
+    int32_t total = 0;
+    uint32_t largest = 0;
+    for (uint32_t j = 0; j < taps; j++) {
+        row[j] = (int16_t)lrintf(h[j] / sum * one);
+        total += row[j];
+        if (row[j] > row[largest]) largest = j;
+    }
+    row[largest] = (int16_t)(row[largest] + ((1 << AUDIO_RESAMPLER_COEF_SHIFT) - total));
+}
+
+static bool resampler_design(audio_resampler_t* rs) {
+    const resampler_tier_t* tier = resampler_tier(rs->quality);
+    size_t entries = (size_t)rs->phases * rs->taps;
+    if (entries > rs->coef_capacity) {
+        hal_system_free(rs->coefs);
+        rs->coefs = (int16_t*)hal_system_malloc(entries * sizeof(int16_t));
+        rs->coef_capacity = rs->coefs ? entries : 0;
+        if (!rs->coefs) return false;
+    }
+
+    // Cutoff in cycles per input frame: below the lower of the two Nyquist limits
+    float ratio = rs->out_rate < rs->in_rate ? (float)rs->out_rate / (float)rs->in_rate : 1.0f;
+    float cutoff = 0.5f * tier->passband * ratio;
+    for (uint32_t p = 0; p < rs->phases; p++) {
+        resampler_design_row(rs->coefs + (size_t)p * rs->taps, rs->taps,
+                             (float)p / (float)rs->phases, cutoff, tier->kaiser_beta);
+    }
+    return true;
+}
+
+static inline void resampler_push(audio_resampler_t* rs, int16_t left, int16_t right) {
+    uint32_t pos = rs->history_pos;
+    rs->history[0][pos] = rs->history[0][pos + rs->taps] = left;
+    rs->history[1][pos] = rs->history[1][pos + rs->taps] = right;
+    rs->history_pos = pos + 1 == rs->taps ? 0 : pos + 1;
+}
+
+static inline int16_t resampler_clamp16(int32_t v) {
+    v = v < -32768 ? -32768 : v;
+    return (int16_t)(v > 32767 ? 32767 : v);
+}
+
+// One output frame from the current window
+static RESAMPLER_HOT void resampler_emit(audio_resampler_t* rs, int16_t* out) {
+    uint32_t phase = rs->position;
+    if (rs->phases != rs->step_out) {
+        // Nearest phase; past the last one rounds down, as the window has not moved yet
+        phase = (uint32_t)(((uint64_t)rs->position * rs->phases + rs->step_out / 2) / rs->step_out);
+        if (phase >= rs->phases) phase = rs->phases - 1;
+    }
+    const int16_t* row = rs->coefs + (size_t)phase * rs->taps;
+    const int16_t* left = rs->history[0] + rs->history_pos;
+    const int16_t* right = rs->history[1] + rs->history_pos;
+
+    int32_t acc_l = 1 << (AUDIO_RESAMPLER_COEF_SHIFT - 1);
+    int32_t acc_r = acc_l;
+    for (uint32_t j = 0; j < rs->taps; j++) {
+        acc_l += (int32_t)left[j] * row[j];
+        acc_r += (int32_t)right[j] * row[j];
+    }
+    out[0] = resampler_clamp16(acc_l >> AUDIO_RESAMPLER_COEF_SHIFT);
+    out[1] = resampler_clamp16(acc_r >> AUDIO_RESAMPLER_COEF_SHIFT);
+
+    rs->position += rs->step_in;
+    rs->pending += rs->position / rs->step_out;
+    rs->position %= rs->step_out;
+}
+
+extern "C" {
+
+uint32_t audio_resampler_taps(audio_resampler_quality_t quality, uint32_t in_rate, uint32_t out_rate) {
+    // Downsampling narrows the cutoff, so the window must span proportionally more input
+    uint32_t taps = resampler_tier(quality)->taps;
+    if (out_rate && in_rate > out_rate) taps *= (in_rate + out_rate - 1) / out_rate;
+    return taps < AUDIO_RESAMPLER_MAX_TAPS ? taps : AUDIO_RESAMPLER_MAX_TAPS;
+}
+
+bool audio_resampler_init(audio_resampler_t* rs, uint32_t in_rate, uint32_t out_rate,
+                          audio_resampler_quality_t quality) {
+    if (!rs || in_rate == 0 || out_rate == 0) return false;
+
+    bool redesign = !rs->coefs || rs->in_rate != in_rate || rs->out_rate != out_rate || rs->quality != quality;
+    rs->in_rate = in_rate;
+    rs->out_rate = out_rate;
+    rs->quality = quality;
+    rs->passthrough = in_rate == out_rate;
+    rs->taps = audio_resampler_taps(quality, in_rate, out_rate);
+
+    uint32_t g = resampler_gcd(in_rate, out_rate);
+    rs->step_in = in_rate / g;
+    rs->step_out = out_rate / g;
+    rs->phases = rs->step_out < AUDIO_RESAMPLER_MAX_PHASES ? rs->step_out : AUDIO_RESAMPLER_MAX_PHASES;
+
+    if (!rs->passthrough && redesign && !resampler_design(rs)) {
+        rs->in_rate = 0;
+        return false;
+    }
+    audio_resampler_reset(rs);
+    return true;
+}
+
+bool audio_resampler_reserve(audio_resampler_t* rs, uint32_t out_rate, audio_resampler_quality_t quality) {
+    static const uint32_t standard_rates[] = {
+        8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100, 48000, 88200, 96000, 176400, 192000
+    };
+    if (!rs || out_rate == 0) return false;
+
+    size_t entries = 0;
+    for (uint32_t in_rate : standard_rates) {
+        if (in_rate == out_rate) continue;
+        uint32_t step_out = out_rate / resampler_gcd(in_rate, out_rate);
+        uint32_t phases = step_out < AUDIO_RESAMPLER_MAX_PHASES ? step_out : AUDIO_RESAMPLER_MAX_PHASES;
+        size_t n = (size_t)phases * audio_resampler_taps(quality, in_rate, out_rate);
+        if (n > entries) entries = n;
+    }
+    if (entries <= rs->coef_capacity) return true;
+
+    hal_system_free(rs->coefs);
+    rs->coefs = (int16_t*)hal_system_malloc(entries * sizeof(int16_t));
+    rs->coef_capacity = rs->coefs ? entries : 0;
+    rs->in_rate = 0;                        // The old table is gone: the next init designs
+    return rs->coefs != nullptr;
+}
+
+void audio_resampler_deinit(audio_resampler_t* rs) {
+    if (!rs) return;
+    hal_system_free(rs->coefs);
+    memset(rs, 0, sizeof(*rs));
+}
+
+void audio_resampler_reset(audio_resampler_t* rs) {
+    memset(rs->history, 0, sizeof(rs->history));
+    rs->history_pos = 0;
+    rs->position = 0;
+    // Fill the window up to the tap just past the first output's centre
+    rs->pending = rs->taps / 2 + 1;
+    rs->drain_left = rs->taps / 2;
+}
+
+RESAMPLER_HOT uint32_t audio_resampler_process(audio_resampler_t* rs, const int16_t* in, uint32_t in_frames,
+                                               uint32_t* consumed, int16_t* out, uint32_t out_frames) {
+    if (rs->passthrough) {
+        uint32_t n = in_frames < out_frames ? in_frames : out_frames;
+        memcpy(out, in, (size_t)n * AUDIO_RESAMPLER_CHANNELS * sizeof(int16_t));
+        *consumed = n;
+        return n;
+    }
+
+    uint32_t used = 0, produced = 0;
+    while (produced < out_frames) {
+        while (rs->pending > 0 && used < in_frames) {
+            resampler_push(rs, in[used * 2], in[used * 2 + 1]);
+            used++;
+            rs->pending--;
+        }
+        if (rs->pending > 0) break;
+        resampler_emit(rs, out + (size_t)produced * AUDIO_RESAMPLER_CHANNELS);
+        produced++;
+    }
+    *consumed = used;
+    return produced;
+}
+
+uint32_t audio_resampler_drain(audio_resampler_t* rs, int16_t* out, uint32_t out_frames) {
+    if (rs->passthrough) return 0;
+
+    uint32_t produced = 0;
+    while (produced < out_frames) {
+        while (rs->pending > 0 && rs->drain_left > 0) {
+            resampler_push(rs, 0, 0);
+            rs->drain_left--;
+            rs->pending--;
+        }
+        if (rs->pending > 0) break;
+        resampler_emit(rs, out + (size_t)produced * AUDIO_RESAMPLER_CHANNELS);
+        produced++;
+    }
+    return produced;
+}
+
+uint64_t audio_resampler_output_frames(const audio_resampler_t* rs, uint64_t in_frames) {
+    if (rs->passthrough) return in_frames;
+    return (in_frames * rs->step_out + rs->step_in - 1) / rs->step_in;
+}
+
+} // extern "C"
@@ -0,0 +1,214 @@
+/*
+ * Audio Ring Buffer Implementation
+ * Lock-free SPSC frame ring shared by ESP32 and host audio backends
+ */
+
+#include "audio/audio_ring_buffer.h"
+#include "hal/hal_system.h"
+
+#include <string.h>
+
+static uint32_t round_up_pow2(uint32_t v) {
+    if (v < 2) return 2;
+    v--;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    return v + 1;
+}
+
+static void ring_clear_state(audio_ring_t* ring) {
+    ring->write_index.store(0, std::memory_order_relaxed);
+    ring->read_index.store(0, std::memory_order_relaxed);
+    ring->stream_active.store(false, std::memory_order_relaxed);
+    ring->consumer_starved = false;
+    audio_ring_reset_stats(ring);
+}
+
+// Lifecycle
+bool audio_ring_init(audio_ring_t* ring, uint32_t capacity_frames, bool prefer_psram) {
+    if (!ring || capacity_frames == 0 || capacity_frames > 0x40000000u) return false;
+
+    uint32_t frames = round_up_pow2(capacity_frames);
+    size_t bytes = (size_t)frames * AUDIO_RING_CHANNELS * sizeof(int16_t);
+    int16_t* storage = (int16_t*)(prefer_psram ? hal_system_malloc_psram(bytes) : hal_system_malloc(bytes));
+    if (!storage) return false;
+
+    memset(storage, 0, bytes);
+    if (!audio_ring_init_with_storage(ring, storage, frames)) {
+        hal_system_free(storage);
+        return false;
+    }
+    ring->owns_storage = true;
+    return true;
+}
+
+bool audio_ring_init_with_storage(audio_ring_t* ring, int16_t* storage, uint32_t capacity_frames) {
+    if (!ring || !storage) return false;
+    if (capacity_frames < 2 || (capacity_frames & (capacity_frames - 1)) != 0) return false;
+
+    ring->samples = storage;
+    ring->capacity_frames = capacity_frames;
+    ring->mask = capacity_frames - 1;
+    ring->owns_storage = false;
+    ring_clear_state(ring);
+    return true;
+}
+
+void audio_ring_deinit(audio_ring_t* ring) {
+    if (!ring) return;
+    if (ring->owns_storage && ring->samples) {
+        hal_system_free(ring->samples);
+    }
+    ring->samples = nullptr;
+    ring->capacity_frames = 0;
+    ring->mask = 0;
+    ring->owns_storage = false;
+    ring_clear_state(ring);
+}
+
+void audio_ring_reset(audio_ring_t* ring) {
+    if (!ring) return;
+    ring->read_index.store(0, std::memory_order_relaxed);
+    ring->write_index.store(0, std::memory_order_relaxed);
+    ring->stream_active.store(false, std::memory_order_relaxed);
+    ring->consumer_starved = false;
+}
+
+void audio_ring_reset_stats(audio_ring_t* ring) {
+    if (!ring) return;
+    ring->overruns.store(0, std::memory_order_relaxed);
+    ring->underruns.store(0, std::memory_order_relaxed);
+    ring->frames_dropped.store(0, std::memory_order_relaxed);
+    ring->frames_padded.store(0, std::memory_order_relaxed);
+}
+
+// Occupancy
+uint32_t audio_ring_used_frames(const audio_ring_t* ring) {
+    if (!ring || !ring->samples) return 0;
+    uint32_t w = ring->write_index.load(std::memory_order_acquire);
+    uint32_t r = ring->read_index.load(std::memory_order_acquire);
+    return w - r;
+}
+
+uint32_t audio_ring_free_frames(const audio_ring_t* ring) {
+    if (!ring || !ring->samples) return 0;
+    return ring->capacity_frames - audio_ring_used_frames(ring);
+}
+
+// Producer side
+uint32_t audio_ring_acquire_write(audio_ring_t* ring, int16_t** region) {
+    if (!ring || !ring->samples || !region) return 0;
+    uint32_t w = ring->write_index.load(std::memory_order_relaxed);
+    uint32_t r = ring->read_index.load(std::memory_order_acquire);
+    uint32_t free_frames = ring->capacity_frames - (w - r);
+    uint32_t offset = w & ring->mask;
+    uint32_t contiguous = ring->capacity_frames - offset;
+    *region = ring->samples + (size_t)offset * AUDIO_RING_CHANNELS;
+    return free_frames < contiguous ? free_frames : contiguous;
+}
+
+void audio_ring_commit_write(audio_ring_t* ring, uint32_t frame_count) {
+    if (!ring || frame_count == 0) return;
+    uint32_t w = ring->write_index.load(std::memory_order_relaxed);
+    ring->stream_active.store(true, std::memory_order_relaxed);
+    ring->write_index.store(w + frame_count, std::memory_order_release);
+}
+
+uint32_t audio_ring_write(audio_ring_t* ring, const int16_t* frames, uint32_t frame_count) {
+    if (!ring || !ring->samples || !frames) return 0;
+
+    uint32_t written = 0;
+    while (written < frame_count) {
+        int16_t* region = nullptr;
+        uint32_t n = audio_ring_acquire_write(ring, &region);
+        if (n == 0) break;
+        if (n > frame_count - written) n = frame_count - written;
+        memcpy(region, frames + (size_t)written * AUDIO_RING_CHANNELS,
+               (size_t)n * AUDIO_RING_CHANNELS * sizeof(int16_t));
+        audio_ring_commit_write(ring, n);
+        written += n;
+    }
+    if (written < frame_count) {
+        ring->overruns.fetch_add(1, std::memory_order_relaxed);
+        ring->frames_dropped.fetch_add(frame_count - written, std::memory_order_relaxed);
+    }
+    return written;
+}
+
+bool audio_ring_write_all(audio_ring_t* ring, const int16_t* frames, uint32_t frame_count) {
+    if (!ring || !ring->samples || !frames) return false;
+    if (audio_ring_free_frames(ring) < frame_count) {
+        ring->overruns.fetch_add(1, std::memory_order_relaxed);
+        ring->frames_dropped.fetch_add(frame_count, std::memory_order_relaxed);
+        return false;
+    }
+    return audio_ring_write(ring, frames, frame_count) == frame_count;
+}
+
+void audio_ring_end_stream(audio_ring_t* ring) {
+    if (!ring) return;
+    ring->stream_active.store(false, std::memory_order_relaxed);
+}
+
+// Consumer side
+uint32_t audio_ring_acquire_read(audio_ring_t* ring, const int16_t** region) {
+    if (!ring || !ring->samples || !region) return 0;
+    uint32_t r = ring->read_index.load(std::memory_order_relaxed);
+    uint32_t w = ring->write_index.load(std::memory_order_acquire);
+    uint32_t used = w - r;
+    uint32_t offset = r & ring->mask;
+    uint32_t contiguous = ring->capacity_frames - offset;
+    *region = ring->samples + (size_t)offset * AUDIO_RING_CHANNELS;
+    return used < contiguous ? used : contiguous;
+}
+
+void audio_ring_commit_read(audio_ring_t* ring, uint32_t frame_count) {
+    if (!ring || frame_count == 0) return;
+    uint32_t r = ring->read_index.load(std::memory_order_relaxed);
+    ring->read_index.store(r + frame_count, std::memory_order_release);
+    ring->consumer_starved = false;
+}
+
+uint32_t audio_ring_read(audio_ring_t* ring, int16_t* out, uint32_t frame_count) {
+    if (!ring || !ring->samples || !out) return 0;
+
+    uint32_t got = 0;
+    while (got < frame_count) {
+        const int16_t* region = nullptr;
+        uint32_t n = audio_ring_acquire_read(ring, &region);
+        if (n == 0) break;
+        if (n > frame_count - got) n = frame_count - got;
+        memcpy(out + (size_t)got * AUDIO_RING_CHANNELS, region,
+               (size_t)n * AUDIO_RING_CHANNELS * sizeof(int16_t));
+        audio_ring_commit_read(ring, n);
+        got += n;
+    }
+    return got;
+}
+
+uint32_t audio_ring_read_padded(audio_ring_t* ring, int16_t* out, uint32_t frame_count) {
+    if (!ring || !out) return 0;
+    uint32_t got = audio_ring_read(ring, out, frame_count);
+    if (got < frame_count) {
+        memset(out + (size_t)got * AUDIO_RING_CHANNELS, 0,
+               (size_t)(frame_count - got) * AUDIO_RING_CHANNELS * sizeof(int16_t));
+        audio_ring_note_starved(ring, frame_count - got);
+    }
+    return got;
+}
+
+void audio_ring_note_starved(audio_ring_t* ring, uint32_t padded_frames) {
+    if (!ring || padded_frames == 0) return;
+    // Count one underrun per dropout, not one per padded period, and only while
+    // the producer still claims to be streaming (end of track is not a dropout).
+    if (ring->stream_active.load(std::memory_order_relaxed)) {
+        ring->frames_padded.fetch_add(padded_frames, std::memory_order_relaxed);
+        if (!ring->consumer_starved) {
+            ring->underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    ring->consumer_starved = true;
+}
@@ -0,0 +1,316 @@
+/*
+ * Audio Synth Implementation
+ * Band-limited wavetable oscillators with linear ADSR, mixed in 32 bits
+ */
+
+#include "audio/audio_synth.h"
+#include "audio/audio_dsp.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifdef PLATFORM_ESP32
+#include <esp_attr.h>
+#define SYNTH_HOT IRAM_ATTR
+#else
+#define SYNTH_HOT
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SYNTH_TABLE_STRIDE  (AUDIO_SYNTH_TABLE_SIZE + 1)    // Guard point for interpolation
+#define SYNTH_TABLE_COUNT   (1 + (AUDIO_SYNTH_WAVEFORMS - 1) * AUDIO_SYNTH_OCTAVES)
+#define SYNTH_TABLE_PEAK    32000.0
+#define SYNTH_INDEX_SHIFT   (32 - AUDIO_SYNTH_TABLE_BITS)
+#define SYNTH_FRAC_SHIFT    (SYNTH_INDEX_SHIFT - 15)        // Phase bits below the index, as Q15
+
+// Amplitude of harmonic n (1-based) in a waveform's Fourier series
+static double synth_harmonic(audio_synth_waveform_t waveform, uint32_t n) {
+    switch (waveform) {
+        case AUDIO_SYNTH_SQUARE:   return (n & 1) ? 1.0 / n : 0.0;
+        case AUDIO_SYNTH_SAW:      return ((n & 1) ? 1.0 : -1.0) / n;
+        case AUDIO_SYNTH_TRIANGLE: return (n & 1) ? (((n >> 1) & 1) ? -1.0 : 1.0) / ((double)n * n) : 0.0;
+        default:                   return n == 1 ? 1.0 : 0.0;
+    }
+}
+
+// One cycle from harmonics 1..harmonics, Lanczos-smoothed against Gibbs
+// ringing and normalized to SYNTH_TABLE_PEAK
+static void synth_build_table(int16_t* table, audio_synth_waveform_t waveform, uint32_t harmonics) {
+    double cycle[AUDIO_SYNTH_TABLE_SIZE];
+    double peak = 0.0;
+    for (uint32_t i = 0; i < AUDIO_SYNTH_TABLE_SIZE; i++) {
+        double x = 2.0 * M_PI * i / AUDIO_SYNTH_TABLE_SIZE;
+        double sum = 0.0;
+        for (uint32_t n = 1; n <= harmonics; n++) {
+            double a = synth_harmonic(waveform, n);
+            if (a == 0.0) continue;
+            double sigma = n > 1 ? sin(M_PI * n / (harmonics + 1)) / (M_PI * n / (harmonics + 1)) : 1.0;
+            sum += a * sigma * sin(n * x);
+        }
+        cycle[i] = sum;
+        if (fabs(sum) > peak) peak = fabs(sum);
+    }
+    double scale = peak > 0.0 ? SYNTH_TABLE_PEAK / peak : 0.0;
+    for (uint32_t i = 0; i < AUDIO_SYNTH_TABLE_SIZE; i++) {
+        table[i] = (int16_t)lrint(cycle[i] * scale);
+    }
+    table[AUDIO_SYNTH_TABLE_SIZE] = table[0];
+}
+
+static const int16_t* synth_table(const audio_synth_t* synth, audio_synth_waveform_t waveform, uint32_t octave) {
+    size_t index = waveform == AUDIO_SYNTH_SINE ? 0 : 1 + (size_t)(waveform - 1) * AUDIO_SYNTH_OCTAVES + octave;
+    return synth->tables + index * SYNTH_TABLE_STRIDE;
+}
+
+static uint32_t synth_ms_to_frames(const audio_synth_t* synth, uint32_t ms) {
+    return (uint32_t)((uint64_t)ms * synth->sample_rate / 1000);
+}
+
+// Voice for a new note: a free one, else the quietest releasing one, else the
+// quietest sounding one; a note still waiting to start goes last
+static audio_synth_voice_t* synth_pick_voice(audio_synth_t* synth) {
+    audio_synth_voice_t* best = nullptr;
+    uint64_t best_key = UINT64_MAX;
+    for (uint32_t i = 0; i < synth->max_voices; i++) {
+        audio_synth_voice_t* voice = &synth->voices[i];
+        if (voice->stage == AUDIO_SYNTH_STAGE_OFF) return voice;
+        uint64_t rank = voice->stage == AUDIO_SYNTH_STAGE_RELEASE ? 0
+                      : voice->stage == AUDIO_SYNTH_STAGE_DELAY ? 2 : 1;
+        uint64_t key = rank << 32 | (uint32_t)voice->level;
+        if (key < best_key) {
+            best_key = key;
+            best = voice;
+        }
+    }
+    synth->voice_steals++;
+    return best;
+}
+
+static void synth_start_note(audio_synth_t* synth, const audio_synth_note_t* note) {
+    audio_synth_voice_t* voice = synth_pick_voice(synth);
+    if (!voice) return;
+    if (voice->stage == AUDIO_SYNTH_STAGE_OFF) synth->active_voices++;
+
+    uint32_t nyquist = synth->sample_rate / 2;
+    uint32_t hz = note->frequency_hz < nyquist ? note->frequency_hz : nyquist - 1;
+    voice->phase_inc = (uint32_t)(((uint64_t)hz << 32) / synth->sample_rate);
+    uint32_t octave = 0;
+    while (octave < AUDIO_SYNTH_OCTAVES - 1 && voice->phase_inc > synth->octave_inc[octave]) octave++;
+    audio_synth_waveform_t waveform = note->waveform < AUDIO_SYNTH_WAVEFORMS ? note->waveform : AUDIO_SYNTH_SINE;
+    voice->table = synth_table(synth, waveform, octave);
+    voice->phase = 0;
+
+    int32_t pan = note->pan < -100 ? -100 : (note->pan > 100 ? 100 : note->pan);
+    int32_t volume_q15 = audio_dsp_gain_from_percent(note->volume);
+    voice->gain_left_q15 = (volume_q15 * audio_dsp_fade_gain_q15((uint32_t)(100 - pan), 200)) >> 15;
+    voice->gain_right_q15 = (volume_q15 * audio_dsp_fade_gain_q15((uint32_t)(100 + pan), 200)) >> 15;
+
+    uint32_t sustain = note->sustain < 100 ? note->sustain : 100;
+    voice->sustain_level = (int32_t)((uint64_t)AUDIO_SYNTH_LEVEL_ONE * sustain / 100);
+    voice->attack_frames = synth_ms_to_frames(synth, note->attack_ms);
+    voice->decay_frames = synth_ms_to_frames(synth, note->decay_ms);
+    uint32_t envelope = voice->attack_frames + voice->decay_frames;
+    uint32_t duration = synth_ms_to_frames(synth, note->duration_ms);
+    voice->sustain_frames = duration > envelope ? duration - envelope : 0;
+    voice->release_frames = synth_ms_to_frames(synth, note->release_ms);
+
+    voice->stage = AUDIO_SYNTH_STAGE_DELAY;
+    voice->stage_frames = synth_ms_to_frames(synth, note->delay_ms);
+    voice->level = 0;
+    voice->step = 0;
+}
+
+// Moves a voice whose stage has run out into the next one. Each stage ends
+// exactly on its target level, so the rounding of its step never accumulates.
+static void synth_next_stage(audio_synth_t* synth, audio_synth_voice_t* voice) {
+    switch (voice->stage) {
+        case AUDIO_SYNTH_STAGE_DELAY:
+            voice->stage = AUDIO_SYNTH_STAGE_ATTACK;
+            voice->stage_frames = voice->attack_frames;
+            voice->level = 0;
+            voice->step = voice->attack_frames ? AUDIO_SYNTH_LEVEL_ONE / (int32_t)voice->attack_frames : 0;
+            break;
+        case AUDIO_SYNTH_STAGE_ATTACK:
+            voice->stage = AUDIO_SYNTH_STAGE_DECAY;
+            voice->stage_frames = voice->decay_frames;
+            voice->level = AUDIO_SYNTH_LEVEL_ONE;
+            voice->step = voice->decay_frames
+                        ? -(AUDIO_SYNTH_LEVEL_ONE - voice->sustain_level) / (int32_t)voice->decay_frames : 0;
+            break;
+        case AUDIO_SYNTH_STAGE_DECAY:
+            voice->stage = AUDIO_SYNTH_STAGE_SUSTAIN;
+            voice->stage_frames = voice->sustain_frames;
+            voice->level = voice->sustain_level;
+            voice->step = 0;
+            break;
+        case AUDIO_SYNTH_STAGE_SUSTAIN:
+            voice->stage = AUDIO_SYNTH_STAGE_RELEASE;
+            voice->stage_frames = voice->release_frames;
+            voice->step = voice->release_frames ? -voice->level / (int32_t)voice->release_frames : 0;
+            break;
+        default:
+            voice->stage = AUDIO_SYNTH_STAGE_OFF;
+            voice->level = 0;
+            synth->active_voices--;
+            break;
+    }
+}
+
+// frames of one voice added to mix along a straight envelope segment
+static SYNTH_HOT void synth_oscillate(audio_synth_voice_t* voice, int32_t* __restrict__ mix, uint32_t frames,
+                                      int32_t gain_left_q15, int32_t gain_right_q15) {
+    const int16_t* __restrict__ table = voice->table;
+    uint32_t phase = voice->phase;
+    const uint32_t phase_inc = voice->phase_inc;
+    int32_t level = voice->level;
+    const int32_t step = voice->step;
+    for (uint32_t i = 0; i < frames; i++) {
+        const uint32_t index = phase >> SYNTH_INDEX_SHIFT;
+        const int32_t frac = (int32_t)((phase >> SYNTH_FRAC_SHIFT) & 0x7FFF);
+        const int32_t a = table[index];
+        const int32_t s = a + (((table[index + 1] - a) * frac) >> 15);
+        const int32_t v = (s * (level >> 15)) >> 15;
+        mix[2 * i] += (v * gain_left_q15) >> 15;
+        mix[2 * i + 1] += (v * gain_right_q15) >> 15;
+        phase += phase_inc;
+        level += step;
+    }
+    voice->phase = phase;
+    voice->level = level;
+}
+
+static void synth_render_voice(audio_synth_t* synth, audio_synth_voice_t* voice, int32_t* mix, uint32_t frames,
+                               int32_t gain_q15) {
+    const int32_t left_q15 = (voice->gain_left_q15 * gain_q15) >> 15;
+    const int32_t right_q15 = (voice->gain_right_q15 * gain_q15) >> 15;
+    uint32_t done = 0;
+    while (done < frames && voice->stage != AUDIO_SYNTH_STAGE_OFF) {
+        if (voice->stage_frames == 0) {
+            synth_next_stage(synth, voice);
+            continue;
+        }
+        uint32_t n = frames - done < voice->stage_frames ? frames - done : voice->stage_frames;
+        if (voice->stage != AUDIO_SYNTH_STAGE_DELAY) {
+            synth_oscillate(voice, mix + (size_t)done * 2, n, left_q15, right_q15);
+        }
+        voice->stage_frames -= n;
+        done += n;
+    }
+}
+
+extern "C" {
+
+bool audio_synth_init(audio_synth_t* synth, uint32_t sample_rate, uint32_t max_voices) {
+    if (!synth || sample_rate == 0) return false;
+    synth->sample_rate = sample_rate;
+    synth->max_voices = max_voices ? max_voices : AUDIO_SYNTH_DEFAULT_VOICES;
+    if (synth->max_voices > AUDIO_SYNTH_MAX_VOICES) synth->max_voices = AUDIO_SYNTH_MAX_VOICES;
+    synth->tables = (int16_t*)hal_system_malloc((size_t)SYNTH_TABLE_COUNT * SYNTH_TABLE_STRIDE * sizeof(int16_t));
+    synth->lock = hal_system_create_mutex();
+    if (!synth->tables || !synth->lock) {
+        audio_synth_deinit(synth);
+        return false;
+    }
+
+    // Table k is clean up to LOWEST << k: it holds the harmonics that stay below
+    // Nyquist there, and never more than half the table can represent
+    synth_build_table(synth->tables, AUDIO_SYNTH_SINE, 1);
+    for (uint32_t octave = 0; octave < AUDIO_SYNTH_OCTAVES; octave++) {
+        uint32_t top_hz = AUDIO_SYNTH_LOWEST_OCTAVE_HZ << octave;
+        uint32_t harmonics = sample_rate / 2 / top_hz;
+        if (harmonics > AUDIO_SYNTH_TABLE_SIZE / 2 - 1) harmonics = AUDIO_SYNTH_TABLE_SIZE / 2 - 1;
+        if (harmonics == 0) harmonics = 1;
+        for (int w = AUDIO_SYNTH_SQUARE; w < AUDIO_SYNTH_WAVEFORMS; w++) {
+            synth_build_table((int16_t*)synth_table(synth, (audio_synth_waveform_t)w, octave),
+                              (audio_synth_waveform_t)w, harmonics);
+        }
+        synth->octave_inc[octave] = (uint32_t)(((uint64_t)top_hz << 32) / sample_rate);
+    }
+
+    memset(synth->voices, 0, sizeof(synth->voices));
+    synth->active_voices = 0;
+    synth->voice_steals = 0;
+    synth->queue_write = 0;
+    synth->queue_read = 0;
+    return true;
+}
+
+void audio_synth_deinit(audio_synth_t* synth) {
+    if (!synth) return;
+    if (synth->lock) {
+        hal_system_delete_mutex(synth->lock);
+        synth->lock = nullptr;
+    }
+    hal_system_free(synth->tables);
+    synth->tables = nullptr;
+    synth->active_voices = 0;
+}
+
+bool audio_synth_post(audio_synth_t* synth, const audio_synth_note_t* notes, size_t count) {
+    if (!synth || !synth->tables || !notes || count == 0) return false;
+    if (!hal_system_take_mutex(synth->lock, UINT32_MAX)) return false;
+    uint32_t write = synth->queue_write.load(std::memory_order_relaxed);
+    uint32_t read = synth->queue_read.load(std::memory_order_acquire);
+    bool fits = count <= AUDIO_SYNTH_QUEUE_LENGTH - (write - read);
+    if (fits) {
+        for (size_t i = 0; i < count; i++) {
+            synth->queue[(write + i) % AUDIO_SYNTH_QUEUE_LENGTH] = notes[i];
+        }
+        // One store publishes the whole call, so its notes start in the same block
+        synth->queue_write.store(write + (uint32_t)count, std::memory_order_release);
+    }
+    hal_system_give_mutex(synth->lock);
+    return fits;
+}
+
+void audio_synth_render(audio_synth_t* synth, int16_t* out, uint32_t frames, int32_t gain_q15) {
+    uint32_t read = synth->queue_read.load(std::memory_order_relaxed);
+    uint32_t write = synth->queue_write.load(std::memory_order_acquire);
+    for (; read != write; read++) {
+        synth_start_note(synth, &synth->queue[read % AUDIO_SYNTH_QUEUE_LENGTH]);
+    }
+    synth->queue_read.store(read, std::memory_order_release);
+
+    while (frames > 0 && synth->active_voices > 0) {
+        uint32_t n = frames < AUDIO_SYNTH_CHUNK_FRAMES ? frames : AUDIO_SYNTH_CHUNK_FRAMES;
+        memset(synth->mix, 0, (size_t)n * 2 * sizeof(int32_t));
+        for (uint32_t i = 0; i < synth->max_voices; i++) {
+            if (synth->voices[i].stage != AUDIO_SYNTH_STAGE_OFF) {
+                synth_render_voice(synth, &synth->voices[i], synth->mix, n, gain_q15);
+            }
+        }
+        audio_dsp_mix_s32_sat(out, synth->mix, (size_t)n * 2);
+        out += (size_t)n * 2;
+        frames -= n;
+    }
+}
+
+bool audio_synth_is_active(const audio_synth_t* synth) {
+    return synth->active_voices > 0 ||
+           synth->queue_read.load(std::memory_order_relaxed) != synth->queue_write.load(std::memory_order_acquire);
+}
+
+void audio_synth_stop_all(audio_synth_t* synth) {
+    for (uint32_t i = 0; i < AUDIO_SYNTH_MAX_VOICES; i++) {
+        synth->voices[i].stage = AUDIO_SYNTH_STAGE_OFF;
+        synth->voices[i].level = 0;
+    }
+    synth->active_voices = 0;
+    synth->queue_read.store(synth->queue_write.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+void audio_synth_note_beep(audio_synth_note_t* note, uint32_t frequency_hz, uint32_t duration_ms) {
+    memset(note, 0, sizeof(*note));
+    note->waveform = AUDIO_SYNTH_SINE;
+    note->frequency_hz = frequency_hz;
+    note->volume = 50;
+    note->duration_ms = duration_ms;
+    note->attack_ms = 5;
+    note->sustain = 100;
+    note->release_ms = 20;
+}
+
+} // extern "C"
@@ -5,4 +5,3 @@ bool mp3StartFirstUnderMusic();
 bool mp3StartFile(const char* path);
 void mp3Stop();
 bool mp3IsPlaying();
-void mp3EnsureTask();
@@ -0,0 +1,395 @@
+/*
+ * ESP32 Hardware Abstraction Layer - Audio Implementation
+ * PCM5102A over I2S, fed by a single feeder task draining a lock-free PCM ring
+ */
+
+#include "hal/hal_audio.h"
+#include "hardware_config.h"
+
+#ifdef PLATFORM_ESP32
+
+#include <Arduino.h>
+#include <driver/i2s.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
+#include <esp_timer.h>
+#include <atomic>
+#include "audio/audio_ring_buffer.h"
+#include "audio/audio_deadline.h"
+
+// I2S pin mapping, as wired in docs/plans/izod_mini_plan.md (overridable from build flags)
+#ifndef I2S_BCLK
+#define I2S_BCLK 39
+#endif
+#ifndef I2S_WS
+#define I2S_WS 38
+#endif
+#ifndef I2S_DATA
+#define I2S_DATA 11
+#endif
+#define HAL_AUDIO_PIN_BCK   I2S_BCLK
+#define HAL_AUDIO_PIN_WS    I2S_WS
+#define HAL_AUDIO_PIN_DATA  I2S_DATA
+
+#define HAL_AUDIO_I2S_PORT          I2S_NUM_0
+#define HAL_AUDIO_DMA_FRAMES        256     // Frames per DMA buffer and per feeder write
+#define HAL_AUDIO_FEEDER_STACK      3072
+#define HAL_AUDIO_FEEDER_PRIORITY   (configMAX_PRIORITIES - 2)
+#define HAL_AUDIO_FEEDER_CORE       0
+
+// Audio state
+static bool g_initialized = false;
+static hal_audio_config_t g_config;
+static hal_audio_error_t g_last_error = HAL_AUDIO_ERROR_NONE;
+
+// Ring and feeder
+static audio_ring_t g_ring;
+static TaskHandle_t g_feeder_task = nullptr;
+static SemaphoreHandle_t g_space_sem = nullptr;   // Given by the feeder after each DMA write
+static volatile bool g_feeder_run = false;
+static std::atomic<bool> g_flush_request(false);  // Consumer discards queued frames when set
+static std::atomic<uint32_t> g_frames_played(0);
+
+// Playback clock (written by the feeder only)
+static QueueHandle_t g_i2s_events = nullptr;        // One I2S_EVENT_TX_DONE per finished DMA buffer
+static std::atomic<uint32_t> g_clock_frames(0);     // Frames the DAC has finished
+static uint32_t g_dma_pending = 0;                  // Handed to DMA, not yet finished
+static audio_deadline_t g_deadline;                 // Refill timing, recorded by the feeder
+
+// Moves finished DMA buffers onto the clock. Writes fill the buffers back to
+// back, so each completion is one buffer's worth of what is pending. After an
+// underrun the auto-cleared buffers ahead of new data complete first, which
+// puts the clock up to a DMA queue early until that silence has played.
+static void feeder_collect_completions(void) {
+    i2s_event_t event;
+    while (xQueueReceive(g_i2s_events, &event, 0) == pdTRUE) {
+        if (event.type != I2S_EVENT_TX_DONE || g_dma_pending == 0) continue;
+        uint32_t done = g_dma_pending < HAL_AUDIO_DMA_FRAMES ? g_dma_pending : HAL_AUDIO_DMA_FRAMES;
+        g_dma_pending -= done;
+        g_clock_frames.fetch_add(done, std::memory_order_release);
+    }
+}
+
+static void feeder_discard_queued(void) {
+    const int16_t* region = nullptr;
+    uint32_t frames;
+    uint32_t dropped = g_dma_pending;
+    while ((frames = audio_ring_acquire_read(&g_ring, &region)) > 0) {
+        audio_ring_commit_read(&g_ring, frames);
+        dropped += frames;
+    }
+    i2s_zero_dma_buffer(HAL_AUDIO_I2S_PORT);
+    xQueueReset(g_i2s_events);
+    g_dma_pending = 0;
+    g_clock_frames.fetch_add(dropped, std::memory_order_release);
+}
+
+static void feeder_task(void* parameters) {
+    const TickType_t idle_wait = pdMS_TO_TICKS(50);
+
+    while (g_feeder_run) {
+        feeder_collect_completions();
+        if (g_flush_request.load(std::memory_order_acquire)) {
+            feeder_discard_queued();
+            g_flush_request.store(false, std::memory_order_release);
+            audio_deadline_idle(&g_deadline);
+            xSemaphoreGive(g_space_sem);
+        }
+
+        const int16_t* region = nullptr;
+        uint32_t frames = audio_ring_acquire_read(&g_ring, &region);
+
+        if (frames == 0) {
+            // DMA auto-clears to silence; account the gap and sleep until a producer writes
+            audio_ring_note_starved(&g_ring, HAL_AUDIO_DMA_FRAMES);
+            // A starved live stream keeps its deadline clock running; an ended one restarts it
+            if (!g_ring.stream_active.load(std::memory_order_relaxed)) audio_deadline_idle(&g_deadline);
+            // Wake every tick while DMA still plays, so the clock follows it out
+            ulTaskNotifyTake(pdTRUE, g_dma_pending ? 1 : idle_wait);
+            continue;
+        }
+
+        if (frames > HAL_AUDIO_DMA_FRAMES) frames = HAL_AUDIO_DMA_FRAMES;
+
+        // Slack is what the DAC can still play before this refill lands: what
+        // DMA holds plus the ring behind it. With nothing left in DMA it has
+        // already fallen back to auto-cleared silence.
+        audio_deadline_record(&g_deadline, (uint64_t)esp_timer_get_time(),
+                              g_dma_pending + audio_ring_used_frames(&g_ring), g_dma_pending == 0);
+
+        // Straight from the ring, no staging copy of our own: i2s_write copies the
+        // region into the driver's DMA buffers before it returns, so the ring
+        // never has to be DMA-capable memory and its slots free right after.
+        // Blocks until a DMA buffer frees up.
+        size_t bytes_written = 0;
+        i2s_write(HAL_AUDIO_I2S_PORT, region, frames * HAL_AUDIO_CHANNELS * sizeof(int16_t),
+                  &bytes_written, portMAX_DELAY);
+
+        uint32_t consumed = bytes_written / (HAL_AUDIO_CHANNELS * sizeof(int16_t));
+        audio_ring_commit_read(&g_ring, consumed);
+        g_dma_pending += consumed;
+        g_frames_played.fetch_add(consumed, std::memory_order_relaxed);
+        xSemaphoreGive(g_space_sem);
+    }
+
+    g_feeder_task = nullptr;
+    vTaskDelete(NULL);
+}
+
+static bool install_i2s(uint32_t sample_rate) {
+    i2s_config_t i2s_config = {
+        .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_TX),
+        .sample_rate = (int)sample_rate,
+        .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
+        .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT,
+        .communication_format = I2S_COMM_FORMAT_STAND_I2S,
+        .intr_alloc_flags = 0,
+        .dma_buf_count = I2S_BUFFER_COUNT,
+        .dma_buf_len = HAL_AUDIO_DMA_FRAMES,
+        .use_apll = true,
+        .tx_desc_auto_clear = true,
+        .fixed_mclk = 0
+    };
+    i2s_pin_config_t pin_config = {
+        .bck_io_num = HAL_AUDIO_PIN_BCK,
+        .ws_io_num = HAL_AUDIO_PIN_WS,
+        .data_out_num = HAL_AUDIO_PIN_DATA,
+        .data_in_num = I2S_PIN_NO_CHANGE
+    };
+
+    if (i2s_driver_install(HAL_AUDIO_I2S_PORT, &i2s_config, I2S_BUFFER_COUNT * 2, &g_i2s_events) != ESP_OK) {
+        return false;
+    }
+    if (i2s_set_pin(HAL_AUDIO_I2S_PORT, &pin_config) != ESP_OK) {
+        i2s_driver_uninstall(HAL_AUDIO_I2S_PORT);
+        return false;
+    }
+    if (i2s_set_clk(HAL_AUDIO_I2S_PORT, sample_rate, I2S_BITS_PER_SAMPLE_16BIT, I2S_CHANNEL_STEREO) != ESP_OK) {
+        i2s_driver_uninstall(HAL_AUDIO_I2S_PORT);
+        return false;
+    }
+    return true;
+}
+
+extern "C" {
+
+// Audio initialization and control
+bool hal_audio_init(const hal_audio_config_t* config) {
+    if (g_initialized) {
+        return true;
+    }
+
+    if (config) {
+        g_config = *config;
+    } else {
+        g_config.sample_rate = HAL_AUDIO_DEFAULT_SAMPLE_RATE;
+        g_config.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+        g_config.volume = HAL_AUDIO_DEFAULT_VOLUME;
+        g_config.loop = false;
+        g_config.buffer_size = 0;
+    }
+    if (g_config.sample_rate == 0) g_config.sample_rate = HAL_AUDIO_DEFAULT_SAMPLE_RATE;
+
+    uint32_t ring_frames = g_config.buffer_size ? g_config.buffer_size / HAL_AUDIO_CHANNELS
+                                                : HAL_AUDIO_DEFAULT_BUFFER_FRAMES;
+    if (!audio_ring_init(&g_ring, ring_frames, true)) {
+        g_last_error = HAL_AUDIO_ERROR_INIT_FAILED;
+        return false;
+    }
+
+    g_space_sem = xSemaphoreCreateBinary();
+    if (!g_space_sem || !install_i2s(g_config.sample_rate)) {
+        if (g_space_sem) { vSemaphoreDelete(g_space_sem); g_space_sem = nullptr; }
+        audio_ring_deinit(&g_ring);
+        g_last_error = HAL_AUDIO_ERROR_INIT_FAILED;
+        return false;
+    }
+
+    // PCM5102A XSMT high = unmuted
+    if (PCM_XSMT_PIN != -1) {
+        pinMode(PCM_XSMT_PIN, OUTPUT);
+        digitalWrite(PCM_XSMT_PIN, HIGH);
+    }
+
+    g_clock_frames = 0;
+    g_dma_pending = 0;
+    audio_deadline_init(&g_deadline, g_config.sample_rate, HAL_AUDIO_DMA_FRAMES);
+    g_feeder_run = true;
+    if (xTaskCreatePinnedToCore(feeder_task, "AudioFeeder", HAL_AUDIO_FEEDER_STACK, NULL,
+                                HAL_AUDIO_FEEDER_PRIORITY, &g_feeder_task, HAL_AUDIO_FEEDER_CORE) != pdPASS) {
+        g_feeder_run = false;
+        i2s_driver_uninstall(HAL_AUDIO_I2S_PORT);
+        vSemaphoreDelete(g_space_sem);
+        g_space_sem = nullptr;
+        audio_ring_deinit(&g_ring);
+        g_last_error = HAL_AUDIO_ERROR_INIT_FAILED;
+        return false;
+    }
+
+    g_frames_played = 0;
+    g_last_error = HAL_AUDIO_ERROR_NONE;
+    g_initialized = true;
+    return true;
+}
+
+void hal_audio_deinit(void) {
+    if (!g_initialized) {
+        return;
+    }
+
+    g_feeder_run = false;
+    if (g_feeder_task) xTaskNotifyGive(g_feeder_task);
+    while (g_feeder_task) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+
+    i2s_driver_uninstall(HAL_AUDIO_I2S_PORT);
+    g_i2s_events = nullptr;
+    vSemaphoreDelete(g_space_sem);
+    g_space_sem = nullptr;
+    audio_ring_deinit(&g_ring);
+
+    g_initialized = false;
+}
+
+bool hal_audio_is_initialized(void) {
+    return g_initialized;
+}
+
+// Configuration management
+bool hal_audio_set_config(const hal_audio_config_t* config) {
+    if (!config) return false;
+    if (g_initialized && config->sample_rate != g_config.sample_rate) {
+        if (!hal_audio_set_sample_rate(config->sample_rate)) return false;
+    }
+    uint16_t buffer_size = g_config.buffer_size;   // Ring size is fixed after init
+    g_config = *config;
+    if (g_initialized) g_config.buffer_size = buffer_size;
+    return true;
+}
+
+void hal_audio_get_config(hal_audio_config_t* config) {
+    if (config) *config = g_config;
+}
+
+bool hal_audio_set_sample_rate(uint32_t sample_rate) {
+    if (sample_rate == 0) return false;
+    if (g_initialized &&
+        i2s_set_clk(HAL_AUDIO_I2S_PORT, sample_rate, I2S_BITS_PER_SAMPLE_16BIT, I2S_CHANNEL_STEREO) != ESP_OK) {
+        g_last_error = HAL_AUDIO_ERROR_HARDWARE_FAULT;
+        return false;
+    }
+    g_config.sample_rate = sample_rate;
+    audio_deadline_set_rate(&g_deadline, sample_rate);
+    return true;
+}
+
+uint32_t hal_audio_get_sample_rate(void) {
+    return g_config.sample_rate;
+}
+
+// Buffer management for streaming
+bool hal_audio_write_samples(const int16_t* samples, size_t count) {
+    if (!g_initialized || !samples) return false;
+
+    uint32_t frames = count / HAL_AUDIO_CHANNELS;
+    if (!audio_ring_write_all(&g_ring, samples, frames)) {
+        g_last_error = HAL_AUDIO_ERROR_BUFFER_FULL;
+        return false;
+    }
+    if (g_feeder_task) xTaskNotifyGive(g_feeder_task);
+    return true;
+}
+
+bool hal_audio_wait_for_space(size_t count, uint32_t timeout_ms) {
+    if (!g_initialized) return false;
+
+    uint32_t frames = count / HAL_AUDIO_CHANNELS;
+    if (frames > g_ring.capacity_frames) return false;
+
+    TickType_t start = xTaskGetTickCount();
+    TickType_t budget = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    while (audio_ring_free_frames(&g_ring) < frames) {
+        TickType_t waited = xTaskGetTickCount() - start;
+        if (budget != portMAX_DELAY && waited >= budget) return false;
+        TickType_t remaining = (budget == portMAX_DELAY) ? portMAX_DELAY : budget - waited;
+        xSemaphoreTake(g_space_sem, remaining);
+    }
+    return true;
+}
+
+size_t hal_audio_get_buffer_free_space(void) {
+    return (size_t)audio_ring_free_frames(&g_ring) * HAL_AUDIO_CHANNELS;
+}
+
+size_t hal_audio_get_buffer_used_space(void) {
+    return (size_t)audio_ring_used_frames(&g_ring) * HAL_AUDIO_CHANNELS;
+}
+
+void hal_audio_flush_buffer(void) {
+    if (!g_initialized) return;
+    // The feeder performs the discard so only the consumer ever moves read_index
+    audio_ring_end_stream(&g_ring);
+    g_flush_request.store(true, std::memory_order_release);
+    xTaskNotifyGive(g_feeder_task);
+    for (int i = 0; i < 20 && g_flush_request.load(std::memory_order_acquire); i++) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+}
+
+void hal_audio_end_stream(void) {
+    audio_ring_end_stream(&g_ring);
+}
+
+uint32_t hal_audio_get_frames_written(void) {
+    return g_ring.write_index.load(std::memory_order_acquire);
+}
+
+uint32_t hal_audio_get_frames_played(void) {
+    return g_clock_frames.load(std::memory_order_acquire);
+}
+
+// Performance and debugging
+void hal_audio_get_stats(uint32_t* samples_played, uint32_t* underruns, uint32_t* overruns) {
+    if (samples_played) *samples_played = g_frames_played.load(std::memory_order_relaxed);
+    if (underruns) *underruns = g_ring.underruns.load(std::memory_order_relaxed);
+    if (overruns) *overruns = g_ring.overruns.load(std::memory_order_relaxed);
+}
+
+void hal_audio_reset_stats(void) {
+    g_frames_played = 0;
+    audio_ring_reset_stats(&g_ring);
+}
+
+void hal_audio_get_deadline_stats(hal_audio_deadline_stats_t* stats) {
+    audio_deadline_read(&g_deadline, stats);
+}
+
+void hal_audio_reset_deadline_stats(void) {
+    audio_deadline_reset(&g_deadline);
+}
+
+// Error handling
+hal_audio_error_t hal_audio_get_last_error(void) {
+    return g_last_error;
+}
+
+const char* hal_audio_get_error_string(hal_audio_error_t error) {
+    switch (error) {
+        case HAL_AUDIO_ERROR_NONE:            return "No error";
+        case HAL_AUDIO_ERROR_INIT_FAILED:     return "Initialization failed";
+        case HAL_AUDIO_ERROR_INVALID_FORMAT:  return "Invalid format";
+        case HAL_AUDIO_ERROR_BUFFER_FULL:     return "Buffer full";
+        case HAL_AUDIO_ERROR_BUFFER_EMPTY:    return "Buffer empty";
+        case HAL_AUDIO_ERROR_FILE_NOT_FOUND:  return "File not found";
+        case HAL_AUDIO_ERROR_DECODE_FAILED:   return "Decode failed";
+        case HAL_AUDIO_ERROR_HARDWARE_FAULT:  return "Hardware fault";
+        default:                              return "Unknown error";
+    }
+}
+
+} // extern "C"
+
+#endif // PLATFORM_ESP32
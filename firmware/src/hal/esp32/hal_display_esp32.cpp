@@ -1,9 +1,17 @@
 /*
  * ESP32 Hardware Abstraction Layer - Display Implementation
  * Uses Adafruit_ST7789 library for TFT display control
+ *
+ * Drawing calls are recorded and rendered into two RAM tiles by the shared
+ * tiled renderer (ui/ui_tiled_display.h). A finished tile goes to a flush
+ * task over a queue, and the task sends it as one address window while the
+ * caller renders the next tile. The transfer goes through Adafruit's
+ * writePixels() because the SD card shares the SPI bus through SPIClass;
+ * the task keeps the CPU free for rendering for the length of each transfer.
  */
 
 #include "hal/hal_display.h"
+#include "hal/hal_system.h"
 #include "hardware_config.h"
 
 #ifdef PLATFORM_ESP32
@@ -13,6 +21,11 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7789.h>
 #include <stdarg.h>
+#include <atomic>
+#include "ui/ui_tiled_display.h"
+
+#define DISPLAY_FLUSH_TASK_STACK  3072
+#define DISPLAY_FLUSH_POLL_MS     100   // How soon the task notices a deinit
 
 // Global display instance
 static Adafruit_ST7789* g_display = nullptr;
@@ -30,6 +43,133 @@ static uint16_t g_text_bg_color = HAL_COLOR_BLACK;
 static hal_font_size_t g_text_size = HAL_FONT_SIZE_MEDIUM;
 static int16_t g_cursor_x = 0;
 static int16_t g_cursor_y = 0;
+static bool g_text_opaque = false;      // A background was set after the text color
+
+// Tiled rendering and the flush task that sends the tiles
+struct display_tile {
+    ui_rect_t rect;
+    const uint16_t* pixels;             // The renderer's tile, untouched until waited for
+};
+
+static ui_tiled_display_t g_tiles;
+static hal_display_tile_stats_t g_tile_stats;
+static hal_queue_t g_tile_queue = nullptr;
+static hal_semaphore_t g_tile_sent = nullptr;      // One give per tile on the panel
+static hal_semaphore_t g_flush_done = nullptr;
+static hal_task_handle_t g_flush_task = nullptr;
+static std::atomic<bool> g_flush_run(false);
+static std::atomic<uint32_t> g_tiles_in_flight(0);
+
+static void flush_task(void* parameters) {
+    (void)parameters;
+    display_tile tile;
+    while (g_flush_run.load()) {
+        if (!hal_system_queue_receive(g_tile_queue, &tile, DISPLAY_FLUSH_POLL_MS)) continue;
+        g_display->startWrite();
+        g_display->setAddrWindow(tile.rect.x, tile.rect.y, tile.rect.w, tile.rect.h);
+        g_display->writePixels((uint16_t*)tile.pixels, (uint32_t)ui_rect_area(tile.rect));
+        g_display->endWrite();
+        g_tiles_in_flight--;
+        hal_system_give_semaphore(g_tile_sent);
+    }
+
+    hal_system_give_semaphore(g_flush_done);
+    hal_system_delete_task(nullptr);
+}
+
+static void panel_push(const ui_rect_t* rect, const uint16_t* pixels, void* user_data) {
+    (void)user_data;
+    const display_tile tile = {*rect, pixels};
+    g_tiles_in_flight++;
+    hal_system_queue_send(g_tile_queue, &tile, UINT32_MAX);
+    g_tile_stats.tiles++;
+    g_tile_stats.bytes += (uint64_t)ui_rect_area(*rect) * sizeof(uint16_t);
+}
+
+static void panel_wait(void* user_data) {
+    (void)user_data;
+    hal_system_take_semaphore(g_tile_sent, UINT32_MAX);
+}
+
+static void stop_flush_task(void) {
+    if (g_flush_task) {
+        g_flush_run = false;
+        hal_system_take_semaphore(g_flush_done, UINT32_MAX);
+        g_flush_task = nullptr;
+    }
+    if (g_tile_queue) hal_system_delete_queue(g_tile_queue);
+    if (g_tile_sent) hal_system_delete_semaphore(g_tile_sent);
+    if (g_flush_done) hal_system_delete_semaphore(g_flush_done);
+    g_tile_queue = nullptr;
+    g_tile_sent = nullptr;
+    g_flush_done = nullptr;
+}
+
+static bool start_flush_task(void) {
+    // Two tiles at most are in flight: the compositor waits before reusing one
+    g_tile_queue = hal_system_create_queue(2, sizeof(display_tile));
+    g_tile_sent = hal_system_create_semaphore(2, 0);
+    g_flush_done = hal_system_create_semaphore(1, 0);
+    g_tiles_in_flight = 0;
+    g_flush_run = true;
+    g_flush_task = g_tile_queue && g_tile_sent && g_flush_done
+                 ? hal_system_create_task(flush_task, "DisplayFlush", DISPLAY_FLUSH_TASK_STACK,
+                                          nullptr, HAL_TASK_PRIORITY_NORMAL)
+                 : nullptr;
+    if (!g_flush_task) {
+        g_flush_run = false;
+        stop_flush_task();
+        return false;
+    }
+    return true;
+}
+
+// Recording
+static void count_dropped(bool recorded) {
+    if (!recorded) g_tile_stats.dropped_ops++;
+}
+
+static void record_text(int16_t x, int16_t y, const char* text) {
+    uint8_t size = (uint8_t)g_text_size;
+    if (g_text_opaque) {
+        ui_rect_t cells = ui_text_bounds(x, y, text, size);
+        count_dropped(ui_display_list_fill_rect(&g_tiles.frame, cells.x, cells.y, cells.w, cells.h, g_text_bg_color));
+    }
+    count_dropped(ui_display_list_text(&g_tiles.frame, x, y, text, g_text_color, size));
+}
+
+// At the cursor, as Adafruit GFX prints: newlines and wrapping at the right edge
+static void print_text(const char* str) {
+    int16_t cell = UI_FONT_CELL_W * g_text_size;
+    int16_t width = g_display->width();
+    char run[64];
+    size_t count = 0;
+    int16_t run_x = 0, run_y = 0;
+    for (const char* p = str; *p; p++) {
+        if (*p == '\r') continue;
+        if (*p == '\n' || g_cursor_x + cell > width) {
+            run[count] = '\0';
+            if (count) record_text(run_x, run_y, run);
+            count = 0;
+            g_cursor_x = 0;
+            g_cursor_y += UI_FONT_CELL_H * g_text_size;
+            if (*p == '\n') continue;
+        }
+        if (count == 0) {
+            run_x = g_cursor_x;
+            run_y = g_cursor_y;
+        }
+        run[count++] = *p;
+        g_cursor_x += cell;
+        if (count == sizeof(run) - 1) {
+            run[count] = '\0';
+            record_text(run_x, run_y, run);
+            count = 0;
+        }
+    }
+    run[count] = '\0';
+    if (count) record_text(run_x, run_y, run);
+}
 
 extern "C" {
 
@@ -55,6 +195,17 @@ bool hal_display_init(void) {
     g_display->setRotation(g_rotation);
     g_display->fillScreen(HAL_COLOR_BLACK);
     
+    // The tiles start from the black the panel now shows
+    memset(&g_tile_stats, 0, sizeof(g_tile_stats));
+    const ui_panel_t panel = {panel_push, panel_wait, nullptr};
+    if (!start_flush_task() ||
+        !ui_tiled_display_init(&g_tiles, g_display->width(), g_display->height(), HAL_DISPLAY_TILE_ROWS, &panel)) {
+        stop_flush_task();
+        delete g_display;
+        g_display = nullptr;
+        return false;
+    }
+    
     // Initialize backlight
     if (TFT_BL_PIN != -1) {
         pinMode(TFT_BL_PIN, OUTPUT);
@@ -75,6 +226,10 @@ void hal_display_deinit(void) {
         digitalWrite(TFT_BL_PIN, LOW);
     }
     
+    // Every tile in flight reaches the panel before the task stops
+    ui_tiled_display_deinit(&g_tiles);
+    stop_flush_task();
+    
     // Clean up display instance
     if (g_display) {
         delete g_display;
@@ -102,8 +257,11 @@ uint16_t hal_display_get_height(void) {
 void hal_display_set_rotation(hal_display_rotation_t rotation) {
     if (!g_initialized || !g_display) return;
     
+    // Tiles in flight were rendered for the old orientation
+    ui_tiled_display_sync(&g_tiles);
     g_rotation = rotation;
     g_display->setRotation((uint8_t)rotation);
+    ui_tiled_display_resize(&g_tiles, g_display->width(), g_display->height());
 }
 
 hal_display_rotation_t hal_display_get_rotation(void) {
@@ -127,7 +285,7 @@ uint8_t hal_display_get_backlight(void) {
 void hal_display_clear(uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->fillScreen(color);
+    ui_display_list_clear(&g_tiles.frame, color);
     g_frames_rendered++;
 }
 
@@ -138,62 +296,63 @@ void hal_display_fill_screen(uint16_t color) {
 void hal_display_set_pixel(int16_t x, int16_t y, uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->drawPixel(x, y, color);
+    count_dropped(ui_display_list_fill_rect(&g_tiles.frame, x, y, 1, 1, color));
     g_pixels_drawn++;
 }
 
 uint16_t hal_display_get_pixel(int16_t x, int16_t y) {
-    // ST7789 doesn't support reading pixels, return black
-    return HAL_COLOR_BLACK;
+    // The ST7789 can't be read back; the recorded calls say what it will show
+    if (!g_initialized) return HAL_COLOR_BLACK;
+    return ui_tiled_display_pixel(&g_tiles, x, y);
 }
 
 // Shape drawing
 void hal_display_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->drawLine(x0, y0, x1, y1, color);
+    count_dropped(ui_display_list_line(&g_tiles.frame, x0, y0, x1, y1, color));
     g_pixels_drawn += abs(x1 - x0) + abs(y1 - y0);
 }
 
 void hal_display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->drawRect(x, y, w, h, color);
+    count_dropped(ui_display_list_rect(&g_tiles.frame, x, y, w, h, color));
     g_pixels_drawn += (w + h) * 2;
 }
 
 void hal_display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->fillRect(x, y, w, h, color);
+    count_dropped(ui_display_list_fill_rect(&g_tiles.frame, x, y, w, h, color));
     g_pixels_drawn += w * h;
 }
 
 void hal_display_draw_circle(int16_t x, int16_t y, int16_t r, uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->drawCircle(x, y, r, color);
+    count_dropped(ui_display_list_circle(&g_tiles.frame, x, y, r, color, false));
     g_pixels_drawn += r * 6; // Approximate
 }
 
 void hal_display_fill_circle(int16_t x, int16_t y, int16_t r, uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->fillCircle(x, y, r, color);
+    count_dropped(ui_display_list_circle(&g_tiles.frame, x, y, r, color, true));
     g_pixels_drawn += r * r * 3; // Approximate
 }
 
 void hal_display_draw_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->drawTriangle(x0, y0, x1, y1, x2, y2, color);
+    count_dropped(ui_display_list_triangle(&g_tiles.frame, x0, y0, x1, y1, x2, y2, color, false));
     g_pixels_drawn += abs(x1 - x0) + abs(y1 - y0) + abs(x2 - x1) + abs(y2 - y1) + abs(x0 - x2) + abs(y0 - y2);
 }
 
 void hal_display_fill_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
     if (!g_initialized || !g_display) return;
     
-    g_display->fillTriangle(x0, y0, x1, y1, x2, y2, color);
+    count_dropped(ui_display_list_triangle(&g_tiles.frame, x0, y0, x1, y1, x2, y2, color, true));
     // Approximate pixel count for filled triangle
     int16_t area = abs((x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0)) / 2;
     g_pixels_drawn += area;
@@ -202,44 +361,35 @@ void hal_display_fill_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, i
 // Text rendering
 void hal_display_set_text_color(uint16_t color) {
     g_text_color = color;
-    if (g_initialized && g_display) {
-        g_display->setTextColor(color);
-    }
+    g_text_opaque = false;
 }
 
 void hal_display_set_text_background(uint16_t color) {
     g_text_bg_color = color;
-    if (g_initialized && g_display) {
-        g_display->setTextColor(g_text_color, color);
-    }
+    g_text_opaque = true;
 }
 
 void hal_display_set_text_size(hal_font_size_t size) {
     g_text_size = size;
-    if (g_initialized && g_display) {
-        g_display->setTextSize((uint8_t)size);
-    }
 }
 
 void hal_display_set_cursor(int16_t x, int16_t y) {
     g_cursor_x = x;
     g_cursor_y = y;
-    if (g_initialized && g_display) {
-        g_display->setCursor(x, y);
-    }
 }
 
 void hal_display_print_char(char c) {
     if (!g_initialized || !g_display) return;
     
-    g_display->print(c);
+    const char text[2] = {c, '\0'};
+    print_text(text);
     g_pixels_drawn += 6 * 8 * g_text_size; // Approximate character size
 }
 
 void hal_display_print_string(const char* str) {
     if (!g_initialized || !g_display || !str) return;
     
-    g_display->print(str);
+    print_text(str);
     g_pixels_drawn += strlen(str) * 6 * 8 * g_text_size; // Approximate
 }
 
@@ -259,10 +409,12 @@ void hal_display_printf(const char* format, ...) {
 void hal_display_draw_text(int16_t x, int16_t y, const char* text, uint16_t color, hal_font_size_t size) {
     if (!g_initialized || !g_display || !text) return;
     
-    g_display->setCursor(x, y);
-    g_display->setTextColor(color);
-    g_display->setTextSize((uint8_t)size);
-    g_display->print(text);
+    g_cursor_x = x;
+    g_cursor_y = y;
+    g_text_color = color;
+    g_text_opaque = false;
+    g_text_size = size;
+    print_text(text);
     
     g_pixels_drawn += strlen(text) * 6 * 8 * size;
 }
@@ -295,58 +447,61 @@ void hal_display_draw_bitmap(int16_t x, int16_t y, const uint8_t* bitmap,
                             int16_t w, int16_t h, uint16_t color) {
     if (!g_initialized || !g_display || !bitmap) return;
     
-    g_display->drawBitmap(x, y, bitmap, w, h, color);
+    count_dropped(ui_display_list_bitmap(&g_tiles.frame, x, y, bitmap, w, h, color));
     g_pixels_drawn += w * h;
 }
 
 void hal_display_draw_rgb_bitmap(int16_t x, int16_t y, const uint16_t* bitmap, int16_t w, int16_t h) {
     if (!g_initialized || !g_display || !bitmap) return;
     
-    g_display->drawRGBBitmap(x, y, bitmap, w, h);
+    count_dropped(ui_display_list_rgb_bitmap(&g_tiles.frame, x, y, bitmap, w, h));
     g_pixels_drawn += w * h;
 }
 
 // Buffer operations
 void hal_display_start_write(void) {
-    if (g_initialized && g_display) {
-        g_display->startWrite();
-    }
+    // No-op: the flush task owns the bus transactions
 }
 
 void hal_display_end_write(void) {
-    if (g_initialized && g_display) {
-        g_display->endWrite();
-    }
+    // No-op: the flush task owns the bus transactions
 }
 
 void hal_display_write_pixel(int16_t x, int16_t y, uint16_t color) {
     if (g_initialized && g_display) {
-        g_display->writePixel(x, y, color);
+        count_dropped(ui_display_list_fill_rect(&g_tiles.frame, x, y, 1, 1, color));
         g_pixels_drawn++;
     }
 }
 
 void hal_display_write_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
     if (g_initialized && g_display) {
-        g_display->writeFillRect(x, y, w, h, color);
+        count_dropped(ui_display_list_fill_rect(&g_tiles.frame, x, y, w, h, color));
         g_pixels_drawn += w * h;
     }
 }
 
 // Display refresh and synchronization
 void hal_display_update(void) {
-    // ST7789 updates immediately, no buffering
+    if (!g_initialized) return;
+    
+    uint32_t bytes = ui_tiled_display_update(&g_tiles) * sizeof(uint16_t);
+    if (bytes) {
+        g_tile_stats.frames++;
+        g_tile_stats.last_frame_bytes = bytes;
+    }
     g_frames_rendered++;
 }
 
 void hal_display_vsync(void) {
-    // No hardware vsync available, just a small delay
-    delay(16); // ~60 FPS
+    // No tearing signal on this panel: wait for the tiles to be sent instead
+    if (g_initialized) {
+        ui_tiled_display_sync(&g_tiles);
+    }
 }
 
 bool hal_display_is_busy(void) {
-    // ST7789 is never busy in this implementation
-    return false;
+    return g_tiles_in_flight.load() > 0;
 }
 
 // Color utilities
@@ -371,6 +526,14 @@ void hal_display_reset_stats(void) {
     g_pixels_drawn = 0;
 }
 
+void hal_display_get_tile_stats(hal_display_tile_stats_t* stats) {
+    if (stats) *stats = g_tile_stats;
+}
+
+void hal_display_reset_tile_stats(void) {
+    memset(&g_tile_stats, 0, sizeof(g_tile_stats));
+}
+
 } // extern "C"
 
 #endif // PLATFORM_ESP32
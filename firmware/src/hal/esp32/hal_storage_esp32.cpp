@@ -0,0 +1,328 @@
+/*
+ * ESP32 Hardware Abstraction Layer - Storage Implementation
+ * Wraps the Arduino SD library; the card itself is brought up by the application
+ */
+
+#include "hal/hal_storage.h"
+
+#ifdef PLATFORM_ESP32
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ESP32 storage state
+static bool g_initialized = false;
+static hal_storage_error_t g_last_error = HAL_STORAGE_ERROR_NONE;
+static uint32_t g_reads = 0;
+static uint32_t g_writes = 0;
+
+static void fill_file_info(File& entry, hal_storage_file_info_t* info) {
+    memset(info, 0, sizeof(*info));
+    const char* path = entry.path();
+    const char* slash = strrchr(path, '/');
+    snprintf(info->name, sizeof(info->name), "%s", slash ? slash + 1 : path);
+    snprintf(info->path, sizeof(info->path), "%s", path);
+    info->type = entry.isDirectory() ? HAL_STORAGE_TYPE_DIRECTORY : HAL_STORAGE_TYPE_FILE;
+    info->size = entry.isDirectory() ? 0 : entry.size();
+    info->modified_time = (uint32_t)entry.getLastWrite();
+    info->hidden = info->name[0] == '.';
+}
+
+extern "C" {
+
+// Storage initialization and control
+bool hal_storage_init(void) {
+    g_initialized = true;
+    g_last_error = HAL_STORAGE_ERROR_NONE;
+    return true;
+}
+
+void hal_storage_deinit(void) {
+    g_initialized = false;
+}
+
+bool hal_storage_is_initialized(void) {
+    return g_initialized;
+}
+
+// Mount/unmount operations
+bool hal_storage_mount(void) {
+    // SD.begin() runs in the application (SPI bus shared with the display)
+    if (!hal_storage_is_mounted()) {
+        g_last_error = HAL_STORAGE_ERROR_NO_CARD;
+        return false;
+    }
+    return true;
+}
+
+bool hal_storage_unmount(void) {
+    SD.end();
+    return true;
+}
+
+bool hal_storage_is_mounted(void) {
+    return SD.cardType() != CARD_NONE;
+}
+
+// File operations
+hal_storage_file_t hal_storage_open(const char* path, hal_storage_mode_t mode) {
+    if (!path) {
+        g_last_error = HAL_STORAGE_ERROR_INVALID_PATH;
+        return nullptr;
+    }
+
+    const char* fmode = FILE_READ;
+    if (mode & HAL_STORAGE_MODE_APPEND) fmode = FILE_APPEND;
+    else if (mode & HAL_STORAGE_MODE_WRITE) fmode = FILE_WRITE;
+
+    File f = SD.open(path, fmode);
+    if (!f) {
+        g_last_error = HAL_STORAGE_ERROR_FILE_NOT_FOUND;
+        return nullptr;
+    }
+    return (hal_storage_file_t)(new File(f));
+}
+
+void hal_storage_close(hal_storage_file_t file) {
+    if (!file) return;
+    File* f = (File*)file;
+    f->close();
+    delete f;
+}
+
+bool hal_storage_is_open(hal_storage_file_t file) {
+    return file && (bool)*(File*)file;
+}
+
+// File I/O operations
+size_t hal_storage_read(hal_storage_file_t file, void* buffer, size_t size) {
+    if (!file || !buffer) return 0;
+    g_reads++;
+    int n = ((File*)file)->read((uint8_t*)buffer, size);
+    return n > 0 ? (size_t)n : 0;
+}
+
+size_t hal_storage_write(hal_storage_file_t file, const void* buffer, size_t size) {
+    if (!file || !buffer) return 0;
+    g_writes++;
+    return ((File*)file)->write((const uint8_t*)buffer, size);
+}
+
+bool hal_storage_flush(hal_storage_file_t file) {
+    if (!file) return false;
+    ((File*)file)->flush();
+    return true;
+}
+
+bool hal_storage_sync(hal_storage_file_t file) {
+    return hal_storage_flush(file);
+}
+
+// File positioning
+bool hal_storage_seek(hal_storage_file_t file, int64_t offset, hal_storage_seek_t origin) {
+    if (!file) return false;
+    SeekMode mode = origin == HAL_STORAGE_SEEK_CUR ? SeekCur : origin == HAL_STORAGE_SEEK_END ? SeekEnd : SeekSet;
+    return ((File*)file)->seek((uint32_t)offset, mode);
+}
+
+int64_t hal_storage_tell(hal_storage_file_t file) {
+    if (!file) return -1;
+    return (int64_t)((File*)file)->position();
+}
+
+bool hal_storage_rewind(hal_storage_file_t file) {
+    return hal_storage_seek(file, 0, HAL_STORAGE_SEEK_SET);
+}
+
+bool hal_storage_eof(hal_storage_file_t file) {
+    return !file || ((File*)file)->available() <= 0;
+}
+
+// File information and properties
+bool hal_storage_get_file_info(const char* path, hal_storage_file_info_t* info) {
+    if (!path || !info) return false;
+    File f = SD.open(path, FILE_READ);
+    if (!f) {
+        g_last_error = HAL_STORAGE_ERROR_FILE_NOT_FOUND;
+        return false;
+    }
+    fill_file_info(f, info);
+    f.close();
+    return true;
+}
+
+uint64_t hal_storage_get_file_size(const char* path) {
+    File f = SD.open(path, FILE_READ);
+    if (!f) return 0;
+    uint64_t size = f.size();
+    f.close();
+    return size;
+}
+
+uint64_t hal_storage_get_file_size_handle(hal_storage_file_t file) {
+    return file ? ((File*)file)->size() : 0;
+}
+
+bool hal_storage_file_exists(const char* path) {
+    return path && SD.exists(path);
+}
+
+// File management
+bool hal_storage_delete_file(const char* path) {
+    return path && SD.remove(path);
+}
+
+bool hal_storage_rename_file(const char* old_path, const char* new_path) {
+    return old_path && new_path && SD.rename(old_path, new_path);
+}
+
+// Directory operations
+bool hal_storage_create_dir(const char* path) {
+    return path && (SD.exists(path) || SD.mkdir(path));
+}
+
+bool hal_storage_dir_exists(const char* path) {
+    if (!path) return false;
+    File f = SD.open(path);
+    bool is_dir = f && f.isDirectory();
+    if (f) f.close();
+    return is_dir;
+}
+
+// Directory listing
+hal_storage_dir_t hal_storage_open_dir(const char* path) {
+    if (!path) return nullptr;
+    File dir = SD.open(path);
+    if (!dir || !dir.isDirectory()) {
+        if (dir) dir.close();
+        g_last_error = HAL_STORAGE_ERROR_FILE_NOT_FOUND;
+        return nullptr;
+    }
+    return (hal_storage_dir_t)(new File(dir));
+}
+
+void hal_storage_close_dir(hal_storage_dir_t dir) {
+    hal_storage_close((hal_storage_file_t)dir);
+}
+
+bool hal_storage_read_dir(hal_storage_dir_t dir, hal_storage_file_info_t* info) {
+    if (!dir || !info) return false;
+    File entry = ((File*)dir)->openNextFile();
+    if (!entry) return false;
+    fill_file_info(entry, info);
+    entry.close();
+    return true;
+}
+
+void hal_storage_rewind_dir(hal_storage_dir_t dir) {
+    if (dir) ((File*)dir)->rewindDirectory();
+}
+
+// Path utilities
+bool hal_storage_is_absolute_path(const char* path) {
+    return path && path[0] == '/';
+}
+
+bool hal_storage_join_path(char* result, size_t result_size, const char* base, const char* relative) {
+    if (!result || !base || !relative) return false;
+    size_t len = strlen(base);
+    const char* sep = (len > 0 && base[len - 1] == '/') ? "" : "/";
+    int n = snprintf(result, result_size, "%s%s%s", base, sep, relative);
+    return n >= 0 && (size_t)n < result_size;
+}
+
+bool hal_storage_get_filename(const char* path, char* filename, size_t filename_size) {
+    if (!path || !filename) return false;
+    const char* slash = strrchr(path, '/');
+    int n = snprintf(filename, filename_size, "%s", slash ? slash + 1 : path);
+    return n >= 0 && (size_t)n < filename_size;
+}
+
+bool hal_storage_get_extension(const char* path, char* extension, size_t extension_size) {
+    if (!path || !extension || extension_size == 0) return false;
+    const char* slash = strrchr(path, '/');
+    const char* dot = strrchr(slash ? slash : path, '.');
+    if (!dot || dot[1] == '\0') {
+        extension[0] = '\0';
+        return false;
+    }
+    int n = snprintf(extension, extension_size, "%s", dot + 1);
+    return n >= 0 && (size_t)n < extension_size;
+}
+
+// Convenience functions for common file operations
+bool hal_storage_read_file_to_buffer(const char* path, void** buffer, size_t* size) {
+    if (!path || !buffer || !size) return false;
+    hal_storage_file_t file = hal_storage_open(path, HAL_STORAGE_MODE_READ);
+    if (!file) return false;
+
+    size_t length = (size_t)hal_storage_get_file_size_handle(file);
+    uint8_t* data = (uint8_t*)malloc(length + 1);
+    bool ok = data && hal_storage_read(file, data, length) == length;
+    hal_storage_close(file);
+    if (!ok) {
+        free(data);
+        g_last_error = HAL_STORAGE_ERROR_IO_ERROR;
+        return false;
+    }
+    data[length] = 0;   // Text files can be used as C strings
+    *buffer = data;
+    *size = length;
+    return true;
+}
+
+bool hal_storage_write_buffer_to_file(const char* path, const void* buffer, size_t size) {
+    if (!path || (!buffer && size)) return false;
+    hal_storage_file_t file = hal_storage_open(path, HAL_STORAGE_MODE_WRITE);
+    if (!file) return false;
+    bool ok = hal_storage_write(file, buffer, size) == size;
+    hal_storage_close(file);
+    return ok;
+}
+
+// Performance monitoring
+void hal_storage_get_stats(uint32_t* reads, uint32_t* writes, uint32_t* cache_hits, uint32_t* cache_misses) {
+    if (reads) *reads = g_reads;
+    if (writes) *writes = g_writes;
+    if (cache_hits) *cache_hits = 0;
+    if (cache_misses) *cache_misses = 0;
+}
+
+void hal_storage_reset_stats(void) {
+    g_reads = 0;
+    g_writes = 0;
+}
+
+// Hardware-specific operations (SD card)
+bool hal_storage_sd_detect(void) {
+    return SD.cardType() != CARD_NONE;
+}
+
+// Error handling
+hal_storage_error_t hal_storage_get_last_error(void) {
+    return g_last_error;
+}
+
+const char* hal_storage_get_error_string(hal_storage_error_t error) {
+    switch (error) {
+        case HAL_STORAGE_ERROR_NONE:            return "No error";
+        case HAL_STORAGE_ERROR_INIT_FAILED:     return "Initialization failed";
+        case HAL_STORAGE_ERROR_NOT_MOUNTED:     return "Not mounted";
+        case HAL_STORAGE_ERROR_FILE_NOT_FOUND:  return "File not found";
+        case HAL_STORAGE_ERROR_ACCESS_DENIED:   return "Access denied";
+        case HAL_STORAGE_ERROR_DISK_FULL:       return "Disk full";
+        case HAL_STORAGE_ERROR_READ_ONLY:       return "Read only";
+        case HAL_STORAGE_ERROR_INVALID_PATH:    return "Invalid path";
+        case HAL_STORAGE_ERROR_IO_ERROR:        return "I/O error";
+        case HAL_STORAGE_ERROR_CORRUPTED:       return "Corrupted";
+        case HAL_STORAGE_ERROR_NO_CARD:         return "No card";
+        default:                                return "Unknown error";
+    }
+}
+
+} // extern "C"
+
+#endif // PLATFORM_ESP32
@@ -25,6 +25,7 @@
 #include <soc/rtc.h>
 #include <driver/gpio.h>
 #include <stdarg.h>
+#include <atomic>
 
 // Global system state
 static bool g_initialized = false;
@@ -41,6 +42,8 @@ static bool g_system_info_cached = false;
 // Task tracking
 static uint32_t g_task_count = 0;
 
+static std::atomic<uint32_t> g_alloc_count(0);
+
 extern "C" {
 
 // Internal helper functions
@@ -180,14 +183,17 @@ uint32_t hal_system_get_max_alloc_heap(void) {
 }
 
 void* hal_system_malloc(size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
     return malloc(size);
 }
 
 void* hal_system_calloc(size_t num, size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
     return calloc(num, size);
 }
 
 void* hal_system_realloc(void* ptr, size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
     return realloc(ptr, size);
 }
 
@@ -195,6 +201,19 @@ void hal_system_free(void* ptr) {
     free(ptr);
 }
 
+void* hal_system_malloc_psram(size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!ptr) {
+        ptr = malloc(size);
+    }
+    return ptr;
+}
+
+uint32_t hal_system_get_alloc_count(void) {
+    return g_alloc_count.load(std::memory_order_relaxed);
+}
+
 // System reset and power control
 void hal_system_reset(void) {
     esp_restart();
@@ -357,10 +376,9 @@ hal_task_handle_t hal_system_create_task(hal_task_function_t function,
 }
 
 void hal_system_delete_task(hal_task_handle_t task) {
-    if (task) {
-        vTaskDelete((TaskHandle_t)task);
-        g_task_count--;
-    }
+    // NULL deletes the calling task, as with vTaskDelete()
+    if (g_task_count > 0) g_task_count--;
+    vTaskDelete((TaskHandle_t)task);
 }
 
 void hal_system_suspend_task(hal_task_handle_t task) {
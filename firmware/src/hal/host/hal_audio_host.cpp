@@ -0,0 +1,460 @@
+/*
+ * Host Hardware Abstraction Layer - Audio Implementation
+ * Drains the shared PCM ring from a sink thread paced like the I2S DMA clock
+ *
+ * The sink discards, keeps the frames in memory or streams them into a WAV
+ * file. In offline mode it is not paced at all: the producer sets the rate,
+ * so whole tracks render through the engine many times faster than real time.
+ */
+
+#include "hal/hal_audio.h"
+
+#ifdef PLATFORM_HOST
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "audio/audio_ring_buffer.h"
+#include "audio/audio_deadline.h"
+
+#define HAL_AUDIO_HOST_PERIOD_FRAMES 256    // Mirrors the ESP32 DMA buffer length
+#define HAL_AUDIO_HOST_WAV_HEADER    44
+
+// Host audio state
+static struct {
+    bool initialized;
+    hal_audio_config_t config;
+    hal_audio_error_t last_error;
+
+    audio_ring_t ring;
+    std::thread* sink_thread;
+    std::atomic<bool> sink_run;
+    std::atomic<bool> flush_request;        // Sink discards queued frames when set
+    std::atomic<uint32_t> frames_played;
+    std::atomic<bool> offline;
+    bool offline_chosen;
+    audio_deadline_t deadline;              // Period timing, real time only
+
+    std::mutex sink_mutex;                  // Sink thread vs. sink selection and memory reads
+    hal_audio_host_sink_t sink;
+    bool sink_chosen;
+    FILE* wav_file;
+    uint64_t wav_data_bytes;
+    std::vector<int16_t> memory;
+
+    std::mutex wake_mutex;
+    std::condition_variable space_cv;       // Sink -> producer: frames were consumed
+    std::condition_variable data_cv;        // Producer -> sink: frames were written
+} g_host_audio;
+
+// Notifies under the lock so a waiter between its predicate check and its
+// wait cannot miss the wakeup (offline the sink never sleeps it off)
+static void wake(std::condition_variable& cv) {
+    { std::lock_guard<std::mutex> lock(g_host_audio.wake_mutex); }
+    cv.notify_all();
+}
+
+static void put_le16(uint8_t* p, uint16_t x) {
+    p[0] = x & 0xFF; p[1] = x >> 8;
+}
+
+static void put_le32(uint8_t* p, uint32_t x) {
+    for (int i = 0; i < 4; i++) p[i] = (x >> (8 * i)) & 0xFF;
+}
+
+static void wav_write_header(FILE* f, uint32_t sample_rate, uint64_t data_bytes) {
+    if (data_bytes > UINT32_MAX - 36) data_bytes = UINT32_MAX - 36;
+    uint8_t h[HAL_AUDIO_HOST_WAV_HEADER];
+    memcpy(h, "RIFF", 4);
+    put_le32(h + 4, (uint32_t)(36 + data_bytes));
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put_le32(h + 16, 16);
+    put_le16(h + 20, 1);
+    put_le16(h + 22, HAL_AUDIO_CHANNELS);
+    put_le32(h + 24, sample_rate);
+    put_le32(h + 28, sample_rate * HAL_AUDIO_CHANNELS * sizeof(int16_t));
+    put_le16(h + 32, HAL_AUDIO_CHANNELS * sizeof(int16_t));
+    put_le16(h + 34, 16);
+    memcpy(h + 36, "data", 4);
+    put_le32(h + 40, (uint32_t)data_bytes);
+    fseek(f, 0, SEEK_SET);
+    fwrite(h, 1, sizeof(h), f);
+    fseek(f, 0, SEEK_END);
+}
+
+// Patches the final sizes and rate in; call with sink_mutex held
+static void wav_close() {
+    if (!g_host_audio.wav_file) return;
+    wav_write_header(g_host_audio.wav_file, g_host_audio.config.sample_rate, g_host_audio.wav_data_bytes);
+    fclose(g_host_audio.wav_file);
+    g_host_audio.wav_file = nullptr;
+}
+
+static void sink_write(const int16_t* period, uint32_t frames) {
+    std::lock_guard<std::mutex> lock(g_host_audio.sink_mutex);
+    const size_t samples = (size_t)frames * HAL_AUDIO_CHANNELS;
+    switch (g_host_audio.sink) {
+        case HAL_AUDIO_HOST_SINK_MEMORY:
+            g_host_audio.memory.insert(g_host_audio.memory.end(), period, period + samples);
+            break;
+        case HAL_AUDIO_HOST_SINK_WAV_FILE:
+            // Host byte order is little-endian, as WAV expects
+            if (g_host_audio.wav_file) {
+                g_host_audio.wav_data_bytes += fwrite(period, sizeof(int16_t), samples, g_host_audio.wav_file) *
+                                               sizeof(int16_t);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void sink_thread_main() {
+    int16_t period[HAL_AUDIO_HOST_PERIOD_FRAMES * HAL_AUDIO_CHANNELS];
+    const auto period_duration = std::chrono::microseconds(
+        (uint64_t)HAL_AUDIO_HOST_PERIOD_FRAMES * 1000000ull / g_host_audio.config.sample_rate);
+    auto next_deadline = std::chrono::steady_clock::now();
+    bool padded = false;                    // Last period ran dry mid-stream
+
+    while (g_host_audio.sink_run.load()) {
+        if (g_host_audio.flush_request.load()) {
+            while (audio_ring_read(&g_host_audio.ring, period, HAL_AUDIO_HOST_PERIOD_FRAMES) > 0) {
+            }
+            g_host_audio.flush_request = false;
+            audio_deadline_idle(&g_host_audio.deadline);
+            padded = false;
+            wake(g_host_audio.space_cv);
+        }
+
+        const bool offline = g_host_audio.offline.load();
+        if (audio_ring_used_frames(&g_host_audio.ring) == 0 &&
+            (offline || !g_host_audio.ring.stream_active.load())) {
+            // Idle, or offline and ahead of the producer: sleep until it writes
+            // instead of ticking silence
+            std::unique_lock<std::mutex> lock(g_host_audio.wake_mutex);
+            g_host_audio.data_cv.wait_for(lock, std::chrono::milliseconds(50), []() {
+                return audio_ring_used_frames(&g_host_audio.ring) > 0 || !g_host_audio.sink_run.load() ||
+                       g_host_audio.flush_request.load();
+            });
+            next_deadline = std::chrono::steady_clock::now();
+            audio_deadline_idle(&g_host_audio.deadline);
+            padded = false;
+            continue;
+        }
+
+        // The ring is all the host queues ahead of its DAC. A period that finds
+        // it empty is no refill; the next one is late if silence was padded in.
+        uint32_t queued = audio_ring_used_frames(&g_host_audio.ring);
+        if (!offline && queued > 0) {
+            uint64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            audio_deadline_record(&g_host_audio.deadline, now_us, queued, padded);
+        }
+        uint32_t got = offline ? audio_ring_read(&g_host_audio.ring, period, HAL_AUDIO_HOST_PERIOD_FRAMES)
+                               : audio_ring_read_padded(&g_host_audio.ring, period, HAL_AUDIO_HOST_PERIOD_FRAMES);
+        padded = got < HAL_AUDIO_HOST_PERIOD_FRAMES && g_host_audio.ring.stream_active.load();
+        // Real time, the sink gets whole periods with the silence the DAC would play
+        sink_write(period, offline ? got : HAL_AUDIO_HOST_PERIOD_FRAMES);
+        g_host_audio.frames_played.fetch_add(got);
+        wake(g_host_audio.space_cv);
+        if (offline) continue;
+
+        next_deadline += period_duration;
+        std::this_thread::sleep_until(next_deadline);
+    }
+}
+
+extern "C" {
+
+// Audio initialization and control
+bool hal_audio_init(const hal_audio_config_t* config) {
+    if (g_host_audio.initialized) {
+        return true;
+    }
+
+    if (config) {
+        g_host_audio.config = *config;
+    } else {
+        g_host_audio.config.sample_rate = HAL_AUDIO_DEFAULT_SAMPLE_RATE;
+        g_host_audio.config.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+        g_host_audio.config.volume = HAL_AUDIO_DEFAULT_VOLUME;
+        g_host_audio.config.loop = false;
+        g_host_audio.config.buffer_size = 0;
+    }
+    if (g_host_audio.config.sample_rate == 0) {
+        g_host_audio.config.sample_rate = HAL_AUDIO_DEFAULT_SAMPLE_RATE;
+    }
+
+    if (!g_host_audio.sink_chosen) {
+        const char* wav_path = getenv("IZOD_AUDIO_WAV");
+        if (wav_path && *wav_path) hal_audio_host_set_sink(HAL_AUDIO_HOST_SINK_WAV_FILE, wav_path);
+    }
+    if (!g_host_audio.offline_chosen) {
+        const char* offline = getenv("IZOD_AUDIO_OFFLINE");
+        g_host_audio.offline = offline && *offline && strcmp(offline, "0") != 0;
+    }
+
+    uint32_t ring_frames = g_host_audio.config.buffer_size
+                         ? g_host_audio.config.buffer_size / HAL_AUDIO_CHANNELS
+                         : HAL_AUDIO_DEFAULT_BUFFER_FRAMES;
+    if (!audio_ring_init(&g_host_audio.ring, ring_frames, true)) {
+        g_host_audio.last_error = HAL_AUDIO_ERROR_INIT_FAILED;
+        return false;
+    }
+
+    g_host_audio.frames_played = 0;
+    g_host_audio.flush_request = false;
+    audio_deadline_init(&g_host_audio.deadline, g_host_audio.config.sample_rate, HAL_AUDIO_HOST_PERIOD_FRAMES);
+    g_host_audio.sink_run = true;
+    g_host_audio.sink_thread = new std::thread(sink_thread_main);
+
+    g_host_audio.last_error = HAL_AUDIO_ERROR_NONE;
+    g_host_audio.initialized = true;
+    printf("Host audio HAL initialized (%u Hz, %u frame ring%s)\n",
+           (unsigned)g_host_audio.config.sample_rate, (unsigned)g_host_audio.ring.capacity_frames,
+           g_host_audio.offline.load() ? ", offline" : "");
+    return true;
+}
+
+void hal_audio_deinit(void) {
+    if (!g_host_audio.initialized) {
+        return;
+    }
+
+    g_host_audio.sink_run = false;
+    g_host_audio.data_cv.notify_all();
+    if (g_host_audio.sink_thread) {
+        if (g_host_audio.sink_thread->joinable()) g_host_audio.sink_thread->join();
+        delete g_host_audio.sink_thread;
+        g_host_audio.sink_thread = nullptr;
+    }
+    wake(g_host_audio.space_cv);
+    audio_ring_deinit(&g_host_audio.ring);
+
+    {
+        std::lock_guard<std::mutex> lock(g_host_audio.sink_mutex);
+        if (g_host_audio.sink == HAL_AUDIO_HOST_SINK_WAV_FILE) {
+            wav_close();
+            g_host_audio.sink = HAL_AUDIO_HOST_SINK_NULL;
+            g_host_audio.sink_chosen = false;
+        }
+    }
+
+    g_host_audio.initialized = false;
+    printf("Host audio HAL deinitialized\n");
+}
+
+bool hal_audio_is_initialized(void) {
+    return g_host_audio.initialized;
+}
+
+// Configuration management
+bool hal_audio_set_config(const hal_audio_config_t* config) {
+    if (!config || config->sample_rate == 0) return false;
+    uint16_t buffer_size = g_host_audio.config.buffer_size;    // Ring size is fixed after init
+    g_host_audio.config = *config;
+    if (g_host_audio.initialized) g_host_audio.config.buffer_size = buffer_size;
+    return true;
+}
+
+void hal_audio_get_config(hal_audio_config_t* config) {
+    if (config) *config = g_host_audio.config;
+}
+
+bool hal_audio_set_sample_rate(uint32_t sample_rate) {
+    if (sample_rate == 0) return false;
+    g_host_audio.config.sample_rate = sample_rate;
+    audio_deadline_set_rate(&g_host_audio.deadline, sample_rate);
+    return true;
+}
+
+uint32_t hal_audio_get_sample_rate(void) {
+    return g_host_audio.config.sample_rate;
+}
+
+// Buffer management for streaming
+bool hal_audio_write_samples(const int16_t* samples, size_t count) {
+    if (!g_host_audio.initialized || !samples) return false;
+
+    uint32_t frames = count / HAL_AUDIO_CHANNELS;
+    if (!audio_ring_write_all(&g_host_audio.ring, samples, frames)) {
+        g_host_audio.last_error = HAL_AUDIO_ERROR_BUFFER_FULL;
+        return false;
+    }
+    wake(g_host_audio.data_cv);
+    return true;
+}
+
+bool hal_audio_wait_for_space(size_t count, uint32_t timeout_ms) {
+    if (!g_host_audio.initialized) return false;
+
+    uint32_t frames = count / HAL_AUDIO_CHANNELS;
+    if (frames > g_host_audio.ring.capacity_frames) return false;
+
+    std::unique_lock<std::mutex> lock(g_host_audio.wake_mutex);
+    auto has_space = [frames]() {
+        return audio_ring_free_frames(&g_host_audio.ring) >= frames || !g_host_audio.sink_run.load();
+    };
+    if (timeout_ms == UINT32_MAX) {
+        g_host_audio.space_cv.wait(lock, has_space);
+    } else {
+        g_host_audio.space_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), has_space);
+    }
+    return audio_ring_free_frames(&g_host_audio.ring) >= frames;
+}
+
+size_t hal_audio_get_buffer_free_space(void) {
+    return (size_t)audio_ring_free_frames(&g_host_audio.ring) * HAL_AUDIO_CHANNELS;
+}
+
+size_t hal_audio_get_buffer_used_space(void) {
+    return (size_t)audio_ring_used_frames(&g_host_audio.ring) * HAL_AUDIO_CHANNELS;
+}
+
+void hal_audio_flush_buffer(void) {
+    if (!g_host_audio.initialized) return;
+    // The sink performs the discard so only the consumer ever moves read_index
+    audio_ring_end_stream(&g_host_audio.ring);
+    g_host_audio.flush_request = true;
+    wake(g_host_audio.data_cv);
+    std::unique_lock<std::mutex> lock(g_host_audio.wake_mutex);
+    g_host_audio.space_cv.wait_for(lock, std::chrono::milliseconds(20),
+                                   []() { return !g_host_audio.flush_request.load(); });
+}
+
+void hal_audio_end_stream(void) {
+    audio_ring_end_stream(&g_host_audio.ring);
+    wake(g_host_audio.data_cv);
+    wake(g_host_audio.space_cv);            // An already empty ring is now drained
+}
+
+// The sink's reads stand in for DMA completions: a flush reads what it drops
+uint32_t hal_audio_get_frames_written(void) {
+    return g_host_audio.ring.write_index.load(std::memory_order_acquire);
+}
+
+uint32_t hal_audio_get_frames_played(void) {
+    return g_host_audio.ring.read_index.load(std::memory_order_acquire);
+}
+
+// Performance and debugging
+void hal_audio_get_stats(uint32_t* samples_played, uint32_t* underruns, uint32_t* overruns) {
+    if (samples_played) *samples_played = g_host_audio.frames_played.load();
+    if (underruns) *underruns = g_host_audio.ring.underruns.load();
+    if (overruns) *overruns = g_host_audio.ring.overruns.load();
+}
+
+void hal_audio_reset_stats(void) {
+    g_host_audio.frames_played = 0;
+    audio_ring_reset_stats(&g_host_audio.ring);
+}
+
+void hal_audio_get_deadline_stats(hal_audio_deadline_stats_t* stats) {
+    audio_deadline_read(&g_host_audio.deadline, stats);
+}
+
+void hal_audio_reset_deadline_stats(void) {
+    audio_deadline_reset(&g_host_audio.deadline);
+}
+
+// Error handling
+hal_audio_error_t hal_audio_get_last_error(void) {
+    return g_host_audio.last_error;
+}
+
+const char* hal_audio_get_error_string(hal_audio_error_t error) {
+    switch (error) {
+        case HAL_AUDIO_ERROR_NONE:            return "No error";
+        case HAL_AUDIO_ERROR_INIT_FAILED:     return "Initialization failed";
+        case HAL_AUDIO_ERROR_INVALID_FORMAT:  return "Invalid format";
+        case HAL_AUDIO_ERROR_BUFFER_FULL:     return "Buffer full";
+        case HAL_AUDIO_ERROR_BUFFER_EMPTY:    return "Buffer empty";
+        case HAL_AUDIO_ERROR_FILE_NOT_FOUND:  return "File not found";
+        case HAL_AUDIO_ERROR_DECODE_FAILED:   return "Decode failed";
+        case HAL_AUDIO_ERROR_HARDWARE_FAULT:  return "Hardware fault";
+        default:                              return "Unknown error";
+    }
+}
+
+// Host emulation controls
+bool hal_audio_host_set_sink(hal_audio_host_sink_t sink, const char* wav_path) {
+    FILE* file = nullptr;
+    if (sink == HAL_AUDIO_HOST_SINK_WAV_FILE) {
+        if (!wav_path || !*wav_path) return false;
+        file = fopen(wav_path, "wb");
+        if (!file) {
+            printf("Host audio: cannot create %s\n", wav_path);
+            return false;
+        }
+        wav_write_header(file, g_host_audio.config.sample_rate, 0);    // Sizes patched on close
+    }
+
+    std::lock_guard<std::mutex> lock(g_host_audio.sink_mutex);
+    wav_close();
+    g_host_audio.wav_file = file;
+    g_host_audio.wav_data_bytes = 0;
+    if (sink == HAL_AUDIO_HOST_SINK_MEMORY) g_host_audio.memory.clear();
+    g_host_audio.sink = sink;
+    g_host_audio.sink_chosen = true;
+    return true;
+}
+
+hal_audio_host_sink_t hal_audio_host_get_sink(void) {
+    std::lock_guard<std::mutex> lock(g_host_audio.sink_mutex);
+    return g_host_audio.sink;
+}
+
+void hal_audio_host_set_offline(bool offline) {
+    g_host_audio.offline = offline;
+    g_host_audio.offline_chosen = true;
+    wake(g_host_audio.data_cv);
+}
+
+bool hal_audio_host_is_offline(void) {
+    return g_host_audio.offline.load();
+}
+
+size_t hal_audio_host_get_memory_samples(void) {
+    std::lock_guard<std::mutex> lock(g_host_audio.sink_mutex);
+    return g_host_audio.memory.size();
+}
+
+size_t hal_audio_host_copy_memory(int16_t* out, size_t offset, size_t count) {
+    if (!out) return 0;
+    std::lock_guard<std::mutex> lock(g_host_audio.sink_mutex);
+    if (offset >= g_host_audio.memory.size()) return 0;
+    if (count > g_host_audio.memory.size() - offset) count = g_host_audio.memory.size() - offset;
+    memcpy(out, g_host_audio.memory.data() + offset, count * sizeof(int16_t));
+    return count;
+}
+
+void hal_audio_host_clear_memory(void) {
+    std::lock_guard<std::mutex> lock(g_host_audio.sink_mutex);
+    g_host_audio.memory.clear();
+    g_host_audio.memory.shrink_to_fit();
+}
+
+bool hal_audio_host_wait_drained(uint32_t timeout_ms) {
+    if (!g_host_audio.initialized) return false;
+    auto drained = []() {
+        return (audio_ring_used_frames(&g_host_audio.ring) == 0 && !g_host_audio.ring.stream_active.load()) ||
+               !g_host_audio.sink_run.load();
+    };
+    std::unique_lock<std::mutex> lock(g_host_audio.wake_mutex);
+    if (timeout_ms == UINT32_MAX) {
+        g_host_audio.space_cv.wait(lock, drained);
+    } else {
+        g_host_audio.space_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), drained);
+    }
+    return audio_ring_used_frames(&g_host_audio.ring) == 0 && !g_host_audio.ring.stream_active.load();
+}
+
+} // extern "C"
+
+#endif // PLATFORM_HOST
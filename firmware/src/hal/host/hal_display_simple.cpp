@@ -1,16 +1,24 @@
 /*
  * Simple Host Display HAL Implementation (No SDL2)
  * For basic testing without graphics dependencies
+ *
+ * Runs the same tiled renderer as the ESP32 build against an in-memory
+ * panel. A pushed tile is not copied to the panel until the renderer waits
+ * for it, so tiles are in flight between update() and vsync() just as they
+ * are on the SPI bus, and the double-buffering is exercised.
  */
 
 #include "hal/hal_display.h"
 
 #ifdef PLATFORM_HOST
 
+#include "ui/ui_tiled_display.h"
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
 #include <stdlib.h>
+#include <deque>
+#include <vector>
 
 // Simple display state
 static struct {
@@ -22,10 +30,104 @@ static struct {
     hal_font_size_t text_size;
     int16_t cursor_x;
     int16_t cursor_y;
+    bool text_opaque;                   // A background was set after the text color
     uint32_t frames_rendered;
     uint32_t pixels_drawn;
+    ui_tiled_display_t tiles;
+    hal_display_tile_stats_t tile_stats;
 } g_simple_display;
 
+// In-memory panel
+struct host_pending_tile {
+    ui_rect_t rect;
+    const uint16_t* pixels;             // The renderer's tile, untouched until waited for
+};
+
+static struct {
+    std::vector<uint16_t> pixels;
+    uint16_t width;
+    uint16_t height;
+    std::deque<host_pending_tile> pending;
+} g_panel;
+
+static void panel_push(const ui_rect_t* rect, const uint16_t* pixels, void* user_data) {
+    (void)user_data;
+    g_panel.pending.push_back(host_pending_tile{*rect, pixels});
+    g_simple_display.tile_stats.tiles++;
+    g_simple_display.tile_stats.bytes += (uint64_t)ui_rect_area(*rect) * sizeof(uint16_t);
+}
+
+// The transfer completes here, when the renderer needs the tile back
+static void panel_wait(void* user_data) {
+    (void)user_data;
+    if (g_panel.pending.empty()) return;
+    const host_pending_tile tile = g_panel.pending.front();
+    g_panel.pending.pop_front();
+    for (int16_t row = 0; row < tile.rect.h; row++) {
+        memcpy(&g_panel.pixels[(size_t)(tile.rect.y + row) * g_panel.width + tile.rect.x],
+               tile.pixels + (size_t)row * tile.rect.w, tile.rect.w * sizeof(uint16_t));
+    }
+}
+
+static bool is_landscape(hal_display_rotation_t rotation) {
+    return rotation == HAL_DISPLAY_ROTATION_90 || rotation == HAL_DISPLAY_ROTATION_270;
+}
+
+static void panel_resize(void) {
+    bool landscape = is_landscape(g_simple_display.rotation);
+    g_panel.width = landscape ? HAL_DISPLAY_HEIGHT : HAL_DISPLAY_WIDTH;
+    g_panel.height = landscape ? HAL_DISPLAY_WIDTH : HAL_DISPLAY_HEIGHT;
+    g_panel.pixels.assign((size_t)g_panel.width * g_panel.height, HAL_COLOR_BLACK);
+}
+
+// Recording
+static void count_dropped(bool recorded) {
+    if (!recorded) g_simple_display.tile_stats.dropped_ops++;
+}
+
+static void record_text(int16_t x, int16_t y, const char* text) {
+    uint8_t size = (uint8_t)g_simple_display.text_size;
+    ui_display_list_t* list = &g_simple_display.tiles.frame;
+    if (g_simple_display.text_opaque) {
+        ui_rect_t cells = ui_text_bounds(x, y, text, size);
+        count_dropped(ui_display_list_fill_rect(list, cells.x, cells.y, cells.w, cells.h,
+                                                g_simple_display.text_bg_color));
+    }
+    count_dropped(ui_display_list_text(list, x, y, text, g_simple_display.text_color, size));
+}
+
+// At the cursor, as Adafruit GFX prints: newlines and wrapping at the right edge
+static void print_text(const char* str) {
+    int16_t cell = UI_FONT_CELL_W * g_simple_display.text_size;
+    char run[64];
+    size_t count = 0;
+    int16_t run_x = 0, run_y = 0;
+    for (const char* p = str; *p; p++) {
+        if (*p == '\r') continue;
+        if (*p == '\n' || g_simple_display.cursor_x + cell > g_panel.width) {
+            run[count] = '\0';
+            if (count) record_text(run_x, run_y, run);
+            count = 0;
+            g_simple_display.cursor_x = 0;
+            g_simple_display.cursor_y += UI_FONT_CELL_H * g_simple_display.text_size;
+            if (*p == '\n') continue;
+        }
+        if (count == 0) {
+            run_x = g_simple_display.cursor_x;
+            run_y = g_simple_display.cursor_y;
+        }
+        run[count++] = *p;
+        g_simple_display.cursor_x += cell;
+        if (count == sizeof(run) - 1) {
+            run[count] = '\0';
+            record_text(run_x, run_y, run);
+            count = 0;
+        }
+    }
+    run[count] = '\0';
+    if (count) record_text(run_x, run_y, run);
+}
+
 extern "C" {
 
 // Display initialization and control
@@ -41,8 +143,18 @@ bool hal_display_init(void) {
     g_simple_display.text_size = HAL_FONT_SIZE_MEDIUM;
     g_simple_display.cursor_x = 0;
     g_simple_display.cursor_y = 0;
+    g_simple_display.text_opaque = false;
     g_simple_display.frames_rendered = 0;
     g_simple_display.pixels_drawn = 0;
+    memset(&g_simple_display.tile_stats, 0, sizeof(g_simple_display.tile_stats));
+
+    panel_resize();
+    const ui_panel_t panel = {panel_push, panel_wait, NULL};
+    if (!ui_tiled_display_init(&g_simple_display.tiles, g_panel.width, g_panel.height,
+                               HAL_DISPLAY_TILE_ROWS, &panel)) {
+        printf("Simple display HAL: no memory for the tiles\n");
+        return false;
+    }
     
     g_simple_display.initialized = true;
     printf("Simple display HAL initialized (%dx%d)\n", HAL_DISPLAY_WIDTH, HAL_DISPLAY_HEIGHT);
@@ -51,6 +163,9 @@ bool hal_display_init(void) {
 }
 
 void hal_display_deinit(void) {
+    if (g_simple_display.initialized) {
+        ui_tiled_display_deinit(&g_simple_display.tiles);
+    }
     g_simple_display.initialized = false;
     printf("Simple display HAL deinitialized\n");
 }
@@ -61,15 +176,24 @@ bool hal_display_is_initialized(void) {
 
 // Display properties
 uint16_t hal_display_get_width(void) {
-    return HAL_DISPLAY_WIDTH;
+    return is_landscape(g_simple_display.rotation) ? HAL_DISPLAY_HEIGHT : HAL_DISPLAY_WIDTH;
 }
 
 uint16_t hal_display_get_height(void) {
-    return HAL_DISPLAY_HEIGHT;
+    return is_landscape(g_simple_display.rotation) ? HAL_DISPLAY_WIDTH : HAL_DISPLAY_HEIGHT;
 }
 
 void hal_display_set_rotation(hal_display_rotation_t rotation) {
+    if (!g_simple_display.initialized) {
+        g_simple_display.rotation = rotation;
+        return;
+    }
+
+    // Tiles in flight land on the old panel layout first
+    ui_tiled_display_sync(&g_simple_display.tiles);
     g_simple_display.rotation = rotation;
+    panel_resize();
+    ui_tiled_display_resize(&g_simple_display.tiles, g_panel.width, g_panel.height);
 }
 
 hal_display_rotation_t hal_display_get_rotation(void) {
@@ -91,6 +215,7 @@ void hal_display_clear(uint16_t color) {
     if (!g_simple_display.initialized) return;
     
     printf("Display cleared with color 0x%04X\n", color);
+    ui_display_list_clear(&g_simple_display.tiles.frame, color);
     g_simple_display.frames_rendered++;
     g_simple_display.pixels_drawn += HAL_DISPLAY_WIDTH * HAL_DISPLAY_HEIGHT;
 }
@@ -101,14 +226,16 @@ void hal_display_fill_screen(uint16_t color) {
 
 void hal_display_set_pixel(int16_t x, int16_t y, uint16_t color) {
     if (!g_simple_display.initialized) return;
-    if (x < 0 || x >= HAL_DISPLAY_WIDTH || y < 0 || y >= HAL_DISPLAY_HEIGHT) return;
+    if (x < 0 || x >= g_panel.width || y < 0 || y >= g_panel.height) return;
     
     printf("Pixel set at (%d,%d) with color 0x%04X\n", x, y, color);
+    count_dropped(ui_display_list_fill_rect(&g_simple_display.tiles.frame, x, y, 1, 1, color));
     g_simple_display.pixels_drawn++;
 }
 
 uint16_t hal_display_get_pixel(int16_t x, int16_t y) {
-    return HAL_COLOR_BLACK;
+    if (!g_simple_display.initialized) return HAL_COLOR_BLACK;
+    return ui_tiled_display_pixel(&g_simple_display.tiles, x, y);
 }
 
 // Shape drawing
@@ -116,6 +243,7 @@ void hal_display_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint1
     if (!g_simple_display.initialized) return;
     
     printf("Line drawn from (%d,%d) to (%d,%d) with color 0x%04X\n", x0, y0, x1, y1, color);
+    count_dropped(ui_display_list_line(&g_simple_display.tiles.frame, x0, y0, x1, y1, color));
     g_simple_display.pixels_drawn += abs(x1 - x0) + abs(y1 - y0);
 }
 
@@ -123,6 +251,7 @@ void hal_display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t
     if (!g_simple_display.initialized) return;
     
     printf("Rectangle drawn at (%d,%d) size %dx%d with color 0x%04X\n", x, y, w, h, color);
+    count_dropped(ui_display_list_rect(&g_simple_display.tiles.frame, x, y, w, h, color));
     g_simple_display.pixels_drawn += (w + h) * 2;
 }
 
@@ -130,6 +259,7 @@ void hal_display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t
     if (!g_simple_display.initialized) return;
     
     printf("Rectangle filled at (%d,%d) size %dx%d with color 0x%04X\n", x, y, w, h, color);
+    count_dropped(ui_display_list_fill_rect(&g_simple_display.tiles.frame, x, y, w, h, color));
     g_simple_display.pixels_drawn += w * h;
 }
 
@@ -137,6 +267,7 @@ void hal_display_draw_circle(int16_t x, int16_t y, int16_t r, uint16_t color) {
     if (!g_simple_display.initialized) return;
     
     printf("Circle drawn at (%d,%d) radius %d with color 0x%04X\n", x, y, r, color);
+    count_dropped(ui_display_list_circle(&g_simple_display.tiles.frame, x, y, r, color, false));
     g_simple_display.pixels_drawn += r * 6;
 }
 
@@ -144,6 +275,7 @@ void hal_display_fill_circle(int16_t x, int16_t y, int16_t r, uint16_t color) {
     if (!g_simple_display.initialized) return;
     
     printf("Circle filled at (%d,%d) radius %d with color 0x%04X\n", x, y, r, color);
+    count_dropped(ui_display_list_circle(&g_simple_display.tiles.frame, x, y, r, color, true));
     g_simple_display.pixels_drawn += r * r * 3;
 }
 
@@ -151,6 +283,7 @@ void hal_display_draw_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, i
     if (!g_simple_display.initialized) return;
     
     printf("Triangle drawn at (%d,%d) (%d,%d) (%d,%d) with color 0x%04X\n", x0, y0, x1, y1, x2, y2, color);
+    count_dropped(ui_display_list_triangle(&g_simple_display.tiles.frame, x0, y0, x1, y1, x2, y2, color, false));
     g_simple_display.pixels_drawn += 100; // Approximate
 }
 
@@ -158,16 +291,19 @@ void hal_display_fill_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, i
     if (!g_simple_display.initialized) return;
     
     printf("Triangle filled at (%d,%d) (%d,%d) (%d,%d) with color 0x%04X\n", x0, y0, x1, y1, x2, y2, color);
+    count_dropped(ui_display_list_triangle(&g_simple_display.tiles.frame, x0, y0, x1, y1, x2, y2, color, true));
     g_simple_display.pixels_drawn += 200; // Approximate
 }
 
 // Text rendering
 void hal_display_set_text_color(uint16_t color) {
     g_simple_display.text_color = color;
+    g_simple_display.text_opaque = false;
 }
 
 void hal_display_set_text_background(uint16_t color) {
     g_simple_display.text_bg_color = color;
+    g_simple_display.text_opaque = true;
 }
 
 void hal_display_set_text_size(hal_font_size_t size) {
@@ -183,6 +319,8 @@ void hal_display_print_char(char c) {
     if (!g_simple_display.initialized) return;
     
     printf("%c", c);
+    const char text[2] = {c, '\0'};
+    print_text(text);
     g_simple_display.pixels_drawn += 6 * 8 * g_simple_display.text_size;
 }
 
@@ -190,16 +328,21 @@ void hal_display_print_string(const char* str) {
     if (!g_simple_display.initialized || !str) return;
     
     printf("%s", str);
+    print_text(str);
     g_simple_display.pixels_drawn += strlen(str) * 6 * 8 * g_simple_display.text_size;
 }
 
 void hal_display_printf(const char* format, ...) {
     if (!g_simple_display.initialized || !format) return;
     
+    char buffer[256];
     va_list args;
     va_start(args, format);
-    vprintf(format, args);
+    vsnprintf(buffer, sizeof(buffer), format, args);
     va_end(args);
+    
+    printf("%s", buffer);
+    print_text(buffer);
 }
 
 // Advanced text rendering
@@ -207,6 +350,13 @@ void hal_display_draw_text(int16_t x, int16_t y, const char* text, uint16_t colo
     if (!g_simple_display.initialized || !text) return;
     
     printf("Text at (%d,%d): %s (color: 0x%04X, size: %d)\n", x, y, text, color, size);
+    // Leaves the cursor, color and size set, as on the panel
+    g_simple_display.cursor_x = x;
+    g_simple_display.cursor_y = y;
+    g_simple_display.text_color = color;
+    g_simple_display.text_opaque = false;
+    g_simple_display.text_size = size;
+    print_text(text);
     g_simple_display.pixels_drawn += strlen(text) * 6 * 8 * size;
 }
 
@@ -216,6 +366,20 @@ void hal_display_draw_text_aligned(int16_t x, int16_t y, int16_t w, const char*
     
     printf("Text aligned at (%d,%d) width %d: %s (color: 0x%04X, size: %d, align: %d)\n", 
            x, y, w, text, color, size, align);
+    
+    int16_t text_width = strlen(text) * 6 * size;
+    int16_t text_x = x;
+    if (align == HAL_TEXT_ALIGN_CENTER) {
+        text_x = x + (w - text_width) / 2;
+    } else if (align == HAL_TEXT_ALIGN_RIGHT) {
+        text_x = x + w - text_width;
+    }
+    g_simple_display.cursor_x = text_x;
+    g_simple_display.cursor_y = y;
+    g_simple_display.text_color = color;
+    g_simple_display.text_opaque = false;
+    g_simple_display.text_size = size;
+    print_text(text);
     g_simple_display.pixels_drawn += strlen(text) * 6 * 8 * size;
 }
 
@@ -225,6 +389,7 @@ void hal_display_draw_bitmap(int16_t x, int16_t y, const uint8_t* bitmap,
     if (!g_simple_display.initialized || !bitmap) return;
     
     printf("Bitmap drawn at (%d,%d) size %dx%d with color 0x%04X\n", x, y, w, h, color);
+    count_dropped(ui_display_list_bitmap(&g_simple_display.tiles.frame, x, y, bitmap, w, h, color));
     g_simple_display.pixels_drawn += w * h;
 }
 
@@ -232,16 +397,17 @@ void hal_display_draw_rgb_bitmap(int16_t x, int16_t y, const uint16_t* bitmap, i
     if (!g_simple_display.initialized || !bitmap) return;
     
     printf("RGB bitmap drawn at (%d,%d) size %dx%d\n", x, y, w, h);
+    count_dropped(ui_display_list_rgb_bitmap(&g_simple_display.tiles.frame, x, y, bitmap, w, h));
     g_simple_display.pixels_drawn += w * h;
 }
 
 // Buffer operations
 void hal_display_start_write(void) {
-    // No-op in simple implementation
+    // No-op: nothing reaches the panel before hal_display_update()
 }
 
 void hal_display_end_write(void) {
-    // No-op in simple implementation
+    // No-op: nothing reaches the panel before hal_display_update()
 }
 
 void hal_display_write_pixel(int16_t x, int16_t y, uint16_t color) {
@@ -254,18 +420,24 @@ void hal_display_write_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uin
 
 // Display refresh and synchronization
 void hal_display_update(void) {
-    if (g_simple_display.initialized) {
-        g_simple_display.frames_rendered++;
+    if (!g_simple_display.initialized) return;
+    
+    uint32_t bytes = ui_tiled_display_update(&g_simple_display.tiles) * sizeof(uint16_t);
+    if (bytes) {
+        g_simple_display.tile_stats.frames++;
+        g_simple_display.tile_stats.last_frame_bytes = bytes;
     }
+    g_simple_display.frames_rendered++;
 }
 
 void hal_display_vsync(void) {
-    // Simple delay
-    // usleep(16000); // ~60 FPS
+    if (g_simple_display.initialized) {
+        ui_tiled_display_sync(&g_simple_display.tiles);
+    }
 }
 
 bool hal_display_is_busy(void) {
-    return false;
+    return !g_panel.pending.empty();
 }
 
 // Color utilities
@@ -290,6 +462,23 @@ void hal_display_reset_stats(void) {
     g_simple_display.pixels_drawn = 0;
 }
 
+void hal_display_get_tile_stats(hal_display_tile_stats_t* stats) {
+    if (stats) *stats = g_simple_display.tile_stats;
+}
+
+void hal_display_reset_tile_stats(void) {
+    memset(&g_simple_display.tile_stats, 0, sizeof(g_simple_display.tile_stats));
+}
+
+// Host emulation controls
+size_t hal_display_host_copy_panel(uint16_t* out, size_t count) {
+    size_t total = g_panel.pixels.size();
+    if (!out) return total;
+    if (count > total) count = total;
+    memcpy(out, g_panel.pixels.data(), count * sizeof(uint16_t));
+    return count;
+}
+
 } // extern "C"
 
 #endif // PLATFORM_HOST
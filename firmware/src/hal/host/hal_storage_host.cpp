@@ -0,0 +1,406 @@
+/*
+ * Host Hardware Abstraction Layer - Storage Implementation
+ * Emulates the SD card with a directory on the host filesystem
+ */
+
+#include "hal/hal_storage.h"
+
+#ifdef PLATFORM_HOST
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+// Host storage state
+static struct {
+    bool initialized;
+    bool mounted;
+    std::string root;
+    hal_storage_error_t last_error;
+    std::atomic<uint32_t> reads;            // Read-ahead task and decoders read concurrently
+    std::atomic<uint32_t> writes;
+    std::atomic<uint32_t> read_latency_us;
+} g_host_storage;
+
+struct host_file {
+    FILE* fp;
+};
+
+struct host_dir {
+    std::string path;
+    std::vector<fs::directory_entry> entries;
+    size_t next;
+};
+
+static std::string resolve_path(const char* path) {
+    if (g_host_storage.root.empty()) {
+        const char* env = getenv("IZOD_SD_ROOT");
+        g_host_storage.root = env && *env ? env : "sdcard";
+    }
+    std::string p = path ? path : "";
+    while (!p.empty() && p[0] == '/') p.erase(0, 1);
+    return (fs::path(g_host_storage.root) / p).string();
+}
+
+static void fill_file_info(const fs::directory_entry& entry, const char* card_path, hal_storage_file_info_t* info) {
+    std::error_code ec;
+    memset(info, 0, sizeof(*info));
+    snprintf(info->name, sizeof(info->name), "%s", entry.path().filename().string().c_str());
+    snprintf(info->path, sizeof(info->path), "%s", card_path);
+    if (entry.is_directory(ec)) {
+        info->type = HAL_STORAGE_TYPE_DIRECTORY;
+    } else if (entry.is_regular_file(ec)) {
+        info->type = HAL_STORAGE_TYPE_FILE;
+        info->size = entry.file_size(ec);
+    } else {
+        info->type = HAL_STORAGE_TYPE_UNKNOWN;
+    }
+    info->hidden = info->name[0] == '.';
+}
+
+extern "C" {
+
+// Storage initialization and control
+bool hal_storage_init(void) {
+    if (g_host_storage.initialized) return true;
+    std::error_code ec;
+    fs::create_directories(resolve_path("/"), ec);
+    g_host_storage.initialized = true;
+    g_host_storage.mounted = true;
+    g_host_storage.last_error = HAL_STORAGE_ERROR_NONE;
+    printf("Host storage HAL initialized (root: %s)\n", g_host_storage.root.c_str());
+    return true;
+}
+
+void hal_storage_deinit(void) {
+    g_host_storage.initialized = false;
+    g_host_storage.mounted = false;
+}
+
+bool hal_storage_is_initialized(void) {
+    return g_host_storage.initialized;
+}
+
+// Mount/unmount operations
+bool hal_storage_mount(void) {
+    g_host_storage.mounted = true;
+    return true;
+}
+
+bool hal_storage_unmount(void) {
+    g_host_storage.mounted = false;
+    return true;
+}
+
+bool hal_storage_is_mounted(void) {
+    return g_host_storage.mounted;
+}
+
+// File operations
+hal_storage_file_t hal_storage_open(const char* path, hal_storage_mode_t mode) {
+    if (!path) {
+        g_host_storage.last_error = HAL_STORAGE_ERROR_INVALID_PATH;
+        return nullptr;
+    }
+
+    const char* fmode = "rb";
+    if (mode & HAL_STORAGE_MODE_APPEND) {
+        fmode = (mode & HAL_STORAGE_MODE_READ) ? "a+b" : "ab";
+    } else if (mode & HAL_STORAGE_MODE_WRITE) {
+        fmode = (mode & HAL_STORAGE_MODE_READ) ? "w+b" : "wb";
+    }
+
+    FILE* fp = fopen(resolve_path(path).c_str(), fmode);
+    if (!fp) {
+        g_host_storage.last_error = HAL_STORAGE_ERROR_FILE_NOT_FOUND;
+        return nullptr;
+    }
+    host_file* file = new host_file();
+    file->fp = fp;
+    return (hal_storage_file_t)file;
+}
+
+void hal_storage_close(hal_storage_file_t file) {
+    if (!file) return;
+    host_file* f = (host_file*)file;
+    if (f->fp) fclose(f->fp);
+    delete f;
+}
+
+bool hal_storage_is_open(hal_storage_file_t file) {
+    return file && ((host_file*)file)->fp;
+}
+
+// File I/O operations
+size_t hal_storage_read(hal_storage_file_t file, void* buffer, size_t size) {
+    if (!file || !buffer) return 0;
+    g_host_storage.reads++;
+    uint32_t latency = g_host_storage.read_latency_us.load();
+    if (latency) std::this_thread::sleep_for(std::chrono::microseconds(latency));
+    return fread(buffer, 1, size, ((host_file*)file)->fp);
+}
+
+size_t hal_storage_write(hal_storage_file_t file, const void* buffer, size_t size) {
+    if (!file || !buffer) return 0;
+    g_host_storage.writes++;
+    return fwrite(buffer, 1, size, ((host_file*)file)->fp);
+}
+
+bool hal_storage_flush(hal_storage_file_t file) {
+    return file && fflush(((host_file*)file)->fp) == 0;
+}
+
+bool hal_storage_sync(hal_storage_file_t file) {
+    return hal_storage_flush(file);
+}
+
+// File positioning
+bool hal_storage_seek(hal_storage_file_t file, int64_t offset, hal_storage_seek_t origin) {
+    if (!file) return false;
+    int whence = origin == HAL_STORAGE_SEEK_CUR ? SEEK_CUR : origin == HAL_STORAGE_SEEK_END ? SEEK_END : SEEK_SET;
+    return fseeko(((host_file*)file)->fp, (off_t)offset, whence) == 0;
+}
+
+int64_t hal_storage_tell(hal_storage_file_t file) {
+    if (!file) return -1;
+    return (int64_t)ftello(((host_file*)file)->fp);
+}
+
+bool hal_storage_rewind(hal_storage_file_t file) {
+    return hal_storage_seek(file, 0, HAL_STORAGE_SEEK_SET);
+}
+
+bool hal_storage_eof(hal_storage_file_t file) {
+    if (!file) return true;
+    FILE* fp = ((host_file*)file)->fp;
+    int c = fgetc(fp);
+    if (c == EOF) return true;
+    ungetc(c, fp);
+    return false;
+}
+
+// File information and properties
+bool hal_storage_get_file_info(const char* path, hal_storage_file_info_t* info) {
+    if (!path || !info) return false;
+    std::error_code ec;
+    fs::directory_entry entry(resolve_path(path), ec);
+    if (ec || !entry.exists(ec)) {
+        g_host_storage.last_error = HAL_STORAGE_ERROR_FILE_NOT_FOUND;
+        return false;
+    }
+    fill_file_info(entry, path, info);
+    return true;
+}
+
+uint64_t hal_storage_get_file_size(const char* path) {
+    std::error_code ec;
+    uint64_t size = fs::file_size(resolve_path(path), ec);
+    return ec ? 0 : size;
+}
+
+uint64_t hal_storage_get_file_size_handle(hal_storage_file_t file) {
+    if (!file) return 0;
+    FILE* fp = ((host_file*)file)->fp;
+    off_t pos = ftello(fp);
+    fseeko(fp, 0, SEEK_END);
+    off_t size = ftello(fp);
+    fseeko(fp, pos, SEEK_SET);
+    return size < 0 ? 0 : (uint64_t)size;
+}
+
+bool hal_storage_file_exists(const char* path) {
+    std::error_code ec;
+    return path && fs::exists(resolve_path(path), ec);
+}
+
+// File management
+bool hal_storage_delete_file(const char* path) {
+    std::error_code ec;
+    return path && fs::remove(resolve_path(path), ec);
+}
+
+bool hal_storage_rename_file(const char* old_path, const char* new_path) {
+    if (!old_path || !new_path) return false;
+    std::error_code ec;
+    fs::rename(resolve_path(old_path), resolve_path(new_path), ec);
+    return !ec;
+}
+
+// Directory operations
+bool hal_storage_create_dir(const char* path) {
+    if (!path) return false;
+    std::error_code ec;
+    fs::create_directories(resolve_path(path), ec);
+    return !ec;
+}
+
+bool hal_storage_dir_exists(const char* path) {
+    std::error_code ec;
+    return path && fs::is_directory(resolve_path(path), ec);
+}
+
+// Directory listing
+hal_storage_dir_t hal_storage_open_dir(const char* path) {
+    if (!path) return nullptr;
+    std::error_code ec;
+    fs::directory_iterator it(resolve_path(path), ec);
+    if (ec) {
+        g_host_storage.last_error = HAL_STORAGE_ERROR_FILE_NOT_FOUND;
+        return nullptr;
+    }
+
+    host_dir* dir = new host_dir();
+    dir->path = path;
+    for (const auto& entry : it) dir->entries.push_back(entry);
+    // Directory order is unspecified on the host; sort for repeatable listings
+    std::sort(dir->entries.begin(), dir->entries.end(),
+              [](const fs::directory_entry& a, const fs::directory_entry& b) { return a.path() < b.path(); });
+    dir->next = 0;
+    return (hal_storage_dir_t)dir;
+}
+
+void hal_storage_close_dir(hal_storage_dir_t dir) {
+    delete (host_dir*)dir;
+}
+
+bool hal_storage_read_dir(hal_storage_dir_t dir, hal_storage_file_info_t* info) {
+    if (!dir || !info) return false;
+    host_dir* d = (host_dir*)dir;
+    if (d->next >= d->entries.size()) return false;
+
+    const fs::directory_entry& entry = d->entries[d->next++];
+    char card_path[HAL_STORAGE_MAX_PATH_LENGTH];
+    hal_storage_join_path(card_path, sizeof(card_path), d->path.c_str(),
+                          entry.path().filename().string().c_str());
+    fill_file_info(entry, card_path, info);
+    return true;
+}
+
+void hal_storage_rewind_dir(hal_storage_dir_t dir) {
+    if (dir) ((host_dir*)dir)->next = 0;
+}
+
+// Path utilities
+bool hal_storage_is_absolute_path(const char* path) {
+    return path && path[0] == '/';
+}
+
+bool hal_storage_join_path(char* result, size_t result_size, const char* base, const char* relative) {
+    if (!result || !base || !relative) return false;
+    size_t len = strlen(base);
+    const char* sep = (len > 0 && base[len - 1] == '/') ? "" : "/";
+    int n = snprintf(result, result_size, "%s%s%s", base, sep, relative);
+    return n >= 0 && (size_t)n < result_size;
+}
+
+bool hal_storage_get_filename(const char* path, char* filename, size_t filename_size) {
+    if (!path || !filename) return false;
+    const char* slash = strrchr(path, '/');
+    int n = snprintf(filename, filename_size, "%s", slash ? slash + 1 : path);
+    return n >= 0 && (size_t)n < filename_size;
+}
+
+bool hal_storage_get_extension(const char* path, char* extension, size_t extension_size) {
+    if (!path || !extension || extension_size == 0) return false;
+    const char* slash = strrchr(path, '/');
+    const char* dot = strrchr(slash ? slash : path, '.');
+    if (!dot || dot[1] == '\0') {
+        extension[0] = '\0';
+        return false;
+    }
+    int n = snprintf(extension, extension_size, "%s", dot + 1);
+    return n >= 0 && (size_t)n < extension_size;
+}
+
+// Convenience functions for common file operations
+bool hal_storage_read_file_to_buffer(const char* path, void** buffer, size_t* size) {
+    if (!path || !buffer || !size) return false;
+    hal_storage_file_t file = hal_storage_open(path, HAL_STORAGE_MODE_READ);
+    if (!file) return false;
+
+    size_t length = (size_t)hal_storage_get_file_size_handle(file);
+    uint8_t* data = (uint8_t*)malloc(length + 1);
+    bool ok = data && hal_storage_read(file, data, length) == length;
+    hal_storage_close(file);
+    if (!ok) {
+        free(data);
+        g_host_storage.last_error = HAL_STORAGE_ERROR_IO_ERROR;
+        return false;
+    }
+    data[length] = 0;   // Text files can be used as C strings
+    *buffer = data;
+    *size = length;
+    return true;
+}
+
+bool hal_storage_write_buffer_to_file(const char* path, const void* buffer, size_t size) {
+    if (!path || (!buffer && size)) return false;
+    hal_storage_file_t file = hal_storage_open(path, HAL_STORAGE_MODE_WRITE);
+    if (!file) return false;
+    bool ok = hal_storage_write(file, buffer, size) == size;
+    hal_storage_close(file);
+    return ok;
+}
+
+// Performance monitoring
+void hal_storage_get_stats(uint32_t* reads, uint32_t* writes, uint32_t* cache_hits, uint32_t* cache_misses) {
+    if (reads) *reads = g_host_storage.reads;
+    if (writes) *writes = g_host_storage.writes;
+    if (cache_hits) *cache_hits = 0;
+    if (cache_misses) *cache_misses = 0;
+}
+
+void hal_storage_reset_stats(void) {
+    g_host_storage.reads = 0;
+    g_host_storage.writes = 0;
+}
+
+// Error handling
+hal_storage_error_t hal_storage_get_last_error(void) {
+    return g_host_storage.last_error;
+}
+
+const char* hal_storage_get_error_string(hal_storage_error_t error) {
+    switch (error) {
+        case HAL_STORAGE_ERROR_NONE:            return "No error";
+        case HAL_STORAGE_ERROR_INIT_FAILED:     return "Initialization failed";
+        case HAL_STORAGE_ERROR_NOT_MOUNTED:     return "Not mounted";
+        case HAL_STORAGE_ERROR_FILE_NOT_FOUND:  return "File not found";
+        case HAL_STORAGE_ERROR_ACCESS_DENIED:   return "Access denied";
+        case HAL_STORAGE_ERROR_DISK_FULL:       return "Disk full";
+        case HAL_STORAGE_ERROR_READ_ONLY:       return "Read only";
+        case HAL_STORAGE_ERROR_INVALID_PATH:    return "Invalid path";
+        case HAL_STORAGE_ERROR_IO_ERROR:        return "I/O error";
+        case HAL_STORAGE_ERROR_CORRUPTED:       return "Corrupted";
+        case HAL_STORAGE_ERROR_NO_CARD:         return "No card";
+        default:                                return "Unknown error";
+    }
+}
+
+// Host emulation controls
+void hal_storage_host_set_root(const char* directory) {
+    g_host_storage.root = directory ? directory : "";
+}
+
+const char* hal_storage_host_get_root(void) {
+    if (g_host_storage.root.empty()) resolve_path("/");
+    return g_host_storage.root.c_str();
+}
+
+void hal_storage_host_set_read_latency_us(uint32_t latency_us) {
+    g_host_storage.read_latency_us = latency_us;
+}
+
+} // extern "C"
+
+#endif // PLATFORM_HOST
@@ -12,7 +12,10 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <deque>
+#include <vector>
 #include <map>
+#include <atomic>
 #include <random>
 #include <cstdio>
 #include <cstdlib>
@@ -40,6 +43,7 @@ static struct {
     // NVS simulation (file-based)
     std::string nvs_directory;
     
+    std::atomic<uint32_t> alloc_count;
 } g_host_system;
 
 // Task wrapper structure
@@ -51,6 +55,23 @@ struct host_task_info {
     bool running;
 };
 
+// Counting semaphore and FIFO queue with FreeRTOS blocking semantics
+struct host_semaphore {
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t count;
+    uint32_t max_count;
+};
+
+struct host_queue {
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<std::vector<uint8_t>> items;
+    uint32_t length;
+    uint32_t item_size;
+};
+
 // Helper functions
 static std::string get_nvs_filename(const char* namespace_name, const char* key);
 static void ensure_nvs_directory();
@@ -69,7 +90,7 @@ bool hal_system_init(void) {
     g_host_system.log_user_data = nullptr;
     g_host_system.event_callback = nullptr;
     g_host_system.event_user_data = nullptr;
-    g_host_system.next_task_id = 1;
+    g_host_system.next_task_id = 0;
     
     // Initialize random generator
     g_host_system.random_generator.seed(std::chrono::steady_clock::now().time_since_epoch().count());
@@ -94,15 +115,18 @@ void hal_system_deinit(void) {
         return;
     }
     
-    // Clean up all tasks
-    std::lock_guard<std::mutex> lock(g_host_system.tasks_mutex);
-    for (auto& pair : g_host_system.tasks) {
+    // Clean up all tasks, joined outside the lock like hal_system_delete_task()
+    std::map<hal_task_handle_t, std::thread*> tasks;
+    {
+        std::lock_guard<std::mutex> lock(g_host_system.tasks_mutex);
+        tasks.swap(g_host_system.tasks);
+    }
+    for (auto& pair : tasks) {
         if (pair.second && pair.second->joinable()) {
             pair.second->join();
         }
         delete pair.second;
     }
-    g_host_system.tasks.clear();
     
     g_host_system.initialized = false;
     printf("Host system HAL deinitialized\n");
@@ -217,14 +241,17 @@ uint32_t hal_system_get_max_alloc_heap(void) {
 }
 
 void* hal_system_malloc(size_t size) {
+    g_host_system.alloc_count.fetch_add(1, std::memory_order_relaxed);
     return malloc(size);
 }
 
 void* hal_system_calloc(size_t num, size_t size) {
+    g_host_system.alloc_count.fetch_add(1, std::memory_order_relaxed);
     return calloc(num, size);
 }
 
 void* hal_system_realloc(void* ptr, size_t size) {
+    g_host_system.alloc_count.fetch_add(1, std::memory_order_relaxed);
     return realloc(ptr, size);
 }
 
@@ -232,6 +259,15 @@ void hal_system_free(void* ptr) {
     free(ptr);
 }
 
+void* hal_system_malloc_psram(size_t size) {
+    g_host_system.alloc_count.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size);
+}
+
+uint32_t hal_system_get_alloc_count(void) {
+    return g_host_system.alloc_count.load(std::memory_order_relaxed);
+}
+
 // System reset and power control
 void hal_system_reset(void) {
     printf("System reset requested - exiting\n");
@@ -325,7 +361,8 @@ hal_task_handle_t hal_system_create_task(hal_task_function_t function,
     
     std::lock_guard<std::mutex> lock(g_host_system.tasks_mutex);
     
-    hal_task_handle_t handle = (hal_task_handle_t)g_host_system.next_task_id++;
+    // Ids start at 1 even before hal_system_init(); a NULL handle means failure
+    hal_task_handle_t handle = (hal_task_handle_t)(uintptr_t)++g_host_system.next_task_id;
     
     auto task_info = new host_task_info{
         function,
@@ -347,18 +384,29 @@ hal_task_handle_t hal_system_create_task(hal_task_function_t function,
 }
 
 void hal_system_delete_task(hal_task_handle_t task) {
-    if (!task) return;
-    
-    std::lock_guard<std::mutex> lock(g_host_system.tasks_mutex);
-    
-    auto it = g_host_system.tasks.find(task);
-    if (it != g_host_system.tasks.end()) {
-        if (it->second && it->second->joinable()) {
-            it->second->join();
+    std::thread* thread = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_host_system.tasks_mutex);
+        auto it = g_host_system.tasks.begin();
+        if (task) {
+            it = g_host_system.tasks.find(task);
+        } else {
+            // NULL (self-delete): the calling task's own entry
+            while (it != g_host_system.tasks.end() && it->second->get_id() != std::this_thread::get_id()) ++it;
         }
-        delete it->second;
+        if (it == g_host_system.tasks.end()) return;
+        thread = it->second;
         g_host_system.tasks.erase(it);
     }
+
+    // Joined outside the lock, as the task may be deleting itself meanwhile; a
+    // task deleting itself is detached and ends when its function returns
+    if (thread->get_id() == std::this_thread::get_id()) {
+        thread->detach();
+    } else if (thread->joinable()) {
+        thread->join();
+    }
+    delete thread;
 }
 
 void hal_system_suspend_task(hal_task_handle_t task) {
@@ -420,7 +468,7 @@ bool hal_system_list_tasks(hal_task_info_t* tasks, uint32_t max_tasks, uint32_t*
     return true;
 }
 
-// Synchronization primitives (simplified implementations)
+// Synchronization primitives
 hal_mutex_t hal_system_create_mutex(void) {
     return (hal_mutex_t)(new std::mutex());
 }
@@ -450,49 +498,93 @@ void hal_system_give_mutex(hal_mutex_t mutex) {
 }
 
 hal_semaphore_t hal_system_create_semaphore(uint32_t max_count, uint32_t initial_count) {
-    // Simplified semaphore using condition variable
-    return (hal_semaphore_t)(new std::condition_variable());
+    auto sem = new host_semaphore();
+    sem->max_count = max_count ? max_count : 1;
+    sem->count = initial_count < sem->max_count ? initial_count : sem->max_count;
+    return (hal_semaphore_t)sem;
 }
 
 void hal_system_delete_semaphore(hal_semaphore_t semaphore) {
     if (semaphore) {
-        delete (std::condition_variable*)semaphore;
+        delete (host_semaphore*)semaphore;
     }
 }
 
 bool hal_system_take_semaphore(hal_semaphore_t semaphore, uint32_t timeout_ms) {
-    // Simplified implementation
-    if (timeout_ms > 0) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+    if (!semaphore) return false;
+
+    host_semaphore* sem = (host_semaphore*)semaphore;
+    std::unique_lock<std::mutex> lock(sem->mutex);
+    auto available = [sem]() { return sem->count > 0; };
+    if (timeout_ms == UINT32_MAX) {
+        sem->cv.wait(lock, available);
+    } else if (!sem->cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), available)) {
+        return false;
     }
+    sem->count--;
     return true;
 }
 
 void hal_system_give_semaphore(hal_semaphore_t semaphore) {
-    if (semaphore) {
-        ((std::condition_variable*)semaphore)->notify_one();
+    if (!semaphore) return;
+
+    host_semaphore* sem = (host_semaphore*)semaphore;
+    {
+        std::lock_guard<std::mutex> lock(sem->mutex);
+        if (sem->count < sem->max_count) sem->count++;
     }
+    sem->cv.notify_one();
 }
 
 hal_queue_t hal_system_create_queue(uint32_t length, uint32_t item_size) {
-    // Simplified queue implementation
-    return (hal_queue_t)(new std::queue<std::vector<uint8_t>>());
+    if (length == 0 || item_size == 0) return nullptr;
+
+    auto queue = new host_queue();
+    queue->length = length;
+    queue->item_size = item_size;
+    return (hal_queue_t)queue;
 }
 
 void hal_system_delete_queue(hal_queue_t queue) {
     if (queue) {
-        delete (std::queue<std::vector<uint8_t>>*)queue;
+        delete (host_queue*)queue;
     }
 }
 
 bool hal_system_queue_send(hal_queue_t queue, const void* item, uint32_t timeout_ms) {
-    // Simplified implementation
+    if (!queue || !item) return false;
+
+    host_queue* q = (host_queue*)queue;
+    std::unique_lock<std::mutex> lock(q->mutex);
+    auto has_room = [q]() { return q->items.size() < q->length; };
+    if (timeout_ms == UINT32_MAX) {
+        q->not_full.wait(lock, has_room);
+    } else if (!q->not_full.wait_for(lock, std::chrono::milliseconds(timeout_ms), has_room)) {
+        return false;
+    }
+    const uint8_t* bytes = (const uint8_t*)item;
+    q->items.emplace_back(bytes, bytes + q->item_size);
+    lock.unlock();
+    q->not_empty.notify_one();
     return true;
 }
 
 bool hal_system_queue_receive(hal_queue_t queue, void* item, uint32_t timeout_ms) {
-    // Simplified implementation
-    return false;
+    if (!queue || !item) return false;
+
+    host_queue* q = (host_queue*)queue;
+    std::unique_lock<std::mutex> lock(q->mutex);
+    auto has_item = [q]() { return !q->items.empty(); };
+    if (timeout_ms == UINT32_MAX) {
+        q->not_empty.wait(lock, has_item);
+    } else if (!q->not_empty.wait_for(lock, std::chrono::milliseconds(timeout_ms), has_item)) {
+        return false;
+    }
+    memcpy(item, q->items.front().data(), q->item_size);
+    q->items.pop_front();
+    lock.unlock();
+    q->not_full.notify_one();
+    return true;
 }
 
 // Logging system
@@ -21,6 +21,8 @@
 #include "audio_wav.h"
 #include "audio_mp3.h"
 #include "touch_wheel.h"
+#include "hal/hal_audio.h"
+#include "audio/audio_deadline.h"
 
 // Touch sensitivity management
 extern bool touch_sensitivity_manager_init();
@@ -184,6 +186,7 @@ void displayTask(void *pvParameters) {
 
     int counter = 0;
     uint32_t lastFooter = 0;
+    uint32_t lastProgress = 0;
 
     while(1) {
         if (appConsumeRedrawRequest()) {
@@ -193,6 +196,12 @@ void displayTask(void *pvParameters) {
                 uiDrawNowPlayingFull();
             }
         }
+        // Progress follows the engine's playback clock
+        if (appGetCurrentView() == UIView::VIEW_NOW_PLAYING && hal_audio_is_playing() &&
+            millis() - lastProgress > 250) {
+            uiUpdateNowPlayingProgress();
+            lastProgress = millis();
+        }
         if (millis() - lastFooter > 500) {
             drawWheelCounter(); // Draw wheel counter overlay
             lastFooter = millis();
@@ -311,8 +320,9 @@ void menuTask(void *pvParameters) {
                     audioSetVolume(min(100, audioGetVolume() + 5));
                     char buf[32]; snprintf(buf, sizeof(buf), "Vol: %d%%", audioGetVolume()); uiToast(buf);
                 } else {
-                    int count = (appGetMenuLevel() == 0 ? 3 : 4);
+                    int count = uiMenuItemCount();
                     int sel = appGetMenuSelected(); sel = (sel - 1 + count) % count; appSetMenuSelected(sel);
+                    audioClick();
                 }
             }
             if (pressed & 0x02) { // DOWN
@@ -321,8 +331,9 @@ void menuTask(void *pvParameters) {
                     audioSetVolume(max(0, audioGetVolume() - 5));
                     char buf[32]; snprintf(buf, sizeof(buf), "Vol: %d%%", audioGetVolume()); uiToast(buf);
                 } else {
-                    int count = (appGetMenuLevel() == 0 ? 3 : 4);
+                    int count = uiMenuItemCount();
                     int sel = appGetMenuSelected(); sel = (sel + 1) % count; appSetMenuSelected(sel);
+                    audioClick();
                 }
             }
             if (pressed & 0x04) { // SELECT pressed: start hold tracking only
@@ -383,10 +394,11 @@ void menuTask(void *pvParameters) {
                 audioSetVolume(vol);
                 char buf[32]; snprintf(buf, sizeof(buf), "Vol: %d%%", vol); uiToast(buf);
             } else {
-                int count = (appGetMenuLevel() == 0 ? 3 : 4);
+                int count = uiMenuItemCount();
                 int sel = appGetMenuSelected();
                 sel = (sel + (uiMoves % count) + count) % count;
                 appSetMenuSelected(sel);
+                audioClick();
                 char buf[24]; snprintf(buf, sizeof(buf), "Menu sel: %d", sel);
                 uiToast(buf);
             }
@@ -395,12 +407,12 @@ void menuTask(void *pvParameters) {
         if (Serial.available()) {
             char c = (char)Serial.read();
             if (c == 'u' || c == 'U') {
-                int count = (appGetMenuLevel() == 0 ? 3 : 4);
+                int count = uiMenuItemCount();
                 int sel = appGetMenuSelected();
                 sel = (sel - 1 + count) % count;
                 appSetMenuSelected(sel);
             } else if (c == 'd' || c == 'D') {
-                int count = (appGetMenuLevel() == 0 ? 3 : 4);
+                int count = uiMenuItemCount();
                 int sel = appGetMenuSelected();
                 sel = (sel + 1) % count;
                 appSetMenuSelected(sel);
@@ -439,6 +451,7 @@ void menuTask(void *pvParameters) {
                 uiToast(audioIsPlaying() ? "Audio: Play" : "Audio: Pause");
             } else if (c == 'n' || c == 'N') {
                 appNextTrack();
+                audioSkipNext();
                 if (appGetCurrentView() == UIView::VIEW_NOW_PLAYING) appRequestRedraw();
                 uiToast("Next track");
             } else if (c == 'r' || c == 'R') {
@@ -464,11 +477,30 @@ void menuTask(void *pvParameters) {
                 if (g_sdMounted) {
                     wavStop(); audioSetPlaying(false);
                     Serial.println("MP3: attempting to start first file under /Music...");
-                    if (mp3StartFirstUnderMusic()) { mp3EnsureTask(); uiToast("Playing MP3 from /Music"); }
+                    if (mp3StartFirstUnderMusic()) { uiToast("Playing MP3 from /Music"); }
                     else { uiToast("No MP3 found"); }
                 }
+            } else if (c == 'f') {
+                if (g_sdMounted) {
+                    wavStop(); audioSetPlaying(false);
+                    if (audioStartFirstUnderMusic("flac")) { uiToast("Playing FLAC from /Music"); }
+                    else { uiToast("No FLAC found"); }
+                }
             } else if (c == 'q') {
                 mp3Stop(); uiToast("Stop MP3");
+            } else if (c == 'c') {
+                audioSetCrossfade(!audioGetCrossfade());
+                uiToast(audioGetCrossfade() ? "Crossfade on" : "Crossfade off");
+            } else if (c == 'g') {
+                char buf[32]; snprintf(buf, sizeof(buf), "ReplayGain: %s", audioCycleReplayGain()); uiToast(buf);
+            } else if (c == 'L') {
+                // Audio deadline report since the last 'L': press, do a UI action, press again
+                hal_audio_deadline_stats_t stats;
+                hal_audio_get_deadline_stats(&stats);
+                hal_audio_reset_deadline_stats();
+                static char report[640];
+                audio_deadline_format(&stats, report, sizeof(report));
+                Serial.print(report);
             } else if (c == 'S') {
                 // Re-list SD
                 if (g_sdMounted) { listSdFiles("/"); if (SD.exists("/Music")) listSdFiles("/Music"); }
@@ -509,7 +541,7 @@ void menuTask(void *pvParameters) {
                 Serial.printf("Manual step injection: counter now %d\n", g_wheelDebugCounter);
                 drawWheelCounter();
                 // Also test the menu logic
-                int count = (appGetMenuLevel() == 0 ? 3 : 4);
+                int count = uiMenuItemCount();
                 int sel = appGetMenuSelected();
                 sel = (sel + 1) % count;
                 appSetMenuSelected(sel);
@@ -517,6 +549,7 @@ void menuTask(void *pvParameters) {
                 uiToast(buf);
             }
         }
+        audioPoll();
         vTaskDelay(pdMS_TO_TICKS(20));
     }
 }
@@ -552,6 +585,7 @@ void setup() {
             Serial.println("SD: layout not detected. Press 'X' to quick-format and create folders, or 'F' to only create missing folders.");
         } else {
             initSdLayout(); // ensure any missing subfolders
+            if (g_audioReady) audioStartLoudnessScan();
         }
         Serial.println("SD: listing / and /Music if present");
         listSdFiles("/");
@@ -576,7 +610,7 @@ void setup() {
     appSetMenuLevel(0);
     appSetMenuSelected(0);
 
-    Serial.println("Controls: u/d/s select, b back, p play/pause, +/- volume");
+    Serial.println("Controls: u/d/s select, b back, p play/pause, +/- volume, L audio deadlines");
     Serial.printf("Firmware: %s %s\n", izod_firmware_name(), izod_firmware_version());
 }
 
@@ -5,6 +5,7 @@
 
 #include "plugin_api.h"
 #include "hardware_config.h"
+#include "audio.h"
 #include <Arduino.h>
 #include <SD.h>
 #include <ArduinoJson.h>
@@ -92,9 +93,9 @@ static void hal_display_update(void) {
 }
 
 // Audio HAL implementations
+// Synth beep over the music, so a plugin never interrupts playback
 static bool hal_audio_play_tone(uint16_t frequency, uint32_t duration_ms) {
-    Serial.printf("Audio: Play tone %dHz for %dms\n", frequency, duration_ms);
-    return true;
+    return audioBeep(frequency, duration_ms);
 }
 
 static bool hal_audio_play_wav(const char* filename) {
@@ -131,6 +132,10 @@ static bool hal_audio_is_playing(void) {
     return false; // Not playing by default
 }
 
+static bool hal_audio_get_deadline_stats(plugin_audio_deadline_t* stats, bool reset) {
+    return audioGetDeadlineStats(stats, reset);
+}
+
 // Storage HAL implementations
 static bool hal_storage_exists(const char* path) {
     return SD.exists(path);
@@ -280,6 +285,7 @@ static void init_hal_interfaces() {
     g_audio_hal.set_volume = hal_audio_set_volume;
     g_audio_hal.get_volume = hal_audio_get_volume;
     g_audio_hal.is_playing = hal_audio_is_playing;
+    g_audio_hal.get_deadline_stats = hal_audio_get_deadline_stats;
     
     // Initialize storage HAL
     g_storage_hal.exists = hal_storage_exists;
@@ -0,0 +1,212 @@
+/*
+ * UI Font: mono_16
+ * Generated by tools/font_atlas.py from DejaVuSansMono.ttf; do not edit
+ *
+ * Copyright (c) 2003 by Bitstream, Inc. All Rights Reserved.
+ * DejaVu changes are in public domain
+ * Glyph data derived from the font; its license is in LICENSE-DejaVu.txt
+ *
+ * 16 px, 4-bit alpha, 12x16 cells, baseline at row 12
+ * tools/font_atlas.py DejaVuSansMono.ttf --name mono_16 --size 16 --cell 12x16 --baseline 12 --bpp 4 --license src/ui/fonts/LICENSE-DejaVu.txt -o src/ui/fonts/ui_font_mono_16.cpp
+ */
+
+#include "ui/ui_font.h"
+
+static const uint8_t kBitmap[] = {
+    0x88, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xBB, 0xAA, 0x22, 0x00, 0xCC, 0xCC,
+    0x2A, 0x22, 0xA2, 0x3F, 0x33, 0xF3, 0x3F, 0x33, 0xF3, 0x3F, 0x33, 0xF3, 0x2A, 0x22, 0xA2,
+    0x00, 0x00, 0x64, 0x05, 0x50, 0x00, 0x00, 0xE4, 0x0C, 0x70, 0x00, 0x03, 0xF1, 0x1F, 0x30, 0x03, 0x49, 0xD4, 0x7F, 0x43, 0x0D, 0xEF, 0xEE, 0xFF, 0xEB, 0x00, 0x0E, 0x40, 0xC7, 0x00, 0x00, 0x3F, 0x11, 0xF3, 0x00, 0x57, 0xAE, 0x79, 0xF7, 0x60, 0x9B, 0xED, 0xBE, 0xEB, 0xA0, 0x00, 0xE4, 0x0C, 0x70, 0x00, 0x03, 0xF1, 0x1F, 0x30, 0x00, 0x07, 0xC0, 0x5E, 0x00, 0x00,
+    0x00, 0x03, 0x90, 0x00, 0x00, 0x16, 0xB3, 0x10, 0x07, 0xFD, 0xEE, 0xF2, 0x2F, 0x63, 0x90, 0x31, 0x5F, 0x23, 0x90, 0x00, 0x2F, 0x94, 0x90, 0x00, 0x06, 0xEF, 0xEA, 0x40, 0x00, 0x06, 0xCB, 0xF5, 0x00, 0x03, 0x90, 0xBC, 0x00, 0x03, 0x90, 0xAD, 0x5A, 0x55, 0xA5, 0xE7, 0x29, 0xDF, 0xFD, 0x70, 0x00, 0x03, 0x90, 0x00, 0x00, 0x03, 0x90, 0x00, 0x00, 0x01, 0x30, 0x00,
+    0x00, 0x22, 0x00, 0x00, 0x00, 0x0B, 0xEE, 0x90, 0x00, 0x00, 0x6B, 0x01, 0xD4, 0x00, 0x00, 0x88, 0x00, 0xA6, 0x00, 0x00, 0x4E, 0x56, 0xE2, 0x01, 0x71, 0x05, 0xBB, 0x44, 0xAC, 0x61, 0x00, 0x17, 0xC9, 0x30, 0x00, 0x0A, 0xC6, 0x16, 0xEE, 0x70, 0x03, 0x00, 0x3E, 0x33, 0xD5, 0x00, 0x00, 0x6A, 0x00, 0x88, 0x00, 0x00, 0x3E, 0x32, 0xD5, 0x00, 0x00, 0x07, 0xEE, 0x80,
+    0x00, 0x19, 0xDD, 0xA0, 0x00, 0x00, 0xBD, 0x65, 0xA0, 0x00, 0x00, 0xE7, 0x00, 0x00, 0x00, 0x00, 0xD9, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x30, 0x00, 0x00, 0x02, 0xDE, 0xD1, 0x00, 0x00, 0x0C, 0xA1, 0xEA, 0x00, 0xA8, 0x3F, 0x20, 0x4F, 0x60, 0xB7, 0x5F, 0x00, 0x08, 0xE3, 0xD4, 0x4F, 0x40, 0x00, 0xBE, 0xD0, 0x0C, 0xD4, 0x01, 0x9F, 0xA0, 0x01, 0xBF, 0xFF, 0xB7, 0xF5, 0x00, 0x02, 0x32, 0x00, 0x00,
+    0x77, 0xAA, 0xAA, 0xAA, 0x77,
+    0x00, 0x8B, 0x02, 0xF4, 0x08, 0xD0, 0x0E, 0x80, 0x3F, 0x40, 0x6F, 0x20, 0x7F, 0x10, 0x7F, 0x10, 0x6F, 0x20, 0x3F, 0x40, 0x0D, 0x80, 0x08, 0xD0, 0x02, 0xE4, 0x00, 0x8B, 0x00, 0x02,
+    0xB8, 0x00, 0x4F, 0x20, 0x0D, 0x80, 0x08, 0xE0, 0x04, 0xF3, 0x02, 0xF6, 0x01, 0xF7, 0x01, 0xF7, 0x02, 0xF6, 0x04, 0xF3, 0x08, 0xD0, 0x0D, 0x80, 0x4E, 0x20, 0xB8, 0x00, 0x20, 0x00,
+    0x00, 0x06, 0x60, 0x00, 0x23, 0x07, 0x70, 0x32, 0x3C, 0x88, 0x88, 0xC3, 0x00, 0x5E, 0xE5, 0x00, 0x04, 0xCC, 0xCC, 0x40, 0x4B, 0x27, 0x72, 0xB4, 0x00, 0x07, 0x70, 0x00, 0x00, 0x03, 0x30, 0x00,
+    0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x1A, 0xAA, 0xDD, 0xAA, 0xA1, 0x19, 0x99, 0xDD, 0x99, 0x91, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00,
+    0x05, 0x60, 0x0D, 0xF1, 0x0E, 0xE0, 0x3F, 0x60, 0x7D, 0x00, 0x22, 0x00,
+    0x1F, 0xFF, 0xF1, 0x04, 0x44, 0x40,
+    0x65, 0xFF, 0xFF,
+    0x00, 0x00, 0x01, 0xA5, 0x00, 0x00, 0x06, 0xF1, 0x00, 0x00, 0x0D, 0x90, 0x00, 0x00, 0x5F, 0x20, 0x00, 0x00, 0xCA, 0x00, 0x00, 0x04, 0xF3, 0x00, 0x00, 0x0B, 0xB0, 0x00, 0x00, 0x3F, 0x40, 0x00, 0x00, 0xAC, 0x00, 0x00, 0x02, 0xF5, 0x00, 0x00, 0x09, 0xD0, 0x00, 0x00, 0x2F, 0x60, 0x00, 0x00, 0x8E, 0x00, 0x00, 0x00, 0x74, 0x00, 0x00, 0x00,
+    0x01, 0x8D, 0xD8, 0x10, 0x0A, 0xE7, 0x7E, 0xA0, 0x3F, 0x60, 0x06, 0xF3, 0x8F, 0x10, 0x01, 0xF8, 0xAD, 0x00, 0x00, 0xDA, 0xBC, 0x0B, 0xB0, 0xCB, 0xCC, 0x0E, 0xE0, 0xCC, 0xBD, 0x01, 0x10, 0xDB, 0x9F, 0x00, 0x00, 0xF9, 0x5F, 0x40, 0x04, 0xF5, 0x1D, 0xC2, 0x2C, 0xD0, 0x03, 0xDF, 0xFD, 0x30, 0x00, 0x03, 0x30, 0x00,
+    0x26, 0x9A, 0x30, 0x00, 0xDF, 0xDF, 0x50, 0x00, 0x31, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x35, 0x7F, 0x85, 0x30, 0xBF, 0xFF, 0xFF, 0xB0,
+    0x28, 0xCD, 0xC7, 0x00, 0x8E, 0x97, 0x9F, 0xB0, 0x31, 0x00, 0x07, 0xF4, 0x00, 0x00, 0x04, 0xF5, 0x00, 0x00, 0x06, 0xF3, 0x00, 0x00, 0x1D, 0xB0, 0x00, 0x00, 0xBD, 0x10, 0x00, 0x0A, 0xE2, 0x00, 0x00, 0x9E, 0x30, 0x00, 0x08, 0xE4, 0x00, 0x00, 0x6F, 0x95, 0x55, 0x52, 0x9F, 0xFF, 0xFF, 0xF7,
+    0x39, 0xCD, 0xC8, 0x10, 0x6C, 0x87, 0x9F, 0xB0, 0x00, 0x00, 0x06, 0xF4, 0x00, 0x00, 0x04, 0xF5, 0x00, 0x00, 0x1A, 0xE1, 0x00, 0xAD, 0xFC, 0x30, 0x00, 0x57, 0x9E, 0x90, 0x00, 0x00, 0x04, 0xF5, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x02, 0xF8, 0x86, 0x32, 0x4C, 0xF3, 0x9F, 0xFF, 0xFD, 0x50, 0x00, 0x23, 0x20, 0x00,
+    0x00, 0x00, 0x6A, 0x50, 0x00, 0x00, 0x02, 0xEF, 0x70, 0x00, 0x00, 0x0B, 0x8F, 0x70, 0x00, 0x00, 0x5D, 0x2F, 0x70, 0x00, 0x01, 0xE4, 0x1F, 0x70, 0x00, 0x09, 0xB0, 0x1F, 0x70, 0x00, 0x4E, 0x20, 0x1F, 0x70, 0x00, 0xD8, 0x11, 0x2F, 0x81, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0x33, 0x33, 0x4F, 0x93, 0x00, 0x00, 0x00, 0x1F, 0x70, 0x00, 0x00, 0x00, 0x1F, 0x70, 0x00,
+    0x2A, 0xAA, 0xAA, 0x70, 0x3F, 0xBA, 0xAA, 0x70, 0x3F, 0x40, 0x00, 0x00, 0x3F, 0x40, 0x00, 0x00, 0x3F, 0xAA, 0x95, 0x00, 0x3D, 0xAA, 0xDF, 0x90, 0x00, 0x00, 0x0A, 0xF3, 0x00, 0x00, 0x02, 0xF7, 0x00, 0x00, 0x01, 0xF8, 0x00, 0x00, 0x05, 0xF6, 0x76, 0x22, 0x5E, 0xD1, 0x9F, 0xFF, 0xFC, 0x20, 0x01, 0x33, 0x20, 0x00,
+    0x00, 0x5B, 0xDC, 0x80, 0x07, 0xFB, 0x78, 0xB0, 0x2F, 0x80, 0x00, 0x00, 0x7E, 0x10, 0x00, 0x00, 0xAC, 0x29, 0xA8, 0x10, 0xBC, 0xE9, 0x8E, 0xD1, 0xCF, 0x60, 0x02, 0xF8, 0xBF, 0x00, 0x00, 0xDB, 0x9E, 0x00, 0x00, 0xCB, 0x6F, 0x20, 0x00, 0xEA, 0x1E, 0xB2, 0x18, 0xF4, 0x03, 0xDF, 0xFE, 0x70, 0x00, 0x02, 0x31, 0x00,
+    0x8A, 0xAA, 0xAA, 0xA6, 0x8A, 0xAA, 0xAB, 0xF6, 0x00, 0x00, 0x07, 0xF1, 0x00, 0x00, 0x0D, 0xA0, 0x00, 0x00, 0x4F, 0x40, 0x00, 0x00, 0xAD, 0x00, 0x00, 0x01, 0xF8, 0x00, 0x00, 0x07, 0xF2, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x3F, 0x60, 0x00, 0x00, 0x9E, 0x10, 0x00, 0x01, 0xE9, 0x00, 0x00,
+    0x02, 0xAD, 0xDA, 0x20, 0x2E, 0xD6, 0x6D, 0xE2, 0x7F, 0x30, 0x03, 0xF7, 0x7F, 0x10, 0x01, 0xF7, 0x3F, 0x60, 0x06, 0xF3, 0x04, 0xDD, 0xDD, 0x40, 0x1B, 0xD8, 0x8D, 0xB1, 0x8F, 0x20, 0x02, 0xF8, 0xBC, 0x00, 0x00, 0xCC, 0xBD, 0x00, 0x00, 0xDB, 0x6F, 0x81, 0x18, 0xF6, 0x08, 0xFF, 0xFF, 0x80, 0x00, 0x13, 0x31, 0x00,
+    0x03, 0xAD, 0xC8, 0x10, 0x2E, 0xC6, 0x7E, 0xA0, 0x9E, 0x10, 0x05, 0xF3, 0xCC, 0x00, 0x01, 0xF7, 0xCB, 0x00, 0x00, 0xFA, 0xAE, 0x00, 0x04, 0xFB, 0x4F, 0xA3, 0x4D, 0xEB, 0x05, 0xDF, 0xE6, 0xCA, 0x00, 0x01, 0x00, 0xE8, 0x00, 0x00, 0x05, 0xF3, 0x07, 0x32, 0x6E, 0xA0, 0x0D, 0xFF, 0xFA, 0x10, 0x00, 0x23, 0x10, 0x00,
+    0x55, 0xFF, 0xFF, 0x11, 0x00, 0x00, 0x65, 0xFF, 0xFF,
+    0x05, 0x50, 0x0F, 0xF0, 0x0F, 0xF0, 0x01, 0x10, 0x00, 0x00, 0x00, 0x00, 0x05, 0x60, 0x0D, 0xF1, 0x0E, 0xE0, 0x3F, 0x60, 0x7D, 0x00, 0x22, 0x00,
+    0x00, 0x00, 0x00, 0x04, 0xA2, 0x00, 0x00, 0x27, 0xDF, 0xB1, 0x00, 0x5B, 0xFD, 0x72, 0x00, 0x1D, 0xE9, 0x40, 0x00, 0x00, 0x1D, 0xE9, 0x40, 0x00, 0x00, 0x00, 0x4A, 0xFD, 0x82, 0x00, 0x00, 0x00, 0x17, 0xDF, 0xB1, 0x00, 0x00, 0x00, 0x04, 0xA2,
+    0x04, 0x44, 0x44, 0x44, 0x40, 0x2F, 0xFF, 0xFF, 0xFF, 0xF2, 0x01, 0x11, 0x11, 0x11, 0x10, 0x02, 0x22, 0x22, 0x22, 0x20, 0x2F, 0xFF, 0xFF, 0xFF, 0xF2, 0x04, 0x44, 0x44, 0x44, 0x40,
+    0x2A, 0x40, 0x00, 0x00, 0x00, 0x1B, 0xFD, 0x72, 0x00, 0x00, 0x00, 0x27, 0xDF, 0xB5, 0x00, 0x00, 0x00, 0x04, 0x9E, 0xD1, 0x00, 0x00, 0x04, 0x9E, 0xD1, 0x00, 0x28, 0xDF, 0xA4, 0x00, 0x1B, 0xFD, 0x71, 0x00, 0x00, 0x2A, 0x40, 0x00, 0x00, 0x00,
+    0x39, 0xDD, 0xA2, 0x00, 0xEB, 0x78, 0xED, 0x10, 0x30, 0x00, 0x6F, 0x40, 0x00, 0x00, 0x6F, 0x30, 0x00, 0x03, 0xEA, 0x00, 0x00, 0x3E, 0xB1, 0x00, 0x00, 0xBC, 0x00, 0x00, 0x00, 0xE8, 0x00, 0x00, 0x00, 0xD7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00,
+    0x00, 0x06, 0xBD, 0xC8, 0x00, 0x00, 0xBD, 0x63, 0x5C, 0xA0, 0x08, 0xC1, 0x00, 0x02, 0xF3, 0x1F, 0x30, 0x17, 0x94, 0xC5, 0x5D, 0x01, 0xDC, 0x8D, 0xE6, 0x8A, 0x06, 0xD0, 0x01, 0xE6, 0x99, 0x09, 0xA0, 0x00, 0xB6, 0x99, 0x08, 0xB0, 0x00, 0xC6, 0x7B, 0x03, 0xF5, 0x16, 0xF6, 0x3F, 0x10, 0x6E, 0xFC, 0xB5, 0x0C, 0x90, 0x00, 0x10, 0x00, 0x02, 0xE8, 0x10, 0x00, 0x00, 0x00, 0x3C, 0xEA, 0xAC, 0x20, 0x00, 0x00, 0x36, 0x75, 0x10,
+    0x00, 0x01, 0xAA, 0x10, 0x00, 0x00, 0x05, 0xFF, 0x50, 0x00, 0x00, 0x09, 0xCC, 0x90, 0x00, 0x00, 0x0E, 0x88, 0xE0, 0x00, 0x00, 0x3F, 0x33, 0xF3, 0x00, 0x00, 0x8E, 0x00, 0xE8, 0x00, 0x00, 0xDA, 0x00, 0xAD, 0x00, 0x02, 0xF9, 0x55, 0x9F, 0x20, 0x07, 0xFE, 0xEE, 0xEF, 0x70, 0x0B, 0xC0, 0x00, 0x0C, 0xB0, 0x1F, 0x80, 0x00, 0x08, 0xF1, 0x6F, 0x40, 0x00, 0x04, 0xF6,
+    0x5A, 0xAA, 0x97, 0x10, 0x00, 0x8F, 0xA9, 0xAE, 0xE2, 0x00, 0x8F, 0x10, 0x02, 0xF8, 0x00, 0x8F, 0x10, 0x00, 0xEA, 0x00, 0x8F, 0x10, 0x05, 0xF6, 0x00, 0x8F, 0xDD, 0xEF, 0x80, 0x00, 0x8F, 0x77, 0x7B, 0xE3, 0x00, 0x8F, 0x10, 0x00, 0xCC, 0x00, 0x8F, 0x10, 0x00, 0x8F, 0x10, 0x8F, 0x10, 0x00, 0xAF, 0x00, 0x8F, 0x55, 0x59, 0xF9, 0x00, 0x8F, 0xFF, 0xFD, 0x70, 0x00,
+    0x00, 0x3A, 0xDD, 0xA3, 0x04, 0xFC, 0x77, 0xB8, 0x1E, 0xB0, 0x00, 0x01, 0x6F, 0x40, 0x00, 0x00, 0x9F, 0x10, 0x00, 0x00, 0xBE, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x00, 0x00, 0xAF, 0x00, 0x00, 0x00, 0x7F, 0x30, 0x00, 0x00, 0x2F, 0x80, 0x00, 0x00, 0x09, 0xF7, 0x22, 0x67, 0x00, 0x8E, 0xFF, 0xF6, 0x00, 0x01, 0x33, 0x10,
+    0x8A, 0xA9, 0x71, 0x00, 0xBE, 0x9B, 0xEE, 0x50, 0xBD, 0x00, 0x1B, 0xE2, 0xBD, 0x00, 0x03, 0xF7, 0xBD, 0x00, 0x00, 0xEA, 0xBD, 0x00, 0x00, 0xDC, 0xBD, 0x00, 0x00, 0xDC, 0xBD, 0x00, 0x00, 0xEB, 0xBD, 0x00, 0x01, 0xF9, 0xBD, 0x00, 0x08, 0xF3, 0xBD, 0x55, 0xAF, 0x90, 0xBF, 0xFE, 0xC6, 0x00,
+    0x3A, 0xAA, 0xAA, 0xA7, 0x4F, 0xCA, 0xAA, 0xA7, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0xED, 0xDD, 0xD5, 0x4F, 0x97, 0x77, 0x73, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x4F, 0x85, 0x55, 0x54, 0x4F, 0xFF, 0xFF, 0xFC,
+    0xAA, 0xAA, 0xAA, 0x90, 0xFD, 0xAA, 0xAA, 0x90, 0xF9, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xFE, 0xDD, 0xDD, 0x50, 0xFC, 0x77, 0x77, 0x20, 0xF9, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00,
+    0x00, 0x5B, 0xDC, 0x81, 0x08, 0xFA, 0x78, 0xD6, 0x4F, 0x70, 0x00, 0x12, 0xAE, 0x10, 0x00, 0x00, 0xDB, 0x00, 0x00, 0x00, 0xFA, 0x00, 0x00, 0x00, 0xFA, 0x00, 0x6F, 0xFC, 0xEB, 0x00, 0x25, 0xCC, 0xBD, 0x00, 0x00, 0xAC, 0x6F, 0x40, 0x00, 0xAC, 0x1C, 0xD4, 0x13, 0xDC, 0x01, 0xBF, 0xFF, 0xD4, 0x00, 0x01, 0x32, 0x00,
+    0x89, 0x00, 0x00, 0x98, 0xBD, 0x00, 0x00, 0xDB, 0xBD, 0x00, 0x00, 0xDB, 0xBD, 0x00, 0x00, 0xDB, 0xBD, 0x00, 0x00, 0xDB, 0xBF, 0xDD, 0xDD, 0xFB, 0xBE, 0x77, 0x77, 0xEB, 0xBD, 0x00, 0x00, 0xDB, 0xBD, 0x00, 0x00, 0xDB, 0xBD, 0x00, 0x00, 0xDB, 0xBD, 0x00, 0x00, 0xDB, 0xBD, 0x00, 0x00, 0xDB,
+    0x3A, 0xAA, 0xAA, 0xA2, 0x3A, 0xAE, 0xEA, 0xA2, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x15, 0x5D, 0xD5, 0x51, 0x4F, 0xFF, 0xFF, 0xF3,
+    0x00, 0x9A, 0xAA, 0x70, 0x00, 0x9A, 0xAF, 0xA0, 0x00, 0x00, 0x0E, 0xA0, 0x00, 0x00, 0x0E, 0xA0, 0x00, 0x00, 0x0E, 0xA0, 0x00, 0x00, 0x0E, 0xA0, 0x00, 0x00, 0x0E, 0xA0, 0x00, 0x00, 0x0E, 0xA0, 0x00, 0x00, 0x0E, 0xA0, 0x10, 0x00, 0x1F, 0x80, 0xD6, 0x21, 0x8F, 0x40, 0xAF, 0xFF, 0xF9, 0x00, 0x01, 0x33, 0x10, 0x00,
+    0x89, 0x00, 0x00, 0x6A, 0x30, 0xBD, 0x00, 0x05, 0xF8, 0x00, 0xBD, 0x00, 0x5F, 0x80, 0x00, 0xBD, 0x04, 0xF9, 0x00, 0x00, 0xBD, 0x3E, 0xA0, 0x00, 0x00, 0xBE, 0xEF, 0x50, 0x00, 0x00, 0xBF, 0xBB, 0xE1, 0x00, 0x00, 0xBD, 0x02, 0xEB, 0x00, 0x00, 0xBD, 0x00, 0x6F, 0x60, 0x00, 0xBD, 0x00, 0x0C, 0xE2, 0x00, 0xBD, 0x00, 0x02, 0xFB, 0x00, 0xBD, 0x00, 0x00, 0x7F, 0x60,
+    0x1A, 0x50, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x70, 0x00, 0x00, 0x00, 0x2F, 0x95, 0x55, 0x55, 0x00, 0x2F, 0xFF, 0xFF, 0xFF, 0x10,
+    0x1A, 0xA1, 0x00, 0x1A, 0xA1, 0x2F, 0xF5, 0x00, 0x6F, 0xF2, 0x2F, 0xBA, 0x00, 0xBB, 0xF2, 0x2F, 0x6E, 0x11, 0xF6, 0xF2, 0x2F, 0x5B, 0x66, 0xB5, 0xF2, 0x2F, 0x56, 0xBB, 0x65, 0xF2, 0x2F, 0x51, 0xEF, 0x15, 0xF2, 0x2F, 0x50, 0x99, 0x05, 0xF2, 0x2F, 0x50, 0x00, 0x05, 0xF2, 0x2F, 0x50, 0x00, 0x05, 0xF2, 0x2F, 0x50, 0x00, 0x05, 0xF2, 0x2F, 0x50, 0x00, 0x05, 0xF2,
+    0x8A, 0x40, 0x00, 0x88, 0xBF, 0xB0, 0x00, 0xCB, 0xBE, 0xF2, 0x00, 0xCB, 0xBC, 0xB9, 0x00, 0xCB, 0xBC, 0x5E, 0x10, 0xCB, 0xBC, 0x0E, 0x60, 0xCB, 0xBC, 0x08, 0xC0, 0xCB, 0xBC, 0x02, 0xF3, 0xCB, 0xBC, 0x00, 0xB9, 0xCB, 0xBC, 0x00, 0x4E, 0xDB, 0xBC, 0x00, 0x0D, 0xFB, 0xBC, 0x00, 0x07, 0xFB,
+    0x01, 0x9D, 0xD9, 0x10, 0x0C, 0xE7, 0x7E, 0xC0, 0x5F, 0x50, 0x05, 0xF5, 0xAE, 0x00, 0x00, 0xEA, 0xCC, 0x00, 0x00, 0xCC, 0xDB, 0x00, 0x00, 0xBD, 0xDB, 0x00, 0x00, 0xBD, 0xDC, 0x00, 0x00, 0xCD, 0xBE, 0x00, 0x00, 0xEB, 0x7F, 0x20, 0x02, 0xF7, 0x2E, 0xB2, 0x2B, 0xE2, 0x04, 0xEF, 0xFE, 0x40, 0x00, 0x03, 0x30, 0x00,
+    0x3A, 0xAA, 0xA8, 0x30, 0x00, 0x4F, 0xB9, 0xAE, 0xF5, 0x00, 0x4F, 0x50, 0x01, 0xDD, 0x00, 0x4F, 0x50, 0x00, 0x9F, 0x10, 0x4F, 0x50, 0x00, 0xAF, 0x10, 0x4F, 0x50, 0x05, 0xFB, 0x00, 0x4F, 0xFF, 0xFF, 0xC2, 0x00, 0x4F, 0x85, 0x43, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x00, 0x4F, 0x50, 0x00, 0x00, 0x00,
+    0x01, 0x9D, 0xD9, 0x10, 0x0C, 0xE7, 0x7E, 0xC0, 0x5F, 0x50, 0x05, 0xF5, 0xAE, 0x00, 0x00, 0xEA, 0xCC, 0x00, 0x00, 0xCC, 0xDB, 0x00, 0x00, 0xBD, 0xDB, 0x00, 0x00, 0xBD, 0xDC, 0x00, 0x00, 0xCD, 0xBE, 0x00, 0x00, 0xEB, 0x7F, 0x20, 0x02, 0xF7, 0x2E, 0xB2, 0x2B, 0xE2, 0x04, 0xEF, 0xFE, 0x40, 0x00, 0x03, 0x7F, 0x70, 0x00, 0x00, 0x07, 0xD1,
+    0x7A, 0xAA, 0x95, 0x00, 0x00, 0xAE, 0x99, 0xCF, 0xB0, 0x00, 0xAD, 0x00, 0x08, 0xF5, 0x00, 0xAD, 0x00, 0x03, 0xF8, 0x00, 0xAD, 0x00, 0x04, 0xF6, 0x00, 0xAE, 0x44, 0x5D, 0xD1, 0x00, 0xAF, 0xFF, 0xFB, 0x10, 0x00, 0xAD, 0x11, 0x6F, 0x70, 0x00, 0xAD, 0x00, 0x08, 0xE2, 0x00, 0xAD, 0x00, 0x01, 0xF9, 0x00, 0xAD, 0x00, 0x00, 0x9F, 0x20, 0xAD, 0x00, 0x00, 0x2F, 0x90,
+    0x02, 0x9D, 0xDB, 0x70, 0x2E, 0xD7, 0x79, 0xE1, 0x9E, 0x10, 0x00, 0x10, 0xBC, 0x00, 0x00, 0x00, 0x9F, 0x50, 0x00, 0x00, 0x2D, 0xFD, 0xA5, 0x00, 0x01, 0x6B, 0xEF, 0xC1, 0x00, 0x00, 0x06, 0xF8, 0x00, 0x00, 0x00, 0xCB, 0x00, 0x00, 0x00, 0xDA, 0x89, 0x31, 0x28, 0xF6, 0x6D, 0xFF, 0xFE, 0x70, 0x00, 0x23, 0x30, 0x00,
+    0x5A, 0xAA, 0xAA, 0xAA, 0xA5, 0x5A, 0xAA, 0xEE, 0xAA, 0xA5, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00,
+    0x79, 0x00, 0x00, 0x97, 0xAE, 0x00, 0x00, 0xEA, 0xAE, 0x00, 0x00, 0xEA, 0xAE, 0x00, 0x00, 0xEA, 0xAE, 0x00, 0x00, 0xEA, 0xAE, 0x00, 0x00, 0xEA, 0xAE, 0x00, 0x00, 0xEA, 0xAE, 0x00, 0x00, 0xEA, 0xAE, 0x00, 0x00, 0xEA, 0x8F, 0x00, 0x00, 0xF8, 0x4F, 0x92, 0x29, 0xF4, 0x06, 0xEF, 0xFE, 0x60, 0x00, 0x13, 0x31, 0x00,
+    0x3A, 0x40, 0x00, 0x04, 0xA3, 0x1F, 0x90, 0x00, 0x09, 0xF1, 0x0B, 0xD0, 0x00, 0x0D, 0xB0, 0x07, 0xF2, 0x00, 0x2F, 0x70, 0x02, 0xF5, 0x00, 0x5F, 0x20, 0x00, 0xD9, 0x00, 0x9D, 0x00, 0x00, 0x9D, 0x00, 0xD9, 0x00, 0x00, 0x4F, 0x22, 0xF4, 0x00, 0x00, 0x0E, 0x66, 0xE0, 0x00, 0x00, 0x0A, 0xAA, 0xA0, 0x00, 0x00, 0x06, 0xEE, 0x60, 0x00, 0x00, 0x02, 0xFF, 0x20, 0x00,
+    0x88, 0x00, 0x00, 0x00, 0x88, 0xAD, 0x00, 0x00, 0x00, 0xDA, 0x7F, 0x00, 0x00, 0x00, 0xF7, 0x5F, 0x10, 0x66, 0x01, 0xF5, 0x3F, 0x31, 0xFF, 0x13, 0xF3, 0x1F, 0x54, 0xDE, 0x45, 0xF1, 0x0D, 0x77, 0xAA, 0x77, 0xD0, 0x0B, 0x9A, 0x77, 0xA8, 0xB0, 0x09, 0xAD, 0x33, 0xDA, 0x90, 0x07, 0xDE, 0x00, 0xED, 0x70, 0x04, 0xFB, 0x00, 0xBF, 0x40, 0x02, 0xF8, 0x00, 0x8F, 0x20,
+    0x09, 0x80, 0x00, 0x05, 0xA2, 0x06, 0xF3, 0x00, 0x1E, 0xA0, 0x00, 0xCC, 0x00, 0x8E, 0x20, 0x00, 0x3F, 0x63, 0xF6, 0x00, 0x00, 0x09, 0xEC, 0xB0, 0x00, 0x00, 0x01, 0xEF, 0x20, 0x00, 0x00, 0x03, 0xFF, 0x50, 0x00, 0x00, 0x0C, 0xC9, 0xD1, 0x00, 0x00, 0x7F, 0x31, 0xE8, 0x00, 0x02, 0xE8, 0x00, 0x7F, 0x30, 0x0B, 0xD1, 0x00, 0x0D, 0xB0, 0x5F, 0x50, 0x00, 0x05, 0xF5,
+    0x4A, 0x30, 0x00, 0x04, 0xA4, 0x0D, 0xC0, 0x00, 0x0C, 0xC0, 0x04, 0xF5, 0x00, 0x5F, 0x40, 0x00, 0xAD, 0x00, 0xDA, 0x00, 0x00, 0x2F, 0x77, 0xF2, 0x00, 0x00, 0x08, 0xEE, 0x80, 0x00, 0x00, 0x01, 0xEE, 0x10, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00,
+    0x4A, 0xAA, 0xAA, 0xAA, 0x10, 0x4A, 0xAA, 0xAA, 0xEF, 0x10, 0x00, 0x00, 0x03, 0xF8, 0x00, 0x00, 0x00, 0x0D, 0xC0, 0x00, 0x00, 0x00, 0x8F, 0x30, 0x00, 0x00, 0x03, 0xF8, 0x00, 0x00, 0x00, 0x0C, 0xC0, 0x00, 0x00, 0x00, 0x7F, 0x30, 0x00, 0x00, 0x02, 0xE7, 0x00, 0x00, 0x00, 0x0B, 0xC0, 0x00, 0x00, 0x00, 0x6F, 0x75, 0x55, 0x55, 0x10, 0x9F, 0xFF, 0xFF, 0xFF, 0x50,
+    0x3F, 0xEE, 0x20, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0x40, 0x00, 0x3F, 0xFF, 0x20, 0x02, 0x22, 0x00,
+    0x96, 0x00, 0x00, 0x00, 0x7E, 0x10, 0x00, 0x00, 0x1E, 0x70, 0x00, 0x00, 0x08, 0xE1, 0x00, 0x00, 0x02, 0xF6, 0x00, 0x00, 0x00, 0x9D, 0x00, 0x00, 0x00, 0x2F, 0x50, 0x00, 0x00, 0x0A, 0xC0, 0x00, 0x00, 0x03, 0xF4, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x0C, 0xA0, 0x00, 0x00, 0x05, 0xF2, 0x00, 0x00, 0x00, 0x74,
+    0x2E, 0xEF, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x00, 0x4F, 0x30, 0x2F, 0xFF, 0x30, 0x02, 0x22, 0x00,
+    0x00, 0x01, 0x99, 0x10, 0x00, 0x00, 0x0A, 0xEE, 0xA0, 0x00, 0x00, 0x7E, 0x33, 0xE7, 0x00, 0x04, 0xE4, 0x00, 0x4E, 0x40, 0x19, 0x50, 0x00, 0x05, 0x91,
+    0x89, 0x99, 0x99, 0x99, 0x98,
+    0x8D, 0x10, 0x0A, 0x90, 0x00, 0x20,
+    0x19, 0xCE, 0xEA, 0x20, 0x2C, 0x64, 0x5B, 0xE1, 0x00, 0x00, 0x02, 0xF5, 0x01, 0x57, 0x88, 0xF7, 0x2D, 0xEA, 0x99, 0xF7, 0x9D, 0x10, 0x00, 0xF7, 0xBA, 0x00, 0x04, 0xF7, 0x9E, 0x30, 0x3D, 0xF7, 0x1C, 0xFF, 0xE5, 0xF7, 0x00, 0x23, 0x10, 0x00,
+    0x5F, 0x20, 0x00, 0x00, 0x5F, 0x20, 0x00, 0x00, 0x5F, 0x20, 0x00, 0x00, 0x5F, 0x5C, 0xEC, 0x40, 0x5F, 0xE6, 0x4B, 0xE2, 0x5F, 0x70, 0x01, 0xE9, 0x5F, 0x30, 0x00, 0xBC, 0x5F, 0x20, 0x00, 0xAD, 0x5F, 0x30, 0x00, 0xAC, 0x5F, 0x60, 0x00, 0xDA, 0x5F, 0xD2, 0x08, 0xF4, 0x5F, 0x8F, 0xFF, 0x70, 0x00, 0x01, 0x31, 0x00,
+    0x00, 0x4B, 0xEE, 0xB3, 0x05, 0xFA, 0x54, 0x97, 0x0D, 0xB0, 0x00, 0x00, 0x3F, 0x50, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x3F, 0x40, 0x00, 0x00, 0x1E, 0x90, 0x00, 0x00, 0x08, 0xF6, 0x10, 0x45, 0x00, 0x8E, 0xFF, 0xE5, 0x00, 0x01, 0x33, 0x00,
+    0x00, 0x00, 0x02, 0xF5, 0x00, 0x00, 0x02, 0xF5, 0x00, 0x00, 0x02, 0xF5, 0x04, 0xCE, 0xC5, 0xF5, 0x2E, 0xB4, 0x6E, 0xF5, 0x8E, 0x10, 0x07, 0xF5, 0xCB, 0x00, 0x03, 0xF5, 0xDA, 0x00, 0x02, 0xF5, 0xCB, 0x00, 0x02, 0xF5, 0x9E, 0x00, 0x06, 0xF5, 0x4F, 0x80, 0x2D, 0xF5, 0x07, 0xFF, 0xF8, 0xF5, 0x00, 0x13, 0x10, 0x00,
+    0x01, 0x9D, 0xEB, 0x30, 0x1D, 0xD6, 0x4A, 0xE2, 0x7F, 0x20, 0x00, 0xC9, 0xBC, 0x22, 0x22, 0xAC, 0xDF, 0xEE, 0xEE, 0xEC, 0xCA, 0x00, 0x00, 0x00, 0x9E, 0x00, 0x00, 0x00, 0x2E, 0xA2, 0x02, 0x66, 0x03, 0xDF, 0xFF, 0xE5, 0x00, 0x02, 0x32, 0x00,
+    0x00, 0x04, 0xEF, 0xF7, 0x00, 0x0C, 0xB1, 0x10, 0x00, 0x0E, 0x70, 0x00, 0x3B, 0xBF, 0xDB, 0xB5, 0x26, 0x6F, 0xA6, 0x63, 0x00, 0x0E, 0x70, 0x00, 0x00, 0x0E, 0x70, 0x00, 0x00, 0x0E, 0x70, 0x00, 0x00, 0x0E, 0x70, 0x00, 0x00, 0x0E, 0x70, 0x00, 0x00, 0x0E, 0x70, 0x00, 0x00, 0x0E, 0x70, 0x00,
+    0x03, 0xCE, 0xC4, 0xB4, 0x2E, 0xB4, 0x6D, 0xF5, 0x8E, 0x10, 0x07, 0xF5, 0xCB, 0x00, 0x03, 0xF5, 0xDA, 0x00, 0x02, 0xF5, 0xCB, 0x00, 0x03, 0xF5, 0x9E, 0x10, 0x06, 0xF5, 0x3F, 0xA3, 0x4D, 0xF5, 0x05, 0xDF, 0xD6, 0xF5, 0x00, 0x01, 0x03, 0xF4, 0x03, 0x00, 0x09, 0xE0, 0x0D, 0xDB, 0xDE, 0x50, 0x02, 0x57, 0x51, 0x00,
+    0x4F, 0x20, 0x00, 0x00, 0x4F, 0x20, 0x00, 0x00, 0x4F, 0x20, 0x00, 0x00, 0x4F, 0x4B, 0xED, 0x50, 0x4F, 0xD7, 0x5C, 0xE1, 0x4F, 0x60, 0x03, 0xF5, 0x4F, 0x30, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6,
+    0x00, 0x09, 0xD0, 0x00, 0x00, 0x06, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xBB, 0xA0, 0x00, 0x05, 0x6B, 0xD0, 0x00, 0x00, 0x09, 0xD0, 0x00, 0x00, 0x09, 0xD0, 0x00, 0x00, 0x09, 0xD0, 0x00, 0x00, 0x09, 0xD0, 0x00, 0x00, 0x09, 0xD0, 0x00, 0x12, 0x29, 0xD2, 0x21, 0x6F, 0xFF, 0xFF, 0xFB,
+    0x00, 0x02, 0xF5, 0x00, 0x01, 0xA3, 0x00, 0x00, 0x00, 0x07, 0xBB, 0xB3, 0x03, 0x67, 0xF5, 0x00, 0x02, 0xF5, 0x00, 0x02, 0xF5, 0x00, 0x02, 0xF5, 0x00, 0x02, 0xF5, 0x00, 0x02, 0xF5, 0x00, 0x02, 0xF5, 0x00, 0x02, 0xF5, 0x00, 0x02, 0xF4, 0x00, 0x07, 0xF2, 0x5D, 0xDF, 0x80, 0x25, 0x53, 0x00,
+    0xF8, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x2B, 0x70, 0xF8, 0x02, 0xDA, 0x00, 0xF8, 0x2D, 0xA0, 0x00, 0xFA, 0xEC, 0x00, 0x00, 0xFF, 0xBF, 0x40, 0x00, 0xFA, 0x0A, 0xE1, 0x00, 0xF8, 0x01, 0xDB, 0x00, 0xF8, 0x00, 0x4F, 0x70, 0xF8, 0x00, 0x08, 0xF3,
+    0x7D, 0xEF, 0x30, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x4F, 0x30, 0x00, 0x00, 0x3F, 0x40, 0x00, 0x00, 0x0E, 0xB4, 0x41, 0x00, 0x04, 0xDF, 0xF4,
+    0xB8, 0xDC, 0x4C, 0xE5, 0x00, 0xEB, 0x4E, 0xE5, 0xAC, 0x00, 0xE6, 0x0A, 0xB0, 0x5F, 0x00, 0xE5, 0x09, 0xA0, 0x4F, 0x10, 0xE5, 0x09, 0xA0, 0x4F, 0x10, 0xE5, 0x09, 0xA0, 0x4F, 0x10, 0xE5, 0x09, 0xA0, 0x4F, 0x10, 0xE5, 0x09, 0xA0, 0x4F, 0x10, 0xE5, 0x09, 0xA0, 0x4F, 0x10,
+    0x3B, 0x3B, 0xED, 0x50, 0x4F, 0xD7, 0x5C, 0xE1, 0x4F, 0x60, 0x03, 0xF5, 0x4F, 0x30, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6,
+    0x02, 0xAE, 0xEA, 0x20, 0x1D, 0xC5, 0x5C, 0xD1, 0x7F, 0x20, 0x02, 0xF7, 0xAD, 0x00, 0x00, 0xDA, 0xBC, 0x00, 0x00, 0xCB, 0xAC, 0x00, 0x00, 0xCA, 0x8F, 0x10, 0x01, 0xF8, 0x2F, 0xA1, 0x1A, 0xF2, 0x05, 0xEF, 0xFE, 0x50, 0x00, 0x03, 0x30, 0x00,
+    0x4B, 0x4C, 0xEC, 0x30, 0x5F, 0xE6, 0x4B, 0xE2, 0x5F, 0x70, 0x01, 0xE8, 0x5F, 0x30, 0x00, 0xBB, 0x5F, 0x20, 0x00, 0xAC, 0x5F, 0x20, 0x00, 0xBC, 0x5F, 0x60, 0x00, 0xE9, 0x5F, 0xD2, 0x08, 0xF4, 0x5F, 0x8F, 0xFF, 0x70, 0x5F, 0x21, 0x31, 0x00, 0x5F, 0x20, 0x00, 0x00, 0x5F, 0x20, 0x00, 0x00, 0x25, 0x10, 0x00, 0x00,
+    0x02, 0xBE, 0xC4, 0xB5, 0x1D, 0xC5, 0x6D, 0xF6, 0x6F, 0x20, 0x06, 0xF6, 0xAD, 0x00, 0x02, 0xF6, 0xBC, 0x00, 0x00, 0xF6, 0xBC, 0x00, 0x01, 0xF6, 0x8F, 0x10, 0x04, 0xF6, 0x3F, 0x90, 0x1C, 0xF6, 0x06, 0xFF, 0xF8, 0xF6, 0x00, 0x14, 0x20, 0xF6, 0x00, 0x00, 0x00, 0xF6, 0x00, 0x00, 0x00, 0xF6, 0x00, 0x00, 0x00, 0x62,
+    0xB5, 0x6D, 0xEB, 0x10, 0xFB, 0xD7, 0x6A, 0x30, 0xFE, 0x10, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xF7, 0x00, 0x00, 0x00, 0xF7, 0x00, 0x00, 0x00, 0xF7, 0x00, 0x00, 0x00, 0xF7, 0x00, 0x00, 0x00, 0xF7, 0x00, 0x00, 0x00,
+    0x02, 0xAE, 0xEC, 0x70, 0x0D, 0xC5, 0x46, 0x90, 0x2F, 0x50, 0x00, 0x00, 0x0E, 0xC4, 0x10, 0x00, 0x04, 0xCF, 0xFC, 0x40, 0x00, 0x01, 0x5D, 0xE1, 0x00, 0x00, 0x04, 0xF3, 0x28, 0x20, 0x1A, 0xE1, 0x2D, 0xFF, 0xFE, 0x50, 0x00, 0x23, 0x30, 0x00,
+    0x00, 0x24, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x9B, 0xDF, 0xBB, 0xB3, 0x46, 0xAF, 0x66, 0x61, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x4F, 0x72, 0x20, 0x00, 0x08, 0xEF, 0xF4,
+    0x3B, 0x20, 0x01, 0xB4, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x20, 0x01, 0xF6, 0x4F, 0x30, 0x04, 0xF6, 0x1F, 0xA1, 0x2B, 0xF6, 0x07, 0xFF, 0xE6, 0xF6, 0x00, 0x23, 0x10, 0x00,
+    0xA7, 0x00, 0x00, 0x7A, 0x9D, 0x00, 0x00, 0xD9, 0x4F, 0x40, 0x04, 0xF4, 0x0D, 0x90, 0x09, 0xD0, 0x08, 0xE0, 0x0E, 0x80, 0x03, 0xF4, 0x4F, 0x30, 0x00, 0xC9, 0x9C, 0x00, 0x00, 0x7E, 0xE7, 0x00, 0x00, 0x2F, 0xF2, 0x00,
+    0x88, 0x00, 0x00, 0x00, 0x88, 0x8D, 0x00, 0x00, 0x00, 0xD8, 0x4F, 0x10, 0x22, 0x01, 0xF4, 0x1F, 0x50, 0xCC, 0x05, 0xF1, 0x0C, 0x81, 0xEE, 0x18, 0xC0, 0x09, 0xB6, 0x99, 0x5B, 0x90, 0x05, 0xEA, 0x55, 0xAE, 0x50, 0x02, 0xFE, 0x11, 0xEF, 0x20, 0x00, 0xDB, 0x00, 0xBD, 0x00,
+    0x7A, 0x10, 0x01, 0xA7, 0x1D, 0x90, 0x09, 0xD1, 0x04, 0xF5, 0x5F, 0x40, 0x00, 0x7E, 0xE7, 0x00, 0x00, 0x1E, 0xE1, 0x00, 0x00, 0x9E, 0xE9, 0x00, 0x05, 0xF4, 0x4F, 0x50, 0x2E, 0x80, 0x08, 0xE2, 0xCC, 0x00, 0x00, 0xCC,
+    0xA7, 0x00, 0x00, 0x5B, 0x10, 0x8E, 0x10, 0x00, 0xCB, 0x00, 0x2F, 0x60, 0x03, 0xF5, 0x00, 0x0B, 0xB0, 0x08, 0xE0, 0x00, 0x05, 0xF2, 0x0E, 0x80, 0x00, 0x00, 0xE8, 0x4F, 0x20, 0x00, 0x00, 0x8D, 0xAB, 0x00, 0x00, 0x00, 0x2F, 0xF6, 0x00, 0x00, 0x00, 0x0C, 0xE1, 0x00, 0x00, 0x00, 0x0D, 0x90, 0x00, 0x00, 0x00, 0x6F, 0x30, 0x00, 0x00, 0x5D, 0xF9, 0x00, 0x00, 0x00, 0x25, 0x30, 0x00, 0x00, 0x00,
+    0x0B, 0xBB, 0xBB, 0xB3, 0x06, 0x66, 0x6A, 0xF3, 0x00, 0x00, 0x2E, 0x80, 0x00, 0x01, 0xDB, 0x00, 0x00, 0x0A, 0xD1, 0x00, 0x00, 0x7E, 0x30, 0x00, 0x05, 0xF5, 0x00, 0x00, 0x2E, 0xA3, 0x33, 0x31, 0x3F, 0xFF, 0xFF, 0xF5,
+    0x00, 0x02, 0xDF, 0xE1, 0x00, 0x08, 0xE2, 0x00, 0x00, 0x0A, 0xC0, 0x00, 0x00, 0x0A, 0xC0, 0x00, 0x00, 0x0A, 0xC0, 0x00, 0x00, 0x0C, 0xB0, 0x00, 0x16, 0x8F, 0x50, 0x00, 0x1C, 0xEC, 0x20, 0x00, 0x00, 0x1E, 0x90, 0x00, 0x00, 0x0A, 0xC0, 0x00, 0x00, 0x0A, 0xC0, 0x00, 0x00, 0x0A, 0xC0, 0x00, 0x00, 0x09, 0xD0, 0x00, 0x00, 0x05, 0xFA, 0x81, 0x00, 0x00, 0x58, 0x91,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x88,
+    0x1E, 0xFD, 0x20, 0x00, 0x00, 0x2E, 0x80, 0x00, 0x00, 0x0C, 0xA0, 0x00, 0x00, 0x0C, 0xA0, 0x00, 0x00, 0x0C, 0xA0, 0x00, 0x00, 0x0B, 0xB0, 0x00, 0x00, 0x05, 0xF8, 0x61, 0x00, 0x02, 0xCE, 0xC1, 0x00, 0x09, 0xD1, 0x00, 0x00, 0x0C, 0xA0, 0x00, 0x00, 0x0C, 0xA0, 0x00, 0x00, 0x0C, 0xA0, 0x00, 0x00, 0x0D, 0x90, 0x00, 0x18, 0xAF, 0x50, 0x00, 0x19, 0x84, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x09, 0xFF, 0xD7, 0x33, 0xA2, 0x2B, 0x43, 0x7D, 0xFF, 0xA1, 0x00, 0x00, 0x00, 0x21, 0x00,
+};
+
+static const ui_glyph_t kGlyphs[] = {
+    {    0,  0,  0,   0,   0, 12},   // ' '
+    {    0,  2, 12,   5,   0, 12},   // '!'
+    {   12,  6,  5,   3,   0, 12},   // '"'
+    {   27, 10, 12,   1,   0, 12},   // '#'
+    {   87,  8, 15,   2,   0, 12},   // '$'
+    {  147, 10, 12,   1,   0, 12},   // '%'
+    {  207, 10, 13,   1,   0, 12},   // '&'
+    {  272,  2,  5,   5,   0, 12},   // '\''
+    {  277,  4, 15,   4,   0, 12},   // '('
+    {  307,  4, 15,   4,   0, 12},   // ')'
+    {  337,  8,  8,   2,   0, 12},   // '*'
+    {  369, 10, 10,   1,   2, 12},   // '+'
+    {  419,  4,  6,   4,   9, 12},   // ','
+    {  431,  6,  2,   3,   7, 12},   // '-'
+    {  437,  2,  3,   5,   9, 12},   // '.'
+    {  440,  8, 14,   2,   0, 12},   // '/'
+    {  496,  8, 13,   2,   0, 12},   // '0'
+    {  548,  7, 12,   3,   0, 12},   // '1'
+    {  596,  8, 12,   2,   0, 12},   // '2'
+    {  644,  8, 13,   2,   0, 12},   // '3'
+    {  696,  9, 12,   2,   0, 12},   // '4'
+    {  756,  8, 13,   2,   0, 12},   // '5'
+    {  808,  8, 13,   2,   0, 12},   // '6'
+    {  860,  8, 12,   2,   0, 12},   // '7'
+    {  908,  8, 13,   2,   0, 12},   // '8'
+    {  960,  8, 13,   2,   0, 12},   // '9'
+    { 1012,  2,  9,   5,   3, 12},   // ':'
+    { 1021,  4, 12,   4,   3, 12},   // ';'
+    { 1045, 10,  8,   1,   3, 12},   // '<'
+    { 1085, 10,  6,   1,   4, 12},   // '='
+    { 1115, 10,  8,   1,   3, 12},   // '>'
+    { 1155,  7, 12,   3,   0, 12},   // '?'
+    { 1203, 10, 14,   1,   1, 12},   // '@'
+    { 1273, 10, 12,   1,   0, 12},   // 'A'
+    { 1333,  9, 12,   2,   0, 12},   // 'B'
+    { 1393,  8, 13,   2,   0, 12},   // 'C'
+    { 1445,  8, 12,   2,   0, 12},   // 'D'
+    { 1493,  8, 12,   2,   0, 12},   // 'E'
+    { 1541,  7, 12,   3,   0, 12},   // 'F'
+    { 1589,  8, 13,   2,   0, 12},   // 'G'
+    { 1641,  8, 12,   2,   0, 12},   // 'H'
+    { 1689,  8, 12,   2,   0, 12},   // 'I'
+    { 1737,  7, 13,   2,   0, 12},   // 'J'
+    { 1789,  9, 12,   2,   0, 12},   // 'K'
+    { 1849,  9, 12,   2,   0, 12},   // 'L'
+    { 1909, 10, 12,   1,   0, 12},   // 'M'
+    { 1969,  8, 12,   2,   0, 12},   // 'N'
+    { 2017,  8, 13,   2,   0, 12},   // 'O'
+    { 2069,  9, 12,   2,   0, 12},   // 'P'
+    { 2129,  8, 14,   2,   0, 12},   // 'Q'
+    { 2185,  9, 12,   2,   0, 12},   // 'R'
+    { 2245,  8, 13,   2,   0, 12},   // 'S'
+    { 2297, 10, 12,   1,   0, 12},   // 'T'
+    { 2357,  8, 13,   2,   0, 12},   // 'U'
+    { 2409, 10, 12,   1,   0, 12},   // 'V'
+    { 2469, 10, 12,   1,   0, 12},   // 'W'
+    { 2529, 10, 12,   1,   0, 12},   // 'X'
+    { 2589, 10, 12,   1,   0, 12},   // 'Y'
+    { 2649,  9, 12,   2,   0, 12},   // 'Z'
+    { 2709,  5, 15,   4,   0, 12},   // '['
+    { 2754,  8, 14,   2,   0, 12},   // '\\'
+    { 2810,  5, 15,   3,   0, 12},   // ']'
+    { 2855, 10,  5,   1,   0, 12},   // '^'
+    { 2880, 10,  1,   1,  15, 12},   // '_'
+    { 2885,  3,  3,   4,   0, 12},   // '`'
+    { 2891,  8, 10,   2,   3, 12},   // 'a'
+    { 2931,  8, 13,   2,   0, 12},   // 'b'
+    { 2983,  8, 10,   2,   3, 12},   // 'c'
+    { 3023,  8, 13,   2,   0, 12},   // 'd'
+    { 3075,  8, 10,   2,   3, 12},   // 'e'
+    { 3115,  8, 12,   2,   0, 12},   // 'f'
+    { 3163,  8, 13,   2,   3, 12},   // 'g'
+    { 3215,  8, 12,   2,   0, 12},   // 'h'
+    { 3263,  8, 12,   2,   0, 12},   // 'i'
+    { 3311,  6, 16,   2,   0, 12},   // 'j'
+    { 3359,  8, 12,   3,   0, 12},   // 'k'
+    { 3407,  8, 12,   2,   0, 12},   // 'l'
+    { 3455,  9,  9,   2,   3, 12},   // 'm'
+    { 3500,  8,  9,   2,   3, 12},   // 'n'
+    { 3536,  8, 10,   2,   3, 12},   // 'o'
+    { 3576,  8, 13,   2,   3, 12},   // 'p'
+    { 3628,  8, 13,   2,   3, 12},   // 'q'
+    { 3680,  7,  9,   4,   3, 12},   // 'r'
+    { 3716,  8, 10,   2,   3, 12},   // 's'
+    { 3756,  8, 12,   2,   0, 12},   // 't'
+    { 3804,  8, 10,   2,   3, 12},   // 'u'
+    { 3844,  8,  9,   2,   3, 12},   // 'v'
+    { 3880, 10,  9,   1,   3, 12},   // 'w'
+    { 3925,  8,  9,   2,   3, 12},   // 'x'
+    { 3961,  9, 13,   2,   3, 12},   // 'y'
+    { 4026,  8,  9,   2,   3, 12},   // 'z'
+    { 4062,  8, 15,   2,   0, 12},   // '{'
+    { 4122,  2, 16,   5,   0, 12},   // '|'
+    { 4138,  8, 15,   2,   0, 12},   // '}'
+    { 4198, 10,  4,   1,   5, 12},   // '~'
+};
+
+extern const ui_font_t ui_font_mono_16 = {
+    kBitmap, kGlyphs, 32, 126, 4, 16, 12
+};
@@ -0,0 +1,212 @@
+/*
+ * UI Font: mono_24
+ * Generated by tools/font_atlas.py from DejaVuSansMono.ttf; do not edit
+ *
+ * Copyright (c) 2003 by Bitstream, Inc. All Rights Reserved.
+ * DejaVu changes are in public domain
+ * Glyph data derived from the font; its license is in LICENSE-DejaVu.txt
+ *
+ * 24 px, 4-bit alpha, 18x24 cells, baseline at row 18
+ * tools/font_atlas.py DejaVuSansMono.ttf --name mono_24 --size 24 --cell 18x24 --baseline 18 --bpp 4 --license src/ui/fonts/LICENSE-DejaVu.txt -o src/ui/fonts/ui_font_mono_24.cpp
+ */
+
+#include "ui/ui_font.h"
+
+static const uint8_t kBitmap[] = {
+    0x18, 0x82, 0x3F, 0xF3, 0x3F, 0xF3, 0x3F, 0xF3, 0x3F, 0xF3, 0x3F, 0xF3, 0x3F, 0xF3, 0x3F, 0xF3, 0x2F, 0xF3, 0x2F, 0xF2, 0x1F, 0xF1, 0x0F, 0xF0, 0x05, 0x50, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF3, 0x3F, 0xF3, 0x3F, 0xF3,
+    0x28, 0x60, 0x06, 0x82, 0x4F, 0xC0, 0x0C, 0xF4, 0x4F, 0xC0, 0x0C, 0xF4, 0x4F, 0xC0, 0x0C, 0xF4, 0x4F, 0xC0, 0x0C, 0xF4, 0x4F, 0xC0, 0x0C, 0xF4, 0x4F, 0xC0, 0x0C, 0xF4,
+    0x00, 0x00, 0x00, 0x04, 0x30, 0x01, 0x42, 0x00, 0x00, 0x00, 0x00, 0x4F, 0x90, 0x08, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x8F, 0x50, 0x0B, 0xF2, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x20, 0x1F, 0xD0, 0x00, 0x00, 0x00, 0x01, 0xFD, 0x00, 0x4F, 0x90, 0x00, 0x00, 0x56, 0x68, 0xFC, 0x66, 0xAF, 0x96, 0x61, 0x00, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x00, 0x67, 0x7D, 0xF7, 0x77, 0xFD, 0x77, 0x71, 0x00, 0x00, 0x0F, 0xD0, 0x04, 0xF9, 0x00, 0x00, 0x00, 0x00, 0x4F, 0x90, 0x08, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x8F, 0x60, 0x0B, 0xF2, 0x00, 0x00, 0x29, 0x99, 0xDF, 0xA9, 0x9F, 0xF9, 0x98, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x02, 0x26, 0xFA, 0x22, 0x9F, 0x62, 0x22, 0x00, 0x00, 0x08, 0xF5, 0x00, 0xBF, 0x20, 0x00, 0x00, 0x00, 0x0C, 0xF2, 0x01, 0xFD, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xD0, 0x04, 0xF9, 0x00, 0x00, 0x00, 0x00, 0x4F, 0x90, 0x08, 0xF5, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x4D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4D, 0x00, 0x00, 0x00, 0x00, 0x14, 0x9E, 0x64, 0x10, 0x00, 0x06, 0xEF, 0xFF, 0xFF, 0xF9, 0x00, 0x5F, 0xE6, 0x6E, 0x36, 0xBA, 0x00, 0xCF, 0x60, 0x4D, 0x00, 0x01, 0x00, 0xFF, 0x20, 0x4D, 0x00, 0x00, 0x00, 0xEF, 0x50, 0x4D, 0x00, 0x00, 0x00, 0x9F, 0xE5, 0x5D, 0x00, 0x00, 0x00, 0x1B, 0xFF, 0xFF, 0xA6, 0x10, 0x00, 0x00, 0x5B, 0xEF, 0xFF, 0xE5, 0x00, 0x00, 0x00, 0x4E, 0x5B, 0xFF, 0x30, 0x00, 0x00, 0x4D, 0x00, 0xAF, 0xA0, 0x00, 0x00, 0x4D, 0x00, 0x6F, 0xC0, 0x00, 0x00, 0x4D, 0x00, 0x7F, 0xB0, 0xD6, 0x10, 0x4D, 0x03, 0xEF, 0x60, 0xFF, 0xFC, 0xCE, 0xCF, 0xF9, 0x00, 0x27, 0xBD, 0xFF, 0xEB, 0x50, 0x00, 0x00, 0x00, 0x4D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00,
+    0x01, 0x8B, 0xB6, 0x00, 0x00, 0x00, 0x00, 0x1D, 0xFD, 0xEF, 0xA0, 0x00, 0x00, 0x00, 0x8F, 0x50, 0x08, 0xF5, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x01, 0xF9, 0x00, 0x00, 0x00, 0x8F, 0x60, 0x09, 0xF5, 0x00, 0x00, 0x41, 0x1C, 0xFE, 0xEF, 0xA0, 0x01, 0x7D, 0xF4, 0x01, 0x7A, 0xA5, 0x04, 0xAF, 0xD7, 0x10, 0x00, 0x00, 0x17, 0xDF, 0xA4, 0x00, 0x00, 0x00, 0x4A, 0xFC, 0x71, 0x27, 0x73, 0x00, 0x1D, 0xE9, 0x30, 0x07, 0xFF, 0xFF, 0x80, 0x06, 0x10, 0x00, 0x3F, 0xB3, 0x2A, 0xF5, 0x00, 0x00, 0x00, 0x9F, 0x10, 0x00, 0xEB, 0x00, 0x00, 0x00, 0x9E, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x7F, 0x50, 0x03, 0xF9, 0x00, 0x00, 0x00, 0x1D, 0xFA, 0xAE, 0xE2, 0x00, 0x00, 0x00, 0x02, 0xAE, 0xFB, 0x30,
+    0x00, 0x00, 0x5A, 0xCC, 0xA6, 0x00, 0x00, 0x00, 0x08, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x3F, 0xF6, 0x10, 0x39, 0x00, 0x00, 0x00, 0x6F, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xF9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xFF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xDF, 0xE2, 0x00, 0x00, 0x00, 0x08, 0xFA, 0x0A, 0xFB, 0x00, 0x01, 0xEC, 0x2F, 0xE1, 0x01, 0xDF, 0x80, 0x01, 0xFC, 0x6F, 0x90, 0x00, 0x3F, 0xF4, 0x01, 0xFA, 0x8F, 0x80, 0x00, 0x07, 0xFE, 0x14, 0xF7, 0x8F, 0xA0, 0x00, 0x00, 0xBF, 0xBA, 0xF3, 0x5F, 0xE1, 0x00, 0x00, 0x1E, 0xFF, 0xA0, 0x0D, 0xFC, 0x10, 0x00, 0x0A, 0xFF, 0x50, 0x03, 0xEF, 0xE9, 0x79, 0xDF, 0xEF, 0xD1, 0x00, 0x2B, 0xFF, 0xFF, 0xE8, 0x1B, 0xFB, 0x00, 0x00, 0x24, 0x53, 0x00, 0x00, 0x00,
+    0x08, 0x80, 0x1F, 0xF0, 0x1F, 0xF0, 0x1F, 0xF0, 0x1F, 0xF0, 0x1F, 0xF0, 0x1F, 0xF0,
+    0x00, 0x03, 0xFB, 0x00, 0x0B, 0xF3, 0x00, 0x4F, 0xC0, 0x00, 0xBF, 0x50, 0x02, 0xFE, 0x10, 0x07, 0xFB, 0x00, 0x0B, 0xF7, 0x00, 0x0E, 0xF4, 0x00, 0x2F, 0xF2, 0x00, 0x3F, 0xF1, 0x00, 0x3F, 0xF1, 0x00, 0x3F, 0xF1, 0x00, 0x1F, 0xF3, 0x00, 0x0E, 0xF5, 0x00, 0x0B, 0xF7, 0x00, 0x07, 0xFB, 0x00, 0x02, 0xFF, 0x10, 0x00, 0xAF, 0x60, 0x00, 0x3F, 0xC0, 0x00, 0x0B, 0xF4, 0x00, 0x02, 0xFC, 0x00, 0x00, 0x23,
+    0xBF, 0x30, 0x00, 0x4F, 0xB0, 0x00, 0x0C, 0xF4, 0x00, 0x06, 0xFB, 0x00, 0x01, 0xFF, 0x20, 0x00, 0xBF, 0x70, 0x00, 0x7F, 0xB0, 0x00, 0x4F, 0xE0, 0x00, 0x2F, 0xF2, 0x00, 0x1F, 0xF3, 0x00, 0x1F, 0xF3, 0x00, 0x1F, 0xF3, 0x00, 0x3F, 0xF1, 0x00, 0x5F, 0xE0, 0x00, 0x7F, 0xB0, 0x00, 0xBF, 0x70, 0x01, 0xFF, 0x20, 0x06, 0xFA, 0x00, 0x0C, 0xF3, 0x00, 0x4F, 0xB0, 0x00, 0xCF, 0x20, 0x00, 0x32, 0x00, 0x00,
+    0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xA0, 0x00, 0x00, 0x08, 0x20, 0x0A, 0xA0, 0x02, 0x80, 0x1C, 0xF7, 0x0A, 0xA0, 0x7F, 0xC1, 0x00, 0x5D, 0xDD, 0xDD, 0xD5, 0x00, 0x00, 0x00, 0x8F, 0xF8, 0x00, 0x00, 0x00, 0x19, 0xFE, 0xEF, 0x91, 0x00, 0x17, 0xEC, 0x3A, 0xA3, 0xCE, 0x71, 0x1D, 0x60, 0x0A, 0xA0, 0x06, 0xD1, 0x00, 0x00, 0x0A, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x01, 0x10, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x18, 0x88, 0x88, 0xFF, 0x88, 0x88, 0x81, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x18, 0x88, 0x88, 0xFF, 0x88, 0x88, 0x81, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x00,
+    0x03, 0x88, 0x50, 0x05, 0xFF, 0x90, 0x05, 0xFF, 0x90, 0x08, 0xFF, 0x40, 0x0B, 0xFC, 0x00, 0x1F, 0xF4, 0x00, 0x4F, 0xB0, 0x00, 0x36, 0x20, 0x00,
+    0x08, 0x88, 0x88, 0x80, 0x1F, 0xFF, 0xFF, 0xF1, 0x06, 0x66, 0x66, 0x60,
+    0x48, 0x84, 0x7F, 0xF7, 0x7F, 0xF7, 0x7F, 0xF7,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xE1, 0x00, 0x00, 0x00, 0x00, 0xBF, 0x70, 0x00, 0x00, 0x00, 0x03, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x0A, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x9F, 0x90, 0x00, 0x00, 0x00, 0x02, 0xFF, 0x20, 0x00, 0x00, 0x00, 0x08, 0xFA, 0x00, 0x00, 0x00, 0x00, 0x1E, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xB0, 0x00, 0x00, 0x00, 0x01, 0xEF, 0x40, 0x00, 0x00, 0x00, 0x06, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x60, 0x00, 0x00, 0x00, 0x04, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x0B, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xE1, 0x00, 0x00, 0x00, 0x00, 0xAF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x44, 0x10, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x03, 0x9C, 0xC9, 0x30, 0x00, 0x00, 0x6F, 0xFF, 0xFF, 0xF6, 0x00, 0x04, 0xFF, 0x92, 0x29, 0xFF, 0x30, 0x0B, 0xFB, 0x00, 0x00, 0xBF, 0xB0, 0x1F, 0xF4, 0x00, 0x00, 0x4F, 0xF1, 0x5F, 0xF1, 0x00, 0x00, 0x1F, 0xF5, 0x7F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x9F, 0xC0, 0x04, 0x40, 0x0C, 0xF9, 0xAF, 0xB0, 0x5F, 0xF5, 0x0B, 0xFA, 0xAF, 0xB0, 0x8F, 0xF8, 0x0B, 0xFA, 0x9F, 0xB0, 0x1A, 0xA1, 0x0B, 0xF9, 0x8F, 0xC0, 0x00, 0x00, 0x0C, 0xF8, 0x6F, 0xE0, 0x00, 0x00, 0x0E, 0xF6, 0x3F, 0xF2, 0x00, 0x00, 0x2F, 0xF3, 0x0E, 0xF7, 0x00, 0x00, 0x7F, 0xE0, 0x08, 0xFE, 0x20, 0x02, 0xEF, 0x80, 0x01, 0xDF, 0xE9, 0x9E, 0xFD, 0x10, 0x00, 0x2B, 0xFF, 0xFF, 0xB1, 0x00, 0x00, 0x00, 0x25, 0x52, 0x00, 0x00,
+    0x00, 0x14, 0x78, 0x70, 0x00, 0x00, 0x3C, 0xFF, 0xFF, 0xE0, 0x00, 0x00, 0x5F, 0xFD, 0xCF, 0xE0, 0x00, 0x00, 0x25, 0x20, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0x90, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0x90,
+    0x01, 0x59, 0xCC, 0xB8, 0x20, 0x00, 0x3E, 0xFF, 0xFF, 0xFF, 0xF6, 0x00, 0x5F, 0xC7, 0x43, 0x5C, 0xFF, 0x50, 0x34, 0x00, 0x00, 0x00, 0xCF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xD0, 0x00, 0x00, 0x00, 0x01, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x09, 0xFD, 0x10, 0x00, 0x00, 0x00, 0x6F, 0xE3, 0x00, 0x00, 0x00, 0x05, 0xFF, 0x50, 0x00, 0x00, 0x00, 0x4F, 0xF6, 0x00, 0x00, 0x00, 0x03, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x2E, 0xF8, 0x00, 0x00, 0x00, 0x02, 0xDF, 0x90, 0x00, 0x00, 0x00, 0x1D, 0xF9, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3,
+    0x03, 0x79, 0xCC, 0xB8, 0x20, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xF7, 0x00, 0x1D, 0x96, 0x33, 0x5A, 0xFF, 0x50, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x00, 0x00, 0x00, 0x01, 0xCF, 0xA0, 0x00, 0x03, 0x55, 0x7D, 0xFD, 0x20, 0x00, 0x09, 0xFF, 0xFF, 0x91, 0x00, 0x00, 0x06, 0x9A, 0xCF, 0xFA, 0x10, 0x00, 0x00, 0x00, 0x03, 0xDF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xF4, 0x76, 0x10, 0x00, 0x03, 0xDF, 0xD0, 0x9F, 0xFC, 0xAA, 0xCF, 0xFF, 0x40, 0x5C, 0xFF, 0xFF, 0xFF, 0xB3, 0x00, 0x00, 0x13, 0x55, 0x41, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x18, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFE, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x1D, 0xDA, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x8F, 0x49, 0xFB, 0x00, 0x00, 0x00, 0x03, 0xFA, 0x09, 0xFB, 0x00, 0x00, 0x00, 0x0C, 0xE2, 0x09, 0xFB, 0x00, 0x00, 0x00, 0x7F, 0x70, 0x09, 0xFB, 0x00, 0x00, 0x02, 0xED, 0x10, 0x09, 0xFB, 0x00, 0x00, 0x0B, 0xF5, 0x00, 0x09, 0xFB, 0x00, 0x00, 0x5F, 0xB0, 0x00, 0x09, 0xFB, 0x00, 0x00, 0xEF, 0x42, 0x22, 0x2A, 0xFC, 0x22, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0xCC, 0xCC, 0xCC, 0xCE, 0xFE, 0xCC, 0x10, 0x00, 0x00, 0x00, 0x09, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFB, 0x00, 0x00,
+    0x06, 0x88, 0x88, 0x88, 0x88, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0x0C, 0xFA, 0x88, 0x88, 0x88, 0x00, 0x0C, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xF8, 0x78, 0x74, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xD3, 0x00, 0x0C, 0xB8, 0x77, 0xAF, 0xFE, 0x20, 0x01, 0x00, 0x00, 0x03, 0xEF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xE1, 0x65, 0x00, 0x00, 0x06, 0xFF, 0x90, 0x8F, 0xEB, 0xAB, 0xDF, 0xFC, 0x10, 0x6E, 0xFF, 0xFF, 0xFE, 0x81, 0x00, 0x00, 0x24, 0x55, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x6A, 0xCC, 0xA6, 0x10, 0x00, 0x2D, 0xFF, 0xFF, 0xFF, 0x60, 0x01, 0xDF, 0xE7, 0x33, 0x5A, 0x60, 0x08, 0xFD, 0x20, 0x00, 0x00, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xB0, 0x27, 0x87, 0x30, 0x00, 0x9F, 0x97, 0xFF, 0xFF, 0xFA, 0x10, 0xAF, 0xCF, 0xB5, 0x58, 0xFF, 0xA0, 0xAF, 0xFB, 0x00, 0x00, 0x5F, 0xF3, 0xAF, 0xF3, 0x00, 0x00, 0x0D, 0xF7, 0x9F, 0xF0, 0x00, 0x00, 0x0B, 0xF9, 0x7F, 0xE0, 0x00, 0x00, 0x0A, 0xFA, 0x4F, 0xF0, 0x00, 0x00, 0x0B, 0xF9, 0x1E, 0xF4, 0x00, 0x00, 0x1E, 0xF6, 0x09, 0xFD, 0x10, 0x00, 0x8F, 0xF1, 0x01, 0xDF, 0xE9, 0x8C, 0xFF, 0x70, 0x00, 0x2B, 0xFF, 0xFF, 0xE6, 0x00, 0x00, 0x00, 0x24, 0x53, 0x00, 0x00,
+    0x48, 0x88, 0x88, 0x88, 0x88, 0x83, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF6, 0x48, 0x88, 0x88, 0x88, 0xAF, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xA0, 0x00, 0x00, 0x00, 0x01, 0xEF, 0x40, 0x00, 0x00, 0x00, 0x06, 0xFD, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xC0, 0x00, 0x00, 0x00, 0x01, 0xEF, 0x60, 0x00, 0x00, 0x00, 0x05, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x0B, 0xF9, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x05, 0xFF, 0x20, 0x00, 0x00, 0x00, 0x0B, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xF5, 0x00, 0x00, 0x00,
+    0x00, 0x06, 0xAC, 0xCA, 0x60, 0x00, 0x01, 0xCF, 0xFF, 0xFF, 0xFC, 0x10, 0x0B, 0xFE, 0x51, 0x15, 0xEF, 0xB0, 0x2F, 0xF5, 0x00, 0x00, 0x5F, 0xF2, 0x4F, 0xF2, 0x00, 0x00, 0x2F, 0xF4, 0x3F, 0xF2, 0x00, 0x00, 0x2F, 0xF3, 0x0D, 0xF6, 0x00, 0x00, 0x6F, 0xD0, 0x04, 0xEF, 0x73, 0x37, 0xFE, 0x40, 0x00, 0x2B, 0xFF, 0xFF, 0xB2, 0x00, 0x02, 0xBF, 0xEB, 0xBE, 0xFB, 0x20, 0x1D, 0xFA, 0x10, 0x01, 0xAF, 0xD1, 0x6F, 0xE1, 0x00, 0x00, 0x1E, 0xF6, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0xAF, 0xB0, 0x00, 0x00, 0x0B, 0xFA, 0x9F, 0xE0, 0x00, 0x00, 0x0D, 0xF9, 0x4F, 0xF8, 0x00, 0x00, 0x7F, 0xF4, 0x0A, 0xFF, 0xC8, 0x8C, 0xFF, 0xA0, 0x00, 0x7E, 0xFF, 0xFF, 0xE7, 0x00, 0x00, 0x00, 0x35, 0x53, 0x00, 0x00,
+    0x00, 0x17, 0xBC, 0xB9, 0x30, 0x00, 0x02, 0xDF, 0xFF, 0xFF, 0xF6, 0x00, 0x0D, 0xFD, 0x41, 0x28, 0xFF, 0x40, 0x5F, 0xF2, 0x00, 0x00, 0xAF, 0xB0, 0x9F, 0xC0, 0x00, 0x00, 0x3F, 0xF1, 0xBF, 0x90, 0x00, 0x00, 0x1F, 0xF4, 0xBF, 0x90, 0x00, 0x00, 0x0F, 0xF7, 0xAF, 0xB0, 0x00, 0x00, 0x2F, 0xF8, 0x6F, 0xE1, 0x00, 0x00, 0x7F, 0xF9, 0x1E, 0xFA, 0x10, 0x04, 0xEF, 0xF9, 0x05, 0xFF, 0xEC, 0xDF, 0xDA, 0xF8, 0x00, 0x4B, 0xFF, 0xFA, 0x1B, 0xF7, 0x00, 0x00, 0x01, 0x00, 0x0D, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF1, 0x00, 0x00, 0x00, 0x00, 0xAF, 0xB0, 0x03, 0x20, 0x00, 0x08, 0xFF, 0x30, 0x07, 0xFC, 0xAB, 0xEF, 0xF7, 0x00, 0x05, 0xEF, 0xFF, 0xFD, 0x50, 0x00, 0x00, 0x03, 0x55, 0x30, 0x00, 0x00,
+    0x37, 0x73, 0x7F, 0xF7, 0x7F, 0xF7, 0x7F, 0xF7, 0x01, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x84, 0x7F, 0xF7, 0x7F, 0xF7, 0x7F, 0xF7,
+    0x03, 0x77, 0x30, 0x07, 0xFF, 0x70, 0x07, 0xFF, 0x70, 0x07, 0xFF, 0x70, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x88, 0x50, 0x05, 0xFF, 0x90, 0x05, 0xFF, 0x90, 0x08, 0xFF, 0x40, 0x0B, 0xFC, 0x00, 0x1F, 0xF4, 0x00, 0x4F, 0xB0, 0x00, 0x36, 0x20, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5B, 0xF3, 0x00, 0x00, 0x00, 0x02, 0x8E, 0xFF, 0xE2, 0x00, 0x00, 0x05, 0xBF, 0xFF, 0xB6, 0x10, 0x00, 0x38, 0xEF, 0xFD, 0x82, 0x00, 0x00, 0x2C, 0xFF, 0xEA, 0x40, 0x00, 0x00, 0x00, 0x3F, 0xFC, 0x20, 0x00, 0x00, 0x00, 0x00, 0x1B, 0xFF, 0xFA, 0x40, 0x00, 0x00, 0x00, 0x00, 0x28, 0xDF, 0xFE, 0x83, 0x00, 0x00, 0x00, 0x00, 0x05, 0xBF, 0xFF, 0xC6, 0x10, 0x00, 0x00, 0x00, 0x02, 0x7D, 0xFF, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4A, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11,
+    0x3D, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0xD3, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x01, 0x11, 0x11, 0x11, 0x11, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x22, 0x22, 0x22, 0x22, 0x22, 0x20, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x3D, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0xD3,
+    0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xB5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2E, 0xFF, 0xE8, 0x20, 0x00, 0x00, 0x00, 0x01, 0x6B, 0xFF, 0xFB, 0x50, 0x00, 0x00, 0x00, 0x00, 0x28, 0xDF, 0xFE, 0x83, 0x00, 0x00, 0x00, 0x00, 0x04, 0xAE, 0xFF, 0xC2, 0x00, 0x00, 0x00, 0x00, 0x02, 0xCF, 0xF3, 0x00, 0x00, 0x00, 0x04, 0xAF, 0xFF, 0xB1, 0x00, 0x00, 0x38, 0xEF, 0xFD, 0x82, 0x00, 0x01, 0x6C, 0xFF, 0xFB, 0x50, 0x00, 0x00, 0x2F, 0xFF, 0xD7, 0x20, 0x00, 0x00, 0x00, 0x3F, 0xA4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x5A, 0xCC, 0xA6, 0x00, 0x3E, 0xFF, 0xFF, 0xFF, 0xC1, 0x5F, 0xA4, 0x23, 0x8F, 0xF8, 0x33, 0x00, 0x00, 0x09, 0xFD, 0x00, 0x00, 0x00, 0x06, 0xFE, 0x00, 0x00, 0x00, 0x0A, 0xFB, 0x00, 0x00, 0x00, 0x7F, 0xF4, 0x00, 0x00, 0x07, 0xFF, 0x60, 0x00, 0x00, 0x6F, 0xF6, 0x00, 0x00, 0x01, 0xEF, 0x70, 0x00, 0x00, 0x05, 0xFD, 0x00, 0x00, 0x00, 0x06, 0xFC, 0x00, 0x00, 0x00, 0x07, 0xFC, 0x00, 0x00, 0x00, 0x02, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0xFD, 0x00, 0x00, 0x00, 0x08, 0xFD, 0x00, 0x00, 0x00, 0x08, 0xFD, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x35, 0x53, 0x00, 0x00, 0x00, 0x00, 0x7E, 0xFF, 0xFF, 0xD5, 0x00, 0x00, 0x1C, 0xFD, 0x85, 0x58, 0xEF, 0x50, 0x00, 0xCF, 0x90, 0x00, 0x00, 0x3E, 0xE1, 0x07, 0xF9, 0x00, 0x00, 0x00, 0x07, 0xF5, 0x1E, 0xE1, 0x00, 0x02, 0x66, 0x23, 0xF8, 0x5F, 0x80, 0x00, 0x9F, 0xFF, 0xF7, 0xF9, 0x9F, 0x30, 0x08, 0xFD, 0x65, 0xAF, 0xF9, 0xBF, 0x00, 0x1F, 0xE1, 0x00, 0x09, 0xF9, 0xDD, 0x00, 0x4F, 0x80, 0x00, 0x03, 0xF9, 0xDD, 0x00, 0x6F, 0x60, 0x00, 0x01, 0xF9, 0xDD, 0x00, 0x5F, 0x80, 0x00, 0x02, 0xF9, 0xCE, 0x00, 0x2F, 0xC0, 0x00, 0x07, 0xF9, 0x9F, 0x20, 0x0A, 0xFA, 0x21, 0x6F, 0xF9, 0x6F, 0x70, 0x01, 0xCF, 0xFF, 0xFA, 0xF9, 0x1E, 0xD1, 0x00, 0x06, 0x99, 0x51, 0x74, 0x08, 0xF9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xCF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2D, 0xFC, 0x51, 0x00, 0x23, 0x00, 0x00, 0x01, 0x9F, 0xFF, 0xEE, 0xFC, 0x00, 0x00, 0x00, 0x01, 0x69, 0xBB, 0x95, 0x00,
+    0x00, 0x00, 0x04, 0x88, 0x40, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xFF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xBB, 0xF5, 0x00, 0x00, 0x00, 0x00, 0xAF, 0x77, 0xFA, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x33, 0xFE, 0x00, 0x00, 0x00, 0x04, 0xFE, 0x00, 0xEF, 0x40, 0x00, 0x00, 0x09, 0xF9, 0x00, 0xAF, 0x90, 0x00, 0x00, 0x0D, 0xF5, 0x00, 0x5F, 0xD0, 0x00, 0x00, 0x3F, 0xF1, 0x00, 0x1F, 0xF3, 0x00, 0x00, 0x7F, 0xC0, 0x00, 0x0C, 0xF7, 0x00, 0x00, 0xCF, 0xB7, 0x77, 0x7B, 0xFC, 0x00, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x20, 0x06, 0xFE, 0x77, 0x77, 0x77, 0xEF, 0x60, 0x0B, 0xF9, 0x00, 0x00, 0x00, 0xAF, 0xB0, 0x1F, 0xF5, 0x00, 0x00, 0x00, 0x5F, 0xF1, 0x5F, 0xF1, 0x00, 0x00, 0x00, 0x1F, 0xF5, 0xAF, 0xC0, 0x00, 0x00, 0x00, 0x0C, 0xFA,
+    0x28, 0x88, 0x88, 0x76, 0x20, 0x00, 0x00, 0x4F, 0xFF, 0xFF, 0xFF, 0xFA, 0x10, 0x00, 0x4F, 0xF7, 0x77, 0x7A, 0xFF, 0xC0, 0x00, 0x4F, 0xF1, 0x00, 0x00, 0x4F, 0xF4, 0x00, 0x4F, 0xF1, 0x00, 0x00, 0x0E, 0xF7, 0x00, 0x4F, 0xF1, 0x00, 0x00, 0x0E, 0xF7, 0x00, 0x4F, 0xF1, 0x00, 0x00, 0x4F, 0xF4, 0x00, 0x4F, 0xF5, 0x44, 0x58, 0xEF, 0xA0, 0x00, 0x4F, 0xFF, 0xFF, 0xFF, 0xE6, 0x00, 0x00, 0x4F, 0xFA, 0x99, 0xAC, 0xFF, 0x70, 0x00, 0x4F, 0xF1, 0x00, 0x00, 0x4E, 0xF6, 0x00, 0x4F, 0xF1, 0x00, 0x00, 0x08, 0xFD, 0x00, 0x4F, 0xF1, 0x00, 0x00, 0x05, 0xFF, 0x10, 0x4F, 0xF1, 0x00, 0x00, 0x05, 0xFF, 0x10, 0x4F, 0xF1, 0x00, 0x00, 0x09, 0xFE, 0x00, 0x4F, 0xF1, 0x00, 0x01, 0x7F, 0xF9, 0x00, 0x4F, 0xFE, 0xEE, 0xEF, 0xFF, 0xC1, 0x00, 0x4F, 0xFF, 0xFF, 0xFD, 0xB6, 0x00, 0x00,
+    0x00, 0x00, 0x38, 0xBC, 0xB8, 0x40, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xF5, 0x00, 0xAF, 0xF8, 0x32, 0x37, 0xE5, 0x05, 0xFF, 0x50, 0x00, 0x00, 0x12, 0x0C, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x1E, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x02, 0xEF, 0xB1, 0x00, 0x00, 0x75, 0x00, 0x4E, 0xFE, 0xA9, 0xAE, 0xF5, 0x00, 0x03, 0xBF, 0xFF, 0xFF, 0xC2, 0x00, 0x00, 0x01, 0x45, 0x41, 0x00,
+    0x58, 0x88, 0x76, 0x30, 0x00, 0x00, 0x9F, 0xFF, 0xFF, 0xFE, 0x70, 0x00, 0x9F, 0xD7, 0x79, 0xDF, 0xFA, 0x00, 0x9F, 0xB0, 0x00, 0x06, 0xFF, 0x70, 0x9F, 0xB0, 0x00, 0x00, 0x9F, 0xE0, 0x9F, 0xB0, 0x00, 0x00, 0x3F, 0xF4, 0x9F, 0xB0, 0x00, 0x00, 0x0E, 0xF8, 0x9F, 0xB0, 0x00, 0x00, 0x0D, 0xFA, 0x9F, 0xB0, 0x00, 0x00, 0x0C, 0xFB, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xFB, 0x9F, 0xB0, 0x00, 0x00, 0x0C, 0xFA, 0x9F, 0xB0, 0x00, 0x00, 0x0D, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x1F, 0xF6, 0x9F, 0xB0, 0x00, 0x00, 0x5F, 0xF2, 0x9F, 0xB0, 0x00, 0x01, 0xDF, 0xB0, 0x9F, 0xB0, 0x01, 0x5D, 0xFE, 0x20, 0x9F, 0xFE, 0xEF, 0xFF, 0xD4, 0x00, 0x9F, 0xFF, 0xFD, 0xB6, 0x10, 0x00,
+    0x78, 0x88, 0x88, 0x88, 0x88, 0x40, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0x70, 0xEF, 0xB8, 0x88, 0x88, 0x88, 0x40, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x95, 0x55, 0x55, 0x55, 0x10, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0x20, 0xEF, 0xCA, 0xAA, 0xAA, 0xAA, 0x10, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0xA0, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0xA0,
+    0x48, 0x88, 0x88, 0x88, 0x88, 0x60, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0x7F, 0xE8, 0x88, 0x88, 0x88, 0x60, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xE6, 0x66, 0x66, 0x66, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0x7F, 0xE9, 0x99, 0x99, 0x99, 0x10, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x6A, 0xCC, 0xA6, 0x10, 0x00, 0x3D, 0xFF, 0xFF, 0xFF, 0xD1, 0x02, 0xEF, 0xD6, 0x22, 0x5B, 0xF2, 0x0B, 0xFD, 0x10, 0x00, 0x00, 0x51, 0x3F, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x80, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x70, 0x00, 0x1F, 0xFF, 0xFB, 0xFF, 0x70, 0x00, 0x1E, 0xEF, 0xFB, 0xDF, 0x90, 0x00, 0x00, 0x08, 0xFB, 0xBF, 0xB0, 0x00, 0x00, 0x08, 0xFB, 0x7F, 0xF1, 0x00, 0x00, 0x08, 0xFB, 0x1E, 0xF7, 0x00, 0x00, 0x08, 0xFB, 0x07, 0xFF, 0x50, 0x00, 0x09, 0xFB, 0x00, 0xAF, 0xFC, 0x99, 0xCF, 0xF9, 0x00, 0x07, 0xEF, 0xFF, 0xFD, 0x70, 0x00, 0x00, 0x03, 0x55, 0x30, 0x00,
+    0x58, 0x60, 0x00, 0x00, 0x06, 0x85, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xD5, 0x55, 0x55, 0x5D, 0xF9, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF9, 0x9F, 0xEA, 0xAA, 0xAA, 0xAE, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9,
+    0x78, 0x88, 0x88, 0x88, 0x86, 0xDF, 0xFF, 0xFF, 0xFF, 0xFD, 0x78, 0x89, 0xFF, 0x98, 0x86, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0xDF, 0xFF, 0xFF, 0xFF, 0xFD, 0xDF, 0xFF, 0xFF, 0xFF, 0xFD,
+    0x00, 0x06, 0x88, 0x88, 0x87, 0x00, 0x0D, 0xFF, 0xFF, 0xFF, 0x00, 0x06, 0x88, 0x8A, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x00, 0x00, 0x00, 0x07, 0xFE, 0x20, 0x00, 0x00, 0x09, 0xFC, 0xD7, 0x00, 0x00, 0x2E, 0xF8, 0xEF, 0xEA, 0x9A, 0xEF, 0xE2, 0x7D, 0xFF, 0xFF, 0xFC, 0x30, 0x00, 0x24, 0x54, 0x20, 0x00,
+    0x58, 0x60, 0x00, 0x00, 0x01, 0x78, 0x50, 0x9F, 0xB0, 0x00, 0x00, 0x1B, 0xFD, 0x20, 0x9F, 0xB0, 0x00, 0x00, 0xBF, 0xD2, 0x00, 0x9F, 0xB0, 0x00, 0x0A, 0xFE, 0x20, 0x00, 0x9F, 0xB0, 0x00, 0xAF, 0xE3, 0x00, 0x00, 0x9F, 0xB0, 0x09, 0xFE, 0x30, 0x00, 0x00, 0x9F, 0xB0, 0x8F, 0xE4, 0x00, 0x00, 0x00, 0x9F, 0xB7, 0xFF, 0x50, 0x00, 0x00, 0x00, 0x9F, 0xEF, 0xFF, 0xA0, 0x00, 0x00, 0x00, 0x9F, 0xFF, 0x8F, 0xF6, 0x00, 0x00, 0x00, 0x9F, 0xF6, 0x09, 0xFE, 0x20, 0x00, 0x00, 0x9F, 0xC0, 0x01, 0xDF, 0xB0, 0x00, 0x00, 0x9F, 0xB0, 0x00, 0x5F, 0xF6, 0x00, 0x00, 0x9F, 0xB0, 0x00, 0x0A, 0xFE, 0x20, 0x00, 0x9F, 0xB0, 0x00, 0x01, 0xEF, 0xB0, 0x00, 0x9F, 0xB0, 0x00, 0x00, 0x5F, 0xF7, 0x00, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xFE, 0x20, 0x9F, 0xB0, 0x00, 0x00, 0x02, 0xEF, 0xC0,
+    0x58, 0x50, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF2, 0xBF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF2,
+    0x28, 0x87, 0x00, 0x00, 0x01, 0x78, 0x81, 0x3F, 0xFF, 0x40, 0x00, 0x05, 0xFF, 0xF3, 0x3F, 0xFF, 0x90, 0x00, 0x0A, 0xEF, 0xF3, 0x3F, 0xEB, 0xE0, 0x00, 0x1E, 0xAF, 0xF3, 0x3F, 0xE6, 0xF5, 0x00, 0x5F, 0x5F, 0xF3, 0x3F, 0xE1, 0xFA, 0x00, 0xAE, 0x1F, 0xF3, 0x3F, 0xE0, 0xAE, 0x11, 0xFA, 0x0F, 0xF3, 0x3F, 0xE0, 0x5F, 0x56, 0xF5, 0x0F, 0xF3, 0x3F, 0xE0, 0x1E, 0xAB, 0xE1, 0x0F, 0xF3, 0x3F, 0xE0, 0x0A, 0xEF, 0xA0, 0x0F, 0xF3, 0x3F, 0xE0, 0x05, 0xFF, 0x50, 0x0F, 0xF3, 0x3F, 0xE0, 0x01, 0xBB, 0x00, 0x0F, 0xF3, 0x3F, 0xE0, 0x00, 0x00, 0x00, 0x0F, 0xF3, 0x3F, 0xE0, 0x00, 0x00, 0x00, 0x0F, 0xF3, 0x3F, 0xE0, 0x00, 0x00, 0x00, 0x0F, 0xF3, 0x3F, 0xE0, 0x00, 0x00, 0x00, 0x0F, 0xF3, 0x3F, 0xE0, 0x00, 0x00, 0x00, 0x0F, 0xF3, 0x3F, 0xE0, 0x00, 0x00, 0x00, 0x0F, 0xF3,
+    0x48, 0x84, 0x00, 0x00, 0x05, 0x84, 0x9F, 0xFC, 0x00, 0x00, 0x0A, 0xF9, 0x9F, 0xFF, 0x30, 0x00, 0x0A, 0xF9, 0x9F, 0xFF, 0x90, 0x00, 0x0A, 0xF9, 0x9F, 0xBE, 0xF1, 0x00, 0x0A, 0xF9, 0x9F, 0xA8, 0xF7, 0x00, 0x0A, 0xF9, 0x9F, 0xA2, 0xFD, 0x00, 0x0A, 0xF9, 0x9F, 0xA0, 0xBF, 0x40, 0x0A, 0xF9, 0x9F, 0xA0, 0x5F, 0xA0, 0x0A, 0xF9, 0x9F, 0xA0, 0x0D, 0xF2, 0x0A, 0xF9, 0x9F, 0xA0, 0x07, 0xF8, 0x0A, 0xF9, 0x9F, 0xA0, 0x01, 0xFD, 0x0A, 0xF9, 0x9F, 0xA0, 0x00, 0xAF, 0x5A, 0xF9, 0x9F, 0xA0, 0x00, 0x4F, 0xBA, 0xF9, 0x9F, 0xA0, 0x00, 0x0D, 0xFD, 0xF9, 0x9F, 0xA0, 0x00, 0x06, 0xFF, 0xF9, 0x9F, 0xA0, 0x00, 0x01, 0xEF, 0xF9, 0x9F, 0xA0, 0x00, 0x00, 0x9F, 0xF9,
+    0x00, 0x04, 0x9C, 0xC9, 0x40, 0x00, 0x00, 0x9F, 0xFF, 0xFF, 0xF9, 0x00, 0x06, 0xFF, 0x82, 0x28, 0xFF, 0x60, 0x0E, 0xF9, 0x00, 0x00, 0x9F, 0xE0, 0x4F, 0xF2, 0x00, 0x00, 0x2F, 0xF4, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF8, 0xAF, 0xB0, 0x00, 0x00, 0x0B, 0xFA, 0xCF, 0xA0, 0x00, 0x00, 0x0A, 0xFC, 0xDF, 0x90, 0x00, 0x00, 0x09, 0xFD, 0xDF, 0x90, 0x00, 0x00, 0x09, 0xFD, 0xCF, 0xA0, 0x00, 0x00, 0x0A, 0xFC, 0xBF, 0xB0, 0x00, 0x00, 0x0B, 0xFB, 0x9F, 0xC0, 0x00, 0x00, 0x0C, 0xF9, 0x7F, 0xF0, 0x00, 0x00, 0x0F, 0xF6, 0x2F, 0xF5, 0x00, 0x00, 0x5F, 0xF2, 0x0B, 0xFD, 0x10, 0x01, 0xDF, 0xB0, 0x02, 0xEF, 0xEA, 0xAE, 0xFE, 0x20, 0x00, 0x3C, 0xFF, 0xFF, 0xC3, 0x00, 0x00, 0x00, 0x25, 0x52, 0x00, 0x00,
+    0x78, 0x88, 0x87, 0x63, 0x00, 0x00, 0xEF, 0xFF, 0xFF, 0xFF, 0xD4, 0x00, 0xEF, 0xA7, 0x77, 0x9E, 0xFF, 0x40, 0xEF, 0x70, 0x00, 0x02, 0xEF, 0xB0, 0xEF, 0x70, 0x00, 0x00, 0x8F, 0xF1, 0xEF, 0x70, 0x00, 0x00, 0x5F, 0xF2, 0xEF, 0x70, 0x00, 0x00, 0x6F, 0xF2, 0xEF, 0x70, 0x00, 0x00, 0xBF, 0xE0, 0xEF, 0x70, 0x00, 0x2A, 0xFF, 0x80, 0xEF, 0xFF, 0xFF, 0xFF, 0xFB, 0x00, 0xEF, 0xEE, 0xEE, 0xDB, 0x50, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x70, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x04, 0x9C, 0xC9, 0x40, 0x00, 0x00, 0x9F, 0xFF, 0xFF, 0xF9, 0x00, 0x06, 0xFF, 0x82, 0x28, 0xFF, 0x60, 0x0E, 0xF9, 0x00, 0x00, 0x9F, 0xE0, 0x4F, 0xF2, 0x00, 0x00, 0x2F, 0xF4, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF8, 0xAF, 0xB0, 0x00, 0x00, 0x0B, 0xFA, 0xCF, 0xA0, 0x00, 0x00, 0x0A, 0xFC, 0xDF, 0x90, 0x00, 0x00, 0x09, 0xFD, 0xDF, 0x90, 0x00, 0x00, 0x09, 0xFD, 0xCF, 0xA0, 0x00, 0x00, 0x0A, 0xFC, 0xBF, 0xB0, 0x00, 0x00, 0x0B, 0xFB, 0x9F, 0xC0, 0x00, 0x00, 0x0C, 0xF9, 0x6F, 0xF0, 0x00, 0x00, 0x0F, 0xF7, 0x2F, 0xF5, 0x00, 0x00, 0x5F, 0xF2, 0x0B, 0xFD, 0x10, 0x01, 0xDF, 0xB0, 0x02, 0xEF, 0xEA, 0xAE, 0xFE, 0x20, 0x00, 0x3C, 0xFF, 0xFF, 0xD3, 0x00, 0x00, 0x00, 0x25, 0x7F, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x70, 0x00, 0x00, 0x00, 0x00, 0x7D, 0x40,
+    0x48, 0x88, 0x88, 0x64, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0xFF, 0xE5, 0x00, 0x00, 0x8F, 0xE7, 0x77, 0x9E, 0xFF, 0x60, 0x00, 0x8F, 0xC0, 0x00, 0x01, 0xDF, 0xE0, 0x00, 0x8F, 0xC0, 0x00, 0x00, 0x6F, 0xF3, 0x00, 0x8F, 0xC0, 0x00, 0x00, 0x3F, 0xF4, 0x00, 0x8F, 0xC0, 0x00, 0x00, 0x5F, 0xF3, 0x00, 0x8F, 0xC0, 0x00, 0x00, 0xBF, 0xD0, 0x00, 0x8F, 0xD5, 0x55, 0x7C, 0xFE, 0x40, 0x00, 0x8F, 0xFF, 0xFF, 0xFF, 0x92, 0x00, 0x00, 0x8F, 0xE9, 0x9A, 0xDF, 0xD3, 0x00, 0x00, 0x8F, 0xC0, 0x00, 0x0A, 0xFD, 0x10, 0x00, 0x8F, 0xC0, 0x00, 0x01, 0xEF, 0x70, 0x00, 0x8F, 0xC0, 0x00, 0x00, 0x7F, 0xE1, 0x00, 0x8F, 0xC0, 0x00, 0x00, 0x1E, 0xF7, 0x00, 0x8F, 0xC0, 0x00, 0x00, 0x07, 0xFE, 0x10, 0x8F, 0xC0, 0x00, 0x00, 0x01, 0xEF, 0x70, 0x8F, 0xC0, 0x00, 0x00, 0x00, 0x8F, 0xE1,
+    0x00, 0x05, 0xAC, 0xCB, 0x84, 0x00, 0x01, 0xCF, 0xFF, 0xFF, 0xFF, 0x90, 0x0C, 0xFE, 0x62, 0x23, 0x7D, 0xA0, 0x4F, 0xF2, 0x00, 0x00, 0x00, 0x30, 0x8F, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xE2, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xFE, 0x94, 0x10, 0x00, 0x00, 0x05, 0xEF, 0xFF, 0xFC, 0x71, 0x00, 0x00, 0x28, 0xDF, 0xFF, 0xFD, 0x30, 0x00, 0x00, 0x02, 0x5A, 0xFF, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xF9, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xF9, 0x10, 0x00, 0x00, 0x00, 0x0C, 0xF8, 0x6B, 0x40, 0x00, 0x00, 0x8F, 0xF3, 0x6F, 0xFD, 0xA9, 0xAD, 0xFF, 0x90, 0x29, 0xEF, 0xFF, 0xFF, 0xD7, 0x00, 0x00, 0x02, 0x45, 0x43, 0x00, 0x00,
+    0x58, 0x88, 0x88, 0x88, 0x88, 0x88, 0x85, 0xAF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFA, 0x58, 0x88, 0x89, 0xFF, 0x98, 0x88, 0x85, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00,
+    0x48, 0x70, 0x00, 0x00, 0x07, 0x84, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x8F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x7F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x7F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x6F, 0xD0, 0x00, 0x00, 0x0D, 0xF6, 0x4F, 0xF1, 0x00, 0x00, 0x1F, 0xF4, 0x1E, 0xF8, 0x00, 0x00, 0x9F, 0xE1, 0x06, 0xFF, 0xD9, 0x9D, 0xFF, 0x60, 0x00, 0x5D, 0xFF, 0xFF, 0xD5, 0x00, 0x00, 0x00, 0x35, 0x53, 0x00, 0x00,
+    0x48, 0x70, 0x00, 0x00, 0x00, 0x07, 0x84, 0x4F, 0xF2, 0x00, 0x00, 0x00, 0x2F, 0xF4, 0x0E, 0xF6, 0x00, 0x00, 0x00, 0x6F, 0xE0, 0x0A, 0xFA, 0x00, 0x00, 0x00, 0xAF, 0xA0, 0x06, 0xFE, 0x00, 0x00, 0x00, 0xEF, 0x60, 0x01, 0xFF, 0x30, 0x00, 0x03, 0xFF, 0x10, 0x00, 0xCF, 0x70, 0x00, 0x07, 0xFC, 0x00, 0x00, 0x8F, 0xB0, 0x00, 0x0B, 0xF8, 0x00, 0x00, 0x3F, 0xF1, 0x00, 0x1F, 0xF3, 0x00, 0x00, 0x0E, 0xF4, 0x00, 0x4F, 0xE0, 0x00, 0x00, 0x09, 0xF8, 0x00, 0x8F, 0x90, 0x00, 0x00, 0x05, 0xFC, 0x00, 0xCF, 0x50, 0x00, 0x00, 0x01, 0xFF, 0x11, 0xFF, 0x10, 0x00, 0x00, 0x00, 0xBF, 0x55, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x99, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xDD, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xFF, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF, 0x90, 0x00, 0x00,
+    0x18, 0x81, 0x00, 0x00, 0x00, 0x00, 0x18, 0x81, 0x1F, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF1, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xE0, 0x0C, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xC0, 0x09, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x8F, 0x90, 0x07, 0xFA, 0x00, 0x3A, 0xA3, 0x00, 0xAF, 0x70, 0x05, 0xFC, 0x00, 0x8F, 0xF7, 0x00, 0xCF, 0x50, 0x03, 0xFE, 0x00, 0xBF, 0xFA, 0x00, 0xEF, 0x30, 0x01, 0xFF, 0x00, 0xEC, 0xCE, 0x00, 0xFF, 0x10, 0x00, 0xDF, 0x22, 0xF8, 0x9F, 0x22, 0xFD, 0x00, 0x00, 0xBF, 0x45, 0xF5, 0x5F, 0x54, 0xFB, 0x00, 0x00, 0x9F, 0x68, 0xF2, 0x2F, 0x86, 0xF9, 0x00, 0x00, 0x6F, 0x7C, 0xD0, 0x0D, 0xB7, 0xF6, 0x00, 0x00, 0x4F, 0xAE, 0xA0, 0x0A, 0xE9, 0xF4, 0x00, 0x00, 0x2F, 0xEF, 0x60, 0x06, 0xFE, 0xF2, 0x00, 0x00, 0x0F, 0xFF, 0x30, 0x03, 0xFF, 0xF0, 0x00, 0x00, 0x0D, 0xFE, 0x00, 0x00, 0xEF, 0xD0, 0x00, 0x00, 0x0A, 0xFB, 0x00, 0x00, 0xBF, 0xA0, 0x00,
+    0x17, 0x84, 0x00, 0x00, 0x00, 0x17, 0x84, 0x09, 0xFD, 0x10, 0x00, 0x00, 0x8F, 0xE1, 0x01, 0xEF, 0x70, 0x00, 0x02, 0xFF, 0x50, 0x00, 0x6F, 0xE2, 0x00, 0x0A, 0xFB, 0x00, 0x00, 0x0B, 0xFA, 0x00, 0x4F, 0xE2, 0x00, 0x00, 0x02, 0xFF, 0x40, 0xDF, 0x70, 0x00, 0x00, 0x00, 0x8F, 0xC7, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x1D, 0xFF, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x05, 0xFF, 0x90, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xFF, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xFD, 0xF7, 0x00, 0x00, 0x00, 0x01, 0xDF, 0x84, 0xFE, 0x20, 0x00, 0x00, 0x08, 0xFD, 0x10, 0xAF, 0xA0, 0x00, 0x00, 0x3F, 0xF5, 0x00, 0x2F, 0xF4, 0x00, 0x00, 0xCF, 0xA0, 0x00, 0x08, 0xFD, 0x00, 0x07, 0xFE, 0x20, 0x00, 0x01, 0xEF, 0x70, 0x2E, 0xF7, 0x00, 0x00, 0x00, 0x6F, 0xE2, 0xAF, 0xC0, 0x00, 0x00, 0x00, 0x0C, 0xFA,
+    0x58, 0x60, 0x00, 0x00, 0x00, 0x07, 0x85, 0x3F, 0xF4, 0x00, 0x00, 0x00, 0x5F, 0xF3, 0x0A, 0xFC, 0x00, 0x00, 0x00, 0xDF, 0x90, 0x02, 0xEF, 0x60, 0x00, 0x06, 0xFE, 0x10, 0x00, 0x7F, 0xD1, 0x00, 0x1E, 0xF7, 0x00, 0x00, 0x0D, 0xF7, 0x00, 0x8F, 0xD0, 0x00, 0x00, 0x05, 0xFE, 0x11, 0xEF, 0x50, 0x00, 0x00, 0x00, 0xBF, 0x99, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xFF, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x30, 0x00, 0x00,
+    0x18, 0x88, 0x88, 0x88, 0x88, 0x88, 0x20, 0x2F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x18, 0x88, 0x88, 0x88, 0x8D, 0xFE, 0x20, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFE, 0x20, 0x00, 0x00, 0x00, 0x00, 0x2E, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x06, 0xFE, 0x20, 0x00, 0x00, 0x00, 0x00, 0x2E, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x00, 0xAF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x05, 0xFE, 0x20, 0x00, 0x00, 0x00, 0x00, 0x1E, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x00, 0xAF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFE, 0x20, 0x00, 0x00, 0x00, 0x00, 0x1D, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x70, 0x6F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x70,
+    0xCF, 0xFF, 0xF3, 0xCF, 0xA7, 0x71, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0x50, 0x00, 0xCF, 0xA8, 0x81, 0xCF, 0xFF, 0xF3, 0x23, 0x33, 0x30,
+    0x78, 0x20, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x09, 0xF9, 0x00, 0x00, 0x00, 0x00, 0x02, 0xFF, 0x20, 0x00, 0x00, 0x00, 0x00, 0xAF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x06, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x01, 0xEF, 0x40, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x1E, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x08, 0xFA, 0x00, 0x00, 0x00, 0x00, 0x02, 0xFF, 0x20, 0x00, 0x00, 0x00, 0x00, 0x9F, 0x90, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x03, 0x41,
+    0x3F, 0xFF, 0xFC, 0x17, 0x7A, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x00, 0x05, 0xFC, 0x18, 0x8A, 0xFC, 0x3F, 0xFF, 0xFC, 0x03, 0x33, 0x32,
+    0x00, 0x00, 0x02, 0x88, 0x20, 0x00, 0x00, 0x00, 0x00, 0x1C, 0xFF, 0xC1, 0x00, 0x00, 0x00, 0x00, 0xAF, 0xCD, 0xFA, 0x00, 0x00, 0x00, 0x07, 0xFD, 0x22, 0xDF, 0x70, 0x00, 0x00, 0x5F, 0xE2, 0x00, 0x2E, 0xF5, 0x00, 0x03, 0xEE, 0x30, 0x00, 0x03, 0xEE, 0x30, 0x1D, 0xE4, 0x00, 0x00, 0x00, 0x4E, 0xD1,
+    0x14, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x41, 0x2A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA2,
+    0x7F, 0x90, 0x00, 0x09, 0xF6, 0x00, 0x00, 0xBE, 0x30, 0x00, 0x13, 0x20,
+    0x00, 0x03, 0x57, 0x64, 0x00, 0x00, 0x07, 0xEF, 0xFF, 0xFF, 0xE6, 0x00, 0x0B, 0xFB, 0x76, 0x7A, 0xFF, 0x50, 0x05, 0x10, 0x00, 0x00, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xF1, 0x00, 0x00, 0x34, 0x55, 0x5F, 0xF2, 0x01, 0x9E, 0xFF, 0xFF, 0xFF, 0xF3, 0x0C, 0xFE, 0x97, 0x66, 0x6F, 0xF3, 0x6F, 0xE2, 0x00, 0x00, 0x0F, 0xF3, 0x9F, 0x80, 0x00, 0x00, 0x3F, 0xF3, 0xAF, 0x80, 0x00, 0x00, 0x8F, 0xF3, 0x7F, 0xD1, 0x00, 0x04, 0xFF, 0xF3, 0x1E, 0xFD, 0x87, 0xAF, 0xBF, 0xF3, 0x03, 0xDF, 0xFF, 0xFA, 0x1F, 0xF3, 0x00, 0x03, 0x54, 0x10, 0x00, 0x00,
+    0xEF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x30, 0x46, 0x62, 0x00, 0x00, 0xEF, 0x5C, 0xFF, 0xFF, 0x80, 0x00, 0xEF, 0xEE, 0x86, 0x9F, 0xF8, 0x00, 0xEF, 0xF3, 0x00, 0x06, 0xFF, 0x20, 0xEF, 0x90, 0x00, 0x00, 0xDF, 0x70, 0xEF, 0x50, 0x00, 0x00, 0x9F, 0xA0, 0xEF, 0x30, 0x00, 0x00, 0x8F, 0xC0, 0xEF, 0x30, 0x00, 0x00, 0x7F, 0xC0, 0xEF, 0x40, 0x00, 0x00, 0x8F, 0xB0, 0xEF, 0x60, 0x00, 0x00, 0xAF, 0x90, 0xEF, 0xA0, 0x00, 0x00, 0xEF, 0x60, 0xEF, 0xF4, 0x00, 0x07, 0xFE, 0x10, 0xEF, 0xDF, 0x98, 0xBF, 0xF6, 0x00, 0xEF, 0x4B, 0xFF, 0xFE, 0x60, 0x00, 0x00, 0x00, 0x35, 0x41, 0x00, 0x00,
+    0x00, 0x00, 0x36, 0x76, 0x20, 0x00, 0x00, 0x4C, 0xFF, 0xFF, 0xFC, 0x20, 0x05, 0xFF, 0xD7, 0x67, 0xBF, 0x30, 0x1E, 0xF9, 0x00, 0x00, 0x04, 0x20, 0x7F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0xBF, 0x80, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x60, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x50, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x60, 0x00, 0x00, 0x00, 0x00, 0xBF, 0x90, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x1E, 0xFB, 0x10, 0x00, 0x05, 0x30, 0x04, 0xEF, 0xE9, 0x88, 0xCF, 0x30, 0x00, 0x3B, 0xFF, 0xFF, 0xFA, 0x10, 0x00, 0x00, 0x14, 0x54, 0x10, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF0, 0x00, 0x02, 0x66, 0x40, 0x3F, 0xF0, 0x00, 0x8F, 0xFF, 0xFD, 0x5F, 0xF0, 0x07, 0xFF, 0x96, 0x8E, 0xEF, 0xF0, 0x1E, 0xF6, 0x00, 0x02, 0xEF, 0xF0, 0x6F, 0xD0, 0x00, 0x00, 0x9F, 0xF0, 0xAF, 0xA0, 0x00, 0x00, 0x5F, 0xF0, 0xBF, 0x80, 0x00, 0x00, 0x3F, 0xF0, 0xCF, 0x70, 0x00, 0x00, 0x3F, 0xF0, 0xBF, 0x80, 0x00, 0x00, 0x3F, 0xF0, 0x9F, 0xA0, 0x00, 0x00, 0x5F, 0xF0, 0x6F, 0xE0, 0x00, 0x00, 0xAF, 0xF0, 0x1E, 0xF8, 0x00, 0x03, 0xFF, 0xF0, 0x06, 0xFF, 0xB8, 0x9F, 0xDF, 0xF0, 0x00, 0x6E, 0xFF, 0xFB, 0x4F, 0xF0, 0x00, 0x01, 0x45, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x36, 0x75, 0x10, 0x00, 0x00, 0x3C, 0xFF, 0xFF, 0xF8, 0x00, 0x03, 0xEF, 0xD7, 0x69, 0xEF, 0x80, 0x0C, 0xFA, 0x00, 0x00, 0x3F, 0xF2, 0x5F, 0xE1, 0x00, 0x00, 0x0A, 0xF8, 0x9F, 0xA0, 0x00, 0x00, 0x06, 0xFB, 0xBF, 0xDB, 0xBB, 0xBB, 0xBD, 0xFC, 0xCF, 0xFE, 0xEE, 0xEE, 0xEE, 0xEB, 0xBF, 0x70, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xFB, 0x10, 0x00, 0x01, 0x63, 0x02, 0xDF, 0xE9, 0x88, 0xBE, 0xF5, 0x00, 0x2A, 0xFF, 0xFF, 0xFE, 0xA2, 0x00, 0x00, 0x14, 0x54, 0x30, 0x00,
+    0x00, 0x00, 0x3D, 0xFF, 0xFF, 0x30, 0x00, 0x00, 0xDF, 0xC9, 0x88, 0x20, 0x00, 0x04, 0xFD, 0x00, 0x00, 0x00, 0x00, 0x06, 0xFB, 0x00, 0x00, 0x00, 0x22, 0x28, 0xFB, 0x22, 0x22, 0x00, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x88, 0x8B, 0xFD, 0x88, 0x88, 0x20, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00,
+    0x00, 0x02, 0x66, 0x40, 0x01, 0x10, 0x00, 0x8F, 0xFF, 0xFD, 0x4F, 0xF0, 0x07, 0xFF, 0xA6, 0x7E, 0xDF, 0xF0, 0x1E, 0xF7, 0x00, 0x02, 0xEF, 0xF0, 0x6F, 0xD0, 0x00, 0x00, 0x9F, 0xF0, 0xAF, 0xA0, 0x00, 0x00, 0x5F, 0xF0, 0xBF, 0x80, 0x00, 0x00, 0x3F, 0xF0, 0xCF, 0x70, 0x00, 0x00, 0x3F, 0xF0, 0xBF, 0x80, 0x00, 0x00, 0x3F, 0xF0, 0x9F, 0xB0, 0x00, 0x00, 0x6F, 0xF0, 0x5F, 0xF1, 0x00, 0x00, 0xBF, 0xF0, 0x0D, 0xFB, 0x10, 0x06, 0xFF, 0xF0, 0x03, 0xEF, 0xEB, 0xCF, 0xAF, 0xF0, 0x00, 0x3B, 0xFF, 0xE7, 0x3F, 0xF0, 0x00, 0x00, 0x01, 0x00, 0x4F, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xA0, 0x03, 0x40, 0x00, 0x02, 0xEF, 0x50, 0x05, 0xFE, 0xA8, 0xAE, 0xFA, 0x00, 0x03, 0xBE, 0xFF, 0xFD, 0x70, 0x00, 0x00, 0x00, 0x22, 0x10, 0x00, 0x00,
+    0xEF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x30, 0x36, 0x63, 0x00, 0x00, 0xEF, 0x4A, 0xFF, 0xFF, 0xA0, 0x00, 0xEF, 0xCE, 0x87, 0xAF, 0xF7, 0x00, 0xEF, 0xE2, 0x00, 0x09, 0xFC, 0x00, 0xEF, 0x80, 0x00, 0x03, 0xFF, 0x00, 0xEF, 0x40, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10,
+    0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x06, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0x21, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xF4, 0x00, 0x00, 0x02, 0x88, 0x8E, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xF4, 0x00, 0x00, 0x1A, 0xAA, 0xAE, 0xFC, 0xAA, 0xA6, 0x2F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF9,
+    0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x01, 0x87, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x22, 0x22, 0x00, 0xEF, 0xFF, 0xFE, 0x00, 0x88, 0x8A, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x05, 0xFD, 0x00, 0x00, 0x1C, 0xF9, 0x1C, 0xCC, 0xEF, 0xE2, 0x1F, 0xFF, 0xEB, 0x30,
+    0x7F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xC0, 0x00, 0x00, 0x12, 0x20, 0x7F, 0xC0, 0x00, 0x04, 0xEF, 0x60, 0x7F, 0xC0, 0x00, 0x4F, 0xF6, 0x00, 0x7F, 0xC0, 0x05, 0xFF, 0x50, 0x00, 0x7F, 0xC0, 0x5F, 0xF4, 0x00, 0x00, 0x7F, 0xC6, 0xFF, 0x40, 0x00, 0x00, 0x7F, 0xEF, 0xFF, 0x60, 0x00, 0x00, 0x7F, 0xFE, 0x8F, 0xE2, 0x00, 0x00, 0x7F, 0xE2, 0x0B, 0xFC, 0x00, 0x00, 0x7F, 0xC0, 0x01, 0xEF, 0x90, 0x00, 0x7F, 0xC0, 0x00, 0x4F, 0xF5, 0x00, 0x7F, 0xC0, 0x00, 0x08, 0xFE, 0x20, 0x7F, 0xC0, 0x00, 0x00, 0xCF, 0xB0, 0x7F, 0xC0, 0x00, 0x00, 0x3E, 0xF7,
+    0x5F, 0xFF, 0xFF, 0x40, 0x00, 0x00, 0x25, 0x55, 0xEF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xDF, 0x40, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xC1, 0x00, 0x00, 0x00, 0x00, 0x1E, 0xFE, 0xCC, 0xB0, 0x00, 0x00, 0x02, 0xAE, 0xFF, 0xD0,
+    0x22, 0x04, 0x63, 0x01, 0x56, 0x20, 0x00, 0xEF, 0xAF, 0xFF, 0x5C, 0xFF, 0xF4, 0x00, 0xEF, 0xC6, 0xBF, 0xFC, 0x6A, 0xFA, 0x00, 0xEF, 0x30, 0x2F, 0xF4, 0x01, 0xFE, 0x00, 0xEF, 0x10, 0x0F, 0xF2, 0x00, 0xEF, 0x00, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xEF, 0x10, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xDF, 0x10, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xDF, 0x10, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xDF, 0x10, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xDF, 0x10, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xDF, 0x10, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xDF, 0x10, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xDF, 0x10, 0xEF, 0x00, 0x0E, 0xF1, 0x00, 0xDF, 0x10,
+    0x22, 0x00, 0x36, 0x63, 0x00, 0x00, 0xEF, 0x4A, 0xFF, 0xFF, 0xA0, 0x00, 0xEF, 0xCE, 0x87, 0xAF, 0xF7, 0x00, 0xEF, 0xE2, 0x00, 0x09, 0xFC, 0x00, 0xEF, 0x80, 0x00, 0x03, 0xFF, 0x00, 0xEF, 0x40, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10,
+    0x00, 0x00, 0x46, 0x64, 0x00, 0x00, 0x00, 0x5E, 0xFF, 0xFF, 0xE5, 0x00, 0x04, 0xFF, 0xB6, 0x6B, 0xFF, 0x40, 0x0D, 0xFA, 0x00, 0x00, 0xAF, 0xD0, 0x4F, 0xF2, 0x00, 0x00, 0x2F, 0xF4, 0x7F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x9F, 0xA0, 0x00, 0x00, 0x0A, 0xF9, 0x9F, 0xB0, 0x00, 0x00, 0x0B, 0xF9, 0x7F, 0xD0, 0x00, 0x00, 0x0D, 0xF7, 0x3F, 0xF2, 0x00, 0x00, 0x2F, 0xF3, 0x0D, 0xFB, 0x00, 0x00, 0xBF, 0xD0, 0x04, 0xFF, 0xD8, 0x8D, 0xFF, 0x40, 0x00, 0x4D, 0xFF, 0xFF, 0xD4, 0x00, 0x00, 0x00, 0x35, 0x53, 0x00, 0x00,
+    0x22, 0x00, 0x46, 0x62, 0x00, 0x00, 0xFF, 0x4C, 0xFF, 0xFF, 0x80, 0x00, 0xFF, 0xEE, 0x86, 0x9F, 0xF7, 0x00, 0xFF, 0xE2, 0x00, 0x06, 0xFE, 0x10, 0xFF, 0x90, 0x00, 0x00, 0xEF, 0x60, 0xFF, 0x50, 0x00, 0x00, 0xAF, 0x90, 0xFF, 0x30, 0x00, 0x00, 0x8F, 0xB0, 0xFF, 0x30, 0x00, 0x00, 0x8F, 0xB0, 0xFF, 0x30, 0x00, 0x00, 0x8F, 0xB0, 0xFF, 0x50, 0x00, 0x00, 0xAF, 0x90, 0xFF, 0xA0, 0x00, 0x00, 0xEF, 0x60, 0xFF, 0xF3, 0x00, 0x08, 0xFE, 0x10, 0xFF, 0xDF, 0x98, 0xBF, 0xF6, 0x00, 0xFF, 0x4B, 0xFF, 0xFE, 0x60, 0x00, 0xFF, 0x30, 0x35, 0x41, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x46, 0x40, 0x01, 0x10, 0x00, 0x5E, 0xFF, 0xFD, 0x3F, 0xF2, 0x04, 0xFF, 0xB7, 0x8E, 0xDF, 0xF2, 0x0D, 0xF9, 0x00, 0x02, 0xEF, 0xF2, 0x3F, 0xF2, 0x00, 0x00, 0x7F, 0xF2, 0x7F, 0xC0, 0x00, 0x00, 0x3F, 0xF2, 0x9F, 0xB0, 0x00, 0x00, 0x1F, 0xF2, 0x9F, 0xA0, 0x00, 0x00, 0x1F, 0xF2, 0x9F, 0xB0, 0x00, 0x00, 0x1F, 0xF2, 0x7F, 0xD0, 0x00, 0x00, 0x3F, 0xF2, 0x4F, 0xF2, 0x00, 0x00, 0x7F, 0xF2, 0x0D, 0xFA, 0x00, 0x02, 0xEF, 0xF2, 0x04, 0xFF, 0xB7, 0x8E, 0xDF, 0xF2, 0x00, 0x5E, 0xFF, 0xFD, 0x3F, 0xF2, 0x00, 0x01, 0x46, 0x40, 0x0F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x01, 0x10,
+    0x22, 0x00, 0x15, 0x75, 0x10, 0xFF, 0x36, 0xEF, 0xFF, 0xF3, 0xFF, 0x8F, 0xD9, 0x8A, 0xE5, 0xFF, 0xE9, 0x00, 0x00, 0x22, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0xFF, 0x60, 0x00, 0x00, 0x00, 0xFF, 0x40, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00,
+    0x00, 0x04, 0x67, 0x53, 0x00, 0x05, 0xEF, 0xFF, 0xFF, 0xE2, 0x3F, 0xFB, 0x66, 0x7A, 0xF3, 0x8F, 0xA0, 0x00, 0x00, 0x21, 0xAF, 0x80, 0x00, 0x00, 0x00, 0x8F, 0xD2, 0x00, 0x00, 0x00, 0x2E, 0xFF, 0xC9, 0x62, 0x00, 0x02, 0xAE, 0xFF, 0xFF, 0x90, 0x00, 0x00, 0x37, 0xCF, 0xF7, 0x00, 0x00, 0x00, 0x0A, 0xFC, 0x00, 0x00, 0x00, 0x05, 0xFC, 0x62, 0x00, 0x00, 0x0B, 0xFA, 0xBF, 0xC9, 0x78, 0xCF, 0xE3, 0x7D, 0xFF, 0xFF, 0xFC, 0x30, 0x00, 0x24, 0x54, 0x20, 0x00,
+    0x00, 0x02, 0xDD, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x12, 0x24, 0xFF, 0x22, 0x22, 0x20, 0xAF, 0xFF, 0xFF, 0xFF, 0xFF, 0xD0, 0x68, 0x8A, 0xFF, 0x88, 0x88, 0x70, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x02, 0xFF, 0x10, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xFC, 0xBB, 0xA0, 0x00, 0x00, 0x07, 0xCF, 0xFF, 0xD0,
+    0x22, 0x00, 0x00, 0x00, 0x22, 0x00, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x30, 0x00, 0x01, 0xFF, 0x10, 0xEF, 0x40, 0x00, 0x03, 0xFF, 0x10, 0xDF, 0x60, 0x00, 0x06, 0xFF, 0x10, 0xAF, 0xC0, 0x00, 0x2D, 0xFF, 0x10, 0x4F, 0xFC, 0x99, 0xEB, 0xFF, 0x10, 0x07, 0xFF, 0xFF, 0xA2, 0xFF, 0x10, 0x00, 0x14, 0x52, 0x00, 0x00, 0x00,
+    0x22, 0x00, 0x00, 0x00, 0x00, 0x22, 0xCF, 0x60, 0x00, 0x00, 0x06, 0xFC, 0x7F, 0xB0, 0x00, 0x00, 0x0B, 0xF7, 0x2F, 0xF2, 0x00, 0x00, 0x2F, 0xF2, 0x0B, 0xF7, 0x00, 0x00, 0x7F, 0xB0, 0x06, 0xFC, 0x00, 0x00, 0xCF, 0x60, 0x01, 0xFF, 0x20, 0x02, 0xFF, 0x10, 0x00, 0xAF, 0x70, 0x07, 0xFA, 0x00, 0x00, 0x5F, 0xC0, 0x0C, 0xF5, 0x00, 0x00, 0x1E, 0xF3, 0x3F, 0xE1, 0x00, 0x00, 0x09, 0xF8, 0x8F, 0x90, 0x00, 0x00, 0x04, 0xFD, 0xDF, 0x40, 0x00, 0x00, 0x00, 0xEF, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xF8, 0x00, 0x00,
+    0x02, 0x20, 0x00, 0x00, 0x00, 0x00, 0x02, 0x20, 0x1F, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xF1, 0x0D, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xD0, 0x09, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x90, 0x06, 0xFA, 0x00, 0x05, 0x40, 0x00, 0xAF, 0x60, 0x02, 0xFE, 0x00, 0x2F, 0xF2, 0x00, 0xEF, 0x20, 0x00, 0xEF, 0x20, 0x6F, 0xF6, 0x02, 0xFE, 0x00, 0x00, 0xAF, 0x50, 0xBC, 0xCA, 0x05, 0xFA, 0x00, 0x00, 0x7F, 0x80, 0xE8, 0x8E, 0x08, 0xF7, 0x00, 0x00, 0x3F, 0xB4, 0xF3, 0x3F, 0x4B, 0xF3, 0x00, 0x00, 0x0E, 0xE8, 0xE0, 0x0E, 0x8E, 0xE0, 0x00, 0x00, 0x0B, 0xFE, 0x90, 0x0A, 0xEF, 0xB0, 0x00, 0x00, 0x08, 0xFF, 0x50, 0x05, 0xFF, 0x80, 0x00, 0x00, 0x04, 0xFF, 0x10, 0x01, 0xFF, 0x40, 0x00,
+    0x02, 0x21, 0x00, 0x00, 0x00, 0x12, 0x20, 0x06, 0xFD, 0x10, 0x00, 0x01, 0xEF, 0x60, 0x00, 0xAF, 0xB0, 0x00, 0x0B, 0xFA, 0x00, 0x00, 0x1D, 0xF7, 0x00, 0x7F, 0xD1, 0x00, 0x00, 0x03, 0xFF, 0x33, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x6F, 0xDD, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xFF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0x70, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xFF, 0xF3, 0x00, 0x00, 0x00, 0x01, 0xDF, 0x77, 0xFD, 0x10, 0x00, 0x00, 0x0A, 0xFB, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x7F, 0xE1, 0x00, 0x1E, 0xF7, 0x00, 0x03, 0xFF, 0x40, 0x00, 0x04, 0xFF, 0x30, 0x1D, 0xF8, 0x00, 0x00, 0x00, 0x8F, 0xD1,
+    0x22, 0x10, 0x00, 0x00, 0x00, 0x22, 0x00, 0xBF, 0x80, 0x00, 0x00, 0x03, 0xFF, 0x10, 0x6F, 0xD0, 0x00, 0x00, 0x09, 0xFA, 0x00, 0x1E, 0xF4, 0x00, 0x00, 0x1E, 0xF4, 0x00, 0x09, 0xFA, 0x00, 0x00, 0x5F, 0xD0, 0x00, 0x03, 0xFF, 0x10, 0x00, 0xBF, 0x70, 0x00, 0x00, 0xCF, 0x60, 0x02, 0xFF, 0x20, 0x00, 0x00, 0x6F, 0xC0, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x1E, 0xF3, 0x0D, 0xF5, 0x00, 0x00, 0x00, 0x09, 0xF8, 0x3F, 0xE0, 0x00, 0x00, 0x00, 0x03, 0xFE, 0x9F, 0x80, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x1C, 0xDF, 0xFA, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFE, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x12, 0x22, 0x22, 0x22, 0x22, 0x8F, 0xFF, 0xFF, 0xFF, 0xFE, 0x58, 0x88, 0x88, 0x8C, 0xFE, 0x00, 0x00, 0x00, 0x2E, 0xF6, 0x00, 0x00, 0x01, 0xCF, 0x90, 0x00, 0x00, 0x0A, 0xFC, 0x00, 0x00, 0x00, 0x7F, 0xE2, 0x00, 0x00, 0x04, 0xFF, 0x40, 0x00, 0x00, 0x2E, 0xF6, 0x00, 0x00, 0x01, 0xCF, 0x90, 0x00, 0x00, 0x0A, 0xFC, 0x00, 0x00, 0x00, 0x7F, 0xE2, 0x00, 0x00, 0x00, 0xDF, 0xDB, 0xBB, 0xBB, 0xBB, 0xDF, 0xFF, 0xFF, 0xFF, 0xFE,
+    0x00, 0x00, 0x1A, 0xFF, 0xFA, 0x00, 0x00, 0x9F, 0xE9, 0x74, 0x00, 0x00, 0xDF, 0x60, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x01, 0xFF, 0x20, 0x00, 0x00, 0x03, 0xFF, 0x10, 0x00, 0x00, 0x3C, 0xFB, 0x00, 0x00, 0xAF, 0xFF, 0x91, 0x00, 0x00, 0x7A, 0xDF, 0xE4, 0x00, 0x00, 0x00, 0x08, 0xFD, 0x00, 0x00, 0x00, 0x02, 0xFF, 0x20, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xFF, 0x40, 0x00, 0x00, 0x00, 0xCF, 0x90, 0x00, 0x00, 0x00, 0x6F, 0xFD, 0xC7, 0x00, 0x00, 0x05, 0xAD, 0xE9,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAA,
+    0xAF, 0xFF, 0xA1, 0x00, 0x00, 0x47, 0x9E, 0xF9, 0x00, 0x00, 0x00, 0x06, 0xFD, 0x00, 0x00, 0x00, 0x03, 0xFE, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x02, 0xFF, 0x00, 0x00, 0x00, 0x01, 0xFF, 0x30, 0x00, 0x00, 0x00, 0xBF, 0xC3, 0x00, 0x00, 0x00, 0x19, 0xFF, 0xFA, 0x00, 0x00, 0x4E, 0xFD, 0xA7, 0x00, 0x00, 0xDF, 0x80, 0x00, 0x00, 0x02, 0xFF, 0x20, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x04, 0xFE, 0x00, 0x00, 0x00, 0x09, 0xFC, 0x00, 0x00, 0x7C, 0xEF, 0xF6, 0x00, 0x00, 0x9E, 0xDA, 0x50, 0x00, 0x00,
+    0x00, 0x01, 0x21, 0x00, 0x00, 0x00, 0x00, 0x04, 0xCF, 0xFF, 0xB5, 0x00, 0x01, 0x93, 0x3F, 0xFD, 0xCE, 0xFF, 0xEB, 0xBF, 0xF3, 0x3B, 0x20, 0x00, 0x4B, 0xFF, 0xFD, 0x60, 0x00, 0x00, 0x00, 0x00, 0x13, 0x20, 0x00,
+};
+
+static const ui_glyph_t kGlyphs[] = {
+    {    0,  0,  0,   0,   0, 18},   // ' '
+    {    0,  4, 18,   7,   0, 18},   // '!'
+    {   36,  8,  7,   5,   0, 18},   // '"'
+    {   64, 16, 18,   1,   0, 18},   // '#'
+    {  208, 11, 22,   4,   0, 18},   // '$'
+    {  340, 14, 17,   2,   1, 18},   // '%'
+    {  459, 14, 19,   2,   0, 18},   // '&'
+    {  592,  3,  7,   7,   0, 18},   // '\''
+    {  606,  6, 22,   6,   0, 18},   // '('
+    {  672,  6, 22,   6,   0, 18},   // ')'
+    {  738, 12, 12,   3,   0, 18},   // '*'
+    {  810, 14, 13,   2,   4, 18},   // '+'
+    {  901,  5,  8,   6,  14, 18},   // ','
+    {  925,  8,  3,   5,  10, 18},   // '-'
+    {  937,  4,  4,   7,  14, 18},   // '.'
+    {  945, 12, 21,   3,   0, 18},   // '/'
+    { 1071, 12, 19,   3,   0, 18},   // '0'
+    { 1185, 11, 18,   4,   0, 18},   // '1'
+    { 1293, 12, 18,   3,   0, 18},   // '2'
+    { 1401, 12, 19,   3,   0, 18},   // '3'
+    { 1515, 13, 18,   3,   0, 18},   // '4'
+    { 1641, 12, 19,   3,   0, 18},   // '5'
+    { 1755, 12, 19,   3,   0, 18},   // '6'
+    { 1869, 12, 18,   3,   0, 18},   // '7'
+    { 1977, 12, 19,   3,   0, 18},   // '8'
+    { 2091, 12, 19,   3,   0, 18},   // '9'
+    { 2205,  4, 13,   7,   5, 18},   // ':'
+    { 2231,  5, 17,   6,   5, 18},   // ';'
+    { 2282, 14, 13,   2,   4, 18},   // '<'
+    { 2373, 14,  7,   2,   7, 18},   // '='
+    { 2422, 14, 13,   2,   4, 18},   // '>'
+    { 2513, 10, 18,   4,   0, 18},   // '?'
+    { 2603, 14, 21,   2,   1, 18},   // '@'
+    { 2750, 14, 18,   2,   0, 18},   // 'A'
+    { 2876, 13, 18,   3,   0, 18},   // 'B'
+    { 3002, 12, 19,   3,   0, 18},   // 'C'
+    { 3116, 12, 18,   3,   0, 18},   // 'D'
+    { 3224, 11, 18,   4,   0, 18},   // 'E'
+    { 3332, 11, 18,   4,   0, 18},   // 'F'
+    { 3440, 12, 19,   3,   0, 18},   // 'G'
+    { 3554, 12, 18,   3,   0, 18},   // 'H'
+    { 3662, 10, 18,   4,   0, 18},   // 'I'
+    { 3752, 10, 19,   3,   0, 18},   // 'J'
+    { 3847, 13, 18,   3,   0, 18},   // 'K'
+    { 3973, 12, 18,   4,   0, 18},   // 'L'
+    { 4081, 14, 18,   2,   0, 18},   // 'M'
+    { 4207, 12, 18,   3,   0, 18},   // 'N'
+    { 4315, 12, 19,   3,   0, 18},   // 'O'
+    { 4429, 12, 18,   4,   0, 18},   // 'P'
+    { 4537, 12, 21,   3,   0, 18},   // 'Q'
+    { 4663, 14, 18,   3,   0, 18},   // 'R'
+    { 4789, 12, 19,   3,   0, 18},   // 'S'
+    { 4903, 14, 18,   2,   0, 18},   // 'T'
+    { 5029, 12, 19,   3,   0, 18},   // 'U'
+    { 5143, 14, 18,   2,   0, 18},   // 'V'
+    { 5269, 16, 18,   1,   0, 18},   // 'W'
+    { 5413, 14, 18,   2,   0, 18},   // 'X'
+    { 5539, 14, 18,   2,   0, 18},   // 'Y'
+    { 5665, 13, 18,   3,   0, 18},   // 'Z'
+    { 5791,  6, 22,   7,   0, 18},   // '['
+    { 5857, 12, 21,   3,   0, 18},   // '\\'
+    { 5983,  6, 22,   5,   0, 18},   // ']'
+    { 6049, 14,  7,   2,   0, 18},   // '^'
+    { 6098, 16,  2,   1,  22, 18},   // '_'
+    { 6114,  5,  4,   6,   0, 18},   // '`'
+    { 6126, 12, 15,   3,   4, 18},   // 'a'
+    { 6216, 11, 19,   4,   0, 18},   // 'b'
+    { 6330, 11, 15,   4,   4, 18},   // 'c'
+    { 6420, 11, 19,   3,   0, 18},   // 'd'
+    { 6534, 12, 15,   3,   4, 18},   // 'e'
+    { 6624, 11, 18,   4,   0, 18},   // 'f'
+    { 6732, 11, 20,   3,   4, 18},   // 'g'
+    { 6852, 11, 18,   4,   0, 18},   // 'h'
+    { 6960, 12, 18,   3,   0, 18},   // 'i'
+    { 7068,  8, 23,   3,   0, 18},   // 'j'
+    { 7160, 12, 18,   4,   0, 18},   // 'k'
+    { 7268, 11, 18,   3,   0, 18},   // 'l'
+    { 7376, 13, 14,   3,   4, 18},   // 'm'
+    { 7474, 11, 14,   4,   4, 18},   // 'n'
+    { 7558, 12, 15,   3,   4, 18},   // 'o'
+    { 7648, 11, 19,   4,   4, 18},   // 'p'
+    { 7762, 12, 20,   3,   4, 18},   // 'q'
+    { 7882, 10, 14,   6,   4, 18},   // 'r'
+    { 7952, 10, 15,   4,   4, 18},   // 's'
+    { 8027, 11, 17,   3,   1, 18},   // 't'
+    { 8129, 11, 15,   4,   4, 18},   // 'u'
+    { 8219, 12, 14,   3,   4, 18},   // 'v'
+    { 8303, 16, 14,   1,   4, 18},   // 'w'
+    { 8415, 14, 14,   2,   4, 18},   // 'x'
+    { 8513, 13, 19,   3,   4, 18},   // 'y'
+    { 8646, 10, 14,   4,   4, 18},   // 'z'
+    { 8716, 10, 22,   4,   0, 18},   // '{'
+    { 8826,  2, 24,   8,   0, 18},   // '|'
+    { 8850, 10, 22,   4,   0, 18},   // '}'
+    { 8960, 14,  5,   2,   8, 18},   // '~'
+};
+
+extern const ui_font_t ui_font_mono_24 = {
+    kBitmap, kGlyphs, 32, 126, 4, 24, 18
+};
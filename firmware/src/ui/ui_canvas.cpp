@@ -0,0 +1,296 @@
+/*
+ * UI Canvas Implementation
+ * Clipped fills, lines and classic-font text for compositor bands
+ */
+
+#include "ui/ui_canvas.h"
+#include "ui/ui_font.h"
+
+#include <string.h>
+
+// Adafruit GFX classic font, printable ASCII: five columns per glyph, bit 0 at the top
+static const uint8_t kFont5x7[][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00}, // ' ' ! "
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, // # $ %
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00}, // & ' (
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08}, // ) * +
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x00, 0x60, 0x60, 0x00}, // , - .
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00}, // / 0 1
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33}, {0x18, 0x14, 0x12, 0x7F, 0x10}, // 2 3 4
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07}, // 5 6 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x00, 0x14, 0x00, 0x00}, // 8 9 :
+    {0x00, 0x40, 0x34, 0x00, 0x00}, {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14}, // ; < =
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, {0x3E, 0x41, 0x5D, 0x59, 0x4E}, // > ? @
+    {0x7C, 0x12, 0x11, 0x12, 0x7C}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22}, // A B C
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01}, // D E F
+    {0x3E, 0x41, 0x41, 0x51, 0x73}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00}, // G H I
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40}, // J K L
+    {0x7F, 0x02, 0x1C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E}, // M N O
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46}, // P Q R
+    {0x26, 0x49, 0x49, 0x49, 0x32}, {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F}, // S T U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63}, // V W X
+    {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41}, // Y Z [
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F}, {0x04, 0x02, 0x01, 0x02, 0x04}, // \ ] ^
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40}, // _ ` a
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28}, {0x38, 0x44, 0x44, 0x28, 0x7F}, // b c d
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78}, // e f g
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x40, 0x3D, 0x00}, // h i j
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78}, // k l m
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0xFC, 0x18, 0x24, 0x24, 0x18}, // n o p
+    {0x18, 0x24, 0x24, 0x18, 0xFC}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24}, // q r s
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C}, // t u v
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C}, // w x y
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x77, 0x00, 0x00}, // z { |
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x02, 0x01, 0x02, 0x04, 0x02},                                  // } ~
+};
+
+#define FONT_FIRST ' '
+#define FONT_LAST  '~'
+
+void ui_canvas_init(ui_canvas_t* canvas, uint16_t* pixels, ui_rect_t rect) {
+    if (!canvas) return;
+    canvas->pixels = pixels;
+    canvas->rect = rect;
+}
+
+void ui_canvas_fill(ui_canvas_t* canvas, uint16_t color) {
+    if (!canvas || !canvas->pixels) return;
+    uint32_t count = ui_rect_area(canvas->rect);
+    for (uint32_t i = 0; i < count; i++) canvas->pixels[i] = color;
+}
+
+void ui_canvas_fill_rect(ui_canvas_t* canvas, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!canvas || !canvas->pixels) return;
+    ui_rect_t area = ui_rect_intersect(ui_rect_t{x, y, w, h}, canvas->rect);
+    if (ui_rect_is_empty(area)) return;
+
+    uint16_t* row = canvas->pixels + (area.y - canvas->rect.y) * canvas->rect.w + (area.x - canvas->rect.x);
+    for (int16_t r = 0; r < area.h; r++) {
+        for (int16_t c = 0; c < area.w; c++) row[c] = color;
+        row += canvas->rect.w;
+    }
+}
+
+void ui_canvas_hline(ui_canvas_t* canvas, int16_t x, int16_t y, int16_t w, uint16_t color) {
+    ui_canvas_fill_rect(canvas, x, y, w, 1, color);
+}
+
+void ui_canvas_vline(ui_canvas_t* canvas, int16_t x, int16_t y, int16_t h, uint16_t color) {
+    ui_canvas_fill_rect(canvas, x, y, 1, h, color);
+}
+
+void ui_canvas_rect(ui_canvas_t* canvas, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+    ui_canvas_hline(canvas, x, y, w, color);
+    ui_canvas_hline(canvas, x, y + h - 1, w, color);
+    ui_canvas_vline(canvas, x, y, h, color);
+    ui_canvas_vline(canvas, x + w - 1, y, h, color);
+}
+
+void ui_canvas_pixel(ui_canvas_t* canvas, int16_t x, int16_t y, uint16_t color) {
+    if (!canvas || !canvas->pixels) return;
+    int32_t cx = x - canvas->rect.x;
+    int32_t cy = y - canvas->rect.y;
+    if (cx < 0 || cy < 0 || cx >= canvas->rect.w || cy >= canvas->rect.h) return;
+    canvas->pixels[cy * canvas->rect.w + cx] = color;
+}
+
+void ui_canvas_line(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1 || y0 == y1) {
+        ui_canvas_fill_rect(canvas, x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+                            (int16_t)(x0 < x1 ? x1 - x0 + 1 : x0 - x1 + 1),
+                            (int16_t)(y0 < y1 ? y1 - y0 + 1 : y0 - y1 + 1), color);
+        return;
+    }
+    // Bresenham, stepping along the longer axis
+    bool steep = (y1 > y0 ? y1 - y0 : y0 - y1) > (x1 > x0 ? x1 - x0 : x0 - x1);
+    int16_t t;
+    if (steep) {
+        t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+    }
+    if (x0 > x1) {
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+    int16_t dx = x1 - x0;
+    int16_t dy = y1 > y0 ? y1 - y0 : y0 - y1;
+    int16_t err = dx / 2;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+        if (steep) ui_canvas_pixel(canvas, y0, x0, color);
+        else ui_canvas_pixel(canvas, x0, y0, color);
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void ui_canvas_circle(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    int16_t f = 1 - r, ddf_x = 1, ddf_y = -2 * r, x = 0, y = r;
+    ui_canvas_pixel(canvas, x0, y0 + r, color);
+    ui_canvas_pixel(canvas, x0, y0 - r, color);
+    ui_canvas_pixel(canvas, x0 + r, y0, color);
+    ui_canvas_pixel(canvas, x0 - r, y0, color);
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddf_y += 2;
+            f += ddf_y;
+        }
+        x++;
+        ddf_x += 2;
+        f += ddf_x;
+        ui_canvas_pixel(canvas, x0 + x, y0 + y, color);
+        ui_canvas_pixel(canvas, x0 - x, y0 + y, color);
+        ui_canvas_pixel(canvas, x0 + x, y0 - y, color);
+        ui_canvas_pixel(canvas, x0 - x, y0 - y, color);
+        ui_canvas_pixel(canvas, x0 + y, y0 + x, color);
+        ui_canvas_pixel(canvas, x0 - y, y0 + x, color);
+        ui_canvas_pixel(canvas, x0 + y, y0 - x, color);
+        ui_canvas_pixel(canvas, x0 - y, y0 - x, color);
+    }
+}
+
+void ui_canvas_fill_circle(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    ui_canvas_vline(canvas, x0, y0 - r, 2 * r + 1, color);
+    int16_t f = 1 - r, ddf_x = 1, ddf_y = -2 * r, x = 0, y = r, px = x, py = y;
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddf_y += 2;
+            f += ddf_y;
+        }
+        x++;
+        ddf_x += 2;
+        f += ddf_x;
+        // Columns either side of the centre, skipping those the other octant draws
+        if (x < y + 1) {
+            ui_canvas_vline(canvas, x0 + x, y0 - y, 2 * y + 1, color);
+            ui_canvas_vline(canvas, x0 - x, y0 - y, 2 * y + 1, color);
+        }
+        if (y != py) {
+            ui_canvas_vline(canvas, x0 + py, y0 - px, 2 * px + 1, color);
+            ui_canvas_vline(canvas, x0 - py, y0 - px, 2 * px + 1, color);
+            py = y;
+        }
+        px = x;
+    }
+}
+
+void ui_canvas_triangle(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                        int16_t x2, int16_t y2, uint16_t color) {
+    ui_canvas_line(canvas, x0, y0, x1, y1, color);
+    ui_canvas_line(canvas, x1, y1, x2, y2, color);
+    ui_canvas_line(canvas, x2, y2, x0, y0, color);
+}
+
+static void swap16(int16_t* a, int16_t* b) {
+    int16_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+void ui_canvas_fill_triangle(ui_canvas_t* canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                             int16_t x2, int16_t y2, uint16_t color) {
+    // Sort by y: y0 <= y1 <= y2
+    if (y0 > y1) { swap16(&y0, &y1); swap16(&x0, &x1); }
+    if (y1 > y2) { swap16(&y2, &y1); swap16(&x2, &x1); }
+    if (y0 > y1) { swap16(&y0, &y1); swap16(&x0, &x1); }
+
+    if (y0 == y2) {
+        // All on one row
+        int16_t a = x0, b = x0;
+        if (x1 < a) a = x1; else if (x1 > b) b = x1;
+        if (x2 < a) a = x2; else if (x2 > b) b = x2;
+        ui_canvas_hline(canvas, a, y0, b - a + 1, color);
+        return;
+    }
+
+    int32_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    // The upper part includes row y1 unless the lower edge is flat, then the lower part takes it
+    int16_t last = y1 == y2 ? y1 : y1 - 1;
+    int16_t y = y0;
+    for (; y <= last; y++) {
+        int16_t a = (int16_t)(x0 + sa / dy01);
+        int16_t b = (int16_t)(x0 + sb / dy02);
+        sa += dx01;
+        sb += dx02;
+        if (a > b) swap16(&a, &b);
+        ui_canvas_hline(canvas, a, y, b - a + 1, color);
+    }
+    sa = dx12 * (y - y1);
+    sb = dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        int16_t a = (int16_t)(x1 + sa / dy12);
+        int16_t b = (int16_t)(x0 + sb / dy02);
+        sa += dx12;
+        sb += dx02;
+        if (a > b) swap16(&a, &b);
+        ui_canvas_hline(canvas, a, y, b - a + 1, color);
+    }
+}
+
+void ui_canvas_bitmap(ui_canvas_t* canvas, int16_t x, int16_t y, const uint8_t* bitmap,
+                      int16_t w, int16_t h, uint16_t color) {
+    if (!canvas || !bitmap) return;
+    ui_rect_t area = ui_rect_intersect(ui_rect_t{x, y, w, h}, canvas->rect);
+    if (ui_rect_is_empty(area)) return;
+    int16_t stride = (w + 7) / 8;
+    for (int16_t row = area.y - y; row < area.y - y + area.h; row++) {
+        const uint8_t* bits = bitmap + row * stride;
+        for (int16_t col = area.x - x; col < area.x - x + area.w; col++) {
+            if (bits[col >> 3] & (0x80 >> (col & 7))) ui_canvas_pixel(canvas, x + col, y + row, color);
+        }
+    }
+}
+
+void ui_canvas_rgb_bitmap(ui_canvas_t* canvas, int16_t x, int16_t y, const uint16_t* pixels, int16_t w, int16_t h) {
+    if (!canvas || !canvas->pixels || !pixels) return;
+    ui_rect_t area = ui_rect_intersect(ui_rect_t{x, y, w, h}, canvas->rect);
+    if (ui_rect_is_empty(area)) return;
+    for (int16_t row = 0; row < area.h; row++) {
+        const uint16_t* src = pixels + (area.y - y + row) * w + (area.x - x);
+        uint16_t* dst = canvas->pixels + (area.y - canvas->rect.y + row) * canvas->rect.w + (area.x - canvas->rect.x);
+        memcpy(dst, src, area.w * sizeof(uint16_t));
+    }
+}
+
+static void draw_glyph(ui_canvas_t* canvas, int16_t x, int16_t y, char ch, uint16_t color, uint8_t size) {
+    if (ch < FONT_FIRST || ch > FONT_LAST) return;
+    const uint8_t* columns = kFont5x7[ch - FONT_FIRST];
+    for (int16_t col = 0; col < 5; col++) {
+        uint8_t bits = columns[col];
+        for (int16_t row = 0; bits; row++, bits >>= 1) {
+            if (bits & 1) ui_canvas_fill_rect(canvas, x + col * size, y + row * size, size, size, color);
+        }
+    }
+}
+
+int16_t ui_canvas_text(ui_canvas_t* canvas, int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size) {
+    if (!text || size == 0) return x;
+    const ui_font_t* font = ui_font_for_size(size);
+    if (font) return ui_font_draw(canvas, x, y, text, font, color);
+    ui_rect_t bounds = ui_text_bounds(x, y, text, size);
+    // Most text lies outside any one band: skip it without touching a glyph
+    bool visible = canvas && !ui_rect_is_empty(ui_rect_intersect(bounds, canvas->rect));
+    int16_t cell = UI_FONT_CELL_W * size;
+    for (const char* p = text; *p && *p != '\n'; p++) {
+        if (visible && x + cell > canvas->rect.x && x < canvas->rect.x + canvas->rect.w) {
+            draw_glyph(canvas, x, y, *p, color, size);
+        }
+        x += cell;
+    }
+    return x;
+}
+
+ui_rect_t ui_text_bounds(int16_t x, int16_t y, const char* text, uint8_t size) {
+    if (!text || size == 0) return ui_rect_t{x, y, 0, 0};
+    const char* end = strchr(text, '\n');
+    size_t len = end ? (size_t)(end - text) : strlen(text);
+    if (len == 0) return ui_rect_t{x, y, 0, 0};
+    return ui_rect_t{x, y, (int16_t)(len * UI_FONT_CELL_W * size), (int16_t)(UI_FONT_CELL_H * size)};
+}
@@ -0,0 +1,123 @@
+/*
+ * UI Compositor Implementation
+ * Band-by-band repaint of the damage list through a panel push callback
+ */
+
+#include "ui/ui_compositor.h"
+#include "hal/hal_system.h"
+
+#include <string.h>
+
+bool ui_compositor_init(ui_compositor_t* compositor, int16_t width, int16_t height, uint16_t band_rows,
+                        uint16_t background, const ui_panel_t* panel) {
+    if (!compositor || width <= 0 || height <= 0 || band_rows == 0 || !panel || !panel->push) return false;
+    memset(compositor, 0, sizeof(*compositor));
+
+    compositor->band_pixels = (uint32_t)width * band_rows;
+    compositor->band_count = panel->wait ? 2 : 1;
+    for (uint32_t i = 0; i < compositor->band_count; i++) {
+        compositor->bands[i] = (uint16_t*)hal_system_malloc(compositor->band_pixels * sizeof(uint16_t));
+        if (!compositor->bands[i]) {
+            ui_compositor_deinit(compositor);
+            return false;
+        }
+    }
+
+    ui_damage_init(&compositor->damage, width, height);
+    compositor->background = background;
+    compositor->panel = *panel;
+    return true;
+}
+
+void ui_compositor_deinit(ui_compositor_t* compositor) {
+    if (!compositor) return;
+    ui_compositor_sync(compositor);
+    for (uint32_t i = 0; i < 2; i++) {
+        if (compositor->bands[i]) hal_system_free(compositor->bands[i]);
+    }
+    memset(compositor, 0, sizeof(*compositor));
+}
+
+void ui_compositor_invalidate(ui_compositor_t* compositor, ui_rect_t rect) {
+    if (compositor) ui_damage_add(&compositor->damage, rect);
+}
+
+void ui_compositor_invalidate_all(ui_compositor_t* compositor) {
+    if (compositor) ui_damage_add_screen(&compositor->damage);
+}
+
+bool ui_compositor_is_dirty(const ui_compositor_t* compositor) {
+    return compositor && !ui_damage_is_empty(&compositor->damage);
+}
+
+// Hands out the band to paint next, waiting for the panel if it is still sending it
+static uint16_t* acquire_band(ui_compositor_t* compositor) {
+    uint32_t index = compositor->next_band;
+    if (compositor->in_flight[index]) {
+        // Bands go out in turn, so this one is the oldest in flight
+        compositor->panel.wait(compositor->panel.user_data);
+        compositor->in_flight[index] = false;
+    }
+    return compositor->bands[index];
+}
+
+static void push_band(ui_compositor_t* compositor, const ui_rect_t* rect) {
+    uint32_t index = compositor->next_band;
+    compositor->panel.push(rect, compositor->bands[index], compositor->panel.user_data);
+    if (compositor->panel.wait) compositor->in_flight[index] = true;
+    compositor->next_band = (index + 1) % compositor->band_count;
+}
+
+uint32_t ui_compositor_flush(ui_compositor_t* compositor, ui_paint_fn_t paint, void* paint_user_data) {
+    if (!compositor || !compositor->bands[0] || !paint) return 0;
+    ui_damage_t* damage = &compositor->damage;
+    if (ui_damage_is_empty(damage)) return 0;
+
+    uint32_t pushed = 0;
+    for (uint32_t i = 0; i < damage->count; i++) {
+        ui_rect_t rect = damage->rects[i];
+        // Narrow windows fit more rows in the same band
+        int16_t rows = (int16_t)(compositor->band_pixels / (uint32_t)rect.w);
+        for (int16_t y = rect.y; y < rect.y + rect.h; y += rows) {
+            ui_rect_t band = {rect.x, y, rect.w, (int16_t)(rect.y + rect.h - y < rows ? rect.y + rect.h - y : rows)};
+            ui_canvas_t canvas;
+            ui_canvas_init(&canvas, acquire_band(compositor), band);
+            ui_canvas_fill(&canvas, compositor->background);
+            paint(&canvas, paint_user_data);
+            push_band(compositor, &band);
+            pushed += ui_rect_area(band);
+            compositor->stats.windows++;
+        }
+    }
+    ui_damage_clear(damage);
+
+    compositor->stats.frames++;
+    compositor->stats.pixels += pushed;
+    compositor->stats.last_pixels = pushed;
+    return pushed;
+}
+
+void ui_compositor_sync(ui_compositor_t* compositor) {
+    if (!compositor || !compositor->panel.wait) return;
+    // Oldest first: the band after the last one pushed
+    for (uint32_t n = 0; n < compositor->band_count; n++) {
+        uint32_t index = (compositor->next_band + n) % compositor->band_count;
+        if (compositor->in_flight[index]) {
+            compositor->panel.wait(compositor->panel.user_data);
+            compositor->in_flight[index] = false;
+        }
+    }
+}
+
+void ui_compositor_get_stats(const ui_compositor_t* compositor, ui_compositor_stats_t* stats) {
+    if (!stats) return;
+    if (!compositor) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = compositor->stats;
+}
+
+void ui_compositor_reset_stats(ui_compositor_t* compositor) {
+    if (compositor) memset(&compositor->stats, 0, sizeof(compositor->stats));
+}
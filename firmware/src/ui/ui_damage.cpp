@@ -0,0 +1,101 @@
+/*
+ * UI Damage Tracking Implementation
+ * Rectangle merging for the compositor's per-frame damage list
+ */
+
+#include "ui/ui_damage.h"
+
+bool ui_rect_is_empty(ui_rect_t rect) {
+    return rect.w <= 0 || rect.h <= 0;
+}
+
+uint32_t ui_rect_area(ui_rect_t rect) {
+    return ui_rect_is_empty(rect) ? 0 : (uint32_t)rect.w * (uint32_t)rect.h;
+}
+
+ui_rect_t ui_rect_intersect(ui_rect_t a, ui_rect_t b) {
+    int32_t x0 = a.x > b.x ? a.x : b.x;
+    int32_t y0 = a.y > b.y ? a.y : b.y;
+    int32_t x1 = a.x + a.w < b.x + b.w ? a.x + a.w : b.x + b.w;
+    int32_t y1 = a.y + a.h < b.y + b.h ? a.y + a.h : b.y + b.h;
+    if (x1 <= x0 || y1 <= y0) return ui_rect_t{0, 0, 0, 0};
+    return ui_rect_t{(int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+ui_rect_t ui_rect_union(ui_rect_t a, ui_rect_t b) {
+    if (ui_rect_is_empty(a)) return b;
+    if (ui_rect_is_empty(b)) return a;
+    int32_t x0 = a.x < b.x ? a.x : b.x;
+    int32_t y0 = a.y < b.y ? a.y : b.y;
+    int32_t x1 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+    int32_t y1 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+    return ui_rect_t{(int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+void ui_damage_init(ui_damage_t* damage, int16_t width, int16_t height) {
+    if (!damage) return;
+    damage->screen = ui_rect_t{0, 0, width, height};
+    damage->count = 0;
+}
+
+void ui_damage_clear(ui_damage_t* damage) {
+    if (damage) damage->count = 0;
+}
+
+static void remove_at(ui_damage_t* damage, uint32_t index) {
+    damage->rects[index] = damage->rects[--damage->count];
+}
+
+void ui_damage_add(ui_damage_t* damage, ui_rect_t rect) {
+    if (!damage) return;
+    rect = ui_rect_intersect(rect, damage->screen);
+    if (ui_rect_is_empty(rect)) return;
+
+    // Absorb every listed rectangle one window covers as cheaply as two; a
+    // merge can bring the grown rectangle in reach of others, so start over
+    for (;;) {
+        bool merged = false;
+        for (uint32_t i = 0; i < damage->count; i++) {
+            ui_rect_t joined = ui_rect_union(damage->rects[i], rect);
+            if (ui_rect_area(joined) <= ui_rect_area(damage->rects[i]) + ui_rect_area(rect) + UI_DAMAGE_MERGE_SLACK_PX) {
+                rect = joined;
+                remove_at(damage, i);
+                merged = true;
+                break;
+            }
+        }
+        if (merged) continue;
+        if (damage->count < UI_DAMAGE_MAX_RECTS) break;
+
+        // Full: join the rectangle that grows least and place the result again
+        uint32_t best = 0;
+        uint32_t best_growth = UINT32_MAX;
+        for (uint32_t i = 0; i < damage->count; i++) {
+            uint32_t growth = ui_rect_area(ui_rect_union(damage->rects[i], rect)) - ui_rect_area(damage->rects[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        rect = ui_rect_union(damage->rects[best], rect);
+        remove_at(damage, best);
+    }
+    damage->rects[damage->count++] = rect;
+}
+
+void ui_damage_add_screen(ui_damage_t* damage) {
+    if (!damage) return;
+    damage->count = 0;
+    ui_damage_add(damage, damage->screen);
+}
+
+bool ui_damage_is_empty(const ui_damage_t* damage) {
+    return !damage || damage->count == 0;
+}
+
+uint32_t ui_damage_area(const ui_damage_t* damage) {
+    if (!damage) return 0;
+    uint32_t area = 0;
+    for (uint32_t i = 0; i < damage->count; i++) area += ui_rect_area(damage->rects[i]);
+    return area;
+}
@@ -0,0 +1,254 @@
+/*
+ * UI Display List Implementation
+ * Recording, tile replay and call-by-call damage between frames
+ */
+
+#include "ui/ui_display_list.h"
+#include "hal/hal_system.h"
+
+#include <string.h>
+
+// FNV-1a over text and bitmap contents
+static uint32_t hash_bytes(const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int16_t min16(int16_t a, int16_t b) { return a < b ? a : b; }
+static int16_t max16(int16_t a, int16_t b) { return a > b ? a : b; }
+
+bool ui_display_list_init(ui_display_list_t* list, uint32_t max_ops, uint32_t text_bytes) {
+    if (!list || max_ops == 0) return false;
+    memset(list, 0, sizeof(*list));
+    list->ops = (ui_op_t*)hal_system_malloc(max_ops * sizeof(ui_op_t));
+    if (!list->ops) return false;
+    if (text_bytes) {
+        list->text = (char*)hal_system_malloc(text_bytes);
+        if (!list->text) {
+            ui_display_list_deinit(list);
+            return false;
+        }
+    }
+    list->max_ops = max_ops;
+    list->text_bytes = text_bytes;
+    return true;
+}
+
+void ui_display_list_deinit(ui_display_list_t* list) {
+    if (!list) return;
+    if (list->ops) hal_system_free(list->ops);
+    if (list->text) hal_system_free(list->text);
+    memset(list, 0, sizeof(*list));
+}
+
+// Recording
+static ui_op_t* append(ui_display_list_t* list, ui_op_kind_t kind, uint16_t color, ui_rect_t bounds) {
+    if (!list || !list->ops) return NULL;
+    if (list->count >= list->max_ops) {
+        list->dropped++;
+        return NULL;
+    }
+    ui_op_t* op = &list->ops[list->count++];
+    memset(op, 0, sizeof(*op));
+    op->kind = (uint8_t)kind;
+    op->color = color;
+    op->bounds = bounds;
+    return op;
+}
+
+static void set_coords(ui_op_t* op, int16_t a, int16_t b, int16_t c, int16_t d, int16_t e, int16_t f) {
+    op->v[0] = a; op->v[1] = b; op->v[2] = c;
+    op->v[3] = d; op->v[4] = e; op->v[5] = f;
+}
+
+void ui_display_list_clear(ui_display_list_t* list, uint16_t color) {
+    if (!list || !list->ops) return;
+    list->count = 0;
+    list->text_used = 0;
+    list->dropped = 0;
+    append(list, UI_OP_CLEAR, color, ui_rect_t{0, 0, INT16_MAX, INT16_MAX});
+}
+
+static bool contains(ui_rect_t outer, ui_rect_t inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+}
+
+// An opaque call hides every earlier call inside it, so those are retired. An
+// overlay redrawn in place each frame without a clear then stays a few calls.
+static void retire_covered(ui_display_list_t* list, ui_rect_t cover) {
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < list->count; i++) {
+        const ui_op_t* op = &list->ops[i];
+        if (op->kind != UI_OP_CLEAR && contains(cover, op->bounds)) continue;
+        if (kept != i) list->ops[kept] = *op;
+        kept++;
+    }
+    list->count = kept;
+}
+
+// Moves the text of live calls down over that of retired ones
+static void compact_text(ui_display_list_t* list) {
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < list->count; i++) {
+        ui_op_t* op = &list->ops[i];
+        if (op->kind != UI_OP_TEXT) continue;
+        size_t len = strlen((const char*)op->data) + 1;
+        memmove(list->text + used, op->data, len);
+        op->data = list->text + used;
+        used += (uint32_t)len;
+    }
+    list->text_used = used;
+}
+
+static bool append_rect(ui_display_list_t* list, ui_op_kind_t kind, int16_t x, int16_t y, int16_t w, int16_t h,
+                        uint16_t color) {
+    ui_rect_t bounds = {x, y, w, h};
+    if (ui_rect_is_empty(bounds)) return true;      // Draws nothing
+    if (kind == UI_OP_FILL_RECT && list && list->ops) retire_covered(list, bounds);
+    ui_op_t* op = append(list, kind, color, bounds);
+    if (!op) return false;
+    set_coords(op, x, y, w, h, 0, 0);
+    return true;
+}
+
+bool ui_display_list_fill_rect(ui_display_list_t* list, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    return append_rect(list, UI_OP_FILL_RECT, x, y, w, h, color);
+}
+
+bool ui_display_list_rect(ui_display_list_t* list, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    return append_rect(list, UI_OP_RECT, x, y, w, h, color);
+}
+
+bool ui_display_list_line(ui_display_list_t* list, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int16_t x = min16(x0, x1), y = min16(y0, y1);
+    ui_op_t* op = append(list, UI_OP_LINE, color,
+                         ui_rect_t{x, y, (int16_t)(max16(x0, x1) - x + 1), (int16_t)(max16(y0, y1) - y + 1)});
+    if (!op) return false;
+    set_coords(op, x0, y0, x1, y1, 0, 0);
+    return true;
+}
+
+bool ui_display_list_circle(ui_display_list_t* list, int16_t x, int16_t y, int16_t r, uint16_t color, bool filled) {
+    if (r < 0) return true;
+    ui_op_t* op = append(list, filled ? UI_OP_FILL_CIRCLE : UI_OP_CIRCLE, color,
+                         ui_rect_t{(int16_t)(x - r), (int16_t)(y - r), (int16_t)(2 * r + 1), (int16_t)(2 * r + 1)});
+    if (!op) return false;
+    set_coords(op, x, y, r, 0, 0, 0);
+    return true;
+}
+
+bool ui_display_list_triangle(ui_display_list_t* list, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              int16_t x2, int16_t y2, uint16_t color, bool filled) {
+    int16_t x = min16(x0, min16(x1, x2)), y = min16(y0, min16(y1, y2));
+    ui_rect_t bounds = {x, y, (int16_t)(max16(x0, max16(x1, x2)) - x + 1), (int16_t)(max16(y0, max16(y1, y2)) - y + 1)};
+    ui_op_t* op = append(list, filled ? UI_OP_FILL_TRIANGLE : UI_OP_TRIANGLE, color, bounds);
+    if (!op) return false;
+    set_coords(op, x0, y0, x1, y1, x2, y2);
+    return true;
+}
+
+bool ui_display_list_text(ui_display_list_t* list, int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size) {
+    if (!list || !list->text || !text) return false;
+    ui_rect_t bounds = ui_text_bounds(x, y, text, size);
+    if (ui_rect_is_empty(bounds)) return true;
+    size_t len = (size_t)(bounds.w / (UI_FONT_CELL_W * size));
+    if (list->text_used + len + 1 > list->text_bytes) compact_text(list);
+    if (list->text_used + len + 1 > list->text_bytes) {
+        list->dropped++;
+        return false;
+    }
+    ui_op_t* op = append(list, UI_OP_TEXT, color, bounds);
+    if (!op) return false;
+
+    char* copy = list->text + list->text_used;
+    memcpy(copy, text, len);
+    copy[len] = '\0';
+    list->text_used += (uint32_t)len + 1;
+    op->size = size;
+    op->data = copy;
+    op->hash = hash_bytes(copy, len);
+    set_coords(op, x, y, (int16_t)len, 0, 0, 0);
+    return true;
+}
+
+bool ui_display_list_bitmap(ui_display_list_t* list, int16_t x, int16_t y, const uint8_t* bitmap,
+                            int16_t w, int16_t h, uint16_t color) {
+    if (!bitmap || w <= 0 || h <= 0) return true;
+    ui_op_t* op = append(list, UI_OP_BITMAP, color, ui_rect_t{x, y, w, h});
+    if (!op) return false;
+    op->data = bitmap;
+    op->hash = hash_bytes(bitmap, (size_t)((w + 7) / 8) * h);
+    set_coords(op, x, y, w, h, 0, 0);
+    return true;
+}
+
+bool ui_display_list_rgb_bitmap(ui_display_list_t* list, int16_t x, int16_t y, const uint16_t* pixels,
+                                int16_t w, int16_t h) {
+    if (!pixels || w <= 0 || h <= 0) return true;
+    if (list && list->ops) retire_covered(list, ui_rect_t{x, y, w, h});
+    ui_op_t* op = append(list, UI_OP_RGB_BITMAP, 0, ui_rect_t{x, y, w, h});
+    if (!op) return false;
+    op->data = pixels;
+    op->hash = hash_bytes(pixels, (size_t)w * h * sizeof(uint16_t));
+    set_coords(op, x, y, w, h, 0, 0);
+    return true;
+}
+
+// Replay
+void ui_display_list_paint(const ui_display_list_t* list, ui_canvas_t* canvas) {
+    if (!list || !canvas) return;
+    for (uint32_t i = 0; i < list->count; i++) {
+        const ui_op_t* op = &list->ops[i];
+        if (ui_rect_is_empty(ui_rect_intersect(op->bounds, canvas->rect))) continue;
+        const int16_t* v = op->v;
+        switch (op->kind) {
+            case UI_OP_CLEAR:         ui_canvas_fill(canvas, op->color); break;
+            case UI_OP_FILL_RECT:     ui_canvas_fill_rect(canvas, v[0], v[1], v[2], v[3], op->color); break;
+            case UI_OP_RECT:          ui_canvas_rect(canvas, v[0], v[1], v[2], v[3], op->color); break;
+            case UI_OP_LINE:          ui_canvas_line(canvas, v[0], v[1], v[2], v[3], op->color); break;
+            case UI_OP_CIRCLE:        ui_canvas_circle(canvas, v[0], v[1], v[2], op->color); break;
+            case UI_OP_FILL_CIRCLE:   ui_canvas_fill_circle(canvas, v[0], v[1], v[2], op->color); break;
+            case UI_OP_TRIANGLE:      ui_canvas_triangle(canvas, v[0], v[1], v[2], v[3], v[4], v[5], op->color); break;
+            case UI_OP_FILL_TRIANGLE: ui_canvas_fill_triangle(canvas, v[0], v[1], v[2], v[3], v[4], v[5], op->color); break;
+            case UI_OP_TEXT:          ui_canvas_text(canvas, v[0], v[1], (const char*)op->data, op->color, op->size); break;
+            case UI_OP_BITMAP:        ui_canvas_bitmap(canvas, v[0], v[1], (const uint8_t*)op->data, v[2], v[3], op->color); break;
+            case UI_OP_RGB_BITMAP:    ui_canvas_rgb_bitmap(canvas, v[0], v[1], (const uint16_t*)op->data, v[2], v[3]); break;
+        }
+    }
+}
+
+// Damage
+static bool same_op(const ui_op_t* a, const ui_op_t* b) {
+    return a->kind == b->kind && a->size == b->size && a->color == b->color && a->hash == b->hash &&
+           memcmp(a->v, b->v, sizeof(a->v)) == 0;
+}
+
+void ui_display_list_diff(const ui_display_list_t* before, const ui_display_list_t* after, ui_damage_t* damage) {
+    if (!before || !after || !damage) return;
+    // A pixel keeps its value while the calls covering it stay the same, in the same order
+    uint32_t count = before->count > after->count ? before->count : after->count;
+    for (uint32_t i = 0; i < count; i++) {
+        const ui_op_t* a = i < before->count ? &before->ops[i] : NULL;
+        const ui_op_t* b = i < after->count ? &after->ops[i] : NULL;
+        if (a && b && same_op(a, b)) continue;
+        if (a) ui_damage_add(damage, a->bounds);
+        if (b) ui_damage_add(damage, b->bounds);
+    }
+}
+
+void ui_display_list_snapshot(const ui_display_list_t* from, ui_display_list_t* to) {
+    if (!from || !to || !to->ops) return;
+    uint32_t count = from->count < to->max_ops ? from->count : to->max_ops;
+    memcpy(to->ops, from->ops, count * sizeof(ui_op_t));
+    to->count = count;
+    // The text stays in from's arena, which a snapshot only ever compares by hash
+    for (uint32_t i = 0; i < count; i++) {
+        if (to->ops[i].kind == UI_OP_TEXT) to->ops[i].data = NULL;
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * UI Font Implementation
+ * Span blitting of packed alpha glyphs into a canvas
+ */
+
+#include "ui/ui_font.h"
+
+#include <string.h>
+
+const ui_font_t* ui_font_for_size(uint8_t size) {
+    switch (size) {
+        case 2:  return &ui_font_mono_16;
+        case 3:  return &ui_font_mono_24;
+        default: return NULL;
+    }
+}
+
+// Blend weights (0-32) for each alpha level, by bits per pixel
+static const uint8_t kWeights1[2] = {0, 32};
+static const uint8_t kWeights2[4] = {0, 11, 21, 32};
+static const uint8_t kWeights4[16] = {0, 2, 4, 6, 9, 11, 13, 15, 17, 19, 21, 23, 26, 28, 30, 32};
+
+static const ui_glyph_t* find_glyph(const ui_font_t* font, char c) {
+    uint8_t code = (uint8_t)c;
+    if (code < font->first || code > font->last) code = '?';
+    return &font->glyphs[code - font->first];
+}
+
+// One glyph row, clipped to the canvas row that spans [x0, x1), as spans of equal alpha
+static void blit_row(uint16_t* row, int16_t left, int16_t x0, int16_t x1, const uint8_t* bits,
+                     uint8_t w, uint8_t bpp, uint16_t color) {
+    const uint32_t levels = (1u << bpp) - 1;
+    const uint8_t* weights = bpp == 4 ? kWeights4 : bpp == 2 ? kWeights2 : kWeights1;
+    int16_t col = x0 > left ? x0 - left : 0;
+    int16_t end = left + w < x1 ? w : x1 - left;
+
+    // Unpack the visible columns first, so the span scan compares bytes
+    uint8_t alphas[256];
+    for (int16_t i = col, bit = col * bpp; i < end; i++, bit += bpp) {
+        alphas[i] = (uint8_t)((bits[bit >> 3] >> (8 - bpp - (bit & 7))) & levels);
+    }
+    while (col < end) {
+        uint32_t alpha = alphas[col];
+        int16_t start = col++;
+        while (col < end && alphas[col] == alpha) col++;
+        if (alpha == 0) continue;
+        uint16_t* out = row + (left + start - x0);
+        if (alpha == levels) {
+            for (int16_t i = start; i < col; i++) *out++ = color;
+        } else {
+            uint32_t weight = weights[alpha];
+            for (int16_t i = start; i < col; i++, out++) *out = ui_blend565(color, *out, weight);
+        }
+    }
+}
+
+static void draw_glyph(ui_canvas_t* canvas, int16_t x, int16_t y, const ui_font_t* font, const ui_glyph_t* glyph,
+                       uint16_t color) {
+    const ui_rect_t* clip = &canvas->rect;
+    int16_t left = x + glyph->x, top = y + glyph->y;
+    if (glyph->w == 0 || left >= clip->x + clip->w || left + glyph->w <= clip->x) return;
+
+    const uint16_t stride = (uint16_t)((glyph->w * font->bpp + 7) / 8);
+    int16_t first = top < clip->y ? clip->y - top : 0;
+    int16_t last = top + glyph->h > clip->y + clip->h ? clip->y + clip->h - top : glyph->h;
+    for (int16_t r = first; r < last; r++) {
+        uint16_t* row = canvas->pixels + (top + r - clip->y) * clip->w;
+        blit_row(row, left, clip->x, clip->x + clip->w, font->bitmap + glyph->offset + r * stride,
+                 glyph->w, font->bpp, color);
+    }
+}
+
+int16_t ui_font_draw(ui_canvas_t* canvas, int16_t x, int16_t y, const char* text,
+                     const ui_font_t* font, uint16_t color) {
+    if (!text || !font) return x;
+    bool visible = canvas && y < canvas->rect.y + canvas->rect.h && y + font->line_height > canvas->rect.y;
+    for (const char* p = text; *p && *p != '\n'; p++) {
+        const ui_glyph_t* glyph = find_glyph(font, *p);
+        if (visible) draw_glyph(canvas, x, y, font, glyph, color);
+        x += glyph->advance;
+    }
+    return x;
+}
+
+int16_t ui_font_text_width(const ui_font_t* font, const char* text) {
+    if (!font || !text) return 0;
+    int16_t width = 0;
+    for (const char* p = text; *p && *p != '\n'; p++) width += find_glyph(font, *p)->advance;
+    return width;
+}
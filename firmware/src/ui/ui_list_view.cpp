@@ -0,0 +1,172 @@
+/*
+ * UI List View Implementation
+ * The row buffer ring, lazy fetch and render, and row copies into bands
+ */
+
+#include "ui/ui_list_view.h"
+#include "hal/hal_system.h"
+
+#include <string.h>
+
+static void drop_rows(ui_list_view_t* view) {
+    for (uint16_t i = 0; i < view->slot_count; i++) view->slots[i].index = UI_LIST_VIEW_NO_ROW;
+}
+
+bool ui_list_view_init(ui_list_view_t* view, int16_t width, int16_t height, int16_t row_h, uint16_t overscan,
+                       uint16_t color, uint16_t selected_color, uint16_t background) {
+    if (!view) return false;
+    memset(view, 0, sizeof(*view));
+    if (width <= 0 || height <= 0 || row_h <= 0) return false;
+    view->width = width;
+    view->height = height;
+    view->row_h = row_h;
+    view->visible_rows = (uint16_t)((height + row_h - 1) / row_h);
+    view->overscan = overscan;
+    view->slot_count = (uint16_t)(view->visible_rows + 2 * overscan);
+    view->selected = UI_LIST_VIEW_NO_ROW;
+    view->color = color;
+    view->selected_color = selected_color;
+    view->background = background;
+
+    // Every row buffer in one block after the slots; large enough to prefer PSRAM
+    size_t row_pixels = (size_t)width * row_h;
+    size_t bytes = view->slot_count * (sizeof(ui_list_slot_t) + row_pixels * sizeof(uint16_t));
+    view->slots = (ui_list_slot_t*)hal_system_malloc_psram(bytes);
+    if (!view->slots) return false;
+    uint16_t* pixels = (uint16_t*)(view->slots + view->slot_count);
+    for (uint16_t i = 0; i < view->slot_count; i++) {
+        memset(&view->slots[i], 0, sizeof(view->slots[i]));
+        view->slots[i].pixels = pixels + i * row_pixels;
+    }
+    drop_rows(view);
+    return true;
+}
+
+void ui_list_view_deinit(ui_list_view_t* view) {
+    if (!view) return;
+    hal_system_free(view->slots);
+    view->slots = NULL;
+    view->slot_count = 0;
+}
+
+void ui_list_view_set_source(ui_list_view_t* view, ui_list_source_fn_t source, void* user_data, uint32_t count) {
+    if (!view) return;
+    view->source = source;
+    view->user_data = user_data;
+    view->count = source ? count : 0;
+    view->top = 0;
+    if (view->selected != UI_LIST_VIEW_NO_ROW && view->selected >= view->count) view->selected = UI_LIST_VIEW_NO_ROW;
+    drop_rows(view);
+}
+
+void ui_list_view_reset(ui_list_view_t* view) {
+    if (view && view->slots) drop_rows(view);
+}
+
+// Scrolling
+static uint32_t full_rows(const ui_list_view_t* view) {
+    uint32_t rows = (uint32_t)(view->height / view->row_h);
+    return rows ? rows : 1;
+}
+
+bool ui_list_view_scroll_to(ui_list_view_t* view, uint32_t top) {
+    if (!view) return false;
+    uint32_t fit = full_rows(view);
+    uint32_t max_top = view->count > fit ? view->count - fit : 0;
+    if (top > max_top) top = max_top;
+    if (top == view->top) return false;
+    view->top = top;
+    view->stats.scrolls++;
+    return true;
+}
+
+bool ui_list_view_select(ui_list_view_t* view, uint32_t index) {
+    if (!view) return false;
+    if (index >= view->count) index = UI_LIST_VIEW_NO_ROW;
+    view->selected = index;
+    if (index == UI_LIST_VIEW_NO_ROW) return false;
+    uint32_t fit = full_rows(view);
+    if (index < view->top) return ui_list_view_scroll_to(view, index);
+    if (index >= view->top + fit) return ui_list_view_scroll_to(view, index - fit + 1);
+    return false;
+}
+
+// Rows
+static void render(ui_list_view_t* view, ui_list_slot_t* slot) {
+    ui_canvas_t canvas;
+    ui_canvas_init(&canvas, slot->pixels, ui_rect_t{0, 0, view->width, view->row_h});
+    ui_canvas_fill(&canvas, view->background);
+    uint16_t color = view->color;
+    if (slot->selected) {
+        ui_canvas_fill_rect(&canvas, 0, 0, view->marker_w, view->marker_h, view->selected_color);
+        color = view->selected_color;
+    }
+    if (slot->text[0]) ui_canvas_text(&canvas, view->text_x, view->text_y, slot->text, color, 1);
+    view->stats.renders++;
+}
+
+// The buffer holding the row as it should look, fetched and rendered if it isn't yet
+static ui_list_slot_t* materialize(ui_list_view_t* view, uint32_t index) {
+    ui_list_slot_t* slot = &view->slots[index % view->slot_count];
+    bool selected = index == view->selected;
+    if (slot->index != index) {
+        // The row it held has left the window; its buffer is this row's now
+        slot->index = index;
+        slot->text[0] = '\0';
+        view->source(index, slot->text, view->user_data);
+        slot->text[UI_LIST_VIEW_TEXT_MAX - 1] = '\0';
+        view->stats.fetches++;
+    } else if (slot->selected == selected) {
+        return slot;
+    }
+    slot->selected = selected;
+    render(view, slot);
+    return slot;
+}
+
+void ui_list_view_prefetch(ui_list_view_t* view) {
+    if (!view || !view->slots || !view->source) return;
+    uint32_t first = view->top > view->overscan ? view->top - view->overscan : 0;
+    uint32_t end = view->top + view->visible_rows + view->overscan;
+    if (end > view->count) end = view->count;
+    for (uint32_t i = first; i < end; i++) materialize(view, i);
+}
+
+void ui_list_view_paint(ui_list_view_t* view, ui_canvas_t* canvas, int16_t x, int16_t y) {
+    if (!view || !view->slots || !view->source || !view->count || !canvas) return;
+    const ui_rect_t area = ui_rect_intersect(ui_rect_t{x, y, view->width, view->height}, canvas->rect);
+    if (ui_rect_is_empty(area)) return;
+
+    uint32_t first = view->top + (uint32_t)((area.y - y) / view->row_h);
+    uint32_t last = view->top + (uint32_t)((area.y + area.h - 1 - y) / view->row_h);
+    if (last >= view->count) last = view->count - 1;
+    for (uint32_t i = first; i <= last; i++) {
+        const ui_list_slot_t* slot = materialize(view, i);
+        const int16_t top = (int16_t)(y + (int32_t)(i - view->top) * view->row_h);
+        int16_t from = top > area.y ? top : area.y;
+        int16_t to = top + view->row_h < area.y + area.h ? (int16_t)(top + view->row_h) : (int16_t)(area.y + area.h);
+        const uint16_t* src = slot->pixels + (from - top) * view->width + (area.x - x);
+        uint16_t* dst = canvas->pixels + (from - canvas->rect.y) * canvas->rect.w + (area.x - canvas->rect.x);
+        for (int16_t row = from; row < to; row++) {
+            memcpy(dst, src, area.w * sizeof(uint16_t));
+            src += view->width;
+            dst += canvas->rect.w;
+        }
+        view->stats.blits++;
+    }
+}
+
+ui_rect_t ui_list_view_row_rect(const ui_list_view_t* view, uint32_t index) {
+    const ui_rect_t empty = {0, 0, 0, 0};
+    if (!view || index >= view->count || index < view->top || index >= view->top + view->visible_rows) return empty;
+    ui_rect_t row = {0, (int16_t)((index - view->top) * view->row_h), view->width, view->row_h};
+    return ui_rect_intersect(row, ui_rect_t{0, 0, view->width, view->height});
+}
+
+void ui_list_view_get_stats(const ui_list_view_t* view, ui_list_view_stats_t* stats) {
+    if (view && stats) *stats = view->stats;
+}
+
+void ui_list_view_reset_stats(ui_list_view_t* view) {
+    if (view) memset(&view->stats, 0, sizeof(view->stats));
+}
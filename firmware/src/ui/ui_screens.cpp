@@ -0,0 +1,206 @@
+/*
+ * UI Screens Implementation
+ * Screen layouts as widgets, and the model the widgets are set from
+ */
+
+#include "ui/ui_screens.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Layout, in landscape panel pixels
+#define HEADER_X        10
+#define HEADER_Y        10
+#define HEADER_W        220
+#define HEADER_H        26                  // Title and the rule under it
+#define TOAST_X         10
+#define TOAST_Y         38
+
+#define MENU_X          6                   // Selection marker, then the labels
+#define MENU_Y          48
+#define MENU_STEP       22
+#define MARKER_W        3
+#define MARKER_H        12
+#define MENU_TEXT_X     6
+#define MENU_TEXT_Y     2
+
+#define PROGRESS_X      10
+#define PROGRESS_Y      170
+#define PROGRESS_W      220
+#define PROGRESS_H      12
+#define ELAPSED_X       10
+#define DURATION_X      200
+#define TIME_Y          190
+
+static const char* const kHomeItems[] = {"Music", "RFID", "Settings"};
+static const char* const kMusicItems[] = {"Now Playing", "Artists", "Albums", "Songs"};
+
+static const char* const* menu_items(ui_screen_id_t screen, int* count) {
+    if (screen == UI_SCREEN_HOME) {
+        *count = sizeof(kHomeItems) / sizeof(kHomeItems[0]);
+        return kHomeItems;
+    }
+    *count = sizeof(kMusicItems) / sizeof(kMusicItems[0]);
+    return kMusicItems;
+}
+
+int ui_screens_menu_count(ui_screen_id_t screen) {
+    int count = 0;
+    if (screen == UI_SCREEN_HOME || screen == UI_SCREEN_MUSIC) menu_items(screen, &count);
+    return count;
+}
+
+static void format_time(char* out, size_t size, uint32_t secs) {
+    snprintf(out, size, "%02lu:%02lu", (unsigned long)(secs / 60), (unsigned long)(secs % 60));
+}
+
+// Building the tree
+static void build_menu(ui_screens_t* s) {
+    ui_widget_box(&s->menu, ui_rect_t{0, 0, 0, 0}, UI_LAYOUT_FIXED);
+    ui_widget_list(&s->menu_list, ui_rect_t{MENU_X, MENU_Y, 140, 0}, MENU_STEP, UI_COLOR_FG, UI_COLOR_ACCENT);
+    s->menu_list.list.marker_w = MARKER_W;
+    s->menu_list.list.marker_h = MARKER_H;
+    s->menu_list.list.text_x = MENU_TEXT_X;
+    s->menu_list.list.text_y = MENU_TEXT_Y;
+    ui_widget_image(&s->menu_art, ui_rect_t{150, 50, 0, 0}, NULL, 80, 80, UI_COLOR_FG);
+    ui_widget_label(&s->menu_art_label, ui_rect_t{0, 38, 0, 0}, "", UI_COLOR_FG, 1);
+    s->menu_art_label.align = UI_ALIGN_CENTER;
+
+    ui_widget_add(&s->menu, &s->menu_list);
+    ui_widget_add(&s->menu, &s->menu_art);
+    ui_widget_add(&s->menu_art, &s->menu_art_label);
+}
+
+static void build_now_playing(ui_screens_t* s) {
+    ui_widget_box(&s->now_playing, ui_rect_t{0, 0, 0, 0}, UI_LAYOUT_FIXED);
+    ui_widget_image(&s->np_art, ui_rect_t{10, 50, 0, 0}, NULL, 100, 100, UI_COLOR_FG);
+    ui_widget_label(&s->np_art_label, ui_rect_t{0, 48, 0, 0}, "artwork", UI_COLOR_FG, 1);
+    s->np_art_label.align = UI_ALIGN_CENTER;
+    ui_widget_label(&s->np_title, ui_rect_t{120, 60, 0, 0}, "", UI_COLOR_FG, 1);
+    ui_widget_label(&s->np_artist, ui_rect_t{120, 75, 0, 0}, "", UI_COLOR_FG, 1);
+    ui_widget_progress(&s->np_progress, ui_rect_t{PROGRESS_X, PROGRESS_Y, PROGRESS_W, PROGRESS_H},
+                       UI_COLOR_FG, UI_COLOR_HI);
+    ui_widget_label(&s->np_elapsed, ui_rect_t{ELAPSED_X, TIME_Y, 0, 0}, "", UI_COLOR_FG, 1);
+    ui_widget_label(&s->np_duration, ui_rect_t{DURATION_X, TIME_Y, 0, 0}, "", UI_COLOR_FG, 1);
+
+    ui_widget_add(&s->now_playing, &s->np_art);
+    ui_widget_add(&s->np_art, &s->np_art_label);
+    ui_widget_add(&s->now_playing, &s->np_title);
+    ui_widget_add(&s->now_playing, &s->np_artist);
+    ui_widget_add(&s->now_playing, &s->np_progress);
+    ui_widget_add(&s->now_playing, &s->np_elapsed);
+    ui_widget_add(&s->now_playing, &s->np_duration);
+}
+
+static void build_splash(ui_screens_t* s) {
+    const int16_t x = 20, y = 40;
+    ui_widget_box(&s->splash, ui_rect_t{0, 0, 0, 0}, UI_LAYOUT_FIXED);
+    ui_widget_label(&s->splash_company, ui_rect_t{x, y, 0, 0}, "", UI_COLOR_FG, 2);
+    ui_widget_label(&s->splash_firmware, ui_rect_t{x, y + 40, 0, 0}, "", UI_COLOR_FG, 2);
+    ui_widget_label(&s->splash_version, ui_rect_t{x, y + 65, 0, 0}, "", UI_COLOR_FG, 1);
+    ui_widget_label(&s->splash_badge, ui_rect_t{x, y + 85, 0, 0}, "", UI_COLOR_FG, 1);
+
+    ui_widget_add(&s->splash, &s->splash_company);
+    ui_widget_add(&s->splash, &s->splash_firmware);
+    ui_widget_add(&s->splash, &s->splash_version);
+    ui_widget_add(&s->splash, &s->splash_badge);
+}
+
+static void build_tree(ui_screens_t* s) {
+    const ui_rect_t screen = s->compositor->damage.screen;
+    ui_widget_box(&s->root, screen, UI_LAYOUT_FIXED);
+    ui_widget_status_bar(&s->header, ui_rect_t{HEADER_X, HEADER_Y, HEADER_W, HEADER_H}, UI_COLOR_FG, UI_COLOR_HI);
+    ui_widget_label(&s->toast, ui_rect_t{TOAST_X, TOAST_Y, 0, 0}, "", UI_COLOR_HI, 1);
+    build_menu(s);
+    build_now_playing(s);
+    build_splash(s);
+
+    ui_widget_add(&s->root, &s->menu);
+    ui_widget_add(&s->root, &s->now_playing);
+    ui_widget_add(&s->root, &s->splash);
+    ui_widget_add(&s->root, &s->header);
+    ui_widget_add(&s->root, &s->toast);
+
+    // Cached runs carry the background in their gaps
+    ui_text_cache_t* cache = s->compositor->background == UI_COLOR_BG ? &s->text_cache : NULL;
+    ui_tree_init(&s->tree, &s->root, s->compositor, cache);
+}
+
+// Model to widgets
+static void set_menu(ui_screens_t* s, const ui_screen_model_t* model) {
+    int count;
+    const char* const* items = menu_items(model->screen, &count);
+    bool home = model->screen == UI_SCREEN_HOME;
+    ui_widget_set_text(&s->header, home ? "Home" : "Music");
+    ui_widget_set_items(&s->menu_list, items, count);
+    ui_widget_set_selected(&s->menu_list, model->selected);
+    ui_widget_set_text(&s->menu_art_label, home ? "menu" : "artwork");
+}
+
+static void set_now_playing(ui_screens_t* s, const ui_screen_model_t* model) {
+    char buf[16];
+    ui_widget_set_text(&s->header, "Now Playing");
+    ui_widget_set_text(&s->np_title, model->title);
+    ui_widget_set_text(&s->np_artist, model->artist);
+    ui_widget_set_progress(&s->np_progress, model->progress);
+    format_time(buf, sizeof(buf), model->elapsed_s);
+    ui_widget_set_text(&s->np_elapsed, buf);
+    format_time(buf, sizeof(buf), model->duration_s);
+    ui_widget_set_text(&s->np_duration, buf);
+}
+
+static void set_splash(ui_screens_t* s, const ui_screen_model_t* model) {
+    char buf[UI_SCREEN_TEXT_MAX + 16];
+    ui_widget_set_text(&s->splash_company, model->company);
+    ui_widget_set_text(&s->splash_firmware, model->firmware);
+    snprintf(buf, sizeof(buf), "Version: %s", model->version);
+    ui_widget_set_text(&s->splash_version, buf);
+    ui_widget_set_text(&s->splash_badge, model->badge);
+    ui_widget_set_color(&s->splash_badge, model->badge_color);
+}
+
+void ui_screens_init(ui_screens_t* screens, ui_compositor_t* compositor) {
+    if (!screens) return;
+    memset(screens, 0, sizeof(*screens));
+    screens->compositor = compositor;
+    if (!compositor) return;
+    // Without memory for the cache, text is drawn directly
+    ui_text_cache_init(&screens->text_cache, UI_TEXT_CACHE_BYTES);
+    build_tree(screens);
+    ui_widget_set_visible(&screens->menu, false);
+    ui_widget_set_visible(&screens->now_playing, false);
+    ui_widget_set_visible(&screens->splash, false);
+    ui_widget_set_visible(&screens->header, false);
+    // Whatever the panel held before, the first show covers all of it
+    ui_compositor_invalidate_all(compositor);
+}
+
+void ui_screens_deinit(ui_screens_t* screens) {
+    if (!screens) return;
+    ui_text_cache_deinit(&screens->text_cache);
+}
+
+uint32_t ui_screens_show(ui_screens_t* screens, const ui_screen_model_t* model) {
+    if (!screens || !screens->compositor || !model) return 0;
+    ui_screen_id_t screen = model->screen;
+    bool menu = screen == UI_SCREEN_HOME || screen == UI_SCREEN_MUSIC;
+    ui_widget_set_visible(&screens->menu, menu);
+    ui_widget_set_visible(&screens->now_playing, screen == UI_SCREEN_NOW_PLAYING);
+    ui_widget_set_visible(&screens->splash, screen == UI_SCREEN_SPLASH);
+    ui_widget_set_visible(&screens->header, menu || screen == UI_SCREEN_NOW_PLAYING);
+    ui_widget_set_visible(&screens->toast, screen != UI_SCREEN_SPLASH);
+
+    if (menu) set_menu(screens, model);
+    if (screen == UI_SCREEN_NOW_PLAYING) set_now_playing(screens, model);
+    if (screen == UI_SCREEN_SPLASH) set_splash(screens, model);
+    ui_widget_set_text(&screens->toast, model->toast);
+
+    if (screen != screens->shown.screen) ui_compositor_invalidate_all(screens->compositor);
+    screens->shown = *model;
+    return ui_tree_update(&screens->tree);
+}
+
+void ui_screens_set_text(char* field, const char* text) {
+    if (!field) return;
+    snprintf(field, UI_SCREEN_TEXT_MAX, "%s", text ? text : "");
+}
@@ -0,0 +1,220 @@
+/*
+ * UI Text Cache Implementation
+ * Row-by-row capture of rendered strings into runs, LRU eviction and clipped blits
+ */
+
+#include "ui/ui_text_cache.h"
+#include "hal/hal_system.h"
+
+#include <string.h>
+
+bool ui_text_cache_init(ui_text_cache_t* cache, uint32_t budget_bytes) {
+    if (!cache) return false;
+    memset(cache, 0, sizeof(*cache));
+    cache->scratch = (uint16_t*)hal_system_malloc(UI_TEXT_CACHE_MAX_WIDTH * sizeof(uint16_t));
+    if (!cache->scratch) return false;
+    cache->budget = budget_bytes;
+    return true;
+}
+
+static void release(ui_text_cache_t* cache, ui_text_run_t* run) {
+    if (!run->used) return;
+    hal_system_free(run->spans);
+    cache->stats.bytes -= run->bytes;
+    memset(run, 0, sizeof(*run));
+}
+
+void ui_text_cache_clear(ui_text_cache_t* cache) {
+    if (!cache) return;
+    for (uint32_t i = 0; i < UI_TEXT_CACHE_ENTRIES; i++) release(cache, &cache->runs[i]);
+}
+
+void ui_text_cache_deinit(ui_text_cache_t* cache) {
+    if (!cache) return;
+    ui_text_cache_clear(cache);
+    hal_system_free(cache->scratch);
+    cache->scratch = NULL;
+}
+
+// Lookup and eviction
+static ui_text_run_t* find(ui_text_cache_t* cache, const char* text, size_t len, uint16_t color,
+                           uint16_t background, uint8_t size) {
+    for (uint32_t i = 0; i < UI_TEXT_CACHE_ENTRIES; i++) {
+        ui_text_run_t* run = &cache->runs[i];
+        if (run->used && run->size == size && run->color == color && run->background == background &&
+            strncmp(run->text, text, len) == 0 && run->text[len] == '\0') {
+            return run;
+        }
+    }
+    return NULL;
+}
+
+static ui_text_run_t* least_recent(ui_text_cache_t* cache) {
+    ui_text_run_t* oldest = NULL;
+    for (uint32_t i = 0; i < UI_TEXT_CACHE_ENTRIES; i++) {
+        ui_text_run_t* run = &cache->runs[i];
+        if (run->used && (!oldest || run->last_used < oldest->last_used)) oldest = run;
+    }
+    return oldest;
+}
+
+// A free entry once the runs of `bytes` more fit the budget
+static ui_text_run_t* make_room(ui_text_cache_t* cache, uint32_t bytes) {
+    while (cache->stats.bytes + bytes > cache->budget) {
+        release(cache, least_recent(cache));
+        cache->stats.evictions++;
+    }
+    for (uint32_t i = 0; i < UI_TEXT_CACHE_ENTRIES; i++) {
+        if (!cache->runs[i].used) return &cache->runs[i];
+    }
+    ui_text_run_t* oldest = least_recent(cache);
+    release(cache, oldest);
+    cache->stats.evictions++;
+    return oldest;
+}
+
+// Capture
+// Renders one row of the string over the background into the scratch row
+static void render_row(ui_text_cache_t* cache, const char* text, int16_t row, int16_t width,
+                       uint16_t color, uint16_t background, uint8_t size) {
+    ui_canvas_t line;
+    ui_canvas_init(&line, cache->scratch, ui_rect_t{0, row, width, 1});
+    ui_canvas_fill(&line, background);
+    ui_canvas_text(&line, 0, 0, text, color, size);
+}
+
+// Next run in the scratch row from *col, ending on ink; false at the end of the row
+static bool next_span(const uint16_t* pixels, int16_t width, uint16_t background, int16_t* col,
+                      int16_t* start, int16_t* end) {
+    int16_t x = *col;
+    while (x < width && pixels[x] == background) x++;
+    if (x == width) return false;
+    *start = x;
+    *end = x;
+    while (x < width) {
+        if (pixels[x] != background) {
+            *end = ++x;
+        } else if (x - *end + 1 >= UI_TEXT_CACHE_GAP_PX) {
+            break;
+        } else {
+            x++;
+        }
+    }
+    *col = *end;
+    return true;
+}
+
+static ui_text_run_t* capture(ui_text_cache_t* cache, const char* text, size_t len, int16_t width, int16_t height,
+                              uint16_t color, uint16_t background, uint8_t size) {
+    // First pass sizes the runs, the second fills them in
+    uint32_t span_count = 0, pixel_count = 0;
+    for (int16_t row = 0; row < height; row++) {
+        render_row(cache, text, row, width, color, background, size);
+        int16_t col = 0, start, end;
+        while (next_span(cache->scratch, width, background, &col, &start, &end)) {
+            span_count++;
+            pixel_count += end - start;
+        }
+    }
+
+    uint32_t bytes = span_count * sizeof(ui_text_span_t) + pixel_count * sizeof(uint16_t);
+    if (bytes > cache->budget) return NULL;
+    ui_text_run_t* run = make_room(cache, bytes);
+    void* block = bytes ? hal_system_malloc(bytes) : NULL;
+    if (bytes && !block) return NULL;
+
+    run->spans = (ui_text_span_t*)block;
+    run->pixels = (uint16_t*)(run->spans + span_count);
+    uint16_t* out = run->pixels;
+    ui_text_span_t* span = run->spans;
+    for (int16_t row = 0; row < height && span_count; row++) {
+        render_row(cache, text, row, width, color, background, size);
+        int16_t col = 0, start, end;
+        while (next_span(cache->scratch, width, background, &col, &start, &end)) {
+            span->x = start;
+            span->row = (uint16_t)row;
+            span->len = (uint16_t)(end - start);
+            memcpy(out, cache->scratch + start, span->len * sizeof(uint16_t));
+            out += span->len;
+            span++;
+        }
+    }
+
+    memcpy(run->text, text, len);
+    run->text[len] = '\0';
+    run->color = color;
+    run->background = background;
+    run->size = size;
+    run->width = width;
+    run->span_count = span_count;
+    run->bytes = bytes;
+    run->used = true;
+    cache->stats.bytes += bytes;
+    return run;
+}
+
+// Blit
+static void blit(const ui_text_run_t* run, ui_canvas_t* canvas, int16_t x, int16_t y) {
+    const ui_rect_t* clip = &canvas->rect;
+    const uint16_t* pixels = run->pixels;
+    for (uint32_t i = 0; i < run->span_count; i++) {
+        const ui_text_span_t* span = &run->spans[i];
+        const uint16_t* src = pixels;
+        pixels += span->len;
+
+        int16_t sy = y + span->row;
+        if (sy < clip->y) continue;
+        if (sy >= clip->y + clip->h) break;
+        int16_t left = x + span->x, right = left + span->len;
+        if (left < clip->x) {
+            src += clip->x - left;
+            left = clip->x;
+        }
+        if (right > clip->x + clip->w) right = clip->x + clip->w;
+        if (right <= left) continue;
+        memcpy(canvas->pixels + (sy - clip->y) * clip->w + (left - clip->x), src,
+               (size_t)(right - left) * sizeof(uint16_t));
+    }
+}
+
+int16_t ui_text_cache_draw(ui_text_cache_t* cache, ui_canvas_t* canvas, int16_t x, int16_t y, const char* text,
+                           uint16_t color, uint16_t background, uint8_t size) {
+    if (!text) return x;
+    if (!cache || !cache->scratch) return ui_canvas_text(canvas, x, y, text, color, size);
+
+    size_t len = 0;
+    while (text[len] && text[len] != '\n') len++;
+    ui_text_run_t* run = NULL;
+    if (len < UI_TEXT_CACHE_TEXT_MAX) run = find(cache, text, len, color, background, size);
+
+    if (run) {
+        cache->stats.hits++;
+    } else {
+        ui_rect_t bounds = ui_text_bounds(0, 0, text, size);
+        if (len < UI_TEXT_CACHE_TEXT_MAX && bounds.w <= UI_TEXT_CACHE_MAX_WIDTH) {
+            run = capture(cache, text, len, bounds.w, bounds.h, color, background, size);
+        }
+        if (!run) {
+            cache->stats.uncached++;
+            return ui_canvas_text(canvas, x, y, text, color, size);
+        }
+        cache->stats.misses++;
+    }
+
+    run->last_used = ++cache->clock;
+    if (canvas && y < canvas->rect.y + canvas->rect.h && y + size * UI_FONT_CELL_H > canvas->rect.y) {
+        blit(run, canvas, x, y);
+    }
+    return x + run->width;
+}
+
+void ui_text_cache_get_stats(const ui_text_cache_t* cache, ui_text_cache_stats_t* stats) {
+    if (cache && stats) *stats = cache->stats;
+}
+
+void ui_text_cache_reset_stats(ui_text_cache_t* cache) {
+    if (!cache) return;
+    uint32_t bytes = cache->stats.bytes;
+    memset(&cache->stats, 0, sizeof(cache->stats));
+    cache->stats.bytes = bytes;
+}
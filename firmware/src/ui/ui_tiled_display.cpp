@@ -0,0 +1,74 @@
+/*
+ * UI Tiled Display Implementation
+ * Display list diff, tile rendering and the snapshot kept for the next update
+ */
+
+#include "ui/ui_tiled_display.h"
+
+#include <string.h>
+
+#define TILED_DISPLAY_BACKGROUND  0x0000    // Under the first clear, as the panel starts
+
+static void paint_frame(ui_canvas_t* canvas, void* user_data) {
+    ui_display_list_paint((const ui_display_list_t*)user_data, canvas);
+}
+
+bool ui_tiled_display_init(ui_tiled_display_t* display, int16_t width, int16_t height, uint16_t tile_rows,
+                           const ui_panel_t* panel) {
+    if (!display || !panel) return false;
+    memset(display, 0, sizeof(*display));
+    display->tile_rows = tile_rows;
+    display->panel = *panel;
+    display->full_repaint = true;
+
+    if (!ui_display_list_init(&display->frame, UI_DISPLAY_LIST_MAX_OPS, UI_DISPLAY_LIST_TEXT_BYTES) ||
+        !ui_display_list_init(&display->shown, UI_DISPLAY_LIST_MAX_OPS, 0) ||
+        !ui_compositor_init(&display->compositor, width, height, tile_rows, TILED_DISPLAY_BACKGROUND, panel)) {
+        ui_tiled_display_deinit(display);
+        return false;
+    }
+    return true;
+}
+
+void ui_tiled_display_deinit(ui_tiled_display_t* display) {
+    if (!display) return;
+    ui_compositor_deinit(&display->compositor);
+    ui_display_list_deinit(&display->frame);
+    ui_display_list_deinit(&display->shown);
+    memset(display, 0, sizeof(*display));
+}
+
+bool ui_tiled_display_resize(ui_tiled_display_t* display, int16_t width, int16_t height) {
+    if (!display) return false;
+    ui_compositor_deinit(&display->compositor);
+    display->full_repaint = true;
+    return ui_compositor_init(&display->compositor, width, height, display->tile_rows,
+                              TILED_DISPLAY_BACKGROUND, &display->panel);
+}
+
+uint32_t ui_tiled_display_update(ui_tiled_display_t* display) {
+    if (!display || !display->compositor.bands[0]) return 0;
+    if (display->full_repaint) {
+        ui_compositor_invalidate_all(&display->compositor);
+        display->full_repaint = false;
+    } else {
+        ui_display_list_diff(&display->shown, &display->frame, &display->compositor.damage);
+    }
+
+    uint32_t pixels = ui_compositor_flush(&display->compositor, paint_frame, &display->frame);
+    ui_display_list_snapshot(&display->frame, &display->shown);
+    return pixels;
+}
+
+void ui_tiled_display_sync(ui_tiled_display_t* display) {
+    if (display) ui_compositor_sync(&display->compositor);
+}
+
+uint16_t ui_tiled_display_pixel(const ui_tiled_display_t* display, int16_t x, int16_t y) {
+    uint16_t pixel = TILED_DISPLAY_BACKGROUND;
+    if (!display) return pixel;
+    ui_canvas_t canvas;
+    ui_canvas_init(&canvas, &pixel, ui_rect_t{x, y, 1, 1});
+    ui_display_list_paint(&display->frame, &canvas);
+    return pixel;
+}
@@ -0,0 +1,513 @@
+/*
+ * UI Widgets Implementation
+ * Setters that record damage, incremental layout of marked subtrees and band-culled painting
+ */
+
+#include "ui/ui_widget.h"
+
+#include <string.h>
+
+static const ui_rect_t kEmpty = {0, 0, 0, 0};
+
+static bool rect_equal(ui_rect_t a, ui_rect_t b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+static void copy_text(char* field, const char* text) {
+    strncpy(field, text ? text : "", UI_WIDGET_TEXT_MAX - 1);
+    field[UI_WIDGET_TEXT_MAX - 1] = '\0';
+}
+
+// Construction
+static void widget_init(ui_widget_t* widget, ui_widget_type_t type, ui_rect_t frame) {
+    memset(widget, 0, sizeof(*widget));
+    widget->type = type;
+    widget->frame = frame;
+    widget->visible = true;
+    widget->needs_layout = true;
+}
+
+void ui_widget_box(ui_widget_t* widget, ui_rect_t frame, ui_layout_t layout) {
+    if (!widget) return;
+    widget_init(widget, UI_WIDGET_BOX, frame);
+    widget->layout = layout;
+}
+
+void ui_widget_label(ui_widget_t* widget, ui_rect_t frame, const char* text, uint16_t color, uint8_t size) {
+    if (!widget) return;
+    widget_init(widget, UI_WIDGET_LABEL, frame);
+    copy_text(widget->label.text, text);
+    widget->label.color = color;
+    widget->label.size = size;
+}
+
+void ui_widget_list(ui_widget_t* widget, ui_rect_t frame, int16_t row_h, uint16_t color, uint16_t selected_color) {
+    if (!widget) return;
+    widget_init(widget, UI_WIDGET_LIST, frame);
+    widget->list.selected = -1;
+    widget->list.row_h = row_h;
+    widget->list.color = color;
+    widget->list.selected_color = selected_color;
+}
+
+void ui_widget_progress(ui_widget_t* widget, ui_rect_t frame, uint16_t color, uint16_t fill_color) {
+    if (!widget) return;
+    widget_init(widget, UI_WIDGET_PROGRESS, frame);
+    widget->progress.color = color;
+    widget->progress.fill_color = fill_color;
+}
+
+void ui_widget_image(ui_widget_t* widget, ui_rect_t frame, const uint16_t* pixels, int16_t w, int16_t h,
+                     uint16_t color) {
+    if (!widget) return;
+    widget_init(widget, UI_WIDGET_IMAGE, frame);
+    widget->image.pixels = pixels;
+    widget->image.w = w;
+    widget->image.h = h;
+    widget->image.color = color;
+}
+
+void ui_widget_status_bar(ui_widget_t* widget, ui_rect_t frame, uint16_t color, uint16_t rule_color) {
+    if (!widget) return;
+    widget_init(widget, UI_WIDGET_STATUS_BAR, frame);
+    widget->status.color = color;
+    widget->status.rule_color = rule_color;
+}
+
+void ui_widget_list_view(ui_widget_t* widget, ui_rect_t frame, ui_list_view_t* view) {
+    if (!widget) return;
+    widget_init(widget, UI_WIDGET_LIST_VIEW, frame);
+    widget->list_view = view;
+}
+
+// Marking
+static void mark_ancestors(ui_widget_t* widget) {
+    for (ui_widget_t* p = widget->parent; p && !p->child_dirty; p = p->parent) p->child_dirty = true;
+}
+
+// Its size or visibility changed: the parent places its children again
+static void mark_layout(ui_widget_t* widget) {
+    ui_widget_t* target = widget->parent ? widget->parent : widget;
+    target->needs_layout = true;
+    mark_ancestors(target);
+}
+
+static void add_damage(ui_widget_t* widget, ui_rect_t rect) {
+    // Hidden or not yet placed: the layout covers it when it appears
+    if (ui_rect_is_empty(widget->bounds) || ui_rect_is_empty(rect)) return;
+    ui_rect_t* best = &widget->damage[0];
+    uint32_t best_growth = UINT32_MAX;
+    for (uint32_t i = 0; i < UI_WIDGET_DAMAGE_RECTS; i++) {
+        ui_rect_t* slot = &widget->damage[i];
+        if (ui_rect_is_empty(*slot)) {
+            best = slot;
+            break;
+        }
+        uint32_t growth = ui_rect_area(ui_rect_union(*slot, rect)) - ui_rect_area(*slot);
+        if (growth < best_growth) {
+            best = slot;
+            best_growth = growth;
+        }
+    }
+    *best = ui_rect_union(*best, rect);
+    mark_ancestors(widget);
+}
+
+void ui_widget_invalidate(ui_widget_t* widget) {
+    if (widget) add_damage(widget, widget->bounds);
+}
+
+void ui_widget_add(ui_widget_t* parent, ui_widget_t* child) {
+    if (!parent || !child) return;
+    child->parent = parent;
+    child->next_sibling = NULL;
+    ui_widget_t** link = &parent->first_child;
+    while (*link) link = &(*link)->next_sibling;
+    *link = child;
+    parent->needs_layout = true;
+    mark_ancestors(parent);
+}
+
+// Measuring; a negative size fills the rest of the parent's content
+static ui_rect_t measure(const ui_widget_t* widget) {
+    ui_rect_t size = {0, 0, -1, -1};
+    switch (widget->type) {
+        case UI_WIDGET_LABEL:
+            size = ui_text_bounds(0, 0, widget->label.text, widget->label.size);
+            break;
+        case UI_WIDGET_LIST:
+            size.h = (int16_t)(widget->list.count * widget->list.row_h);
+            break;
+        case UI_WIDGET_IMAGE:
+            size.w = widget->image.w;
+            size.h = widget->image.h;
+            break;
+        case UI_WIDGET_LIST_VIEW:
+            if (widget->list_view) {
+                size.w = widget->list_view->width;
+                size.h = widget->list_view->height;
+            }
+            break;
+        default:
+            break;
+    }
+    if (widget->frame.w > 0) size.w = widget->frame.w;
+    if (widget->frame.h > 0) size.h = widget->frame.h;
+    return size;
+}
+
+// Setters
+void ui_widget_set_visible(ui_widget_t* widget, bool visible) {
+    if (!widget || widget->visible == visible) return;
+    widget->visible = visible;
+    mark_layout(widget);
+}
+
+void ui_widget_set_frame(ui_widget_t* widget, ui_rect_t frame) {
+    if (!widget || rect_equal(widget->frame, frame)) return;
+    widget->frame = frame;
+    mark_layout(widget);
+}
+
+static ui_rect_t status_info_bounds(const ui_widget_t* widget, const char* info) {
+    ui_rect_t text = ui_text_bounds(0, widget->bounds.y, info, 1);
+    text.x = (int16_t)(widget->bounds.x + widget->bounds.w - text.w);
+    return text;
+}
+
+void ui_widget_set_text(ui_widget_t* widget, const char* text) {
+    if (!widget) return;
+    if (!text) text = "";
+    if (widget->type == UI_WIDGET_LABEL) {
+        if (strncmp(widget->label.text, text, UI_WIDGET_TEXT_MAX - 1) == 0) return;
+        const ui_widget_t before = *widget;
+        copy_text(widget->label.text, text);
+        uint8_t size = widget->label.size;
+        add_damage(widget, ui_rect_union(ui_text_bounds(widget->bounds.x, widget->bounds.y, before.label.text, size),
+                                         ui_text_bounds(widget->bounds.x, widget->bounds.y, text, size)));
+        if (!rect_equal(measure(&before), measure(widget))) mark_layout(widget);
+    } else if (widget->type == UI_WIDGET_STATUS_BAR) {
+        if (strncmp(widget->status.title, text, UI_WIDGET_TEXT_MAX - 1) == 0) return;
+        ui_rect_t before = ui_text_bounds(widget->bounds.x, widget->bounds.y, widget->status.title, 2);
+        copy_text(widget->status.title, text);
+        add_damage(widget, ui_rect_union(before, ui_text_bounds(widget->bounds.x, widget->bounds.y, text, 2)));
+    }
+}
+
+void ui_widget_set_info(ui_widget_t* widget, const char* text) {
+    if (!widget || widget->type != UI_WIDGET_STATUS_BAR) return;
+    if (!text) text = "";
+    if (strncmp(widget->status.info, text, UI_WIDGET_TEXT_MAX - 1) == 0) return;
+    ui_rect_t before = status_info_bounds(widget, widget->status.info);
+    copy_text(widget->status.info, text);
+    add_damage(widget, ui_rect_union(before, status_info_bounds(widget, text)));
+}
+
+void ui_widget_set_color(ui_widget_t* widget, uint16_t color) {
+    if (!widget) return;
+    uint16_t* field = NULL;
+    switch (widget->type) {
+        case UI_WIDGET_BOX:        field = &widget->box.color; break;
+        case UI_WIDGET_LABEL:      field = &widget->label.color; break;
+        case UI_WIDGET_LIST:       field = &widget->list.color; break;
+        case UI_WIDGET_PROGRESS:   field = &widget->progress.color; break;
+        case UI_WIDGET_IMAGE:      field = &widget->image.color; break;
+        case UI_WIDGET_STATUS_BAR: field = &widget->status.color; break;
+        case UI_WIDGET_LIST_VIEW:
+            if (widget->list_view) {
+                field = &widget->list_view->color;
+                if (*field != color) ui_list_view_reset(widget->list_view);
+            }
+            break;
+    }
+    if (!field || *field == color) return;
+    *field = color;
+    ui_widget_invalidate(widget);
+}
+
+void ui_widget_set_items(ui_widget_t* widget, const char* const* items, int count) {
+    if (!widget || widget->type != UI_WIDGET_LIST) return;
+    if (widget->list.items == items && widget->list.count == count) return;
+    bool resized = widget->list.count != count;
+    widget->list.items = items;
+    widget->list.count = count;
+    ui_widget_invalidate(widget);
+    if (resized) mark_layout(widget);
+}
+
+static ui_rect_t list_view_row_bounds(const ui_widget_t* widget, uint32_t index) {
+    ui_rect_t row = ui_list_view_row_rect(widget->list_view, index);
+    if (ui_rect_is_empty(row)) return kEmpty;
+    return ui_rect_t{(int16_t)(widget->bounds.x + row.x), (int16_t)(widget->bounds.y + row.y), row.w, row.h};
+}
+
+void ui_widget_list_view_select(ui_widget_t* widget, uint32_t index) {
+    if (!widget || widget->type != UI_WIDGET_LIST_VIEW || !widget->list_view) return;
+    ui_list_view_t* view = widget->list_view;
+    uint32_t before = view->selected;
+    if (ui_list_view_select(view, index)) {
+        ui_widget_invalidate(widget);
+    } else if (view->selected != before) {
+        add_damage(widget, list_view_row_bounds(widget, before));
+        add_damage(widget, list_view_row_bounds(widget, view->selected));
+    }
+    ui_list_view_prefetch(view);
+}
+
+void ui_widget_list_view_scroll(ui_widget_t* widget, uint32_t top) {
+    if (!widget || widget->type != UI_WIDGET_LIST_VIEW || !widget->list_view) return;
+    if (!ui_list_view_scroll_to(widget->list_view, top)) return;
+    ui_widget_invalidate(widget);
+    ui_list_view_prefetch(widget->list_view);
+}
+
+void ui_widget_list_view_reload(ui_widget_t* widget) {
+    if (!widget || widget->type != UI_WIDGET_LIST_VIEW || !widget->list_view) return;
+    ui_list_view_reset(widget->list_view);
+    ui_widget_invalidate(widget);
+}
+
+ui_rect_t ui_widget_list_row_bounds(const ui_widget_t* widget, int row) {
+    if (!widget || widget->type != UI_WIDGET_LIST) return kEmpty;
+    const ui_list_t* list = &widget->list;
+    if (row < 0 || row >= list->count || !list->items) return kEmpty;
+    int16_t top = (int16_t)(widget->bounds.y + row * list->row_h);
+    ui_rect_t marker = {widget->bounds.x, top, list->marker_w, list->marker_h};
+    return ui_rect_union(marker, ui_text_bounds(widget->bounds.x + list->text_x, top + list->text_y,
+                                                list->items[row], 1));
+}
+
+void ui_widget_set_selected(ui_widget_t* widget, int selected) {
+    if (!widget || widget->type != UI_WIDGET_LIST || widget->list.selected == selected) return;
+    add_damage(widget, ui_widget_list_row_bounds(widget, widget->list.selected));
+    widget->list.selected = selected;
+    add_damage(widget, ui_widget_list_row_bounds(widget, selected));
+}
+
+static int16_t progress_fill_width(const ui_widget_t* widget, float value) {
+    if (!(value > 0.0f)) return 0;
+    if (value > 1.0f) value = 1.0f;
+    return (int16_t)(value * (widget->bounds.w - 4));
+}
+
+void ui_widget_set_progress(ui_widget_t* widget, float value) {
+    if (!widget || widget->type != UI_WIDGET_PROGRESS || widget->progress.value == value) return;
+    // Only the stretch between the old and new end of the fill
+    int16_t before = progress_fill_width(widget, widget->progress.value);
+    int16_t after = progress_fill_width(widget, value);
+    widget->progress.value = value;
+    if (before == after) return;
+    int16_t from = before < after ? before : after;
+    add_damage(widget, ui_rect_t{(int16_t)(widget->bounds.x + 2 + from), (int16_t)(widget->bounds.y + 2),
+                                 (int16_t)(before + after - 2 * from), (int16_t)(widget->bounds.h - 4)});
+}
+
+void ui_widget_set_pixels(ui_widget_t* widget, const uint16_t* pixels) {
+    if (!widget || widget->type != UI_WIDGET_IMAGE || widget->image.pixels == pixels) return;
+    widget->image.pixels = pixels;
+    ui_widget_invalidate(widget);
+}
+
+// Layout
+static void update_subtree(ui_tree_t* tree, ui_widget_t* widget);
+
+static void hide_subtree(ui_tree_t* tree, ui_widget_t* widget) {
+    if (!ui_rect_is_empty(widget->bounds)) ui_compositor_invalidate(tree->compositor, widget->bounds);
+    widget->bounds = kEmpty;
+    memset(widget->damage, 0, sizeof(widget->damage));
+    widget->child_dirty = false;
+    widget->needs_layout = true;            // Placed afresh when it shows again
+    for (ui_widget_t* child = widget->first_child; child; child = child->next_sibling) hide_subtree(tree, child);
+}
+
+static void layout_children(ui_tree_t* tree, ui_widget_t* parent) {
+    const int16_t pad = parent->padding;
+    const ui_rect_t content = {(int16_t)(parent->bounds.x + pad), (int16_t)(parent->bounds.y + pad),
+                               (int16_t)(parent->bounds.w - 2 * pad), (int16_t)(parent->bounds.h - 2 * pad)};
+    int16_t cursor = parent->layout == UI_LAYOUT_ROW ? content.x : content.y;
+
+    for (ui_widget_t* child = parent->first_child; child; child = child->next_sibling) {
+        if (!child->visible) {
+            hide_subtree(tree, child);
+            continue;
+        }
+
+        ui_rect_t r = measure(child);
+        r.x = (int16_t)(content.x + child->frame.x);
+        r.y = (int16_t)(content.y + child->frame.y);
+        if (parent->layout == UI_LAYOUT_COLUMN) r.y = (int16_t)(cursor + child->frame.y);
+        if (parent->layout == UI_LAYOUT_ROW) r.x = (int16_t)(cursor + child->frame.x);
+        if (r.w < 0) r.w = (int16_t)(content.x + content.w - r.x);
+        if (r.h < 0) r.h = (int16_t)(content.y + content.h - r.y);
+        if (parent->layout != UI_LAYOUT_ROW && child->align == UI_ALIGN_CENTER) {
+            r.x = (int16_t)(content.x + (content.w - r.w) / 2);
+        } else if (parent->layout != UI_LAYOUT_ROW && child->align == UI_ALIGN_END) {
+            r.x = (int16_t)(content.x + content.w - r.w - child->frame.x);
+        }
+        if (parent->layout == UI_LAYOUT_COLUMN) cursor = (int16_t)(r.y + r.h + parent->spacing);
+        if (parent->layout == UI_LAYOUT_ROW) cursor = (int16_t)(r.x + r.w + parent->spacing);
+
+        tree->stats.layouts++;
+        if (!rect_equal(r, child->bounds)) {
+            // Whatever it showed goes, and it shows in full where it lands
+            ui_compositor_invalidate(tree->compositor, child->bounds);
+            ui_compositor_invalidate(tree->compositor, r);
+            child->bounds = r;
+            memset(child->damage, 0, sizeof(child->damage));
+            child->needs_layout = true;     // Its content moved with it
+            tree->stats.moved++;
+        }
+        update_subtree(tree, child);
+    }
+}
+
+static void update_subtree(ui_tree_t* tree, ui_widget_t* widget) {
+    for (uint32_t i = 0; i < UI_WIDGET_DAMAGE_RECTS; i++) {
+        if (!ui_rect_is_empty(widget->damage[i])) ui_compositor_invalidate(tree->compositor, widget->damage[i]);
+        widget->damage[i] = kEmpty;
+    }
+    bool relayout = widget->needs_layout, below = widget->child_dirty;
+    widget->needs_layout = false;
+    widget->child_dirty = false;
+
+    if (relayout) {
+        layout_children(tree, widget);
+    } else if (below) {
+        for (ui_widget_t* child = widget->first_child; child; child = child->next_sibling) {
+            if (child->visible) update_subtree(tree, child);
+        }
+    }
+}
+
+// Painting
+static int16_t draw_text(ui_canvas_t* canvas, ui_text_cache_t* cache, uint16_t background, int16_t x, int16_t y,
+                         const char* text, uint16_t color, uint8_t size) {
+    if (!text[0]) return x;
+    if (cache) return ui_text_cache_draw(cache, canvas, x, y, text, color, background, size);
+    return ui_canvas_text(canvas, x, y, text, color, size);
+}
+
+// Where it may draw: a label's text can run past a fixed frame
+static ui_rect_t paint_extent(const ui_widget_t* widget) {
+    if (widget->type != UI_WIDGET_LABEL) return widget->bounds;
+    return ui_rect_union(widget->bounds, ui_text_bounds(widget->bounds.x, widget->bounds.y,
+                                                        widget->label.text, widget->label.size));
+}
+
+static void paint_list(ui_canvas_t* canvas, ui_text_cache_t* cache, uint16_t background, const ui_widget_t* widget) {
+    const ui_list_t* list = &widget->list;
+    if (!list->items || list->row_h <= 0) return;
+    // Rows above the band are skipped without looking at them
+    int first = (canvas->rect.y - widget->bounds.y - list->row_h) / list->row_h;
+    if (first < 0) first = 0;
+    for (int i = first; i < list->count; i++) {
+        int16_t top = (int16_t)(widget->bounds.y + i * list->row_h);
+        if (top >= canvas->rect.y + canvas->rect.h) break;
+        uint16_t color = list->color;
+        if (i == list->selected) {
+            ui_canvas_fill_rect(canvas, widget->bounds.x, top, list->marker_w, list->marker_h, list->selected_color);
+            color = list->selected_color;
+        }
+        draw_text(canvas, cache, background, widget->bounds.x + list->text_x, top + list->text_y,
+                  list->items[i], color, 1);
+    }
+}
+
+static void paint_widget(ui_tree_t* tree, ui_canvas_t* canvas, ui_text_cache_t* cache, const ui_widget_t* widget) {
+    const ui_rect_t* b = &widget->bounds;
+    uint16_t background = tree->compositor->background;
+    switch (widget->type) {
+        case UI_WIDGET_BOX:
+            if (widget->box.outlined) ui_canvas_rect(canvas, b->x, b->y, b->w, b->h, widget->box.color);
+            break;
+        case UI_WIDGET_LABEL:
+            draw_text(canvas, cache, background, b->x, b->y, widget->label.text, widget->label.color,
+                      widget->label.size);
+            break;
+        case UI_WIDGET_LIST:
+            paint_list(canvas, cache, background, widget);
+            break;
+        case UI_WIDGET_PROGRESS:
+            ui_canvas_rect(canvas, b->x, b->y, b->w, b->h, widget->progress.color);
+            ui_canvas_fill_rect(canvas, b->x + 2, b->y + 2, progress_fill_width(widget, widget->progress.value),
+                                b->h - 4, widget->progress.fill_color);
+            break;
+        case UI_WIDGET_IMAGE:
+            if (widget->image.pixels) {
+                ui_canvas_rgb_bitmap(canvas, b->x, b->y, widget->image.pixels, widget->image.w, widget->image.h);
+            } else {
+                ui_canvas_rect(canvas, b->x, b->y, b->w, b->h, widget->image.color);
+            }
+            break;
+        case UI_WIDGET_STATUS_BAR: {
+            draw_text(canvas, cache, background, b->x, b->y, widget->status.title, widget->status.color, 2);
+            ui_rect_t info = status_info_bounds(widget, widget->status.info);
+            draw_text(canvas, cache, background, info.x, info.y, widget->status.info, widget->status.color, 1);
+            ui_canvas_hline(canvas, b->x, b->y + b->h - 1, b->w, widget->status.rule_color);
+            break;
+        }
+        case UI_WIDGET_LIST_VIEW:
+            ui_list_view_paint(widget->list_view, canvas, b->x, b->y);
+            break;
+    }
+    tree->stats.paints++;
+    tree->stats.last_paints++;
+}
+
+static void paint_subtree(ui_tree_t* tree, ui_canvas_t* canvas, ui_text_cache_t* cache, const ui_widget_t* widget) {
+    if (!widget->visible || ui_rect_is_empty(widget->bounds)) return;
+    // A band paints only the widgets it crosses; children may lie outside a container
+    if (!ui_rect_is_empty(ui_rect_intersect(paint_extent(widget), canvas->rect))) {
+        paint_widget(tree, canvas, cache, widget);
+    }
+    // Text over a picture can't come from runs cut against the background
+    if (widget->type == UI_WIDGET_IMAGE && widget->image.pixels) cache = NULL;
+    for (const ui_widget_t* child = widget->first_child; child; child = child->next_sibling) {
+        paint_subtree(tree, canvas, cache, child);
+    }
+}
+
+static void paint_tree(ui_canvas_t* canvas, void* user_data) {
+    ui_tree_t* tree = (ui_tree_t*)user_data;
+    paint_subtree(tree, canvas, tree->text_cache, tree->root);
+}
+
+// Tree
+void ui_tree_init(ui_tree_t* tree, ui_widget_t* root, ui_compositor_t* compositor, ui_text_cache_t* text_cache) {
+    if (!tree) return;
+    memset(tree, 0, sizeof(*tree));
+    tree->root = root;
+    tree->compositor = compositor;
+    tree->text_cache = text_cache;
+}
+
+uint32_t ui_tree_update(ui_tree_t* tree) {
+    if (!tree || !tree->root || !tree->compositor) return 0;
+    ui_widget_t* root = tree->root;
+    ui_rect_t bounds = root->visible ? root->frame : kEmpty;
+    if (!rect_equal(bounds, root->bounds)) {
+        ui_compositor_invalidate(tree->compositor, root->bounds);
+        ui_compositor_invalidate(tree->compositor, bounds);
+        root->bounds = bounds;
+        root->needs_layout = true;
+    }
+    if (root->visible) {
+        update_subtree(tree, root);
+    } else {
+        hide_subtree(tree, root);
+    }
+
+    tree->stats.last_paints = 0;
+    uint32_t pixels = ui_compositor_flush(tree->compositor, paint_tree, tree);
+    if (pixels) tree->stats.updates++;
+    tree->stats.last_pixels = pixels;
+    return pixels;
+}
+
+void ui_tree_get_stats(const ui_tree_t* tree, ui_tree_stats_t* stats) {
+    if (tree && stats) *stats = tree->stats;
+}
+
+void ui_tree_reset_stats(ui_tree_t* tree) {
+    if (tree) memset(&tree->stats, 0, sizeof(tree->stats));
+}
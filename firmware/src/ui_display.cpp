@@ -4,10 +4,29 @@
 static Adafruit_ST7789* s_display = nullptr;
 static SemaphoreHandle_t* s_mutex = nullptr;
 
-static const int kWidth = 240;
-static const int kHeight = 280;
+// Screens draw through the compositor, which sends only what changed
+static ui_compositor_t s_compositor;
+static ui_screens_t s_screens;
+static ui_screen_model_t s_model;       // Next state to show, built from the app state
+
+static void pushToPanel(const ui_rect_t* rect, const uint16_t* pixels, void* user) {
+    (void)user;
+    s_display->startWrite();
+    s_display->setAddrWindow(rect->x, rect->y, rect->w, rect->h);
+    s_display->writePixels((uint16_t*)pixels, (uint32_t)rect->w * rect->h);
+    s_display->endWrite();
+}
 
 void uiInit(Adafruit_ST7789* d, SemaphoreHandle_t* mtx) {
+    // After setRotation(), so the compositor sees the landscape panel
+    const ui_panel_t panel = {pushToPanel, nullptr, nullptr};
+    if (!ui_compositor_init(&s_compositor, d->width(), d->height(), UI_COMPOSITOR_BAND_ROWS,
+                            UI_COLOR_BG, &panel)) {
+        Serial.println("UI: no memory for the compositor band");
+        return;
+    }
+    ui_screens_init(&s_screens, &s_compositor);
+    memset(&s_model, 0, sizeof(s_model));
     s_display = d;
     s_mutex = mtx;
 }
@@ -19,155 +38,72 @@ static void withLock(std::function<void()> fn) {
     xSemaphoreGive(*s_mutex);
 }
 
+// A new screen starts without the previous one's toast, as a full redraw used to
+static void setScreen(ui_screen_id_t screen) {
+    if (s_model.screen != screen) s_model.toast[0] = '\0';
+    s_model.screen = screen;
+}
+
+static void updateNowPlayingModel() {
+    ui_screens_set_text(s_model.title, appGetCurrentTrackTitle());
+    ui_screens_set_text(s_model.artist, appGetCurrentTrackArtist());
+    s_model.duration_s = appGetCurrentTrackDurationSec();
+    s_model.elapsed_s = appGetNowPlayingSeconds();
+    s_model.progress = appGetNowPlayingProgress();
+}
+
 void uiDrawHome() {
     withLock([](){
-        s_display->fillScreen(UI_COLOR_BG);
-        s_display->setTextColor(UI_COLOR_FG);
-        s_display->setTextSize(2);
-        s_display->setCursor(10, 10);
-        s_display->println("Home");
-        s_display->drawFastHLine(10, 35, 220, UI_COLOR_HI);
-
-        static const char* items[] = {"Music", "RFID", "Settings"};
-        int count = 3;
-        int sel = appGetMenuSelected();
-        int y = 50;
-        for (int i = 0; i < count; i++) {
-            if (i == sel) {
-                s_display->fillRect(8, y - 2, 224, 20, UI_COLOR_ACCENT);
-                s_display->setTextColor(UI_COLOR_BG);
-            } else {
-                s_display->setTextColor(UI_COLOR_FG);
-            }
-            s_display->setTextSize(1);
-            s_display->setCursor(12, y);
-            s_display->println(items[i]);
-            y += 22;
-        }
-        s_display->drawRect(150, 50, 80, 80, UI_COLOR_FG);
-        s_display->setCursor(160, 88);
-        s_display->setTextColor(UI_COLOR_FG);
-        s_display->setTextSize(1);
-        s_display->println("menu");
+        setScreen(UI_SCREEN_HOME);
+        s_model.selected = appGetMenuSelected();
+        ui_screens_show(&s_screens, &s_model);
     });
 }
 
 void uiDrawMusic() {
     withLock([](){
-        s_display->fillScreen(UI_COLOR_BG);
-        s_display->setTextColor(UI_COLOR_FG);
-        s_display->setTextSize(2);
-        s_display->setCursor(10, 10);
-        s_display->println("Music");
-        s_display->drawFastHLine(10, 35, 220, UI_COLOR_HI);
-
-        static const char* items[] = {"Now Playing", "Artists", "Albums", "Songs"};
-        int count = 4;
-        int sel = appGetMenuSelected();
-        int y = 50;
-        for (int i = 0; i < count; i++) {
-            if (i == sel) {
-                s_display->fillRect(8, y - 2, 224, 20, UI_COLOR_ACCENT);
-                s_display->setTextColor(UI_COLOR_BG);
-            } else {
-                s_display->setTextColor(UI_COLOR_FG);
-            }
-            s_display->setTextSize(1);
-            s_display->setCursor(12, y);
-            s_display->println(items[i]);
-            y += 22;
-        }
-        s_display->drawRect(150, 50, 80, 80, UI_COLOR_FG);
-        s_display->setCursor(155, 88);
-        s_display->setTextColor(UI_COLOR_FG);
-        s_display->setTextSize(1);
-        s_display->println("artwork");
+        setScreen(UI_SCREEN_MUSIC);
+        s_model.selected = appGetMenuSelected();
+        ui_screens_show(&s_screens, &s_model);
     });
 }
 
 void uiDrawNowPlayingFull() {
     withLock([](){
-        s_display->fillScreen(UI_COLOR_BG);
-        s_display->setTextColor(UI_COLOR_FG);
-        s_display->setTextSize(2);
-        s_display->setCursor(10, 10);
-        s_display->println("Now Playing");
-        s_display->drawFastHLine(10, 35, 220, UI_COLOR_HI);
-
-        s_display->drawRect(10, 50, 100, 100, UI_COLOR_FG);
-        s_display->setCursor(25, 98);
-        s_display->setTextSize(1);
-        s_display->println("artwork");
-
-        s_display->setTextSize(1);
-        s_display->setCursor(120, 60);
-        s_display->println(appGetCurrentTrackTitle());
-        s_display->setCursor(120, 75);
-        s_display->println(appGetCurrentTrackArtist());
-
-        s_display->drawRect(10, 170, 220, 12, UI_COLOR_FG);
-
-        // Duration at right
-        int dur = appGetCurrentTrackDurationSec();
-        int mm = dur / 60, ss = dur % 60;
-        s_display->setCursor(200, 190);
-        char buf[8]; snprintf(buf, sizeof(buf), "%02d:%02d", mm, ss);
-        s_display->print(buf);
+        setScreen(UI_SCREEN_NOW_PLAYING);
+        updateNowPlayingModel();
+        ui_screens_show(&s_screens, &s_model);
     });
-    uiUpdateNowPlayingProgress();
 }
 
 void uiUpdateNowPlayingProgress() {
     withLock([](){
-        int secs = appGetNowPlayingSeconds();
-        int prog = (secs % appGetCurrentTrackDurationSec()) * (220 - 4) / max(1, appGetCurrentTrackDurationSec());
-        s_display->fillRect(12, 172, 216, 8, UI_COLOR_BG);
-        s_display->fillRect(12, 172, prog, 8, UI_COLOR_HI);
-        s_display->fillRect(10, 188, 60, 12, UI_COLOR_BG);
-        s_display->setTextColor(UI_COLOR_FG);
-        s_display->setTextSize(1);
-        s_display->setCursor(10, 190);
-        s_display->printf("%02d:%02d", secs / 60, secs % 60);
+        if (s_model.screen != UI_SCREEN_NOW_PLAYING) return;
+        s_model.elapsed_s = appGetNowPlayingSeconds();
+        s_model.progress = appGetNowPlayingProgress();
+        ui_screens_show(&s_screens, &s_model);
     });
 }
 
 void uiToast(const char* msg) {
     withLock([&](){
-        s_display->fillRect(10, 38, 220, 12, UI_COLOR_BG);
-        s_display->setTextColor(UI_COLOR_HI);
-        s_display->setTextSize(1);
-        s_display->setCursor(10, 38);
-        s_display->print(msg);
+        ui_screens_set_text(s_model.toast, msg);
+        ui_screens_show(&s_screens, &s_model);
     });
 }
 
+int uiMenuItemCount() {
+    return ui_screens_menu_count(appGetMenuLevel() == 0 ? UI_SCREEN_HOME : UI_SCREEN_MUSIC);
+}
+
 void uiShowSplash(const char* company, const char* fwName, const char* fwVersion, const char* badgeText, uint16_t badgeColor) {
     withLock([&](){
-        s_display->fillScreen(UI_COLOR_BG);
-        // Company (logo placeholder)
-        s_display->setTextColor(UI_COLOR_FG);
-        s_display->setTextSize(2);
-        int cx = 20, cy = 40;
-        s_display->setCursor(cx, cy);
-        s_display->print(company);
-
-        // Firmware name
-        s_display->setTextSize(2);
-        s_display->setCursor(20, cy + 40);
-        s_display->print(fwName);
-
-        // Version
-        s_display->setTextSize(1);
-        s_display->setCursor(20, cy + 65);
-        s_display->print("Version: ");
-        s_display->print(fwVersion);
-
-        // Badge (optional)
-        if (badgeText && badgeText[0]) {
-            s_display->setTextColor(badgeColor);
-            s_display->setTextSize(1);
-            s_display->setCursor(20, cy + 85);
-            s_display->print(badgeText);
-        }
+        setScreen(UI_SCREEN_SPLASH);
+        ui_screens_set_text(s_model.company, company);
+        ui_screens_set_text(s_model.firmware, fwName);
+        ui_screens_set_text(s_model.version, fwVersion);
+        ui_screens_set_text(s_model.badge, badgeText);
+        s_model.badge_color = badgeColor;
+        ui_screens_show(&s_screens, &s_model);
     });
 }
@@ -4,12 +4,7 @@
 #include <Adafruit_ST7789.h>
 #include "freertos/semphr.h"
 #include "app_state.h"
-
-// Colors
-#define UI_COLOR_BG      0x0000
-#define UI_COLOR_FG      0xFFFF
-#define UI_COLOR_HI      0x07E0
-#define UI_COLOR_ACCENT  0xFBE0
+#include "ui/ui_screens.h"     // Colors, layouts and the compositor behind them
 
 void uiInit(Adafruit_ST7789* d, SemaphoreHandle_t* mtx);
 
@@ -0,0 +1,75 @@
+/*
+ * Audio Analyzer Benchmark
+ * Cost of one spectrum (window, FFT, band folding) per FFT size, and of the
+ * per-block capture tap at 44.1 kHz stereo
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include "audio/audio_analyzer.h"
+
+#define BENCH_RATE          44100
+#define BENCH_BLOCK_FRAMES  256
+#define BENCH_SPECTRA       5000
+
+static int16_t g_block[BENCH_BLOCK_FRAMES * 2];
+static const uint32_t k_fft_sizes[] = { 256, 512, 1024 };
+
+void setUp(void) {
+    for (int i = 0; i < BENCH_BLOCK_FRAMES; i++) {
+        int16_t s = (int16_t)(12000.0 * sin(0.0007 * i * i));
+        g_block[i * 2] = s;
+        g_block[i * 2 + 1] = (int16_t)(s / 2);  // Not -s: the mono downmix would cancel
+    }
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+void bench_analyzer_fft_sizes(void) {
+    for (uint32_t size : k_fft_sizes) {
+        audio_analyzer_t an = {};
+        TEST_ASSERT_TRUE(audio_analyzer_init(&an, BENCH_RATE, size, 2));
+        for (uint32_t i = 0; i < size * 2 / BENCH_BLOCK_FRAMES; i++) {
+            audio_analyzer_feed(&an, g_block, BENCH_BLOCK_FRAMES);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCH_SPECTRA; i++) audio_analyzer_analyze(&an);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double per_frame_us = secs * 1e6 / BENCH_SPECTRA;
+
+        audio_analyzer_frame_t frame;
+        audio_analyzer_read(&an, &frame);
+        printf("fft %4u points  %8.2f us per spectrum  (%.4f%% CPU at %d Hz) [chk %.3f]\n",
+               (unsigned)size, per_frame_us, per_frame_us * AUDIO_ANALYZER_RATE_HZ / 1e4,
+               AUDIO_ANALYZER_RATE_HZ, frame.bands[10]);
+        audio_analyzer_deinit(&an);
+    }
+}
+
+void bench_analyzer_tap(void) {
+    // Capture and metering on every block, with the spectra it triggers
+    audio_analyzer_t an = {};
+    TEST_ASSERT_TRUE(audio_analyzer_init(&an, BENCH_RATE, AUDIO_ANALYZER_DEFAULT_FFT, 2));
+    const uint32_t seconds = 60;
+    const uint32_t blocks = BENCH_RATE * seconds / BENCH_BLOCK_FRAMES;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < blocks; i++) audio_analyzer_feed(&an, g_block, BENCH_BLOCK_FRAMES);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("tap + %d spectra/s  %9.6f CPU s/audio s (%6.0fx realtime) [%u published]\n",
+           AUDIO_ANALYZER_RATE_HZ, secs / seconds, seconds / secs, (unsigned)an.published);
+    audio_analyzer_deinit(&an);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_analyzer_fft_sizes);
+    RUN_TEST(bench_analyzer_tap);
+
+    return UNITY_END();
+}
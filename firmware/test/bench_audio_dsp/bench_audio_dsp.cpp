@@ -0,0 +1,84 @@
+/*
+ * Audio DSP Kernel Benchmark
+ * Samples per second for each kernel on the host, next to the per-sample
+ * divide it replaces
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "audio/audio_dsp.h"
+
+#define BENCH_BLOCK_SAMPLES 512             // One engine block of stereo frames
+#define BENCH_TOTAL_SAMPLES (256u * 1024u * 1024u)
+
+static int16_t g_s16[BENCH_BLOCK_SAMPLES];
+static int16_t g_out[BENCH_BLOCK_SAMPLES * 2];
+static uint8_t g_bytes[BENCH_BLOCK_SAMPLES * 4];
+static int32_t g_s32[BENCH_BLOCK_SAMPLES];
+static float g_f32[BENCH_BLOCK_SAMPLES];
+
+void setUp(void) {
+    for (int i = 0; i < BENCH_BLOCK_SAMPLES; i++) {
+        g_s16[i] = (int16_t)(i * 97);
+        g_s32[i] = (int32_t)((uint32_t)i * 6361u * 1024u);
+        g_f32[i] = (float)(i - BENCH_BLOCK_SAMPLES / 2) / BENCH_BLOCK_SAMPLES;
+    }
+    for (int i = 0; i < BENCH_BLOCK_SAMPLES * 4; i++) g_bytes[i] = (uint8_t)(i * 13);
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+// Runs fn over BENCH_TOTAL_SAMPLES samples in engine-sized blocks and prints the rate
+template <typename Fn>
+static void bench_kernel(const char* name, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    int64_t checksum = 0;
+    for (uint32_t done = 0; done < BENCH_TOTAL_SAMPLES; done += BENCH_BLOCK_SAMPLES) {
+        fn();
+        checksum += g_out[done & (BENCH_BLOCK_SAMPLES - 1)];
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double rate = BENCH_TOTAL_SAMPLES / secs;
+    printf("%-22s %8.1f Msamples/s (%6.0fx realtime stereo @44.1k) [chk %lld]\n",
+           name, rate / 1e6, rate / (44100.0 * 2), (long long)checksum);
+}
+
+void bench_dsp_gain(void) {
+    volatile int volume_percent = 70;
+    bench_kernel("gain divide (legacy)", [&]() {
+        int volume = volume_percent;
+        for (int i = 0; i < BENCH_BLOCK_SAMPLES; i++) g_out[i] = (int16_t)((g_s16[i] * volume) / 100);
+    });
+    int32_t gain = audio_dsp_gain_from_percent(70);
+    bench_kernel("gain q15", [&]() { audio_dsp_gain_q15_copy(g_s16, g_out, BENCH_BLOCK_SAMPLES, gain); });
+    int32_t boost = audio_dsp_gain_from_db(9.0f);
+    bench_kernel("gain q15 boost", [&]() { audio_dsp_gain_q15_copy(g_s16, g_out, BENCH_BLOCK_SAMPLES, boost); });
+}
+
+void bench_dsp_layout(void) {
+    bench_kernel("upmix mono", []() { audio_dsp_upmix_mono(g_s16, g_out, BENCH_BLOCK_SAMPLES / 2); });
+    bench_kernel("downmix to mono", []() { audio_dsp_downmix_to_mono(g_s16, g_out, BENCH_BLOCK_SAMPLES / 2); });
+    bench_kernel("mix saturate", []() { audio_dsp_mix_sat(g_out, g_s16, BENCH_BLOCK_SAMPLES); });
+    bench_kernel("saturate s32", []() { audio_dsp_saturate_s32(g_s32, g_out, BENCH_BLOCK_SAMPLES, 12); });
+}
+
+void bench_dsp_conversion(void) {
+    bench_kernel("u8 to s16", []() { audio_dsp_u8_to_s16(g_bytes, g_out, BENCH_BLOCK_SAMPLES); });
+    bench_kernel("s24le to s16", []() { audio_dsp_s24le_to_s16(g_bytes, g_out, BENCH_BLOCK_SAMPLES); });
+    bench_kernel("s32 to s16", []() { audio_dsp_s32_to_s16(g_s32, g_out, BENCH_BLOCK_SAMPLES); });
+    bench_kernel("f32 to s16", []() { audio_dsp_f32_to_s16(g_f32, g_out, BENCH_BLOCK_SAMPLES); });
+    bench_kernel("s16 to f32", []() { audio_dsp_s16_to_f32(g_s16, g_f32, BENCH_BLOCK_SAMPLES); });
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_dsp_gain);
+    RUN_TEST(bench_dsp_layout);
+    RUN_TEST(bench_dsp_conversion);
+
+    return UNITY_END();
+}
@@ -0,0 +1,73 @@
+/*
+ * Audio Equalizer Benchmark
+ * CPU cost of the biquad cascade at 44.1 kHz stereo, per active stage count
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <chrono>
+#include "audio/audio_eq.h"
+
+#define BENCH_RATE          44100
+#define BENCH_BLOCK_FRAMES  256             // One engine block
+#define BENCH_AUDIO_SECONDS 30
+
+static audio_eq_t g_eq;
+static int16_t g_source[BENCH_BLOCK_FRAMES * 2];
+static int16_t g_block[BENCH_BLOCK_FRAMES * 2];
+static int64_t g_checksum;
+
+void setUp(void) {
+    for (int i = 0; i < BENCH_BLOCK_FRAMES; i++) {
+        int16_t s = (int16_t)(6000.0 * sin(0.0007 * i * i));
+        g_source[i * 2] = s;
+        g_source[i * 2 + 1] = (int16_t)-s;
+    }
+    audio_eq_init(&g_eq, BENCH_RATE);
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+// CPU seconds per second of audio with the given settings
+static double bench_cost(void) {
+    const uint32_t blocks = BENCH_RATE * BENCH_AUDIO_SECONDS / BENCH_BLOCK_FRAMES;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t b = 0; b < blocks; b++) {
+        memcpy(g_block, g_source, sizeof(g_block));
+        audio_eq_process(&g_eq, g_block, BENCH_BLOCK_FRAMES);
+        g_checksum += g_block[b & (BENCH_BLOCK_FRAMES - 1)];
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return secs / BENCH_AUDIO_SECONDS;
+}
+
+void bench_eq_per_band(void) {
+    double flat = bench_cost();
+    printf("flat (bypass)        %9.6f CPU s/audio s\n", flat);
+
+    float bands[AUDIO_EQ_BANDS] = {};
+    for (int active = 1; active <= AUDIO_EQ_BANDS; active++) {
+        bands[active - 1] = (active & 1) ? 4.0f : -4.0f;
+        audio_eq_set_bands(&g_eq, bands, AUDIO_EQ_BANDS);
+        double cost = bench_cost();
+        printf("%2d bands             %9.6f CPU s/audio s  (%.3f%% CPU per band)\n",
+               active, cost, (cost - flat) * 100.0 / active);
+    }
+    audio_eq_set_bass(&g_eq, 6.0f);
+    audio_eq_set_treble(&g_eq, 3.0f);
+    double full = bench_cost();
+    printf("10 bands + 2 shelves %9.6f CPU s/audio s (%6.0fx realtime) [chk %lld]\n",
+           full, 1.0 / full, (long long)g_checksum);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_eq_per_band);
+
+    return UNITY_END();
+}
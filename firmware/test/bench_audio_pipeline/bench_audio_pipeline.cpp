@@ -0,0 +1,426 @@
+/*
+ * Audio Pipeline Benchmark
+ * Every stage of the playback path over one fixed corpus: card read, WAV
+ * decode, FLAC decode, MP3 decode, gain, resample, EQ and I2S packing, then
+ * the whole engine with one and with two decoders running through a
+ * crossfade. Each stage reports throughput, CPU seconds per audio second and
+ * p50/p99/max time per engine block. Builds for the host (pio test -e
+ * native-bench) and for the device (pio test -e esp32-bench), where the same
+ * table is printed over serial.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "audio/audio_decoder.h"
+#include "audio/audio_dsp.h"
+#include "audio/audio_engine.h"
+#include "audio/audio_eq.h"
+#include "audio/audio_resampler.h"
+#include "audio/audio_ring_buffer.h"
+#include "hal/hal_storage.h"
+#include "hal/hal_system.h"
+#include "../flac_test_encoder.h"
+#include "../wav_test_writer.h"
+
+#ifdef PLATFORM_ESP32
+#include <Arduino.h>
+#include <SPI.h>
+#include <SD.h>
+#include "hardware_config.h"
+#ifndef IZOD_BENCH_SD_CS
+#define IZOD_BENCH_SD_CS SS
+#endif
+#else
+#include <chrono>
+#include <string>
+#include <filesystem>
+#endif
+
+#define BENCH_RATE              44100
+#define BENCH_AUDIO_SECONDS     5
+#define BENCH_CORPUS_FRAMES     (BENCH_RATE * BENCH_AUDIO_SECONDS)
+#define BENCH_BLOCK_FRAMES      AUDIO_ENGINE_BLOCK_FRAMES
+#define BENCH_MAX_BLOCKS        4096
+#define BENCH_RESAMPLE_FROM     48000       // The corpus stands in for a 48 kHz source
+#define BENCH_CORPUS_WAV        "/bench/corpus.wav"
+#define BENCH_CORPUS_FLAC       "/bench/corpus.flac"
+#define BENCH_CROSSFADE_MS      3000
+#define BENCH_CORPUS_MP3        "/bench/corpus.mp3"     // Copied to the card by hand
+
+// Timestamps: CPU cycles on the device, nanoseconds on the host. Only
+// differences within one block are taken, so 32-bit wraparound is harmless.
+#ifdef PLATFORM_ESP32
+static inline uint32_t bench_ticks(void) { return ESP.getCycleCount(); }
+static double bench_ticks_per_us(void) { return getCpuFrequencyMhz(); }
+#else
+static inline uint32_t bench_ticks(void) {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static double bench_ticks_per_us(void) { return 1000.0; }
+#endif
+
+// One stage's measurements
+typedef struct {
+    uint32_t blocks;
+    uint64_t ticks;
+    uint64_t bytes;             // Input consumed, 0 when throughput is not meaningful
+    uint64_t frames;            // Audio frames processed, at the stage's input rate
+    uint32_t rate;
+    int64_t checksum;
+} bench_stage_t;
+
+static int16_t* g_corpus;       // BENCH_CORPUS_FRAMES stereo frames
+static uint32_t* g_block_ticks; // Per-block time of the stage being measured
+static int16_t g_block[BENCH_BLOCK_FRAMES * 2];
+static int16_t g_work[BENCH_BLOCK_FRAMES * 2];
+static double g_wav_path_cost;  // Sum of CPU s/audio s along the WAV playback path
+
+static void stage_begin(bench_stage_t* st, uint32_t rate) {
+    memset(st, 0, sizeof(*st));
+    st->rate = rate;
+}
+
+static inline void stage_block(bench_stage_t* st, uint32_t start) {
+    uint32_t t = bench_ticks() - start;
+    if (st->blocks < BENCH_MAX_BLOCKS) g_block_ticks[st->blocks++] = t;
+    st->ticks += t;
+}
+
+static int compare_ticks(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// Prints one row and returns its CPU seconds per audio second
+static double stage_report(const char* name, bench_stage_t* st) {
+    TEST_ASSERT_GREATER_THAN(0, st->blocks);
+    qsort(g_block_ticks, st->blocks, sizeof(uint32_t), compare_ticks);
+    const double per_us = bench_ticks_per_us();
+    const double secs = st->ticks / per_us / 1e6;
+    const double audio_secs = (double)st->frames / st->rate;
+    const double cost = secs / audio_secs;
+
+    char throughput[16] = "      -";
+    if (st->bytes) snprintf(throughput, sizeof(throughput), "%7.2f", st->bytes / secs / 1e6);
+    printf("%-12s %s MB/s %9.6f CPU s/audio s  block p50 %8.2f  p99 %8.2f  max %8.2f us [chk %lld]\n",
+           name, throughput, cost, g_block_ticks[st->blocks / 2] / per_us,
+           g_block_ticks[st->blocks * 99 / 100] / per_us, g_block_ticks[st->blocks - 1] / per_us,
+           (long long)st->checksum);
+    return cost;
+}
+
+// Two tones and a little noise: enough detail that no stage sees silence
+static void make_corpus(void) {
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < BENCH_CORPUS_FRAMES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float t = (float)i / BENCH_RATE;
+        float s = 9000.0f * sinf(2.0f * (float)M_PI * 220.0f * t) + 4000.0f * sinf(2.0f * (float)M_PI * 3100.0f * t);
+        int16_t noise = (int16_t)((seed >> 16) & 0x3FF) - 512;
+        g_corpus[i * 2] = (int16_t)(s + noise);
+        g_corpus[i * 2 + 1] = (int16_t)(s * 0.7f - noise);
+    }
+}
+
+static bool write_corpus_wav(void) {
+    const uint32_t data_bytes = BENCH_CORPUS_FRAMES * 4;
+    wav_test_format_t format;
+    format.rate = BENCH_RATE;
+    const std::vector<uint8_t> h = wav_test_header(format, data_bytes);
+
+    hal_storage_create_dir("/bench");
+    hal_storage_file_t f = hal_storage_open(BENCH_CORPUS_WAV, HAL_STORAGE_MODE_WRITE);
+    if (!f) return false;
+    bool ok = hal_storage_write(f, h.data(), h.size()) == h.size() &&
+              hal_storage_write(f, g_corpus, data_bytes) == data_bytes;
+    hal_storage_close(f);
+    return ok;
+}
+
+// The corpus through the test encoder with the usual settings: LPC order 8,
+// mid/side, 4096-sample blocks
+static bool write_corpus_flac(void) {
+    std::vector<int32_t> samples(g_corpus, g_corpus + BENCH_CORPUS_FRAMES * 2);
+    std::vector<uint8_t> flac = flac_test_encode(samples.data(), BENCH_CORPUS_FRAMES, 2, 16, BENCH_RATE);
+    hal_storage_file_t f = hal_storage_open(BENCH_CORPUS_FLAC, HAL_STORAGE_MODE_WRITE);
+    if (!f) return false;
+    bool ok = hal_storage_write(f, flac.data(), flac.size()) == flac.size();
+    hal_storage_close(f);
+    return ok;
+}
+
+// Decodes a card file block by block through its registered decoder
+static bool bench_decode_file(const char* name, const char* path, double* cost) {
+    audio_source_t source;
+    audio_source_file(&source, path);
+    const audio_decoder_ops_t* ops = audio_decoder_find(&source);
+    if (!ops) return false;
+    void* state = hal_system_malloc(ops->state_size);
+    TEST_ASSERT_NOT_NULL(state);
+    memset(state, 0, ops->state_size);
+
+    audio_stream_info_t info = {};
+    bench_stage_t st;
+    uint32_t start = bench_ticks();
+    bool opened = ops->open(state, &source, &info);
+    if (opened) {
+        stage_begin(&st, info.sample_rate);
+        st.bytes = hal_storage_get_file_size(path);
+        stage_block(&st, start);            // Open (headers, index) counts as the first block
+        for (;;) {
+            start = bench_ticks();
+            uint32_t got = ops->decode(state, g_block, BENCH_BLOCK_FRAMES);
+            if (got == 0) break;
+            stage_block(&st, start);
+            st.frames += got;
+            st.checksum += g_block[(got - 1) * 2];
+        }
+        ops->close(state);
+        *cost = stage_report(name, &st);
+    }
+    hal_system_free(state);
+    return opened;
+}
+
+void setUp(void) {
+#ifndef PLATFORM_ESP32
+    std::string root = (std::filesystem::temp_directory_path() / "izod_bench_audio_pipeline").string();
+    hal_storage_host_set_root(root.c_str());
+#endif
+    hal_storage_init();
+}
+
+void tearDown(void) {
+    hal_storage_delete_file(BENCH_CORPUS_WAV);
+    hal_storage_delete_file(BENCH_CORPUS_FLAC);
+    hal_storage_deinit();
+}
+
+void bench_pipeline_card_and_decode(void) {
+    if (!hal_storage_is_mounted() || !write_corpus_wav()) {
+        printf("card read / wav decode: no card, skipped\n");
+        return;
+    }
+
+    // Card read: the 1 KB reads the WAV decoder issues for one 16-bit stereo block
+    bench_stage_t st;
+    stage_begin(&st, BENCH_RATE);
+    hal_storage_file_t f = hal_storage_open(BENCH_CORPUS_WAV, HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_NOT_NULL(f);
+    for (;;) {
+        uint32_t start = bench_ticks();
+        size_t got = hal_storage_read(f, g_block, sizeof(g_block));
+        if (got == 0) break;
+        stage_block(&st, start);
+        st.bytes += got;
+        st.checksum += g_block[0];
+    }
+    hal_storage_close(f);
+    st.frames = st.bytes / 4;
+    g_wav_path_cost += stage_report("card read", &st);
+
+    double cost = 0.0;
+    TEST_ASSERT_TRUE(bench_decode_file("wav decode", BENCH_CORPUS_WAV, &cost));
+    g_wav_path_cost += cost;
+
+    TEST_ASSERT_TRUE(write_corpus_flac());
+    TEST_ASSERT_TRUE(bench_decode_file("flac decode", BENCH_CORPUS_FLAC, &cost));
+
+#if AUDIO_DECODER_MP3
+    if (!hal_storage_file_exists(BENCH_CORPUS_MP3) || !bench_decode_file("mp3 decode", BENCH_CORPUS_MP3, &cost)) {
+        printf("mp3 decode: copy an MP3 to %s on the card to measure it\n", BENCH_CORPUS_MP3);
+    }
+#else
+    printf("mp3 decode: no MP3 decoder in this build\n");
+#endif
+}
+
+void bench_pipeline_dsp(void) {
+    bench_stage_t st;
+    const uint32_t blocks = BENCH_CORPUS_FRAMES / BENCH_BLOCK_FRAMES;
+
+    // Gain: volume applied while copying out of the decode block
+    const int32_t gain = audio_dsp_gain_from_percent(70);
+    stage_begin(&st, BENCH_RATE);
+    for (uint32_t b = 0; b < blocks; b++) {
+        const int16_t* in = g_corpus + b * BENCH_BLOCK_FRAMES * 2;
+        uint32_t start = bench_ticks();
+        audio_dsp_gain_q15_copy(in, g_block, BENCH_BLOCK_FRAMES * 2, gain);
+        stage_block(&st, start);
+        st.checksum += g_block[b & (BENCH_BLOCK_FRAMES - 1)];
+    }
+    st.frames = (uint64_t)blocks * BENCH_BLOCK_FRAMES;
+    st.bytes = st.frames * 4;
+    g_wav_path_cost += stage_report("gain", &st);
+
+    // Resample 48 kHz to the output rate, one output block at a time
+    static audio_resampler_t rs;
+    memset(&rs, 0, sizeof(rs));
+    TEST_ASSERT_TRUE(audio_resampler_init(&rs, BENCH_RESAMPLE_FROM, BENCH_RATE, AUDIO_RESAMPLER_QUALITY_DEFAULT));
+    stage_begin(&st, BENCH_RESAMPLE_FROM);
+    uint32_t in_pos = 0;
+    while (in_pos < BENCH_CORPUS_FRAMES) {
+        uint32_t consumed = 0;
+        uint32_t start = bench_ticks();
+        uint32_t got = audio_resampler_process(&rs, g_corpus + in_pos * 2, BENCH_CORPUS_FRAMES - in_pos, &consumed,
+                                               g_block, BENCH_BLOCK_FRAMES);
+        stage_block(&st, start);
+        in_pos += consumed;
+        st.frames += consumed;
+        if (got) st.checksum += g_block[(got - 1) * 2];
+        if (got == 0 && consumed == 0) break;
+    }
+    st.bytes = st.frames * 4;
+    audio_resampler_deinit(&rs);
+    g_wav_path_cost += stage_report("resample", &st);
+
+    // EQ: every band and both shelves active, the worst case
+    static audio_eq_t eq;
+    audio_eq_init(&eq, BENCH_RATE);
+    float bands[AUDIO_EQ_BANDS];
+    for (int i = 0; i < AUDIO_EQ_BANDS; i++) bands[i] = (i & 1) ? -4.0f : 4.0f;
+    audio_eq_set_bands(&eq, bands, AUDIO_EQ_BANDS);
+    audio_eq_set_bass(&eq, 6.0f);
+    audio_eq_set_treble(&eq, -3.0f);
+    stage_begin(&st, BENCH_RATE);
+    for (uint32_t b = 0; b < blocks; b++) {
+        memcpy(g_work, g_corpus + b * BENCH_BLOCK_FRAMES * 2, sizeof(g_work));
+        uint32_t start = bench_ticks();
+        audio_eq_process(&eq, g_work, BENCH_BLOCK_FRAMES);
+        stage_block(&st, start);
+        st.checksum += g_work[b & (BENCH_BLOCK_FRAMES - 1)];
+    }
+    st.frames = (uint64_t)blocks * BENCH_BLOCK_FRAMES;
+    st.bytes = st.frames * 4;
+    g_wav_path_cost += stage_report("eq", &st);
+
+    // I2S packing: the engine's ring write and the feeder's hand-off of one
+    // DMA period, as hal_audio_esp32 does before i2s_write()
+    static audio_ring_t ring;
+    TEST_ASSERT_TRUE(audio_ring_init(&ring, HAL_AUDIO_DEFAULT_BUFFER_FRAMES, true));
+    stage_begin(&st, BENCH_RATE);
+    for (uint32_t b = 0; b < blocks; b++) {
+        const int16_t* in = g_corpus + b * BENCH_BLOCK_FRAMES * 2;
+        uint32_t start = bench_ticks();
+        audio_ring_write_all(&ring, in, BENCH_BLOCK_FRAMES);
+        uint32_t left = BENCH_BLOCK_FRAMES;
+        int16_t* dma = g_work;
+        while (left > 0) {
+            const int16_t* region = nullptr;
+            uint32_t frames = audio_ring_acquire_read(&ring, &region);
+            if (frames > left) frames = left;
+            memcpy(dma, region, frames * 4);
+            audio_ring_commit_read(&ring, frames);
+            dma += frames * 2;
+            left -= frames;
+        }
+        stage_block(&st, start);
+        st.checksum += g_work[b & (BENCH_BLOCK_FRAMES - 1)];
+    }
+    st.frames = (uint64_t)blocks * BENCH_BLOCK_FRAMES;
+    st.bytes = st.frames * 4;
+    audio_ring_deinit(&ring);
+    g_wav_path_cost += stage_report("i2s pack", &st);
+}
+
+// The engine task's real work per block with one decoder, then with two while
+// the same track fades in over itself. Two MP3 decoders when there is an MP3
+// corpus, otherwise FLAC, the heaviest decoder every build has.
+void bench_pipeline_crossfade(void) {
+    bool mp3 = false;
+#if AUDIO_DECODER_MP3
+    mp3 = hal_storage_file_exists(BENCH_CORPUS_MP3);
+#endif
+    const char* path = mp3 ? BENCH_CORPUS_MP3 : BENCH_CORPUS_FLAC;
+    const char* names[2] = { mp3 ? "engine mp3" : "engine flac", mp3 ? "xfade 2 mp3" : "xfade 2 flac" };
+    if (!hal_storage_is_mounted() || (!mp3 && !write_corpus_flac())) {
+        printf("crossfade: no card, skipped\n");
+        return;
+    }
+
+    audio_engine_config_t config = {};
+    config.start_task = false;
+    config.block_frames = BENCH_BLOCK_FRAMES;
+    config.output_rate = BENCH_RATE;
+    config.crossfade_ms = BENCH_CROSSFADE_MS;
+    TEST_ASSERT_TRUE(audio_engine_init(&config));
+    audio_engine_set_volume(100);
+
+    // The play command runs inside the first measured block of each stage,
+    // so opening the decoder counts where the engine task would pay for it
+    bench_stage_t st[2];
+    const uint32_t stage_frames[2] = { BENCH_RATE, (uint32_t)((uint64_t)BENCH_CROSSFADE_MS * BENCH_RATE / 1000) };
+    for (int s = 0; s < 2; s++) {
+        TEST_ASSERT_TRUE(audio_engine_play_file(path));
+        stage_begin(&st[s], BENCH_RATE);
+        while (st[s].frames < stage_frames[s]) {
+            uint32_t start = bench_ticks();
+            uint32_t got = audio_engine_render(g_block, BENCH_BLOCK_FRAMES);
+            stage_block(&st[s], start);
+            TEST_ASSERT_EQUAL(BENCH_BLOCK_FRAMES, got);
+            st[s].frames += got;
+            st[s].checksum += g_block[(got - 1) * 2];
+        }
+        stage_report(names[s], &st[s]);
+    }
+    const double worst_us = g_block_ticks[st[1].blocks - 1] / bench_ticks_per_us();
+
+    audio_engine_stats_t stats;
+    audio_engine_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.crossfades);
+    audio_engine_deinit();
+
+    // The engine task must finish each block well inside its playback time
+    const double deadline_us = BENCH_BLOCK_FRAMES * 1e6 / BENCH_RATE;
+    printf("xfade worst  %8.2f us of a %.2f us block (%.1f%%)\n", worst_us, deadline_us,
+           worst_us * 100.0 / deadline_us);
+}
+
+void bench_pipeline_headroom(void) {
+    // WAV playback runs every stage above once per output block
+    printf("wav path     %9.6f CPU s/audio s  (%.2f%% of one core, %.0fx headroom)\n",
+           g_wav_path_cost, g_wav_path_cost * 100.0, g_wav_path_cost > 0 ? 1.0 / g_wav_path_cost : 0.0);
+}
+
+static int run_benches(void) {
+    g_corpus = (int16_t*)hal_system_malloc_psram(BENCH_CORPUS_FRAMES * 4);
+    g_block_ticks = (uint32_t*)hal_system_malloc(BENCH_MAX_BLOCKS * sizeof(uint32_t));
+    if (!g_corpus || !g_block_ticks) {
+        printf("bench_audio_pipeline: out of memory\n");
+        return 1;
+    }
+    make_corpus();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_pipeline_card_and_decode);
+    RUN_TEST(bench_pipeline_dsp);
+    RUN_TEST(bench_pipeline_crossfade);
+    RUN_TEST(bench_pipeline_headroom);
+
+    int failures = UNITY_END();
+    hal_system_free(g_block_ticks);
+    hal_system_free(g_corpus);
+    return failures;
+}
+
+#ifdef PLATFORM_ESP32
+void setup(void) {
+    Serial.begin(115200);
+    delay(2000);                            // Give the test runner time to open the port
+    SPI.begin();
+    SD.begin(IZOD_BENCH_SD_CS, SPI, SD_MAX_FREQUENCY);
+    run_benches();
+}
+
+void loop(void) {
+}
+#else
+int main(void) {
+    return run_benches();
+}
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Audio Probe Benchmark
+ * Library-scan throughput: files per second and storage reads per file for
+ * header-only probing of a directory. Set IZOD_BENCH_PROBE_DIR to probe a
+ * real music folder instead of the generated one.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include "audio/audio_decoder.h"
+#include "hal/hal_storage.h"
+#include "../wav_test_writer.h"
+
+#define BENCH_FILES_PER_KIND    400
+#define BENCH_PASSES            5
+
+static std::string g_generated;
+
+static void put_be32(uint8_t* p, uint32_t x) {
+    p[0] = x >> 24; p[1] = x >> 16; p[2] = x >> 8; p[3] = x;
+}
+
+static void write_card_file(const std::string& path, const std::vector<uint8_t>& bytes) {
+    hal_storage_file_t f = hal_storage_open(path.c_str(), HAL_STORAGE_MODE_WRITE);
+    TEST_ASSERT_NOT_NULL(f);
+    hal_storage_write(f, bytes.data(), bytes.size());
+    hal_storage_close(f);
+}
+
+// 16-bit stereo WAV with a LIST chunk before the data, as taggers write them
+static std::vector<uint8_t> make_wav(uint32_t seconds) {
+    wav_test_format_t format;
+    format.list_bytes = 200;
+    return wav_test_file(format, std::vector<uint8_t>(seconds * 44100 * 4, 0));
+}
+
+// 128 kbps MPEG-1 frames behind an ID3v2 tag with cover art, optionally led by
+// an Info tag; untagged files alternate bitrates so they read as VBR
+static std::vector<uint8_t> make_mp3(uint32_t frames, bool info_tag) {
+    const uint32_t art = 30000;
+    std::vector<uint8_t> v = {'I', 'D', '3', 4, 0, 0, 0, (uint8_t)(art >> 14), (uint8_t)((art >> 7) & 0x7F),
+                              (uint8_t)(art & 0x7F)};
+    v.resize(v.size() + art, 0x55);
+    const size_t tag_at = v.size();
+    for (uint32_t n = 0; n < frames + (info_tag ? 1 : 0); n++) {
+        const uint32_t index = info_tag || (n & 1) ? 9 : 10;
+        const uint32_t bytes = 144 * (index == 9 ? 128000 : 160000) / 44100;
+        size_t at = v.size();
+        v.resize(at + bytes, 0x11);
+        v[at] = 0xFF; v[at + 1] = 0xFB; v[at + 2] = (uint8_t)(index << 4); v[at + 3] = 0x00;
+    }
+    if (info_tag) {
+        uint8_t* p = &v[tag_at + 4 + 32];
+        memcpy(p, "Info", 4);
+        put_be32(p + 4, 3);
+        put_be32(p + 8, frames);
+        put_be32(p + 12, (uint32_t)(v.size() - tag_at));
+    }
+    return v;
+}
+
+void setUp(void) {
+    g_generated = (std::filesystem::temp_directory_path() / "izod_bench_audio_probe").string();
+    hal_storage_host_set_root(g_generated.c_str());
+    hal_storage_init();
+}
+
+void tearDown(void) {
+    std::filesystem::remove_all(g_generated);
+    hal_storage_deinit();
+}
+
+// Probes every file in dir BENCH_PASSES times
+static void bench_directory(const char* label, const char* dir) {
+    std::vector<std::string> paths;
+    hal_storage_dir_t d = hal_storage_open_dir(dir);
+    TEST_ASSERT_NOT_NULL(d);
+    hal_storage_file_info_t entry;
+    while (hal_storage_read_dir(d, &entry)) {
+        if (entry.type == HAL_STORAGE_TYPE_FILE) paths.push_back(std::string(dir) + "/" + entry.name);
+    }
+    hal_storage_close_dir(d);
+    TEST_ASSERT_GREATER_THAN(0, paths.size());
+
+    uint32_t probed = 0, reads_before = 0, reads_after = 0;
+    uint64_t total_ms = 0;
+    audio_probe_t probe;
+    hal_storage_get_stats(&reads_before, nullptr, nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (const std::string& path : paths) {
+            if (!audio_decoder_probe_file(path.c_str(), &probe)) continue;
+            probed++;
+            total_ms += probe.duration_ms;
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    hal_storage_get_stats(&reads_after, nullptr, nullptr, nullptr);
+
+    const double files = (double)paths.size() * BENCH_PASSES;
+    printf("%-10s %5u files  %9.0f files/s  %5.2f reads/file  %u/%u probed [chk %llu]\n",
+           label, (unsigned)paths.size(), files / secs, (reads_after - reads_before) / files,
+           (unsigned)(probed / BENCH_PASSES), (unsigned)paths.size(),
+           (unsigned long long)(total_ms / BENCH_PASSES));
+}
+
+void bench_probe_generated_library(void) {
+    hal_storage_create_dir("/wav");
+    hal_storage_create_dir("/mp3-info");
+    hal_storage_create_dir("/mp3-vbr");
+    const std::vector<uint8_t> wav = make_wav(2);
+    const std::vector<uint8_t> cbr = make_mp3(400, true);
+    const std::vector<uint8_t> vbr = make_mp3(400, false);
+    for (int i = 0; i < BENCH_FILES_PER_KIND; i++) {
+        write_card_file("/wav/" + std::to_string(i) + ".wav", wav);
+        write_card_file("/mp3-info/" + std::to_string(i) + ".mp3", cbr);
+        write_card_file("/mp3-vbr/" + std::to_string(i) + ".mp3", vbr);
+    }
+    bench_directory("wav", "/wav");
+    bench_directory("mp3 info", "/mp3-info");
+    bench_directory("mp3 vbr", "/mp3-vbr");
+}
+
+void bench_probe_user_directory(void) {
+    const char* dir = getenv("IZOD_BENCH_PROBE_DIR");
+    if (!dir || !*dir) {
+        printf("IZOD_BENCH_PROBE_DIR not set, skipping\n");
+        return;
+    }
+    hal_storage_host_set_root(dir);
+    bench_directory("user", "/");
+    hal_storage_host_set_root(g_generated.c_str());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_probe_generated_library);
+    RUN_TEST(bench_probe_user_directory);
+
+    return UNITY_END();
+}
@@ -0,0 +1,85 @@
+/*
+ * Audio Resampler Benchmark
+ * CPU seconds spent per second of output audio for each quality tier and
+ * common source rate, converting to the 44.1 kHz output
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <chrono>
+#include "audio/audio_resampler.h"
+
+#define BENCH_OUTPUT_RATE   44100
+#define BENCH_BLOCK_FRAMES  256             // One engine block
+#define BENCH_AUDIO_SECONDS 60
+
+static int16_t g_in[BENCH_BLOCK_FRAMES * 2];
+static int16_t g_out[BENCH_BLOCK_FRAMES * 2];
+
+static const uint32_t k_source_rates[] = { 8000, 16000, 22050, 32000, 48000, 88200, 96000 };
+
+void setUp(void) {
+    // Broadband input: a swept tone, so no branch or zero shortcut flatters a tier
+    for (int i = 0; i < BENCH_BLOCK_FRAMES; i++) {
+        int16_t s = (int16_t)(12000.0 * sin(0.0007 * i * i));
+        g_in[i * 2] = s;
+        g_in[i * 2 + 1] = (int16_t)-s;
+    }
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+// Produces BENCH_AUDIO_SECONDS of output and prints CPU time per audio second
+static void bench_tier(const char* name, audio_resampler_quality_t quality) {
+    for (uint32_t r = 0; r < sizeof(k_source_rates) / sizeof(k_source_rates[0]); r++) {
+        uint32_t in_rate = k_source_rates[r];
+        audio_resampler_t rs;
+        memset(&rs, 0, sizeof(rs));
+        TEST_ASSERT_TRUE(audio_resampler_init(&rs, in_rate, BENCH_OUTPUT_RATE, quality));
+
+        const uint64_t target = (uint64_t)BENCH_OUTPUT_RATE * BENCH_AUDIO_SECONDS;
+        uint64_t produced = 0;
+        uint32_t in_pos = 0;
+        int64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (produced < target) {
+            uint32_t consumed = 0;
+            uint32_t n = audio_resampler_process(&rs, g_in + in_pos * 2, BENCH_BLOCK_FRAMES - in_pos,
+                                                 &consumed, g_out, BENCH_BLOCK_FRAMES);
+            in_pos = (in_pos + consumed) % BENCH_BLOCK_FRAMES;
+            produced += n;
+            if (n) checksum += g_out[(n - 1) * 2];
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double per_second = secs / BENCH_AUDIO_SECONDS;
+        printf("%-7s %5.1f kHz -> 44.1 kHz  %2u taps  %8.5f CPU s/audio s (%6.0fx realtime) [chk %lld]\n",
+               name, in_rate / 1000.0, (unsigned)rs.taps, per_second, 1.0 / per_second, (long long)checksum);
+        audio_resampler_deinit(&rs);
+    }
+}
+
+void bench_resampler_low(void) {
+    bench_tier("low", AUDIO_RESAMPLER_QUALITY_LOW);
+}
+
+void bench_resampler_medium(void) {
+    bench_tier("medium", AUDIO_RESAMPLER_QUALITY_MEDIUM);
+}
+
+void bench_resampler_high(void) {
+    bench_tier("high", AUDIO_RESAMPLER_QUALITY_HIGH);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_resampler_low);
+    RUN_TEST(bench_resampler_medium);
+    RUN_TEST(bench_resampler_high);
+
+    return UNITY_END();
+}
@@ -0,0 +1,90 @@
+/*
+ * Audio Ring Buffer Benchmark
+ * Copy cost per frame and producer/consumer throughput on the host
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include "audio/audio_ring_buffer.h"
+
+#define BENCH_RING_FRAMES   4096
+#define BENCH_BLOCK_FRAMES  256
+#define BENCH_TOTAL_FRAMES  (64u * 1024u * 1024u)
+
+static audio_ring_t g_ring;
+
+void setUp(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, BENCH_RING_FRAMES, false));
+}
+
+void tearDown(void) {
+    audio_ring_deinit(&g_ring);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void bench_ring_single_thread(void) {
+    static int16_t block[BENCH_BLOCK_FRAMES * AUDIO_RING_CHANNELS];
+    for (int i = 0; i < BENCH_BLOCK_FRAMES * AUDIO_RING_CHANNELS; i++) block[i] = (int16_t)i;
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t frames = 0;
+    int64_t checksum = 0;
+    while (frames < BENCH_TOTAL_FRAMES) {
+        audio_ring_write(&g_ring, block, BENCH_BLOCK_FRAMES);
+        audio_ring_read(&g_ring, block, BENCH_BLOCK_FRAMES);
+        checksum += block[0];
+        frames += BENCH_BLOCK_FRAMES;
+    }
+    double secs = seconds_since(start);
+
+    printf("ring single-thread: %.2f ns/frame, %.1f Mframes/s (%.0fx realtime @44.1k) [chk %lld]\n",
+           secs * 1e9 / frames, frames / secs / 1e6, frames / secs / 44100.0, (long long)checksum);
+    TEST_ASSERT_EQUAL(0, g_ring.overruns.load());
+}
+
+void bench_ring_producer_consumer(void) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread consumer([]() {
+        static int16_t out[BENCH_BLOCK_FRAMES * AUDIO_RING_CHANNELS];
+        uint64_t got = 0;
+        while (got < BENCH_TOTAL_FRAMES) {
+            uint32_t n = audio_ring_read(&g_ring, out, BENCH_BLOCK_FRAMES);
+            if (n == 0) std::this_thread::yield();
+            got += n;
+        }
+    });
+
+    static int16_t block[BENCH_BLOCK_FRAMES * AUDIO_RING_CHANNELS];
+    uint64_t sent = 0;
+    uint64_t full_spins = 0;
+    while (sent < BENCH_TOTAL_FRAMES) {
+        if (audio_ring_free_frames(&g_ring) < BENCH_BLOCK_FRAMES) {
+            full_spins++;
+            std::this_thread::yield();
+            continue;
+        }
+        audio_ring_write(&g_ring, block, BENCH_BLOCK_FRAMES);
+        sent += BENCH_BLOCK_FRAMES;
+    }
+    consumer.join();
+    double secs = seconds_since(start);
+
+    printf("ring producer/consumer: %.1f Mframes/s (%.0fx realtime @44.1k), %llu full spins\n",
+           sent / secs / 1e6, sent / secs / 44100.0, (unsigned long long)full_spins);
+    TEST_ASSERT_EQUAL(0, audio_ring_used_frames(&g_ring));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_ring_single_thread);
+    RUN_TEST(bench_ring_producer_consumer);
+
+    return UNITY_END();
+}
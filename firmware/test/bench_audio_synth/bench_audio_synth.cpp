@@ -0,0 +1,86 @@
+/*
+ * Audio Synth Benchmark
+ * CPU cost of mixing 1 to 16 sustained voices over a block at 44.1 kHz stereo
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <chrono>
+#include "audio/audio_synth.h"
+
+#define BENCH_RATE          44100
+#define BENCH_BLOCK_FRAMES  256             // One engine block
+#define BENCH_AUDIO_SECONDS 30
+
+static audio_synth_t g_synth;
+static int16_t g_source[BENCH_BLOCK_FRAMES * 2];
+static int16_t g_block[BENCH_BLOCK_FRAMES * 2];
+static int64_t g_checksum;
+
+void setUp(void) {
+    for (int i = 0; i < BENCH_BLOCK_FRAMES; i++) {
+        int16_t s = (int16_t)(6000.0 * sin(0.0007 * i * i));
+        g_source[i * 2] = s;
+        g_source[i * 2 + 1] = (int16_t)-s;
+    }
+    TEST_ASSERT_TRUE(audio_synth_init(&g_synth, BENCH_RATE, AUDIO_SYNTH_MAX_VOICES));
+}
+
+void tearDown(void) {
+    audio_synth_deinit(&g_synth);
+}
+
+// Starts voices notes held for longer than the run, spread over the waveforms and octaves
+static void start_voices(uint32_t voices) {
+    audio_synth_stop_all(&g_synth);
+    for (uint32_t v = 0; v < voices; v++) {
+        audio_synth_note_t note;
+        memset(&note, 0, sizeof(note));
+        note.waveform = (audio_synth_waveform_t)(v % AUDIO_SYNTH_WAVEFORMS);
+        note.frequency_hz = 110 + 137 * v;
+        note.volume = 100 / AUDIO_SYNTH_MAX_VOICES;
+        note.pan = (int8_t)(v * 12 - 90);
+        note.duration_ms = (BENCH_AUDIO_SECONDS + 1) * 1000;
+        note.attack_ms = 5;
+        note.sustain = 100;
+        TEST_ASSERT_TRUE(audio_synth_post(&g_synth, &note, 1));
+    }
+}
+
+// CPU seconds per second of audio, mixing over a music block as the engine does
+static double bench_cost(void) {
+    const uint32_t blocks = BENCH_RATE * BENCH_AUDIO_SECONDS / BENCH_BLOCK_FRAMES;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t b = 0; b < blocks; b++) {
+        memcpy(g_block, g_source, sizeof(g_block));
+        audio_synth_render(&g_synth, g_block, BENCH_BLOCK_FRAMES, 32768);
+        g_checksum += g_block[b & (BENCH_BLOCK_FRAMES - 1)];
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return secs / BENCH_AUDIO_SECONDS;
+}
+
+void bench_synth_per_voice(void) {
+    start_voices(0);
+    double idle = bench_cost();
+    printf("idle                 %9.6f CPU s/audio s\n", idle);
+
+    for (uint32_t voices = 1; voices <= AUDIO_SYNTH_MAX_VOICES; voices++) {
+        start_voices(voices);
+        double cost = bench_cost();
+        TEST_ASSERT_EQUAL(voices, g_synth.active_voices);
+        printf("%2u voices            %9.6f CPU s/audio s  (%.3f%% CPU per voice, %6.0fx realtime)\n",
+               (unsigned)voices, cost, (cost - idle) * 100.0 / voices, 1.0 / cost);
+    }
+    printf("[chk %lld]\n", (long long)g_checksum);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_synth_per_voice);
+
+    return UNITY_END();
+}
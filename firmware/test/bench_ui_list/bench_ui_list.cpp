@@ -0,0 +1,185 @@
+/*
+ * UI List Benchmark
+ * Frame times scrolling a 10,000-row library a row at a time: the list view
+ * shifting rows it already holds, and a plain list redrawn over the same
+ * window each step, both through the compositor onto an in-memory panel
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "ui/ui_widget.h"
+
+#define BENCH_WIDTH   320
+#define BENCH_HEIGHT  240
+#define BENCH_ROWS    10000
+#define BENCH_PAGE    64                    // Rows a library index page holds
+#define VIEW_X        6
+#define VIEW_Y        48
+#define VIEW_W        220
+#define VIEW_H        176
+#define ROW_H         22
+#define FRAME_BUDGET_US  33333.0            // 30 FPS
+
+static std::vector<uint16_t> g_panel;
+static ui_compositor_t g_compositor;
+
+static void push_to_panel(const ui_rect_t* rect, const uint16_t* pixels, void* user_data) {
+    (void)user_data;
+    for (int16_t row = 0; row < rect->h; row++) {
+        memcpy(&g_panel[(rect->y + row) * BENCH_WIDTH + rect->x], pixels + row * rect->w, rect->w * sizeof(uint16_t));
+    }
+}
+
+// Synthetic library index, read a page at a time
+static struct {
+    uint32_t first;
+    uint32_t loads;
+    char rows[BENCH_PAGE][UI_LIST_VIEW_TEXT_MAX];
+} g_index = {UINT32_MAX, 0, {}};
+
+static const char* library_row(uint32_t index) {
+    uint32_t first = index - index % BENCH_PAGE;
+    if (first != g_index.first) {
+        for (uint32_t i = 0; i < BENCH_PAGE; i++) {
+            snprintf(g_index.rows[i], UI_LIST_VIEW_TEXT_MAX, "%05lu Artist %lu - Song",
+                     (unsigned long)(first + i), (unsigned long)((first + i) % 997));
+        }
+        g_index.first = first;
+        g_index.loads++;
+    }
+    return g_index.rows[index - first];
+}
+
+static void library_source(uint32_t index, char* text, void* user_data) {
+    (void)user_data;
+    strncpy(text, library_row(index), UI_LIST_VIEW_TEXT_MAX - 1);
+}
+
+void setUp(void) {
+    g_panel.assign(BENCH_WIDTH * BENCH_HEIGHT, 0);
+    g_index.first = UINT32_MAX;
+    g_index.loads = 0;
+    const ui_panel_t panel = {push_to_panel, NULL, NULL};
+    TEST_ASSERT_TRUE(ui_compositor_init(&g_compositor, BENCH_WIDTH, BENCH_HEIGHT, UI_COMPOSITOR_BAND_ROWS, 0,
+                                        &panel));
+}
+
+void tearDown(void) {
+    ui_compositor_deinit(&g_compositor);
+}
+
+static uint32_t checksum(void) {
+    uint32_t sum = 0;
+    for (uint16_t p : g_panel) sum = sum * 31 + p;
+    return sum;
+}
+
+static void report(const char* path, std::vector<double>& frame_us, uint64_t pixels) {
+    std::sort(frame_us.begin(), frame_us.end());
+    double total = 0;
+    for (double us : frame_us) total += us;
+    size_t n = frame_us.size();
+    printf("%-12s %6zu frames  avg %7.1f us  p50 %7.1f  p99 %7.1f  max %7.1f  %6.0f FPS  %6lu px/frame [chk %08x]\n",
+           path, n, total / n, frame_us[n / 2], frame_us[n * 99 / 100], frame_us[n - 1], n * 1e6 / total,
+           (unsigned long)(pixels / n), (unsigned)checksum());
+    TEST_ASSERT_TRUE(frame_us[n * 99 / 100] < FRAME_BUDGET_US);
+}
+
+// One frame per step through the whole library, the selection leading
+static void scroll_list_view(const char* path, uint32_t step) {
+    ui_list_view_t view;
+    TEST_ASSERT_TRUE(ui_list_view_init(&view, VIEW_W, VIEW_H, ROW_H, UI_LIST_VIEW_OVERSCAN, 0xFFFF, 0xFBE0, 0));
+    view.marker_w = 3;
+    view.marker_h = 12;
+    view.text_x = 6;
+    view.text_y = 2;
+    ui_list_view_set_source(&view, library_source, NULL, BENCH_ROWS);
+    ui_widget_t root, list;
+    ui_tree_t tree;
+    ui_widget_box(&root, ui_rect_t{0, 0, BENCH_WIDTH, BENCH_HEIGHT}, UI_LAYOUT_FIXED);
+    ui_widget_list_view(&list, ui_rect_t{VIEW_X, VIEW_Y, 0, 0}, &view);
+    ui_widget_add(&root, &list);
+    ui_tree_init(&tree, &root, &g_compositor, NULL);
+    ui_compositor_invalidate_all(&g_compositor);
+    ui_widget_list_view_select(&list, 0);
+    ui_tree_update(&tree);
+
+    std::vector<double> frame_us;
+    uint64_t pixels = 0;
+    for (uint32_t row = step; row < BENCH_ROWS; row += step) {
+        auto start = std::chrono::steady_clock::now();
+        ui_widget_list_view_select(&list, row);
+        pixels += ui_tree_update(&tree);
+        frame_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    report(path, frame_us, pixels);
+
+    ui_list_view_stats_t stats;
+    ui_list_view_get_stats(&view, &stats);
+    printf("%-12s %lu fetches, %lu renders, %lu row copies, %lu index pages\n", "", (unsigned long)stats.fetches,
+           (unsigned long)stats.renders, (unsigned long)stats.blits, (unsigned long)g_index.loads);
+    ui_list_view_deinit(&view);
+}
+
+void bench_list_view_row_steps(void) {
+    scroll_list_view("view x1", 1);
+}
+
+void bench_list_view_page_steps(void) {
+    scroll_list_view("view x8", VIEW_H / ROW_H);
+}
+
+// The plain list given the rows in view each step, as a static menu would be
+void bench_list_redraw(void) {
+    ui_text_cache_t cache;
+    TEST_ASSERT_TRUE(ui_text_cache_init(&cache, UI_TEXT_CACHE_BYTES));
+    static char texts[BENCH_ROWS][UI_LIST_VIEW_TEXT_MAX];
+    static const char* items[BENCH_ROWS];
+    for (uint32_t i = 0; i < BENCH_ROWS; i++) {
+        strncpy(texts[i], library_row(i), UI_LIST_VIEW_TEXT_MAX - 1);
+        items[i] = texts[i];
+    }
+    const int fit = VIEW_H / ROW_H;
+    ui_widget_t root, list;
+    ui_tree_t tree;
+    ui_widget_box(&root, ui_rect_t{0, 0, BENCH_WIDTH, BENCH_HEIGHT}, UI_LAYOUT_FIXED);
+    ui_widget_list(&list, ui_rect_t{VIEW_X, VIEW_Y, VIEW_W, 0}, ROW_H, 0xFFFF, 0xFBE0);
+    list.list.marker_w = 3;
+    list.list.marker_h = 12;
+    list.list.text_x = 6;
+    list.list.text_y = 2;
+    ui_widget_set_items(&list, items, fit);
+    ui_widget_set_selected(&list, 0);
+    ui_widget_add(&root, &list);
+    ui_tree_init(&tree, &root, &g_compositor, &cache);
+    ui_compositor_invalidate_all(&g_compositor);
+    ui_tree_update(&tree);
+
+    std::vector<double> frame_us;
+    uint64_t pixels = 0;
+    uint32_t top = 0;
+    for (uint32_t row = 1; row < BENCH_ROWS; row++) {
+        auto start = std::chrono::steady_clock::now();
+        if (row >= top + fit) top = row - fit + 1;
+        ui_widget_set_items(&list, items + top, fit);
+        ui_widget_set_selected(&list, (int)(row - top));
+        pixels += ui_tree_update(&tree);
+        frame_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    report("redraw x1", frame_us, pixels);
+    ui_text_cache_deinit(&cache);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_list_view_row_steps);
+    RUN_TEST(bench_list_view_page_steps);
+    RUN_TEST(bench_list_redraw);
+
+    return UNITY_END();
+}
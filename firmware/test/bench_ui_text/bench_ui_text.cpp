@@ -0,0 +1,137 @@
+/*
+ * UI Text Benchmark
+ * Glyphs per second at text size 2: the classic font scaled a pixel at a
+ * time, as Adafruit GFX drawChar does, the atlas span blitter, and copies
+ * out of the text run cache
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "ui/ui_text_cache.h"
+
+#define BENCH_WIDTH   320
+#define BENCH_ROWS    32                    // One compositor band
+#define BENCH_SIZE    2
+#define BENCH_PASSES  4000
+
+static const char* const k_labels[] = {"Now Playing", "Artists", "Albums", "Songs", "Settings", "Home", "3:07"};
+
+static std::vector<uint16_t> g_band;
+static ui_canvas_t g_canvas;
+static uint8_t g_classic[128][UI_FONT_CELL_H];  // Size 1 cells, a column bit per pixel
+
+void setUp(void) {
+    g_band.assign(BENCH_WIDTH * BENCH_ROWS, 0);
+    ui_canvas_init(&g_canvas, g_band.data(), ui_rect_t{0, 0, BENCH_WIDTH, BENCH_ROWS});
+
+    // The classic glyphs, read back from size 1 where the canvas still draws them
+    uint16_t cell[UI_FONT_CELL_W * UI_FONT_CELL_H];
+    for (int c = 32; c < 127; c++) {
+        ui_canvas_t canvas;
+        ui_canvas_init(&canvas, cell, ui_rect_t{0, 0, UI_FONT_CELL_W, UI_FONT_CELL_H});
+        ui_canvas_fill(&canvas, 0);
+        const char text[2] = {(char)c, '\0'};
+        ui_canvas_text(&canvas, 0, 0, text, 0xFFFF, 1);
+        for (int y = 0; y < UI_FONT_CELL_H; y++) {
+            g_classic[c][y] = 0;
+            for (int x = 0; x < UI_FONT_CELL_W; x++) {
+                if (cell[y * UI_FONT_CELL_W + x]) g_classic[c][y] |= 1 << x;
+            }
+        }
+    }
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+static uint32_t glyphs_per_pass(void) {
+    uint32_t glyphs = 0;
+    for (const char* label : k_labels) glyphs += strlen(label);
+    return glyphs;
+}
+
+static uint32_t checksum(void) {
+    uint32_t sum = 0;
+    for (uint16_t p : g_band) sum = sum * 31 + p;
+    return sum;
+}
+
+static void report(const char* path, double secs) {
+    double glyphs = (double)glyphs_per_pass() * BENCH_PASSES;
+    printf("%-14s %10.0f glyphs/s  %7.1f ns per glyph [chk %08x]\n",
+           path, glyphs / secs, secs * 1e9 / glyphs, (unsigned)checksum());
+}
+
+// A size-scaled square per set pixel, as drawChar does for sizes above 1
+static void draw_classic(int16_t x, int16_t y, const char* text, uint16_t color) {
+    for (const char* p = text; *p; p++, x += UI_FONT_CELL_W * BENCH_SIZE) {
+        const uint8_t* rows = g_classic[(uint8_t)*p & 0x7F];
+        for (int16_t row = 0; row < UI_FONT_CELL_H; row++) {
+            for (int16_t col = 0; col < UI_FONT_CELL_W; col++) {
+                if (rows[row] & (1 << col)) {
+                    ui_canvas_fill_rect(&g_canvas, x + col * BENCH_SIZE, y + row * BENCH_SIZE,
+                                        BENCH_SIZE, BENCH_SIZE, color);
+                }
+            }
+        }
+    }
+}
+
+void bench_text_classic_scaled(void) {
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        int16_t x = 0;
+        for (const char* label : k_labels) {
+            draw_classic(x % 200, 8, label, 0xFFFF);
+            x += 40;
+        }
+    }
+    report("classic x2", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+void bench_text_atlas(void) {
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        int16_t x = 0;
+        for (const char* label : k_labels) {
+            ui_canvas_text(&g_canvas, x % 200, 8, label, 0xFFFF, BENCH_SIZE);
+            x += 40;
+        }
+    }
+    report("atlas", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+void bench_text_cache_hits(void) {
+    ui_text_cache_t cache;
+    TEST_ASSERT_TRUE(ui_text_cache_init(&cache, UI_TEXT_CACHE_BYTES));
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        int16_t x = 0;
+        for (const char* label : k_labels) {
+            ui_text_cache_draw(&cache, &g_canvas, x % 200, 8, label, 0xFFFF, 0, BENCH_SIZE);
+            x += 40;
+        }
+    }
+    report("cache", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    ui_text_cache_stats_t stats;
+    ui_text_cache_get_stats(&cache, &stats);
+    printf("cache: %lu hits, %lu misses, %lu bytes\n",
+           (unsigned long)stats.hits, (unsigned long)stats.misses, (unsigned long)stats.bytes);
+    TEST_ASSERT_EQUAL(0, stats.evictions);
+    ui_text_cache_deinit(&cache);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(bench_text_classic_scaled);
+    RUN_TEST(bench_text_atlas);
+    RUN_TEST(bench_text_cache_hits);
+
+    return UNITY_END();
+}
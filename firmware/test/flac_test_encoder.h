@@ -0,0 +1,397 @@
+/*
+ * FLAC Test Encoder
+ * Small reference encoder for the FLAC decoder tests and benchmarks
+ *
+ * Every choice an encoder normally searches over (subframe type and order,
+ * stereo mode, Rice parameter width, escaped partitions, block sizes) is
+ * forced through the options instead, so a round trip exercises exactly the
+ * decoder path under test. Constant subframes and wasted bits are still
+ * detected per subframe. Not a good encoder: it never compares choices.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+enum flac_enc_subframe_t {
+    FLAC_ENC_VERBATIM,
+    FLAC_ENC_FIXED,
+    FLAC_ENC_LPC
+};
+
+struct flac_enc_options_t {
+    uint32_t block_size = 4096;
+    flac_enc_subframe_t subframe = FLAC_ENC_LPC;
+    uint32_t order = 8;                 // Fixed 0-4, LPC 1-32
+    uint32_t precision = 12;            // LPC coefficient bits, 2-15
+    uint32_t stereo = 10;               // Channel assignment: 1 independent, 8 left/side, 9 right/side, 10 mid/side
+    uint32_t partition_order = 4;       // Lowered per block until the partitions fit
+    bool rice2 = false;                 // 5-bit Rice parameters even when 4 would do
+    bool escape = false;                // Every partition as raw bits
+    bool variable = false;              // Variable block sizes, headers carry sample numbers
+    uint32_t seek_every = 0;            // SEEKTABLE point spacing in samples, 0 for none
+    bool id3 = false;                   // ID3v2 tag before "fLaC"
+};
+
+struct flac_enc_bits_t {
+    std::vector<uint8_t> bytes;
+    uint64_t acc = 0;
+    uint32_t n = 0;
+
+    void put(uint32_t v, uint32_t bits) {
+        if (bits == 0) return;
+        acc = (acc << bits) | (bits < 32 ? v & ((1u << bits) - 1) : v);
+        n += bits;
+        while (n >= 8) {
+            n -= 8;
+            bytes.push_back((uint8_t)(acc >> n));
+        }
+    }
+    void put_signed(int32_t v, uint32_t bits) { put((uint32_t)v, bits); }
+    void put_unary(uint32_t q) {
+        for (; q >= 16; q -= 16) put(0, 16);
+        put(1, q + 1);
+    }
+    void align() {
+        if (n) put(0, 8 - n);
+    }
+};
+
+static inline uint8_t flac_enc_crc8(const uint8_t* p, size_t n) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++) crc = (uint8_t)((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+    return crc;
+}
+
+static inline uint16_t flac_enc_crc16(const uint8_t* p, size_t n) {
+    uint16_t crc = 0;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= (uint16_t)(p[i] << 8);
+        for (int b = 0; b < 8; b++) crc = (uint16_t)((crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1);
+    }
+    return crc;
+}
+
+static inline void flac_enc_utf8(flac_enc_bits_t& w, uint64_t v) {
+    if (v < 0x80) {
+        w.put((uint32_t)v, 8);
+        return;
+    }
+    uint32_t extra = 1;
+    while (extra < 6 && v >= (1ull << (6 * extra + 6 - extra))) extra++;
+    w.put((uint32_t)((0xFF00u >> (extra + 1)) & 0xFF) | (uint32_t)(v >> (6 * extra)), 8);
+    for (int i = (int)extra - 1; i >= 0; i--) w.put(0x80 | (uint32_t)((v >> (6 * i)) & 0x3F), 8);
+}
+
+// Bits to hold every value as two's complement; 0 when all are zero
+static inline uint32_t flac_enc_signed_bits(const int64_t* r, uint32_t n) {
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (r[i] == 0) continue;
+        uint64_t v = (uint64_t)(r[i] < 0 ? ~r[i] : r[i]);
+        uint32_t need = 1;
+        for (; v; v >>= 1) need++;
+        if (need > bits) bits = need;
+    }
+    return bits;
+}
+
+static inline void flac_enc_residual(flac_enc_bits_t& w, const int64_t* r, uint32_t n, uint32_t order,
+                                     const flac_enc_options_t& o) {
+    uint32_t po = o.partition_order;
+    while (po > 0 && ((n % (1u << po)) != 0 || (n >> po) < order)) po--;
+    const uint32_t parts = 1u << po;
+
+    // Best parameter per partition; 5-bit parameters when any needs more than 14
+    std::vector<uint32_t> params(parts);
+    bool rice2 = o.rice2;
+    for (uint32_t p = 0, at = order; p < parts; p++) {
+        const uint32_t count = (n >> po) - (p == 0 ? order : 0);
+        uint64_t best = UINT64_MAX;
+        for (uint32_t k = 0; k <= 30; k++) {
+            uint64_t cost = 0;
+            for (uint32_t i = 0; i < count; i++) {
+                const uint64_t u = r[at + i] < 0 ? ((uint64_t)(-r[at + i]) << 1) - 1 : (uint64_t)r[at + i] << 1;
+                cost += (u >> k) + 1 + k;
+            }
+            if (cost < best) {
+                best = cost;
+                params[p] = k;
+            }
+        }
+        if (params[p] > 14) rice2 = true;
+        at += count;
+    }
+
+    w.put(rice2 ? 1 : 0, 2);
+    w.put(po, 4);
+    for (uint32_t p = 0, at = order; p < parts; p++) {
+        const uint32_t count = (n >> po) - (p == 0 ? order : 0);
+        if (o.escape) {
+            const uint32_t bits = flac_enc_signed_bits(r + at, count);
+            w.put(rice2 ? 31 : 15, rice2 ? 5 : 4);
+            w.put(bits, 5);
+            for (uint32_t i = 0; i < count; i++) w.put_signed((int32_t)r[at + i], bits);
+        } else {
+            const uint32_t k = params[p];
+            w.put(k, rice2 ? 5 : 4);
+            for (uint32_t i = 0; i < count; i++) {
+                const uint64_t u = r[at + i] < 0 ? ((uint64_t)(-r[at + i]) << 1) - 1 : (uint64_t)r[at + i] << 1;
+                w.put_unary((uint32_t)(u >> k));
+                w.put((uint32_t)u, k);
+            }
+        }
+        at += count;
+    }
+}
+
+// Autocorrelation and Levinson-Durbin, quantized to the requested precision
+static inline void flac_enc_lpc(const int32_t* s, uint32_t n, uint32_t order, uint32_t precision,
+                                int32_t* qcoef, uint32_t* shift) {
+    std::vector<float> x(n);
+    for (uint32_t i = 0; i < n; i++) {
+        const float w = 0.5f - 0.5f * cosf(6.2831853f * (i + 0.5f) / n);      // Hann
+        x[i] = s[i] * w;
+    }
+    double ac[33] = {};
+    for (uint32_t lag = 0; lag <= order; lag++) {
+        float sum = 0;
+        for (uint32_t i = lag; i < n; i++) sum += x[i] * x[i - lag];
+        ac[lag] = sum;
+    }
+    ac[0] *= 1.0 + 1e-9;
+    double lpc[32] = {}, tmp[32];
+    double err = ac[0];
+    for (uint32_t i = 0; i < order && err > 0; i++) {
+        double k = -ac[i + 1];
+        for (uint32_t j = 0; j < i; j++) k -= lpc[j] * ac[i - j];
+        k /= err;
+        for (uint32_t j = 0; j < i; j++) tmp[j] = lpc[j] + k * lpc[i - 1 - j];
+        for (uint32_t j = 0; j < i; j++) lpc[j] = tmp[j];
+        lpc[i] = k;
+        err *= 1.0 - k * k;
+    }
+    // lpc[] predicts with a minus sign: s[i] ~ -sum(lpc[j] s[i-1-j])
+    double cmax = 0;
+    for (uint32_t j = 0; j < order; j++) cmax = fmax(cmax, fabs(lpc[j]));
+    int log2cmax = 0;
+    frexp(cmax, &log2cmax);
+    int sh = cmax > 0 ? (int)precision - 1 - log2cmax : 0;
+    if (sh > 15) sh = 15;
+    if (sh < 0) sh = 0;
+    const int32_t qmax = (1 << (precision - 1)) - 1, qmin = -(1 << (precision - 1));
+    double carry = 0;
+    for (uint32_t j = 0; j < order; j++) {
+        double v = -lpc[j] * (1 << sh) + carry;
+        long q = lround(v);
+        if (q > qmax) q = qmax;
+        if (q < qmin) q = qmin;
+        carry = v - q;
+        qcoef[j] = (int32_t)q;
+    }
+    *shift = (uint32_t)sh;
+}
+
+static inline void flac_enc_subframe(flac_enc_bits_t& w, const int32_t* in, uint32_t n, uint32_t bits,
+                                     const flac_enc_options_t& o) {
+    bool constant = true;
+    uint32_t any = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        constant = constant && in[i] == in[0];
+        any |= (uint32_t)in[i];
+    }
+    if (constant) {
+        w.put(0, 8);
+        w.put_signed(in[0], bits);
+        return;
+    }
+    uint32_t wasted = 0;
+    while (wasted < bits - 1 && !(any & (1u << wasted))) wasted++;
+    std::vector<int32_t> s(in, in + n);
+    for (int32_t& v : s) v >>= wasted;
+    bits -= wasted;
+
+    uint32_t order = o.order;
+    flac_enc_subframe_t kind = o.subframe;
+    if (order >= n) kind = FLAC_ENC_VERBATIM;
+    uint32_t type = 1;
+    if (kind == FLAC_ENC_FIXED) type = 8 + order;
+    if (kind == FLAC_ENC_LPC) type = 31 + order;
+    w.put(type << 1 | (wasted ? 1 : 0), 8);
+    if (wasted) w.put_unary(wasted - 1);
+
+    if (kind == FLAC_ENC_VERBATIM) {
+        for (uint32_t i = 0; i < n; i++) w.put_signed(s[i], bits);
+        return;
+    }
+    std::vector<int64_t> r(n);
+    for (uint32_t i = 0; i < order; i++) w.put_signed(s[i], bits);
+    if (kind == FLAC_ENC_FIXED) {
+        static const int64_t k_fixed[5][4] = {{0}, {1}, {2, -1}, {3, -3, 1}, {4, -6, 4, -1}};
+        for (uint32_t i = order; i < n; i++) {
+            int64_t p = 0;
+            for (uint32_t j = 0; j < order; j++) p += k_fixed[order][j] * s[i - 1 - j];
+            r[i] = s[i] - p;
+        }
+    } else {
+        int32_t q[32];
+        uint32_t shift = 0;
+        flac_enc_lpc(s.data(), n, order, o.precision, q, &shift);
+        w.put(o.precision - 1, 4);
+        w.put_signed((int32_t)shift, 5);
+        for (uint32_t j = 0; j < order; j++) w.put_signed(q[j], o.precision);
+        for (uint32_t i = order; i < n; i++) {
+            int64_t p = 0;
+            for (uint32_t j = 0; j < order; j++) p += (int64_t)q[j] * s[i - 1 - j];
+            r[i] = s[i] - (p >> shift);
+        }
+    }
+    flac_enc_residual(w, r.data(), n, order, o);
+}
+
+static inline void flac_enc_frame(std::vector<uint8_t>& out, const int32_t* interleaved, uint64_t first,
+                                  uint32_t n, uint32_t channels, uint32_t bits, uint32_t rate,
+                                  uint64_t number, const flac_enc_options_t& o) {
+    flac_enc_bits_t w;
+    w.put(0xFFF8 | (o.variable ? 1 : 0), 16);
+
+    uint32_t bs_code = 7;
+    if (n == 192) bs_code = 1;
+    else if (n == 576 || n == 1152 || n == 2304 || n == 4608) bs_code = 2 + (uint32_t)log2(n / 576);
+    else if (n >= 256 && n <= 32768 && (n & (n - 1)) == 0) bs_code = 8 + (uint32_t)log2(n / 256);
+    else if (n <= 256) bs_code = 6;
+    static const uint32_t k_rates[12] = {0, 88200, 176400, 192000, 8000, 16000, 22050, 24000, 32000, 44100, 48000, 96000};
+    uint32_t rate_code = 0;
+    for (uint32_t i = 1; i < 12; i++) {
+        if (k_rates[i] == rate) rate_code = i;
+    }
+    if (!rate_code) rate_code = rate % 1000 == 0 && rate / 1000 < 256 ? 12 : (rate < 65536 ? 13 : (rate % 10 == 0 ? 14 : 0));
+    uint32_t bits_code = bits == 8 ? 1 : bits == 12 ? 2 : bits == 16 ? 4 : bits == 20 ? 5 : bits == 24 ? 6 : 0;
+    const uint32_t mode = channels == 2 ? o.stereo : 1;
+    w.put(bs_code, 4);
+    w.put(rate_code, 4);
+    w.put(channels == 1 ? 0 : mode, 4);
+    w.put(bits_code, 3);
+    w.put(0, 1);
+    flac_enc_utf8(w, number);
+    if (bs_code == 6) w.put(n - 1, 8);
+    if (bs_code == 7) w.put(n - 1, 16);
+    if (rate_code == 12) w.put(rate / 1000, 8);
+    if (rate_code == 13) w.put(rate, 16);
+    if (rate_code == 14) w.put(rate / 10, 16);
+    w.put(flac_enc_crc8(w.bytes.data(), w.bytes.size()), 8);
+
+    std::vector<int32_t> a(n), b(n);
+    for (uint32_t i = 0; i < n; i++) {
+        a[i] = interleaved[(first + i) * channels];
+        b[i] = channels == 2 ? interleaved[(first + i) * channels + 1] : 0;
+    }
+    if (channels == 1) {
+        flac_enc_subframe(w, a.data(), n, bits, o);
+    } else if (mode == 1) {
+        flac_enc_subframe(w, a.data(), n, bits, o);
+        flac_enc_subframe(w, b.data(), n, bits, o);
+    } else {
+        std::vector<int32_t> side(n), mid(n);
+        for (uint32_t i = 0; i < n; i++) {
+            side[i] = a[i] - b[i];
+            mid[i] = (a[i] + b[i]) >> 1;
+        }
+        if (mode == 8) {
+            flac_enc_subframe(w, a.data(), n, bits, o);
+            flac_enc_subframe(w, side.data(), n, bits + 1, o);
+        } else if (mode == 9) {
+            flac_enc_subframe(w, side.data(), n, bits + 1, o);
+            flac_enc_subframe(w, b.data(), n, bits, o);
+        } else {
+            flac_enc_subframe(w, mid.data(), n, bits, o);
+            flac_enc_subframe(w, side.data(), n, bits + 1, o);
+        }
+    }
+    w.align();
+    const uint16_t crc = flac_enc_crc16(w.bytes.data(), w.bytes.size());
+    w.put(crc, 16);
+    out.insert(out.end(), w.bytes.begin(), w.bytes.end());
+}
+
+static inline void flac_enc_block_header(std::vector<uint8_t>& v, bool last, uint32_t type, uint32_t len) {
+    v.push_back((uint8_t)((last ? 0x80 : 0) | type));
+    v.push_back((uint8_t)(len >> 16));
+    v.push_back((uint8_t)(len >> 8));
+    v.push_back((uint8_t)len);
+}
+
+static inline void flac_enc_be(std::vector<uint8_t>& v, uint64_t x, int bytes) {
+    for (int i = bytes - 1; i >= 0; i--) v.push_back((uint8_t)(x >> (8 * i)));
+}
+
+// samples: frames x channels interleaved, each within bits
+static inline std::vector<uint8_t> flac_test_encode(const int32_t* samples, uint32_t frames, uint32_t channels,
+                                                    uint32_t bits, uint32_t rate,
+                                                    const flac_enc_options_t& o = flac_enc_options_t()) {
+    // Frames first, so the SEEKTABLE can point into them
+    std::vector<uint8_t> audio;
+    std::vector<uint64_t> frame_sample, frame_offset;
+    static const uint32_t k_variable[4] = {1, 2, 3, 5};
+    uint32_t min_block = UINT32_MAX, max_block = 0;
+    uint64_t at = 0;
+    for (uint32_t index = 0; at < frames; index++) {
+        uint32_t n = o.variable ? o.block_size * k_variable[index % 4] / 5 : o.block_size;
+        if (n < 16) n = 16;
+        if (n > frames - at) n = (uint32_t)(frames - at);
+        frame_sample.push_back(at);
+        frame_offset.push_back(audio.size());
+        flac_enc_frame(audio, samples, at, n, channels, bits, rate, o.variable ? at : index, o);
+        if (at + n < frames || index == 0) {
+            if (n < min_block) min_block = n;
+            if (n > max_block) max_block = n;
+        }
+        at += n;
+    }
+    if (!o.variable) min_block = max_block = o.block_size;
+
+    std::vector<uint8_t> v;
+    if (o.id3) {
+        const uint32_t tag = 300;
+        v = {'I', 'D', '3', 4, 0, 0, 0, 0, (uint8_t)(tag >> 7), (uint8_t)(tag & 0x7F)};
+        v.resize(10 + tag, 0);
+    }
+    v.insert(v.end(), {'f', 'L', 'a', 'C'});
+    flac_enc_block_header(v, false, 0, 34);
+    flac_enc_be(v, min_block, 2);
+    flac_enc_be(v, max_block, 2);
+    flac_enc_be(v, 0, 3);
+    flac_enc_be(v, 0, 3);
+    flac_enc_be(v, ((uint64_t)rate << 44) | ((uint64_t)(channels - 1) << 41) | ((uint64_t)(bits - 1) << 36) | frames, 8);
+    v.resize(v.size() + 16, 0);     // MD5 unknown
+
+    if (o.seek_every) {
+        std::vector<uint64_t> points;
+        for (uint64_t s = 0; s < frames; s += o.seek_every) {
+            size_t f = 0;
+            while (f + 1 < frame_sample.size() && frame_sample[f + 1] <= s) f++;
+            if (points.empty() || points.back() != f) points.push_back(f);
+        }
+        flac_enc_block_header(v, false, 3, (uint32_t)(points.size() + 1) * 18);
+        for (uint64_t f : points) {
+            flac_enc_be(v, frame_sample[f], 8);
+            flac_enc_be(v, frame_offset[f], 8);
+            flac_enc_be(v, f + 1 < frame_sample.size() ? frame_sample[f + 1] - frame_sample[f] : frames - frame_sample[f], 2);
+        }
+        flac_enc_be(v, UINT64_MAX, 8);  // Placeholder
+        flac_enc_be(v, 0, 8);
+        flac_enc_be(v, 0, 2);
+    }
+    // Padding, as taggers leave room to grow
+    flac_enc_block_header(v, true, 1, 64);
+    v.resize(v.size() + 64, 0);
+
+    v.insert(v.end(), audio.begin(), audio.end());
+    return v;
+}
@@ -0,0 +1,171 @@
+/*
+ * Audio Analyzer Tests
+ * FFT accuracy, band placement, level metering and lock-free publishing
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "audio/audio_analyzer.h"
+
+#define TEST_RATE 44100
+
+static audio_analyzer_t g_an;
+
+// Feeds seconds of a stereo sine in engine-sized blocks
+static void feed_sine(float hz, float amplitude, float seconds) {
+    int16_t block[256 * 2];
+    uint32_t total = (uint32_t)(TEST_RATE * seconds);
+    for (uint32_t start = 0; start < total; start += 256) {
+        for (uint32_t i = 0; i < 256; i++) {
+            int16_t s = (int16_t)lrintf(amplitude * sinf(2.0f * (float)M_PI * hz * (float)(start + i) / TEST_RATE));
+            block[i * 2] = s;
+            block[i * 2 + 1] = s;
+        }
+        audio_analyzer_feed(&g_an, block, 256);
+    }
+}
+
+static uint32_t loudest_band(const audio_analyzer_frame_t* frame) {
+    uint32_t best = 0;
+    for (uint32_t b = 1; b < AUDIO_ANALYZER_BANDS; b++) {
+        if (frame->bands[b] > frame->bands[best]) best = b;
+    }
+    return best;
+}
+
+// Band whose range holds hz, from the published layout
+static uint32_t band_of(float hz) {
+    const float bin_hz = (float)TEST_RATE / g_an.decimation / g_an.fft_size;
+    uint32_t bin = (uint32_t)(hz / bin_hz + 0.5f);
+    for (uint32_t b = 0; b < AUDIO_ANALYZER_BANDS; b++) {
+        if (bin >= g_an.band_lo[b] && bin < g_an.band_hi[b]) return b;
+    }
+    return AUDIO_ANALYZER_BANDS;
+}
+
+void setUp(void) {
+    TEST_ASSERT_TRUE(audio_analyzer_init(&g_an, TEST_RATE, 512, 2));
+}
+
+void tearDown(void) {
+    audio_analyzer_deinit(&g_an);
+}
+
+void test_analyzer_fft_matches_reference(void) {
+    // Two tones against a float DFT of the same input
+    const uint32_t n = 256;
+    std::vector<int32_t> re(n), im(n), twiddle(n);
+    for (uint32_t k = 0; k < n / 2; k++) {
+        twiddle[k * 2] = (int32_t)lrint(cos(2.0 * M_PI * k / n) * (1 << 30));
+        twiddle[k * 2 + 1] = (int32_t)lrint(-sin(2.0 * M_PI * k / n) * (1 << 30));
+    }
+    std::vector<double> x(n);
+    for (uint32_t i = 0; i < n; i++) {
+        x[i] = 1e7 * sin(2.0 * M_PI * 10 * i / n) + 4e6 * cos(2.0 * M_PI * 37 * i / n);
+        re[i] = (int32_t)x[i];
+        im[i] = 0;
+    }
+    audio_analyzer_fft(re.data(), im.data(), twiddle.data(), 8);
+
+    for (uint32_t k = 0; k < n / 2; k++) {
+        double dr = 0.0, di = 0.0;
+        for (uint32_t i = 0; i < n; i++) {
+            dr += x[i] * cos(2.0 * M_PI * k * i / n);
+            di -= x[i] * sin(2.0 * M_PI * k * i / n);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(64.0, dr / n, re[k]);
+        TEST_ASSERT_FLOAT_WITHIN(64.0, di / n, im[k]);
+    }
+}
+
+void test_analyzer_nothing_before_first_publish(void) {
+    audio_analyzer_frame_t frame;
+    TEST_ASSERT_FALSE(audio_analyzer_read(&g_an, &frame));
+    feed_sine(1000.0f, 8000.0f, 0.02f);
+    TEST_ASSERT_FALSE(audio_analyzer_read(&g_an, &frame));
+    feed_sine(1000.0f, 8000.0f, 0.02f);
+    TEST_ASSERT_TRUE(audio_analyzer_read(&g_an, &frame));
+    TEST_ASSERT_EQUAL(1, frame.sequence);
+}
+
+void test_analyzer_sine_lands_in_its_band(void) {
+    audio_analyzer_frame_t frame;
+    for (float hz : {100.0f, 1000.0f, 5000.0f}) {
+        feed_sine(hz, 16384.0f, 0.1f);
+        TEST_ASSERT_TRUE(audio_analyzer_read(&g_an, &frame));
+        TEST_ASSERT_EQUAL(band_of(hz), loudest_band(&frame));
+        // -6 dBFS on a 72 dB scale
+        TEST_ASSERT_FLOAT_WITHIN(0.03f, 1.0f - 6.0f / 72.0f, frame.bands[band_of(hz)]);
+    }
+    // Far from the tone the Hann sidelobes are below the floor
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, frame.bands[0]);
+}
+
+void test_analyzer_peak_and_rms(void) {
+    audio_analyzer_frame_t frame;
+    feed_sine(1000.0f, 16384.0f, 0.1f);
+    TEST_ASSERT_TRUE(audio_analyzer_read(&g_an, &frame));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, frame.peak);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f / sqrtf(2.0f), frame.rms);
+
+    audio_analyzer_clear(&g_an);
+    TEST_ASSERT_TRUE(audio_analyzer_read(&g_an, &frame));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, frame.peak);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, frame.rms);
+    for (uint32_t b = 0; b < AUDIO_ANALYZER_BANDS; b++) TEST_ASSERT_EQUAL_FLOAT(0.0f, frame.bands[b]);
+}
+
+void test_analyzer_rejects_bad_sizes(void) {
+    audio_analyzer_t an = {};
+    TEST_ASSERT_FALSE(audio_analyzer_init(&an, TEST_RATE, 500, 1));
+    TEST_ASSERT_FALSE(audio_analyzer_init(&an, TEST_RATE, 2048, 1));
+    TEST_ASSERT_FALSE(audio_analyzer_init(&an, 0, 512, 1));
+    TEST_ASSERT_TRUE(audio_analyzer_init(&an, TEST_RATE, 0, 0));
+    TEST_ASSERT_EQUAL(AUDIO_ANALYZER_DEFAULT_FFT, an.fft_size);
+    audio_analyzer_deinit(&an);
+}
+
+void test_analyzer_readers_never_see_torn_frames(void) {
+    // Each publish window is a square wave of one amplitude, so peak == rms in
+    // every whole frame; a frame stitched from two publishes would disagree
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> reads(0);
+    std::atomic<bool> torn(false);
+    std::thread reader([&]() {
+        audio_analyzer_frame_t frame;
+        while (!done.load()) {
+            if (!audio_analyzer_read(&g_an, &frame)) continue;
+            if (fabsf(frame.peak - frame.rms) > 1e-3f) torn = true;
+            reads++;
+        }
+    });
+
+    std::vector<int16_t> window(g_an.frames_per_update * 2);
+    for (uint32_t n = 0; n < 2000; n++) {
+        int16_t a = (n & 1) ? 1000 : 30000;
+        for (size_t i = 0; i < window.size(); i++) window[i] = (i & 2) ? a : (int16_t)-a;
+        audio_analyzer_feed(&g_an, window.data(), g_an.frames_per_update);
+    }
+    done = true;
+    reader.join();
+    TEST_ASSERT_EQUAL(2000, g_an.published);
+    TEST_ASSERT_FALSE(torn.load());
+    TEST_ASSERT_GREATER_THAN(0, reads.load());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_analyzer_fft_matches_reference);
+    RUN_TEST(test_analyzer_nothing_before_first_publish);
+    RUN_TEST(test_analyzer_sine_lands_in_its_band);
+    RUN_TEST(test_analyzer_peak_and_rms);
+    RUN_TEST(test_analyzer_rejects_bad_sizes);
+    RUN_TEST(test_analyzer_readers_never_see_torn_frames);
+
+    return UNITY_END();
+}
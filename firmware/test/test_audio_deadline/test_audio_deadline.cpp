@@ -0,0 +1,144 @@
+/*
+ * Audio Deadline Monitor Tests
+ * Log2 binning, slack and interval recording, misses, resets and the console table
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "audio/audio_deadline.h"
+
+#define TEST_RATE       44100
+#define TEST_PERIOD     256                 // 5804 us at 44.1 kHz
+
+static audio_deadline_t g_deadline;
+
+void setUp(void) {
+    audio_deadline_init(&g_deadline, TEST_RATE, TEST_PERIOD);
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+void test_deadline_bins_double_from_256_us(void) {
+    TEST_ASSERT_EQUAL(0, audio_deadline_bin(0));
+    TEST_ASSERT_EQUAL(0, audio_deadline_bin(255));
+    TEST_ASSERT_EQUAL(1, audio_deadline_bin(256));
+    TEST_ASSERT_EQUAL(1, audio_deadline_bin(511));
+    TEST_ASSERT_EQUAL(2, audio_deadline_bin(512));
+    TEST_ASSERT_EQUAL(5, audio_deadline_bin(5804));
+    TEST_ASSERT_EQUAL(AUDIO_DEADLINE_BINS - 1, audio_deadline_bin(UINT32_MAX));
+
+    for (uint32_t bin = 1; bin < AUDIO_DEADLINE_BINS; bin++) {
+        TEST_ASSERT_EQUAL(bin, audio_deadline_bin(audio_deadline_bin_floor_us(bin)));
+        TEST_ASSERT_EQUAL(bin - 1, audio_deadline_bin(audio_deadline_bin_floor_us(bin) - 1));
+    }
+}
+
+void test_deadline_records_slack_and_intervals(void) {
+    // Four refills a period apart, the ring draining by a period each time
+    for (uint32_t i = 0; i < 4; i++) {
+        audio_deadline_record(&g_deadline, 1000000 + i * 5804, 4096 - i * TEST_PERIOD, false);
+    }
+    // Then one after a 40 ms stall with little left
+    audio_deadline_record(&g_deadline, 1000000 + 3 * 5804 + 40000, 300, false);
+
+    hal_audio_deadline_stats_t stats;
+    audio_deadline_read(&g_deadline, &stats);
+    TEST_ASSERT_EQUAL(5804, stats.period_us);
+    TEST_ASSERT_EQUAL(5, stats.periods);
+    TEST_ASSERT_EQUAL(0, stats.misses);
+    TEST_ASSERT_EQUAL(300 * 1000000ull / TEST_RATE, stats.min_slack_us);
+    TEST_ASSERT_EQUAL(40000, stats.max_interval_us);
+
+    // 4096..3328 frames is 92.9..75.5 ms, all in [65536, 131072)
+    TEST_ASSERT_EQUAL(4, stats.slack_bins[audio_deadline_bin(90000)]);
+    TEST_ASSERT_EQUAL(1, stats.slack_bins[audio_deadline_bin(6802)]);
+    // The first refill opens the run, so one interval fewer than refills
+    TEST_ASSERT_EQUAL(3, stats.interval_bins[audio_deadline_bin(5804)]);
+    TEST_ASSERT_EQUAL(1, stats.interval_bins[audio_deadline_bin(40000)]);
+}
+
+void test_deadline_counts_misses_only_mid_stream(void) {
+    // Late on the first refill is just the stream starting
+    audio_deadline_record(&g_deadline, 0, 512, true);
+    audio_deadline_record(&g_deadline, 5804, 512, true);
+
+    hal_audio_deadline_stats_t stats;
+    audio_deadline_read(&g_deadline, &stats);
+    TEST_ASSERT_EQUAL(2, stats.periods);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+    TEST_ASSERT_EQUAL(0, stats.min_slack_us);
+    TEST_ASSERT_EQUAL(1, stats.slack_bins[0]);
+
+    // Going idle ends the run: no interval spans the gap and no miss follows it
+    audio_deadline_idle(&g_deadline);
+    audio_deadline_record(&g_deadline, 10000000, 512, true);
+    audio_deadline_read(&g_deadline, &stats);
+    TEST_ASSERT_EQUAL(3, stats.periods);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+    TEST_ASSERT_EQUAL(5804, stats.max_interval_us);
+}
+
+void test_deadline_reset_applies_at_the_next_refill(void) {
+    audio_deadline_record(&g_deadline, 0, 1024, false);
+    audio_deadline_record(&g_deadline, 5804, 1024, false);
+    audio_deadline_reset(&g_deadline);
+
+    // Reads as reset straight away, before the consumer picks it up
+    hal_audio_deadline_stats_t stats;
+    audio_deadline_read(&g_deadline, &stats);
+    TEST_ASSERT_EQUAL(0, stats.periods);
+    TEST_ASSERT_EQUAL(UINT32_MAX, stats.min_slack_us);
+    TEST_ASSERT_EQUAL(5804, stats.period_us);
+
+    // The stream carries on: its interval counts in the new window
+    audio_deadline_record(&g_deadline, 2 * 5804, 2048, false);
+    audio_deadline_read(&g_deadline, &stats);
+    TEST_ASSERT_EQUAL(1, stats.periods);
+    TEST_ASSERT_EQUAL(2048 * 1000000ull / TEST_RATE, stats.min_slack_us);
+    TEST_ASSERT_EQUAL(1, stats.interval_bins[audio_deadline_bin(5804)]);
+
+    // A new rate rescales the period and the slack
+    audio_deadline_set_rate(&g_deadline, 48000);
+    audio_deadline_record(&g_deadline, 3 * 5804, 480, false);
+    audio_deadline_read(&g_deadline, &stats);
+    TEST_ASSERT_EQUAL(5333, stats.period_us);
+    TEST_ASSERT_EQUAL(10000, stats.min_slack_us);
+}
+
+void test_deadline_formats_a_console_table(void) {
+    char text[512];
+    hal_audio_deadline_stats_t stats;
+    audio_deadline_read(&g_deadline, &stats);
+    audio_deadline_format(&stats, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("Audio deadlines: 0 refills of 5804 us, 0 missed\n", text);
+
+    audio_deadline_record(&g_deadline, 0, 4096, false);
+    audio_deadline_record(&g_deadline, 5804, 0, true);
+    audio_deadline_read(&g_deadline, &stats);
+    size_t len = audio_deadline_format(&stats, text, sizeof(text));
+    TEST_ASSERT_EQUAL(strlen(text), len);
+    TEST_ASSERT_NOT_NULL(strstr(text, "2 refills of 5804 us, 1 missed\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "min slack 0 us, max interval 5804 us\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "          0          1          0\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "       4096          0          1\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "      65536          1          0\n"));
+
+    // Truncates cleanly into a short buffer
+    char tiny[16];
+    TEST_ASSERT_EQUAL(15, audio_deadline_format(&stats, tiny, sizeof(tiny)));
+    TEST_ASSERT_EQUAL(15, strlen(tiny));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_deadline_bins_double_from_256_us);
+    RUN_TEST(test_deadline_records_slack_and_intervals);
+    RUN_TEST(test_deadline_counts_misses_only_mid_stream);
+    RUN_TEST(test_deadline_reset_applies_at_the_next_refill);
+    RUN_TEST(test_deadline_formats_a_console_table);
+
+    return UNITY_END();
+}
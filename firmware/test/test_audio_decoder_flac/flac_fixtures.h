@@ -0,0 +1,42 @@
+/*
+ * FLAC Reference Fixtures
+ * Generated by tools/flac_fixtures.py; do not edit
+ *
+ * Files in fixtures/, encoded by libFLAC in libsndfile 1.2.2 and FFmpeg
+ * 7.0.2-static. Checksums are FNV-1a over the libFLAC decode, as 16-bit
+ * little-endian stereo samples.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct flac_fixture_t {
+    const char* file;
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t bits;
+    uint32_t frames;
+    uint32_t checksum;
+};
+
+static const flac_fixture_t k_flac_fixtures[] = {
+    // libflac, flac -8: LPC up to order 12, adaptive stereo
+    // 3 fixed frames of 808/4096; lpc 11, lpc 12; mid/side
+    {"libflac_8.flac", 44100, 2, 16, 9000, 0x23D730D3},
+    // libflac, flac -0: fixed predictors only, after a frame of digital silence
+    // 5 fixed frames of 392/1152; constant, fixed 4
+    {"libflac_0.flac", 44100, 2, 16, 5000, 0xADCF38DF},
+    // libflac, 24-bit; a loud first frame needs 5-bit Rice parameters, the second carries 16-bit audio
+    // 3 fixed frames of 808/4096; lpc 5, lpc 11, lpc 12; mid/side; up to 8 wasted bits; 5-bit Rice parameters
+    {"libflac_24.flac", 48000, 2, 24, 9000, 0x7CBAEFA1},
+    // libflac, 8-bit mono
+    // 2 fixed frames of 904/4096; lpc 4
+    {"libflac_8bit_mono.flac", 22050, 1, 8, 5000, 0x030EA65D},
+    // ffmpeg, --lax: LPC order 32 (outside the subset), left/side
+    // 3 fixed frames of 808/4096; lpc 32; left/side
+    {"ffmpeg_lpc32.flac", 44100, 2, 16, 9000, 0x23D730D3},
+    // ffmpeg, fixed order 4, right/side
+    // 5 fixed frames of 392/1152; fixed 4; right/side
+    {"ffmpeg_fixed4.flac", 44100, 2, 16, 5000, 0x694F35E4},
+};
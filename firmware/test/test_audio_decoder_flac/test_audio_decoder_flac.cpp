@@ -0,0 +1,432 @@
+/*
+ * FLAC Decoder Tests
+ * Bit-exact round trips through the test encoder for every subframe type,
+ * stereo mode, sample width and residual coding, files from real encoders
+ * checked against the reference decoder, plus seeking, probing and recovery
+ * from a damaged frame
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "audio/audio_decoder.h"
+#include "audio/audio_readahead.h"
+#include "hal/hal_storage.h"
+#include "../flac_test_encoder.h"
+#include "flac_fixtures.h"
+
+static std::vector<uint8_t> g_state;
+
+// Two detuned tones with a little deterministic noise, full range for the width
+static std::vector<int32_t> make_signal(uint32_t frames, uint32_t channels, uint32_t bits, uint32_t seed = 1) {
+    std::vector<int32_t> v(frames * channels);
+    const double scale = (double)((1 << (bits - 1)) - 1) * 0.45;
+    uint32_t noise = seed;
+    for (uint32_t i = 0; i < frames; i++) {
+        for (uint32_t c = 0; c < channels; c++) {
+            noise = noise * 1664525u + 1013904223u;
+            double x = sin(i * (0.031 + 0.007 * c)) + 0.8 * sin(i * 0.0043 + c) + ((int32_t)(noise >> 16) % 64) / 2048.0;
+            v[i * channels + c] = (int32_t)lrint(x * scale);
+        }
+    }
+    return v;
+}
+
+static void write_file(const char* card_path, const std::vector<uint8_t>& bytes) {
+    hal_storage_file_t f = hal_storage_open(card_path, HAL_STORAGE_MODE_WRITE);
+    TEST_ASSERT_NOT_NULL(f);
+    hal_storage_write(f, bytes.data(), bytes.size());
+    hal_storage_close(f);
+}
+
+static bool open_flac(const char* path, audio_stream_info_t* info) {
+    audio_source_t source;
+    audio_source_file(&source, path);
+    TEST_ASSERT_EQUAL_PTR(&audio_decoder_flac, audio_decoder_find(&source));
+    g_state.assign(audio_decoder_flac.state_size, 0);
+    memset(info, 0, sizeof(*info));
+    return audio_decoder_flac.open(g_state.data(), &source, info);
+}
+
+static std::vector<int16_t> decode_all(uint32_t block_frames = 1000) {
+    std::vector<int16_t> out;
+    std::vector<int16_t> block(block_frames * 2);
+    uint32_t got;
+    while ((got = audio_decoder_flac.decode(g_state.data(), block.data(), block_frames)) > 0) {
+        out.insert(out.end(), block.begin(), block.begin() + got * 2);
+    }
+    return out;
+}
+
+// The source scaled to int16 the way the decoder does, mono duplicated
+static int16_t expected(const std::vector<int32_t>& src, uint32_t channels, uint32_t bits, uint32_t frame, int side) {
+    int32_t x = src[frame * channels + (channels == 2 ? side : 0)];
+    return (int16_t)(bits >= 16 ? x >> (bits - 16) : (int32_t)((uint32_t)x << (16 - bits)));
+}
+
+// Encodes, decodes the whole file and compares every sample
+static void round_trip(const std::vector<int32_t>& src, uint32_t channels, uint32_t bits, uint32_t rate,
+                       const flac_enc_options_t& options) {
+    const uint32_t frames = (uint32_t)(src.size() / channels);
+    write_file("/t.flac", flac_test_encode(src.data(), frames, channels, bits, rate, options));
+
+    audio_stream_info_t info;
+    TEST_ASSERT_TRUE(open_flac("/t.flac", &info));
+    TEST_ASSERT_EQUAL(rate, info.sample_rate);
+    TEST_ASSERT_EQUAL(channels, info.channels);
+    TEST_ASSERT_EQUAL(bits, info.bits_per_sample);
+    TEST_ASSERT_EQUAL(frames, (uint32_t)info.total_frames);
+
+    std::vector<int16_t> out = decode_all();
+    audio_decoder_flac.close(g_state.data());
+    TEST_ASSERT_EQUAL(frames * 2, out.size());
+    for (uint32_t i = 0; i < frames; i++) {
+        if (out[i * 2] != expected(src, channels, bits, i, 0) || out[i * 2 + 1] != expected(src, channels, bits, i, 1)) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "sample %u differs", (unsigned)i);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+}
+
+void setUp(void) {
+    std::string root = (std::filesystem::temp_directory_path() / "izod_test_audio_decoder_flac").string();
+    hal_storage_host_set_root(root.c_str());
+    hal_storage_init();
+}
+
+void tearDown(void) {
+    std::filesystem::remove_all(hal_storage_host_get_root());
+    hal_storage_deinit();
+}
+
+void test_flac_fixed_predictors(void) {
+    std::vector<int32_t> src = make_signal(10000, 1, 16);
+    for (uint32_t order = 0; order <= 4; order++) {
+        flac_enc_options_t o;
+        o.subframe = FLAC_ENC_FIXED;
+        o.order = order;
+        round_trip(src, 1, 16, 44100, o);
+    }
+}
+
+void test_flac_lpc_orders_and_precisions(void) {
+    std::vector<int32_t> src = make_signal(9000, 2, 16);
+    // Unrolled orders, the generic loop, and 15-bit coefficients that need 64-bit sums
+    const uint32_t orders[] = {1, 2, 5, 8, 12, 13, 20, 32};
+    for (uint32_t order : orders) {
+        flac_enc_options_t o;
+        o.order = order;
+        o.precision = order >= 20 ? 15 : 12;
+        round_trip(src, 2, 16, 44100, o);
+    }
+}
+
+void test_flac_stereo_decorrelation(void) {
+    std::vector<int32_t> src = make_signal(8192, 2, 16, 7);
+    const uint32_t modes[] = {1, 8, 9, 10};
+    for (uint32_t mode : modes) {
+        flac_enc_options_t o;
+        o.stereo = mode;
+        round_trip(src, 2, 16, 48000, o);
+    }
+}
+
+void test_flac_sample_widths(void) {
+    const uint32_t widths[] = {8, 12, 20, 24};
+    for (uint32_t bits : widths) {
+        std::vector<int32_t> src = make_signal(6000, 2, bits);
+        flac_enc_options_t o;
+        o.precision = bits == 24 ? 14 : 12;
+        round_trip(src, 2, bits, 96000, o);
+    }
+}
+
+void test_flac_constant_verbatim_and_wasted_bits(void) {
+    // Digital silence then a held level: constant subframes
+    std::vector<int32_t> src(4096 * 2 * 3, 0);
+    for (size_t i = 4096 * 2; i < src.size(); i++) src[i] = 1234;
+    round_trip(src, 2, 16, 44100, flac_enc_options_t());
+
+    // 14-bit material in 16-bit words: two wasted bits per sample
+    src = make_signal(10000, 2, 16);
+    for (int32_t& x : src) x = (int32_t)((uint32_t)x & ~3u);
+    round_trip(src, 2, 16, 44100, flac_enc_options_t());
+
+    flac_enc_options_t o;
+    o.subframe = FLAC_ENC_VERBATIM;
+    round_trip(make_signal(5000, 2, 24), 2, 24, 44100, o);
+}
+
+void test_flac_rice2_and_escaped_partitions(void) {
+    std::vector<int32_t> src = make_signal(10000, 2, 16);
+    flac_enc_options_t o;
+    o.rice2 = true;
+    round_trip(src, 2, 16, 44100, o);
+
+    o = flac_enc_options_t();
+    o.escape = true;
+    round_trip(src, 2, 16, 44100, o);
+
+    // White noise at 24 bits: residuals need Rice parameters above 14
+    std::vector<int32_t> noise(8000 * 2);
+    uint32_t r = 99;
+    for (int32_t& x : noise) {
+        r = r * 1664525u + 1013904223u;
+        x = (int32_t)r >> 8;
+    }
+    o = flac_enc_options_t();
+    o.subframe = FLAC_ENC_FIXED;
+    o.order = 1;
+    o.precision = 15;
+    round_trip(noise, 2, 24, 44100, o);
+}
+
+void test_flac_block_sizes_and_header_fields(void) {
+    std::vector<int32_t> src = make_signal(20000, 2, 16);
+    // 1152 and 4608 from the table, 1000 and 100 spelled out, variable sizes
+    const uint32_t sizes[] = {192, 1152, 4608, 1000, 100};
+    for (uint32_t size : sizes) {
+        flac_enc_options_t o;
+        o.block_size = size;
+        o.order = size < 200 ? 4 : 8;
+        round_trip(src, 2, 16, 44100, o);
+    }
+    flac_enc_options_t o;
+    o.variable = true;
+    round_trip(src, 2, 16, 44100, o);
+    // Rates outside the header table, and an ID3v2 tag in front
+    o = flac_enc_options_t();
+    o.id3 = true;
+    round_trip(src, 2, 16, 11025, o);
+    round_trip(src, 1, 16, 37000, o);
+}
+
+void test_flac_rejects_unsupported_streams(void) {
+    std::vector<int32_t> src = make_signal(5000, 2, 16);
+    flac_enc_options_t o;
+    o.block_size = 8192;
+    write_file("/big.flac", flac_test_encode(src.data(), 5000, 2, 16, 44100, o));
+    audio_stream_info_t info;
+    TEST_ASSERT_FALSE(open_flac("/big.flac", &info));
+
+    std::vector<int32_t> six = make_signal(5000, 6, 16);
+    write_file("/six.flac", flac_test_encode(six.data(), 5000, 6, 16, 44100));
+    TEST_ASSERT_FALSE(open_flac("/six.flac", &info));
+
+    write_file("/fake.flac", std::vector<uint8_t>(1000, 0x55));
+    TEST_ASSERT_FALSE(open_flac("/fake.flac", &info));
+    TEST_ASSERT_FALSE(open_flac("/missing.flac", &info));
+}
+
+// Seeks to each target and checks the next block against the source
+static void check_seeks(const std::vector<int32_t>& src, uint32_t frames) {
+    const uint32_t targets[] = {0, 1, 4095, 4096, 4097, 77777, frames / 2, frames - 500, 12345, 3};
+    std::vector<int16_t> block(400 * 2);
+    for (uint32_t target : targets) {
+        TEST_ASSERT_TRUE(audio_decoder_flac.seek(g_state.data(), target));
+        uint32_t got = audio_decoder_flac.decode(g_state.data(), block.data(), 400);
+        TEST_ASSERT_EQUAL(frames - target < 400 ? frames - target : 400, got);
+        for (uint32_t i = 0; i < got; i++) {
+            TEST_ASSERT_EQUAL(expected(src, 2, 16, target + i, 0), block[i * 2]);
+            TEST_ASSERT_EQUAL(expected(src, 2, 16, target + i, 1), block[i * 2 + 1]);
+        }
+    }
+    // Past the end
+    TEST_ASSERT_TRUE(audio_decoder_flac.seek(g_state.data(), frames + 10));
+    TEST_ASSERT_EQUAL(0, audio_decoder_flac.decode(g_state.data(), block.data(), 400));
+}
+
+void test_flac_seek_through_seektable(void) {
+    const uint32_t frames = 44100 * 6;
+    std::vector<int32_t> src = make_signal(frames, 2, 16);
+    flac_enc_options_t o;
+    o.seek_every = 44100;
+    write_file("/s.flac", flac_test_encode(src.data(), frames, 2, 16, 44100, o));
+    audio_stream_info_t info;
+    TEST_ASSERT_TRUE(open_flac("/s.flac", &info));
+    check_seeks(src, frames);
+    audio_decoder_flac.close(g_state.data());
+}
+
+void test_flac_seek_by_bisection(void) {
+    const uint32_t frames = 44100 * 6;
+    std::vector<int32_t> src = make_signal(frames, 2, 16, 3);
+    flac_enc_options_t o;
+    o.variable = true;
+    write_file("/b.flac", flac_test_encode(src.data(), frames, 2, 16, 44100, o));
+    audio_stream_info_t info;
+    TEST_ASSERT_TRUE(open_flac("/b.flac", &info));
+    check_seeks(src, frames);
+    audio_decoder_flac.close(g_state.data());
+}
+
+void test_flac_probe(void) {
+    std::vector<int32_t> src = make_signal(44100 * 2, 2, 16);
+    flac_enc_options_t o;
+    o.id3 = true;
+    o.seek_every = 10000;
+    hal_storage_create_dir("/Music");
+    write_file("/Music/p.flac", flac_test_encode(src.data(), 44100 * 2, 2, 16, 44100, o));
+    audio_probe_t probe;
+    TEST_ASSERT_TRUE(audio_decoder_probe_file("/Music/p.flac", &probe));
+    TEST_ASSERT_EQUAL_STRING("flac", probe.codec);
+    TEST_ASSERT_EQUAL(44100, probe.info.sample_rate);
+    TEST_ASSERT_EQUAL(2, probe.info.channels);
+    TEST_ASSERT_EQUAL(16, probe.info.bits_per_sample);
+    TEST_ASSERT_EQUAL(44100 * 2, (uint32_t)probe.info.total_frames);
+    TEST_ASSERT_EQUAL(2000, probe.duration_ms);
+    TEST_ASSERT_TRUE(probe.info.bitrate_kbps > 100 && probe.info.bitrate_kbps < 1411);
+}
+
+void test_flac_damaged_frame_plays_silence(void) {
+    const uint32_t frames = 4096 * 6;
+    std::vector<int32_t> src = make_signal(frames, 2, 16);
+    std::vector<uint8_t> file = flac_test_encode(src.data(), frames, 2, 16, 44100);
+    // Flip a bit in the middle of the file: one frame fails its CRC-16
+    file[file.size() / 2] ^= 0x10;
+    write_file("/d.flac", file);
+
+    audio_stream_info_t info;
+    TEST_ASSERT_TRUE(open_flac("/d.flac", &info));
+    std::vector<int16_t> out = decode_all();
+    audio_decoder_flac.close(g_state.data());
+    TEST_ASSERT_EQUAL(frames * 2, out.size());
+
+    uint32_t silent = 0, exact = 0;
+    for (uint32_t block = 0; block < 6; block++) {
+        bool all_zero = true, all_match = true;
+        for (uint32_t i = block * 4096; i < (block + 1) * 4096; i++) {
+            all_zero = all_zero && out[i * 2] == 0 && out[i * 2 + 1] == 0;
+            all_match = all_match && out[i * 2] == expected(src, 2, 16, i, 0) &&
+                        out[i * 2 + 1] == expected(src, 2, 16, i, 1);
+        }
+        silent += all_zero;
+        exact += all_match;
+    }
+    TEST_ASSERT_EQUAL(1, silent);
+    TEST_ASSERT_EQUAL(5, exact);
+}
+
+// Files from real encoders (tools/flac_fixtures.py), checked against the
+// libFLAC decode of each
+static std::vector<uint8_t> read_fixture(const char* name) {
+    const std::string path = (std::filesystem::path(__FILE__).parent_path() / "fixtures" / name).string();
+    std::ifstream f(path, std::ios::binary);
+    TEST_ASSERT_TRUE_MESSAGE(f.good(), path.c_str());
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+static uint32_t fnv1a(const std::vector<int16_t>& samples) {
+    uint32_t h = 0x811C9DC5;
+    for (int16_t s : samples) {
+        h = (h ^ ((uint16_t)s & 0xFF)) * 0x01000193;
+        h = (h ^ ((uint16_t)s >> 8)) * 0x01000193;
+    }
+    return h;
+}
+
+void test_flac_reference_fixtures(void) {
+    for (const flac_fixture_t& fixture : k_flac_fixtures) {
+        write_file("/ref.flac", read_fixture(fixture.file));
+        audio_stream_info_t info;
+        TEST_ASSERT_TRUE_MESSAGE(open_flac("/ref.flac", &info), fixture.file);
+        TEST_ASSERT_EQUAL(fixture.sample_rate, info.sample_rate);
+        TEST_ASSERT_EQUAL(fixture.channels, info.channels);
+        TEST_ASSERT_EQUAL(fixture.bits, info.bits_per_sample);
+        TEST_ASSERT_EQUAL(fixture.frames, (uint32_t)info.total_frames);
+
+        // Odd block sizes, so decode calls straddle frames
+        std::vector<int16_t> out = decode_all(777);
+        audio_decoder_flac.close(g_state.data());
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(fixture.frames * 2, out.size(), fixture.file);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(fixture.checksum, fnv1a(out), fixture.file);
+    }
+}
+
+// Junk between two frames full of sync codes that fail their header CRC: the
+// frames around it play exactly, and the rescan reads the card no more often
+// than straight playback does
+void test_flac_false_syncs_rescan_in_buffer(void) {
+    const uint32_t frames = 4096 * 6;
+    std::vector<int32_t> src = make_signal(frames, 2, 16, 5);
+    std::vector<uint8_t> file = flac_test_encode(src.data(), frames, 2, 16, 44100);
+    // The first three frames encode the same alone, so they end where frame 3 begins
+    const size_t frame3 = flac_test_encode(src.data(), 4096 * 3, 2, 16, 44100).size();
+    std::vector<uint8_t> junk(8192);
+    for (size_t i = 0; i < junk.size(); i++) junk[i] = i & 1 ? 0xF8 : 0xFF;
+    file.insert(file.begin() + frame3, junk.begin(), junk.end());
+    write_file("/s.flac", file);
+
+    audio_stream_info_t info;
+    TEST_ASSERT_TRUE(open_flac("/s.flac", &info));
+    audio_readahead_reset_stats();
+    std::vector<int16_t> out = decode_all();
+    audio_readahead_stats_t stats;
+    audio_readahead_get_stats(&stats);
+    audio_decoder_flac.close(g_state.data());
+
+    TEST_ASSERT_EQUAL(frames * 2, out.size());
+    for (uint32_t i = 0; i < frames; i++) {
+        TEST_ASSERT_EQUAL(expected(src, 2, 16, i, 0), out[i * 2]);
+        TEST_ASSERT_EQUAL(expected(src, 2, 16, i, 1), out[i * 2 + 1]);
+    }
+    TEST_ASSERT_TRUE(stats.reads <= file.size() / AUDIO_READAHEAD_DEFAULT_CHUNK + 2);
+}
+
+// Random damage decodes to something, never past the stream; run under UBSan this
+// also checks that corrupt residuals can't overflow the predictors
+void test_flac_random_damage_is_contained(void) {
+    const uint32_t frames = 1024 * 4;
+    std::vector<int32_t> src = make_signal(frames, 2, 16, 3);
+    const flac_enc_subframe_t kinds[] = {FLAC_ENC_FIXED, FLAC_ENC_LPC};
+    uint32_t rng = 12345;
+    for (uint32_t iteration = 0; iteration < 200; iteration++) {
+        flac_enc_options_t o;
+        o.block_size = 1024;
+        o.subframe = kinds[iteration % 2];
+        o.order = o.subframe == FLAC_ENC_FIXED ? 1 + iteration % 4 : 1 + iteration % 12;
+        o.stereo = iteration % 3 ? 10 : 8;
+        std::vector<uint8_t> file = flac_test_encode(src.data(), frames, 2, 16, 44100, o);
+        // A few bytes anywhere past the metadata
+        for (int flips = 0; flips < 4; flips++) {
+            rng = rng * 1664525u + 1013904223u;
+            size_t at = file.size() / 4 + (rng >> 8) % (file.size() * 3 / 4);
+            file[at] ^= (uint8_t)(1 + (rng & 0x7F));
+        }
+        write_file("/r.flac", file);
+
+        audio_stream_info_t info;
+        if (!open_flac("/r.flac", &info)) continue;
+        std::vector<int16_t> out = decode_all();
+        audio_decoder_flac.close(g_state.data());
+        TEST_ASSERT_TRUE(out.size() <= frames * 2);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_flac_fixed_predictors);
+    RUN_TEST(test_flac_lpc_orders_and_precisions);
+    RUN_TEST(test_flac_stereo_decorrelation);
+    RUN_TEST(test_flac_sample_widths);
+    RUN_TEST(test_flac_constant_verbatim_and_wasted_bits);
+    RUN_TEST(test_flac_rice2_and_escaped_partitions);
+    RUN_TEST(test_flac_block_sizes_and_header_fields);
+    RUN_TEST(test_flac_rejects_unsupported_streams);
+    RUN_TEST(test_flac_seek_through_seektable);
+    RUN_TEST(test_flac_seek_by_bisection);
+    RUN_TEST(test_flac_probe);
+    RUN_TEST(test_flac_reference_fixtures);
+    RUN_TEST(test_flac_damaged_frame_plays_silence);
+    RUN_TEST(test_flac_false_syncs_rescan_in_buffer);
+    RUN_TEST(test_flac_random_damage_is_contained);
+
+    return UNITY_END();
+}
@@ -0,0 +1,213 @@
+/*
+ * WAV Decoder Tests
+ * Sample formats, WAVE_FORMAT_EXTENSIBLE and multichannel downmix
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "audio/audio_decoder.h"
+#include "hal/hal_storage.h"
+#include "../wav_test_writer.h"
+
+static std::vector<uint8_t> g_state;
+
+// Writes a 48 kHz WAV around raw sample bytes. With extensible set the fmt
+// chunk is WAVE_FORMAT_EXTENSIBLE carrying format_tag in its sub-format GUID.
+static void write_wav(const char* card_path, uint16_t format_tag, uint16_t channels, uint16_t bits,
+                      const std::vector<uint8_t>& data, bool extensible = false, uint32_t speaker_mask = 0) {
+    wav_test_format_t format;
+    format.format_tag = format_tag;
+    format.channels = channels;
+    format.bits = bits;
+    format.rate = 48000;
+    format.extensible = extensible;
+    format.speaker_mask = speaker_mask;
+    TEST_ASSERT_TRUE(wav_test_save(card_path, wav_test_file(format, data)));
+}
+
+static bool open_wav(const char* card_path, audio_stream_info_t* info) {
+    audio_source_t source;
+    audio_source_file(&source, card_path);
+    g_state.assign(audio_decoder_wav.state_size, 0);
+    return audio_decoder_wav.open(g_state.data(), &source, info);
+}
+
+static uint32_t decode_all(int16_t* out, uint32_t max_frames) {
+    uint32_t total = 0;
+    for (uint32_t n; total < max_frames &&
+         (n = audio_decoder_wav.decode(g_state.data(), out + total * 2, max_frames - total)) > 0; ) {
+        total += n;
+    }
+    audio_decoder_wav.close(g_state.data());
+    return total;
+}
+
+void setUp(void) {
+    std::string root = (std::filesystem::temp_directory_path() / "izod_test_audio_decoder_wav").string();
+    hal_storage_host_set_root(root.c_str());
+    hal_storage_init();
+}
+
+void tearDown(void) {
+    std::filesystem::remove_all(hal_storage_host_get_root());
+    hal_storage_deinit();
+}
+
+void test_wav_8bit_mono(void) {
+    write_wav("/u8.wav", 1, 1, 8, {128, 255, 0, 192});
+    audio_stream_info_t info = {};
+    TEST_ASSERT_TRUE(open_wav("/u8.wav", &info));
+    TEST_ASSERT_EQUAL(8, info.bits_per_sample);
+    TEST_ASSERT_EQUAL(4, info.total_frames);
+
+    int16_t out[8 * 2];
+    TEST_ASSERT_EQUAL(4, decode_all(out, 8));
+    const int16_t expected[8] = {0, 0, 127 << 8, 127 << 8, -128 * 256, -128 * 256, 64 << 8, 64 << 8};
+    TEST_ASSERT_EQUAL_INT16_ARRAY(expected, out, 8);
+}
+
+void test_wav_24bit_stereo(void) {
+    // Frames: (+1.0 - 1 LSB, -1.0), (0x123456, -0x123456)
+    write_wav("/s24.wav", 1, 2, 24, {0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x80,
+                                     0x56, 0x34, 0x12, 0xAA, 0xCB, 0xED});
+    audio_stream_info_t info = {};
+    TEST_ASSERT_TRUE(open_wav("/s24.wav", &info));
+    TEST_ASSERT_EQUAL(24, info.bits_per_sample);
+    TEST_ASSERT_EQUAL(2, info.total_frames);
+
+    int16_t out[4 * 2];
+    TEST_ASSERT_EQUAL(2, decode_all(out, 4));
+    const int16_t expected[4] = {32767, -32768, 0x1234, (int16_t)0xEDCB};
+    TEST_ASSERT_EQUAL_INT16_ARRAY(expected, out, 4);
+}
+
+void test_wav_32bit_int_and_float(void) {
+    std::vector<uint8_t> data;
+    wav_test_le32(data, 0x40000000u);
+    wav_test_le32(data, 0xC0000000u);
+    write_wav("/s32.wav", 1, 2, 32, data);
+    audio_stream_info_t info = {};
+    TEST_ASSERT_TRUE(open_wav("/s32.wav", &info));
+    int16_t out[2 * 2];
+    TEST_ASSERT_EQUAL(1, decode_all(out, 2));
+    TEST_ASSERT_EQUAL(16384, out[0]);
+    TEST_ASSERT_EQUAL(-16384, out[1]);
+
+    // IEEE float, both plain and EXTENSIBLE; out-of-range samples clip
+    const float samples[4] = {0.5f, -0.25f, 2.0f, -2.0f};
+    data.assign((const uint8_t*)samples, (const uint8_t*)samples + sizeof(samples));
+    write_wav("/f32.wav", 3, 2, 32, data);
+    write_wav("/f32x.wav", 3, 2, 32, data, true, 0x3);
+    for (const char* path : {"/f32.wav", "/f32x.wav"}) {
+        TEST_ASSERT_TRUE(open_wav(path, &info));
+        int16_t f[4 * 2];
+        TEST_ASSERT_EQUAL(2, decode_all(f, 4));
+        const int16_t expected[4] = {16384, -8192, 32767, -32768};
+        TEST_ASSERT_EQUAL_INT16_ARRAY(expected, f, 4);
+    }
+}
+
+void test_wav_extensible_pcm16_reads_directly(void) {
+    std::vector<uint8_t> data;
+    for (int i = 0; i < 600; i++) {
+        wav_test_le16(data, (uint16_t)i);
+        wav_test_le16(data, (uint16_t)-i);
+    }
+    write_wav("/x16.wav", 1, 2, 16, data, true, 0x3);
+    audio_stream_info_t info = {};
+    TEST_ASSERT_TRUE(open_wav("/x16.wav", &info));
+    static int16_t out[1024 * 2];
+    TEST_ASSERT_EQUAL(600, decode_all(out, 1024));
+    for (int i = 0; i < 600; i++) {
+        TEST_ASSERT_EQUAL(i, out[i * 2]);
+        TEST_ASSERT_EQUAL(-i, out[i * 2 + 1]);
+    }
+}
+
+void test_wav_5_1_downmix(void) {
+    // FL FR FC LFE BL BR: each side gets its own front and back, centre at -3 dB, no LFE
+    std::vector<uint8_t> data;
+    const int16_t frames[2][6] = {
+        {10000, 0, 0, 30000, 0, 0},
+        {0, 0, 10000, 30000, 0, -10000},
+    };
+    for (const auto& frame : frames) {
+        for (int16_t s : frame) wav_test_le16(data, (uint16_t)s);
+    }
+    write_wav("/51.wav", 1, 6, 16, data, true, 0x3F);
+    audio_stream_info_t info = {};
+    TEST_ASSERT_TRUE(open_wav("/51.wav", &info));
+    TEST_ASSERT_EQUAL(6, info.channels);
+
+    int16_t out[2 * 2];
+    TEST_ASSERT_EQUAL(2, decode_all(out, 2));
+    // Each side sums front + back + 0.707 centre, scaled by 1 / 2.707
+    TEST_ASSERT_INT_WITHIN(2, 3694, out[0]);
+    TEST_ASSERT_EQUAL(0, out[1]);
+    TEST_ASSERT_INT_WITHIN(2, 2612, out[2]);
+    TEST_ASSERT_INT_WITHIN(2, 2612 - 3694, out[3]);
+}
+
+void test_wav_multichannel_without_mask(void) {
+    // Plain PCM with 4 channels uses the default order: FL FR FC LFE
+    std::vector<uint8_t> data;
+    for (int16_t s : {8000, -8000, 0, 32767}) wav_test_le16(data, (uint16_t)s);
+    write_wav("/quad.wav", 1, 4, 16, data);
+    audio_stream_info_t info = {};
+    TEST_ASSERT_TRUE(open_wav("/quad.wav", &info));
+    int16_t out[2];
+    TEST_ASSERT_EQUAL(1, decode_all(out, 1));
+    TEST_ASSERT_INT_WITHIN(2, 4686, out[0]);
+    TEST_ASSERT_INT_WITHIN(2, -4686, out[1]);
+}
+
+void test_wav_rejects_unsupported(void) {
+    audio_stream_info_t info = {};
+    write_wav("/adpcm.wav", 2, 1, 4, {0, 0});
+    TEST_ASSERT_FALSE(open_wav("/adpcm.wav", &info));
+    write_wav("/f64.wav", 3, 1, 64, std::vector<uint8_t>(8, 0));
+    TEST_ASSERT_FALSE(open_wav("/f64.wav", &info));
+    write_wav("/wide.wav", 1, 10, 16, std::vector<uint8_t>(20, 0));
+    TEST_ASSERT_FALSE(open_wav("/wide.wav", &info));
+}
+
+void test_wav_probe_reads_only_the_header(void) {
+    // 24-bit 5.1, one second at 48 kHz
+    write_wav("/probe.wav", 1, 6, 24, std::vector<uint8_t>(48000 * 18, 0), true, 0x3F);
+    uint32_t before = 0, after = 0;
+    hal_storage_get_stats(&before, nullptr, nullptr, nullptr);
+    audio_probe_t probe;
+    TEST_ASSERT_TRUE(audio_decoder_probe_file("/probe.wav", &probe));
+    hal_storage_get_stats(&after, nullptr, nullptr, nullptr);
+
+    TEST_ASSERT_EQUAL_STRING("wav", probe.codec);
+    TEST_ASSERT_EQUAL(48000, probe.info.sample_rate);
+    TEST_ASSERT_EQUAL(6, probe.info.channels);
+    TEST_ASSERT_EQUAL(24, probe.info.bits_per_sample);
+    TEST_ASSERT_EQUAL(48000, probe.info.total_frames);
+    TEST_ASSERT_EQUAL(1000, probe.duration_ms);
+    TEST_ASSERT_EQUAL(6912, probe.info.bitrate_kbps);
+    TEST_ASSERT_LESS_OR_EQUAL(4, after - before);
+
+    TEST_ASSERT_FALSE(audio_decoder_probe_file("/missing.wav", &probe));
+    write_wav("/adpcm.wav", 2, 1, 4, {0, 0});
+    TEST_ASSERT_FALSE(audio_decoder_probe_file("/adpcm.wav", &probe));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_wav_8bit_mono);
+    RUN_TEST(test_wav_24bit_stereo);
+    RUN_TEST(test_wav_32bit_int_and_float);
+    RUN_TEST(test_wav_extensible_pcm16_reads_directly);
+    RUN_TEST(test_wav_5_1_downmix);
+    RUN_TEST(test_wav_multichannel_without_mask);
+    RUN_TEST(test_wav_rejects_unsupported);
+    RUN_TEST(test_wav_probe_reads_only_the_header);
+
+    return UNITY_END();
+}
@@ -0,0 +1,215 @@
+/*
+ * Audio DSP Kernel Tests
+ * Q15 gain, saturation, crossfade, channel layout and format conversion
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "audio/audio_dsp.h"
+
+void setUp(void) {
+    // Set up test environment
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+void test_dsp_gain_from_percent(void) {
+    TEST_ASSERT_EQUAL(0, audio_dsp_gain_from_percent(0));
+    TEST_ASSERT_EQUAL(16384, audio_dsp_gain_from_percent(50));
+    TEST_ASSERT_EQUAL(AUDIO_DSP_Q15_ONE, audio_dsp_gain_from_percent(100));
+    TEST_ASSERT_EQUAL(AUDIO_DSP_Q15_ONE, audio_dsp_gain_from_percent(200));
+}
+
+void test_dsp_gain_from_db(void) {
+    TEST_ASSERT_EQUAL(AUDIO_DSP_Q15_ONE, audio_dsp_gain_from_db(0.0f));
+    TEST_ASSERT_INT_WITHIN(2, 16422, audio_dsp_gain_from_db(-6.0f));
+    TEST_ASSERT_INT_WITHIN(4, 65381, audio_dsp_gain_from_db(6.0f));
+    TEST_ASSERT_EQUAL(AUDIO_DSP_GAIN_MAX_Q15, audio_dsp_gain_from_db(40.0f));
+    TEST_ASSERT_EQUAL(AUDIO_DSP_Q15_ONE / 4,
+                      audio_dsp_gain_multiply(AUDIO_DSP_Q15_ONE / 2, AUDIO_DSP_Q15_ONE / 2));
+}
+
+void test_dsp_gain_attenuates_and_mutes(void) {
+    int16_t s[6] = { 32767, -32768, 1000, -1000, 1, 0 };
+    audio_dsp_gain_q15(s, 6, AUDIO_DSP_Q15_ONE / 2);
+    TEST_ASSERT_EQUAL(16383, s[0]);
+    TEST_ASSERT_EQUAL(-16384, s[1]);
+    TEST_ASSERT_EQUAL(500, s[2]);
+    TEST_ASSERT_EQUAL(-500, s[3]);
+
+    audio_dsp_gain_q15(s, 6, 0);
+    for (int i = 0; i < 6; i++) TEST_ASSERT_EQUAL(0, s[i]);
+}
+
+void test_dsp_gain_above_unity_saturates(void) {
+    int16_t s[4] = { 20000, -20000, 1000, -3 };
+    int16_t out[4];
+    audio_dsp_gain_q15_copy(s, out, 4, AUDIO_DSP_Q15_ONE * 4);
+    TEST_ASSERT_EQUAL(32767, out[0]);
+    TEST_ASSERT_EQUAL(-32768, out[1]);
+    TEST_ASSERT_EQUAL(4000, out[2]);
+    TEST_ASSERT_EQUAL(-12, out[3]);
+
+    // Unity is an exact copy
+    audio_dsp_gain_q15_copy(s, out, 4, AUDIO_DSP_Q15_ONE);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(s, out, 4);
+}
+
+void test_dsp_upmix_and_downmix(void) {
+    const int16_t mono[3] = { 1, -2, 3 };
+    int16_t stereo[6];
+    audio_dsp_upmix_mono(mono, stereo, 3);
+    const int16_t expected[6] = { 1, 1, -2, -2, 3, 3 };
+    TEST_ASSERT_EQUAL_INT16_ARRAY(expected, stereo, 6);
+
+    const int16_t lr[4] = { 32767, 32767, -32768, 32767 };
+    int16_t down[2];
+    audio_dsp_downmix_to_mono(lr, down, 2);
+    TEST_ASSERT_EQUAL(32767, down[0]);
+    TEST_ASSERT_EQUAL(-1, down[1]);
+}
+
+void test_dsp_mix_and_saturate(void) {
+    int16_t acc[3] = { 30000, -30000, 5 };
+    const int16_t in[3] = { 10000, -10000, -10 };
+    audio_dsp_mix_sat(acc, in, 3);
+    TEST_ASSERT_EQUAL(32767, acc[0]);
+    TEST_ASSERT_EQUAL(-32768, acc[1]);
+    TEST_ASSERT_EQUAL(-5, acc[2]);
+
+    const int32_t wide[3] = { 40000 * 4, -40000 * 4, 1234 * 4 };
+    int16_t out[3];
+    audio_dsp_saturate_s32(wide, out, 3, 2);
+    TEST_ASSERT_EQUAL(32767, out[0]);
+    TEST_ASSERT_EQUAL(-32768, out[1]);
+    TEST_ASSERT_EQUAL(1234, out[2]);
+
+    // A wide sum far past full scale still lands back in range once added
+    int16_t music[3] = { 30000, 30000, -100 };
+    const int32_t voices[3] = { 100000, -60000, 100 };
+    audio_dsp_mix_s32_sat(music, voices, 3);
+    TEST_ASSERT_EQUAL(32767, music[0]);
+    TEST_ASSERT_EQUAL(-30000, music[1]);
+    TEST_ASSERT_EQUAL(0, music[2]);
+}
+
+void test_dsp_crossfade_equal_power(void) {
+    TEST_ASSERT_EQUAL(0, audio_dsp_fade_gain_q15(0, 1000));
+    TEST_ASSERT_EQUAL(AUDIO_DSP_Q15_ONE, audio_dsp_fade_gain_q15(1000, 1000));
+    TEST_ASSERT_EQUAL(AUDIO_DSP_Q15_ONE, audio_dsp_fade_gain_q15(5, 0));
+    for (uint32_t pos = 0; pos <= 1000; pos += 10) {
+        float expected = sinf((float)M_PI / 2.0f * pos / 1000.0f) * AUDIO_DSP_Q15_ONE;
+        TEST_ASSERT_INT_WITHIN(5, (int32_t)lrintf(expected), audio_dsp_fade_gain_q15(pos, 1000));
+
+        // Power of the two sides stays at unity through the whole fade
+        float in = audio_dsp_fade_gain_q15(pos, 1000) / (float)AUDIO_DSP_Q15_ONE;
+        float out = audio_dsp_fade_gain_q15(1000 - pos, 1000) / (float)AUDIO_DSP_Q15_ONE;
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, in * in + out * out);
+    }
+
+    // Incoming ramps up from silence while outgoing falls away, both channels alike
+    static int16_t incoming[64 * 2], outgoing[64 * 2];
+    for (int i = 0; i < 64 * 2; i++) {
+        incoming[i] = 10000;
+        outgoing[i] = -20000;
+    }
+    audio_dsp_crossfade(incoming, outgoing, 64, 0, 64);
+    TEST_ASSERT_EQUAL(-20000, incoming[0]);
+    TEST_ASSERT_EQUAL(incoming[0], incoming[1]);
+    for (int i = 1; i < 64; i++) TEST_ASSERT_TRUE(incoming[i * 2] > incoming[(i - 1) * 2]);
+    TEST_ASSERT_INT_WITHIN(2, (10000 - 20000) * 23170 / 32768, incoming[32 * 2]);
+
+    // Resuming mid-fade picks up the same curve; past the end is all incoming
+    for (int i = 0; i < 64 * 2; i++) incoming[i] = 10000;
+    audio_dsp_crossfade(incoming, outgoing, 16, 32, 64);
+    TEST_ASSERT_INT_WITHIN(2, (10000 - 20000) * 23170 / 32768, incoming[0]);
+    audio_dsp_crossfade(incoming + 32, outgoing, 16, 64, 64);
+    TEST_ASSERT_EQUAL(10000, incoming[32]);
+
+    // Full scale on both sides at the midpoint saturates instead of wrapping
+    int16_t a[2] = { 32767, -32768 };
+    const int16_t b[2] = { 32767, -32768 };
+    audio_dsp_crossfade(a, b, 1, 50, 100);
+    TEST_ASSERT_EQUAL(32767, a[0]);
+    TEST_ASSERT_EQUAL(-32768, a[1]);
+}
+
+void test_dsp_integer_format_conversion(void) {
+    const uint8_t u8[3] = { 0, 128, 255 };
+    int16_t out[3];
+    audio_dsp_u8_to_s16(u8, out, 3);
+    TEST_ASSERT_EQUAL(-32768, out[0]);
+    TEST_ASSERT_EQUAL(0, out[1]);
+    TEST_ASSERT_EQUAL(32512, out[2]);
+
+    // 0x7FFFFF, -0x800000, 0x123456
+    const uint8_t s24[9] = { 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x80, 0x56, 0x34, 0x12 };
+    audio_dsp_s24le_to_s16(s24, out, 3);
+    TEST_ASSERT_EQUAL(32767, out[0]);
+    TEST_ASSERT_EQUAL(-32768, out[1]);
+    TEST_ASSERT_EQUAL(0x1234, out[2]);
+
+    const int32_t s32[3] = { INT32_MAX, INT32_MIN, 0x12345678 };
+    audio_dsp_s32_to_s16(s32, out, 3);
+    TEST_ASSERT_EQUAL(32767, out[0]);
+    TEST_ASSERT_EQUAL(-32768, out[1]);
+    TEST_ASSERT_EQUAL(0x1234, out[2]);
+}
+
+void test_dsp_float_conversion(void) {
+    const float f[5] = { 0.0f, 0.5f, -1.0f, 1.5f, -2.0f };
+    int16_t out[5];
+    audio_dsp_f32_to_s16(f, out, 5);
+    TEST_ASSERT_EQUAL(0, out[0]);
+    TEST_ASSERT_EQUAL(16384, out[1]);
+    TEST_ASSERT_EQUAL(-32768, out[2]);
+    TEST_ASSERT_EQUAL(32767, out[3]);
+    TEST_ASSERT_EQUAL(-32768, out[4]);
+
+    float back[2];
+    audio_dsp_s16_to_f32(out + 1, back, 2);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, back[0]);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, back[1]);
+}
+
+void test_dsp_pcm_to_stereo_and_downmix_matrix(void) {
+    // Packed 24-bit mono goes straight to duplicated stereo
+    const uint8_t s24[6] = { 0x00, 0x00, 0x40, 0x00, 0x00, 0xC0 };
+    int16_t out[4];
+    audio_dsp_pcm_to_stereo(s24, out, 2, AUDIO_DSP_PCM_S24, 1, nullptr);
+    TEST_ASSERT_EQUAL(16384, out[0]);
+    TEST_ASSERT_EQUAL(16384, out[1]);
+    TEST_ASSERT_EQUAL(-16384, out[2]);
+    TEST_ASSERT_EQUAL(-16384, out[3]);
+
+    // 3.0 (FL FR FC): full-scale input on every channel must not wrap
+    int32_t mix[3 * 2];
+    audio_dsp_downmix_matrix(0x7, 3, mix);
+    TEST_ASSERT_EQUAL(0, mix[1]);
+    TEST_ASSERT_EQUAL(0, mix[2]);
+    TEST_ASSERT_EQUAL(mix[4], mix[5]);
+    TEST_ASSERT_INT_WITHIN(2, AUDIO_DSP_Q15_ONE, mix[0] + mix[4]);
+    const int16_t loud[3] = { 32767, 32767, 32767 };
+    audio_dsp_pcm_to_stereo(loud, out, 1, AUDIO_DSP_PCM_S16, 3, mix);
+    TEST_ASSERT_INT_WITHIN(2, 32767, out[0]);
+    TEST_ASSERT_INT_WITHIN(2, 32767, out[1]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_dsp_gain_from_percent);
+    RUN_TEST(test_dsp_gain_from_db);
+    RUN_TEST(test_dsp_gain_attenuates_and_mutes);
+    RUN_TEST(test_dsp_gain_above_unity_saturates);
+    RUN_TEST(test_dsp_upmix_and_downmix);
+    RUN_TEST(test_dsp_mix_and_saturate);
+    RUN_TEST(test_dsp_crossfade_equal_power);
+    RUN_TEST(test_dsp_integer_format_conversion);
+    RUN_TEST(test_dsp_float_conversion);
+    RUN_TEST(test_dsp_pcm_to_stereo_and_downmix_matrix);
+
+    return UNITY_END();
+}
@@ -0,0 +1,594 @@
+/*
+ * Audio Engine Tests
+ * Decoder plumbing and transport, rendered to memory on the host
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "audio/audio_engine.h"
+#include "hal/hal_audio.h"
+#include "hal/hal_storage.h"
+#include "hal/hal_system.h"
+#include "../wav_test_writer.h"
+
+static int g_end_calls = 0;
+static int g_track_calls = 0;
+
+static void on_track_end(void* user_data) {
+    (void)user_data;
+    g_end_calls++;
+}
+
+static void on_track_change(void* user_data) {
+    (void)user_data;
+    g_track_calls++;
+}
+
+// Everything the engine task rendered, in order
+static void on_rendered(int16_t* buffer, size_t samples, void* user_data) {
+    std::vector<int16_t>* rendered = (std::vector<int16_t>*)user_data;
+    rendered->insert(rendered->end(), buffer, buffer + samples);
+}
+
+// Writes a 16-bit PCM WAV whose left channel is a ramp (first + step * frame index) and right is its negation
+static void write_ramp_wav(const char* card_path, uint16_t channels, uint32_t rate, uint32_t frames,
+                           int16_t first = 0, int32_t step = 1) {
+    wav_test_format_t format;
+    format.channels = channels;
+    format.rate = rate;
+    format.list_bytes = 4;                  // Unknown chunk before data must be skipped
+    std::vector<int16_t> pcm = wav_test_ramp(channels, frames, first, step);
+    TEST_ASSERT_TRUE(wav_test_save(card_path, wav_test_pcm16(format, pcm.data(), pcm.size())));
+}
+
+static void start_render_engine(void) {
+    audio_engine_config_t config = {};
+    config.start_task = false;
+    TEST_ASSERT_TRUE(audio_engine_init(&config));
+    audio_engine_set_volume(100);
+    audio_engine_set_end_callback(on_track_end, nullptr);
+    audio_engine_set_track_callback(on_track_change, nullptr);
+}
+
+void setUp(void) {
+    std::string root = (std::filesystem::temp_directory_path() / "izod_test_audio_engine").string();
+    hal_storage_host_set_root(root.c_str());
+    hal_storage_init();
+    hal_storage_create_dir("/Music");
+    g_end_calls = 0;
+    g_track_calls = 0;
+}
+
+void tearDown(void) {
+    audio_engine_deinit();
+    std::filesystem::remove_all(hal_storage_host_get_root());
+    hal_storage_deinit();
+}
+
+void test_engine_renders_tone(void) {
+    start_render_engine();
+    audio_engine_set_volume(50);
+    TEST_ASSERT_TRUE(audio_engine_play_tone(1000));
+
+    static int16_t out[441 * 2];
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_PLAYING, audio_engine_get_state());
+    TEST_ASSERT_EQUAL(AUDIO_SOURCE_TONE, audio_engine_get_source_kind());
+
+    int peak = 0;
+    for (int i = 0; i < 441 * 2; i += 2) {
+        TEST_ASSERT_EQUAL(out[i], out[i + 1]);
+        if (abs(out[i]) > peak) peak = abs(out[i]);
+    }
+    // 10 full periods of 1 kHz at 44.1 kHz, scaled to 50%
+    TEST_ASSERT_INT_WITHIN(200, 16383, peak);
+}
+
+void test_engine_renders_stereo_wav_to_memory(void) {
+    write_ramp_wav("/Music/ramp.wav", 2, 44100, 1000);
+    start_render_engine();
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/ramp.wav"));
+
+    static int16_t out[1500 * 2];
+    TEST_ASSERT_EQUAL(1000, audio_engine_render(out, 1500));
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(i, out[i * 2]);
+        TEST_ASSERT_EQUAL(-i, out[i * 2 + 1]);
+    }
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, audio_engine_get_state());
+    TEST_ASSERT_EQUAL(1, g_end_calls);
+}
+
+void test_engine_expands_mono_wav(void) {
+    write_ramp_wav("/Music/mono.wav", 1, 44100, 300);
+    start_render_engine();
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/mono.wav"));
+
+    static int16_t out[300 * 2];
+    TEST_ASSERT_EQUAL(300, audio_engine_render(out, 300));
+    TEST_ASSERT_EQUAL(44100, audio_engine_get_sample_rate());
+    TEST_ASSERT_EQUAL(6, audio_engine_get_duration_ms());
+    for (int i = 0; i < 300; i++) {
+        TEST_ASSERT_EQUAL(i, out[i * 2]);
+        TEST_ASSERT_EQUAL(i, out[i * 2 + 1]);
+    }
+}
+
+void test_engine_seek_and_position(void) {
+    write_ramp_wav("/Music/seek.wav", 2, 44100, 44100);
+    start_render_engine();
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/seek.wav"));
+
+    static int16_t out[256 * 2];
+    audio_engine_render(out, 256);
+    TEST_ASSERT_TRUE(audio_engine_seek_ms(500));
+    TEST_ASSERT_EQUAL(256, audio_engine_render(out, 256));
+    TEST_ASSERT_EQUAL((int16_t)22050, out[0]);
+    TEST_ASSERT_EQUAL(505, audio_engine_get_position_ms());
+    TEST_ASSERT_EQUAL(1000, audio_engine_get_duration_ms());
+}
+
+void test_engine_pause_resume_stop(void) {
+    start_render_engine();
+    TEST_ASSERT_TRUE(audio_engine_play_tone(440));
+
+    static int16_t out[128 * 2];
+    TEST_ASSERT_EQUAL(128, audio_engine_render(out, 128));
+    audio_engine_pause();
+    TEST_ASSERT_EQUAL(0, audio_engine_render(out, 128));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_PAUSED, audio_engine_get_state());
+    audio_engine_resume();
+    TEST_ASSERT_EQUAL(128, audio_engine_render(out, 128));
+    audio_engine_stop();
+    TEST_ASSERT_EQUAL(0, audio_engine_render(out, 128));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, audio_engine_get_state());
+    TEST_ASSERT_EQUAL(0, g_end_calls);
+}
+
+void test_engine_loop_wraps_track(void) {
+    write_ramp_wav("/Music/loop.wav", 2, 44100, 100);
+    start_render_engine();
+    audio_engine_set_loop(true);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/loop.wav"));
+
+    static int16_t out[250 * 2];
+    TEST_ASSERT_EQUAL(250, audio_engine_render(out, 250));
+    TEST_ASSERT_EQUAL(99, out[99 * 2]);
+    TEST_ASSERT_EQUAL(0, out[100 * 2]);
+    TEST_ASSERT_EQUAL(49, out[249 * 2]);
+    TEST_ASSERT_EQUAL(0, g_end_calls);
+    audio_engine_set_loop(false);
+}
+
+void test_engine_rejects_bad_sources(void) {
+    start_render_engine();
+    TEST_ASSERT_FALSE(audio_engine_play_file("/Music/missing.wav"));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_ERROR_FILE_NOT_FOUND, audio_engine_get_last_error());
+    TEST_ASSERT_FALSE(audio_engine_play_file("/Music/notes.txt"));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_ERROR_INVALID_FORMAT, audio_engine_get_last_error());
+
+    // Exists and has the right extension, but is not a WAV
+    hal_storage_write_buffer_to_file("/Music/junk.wav", "not a wave file", 15);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/junk.wav"));
+    static int16_t out[64 * 2];
+    TEST_ASSERT_EQUAL(0, audio_engine_render(out, 64));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_ERROR, audio_engine_get_state());
+    TEST_ASSERT_EQUAL(HAL_AUDIO_ERROR_DECODE_FAILED, audio_engine_get_last_error());
+}
+
+void test_engine_plays_memory_buffer_through_hal_api(void) {
+    start_render_engine();
+    static const uint8_t pcm8[4] = {128, 255, 0, 192};
+    TEST_ASSERT_TRUE(hal_audio_play_buffer(pcm8, sizeof(pcm8), HAL_AUDIO_FORMAT_PCM_8BIT_MONO));
+
+    static int16_t out[8 * 2];
+    TEST_ASSERT_EQUAL(4, audio_engine_render(out, 8));
+    TEST_ASSERT_EQUAL(0, out[0]);
+    TEST_ASSERT_EQUAL(127 << 8, out[2]);
+    TEST_ASSERT_EQUAL(-128 * 256, out[4]);
+    TEST_ASSERT_EQUAL(64 << 8, out[7]);
+    TEST_ASSERT_FALSE(hal_audio_is_playing());
+}
+
+void test_engine_equalizer_through_hal_api(void) {
+    start_render_engine();
+    audio_engine_set_volume(25);
+    TEST_ASSERT_TRUE(audio_engine_play_tone(8000));
+
+    static int16_t out[4410 * 2];
+    auto peak = [&]() {
+        audio_engine_render(out, 4410);
+        int p = 0;
+        for (int i = 2205 * 2; i < 4410 * 2; i++) p = abs(out[i]) > p ? abs(out[i]) : p;
+        return p;
+    };
+    int flat = peak();
+    float bands[10] = {0, 0, 0, 0, 0, 0, 0, 0, 12.0f, 0};
+    hal_audio_set_equalizer(bands, 10);
+    TEST_ASSERT_INT_WITHIN(flat / 20, flat * 4, peak());
+    hal_audio_reset_effects();
+    TEST_ASSERT_INT_WITHIN(flat / 100, flat, peak());
+}
+
+void test_engine_gapless_splice_inserts_no_silence(void) {
+    // Neither ramp contains a zero sample, so any inserted silence shows up
+    write_ramp_wav("/Music/01.wav", 2, 44100, 1000, 1000);
+    write_ramp_wav("/Music/02.wav", 1, 44100, 700, 2000);
+    start_render_engine();
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/01.wav"));
+    TEST_ASSERT_TRUE(audio_engine_queue_next_file("/Music/02.wav"));
+
+    static int16_t out[2048 * 2];
+    uint32_t total = 0;
+    for (uint32_t n; (n = audio_engine_render(out + total * 2, 256)) > 0; ) total += n;
+
+    TEST_ASSERT_EQUAL(1700, total);
+    for (uint32_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(1000 + (int)i, out[i * 2]);
+        TEST_ASSERT_EQUAL(-(1000 + (int)i), out[i * 2 + 1]);
+    }
+    for (uint32_t i = 0; i < 700; i++) {
+        TEST_ASSERT_EQUAL(2000 + (int)i, out[(1000 + i) * 2]);
+        TEST_ASSERT_EQUAL(2000 + (int)i, out[(1000 + i) * 2 + 1]);
+    }
+
+    audio_engine_stats_t stats;
+    audio_engine_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.gapless_splices);
+    TEST_ASSERT_EQUAL(2, stats.tracks_opened);
+    TEST_ASSERT_EQUAL(1, g_track_calls);
+    TEST_ASSERT_EQUAL(1, g_end_calls);
+    TEST_ASSERT_FALSE(audio_engine_has_next());
+}
+
+void test_engine_position_follows_splice_and_end(void) {
+    write_ramp_wav("/Music/01.wav", 2, 44100, 44100, 1);
+    write_ramp_wav("/Music/02.wav", 2, 22050, 22050, 1);
+    start_render_engine();
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/01.wav"));
+    TEST_ASSERT_TRUE(audio_engine_queue_next_file("/Music/02.wav"));
+
+    // The splice falls inside a block; the new track counts from that frame
+    static int16_t out[256 * 2];
+    uint32_t total = 0;
+    while (total < 44100 + 22050) total += audio_engine_render(out, 256);
+    TEST_ASSERT_EQUAL(total, audio_engine_get_frames_played());
+    TEST_ASSERT_EQUAL((total - 44100) * 1000 / 44100, audio_engine_get_position_ms());
+    TEST_ASSERT_EQUAL(1000, audio_engine_get_duration_ms());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, audio_engine_get_progress());
+
+    // Once the tail is out, nothing is playing
+    while (audio_engine_render(out, 256) > 0) {
+    }
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, audio_engine_get_state());
+    TEST_ASSERT_EQUAL(0, audio_engine_get_position_ms());
+}
+
+void test_engine_gapless_rate_change_is_resampled(void) {
+    write_ramp_wav("/Music/a.wav", 2, 44100, 300, 1);
+    write_ramp_wav("/Music/b.wav", 2, 22050, 300, 1);
+    start_render_engine();
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/a.wav"));
+    TEST_ASSERT_TRUE(audio_engine_queue_next_file("/Music/b.wav"));
+
+    // The 22.05 kHz track comes out at twice the frames, in the same blocks
+    static int16_t out[1024 * 2];
+    uint32_t total = 0;
+    for (uint32_t n; (n = audio_engine_render(out + total * 2, 256)) > 0; ) total += n;
+    TEST_ASSERT_EQUAL(900, total);
+    TEST_ASSERT_EQUAL(22050, audio_engine_get_sample_rate());
+    TEST_ASSERT_EQUAL(44100, audio_engine_get_output_rate());
+
+    for (int i = 0; i < 300; i++) TEST_ASSERT_EQUAL(i + 1, out[i * 2]);
+    // Away from the edges every other output frame lands on a source frame
+    for (int k = 16; k < 280; k++) {
+        TEST_ASSERT_INT_WITHIN(1, k + 1, out[(300 + k * 2) * 2]);
+        TEST_ASSERT_INT_WITHIN(1, -(k + 1), out[(300 + k * 2) * 2 + 1]);
+    }
+    TEST_ASSERT_EQUAL(1, g_track_calls);
+    TEST_ASSERT_EQUAL(1, g_end_calls);
+}
+
+void test_engine_play_and_bad_next_drop_queue(void) {
+    write_ramp_wav("/Music/a.wav", 2, 44100, 100, 1);
+    write_ramp_wav("/Music/b.wav", 2, 44100, 100, 1);
+    start_render_engine();
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/a.wav"));
+    TEST_ASSERT_TRUE(audio_engine_queue_next_file("/Music/b.wav"));
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/a.wav"));
+
+    static int16_t out[512 * 2];
+    TEST_ASSERT_EQUAL(100, audio_engine_render(out, 512));
+    TEST_ASSERT_FALSE(audio_engine_has_next());
+    TEST_ASSERT_EQUAL(0, g_track_calls);
+
+    // A queued file that fails to open leaves the current track to end normally
+    hal_storage_write_buffer_to_file("/Music/junk.wav", "not a wave file", 15);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/a.wav"));
+    TEST_ASSERT_TRUE(audio_engine_queue_next_file("/Music/junk.wav"));
+    TEST_ASSERT_EQUAL(100, audio_engine_render(out, 512));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, audio_engine_get_state());
+    TEST_ASSERT_EQUAL(HAL_AUDIO_ERROR_DECODE_FAILED, audio_engine_get_last_error());
+    TEST_ASSERT_EQUAL(2, g_end_calls);
+}
+
+void test_engine_crossfade_on_play(void) {
+    write_ramp_wav("/Music/a.wav", 2, 44100, 44100, 10000, 0);
+    write_ramp_wav("/Music/b.wav", 2, 44100, 44100, 20000, 0);
+    write_ramp_wav("/Music/c.wav", 2, 44100, 500, 5000, 0);
+    start_render_engine();
+    audio_engine_set_crossfade_ms(100);
+    TEST_ASSERT_EQUAL(100, audio_engine_get_crossfade_ms());
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/a.wav"));
+
+    static int16_t out[8192 * 2];
+    TEST_ASSERT_EQUAL(1000, audio_engine_render(out, 1000));
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/b.wav"));
+    TEST_ASSERT_EQUAL(8192, audio_engine_render(out, 8192));
+
+    // 4410 frames from a alone to b alone, equal power at the midpoint
+    TEST_ASSERT_EQUAL(10000, out[0]);
+    TEST_ASSERT_EQUAL(-10000, out[1]);
+    TEST_ASSERT_INT_WITHIN(8, (10000 + 20000) * 23170 / 32768, out[2205 * 2]);
+    for (int i = 1; i < 4410; i++) {
+        // Never below either level, never above their power sum (22361)
+        TEST_ASSERT_TRUE(out[i * 2] >= 9999 && out[i * 2] <= 22370);
+        TEST_ASSERT_INT_WITHIN(1, -out[i * 2], out[i * 2 + 1]);
+    }
+    for (int i = 4410; i < 8192; i++) TEST_ASSERT_EQUAL(20000, out[i * 2]);
+    TEST_ASSERT_EQUAL_STRING("wav", audio_engine_get_decoder_name());
+    TEST_ASSERT_EQUAL(1000 * 8192 / 44100, audio_engine_get_position_ms());
+
+    // The fade handed the gapless slot back: a queued track splices as usual
+    audio_engine_set_crossfade_ms(0);
+    TEST_ASSERT_TRUE(audio_engine_queue_next_file("/Music/c.wav"));
+    uint32_t total = 0, last = 0;
+    for (uint32_t n; (n = audio_engine_render(out, 4096)) > 0; last = n) total += n;
+    TEST_ASSERT_EQUAL(44100 - 8192 + 500, total);
+    TEST_ASSERT_EQUAL(5000, out[(last - 1) * 2]);
+
+    audio_engine_stats_t stats;
+    audio_engine_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.crossfades);
+    TEST_ASSERT_EQUAL(1, stats.gapless_splices);
+    TEST_ASSERT_EQUAL(1, g_end_calls);
+
+    // Stopped or cut off mid-fade, nothing of the old tracks is left behind
+    audio_engine_set_crossfade_ms(100);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/a.wav"));
+    TEST_ASSERT_EQUAL(256, audio_engine_render(out, 256));
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/b.wav"));
+    TEST_ASSERT_EQUAL(256, audio_engine_render(out, 256));
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/c.wav"));
+    TEST_ASSERT_EQUAL(500, audio_engine_render(out, 8192));
+    TEST_ASSERT_EQUAL(5000, out[499 * 2]);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/a.wav"));
+    TEST_ASSERT_EQUAL(256, audio_engine_render(out, 256));
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/b.wav"));
+    TEST_ASSERT_EQUAL(256, audio_engine_render(out, 256));
+    audio_engine_stop();
+    TEST_ASSERT_EQUAL(0, audio_engine_render(out, 256));
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/c.wav"));
+    TEST_ASSERT_EQUAL(500, audio_engine_render(out, 8192));
+    TEST_ASSERT_EQUAL(5000, out[0]);
+}
+
+void test_engine_crossfade_into_queued_track(void) {
+    // The incoming track runs at another rate, through the second voice's resampler
+    write_ramp_wav("/Music/01.wav", 2, 44100, 44100, 10000, 0);
+    write_ramp_wav("/Music/02.wav", 2, 22050, 11025, 20000, 0);
+    start_render_engine();
+    audio_engine_set_crossfade_ms(200);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/01.wav"));
+    TEST_ASSERT_TRUE(audio_engine_queue_next_file("/Music/02.wav"));
+
+    static int16_t out[70000 * 2];
+    uint32_t total = 0;
+    for (uint32_t n; (n = audio_engine_render(out + total * 2, 256)) > 0; ) total += n;
+
+    // The second track starts within one block of 200 ms before the first ends
+    const uint32_t overlap = 44100 + 22050 - total;
+    TEST_ASSERT_TRUE(overlap <= 8820 && overlap > 8820 - 256);
+    const uint32_t start = 44100 - overlap;
+    for (uint32_t i = 0; i < start; i++) TEST_ASSERT_EQUAL(10000, out[i * 2]);
+    // Never a dip: 10000 fades against 20000
+    for (uint32_t i = start; i < start + overlap; i++) TEST_ASSERT_TRUE(out[i * 2] >= 9990);
+    TEST_ASSERT_INT_WITHIN(4, 20000, out[(start + overlap + 1000) * 2]);
+    TEST_ASSERT_INT_WITHIN(4, -20000, out[(start + overlap + 1000) * 2 + 1]);
+
+    audio_engine_stats_t stats;
+    audio_engine_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.crossfades);
+    TEST_ASSERT_EQUAL(0, stats.gapless_splices);
+    TEST_ASSERT_EQUAL(1, g_track_calls);
+    TEST_ASSERT_EQUAL(1, g_end_calls);
+}
+
+void test_engine_track_switches_do_not_allocate(void) {
+    write_ramp_wav("/Music/a.wav", 2, 44100, 44100, 1);
+    write_ramp_wav("/Music/b.wav", 1, 22050, 22050, 1);
+    write_ramp_wav("/Music/c.wav", 2, 48000, 48000, 1);
+    start_render_engine();
+    audio_engine_set_crossfade_ms(20);
+    const char* const tracks[] = {"/Music/a.wav", "/Music/b.wav", "/Music/c.wav"};
+
+    // Next/prev, with the fades, gapless queue, seeks and pauses around them
+    static int16_t out[256 * 2];
+    uint32_t allocations = hal_system_get_alloc_count();
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(audio_engine_play_file(tracks[i % 3]));
+        TEST_ASSERT_TRUE(audio_engine_queue_next_file(tracks[(i + 1) % 3]));
+        TEST_ASSERT_EQUAL(256, audio_engine_render(out, 256));
+        if (i % 4 == 0) TEST_ASSERT_TRUE(audio_engine_seek_ms(900));
+        if (i % 5 == 0) {
+            audio_engine_pause();
+            audio_engine_render(out, 256);
+            audio_engine_resume();
+        }
+        if (i % 3 == 0) TEST_ASSERT_TRUE(audio_engine_beep(880, 5));
+        audio_engine_render(out, 256);
+        if (i % 7 == 0) audio_engine_stop();
+    }
+    TEST_ASSERT_EQUAL(allocations, hal_system_get_alloc_count());
+
+    audio_engine_stats_t stats;
+    audio_engine_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1000, stats.tracks_opened);
+    TEST_ASSERT_GREATER_THAN(0, stats.crossfades);
+}
+
+void test_engine_beeps_over_music_and_while_paused(void) {
+    write_ramp_wav("/Music/flat.wav", 2, 44100, 44100, 1000, 0);
+    start_render_engine();
+    static int16_t out[441 * 2];
+
+    // Stopped: the beep renders on its own, then the engine falls quiet again
+    TEST_ASSERT_TRUE(audio_engine_beep(1000, 10));
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, audio_engine_get_state());
+    int peak = 0;
+    for (int i = 0; i < 441 * 2; i++) peak = abs(out[i]) > peak ? abs(out[i]) : peak;
+    TEST_ASSERT_GREATER_THAN(5000, peak);
+    int blocks = 0;
+    while (audio_engine_render(out, 441) > 0) TEST_ASSERT_LESS_THAN(10, ++blocks);
+
+    // Playing: the track carries on under it, sample for sample
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/flat.wav"));
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    TEST_ASSERT_EQUAL(1000, out[0]);
+    TEST_ASSERT_TRUE(audio_engine_beep(2000, 50));
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    peak = 0;
+    for (int i = 0; i < 441; i++) {
+        int beep = out[i * 2] - 1000;
+        TEST_ASSERT_EQUAL(beep, out[i * 2 + 1] + 1000);
+        peak = abs(beep) > peak ? abs(beep) : peak;
+    }
+    TEST_ASSERT_GREATER_THAN(5000, peak);
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_PLAYING, audio_engine_get_state());
+    TEST_ASSERT_EQUAL(20, audio_engine_get_position_ms());
+
+    // Paused: the beep plays, the position holds, and resume picks up there
+    audio_engine_pause();
+    TEST_ASSERT_TRUE(audio_engine_beep(1000, 10));
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_PAUSED, audio_engine_get_state());
+    TEST_ASSERT_EQUAL(20, audio_engine_get_position_ms());
+    audio_engine_resume();
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    TEST_ASSERT_EQUAL(30, audio_engine_get_position_ms());
+}
+
+void test_engine_task_feeds_hal_backend(void) {
+    hal_audio_config_t config = {};
+    config.sample_rate = 44100;
+    config.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+    config.volume = HAL_AUDIO_DEFAULT_VOLUME;
+    TEST_ASSERT_TRUE(hal_audio_init(&config));
+
+    audio_engine_config_t engine_config = {};
+    engine_config.start_task = true;
+    TEST_ASSERT_TRUE(audio_engine_init(&engine_config));
+
+    write_ramp_wav("/Music/task.wav", 1, 22050, 22050);
+    TEST_ASSERT_TRUE(hal_audio_play_file("/Music/task.wav"));
+    hal_system_delay_ms(150);
+    TEST_ASSERT_TRUE(hal_audio_is_playing());
+    // The source is resampled; the DAC stays at the output rate
+    TEST_ASSERT_EQUAL(22050, audio_engine_get_sample_rate());
+    TEST_ASSERT_EQUAL(44100, hal_audio_get_sample_rate());
+
+    // Switching sources reuses the same output; the ring keeps running
+    TEST_ASSERT_TRUE(audio_engine_play_tone(1000));
+    hal_system_delay_ms(100);
+    TEST_ASSERT_EQUAL(AUDIO_SOURCE_TONE, audio_engine_get_source_kind());
+    TEST_ASSERT_EQUAL(44100, hal_audio_get_sample_rate());
+
+    uint32_t played = 0, underruns = 0, overruns = 0;
+    hal_audio_get_stats(&played, &underruns, &overruns);
+    TEST_ASSERT_GREATER_THAN(0, played);
+    TEST_ASSERT_EQUAL(0, overruns);
+
+    hal_audio_stop();
+    hal_system_delay_ms(20);
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, hal_audio_get_state());
+
+    // A beep wakes the idle task, which writes it out and goes back to sleep
+    uint32_t written = hal_audio_get_frames_written();
+    TEST_ASSERT_TRUE(audio_engine_beep(1000, 20));
+    hal_system_delay_ms(150);
+    written = hal_audio_get_frames_written() - written;
+    TEST_ASSERT_GREATER_OR_EQUAL(44100 * 40 / 1000, written);
+    TEST_ASSERT_LESS_THAN(44100 * 40 / 1000 + 2 * AUDIO_ENGINE_BLOCK_FRAMES, written);
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, hal_audio_get_state());
+
+    audio_engine_deinit();
+    hal_audio_deinit();
+}
+
+void test_engine_task_splices_gaplessly(void) {
+    hal_audio_config_t config = {};
+    config.sample_rate = 44100;
+    config.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+    config.volume = HAL_AUDIO_DEFAULT_VOLUME;
+    TEST_ASSERT_TRUE(hal_audio_init(&config));
+
+    audio_engine_config_t engine_config = {};
+    engine_config.start_task = true;
+    TEST_ASSERT_TRUE(audio_engine_init(&engine_config));
+    audio_engine_set_volume(100);
+    static std::vector<int16_t> rendered;
+    rendered.clear();
+    audio_engine_set_data_callback(on_rendered, &rendered);
+
+    write_ramp_wav("/Music/01.wav", 2, 44100, 3000, 1);
+    write_ramp_wav("/Music/02.wav", 2, 44100, 2000, 3001);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/01.wav"));
+    TEST_ASSERT_TRUE(audio_engine_queue_next_file("/Music/02.wav"));
+    for (int i = 0; i < 100 && audio_engine_get_state() != HAL_AUDIO_STATE_PLAYING; i++) {
+        hal_system_delay_ms(1);
+    }
+    for (int i = 0; i < 100 && audio_engine_get_state() != HAL_AUDIO_STATE_STOPPED; i++) {
+        hal_system_delay_ms(10);
+    }
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, audio_engine_get_state());
+
+    // One continuous ramp across the track boundary
+    TEST_ASSERT_EQUAL(5000 * 2, rendered.size());
+    for (int i = 0; i < 5000; i++) TEST_ASSERT_EQUAL(i + 1, rendered[i * 2]);
+    audio_engine_stats_t stats;
+    audio_engine_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.gapless_splices);
+
+    audio_engine_deinit();
+    hal_audio_deinit();
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_engine_renders_tone);
+    RUN_TEST(test_engine_renders_stereo_wav_to_memory);
+    RUN_TEST(test_engine_expands_mono_wav);
+    RUN_TEST(test_engine_seek_and_position);
+    RUN_TEST(test_engine_pause_resume_stop);
+    RUN_TEST(test_engine_loop_wraps_track);
+    RUN_TEST(test_engine_rejects_bad_sources);
+    RUN_TEST(test_engine_plays_memory_buffer_through_hal_api);
+    RUN_TEST(test_engine_equalizer_through_hal_api);
+    RUN_TEST(test_engine_gapless_splice_inserts_no_silence);
+    RUN_TEST(test_engine_position_follows_splice_and_end);
+    RUN_TEST(test_engine_gapless_rate_change_is_resampled);
+    RUN_TEST(test_engine_play_and_bad_next_drop_queue);
+    RUN_TEST(test_engine_crossfade_on_play);
+    RUN_TEST(test_engine_crossfade_into_queued_track);
+    RUN_TEST(test_engine_track_switches_do_not_allocate);
+    RUN_TEST(test_engine_beeps_over_music_and_while_paused);
+    RUN_TEST(test_engine_task_feeds_hal_backend);
+    RUN_TEST(test_engine_task_splices_gaplessly);
+
+    return UNITY_END();
+}
@@ -0,0 +1,174 @@
+/*
+ * Audio Equalizer Tests
+ * Band and shelf response, bypass, and coefficient swaps while streaming
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "audio/audio_eq.h"
+
+#define TEST_RATE   44100
+#define TEST_BLOCK  256
+
+static audio_eq_t g_eq;
+
+// Runs a one-second stereo sine through the EQ and returns the gain in dB,
+// measured over the second half once the filters have settled
+static float measure_gain_db(float hz) {
+    std::vector<int16_t> block(TEST_BLOCK * 2);
+    const float amplitude = 4000.0f;
+    double in_power = 0.0, out_power = 0.0;
+    for (uint32_t start = 0; start < TEST_RATE; start += TEST_BLOCK) {
+        for (uint32_t i = 0; i < TEST_BLOCK; i++) {
+            int16_t s = (int16_t)lrintf(amplitude * sinf(2.0f * (float)M_PI * hz * (float)(start + i) / TEST_RATE));
+            block[i * 2] = s;
+            block[i * 2 + 1] = s;
+            if (start >= TEST_RATE / 2) in_power += (double)s * s;
+        }
+        audio_eq_process(&g_eq, block.data(), TEST_BLOCK);
+        if (start >= TEST_RATE / 2) {
+            for (uint32_t i = 0; i < TEST_BLOCK; i++) {
+                TEST_ASSERT_EQUAL(block[i * 2], block[i * 2 + 1]);
+                out_power += (double)block[i * 2] * block[i * 2];
+            }
+        }
+    }
+    return (float)(10.0 * log10(out_power / in_power));
+}
+
+void setUp(void) {
+    audio_eq_init(&g_eq, TEST_RATE);
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+void test_eq_flat_is_bit_exact(void) {
+    int16_t block[64 * 2];
+    for (int i = 0; i < 64 * 2; i++) block[i] = (int16_t)(i * 517 - 30000);
+    int16_t copy[64 * 2];
+    memcpy(copy, block, sizeof(block));
+
+    TEST_ASSERT_TRUE(audio_eq_is_flat(&g_eq));
+    audio_eq_process(&g_eq, block, 64);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(copy, block, 64 * 2);
+
+    // Setting every band to 0 dB keeps every stage bypassed
+    const float zero[AUDIO_EQ_BANDS] = {};
+    audio_eq_set_bands(&g_eq, zero, AUDIO_EQ_BANDS);
+    audio_eq_set_bass(&g_eq, 0.01f);
+    TEST_ASSERT_TRUE(audio_eq_is_flat(&g_eq));
+    audio_eq_process(&g_eq, block, 64);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(copy, block, 64 * 2);
+}
+
+void test_eq_band_boost_is_local(void) {
+    float bands[AUDIO_EQ_BANDS] = {};
+    bands[5] = 6.0f;    // 1 kHz
+    audio_eq_set_bands(&g_eq, bands, AUDIO_EQ_BANDS);
+    TEST_ASSERT_FALSE(audio_eq_is_flat(&g_eq));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 6.0f, measure_gain_db(1000.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, measure_gain_db(125.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, measure_gain_db(8000.0f));
+}
+
+void test_eq_lowest_band_cut(void) {
+    // 31 Hz poles sit right on the unit circle; quantization must not detune them
+    float bands[AUDIO_EQ_BANDS] = {};
+    bands[0] = -12.0f;
+    audio_eq_set_bands(&g_eq, bands, AUDIO_EQ_BANDS);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, -12.0f, measure_gain_db(31.25f));
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 0.0f, measure_gain_db(1000.0f));
+}
+
+void test_eq_shelves(void) {
+    audio_eq_set_bass(&g_eq, 9.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 9.0f, measure_gain_db(40.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 0.0f, measure_gain_db(5000.0f));
+
+    audio_eq_set_bass(&g_eq, 0.0f);
+    audio_eq_set_treble(&g_eq, 6.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 6.0f, measure_gain_db(16000.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 0.0f, measure_gain_db(200.0f));
+}
+
+void test_eq_gain_is_clamped(void) {
+    float bands[AUDIO_EQ_BANDS] = {};
+    bands[5] = 40.0f;
+    audio_eq_set_bands(&g_eq, bands, AUDIO_EQ_BANDS);
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, AUDIO_EQ_MAX_GAIN_DB, measure_gain_db(1000.0f));
+    TEST_ASSERT_EQUAL_FLOAT(AUDIO_EQ_MAX_GAIN_DB, g_eq.band_db[5]);
+}
+
+void test_eq_swap_mid_stream_does_not_click(void) {
+    // A 1 kHz sine at 4000 moves at most ~570 per sample, ~2300 at +12 dB
+    float bands[AUDIO_EQ_BANDS] = {};
+    int16_t block[TEST_BLOCK * 2];
+    int16_t last = 0;
+    int max_step = 0;
+    for (uint32_t b = 0; b < 200; b++) {
+        if (b >= 20) {
+            bands[5] = (b & 1) ? 12.0f : -12.0f;
+            audio_eq_set_bands(&g_eq, bands, AUDIO_EQ_BANDS);
+        }
+        for (uint32_t i = 0; i < TEST_BLOCK; i++) {
+            uint32_t n = b * TEST_BLOCK + i;
+            int16_t s = (int16_t)lrintf(4000.0f * sinf(2.0f * (float)M_PI * 1000.0f * n / TEST_RATE));
+            block[i * 2] = s;
+            block[i * 2 + 1] = s;
+        }
+        audio_eq_process(&g_eq, block, TEST_BLOCK);
+        for (uint32_t i = 0; i < TEST_BLOCK; i++) {
+            int step = abs(block[i * 2] - last);
+            if (step > max_step) max_step = step;
+            last = block[i * 2];
+        }
+    }
+    TEST_ASSERT_LESS_THAN(3000, max_step);
+}
+
+void test_eq_concurrent_updates(void) {
+    // A torn coefficient set would make the cascade unstable and slam the rails
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        float bands[AUDIO_EQ_BANDS];
+        for (int n = 0; !done.load(); n++) {
+            for (int b = 0; b < AUDIO_EQ_BANDS; b++) bands[b] = (float)(((n + b) % 25) - 12);
+            audio_eq_set_bands(&g_eq, bands, AUDIO_EQ_BANDS);
+        }
+    });
+
+    int16_t block[TEST_BLOCK * 2];
+    int peak = 0;
+    for (uint32_t b = 0; b < 2000; b++) {
+        for (uint32_t i = 0; i < TEST_BLOCK * 2; i++) block[i] = (int16_t)((i * 37 + b * 11) % 200 - 100);
+        audio_eq_process(&g_eq, block, TEST_BLOCK);
+        for (uint32_t i = 0; i < TEST_BLOCK * 2; i++) {
+            if (abs(block[i]) > peak) peak = abs(block[i]);
+        }
+    }
+    done = true;
+    writer.join();
+    TEST_ASSERT_LESS_THAN(32767, peak);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_eq_flat_is_bit_exact);
+    RUN_TEST(test_eq_band_boost_is_local);
+    RUN_TEST(test_eq_lowest_band_cut);
+    RUN_TEST(test_eq_shelves);
+    RUN_TEST(test_eq_gain_is_clamped);
+    RUN_TEST(test_eq_swap_mid_stream_does_not_click);
+    RUN_TEST(test_eq_concurrent_updates);
+
+    return UNITY_END();
+}
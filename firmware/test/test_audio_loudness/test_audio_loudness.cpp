@@ -0,0 +1,436 @@
+/*
+ * Audio Loudness Tests
+ * R128 meter against EBU Tech 3341 cases, ReplayGain tags, the record cache,
+ * the indexing job and the gain the engine applies
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "audio/audio_loudness.h"
+#include "audio/audio_engine.h"
+#include "audio/audio_dsp.h"
+#include "hal/hal_storage.h"
+#include "hal/hal_system.h"
+#include "../wav_test_writer.h"
+
+static const double k_pi = 3.14159265358979323846;
+
+static void put_be32(std::vector<uint8_t>& v, uint32_t x) {
+    for (int i = 3; i >= 0; i--) v.push_back((x >> (8 * i)) & 0xFF);
+}
+
+static void write_file(const char* card_path, const std::vector<uint8_t>& v) {
+    hal_storage_file_t f = hal_storage_open(card_path, HAL_STORAGE_MODE_WRITE);
+    TEST_ASSERT_NOT_NULL(f);
+    hal_storage_write(f, v.data(), v.size());
+    hal_storage_close(f);
+}
+
+// Appends seconds of a 1 kHz sine at dbfs (peak) to interleaved stereo; right is silent when mono_left
+static void append_sine(std::vector<int16_t>& pcm, uint32_t rate, double seconds, double dbfs,
+                        bool mono_left = false) {
+    double amplitude = 32767.0 * pow(10.0, dbfs / 20.0);
+    size_t start = pcm.size() / 2;
+    size_t frames = (size_t)(seconds * rate);
+    for (size_t i = 0; i < frames; i++) {
+        int16_t s = (int16_t)lrint(amplitude * sin(2.0 * k_pi * 1000.0 * (double)(start + i) / rate));
+        pcm.push_back(s);
+        pcm.push_back(mono_left ? 0 : s);
+    }
+}
+
+static void write_wav(const char* card_path, const std::vector<int16_t>& pcm, uint32_t rate) {
+    wav_test_format_t format;
+    format.rate = rate;
+    write_file(card_path, wav_test_pcm16(format, pcm.data(), pcm.size()));
+}
+
+// "fLaC", an empty STREAMINFO and a VORBIS_COMMENT block; enough for the tag reader
+static void write_tagged_flac(const char* card_path, const std::vector<std::string>& comments) {
+    std::vector<uint8_t> v = {'f', 'L', 'a', 'C', 0x00, 0x00, 0x00, 34};
+    v.resize(v.size() + 34, 0);
+    std::vector<uint8_t> block;
+    wav_test_le32(block, 6);
+    block.insert(block.end(), {'v', 'e', 'n', 'd', 'o', 'r'});
+    wav_test_le32(block, (uint32_t)comments.size());
+    for (const std::string& c : comments) {
+        wav_test_le32(block, (uint32_t)c.size());
+        block.insert(block.end(), c.begin(), c.end());
+    }
+    v.insert(v.end(), {0x84, (uint8_t)(block.size() >> 16), (uint8_t)(block.size() >> 8), (uint8_t)block.size()});
+    v.insert(v.end(), block.begin(), block.end());
+    write_file(card_path, v);
+}
+
+// ID3v2.3 TXXX frame with a UTF-16 (BOM) description and value
+static void put_txxx_utf16(std::vector<uint8_t>& v, const char* key, const char* value) {
+    std::vector<uint8_t> body = {1};
+    for (const char* s : {key, value}) {
+        body.insert(body.end(), {0xFF, 0xFE});
+        for (const char* c = s; *c; c++) body.insert(body.end(), {(uint8_t)*c, 0});
+        body.insert(body.end(), {0, 0});
+    }
+    v.insert(v.end(), {'T', 'X', 'X', 'X'});
+    put_be32(v, (uint32_t)body.size());
+    v.insert(v.end(), {0, 0});
+    v.insert(v.end(), body.begin(), body.end());
+}
+
+// ID3v2.3 tag around the frames, padded
+static std::vector<uint8_t> id3_tag(std::vector<uint8_t> frames) {
+    frames.resize(frames.size() + 64, 0);
+    std::vector<uint8_t> v = {'I', 'D', '3', 3, 0, 0};
+    uint32_t size = (uint32_t)frames.size();
+    v.insert(v.end(), {(uint8_t)((size >> 21) & 0x7F), (uint8_t)((size >> 14) & 0x7F),
+                       (uint8_t)((size >> 7) & 0x7F), (uint8_t)(size & 0x7F)});
+    v.insert(v.end(), frames.begin(), frames.end());
+    return v;
+}
+
+// Ten-byte frame header and a body of zeros
+static void put_frame(std::vector<uint8_t>& v, const char* id, uint32_t size) {
+    v.insert(v.end(), id, id + 4);
+    put_be32(v, size);
+    v.insert(v.end(), {0, 0});
+    v.resize(v.size() + size, 0);
+}
+
+// ReplayGain frames between many small ones, cover art after them
+static void write_tagged_mp3(const char* card_path, uint32_t art_bytes = 0) {
+    std::vector<uint8_t> frames;
+    // An unrelated frame first
+    frames.insert(frames.end(), {'T', 'I', 'T', '2', 0, 0, 0, 4, 0, 0, 0, 'a', 'b', 'c'});
+    for (int i = 0; i < 40; i++) put_frame(frames, "PRIV", 24);
+    put_txxx_utf16(frames, "replaygain_track_gain", "-7.25 dB");
+    put_txxx_utf16(frames, "replaygain_track_peak", "0.891251");
+    if (art_bytes) put_frame(frames, "APIC", art_bytes);
+
+    std::vector<uint8_t> v = id3_tag(frames);
+    v.insert(v.end(), {0xFF, 0xFB, 0x90, 0x00});
+    v.resize(v.size() + 413, 0);
+    write_file(card_path, v);
+}
+
+static float measure(const std::vector<int16_t>& pcm, uint32_t rate, uint16_t channels) {
+    static audio_loudness_meter_t meter;
+    TEST_ASSERT_TRUE(audio_loudness_meter_init(&meter, rate, channels));
+    // Uneven pieces, as the decoders deliver them
+    size_t frames = pcm.size() / 2;
+    for (size_t pos = 0; pos < frames;) {
+        size_t n = frames - pos < 1152 ? frames - pos : 1152;
+        audio_loudness_meter_feed(&meter, pcm.data() + pos * 2, n);
+        pos += n;
+    }
+    return audio_loudness_meter_integrated(&meter);
+}
+
+static void run_job(const char* root) {
+    audio_loudness_job_config_t config = {};
+    config.root = root;
+    TEST_ASSERT_TRUE(audio_loudness_job_start(&config));
+    int steps = 0;
+    while (audio_loudness_job_step()) TEST_ASSERT_TRUE(++steps < 10000);
+    TEST_ASSERT_FALSE(audio_loudness_job_is_running());
+}
+
+void setUp(void) {
+    std::string root = (std::filesystem::temp_directory_path() / "izod_test_audio_loudness").string();
+    hal_storage_host_set_root(root.c_str());
+    hal_storage_init();
+    hal_storage_create_dir("/Music");
+}
+
+void tearDown(void) {
+    audio_loudness_job_stop();
+    audio_engine_deinit();
+    std::filesystem::remove_all(hal_storage_host_get_root());
+    hal_storage_deinit();
+}
+
+// Tech 3341 case 1: stereo 1 kHz at -23 dBFS reads -23.0 LUFS, at 48 and 44.1 kHz
+void test_meter_reads_reference_tone(void) {
+    for (uint32_t rate : {48000u, 44100u}) {
+        std::vector<int16_t> pcm;
+        append_sine(pcm, rate, 20.0, -23.0);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, -23.0f, measure(pcm, rate, 2));
+    }
+}
+
+// One channel is 3 dB down on two; an upmixed mono source is measured once
+void test_meter_counts_mono_once(void) {
+    std::vector<int16_t> left_only;
+    append_sine(left_only, 48000, 10.0, -20.0, true);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -23.0f, measure(left_only, 48000, 2));
+
+    std::vector<int16_t> upmixed;
+    append_sine(upmixed, 48000, 10.0, -20.0);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -23.0f, measure(upmixed, 48000, 1));
+}
+
+// Tech 3341 case 3: -36 / -23 / -36 dBFS for 10 / 60 / 10 s; the relative gate drops the quiet parts
+void test_meter_relative_gate(void) {
+    std::vector<int16_t> pcm;
+    append_sine(pcm, 48000, 10.0, -36.0);
+    append_sine(pcm, 48000, 60.0, -23.0);
+    append_sine(pcm, 48000, 10.0, -36.0);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -23.0f, measure(pcm, 48000, 2));
+
+    // Tech 3341 case 5: the -72 dBFS part falls under the absolute gate
+    pcm.clear();
+    append_sine(pcm, 48000, 20.0, -26.0);
+    append_sine(pcm, 48000, 20.1, -20.0);
+    append_sine(pcm, 48000, 20.0, -26.0);
+    append_sine(pcm, 48000, 10.0, -72.0);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -23.0f, measure(pcm, 48000, 2));
+}
+
+void test_meter_silence_and_peak(void) {
+    std::vector<int16_t> pcm(48000 * 2 * 2, 0);
+    static audio_loudness_meter_t meter;
+    TEST_ASSERT_TRUE(audio_loudness_meter_init(&meter, 48000, 2));
+    audio_loudness_meter_feed(&meter, pcm.data(), pcm.size() / 2);
+    TEST_ASSERT_EQUAL_FLOAT(AUDIO_LOUDNESS_FLOOR_LUFS, audio_loudness_meter_integrated(&meter));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, audio_loudness_meter_peak(&meter));
+
+    pcm[1001] = -16384;
+    audio_loudness_meter_feed(&meter, pcm.data(), pcm.size() / 2);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, audio_loudness_meter_peak(&meter));
+}
+
+void test_tags_from_flac_and_id3(void) {
+    write_tagged_flac("/Music/a.flac", {"TITLE=x", "REPLAYGAIN_TRACK_GAIN=-3.50 dB", "REPLAYGAIN_TRACK_PEAK=0.95",
+                                        "replaygain_album_gain=-4.25 dB", std::string(400, 'c')});
+    audio_loudness_t loudness;
+    TEST_ASSERT_TRUE(audio_loudness_read_tags("/Music/a.flac", &loudness, nullptr));
+    TEST_ASSERT_TRUE(loudness.has_track);
+    TEST_ASSERT_TRUE(loudness.has_album);
+    TEST_ASSERT_FALSE(loudness.measured);
+    TEST_ASSERT_EQUAL_FLOAT(-3.5f, loudness.track_gain_db);
+    TEST_ASSERT_EQUAL_FLOAT(0.95f, loudness.track_peak);
+    TEST_ASSERT_EQUAL_FLOAT(-4.25f, loudness.album_gain_db);
+    // No album peak: bounded by the track's
+    TEST_ASSERT_EQUAL_FLOAT(0.95f, loudness.album_peak);
+
+    write_tagged_mp3("/Music/b.mp3");
+    TEST_ASSERT_TRUE(audio_loudness_read_tags("/Music/b.mp3", &loudness, nullptr));
+    TEST_ASSERT_EQUAL_FLOAT(-7.25f, loudness.track_gain_db);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.891251f, loudness.track_peak);
+    TEST_ASSERT_FALSE(loudness.has_album);
+
+    write_tagged_flac("/Music/c.flac", {"TITLE=x"});
+    TEST_ASSERT_FALSE(audio_loudness_read_tags("/Music/c.flac", &loudness, nullptr));
+}
+
+// The tags are read when a track is opened, on the engine task: however many
+// frames the ID3 tag holds, the file head is one read
+void test_tags_read_in_one_read(void) {
+    write_tagged_mp3("/Music/art.mp3", 300000);
+    uint32_t reads;
+    hal_storage_reset_stats();
+    audio_loudness_t loudness;
+    TEST_ASSERT_TRUE(audio_loudness_lookup("/Music/art.mp3", &loudness, nullptr));
+    TEST_ASSERT_EQUAL_FLOAT(-7.25f, loudness.track_gain_db);
+    hal_storage_get_stats(&reads, nullptr, nullptr, nullptr);
+    TEST_ASSERT_EQUAL_UINT32(1, reads);
+
+    // FLAC behind an ID3 tag larger than the read: one more for its metadata
+    std::vector<uint8_t> frames;
+    put_frame(frames, "APIC", AUDIO_LOUDNESS_TAG_READ_BYTES * 2);
+    std::vector<uint8_t> v = id3_tag(frames);
+    write_tagged_flac("/Music/d.flac", {"REPLAYGAIN_TRACK_GAIN=+1.5 dB", "REPLAYGAIN_TRACK_PEAK=0.5"});
+    hal_storage_file_t f = hal_storage_open("/Music/d.flac", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_NOT_NULL(f);
+    size_t flac_start = v.size();
+    v.resize(flac_start + 1024);
+    v.resize(flac_start + hal_storage_read(f, v.data() + flac_start, 1024));
+    hal_storage_close(f);
+    write_file("/Music/d.flac", v);
+
+    hal_storage_reset_stats();
+    TEST_ASSERT_TRUE(audio_loudness_lookup("/Music/d.flac", &loudness, nullptr));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, loudness.track_gain_db);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, loudness.track_peak);
+    hal_storage_get_stats(&reads, nullptr, nullptr, nullptr);
+    TEST_ASSERT_EQUAL_UINT32(2, reads);
+}
+
+void test_cache_roundtrip_and_invalidation(void) {
+    std::vector<int16_t> pcm;
+    append_sine(pcm, 44100, 1.0, -20.0);
+    write_wav("/Music/t.wav", pcm, 44100);
+
+    audio_loudness_t loudness = {};
+    TEST_ASSERT_FALSE(audio_loudness_load("/Music/t.wav", &loudness));
+    loudness.has_track = true;
+    loudness.measured = true;
+    loudness.track_gain_db = 2.5f;
+    loudness.track_peak = 0.1f;
+    TEST_ASSERT_TRUE(audio_loudness_save("/Music/t.wav", &loudness, nullptr));
+
+    audio_loudness_t loaded;
+    TEST_ASSERT_TRUE(audio_loudness_load("/Music/t.wav", &loaded));
+    TEST_ASSERT_TRUE(loaded.has_track && loaded.measured && !loaded.has_album);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, loaded.track_gain_db);
+    TEST_ASSERT_TRUE(audio_loudness_lookup("/Music/t.wav", &loaded, nullptr));
+
+    // A rewritten file of another size is a different track
+    pcm.resize(pcm.size() / 2);
+    write_wav("/Music/t.wav", pcm, 44100);
+    TEST_ASSERT_FALSE(audio_loudness_load("/Music/t.wav", &loaded));
+    TEST_ASSERT_FALSE(audio_loudness_lookup("/Music/t.wav", &loaded, nullptr));
+}
+
+void test_gain_modes_and_clip_prevention(void) {
+    audio_loudness_t loudness = {};
+    TEST_ASSERT_EQUAL(AUDIO_DSP_Q15_ONE, audio_loudness_gain_q15(&loudness, AUDIO_REPLAY_GAIN_TRACK, 0.0f));
+
+    loudness.has_track = true;
+    loudness.track_gain_db = -6.0f;
+    loudness.track_peak = 1.0f;
+    TEST_ASSERT_EQUAL(AUDIO_DSP_Q15_ONE, audio_loudness_gain_q15(&loudness, AUDIO_REPLAY_GAIN_OFF, 0.0f));
+    TEST_ASSERT_EQUAL(audio_dsp_gain_from_db(-6.0f), audio_loudness_gain_q15(&loudness, AUDIO_REPLAY_GAIN_TRACK, 0.0f));
+    // Album mode without an album gain uses the track's
+    TEST_ASSERT_EQUAL(audio_dsp_gain_from_db(-6.0f), audio_loudness_gain_q15(&loudness, AUDIO_REPLAY_GAIN_ALBUM, 0.0f));
+
+    loudness.has_album = true;
+    loudness.album_gain_db = 3.0f;
+    loudness.album_peak = 0.5f;
+    TEST_ASSERT_EQUAL(audio_dsp_gain_from_db(3.0f), audio_loudness_gain_q15(&loudness, AUDIO_REPLAY_GAIN_ALBUM, 0.0f));
+    // +3 dB preamp would lift the 0.5 peak past full scale: held at +6.02 dB
+    TEST_ASSERT_EQUAL(audio_dsp_gain_from_db(-20.0f * log10f(0.5f)),
+                      audio_loudness_gain_q15(&loudness, AUDIO_REPLAY_GAIN_ALBUM, 6.0f));
+}
+
+// Two tracks 10 dB apart form one album; a fully tagged folder is not decoded
+void test_job_measures_tracks_and_albums(void) {
+    hal_storage_create_dir("/Music/Album");
+    hal_storage_create_dir("/Music/Tagged");
+    std::vector<int16_t> loud, quiet;
+    append_sine(loud, 44100, 3.0, -20.0);
+    append_sine(quiet, 44100, 3.0, -30.0);
+    write_wav("/Music/Album/01.wav", loud, 44100);
+    write_wav("/Music/Album/02.wav", quiet, 44100);
+    write_tagged_flac("/Music/Tagged/01.flac", {"REPLAYGAIN_TRACK_GAIN=1.00 dB", "REPLAYGAIN_ALBUM_GAIN=2.00 dB"});
+
+    run_job("/Music");
+    audio_loudness_progress_t progress;
+    audio_loudness_job_get_progress(&progress);
+    TEST_ASSERT_FALSE(progress.running);
+    TEST_ASSERT_EQUAL(2, progress.measured);
+    TEST_ASSERT_EQUAL(1, progress.tagged);
+    TEST_ASSERT_EQUAL(0, progress.failed);
+    TEST_ASSERT_EQUAL(1, progress.albums);
+
+    audio_loudness_t a, b, c;
+    TEST_ASSERT_TRUE(audio_loudness_load("/Music/Album/01.wav", &a));
+    TEST_ASSERT_TRUE(audio_loudness_load("/Music/Album/02.wav", &b));
+    TEST_ASSERT_TRUE(audio_loudness_load("/Music/Tagged/01.flac", &c));
+    // -20 dBFS stereo sine is -20 LUFS: +2 dB to the -18 LUFS reference
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 2.0f, a.track_gain_db);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 12.0f, b.track_gain_db);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.1f, a.track_peak);
+    // Equal time at -20 and -30 LUFS averages to -22.6 LUFS
+    TEST_ASSERT_TRUE(a.has_album && b.has_album);
+    TEST_ASSERT_FLOAT_WITHIN(0.15f, 4.6f, a.album_gain_db);
+    TEST_ASSERT_EQUAL_FLOAT(a.album_gain_db, b.album_gain_db);
+    TEST_ASSERT_EQUAL_FLOAT(a.track_peak, b.album_peak);
+    TEST_ASSERT_FALSE(c.measured);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, c.album_gain_db);
+
+    // A second run finds every record and measures nothing
+    run_job("/Music");
+    audio_loudness_job_get_progress(&progress);
+    TEST_ASSERT_EQUAL(3, progress.cached);
+    TEST_ASSERT_EQUAL(0, progress.measured);
+    TEST_ASSERT_EQUAL(0, progress.albums);
+}
+
+// Stopped half way, the job keeps finished tracks and picks up with the rest
+void test_job_resumes_after_stop(void) {
+    std::vector<int16_t> pcm;
+    append_sine(pcm, 44100, 2.0, -20.0);
+    write_wav("/Music/1.wav", pcm, 44100);
+    write_wav("/Music/2.wav", pcm, 44100);
+
+    audio_loudness_job_config_t config = {};
+    config.root = "/Music";
+    TEST_ASSERT_TRUE(audio_loudness_job_start(&config));
+    audio_loudness_progress_t progress;
+    do {
+        TEST_ASSERT_TRUE(audio_loudness_job_step());
+        audio_loudness_job_get_progress(&progress);
+    } while (progress.measured == 0);
+    audio_loudness_job_stop();
+
+    run_job("/Music");
+    audio_loudness_job_get_progress(&progress);
+    TEST_ASSERT_EQUAL(1, progress.cached);
+    TEST_ASSERT_EQUAL(1, progress.measured);
+    TEST_ASSERT_EQUAL(1, progress.albums);
+    audio_loudness_t loudness;
+    TEST_ASSERT_TRUE(audio_loudness_load("/Music/1.wav", &loudness));
+    TEST_ASSERT_TRUE(loudness.has_album);
+}
+
+static int peak_of(const int16_t* samples, size_t count) {
+    int peak = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (abs(samples[i]) > peak) peak = abs(samples[i]);
+    }
+    return peak;
+}
+
+// The engine applies the cached gain from the first block and follows mode changes
+void test_engine_applies_replay_gain(void) {
+    std::vector<int16_t> pcm;
+    append_sine(pcm, AUDIO_SAMPLE_RATE, 1.0, -6.0);     // Peak 16384
+    write_wav("/Music/g.wav", pcm, AUDIO_SAMPLE_RATE);
+    audio_loudness_t loudness = {};
+    loudness.has_track = true;
+    loudness.track_gain_db = -6.0206f;
+    loudness.track_peak = 0.5f;
+    TEST_ASSERT_TRUE(audio_loudness_save("/Music/g.wav", &loudness, nullptr));
+
+    audio_engine_config_t config = {};
+    config.start_task = false;
+    config.replay_gain = AUDIO_REPLAY_GAIN_TRACK;
+    TEST_ASSERT_TRUE(audio_engine_init(&config));
+    audio_engine_set_volume(100);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/g.wav"));
+
+    static int16_t out[441 * 2];
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    TEST_ASSERT_INT_WITHIN(40, 8192, peak_of(out, 441 * 2));
+
+    audio_engine_set_replay_gain(AUDIO_REPLAY_GAIN_OFF, 0.0f);
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    TEST_ASSERT_INT_WITHIN(40, 16384, peak_of(out, 441 * 2));
+
+    // +12 dB of preamp stops where the 0.5 peak reaches full scale
+    audio_engine_set_replay_gain(AUDIO_REPLAY_GAIN_TRACK, 12.0f);
+    TEST_ASSERT_EQUAL(AUDIO_REPLAY_GAIN_TRACK, audio_engine_get_replay_gain());
+    TEST_ASSERT_EQUAL(441, audio_engine_render(out, 441));
+    TEST_ASSERT_INT_WITHIN(80, 32767, peak_of(out, 441 * 2));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_meter_reads_reference_tone);
+    RUN_TEST(test_meter_counts_mono_once);
+    RUN_TEST(test_meter_relative_gate);
+    RUN_TEST(test_meter_silence_and_peak);
+    RUN_TEST(test_tags_from_flac_and_id3);
+    RUN_TEST(test_tags_read_in_one_read);
+    RUN_TEST(test_cache_roundtrip_and_invalidation);
+    RUN_TEST(test_gain_modes_and_clip_prevention);
+    RUN_TEST(test_job_measures_tracks_and_albums);
+    RUN_TEST(test_job_resumes_after_stop);
+    RUN_TEST(test_engine_applies_replay_gain);
+
+    return UNITY_END();
+}
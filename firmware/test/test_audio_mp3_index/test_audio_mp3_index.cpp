@@ -0,0 +1,429 @@
+/*
+ * MP3 Seek Index Tests
+ * Header parsing, Xing/Info/VBRI tags, header scans, bounded seeks, the table
+ * cache and header-only probing
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "audio/audio_mp3_index.h"
+#include "audio/audio_loudness.h"
+#include "hal/hal_storage.h"
+#include "hal/hal_system.h"
+
+// Synthetic stream: real frame headers around payload that never contains 0xFF
+struct mp3_file {
+    std::vector<uint8_t> bytes;
+    std::vector<uint64_t> frames;           // Offset of every audio frame
+};
+
+static audio_mp3_index_t g_index;
+
+static void put_be32(uint8_t* p, uint32_t x) {
+    p[0] = x >> 24; p[1] = x >> 16; p[2] = x >> 8; p[3] = x;
+}
+
+// MPEG-1 44.1 kHz (b1 0xFB) or MPEG-2 22.05 kHz (b1 0xF3) stereo frame
+static std::vector<uint8_t> make_frame(uint8_t b1, uint32_t bitrate_index, bool padding, uint32_t seed) {
+    uint8_t head[4] = {0xFF, b1, (uint8_t)((bitrate_index << 4) | (padding ? 2 : 0)), 0x00};
+    audio_mp3_header_t h;
+    TEST_ASSERT_TRUE(audio_mp3_parse_header(head, &h));
+    std::vector<uint8_t> f(h.bytes);
+    memcpy(f.data(), head, 4);
+    for (size_t i = 4; i < f.size(); i++) f[i] = (uint8_t)((seed * 31 + i * 7) & 0x7F);
+    return f;
+}
+
+static void append_id3v2(mp3_file& m, uint32_t size) {
+    uint8_t tag[10] = {'I', 'D', '3', 4, 0, 0,
+                       (uint8_t)((size >> 21) & 0x7F), (uint8_t)((size >> 14) & 0x7F),
+                       (uint8_t)((size >> 7) & 0x7F), (uint8_t)(size & 0x7F)};
+    m.bytes.insert(m.bytes.end(), tag, tag + 10);
+    m.bytes.insert(m.bytes.end(), size, 0xFF);  // Cover art full of false syncs
+}
+
+// Constant bitrate: padding keeps frame n at n * 144000 * kbps / 44100
+static void append_cbr(mp3_file& m, uint32_t count) {
+    const uint64_t num = 144000ull * 128;
+    for (uint32_t n = 0; n < count; n++) {
+        bool pad = (n + 1) * num / 44100 - n * num / 44100 > num / 44100;
+        m.frames.push_back(m.bytes.size());
+        std::vector<uint8_t> f = make_frame(0xFB, 9, pad, n);
+        m.bytes.insert(m.bytes.end(), f.begin(), f.end());
+    }
+}
+
+static void append_vbr(mp3_file& m, uint8_t b1, uint32_t count) {
+    uint32_t rng = 12345;
+    for (uint32_t n = 0; n < count; n++) {
+        rng = rng * 1103515245u + 12345u;
+        uint32_t index = b1 == 0xFB ? 5 + (rng >> 16) % 9 : 1 + (rng >> 16) % 3;
+        m.frames.push_back(m.bytes.size());
+        std::vector<uint8_t> f = make_frame(b1, index, false, n);
+        m.bytes.insert(m.bytes.end(), f.begin(), f.end());
+    }
+}
+
+static void write_file(const char* path, const mp3_file& m) {
+    hal_storage_file_t f = hal_storage_open(path, HAL_STORAGE_MODE_WRITE);
+    TEST_ASSERT_NOT_NULL(f);
+    hal_storage_write(f, m.bytes.data(), m.bytes.size());
+    hal_storage_close(f);
+}
+
+// Rewrites the frame count, byte count and TOC of a Xing/Info tag frame
+static void fill_xing(mp3_file& m, size_t tag_at, const char* id, bool toc) {
+    uint8_t* p = m.bytes.data() + tag_at + 4 + 32;
+    const uint64_t stream = m.bytes.size() - tag_at;
+    memcpy(p, id, 4);
+    put_be32(p + 4, toc ? 7 : 3);
+    put_be32(p + 8, (uint32_t)m.frames.size());
+    put_be32(p + 12, (uint32_t)stream);
+    if (!toc) return;
+    const uint64_t audio_start = m.frames[0];
+    const uint64_t audio_bytes = m.bytes.size() - audio_start;
+    for (uint32_t i = 0; i < 100; i++) {
+        uint64_t at = m.frames[m.frames.size() * i / 100] - audio_start;
+        p[16 + i] = (uint8_t)(at * 256 / audio_bytes);
+    }
+}
+
+static uint32_t reads_since(uint32_t before) {
+    uint32_t reads = 0;
+    hal_storage_get_stats(&reads, nullptr, nullptr, nullptr);
+    return reads - before;
+}
+
+static uint32_t reads_now(void) {
+    return reads_since(0);
+}
+
+// Locates a spread of frames and checks each lands exactly on its header
+static void check_exact(hal_storage_file_t f, const mp3_file& m, uint32_t max_reads) {
+    for (uint32_t frame = 0; frame < m.frames.size(); frame += 97) {
+        uint64_t offset = 0;
+        uint32_t located = 0;
+        uint32_t before = reads_now();
+        TEST_ASSERT_TRUE(audio_mp3_index_locate(&g_index, f, frame, &offset, &located));
+        TEST_ASSERT_LESS_OR_EQUAL(max_reads, reads_since(before));
+        TEST_ASSERT_EQUAL_UINT32(frame, located);
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)m.frames[frame], (uint32_t)offset);
+    }
+}
+
+void setUp(void) {
+    std::string root = (std::filesystem::temp_directory_path() / "izod_test_audio_mp3_index").string();
+    hal_storage_host_set_root(root.c_str());
+    hal_storage_init();
+    memset(&g_index, 0, sizeof(g_index));
+}
+
+void tearDown(void) {
+    std::filesystem::remove_all(hal_storage_host_get_root());
+    hal_storage_deinit();
+}
+
+void test_mp3_parse_header(void) {
+    audio_mp3_header_t h;
+    const uint8_t mpeg1[4] = {0xFF, 0xFB, 0x92, 0x00};     // 128 kbps, 44.1 kHz, padded
+    TEST_ASSERT_TRUE(audio_mp3_parse_header(mpeg1, &h));
+    TEST_ASSERT_EQUAL(44100, h.sample_rate);
+    TEST_ASSERT_EQUAL(128, h.bitrate_kbps);
+    TEST_ASSERT_EQUAL(1152, h.samples);
+    TEST_ASSERT_EQUAL(418, h.bytes);
+    TEST_ASSERT_EQUAL(2, h.channels);
+
+    const uint8_t mpeg2[4] = {0xFF, 0xF3, 0x84, 0xC0};     // 64 kbps, 24 kHz, mono
+    TEST_ASSERT_TRUE(audio_mp3_parse_header(mpeg2, &h));
+    TEST_ASSERT_EQUAL(24000, h.sample_rate);
+    TEST_ASSERT_EQUAL(576, h.samples);
+    TEST_ASSERT_EQUAL(192, h.bytes);
+    TEST_ASSERT_EQUAL(1, h.channels);
+
+    const uint8_t layer2[4] = {0xFF, 0xFD, 0x90, 0x00};
+    const uint8_t free_format[4] = {0xFF, 0xFB, 0x00, 0x00};
+    TEST_ASSERT_FALSE(audio_mp3_parse_header(layer2, &h));
+    TEST_ASSERT_FALSE(audio_mp3_parse_header(free_format, &h));
+}
+
+void test_mp3_info_tag_is_exact_arithmetic(void) {
+    mp3_file m;
+    append_id3v2(m, 3000);
+    size_t tag_at = m.bytes.size();
+    std::vector<uint8_t> tag = make_frame(0xFB, 9, false, 0);
+    m.bytes.insert(m.bytes.end(), tag.begin(), tag.end());
+    append_cbr(m, 3000);
+    fill_xing(m, tag_at, "Info", false);
+    m.bytes.insert(m.bytes.end(), {'T', 'A', 'G'});
+    m.bytes.insert(m.bytes.end(), 125, 0);
+    write_file("/info.mp3", m);
+
+    hal_storage_file_t f = hal_storage_open("/info.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_EQUAL(AUDIO_MP3_INDEX_LINEAR, g_index.kind);
+    TEST_ASSERT_TRUE(g_index.exact);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)m.frames[0], (uint32_t)g_index.data_start);
+    TEST_ASSERT_EQUAL(3000, g_index.total_frames);
+    TEST_ASSERT_EQUAL(128, g_index.bitrate_kbps);
+    check_exact(f, m, 2);
+    hal_storage_close(f);
+}
+
+void test_mp3_untagged_cbr_and_vbr(void) {
+    mp3_file cbr;
+    append_cbr(cbr, 2000);
+    write_file("/cbr.mp3", cbr);
+    hal_storage_file_t f = hal_storage_open("/cbr.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_EQUAL(AUDIO_MP3_INDEX_LINEAR, g_index.kind);
+    TEST_ASSERT_EQUAL(2000, g_index.total_frames);
+    check_exact(f, cbr, 2);
+    hal_storage_close(f);
+
+    // Without a tag a variable bitrate file seeks by estimate until it is scanned
+    mp3_file vbr;
+    append_vbr(vbr, 0xFB, 2000);
+    write_file("/vbr.mp3", vbr);
+    f = hal_storage_open("/vbr.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_EQUAL(AUDIO_MP3_INDEX_NONE, g_index.kind);
+    TEST_ASSERT_FALSE(g_index.exact);
+    uint64_t offset;
+    uint32_t located;
+    TEST_ASSERT_TRUE(audio_mp3_index_locate(&g_index, f, 1000, &offset, &located));
+    TEST_ASSERT_TRUE(std::binary_search(vbr.frames.begin(), vbr.frames.end(), offset));
+
+    TEST_ASSERT_TRUE(audio_mp3_index_scan(&g_index, f));
+    TEST_ASSERT_EQUAL(AUDIO_MP3_INDEX_FRAMES, g_index.kind);
+    TEST_ASSERT_EQUAL(2000, g_index.total_frames);
+    check_exact(f, vbr, 3);
+    hal_storage_close(f);
+}
+
+void test_mp3_hour_long_seek_is_bounded(void) {
+    // An hour of MPEG-2 at 22.05 kHz: 138k frames halve the table until it fits
+    mp3_file m;
+    append_vbr(m, 0xF3, 3600 * 22050 / 576);
+    write_file("/hour.mp3", m);
+    hal_storage_file_t f = hal_storage_open("/hour.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_TRUE(audio_mp3_index_scan(&g_index, f));
+    TEST_ASSERT_EQUAL(m.frames.size(), g_index.total_frames);
+    TEST_ASSERT_LESS_OR_EQUAL(AUDIO_MP3_INDEX_POINTS, g_index.count);
+    TEST_ASSERT_EQUAL(128, g_index.stride);
+    check_exact(f, m, 3);
+
+    // Last frame and past the end
+    uint64_t offset;
+    uint32_t located;
+    TEST_ASSERT_TRUE(audio_mp3_index_locate(&g_index, f, m.frames.size() - 1, &offset, &located));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)m.frames.back(), (uint32_t)offset);
+    TEST_ASSERT_TRUE(audio_mp3_index_locate(&g_index, f, m.frames.size() + 10, &offset, &located));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)m.bytes.size(), (uint32_t)offset);
+    TEST_ASSERT_EQUAL(m.frames.size(), located);
+    hal_storage_close(f);
+}
+
+void test_mp3_xing_toc_lands_on_a_frame(void) {
+    mp3_file m;
+    std::vector<uint8_t> tag = make_frame(0xFB, 9, false, 0);
+    m.bytes.insert(m.bytes.end(), tag.begin(), tag.end());
+    append_vbr(m, 0xFB, 5000);
+    fill_xing(m, 0, "Xing", true);
+    write_file("/xing.mp3", m);
+
+    hal_storage_file_t f = hal_storage_open("/xing.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_EQUAL(AUDIO_MP3_INDEX_XING, g_index.kind);
+    TEST_ASSERT_FALSE(g_index.exact);
+    TEST_ASSERT_EQUAL(5000, g_index.total_frames);
+    for (uint32_t frame = 1; frame < 5000; frame += 331) {
+        uint64_t offset;
+        uint32_t located;
+        TEST_ASSERT_TRUE(audio_mp3_index_locate(&g_index, f, frame, &offset, &located));
+        TEST_ASSERT_EQUAL(frame, located);
+        // On a real header, within the TOC's resolution of the target
+        auto it = std::lower_bound(m.frames.begin(), m.frames.end(), offset);
+        TEST_ASSERT_TRUE(it != m.frames.end() && *it == offset);
+        int32_t actual = (int32_t)(it - m.frames.begin());
+        TEST_ASSERT_INT_WITHIN(5000 / 100, (int32_t)frame, actual);
+    }
+    hal_storage_close(f);
+}
+
+void test_mp3_vbri_toc(void) {
+    mp3_file m;
+    std::vector<uint8_t> tag = make_frame(0xFB, 14, false, 0);     // Room for the TOC
+    m.bytes.insert(m.bytes.end(), tag.begin(), tag.end());
+    append_vbr(m, 0xFB, 1000);
+    const uint32_t per_entry = 10, entries = 100;
+    uint8_t* p = m.bytes.data() + 4 + 32;
+    memcpy(p, "VBRI", 4);
+    put_be32(p + 10, (uint32_t)m.bytes.size());
+    put_be32(p + 14, 1000);
+    p[18] = 0; p[19] = entries;
+    p[20] = 0; p[21] = 1;                   // Scale
+    p[22] = 0; p[23] = 2;                   // Bytes per entry
+    p[24] = 0; p[25] = per_entry;
+    for (uint32_t i = 0; i < entries; i++) {
+        uint64_t from = i == 0 ? 0 : m.frames[i * per_entry];
+        uint64_t to = i + 1 < entries ? m.frames[(i + 1) * per_entry] : m.bytes.size();
+        p[26 + i * 2] = (uint8_t)((to - from) >> 8);
+        p[27 + i * 2] = (uint8_t)(to - from);
+    }
+    write_file("/vbri.mp3", m);
+
+    hal_storage_file_t f = hal_storage_open("/vbri.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_EQUAL(AUDIO_MP3_INDEX_FRAMES, g_index.kind);
+    TEST_ASSERT_EQUAL(1000, g_index.total_frames);
+    TEST_ASSERT_EQUAL(per_entry, g_index.stride);
+    TEST_ASSERT_EQUAL(entries, g_index.count);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)m.frames[0], (uint32_t)g_index.data_start);
+    check_exact(f, m, 2);
+    hal_storage_close(f);
+}
+
+void test_mp3_scanned_table_cache(void) {
+    mp3_file m;
+    append_id3v2(m, 500);
+    append_vbr(m, 0xFB, 1500);
+    hal_storage_create_dir("/Music");
+    write_file("/Music/cache.mp3", m);
+
+    hal_storage_file_t f = hal_storage_open("/Music/cache.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_FALSE(audio_mp3_index_load(&g_index, "/Music/cache.mp3"));
+    TEST_ASSERT_TRUE(audio_mp3_index_scan(&g_index, f));
+    TEST_ASSERT_TRUE(audio_mp3_index_save(&g_index, "/Music/cache.mp3"));
+    TEST_ASSERT_TRUE(hal_storage_dir_exists(AUDIO_MP3_INDEX_CACHE_DIR));
+
+    // A fresh open picks the table up without scanning again
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    uint32_t before = reads_now();
+    TEST_ASSERT_TRUE(audio_mp3_index_load(&g_index, "/Music/cache.mp3"));
+    TEST_ASSERT_LESS_OR_EQUAL(2, reads_since(before));
+    TEST_ASSERT_EQUAL(AUDIO_MP3_INDEX_FRAMES, g_index.kind);
+    TEST_ASSERT_EQUAL(1500, g_index.total_frames);
+    check_exact(f, m, 3);
+    hal_storage_close(f);
+
+    // The table is dropped once the file changes
+    append_vbr(m, 0xFB, 10);
+    write_file("/Music/cache.mp3", m);
+    f = hal_storage_open("/Music/cache.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_FALSE(audio_mp3_index_load(&g_index, "/Music/cache.mp3"));
+    hal_storage_close(f);
+}
+
+// The decoder's seek path on an untagged variable bitrate file: the cache,
+// else an estimate. The scan is left to the loudness job's own task.
+static bool seek_path(const char* path, uint32_t frame, uint64_t* offset, uint32_t* located) {
+    hal_storage_file_t f = hal_storage_open(path, HAL_STORAGE_MODE_READ);
+    bool ok = f && audio_mp3_index_open(&g_index, f);
+    if (ok && g_index.kind == AUDIO_MP3_INDEX_NONE) audio_mp3_index_load(&g_index, path);
+    ok = ok && audio_mp3_index_locate(&g_index, f, frame, offset, located);
+    if (f) hal_storage_close(f);
+    return ok;
+}
+
+void test_mp3_untagged_vbr_is_scanned_off_the_playback_path(void) {
+    mp3_file m;
+    append_id3v2(m, 500);
+    append_vbr(m, 0xFB, 3000);
+    hal_storage_create_dir("/Music");
+    write_file("/Music/vbr.mp3", m);
+
+    // A scan would read the whole file, several hundred KB
+    uint64_t offset = 0;
+    uint32_t located = 0;
+    uint32_t before = reads_now();
+    TEST_ASSERT_TRUE(seek_path("/Music/vbr.mp3", 2000, &offset, &located));
+    TEST_ASSERT_LESS_OR_EQUAL(4, reads_since(before));
+    TEST_ASSERT_FALSE(g_index.exact);
+    TEST_ASSERT_TRUE(std::binary_search(m.frames.begin(), m.frames.end(), offset));
+
+    audio_loudness_job_config_t config = {};
+    config.start_task = true;
+    TEST_ASSERT_TRUE(audio_loudness_job_start(&config));
+    for (int i = 0; i < 1000 && audio_loudness_job_is_running(); i++) hal_system_delay_ms(5);
+    TEST_ASSERT_FALSE(audio_loudness_job_is_running());
+    audio_loudness_progress_t progress;
+    audio_loudness_job_get_progress(&progress);
+    TEST_ASSERT_EQUAL(1, progress.seek_indexed);
+    audio_loudness_job_stop();
+
+    // Exact from the cached table, with no scan on the seek
+    before = reads_now();
+    TEST_ASSERT_TRUE(seek_path("/Music/vbr.mp3", 2000, &offset, &located));
+    TEST_ASSERT_LESS_OR_EQUAL(6, reads_since(before));
+    TEST_ASSERT_TRUE(g_index.exact);
+    TEST_ASSERT_EQUAL_UINT32(2000, located);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)m.frames[2000], (uint32_t)offset);
+
+    // Already cached: the next run leaves it
+    TEST_ASSERT_TRUE(audio_loudness_job_start(&config));
+    for (int i = 0; i < 1000 && audio_loudness_job_is_running(); i++) hal_system_delay_ms(5);
+    audio_loudness_job_get_progress(&progress);
+    TEST_ASSERT_EQUAL(0, progress.seek_indexed);
+    audio_loudness_job_stop();
+}
+
+void test_mp3_probe_durations(void) {
+    // Info tag: frame count from the tag
+    mp3_file info;
+    append_id3v2(info, 20000);
+    std::vector<uint8_t> tag = make_frame(0xFB, 9, false, 0);
+    info.bytes.insert(info.bytes.end(), tag.begin(), tag.end());
+    append_cbr(info, 3828);                 // 99.997 s
+    fill_xing(info, 20010, "Info", false);
+    write_file("/info.mp3", info);
+
+    uint32_t before = reads_now();
+    audio_probe_t probe;
+    TEST_ASSERT_TRUE(audio_decoder_probe_file("/info.mp3", &probe));
+    TEST_ASSERT_LESS_OR_EQUAL(4, reads_since(before));
+    TEST_ASSERT_EQUAL_STRING("mp3", probe.codec);
+    TEST_ASSERT_EQUAL(44100, probe.info.sample_rate);
+    TEST_ASSERT_EQUAL(2, probe.info.channels);
+    TEST_ASSERT_EQUAL(0, probe.info.bits_per_sample);
+    TEST_ASSERT_EQUAL(128, probe.info.bitrate_kbps);
+    TEST_ASSERT_EQUAL(3828 * 1152, probe.info.total_frames);
+    TEST_ASSERT_INT_WITHIN(1, 99997, probe.duration_ms);
+
+    // Untagged variable bitrate: an estimate until a scan has been cached
+    mp3_file vbr;
+    append_vbr(vbr, 0xFB, 3828);
+    write_file("/vbr.mp3", vbr);
+    TEST_ASSERT_TRUE(audio_decoder_probe_file("/vbr.mp3", &probe));
+    TEST_ASSERT_GREATER_THAN(0, probe.duration_ms);
+
+    hal_storage_file_t f = hal_storage_open("/vbr.mp3", HAL_STORAGE_MODE_READ);
+    TEST_ASSERT_TRUE(audio_mp3_index_open(&g_index, f));
+    TEST_ASSERT_TRUE(audio_mp3_index_scan(&g_index, f));
+    TEST_ASSERT_TRUE(audio_mp3_index_save(&g_index, "/vbr.mp3"));
+    hal_storage_close(f);
+    TEST_ASSERT_TRUE(audio_decoder_probe_file("/vbr.mp3", &probe));
+    TEST_ASSERT_INT_WITHIN(1, 99997, probe.duration_ms);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mp3_parse_header);
+    RUN_TEST(test_mp3_info_tag_is_exact_arithmetic);
+    RUN_TEST(test_mp3_untagged_cbr_and_vbr);
+    RUN_TEST(test_mp3_hour_long_seek_is_bounded);
+    RUN_TEST(test_mp3_xing_toc_lands_on_a_frame);
+    RUN_TEST(test_mp3_vbri_toc);
+    RUN_TEST(test_mp3_scanned_table_cache);
+    RUN_TEST(test_mp3_untagged_vbr_is_scanned_off_the_playback_path);
+    RUN_TEST(test_mp3_probe_durations);
+
+    return UNITY_END();
+}
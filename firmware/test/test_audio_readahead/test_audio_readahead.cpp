@@ -0,0 +1,225 @@
+/*
+ * Audio Read-Ahead Tests
+ * Chunked reads, seeking, the filesystem task and riding out a slow card
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "audio/audio_readahead.h"
+#include "hal/hal_storage.h"
+#include "hal/hal_system.h"
+
+// Byte i of every test file is pattern(i), so any offset can be checked
+static uint8_t pattern(uint64_t i) {
+    return (uint8_t)((i * 7) ^ (i >> 9));
+}
+
+static void write_pattern(const char* card_path, uint32_t bytes) {
+    std::vector<uint8_t> v(bytes);
+    for (uint32_t i = 0; i < bytes; i++) v[i] = pattern(i);
+    hal_storage_file_t f = hal_storage_open(card_path, HAL_STORAGE_MODE_WRITE);
+    TEST_ASSERT_NOT_NULL(f);
+    hal_storage_write(f, v.data(), v.size());
+    hal_storage_close(f);
+}
+
+// Reads to end of file through acquire/release, checking every byte
+static uint64_t drain_and_check(audio_readahead_t* ra) {
+    uint64_t pos = audio_readahead_tell(ra);
+    const uint8_t* data = nullptr;
+    uint32_t n;
+    while ((n = audio_readahead_acquire(ra, &data)) > 0) {
+        for (uint32_t i = 0; i < n; i++) {
+            if (data[i] != pattern(pos + i)) TEST_FAIL_MESSAGE("wrong byte");
+        }
+        audio_readahead_release(ra, n);
+        pos += n;
+    }
+    TEST_ASSERT_EQUAL((uint32_t)pos, (uint32_t)audio_readahead_tell(ra));
+    return pos;
+}
+
+static void start(uint32_t chunk_bytes, uint32_t chunks, bool task) {
+    audio_readahead_config_t config = {};
+    config.chunk_bytes = chunk_bytes;
+    config.chunks = chunks;
+    config.start_task = task;
+    TEST_ASSERT_TRUE(audio_readahead_init(&config));
+}
+
+void setUp(void) {
+    std::string root = (std::filesystem::temp_directory_path() / "izod_test_audio_readahead").string();
+    hal_storage_host_set_root(root.c_str());
+    hal_storage_init();
+}
+
+void tearDown(void) {
+    audio_readahead_deinit();
+    hal_storage_host_set_read_latency_us(0);
+    std::filesystem::remove_all(hal_storage_host_get_root());
+    hal_storage_deinit();
+}
+
+void test_readahead_rejects_bad_config(void) {
+    audio_readahead_config_t config = {};
+    config.chunk_bytes = 1000;
+    TEST_ASSERT_FALSE(audio_readahead_init(&config));
+    config.chunk_bytes = 4096;
+    config.chunks = 1;
+    TEST_ASSERT_FALSE(audio_readahead_init(&config));
+    config.chunks = AUDIO_READAHEAD_MAX_CHUNKS + 1;
+    TEST_ASSERT_FALSE(audio_readahead_init(&config));
+}
+
+void test_readahead_reads_whole_file_in_chunks(void) {
+    write_pattern("/a.bin", 10000);
+    start(4096, 3, false);
+    audio_readahead_t* ra = audio_readahead_open("/a.bin");
+    TEST_ASSERT_NOT_NULL(ra);
+    TEST_ASSERT_EQUAL(10000, (uint32_t)audio_readahead_size(ra));
+    TEST_ASSERT_EQUAL(10000, (uint32_t)drain_and_check(ra));
+
+    // One card read per chunk, however small the decoder's reads were
+    audio_readahead_stats_t stats;
+    audio_readahead_get_stats(&stats);
+    TEST_ASSERT_EQUAL(3, stats.reads);
+    TEST_ASSERT_EQUAL(10000, (uint32_t)stats.bytes_read);
+    TEST_ASSERT_EQUAL(1, stats.streams);
+    TEST_ASSERT_EQUAL(3 * 4096, stats.capacity_bytes);
+    audio_readahead_close(ra);
+}
+
+void test_readahead_copying_read_crosses_chunks(void) {
+    write_pattern("/a.bin", 5000);
+    start(1024, 2, false);
+    audio_readahead_t* ra = audio_readahead_open("/a.bin");
+    TEST_ASSERT_NOT_NULL(ra);
+    uint8_t buf[3000];
+    TEST_ASSERT_EQUAL(10, audio_readahead_read(ra, buf, 10));
+    TEST_ASSERT_EQUAL(3000, audio_readahead_read(ra, buf, 3000));
+    for (int i = 0; i < 3000; i++) TEST_ASSERT_EQUAL(pattern(10 + i), buf[i]);
+    TEST_ASSERT_EQUAL(1990, audio_readahead_read(ra, buf, 3000));
+    TEST_ASSERT_EQUAL(0, audio_readahead_read(ra, buf, 3000));
+    audio_readahead_close(ra);
+}
+
+void test_readahead_seek_unaligned_and_past_end(void) {
+    write_pattern("/a.bin", 20000);
+    start(2048, 3, false);
+    audio_readahead_t* ra = audio_readahead_open("/a.bin");
+    TEST_ASSERT_NOT_NULL(ra);
+    uint8_t buf[100];
+    TEST_ASSERT_EQUAL(100, audio_readahead_read(ra, buf, 100));
+
+    // The card read starts on the sector below; the skipped bytes never show
+    TEST_ASSERT_TRUE(audio_readahead_seek(ra, 12345));
+    TEST_ASSERT_EQUAL(12345, (uint32_t)audio_readahead_tell(ra));
+    const uint8_t* data = nullptr;
+    uint32_t n = audio_readahead_acquire(ra, &data);
+    TEST_ASSERT_EQUAL(2048 - 12345 % 512, n);
+    TEST_ASSERT_EQUAL(pattern(12345), data[0]);
+    TEST_ASSERT_EQUAL(20000, (uint32_t)drain_and_check(ra));
+
+    // Back to the start after end of file
+    TEST_ASSERT_TRUE(audio_readahead_seek(ra, 0));
+    TEST_ASSERT_EQUAL(20000, (uint32_t)drain_and_check(ra));
+
+    TEST_ASSERT_TRUE(audio_readahead_seek(ra, 99999));
+    TEST_ASSERT_EQUAL(20000, (uint32_t)audio_readahead_tell(ra));
+    TEST_ASSERT_EQUAL(0, audio_readahead_acquire(ra, &data));
+    audio_readahead_close(ra);
+}
+
+void test_readahead_runs_out_of_slots(void) {
+    write_pattern("/a.bin", 1000);
+    start(1024, 2, false);
+    audio_readahead_t* ra[AUDIO_READAHEAD_MAX_STREAMS];
+    for (int i = 0; i < AUDIO_READAHEAD_MAX_STREAMS; i++) {
+        ra[i] = audio_readahead_open("/a.bin");
+        TEST_ASSERT_NOT_NULL(ra[i]);
+    }
+    TEST_ASSERT_NULL(audio_readahead_open("/a.bin"));
+    TEST_ASSERT_NULL(audio_readahead_open("/missing.bin"));
+
+    // A closed slot is reused with its buffers
+    audio_readahead_close(ra[1]);
+    TEST_ASSERT_TRUE(audio_readahead_open("/a.bin") == ra[1]);
+    for (int i = 0; i < AUDIO_READAHEAD_MAX_STREAMS; i++) audio_readahead_close(ra[i]);
+}
+
+void test_readahead_task_fills_ahead_of_the_decoder(void) {
+    write_pattern("/a.bin", 100000);
+    write_pattern("/b.bin", 30000);
+    start(8192, 3, true);
+    audio_readahead_t* a = audio_readahead_open("/a.bin");
+    audio_readahead_t* b = audio_readahead_open("/b.bin");
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+
+    // Both fill up without anyone asking
+    audio_readahead_stats_t stats;
+    for (int i = 0; i < 200; i++) {
+        audio_readahead_get_stats(&stats);
+        if (stats.fill_bytes == stats.capacity_bytes) break;
+        hal_system_delay_ms(1);
+    }
+    TEST_ASSERT_EQUAL(2, stats.streams);
+    TEST_ASSERT_EQUAL(2 * 3 * 8192, stats.fill_bytes);
+
+    TEST_ASSERT_EQUAL(100000, (uint32_t)drain_and_check(a));
+    TEST_ASSERT_EQUAL(30000, (uint32_t)drain_and_check(b));
+    TEST_ASSERT_TRUE(audio_readahead_seek(a, 54321));
+    TEST_ASSERT_EQUAL(100000, (uint32_t)drain_and_check(a));
+    audio_readahead_close(a);
+    audio_readahead_close(b);
+}
+
+void test_readahead_rides_out_a_slow_card(void) {
+    // Every read takes 20 ms; the decoder wants 16 KB every 50 ms, so a read
+    // keeps ahead as long as it happens in the background
+    write_pattern("/a.bin", 16 * 1024 * 12);
+    hal_storage_host_set_read_latency_us(20000);
+    start(16 * 1024, 3, true);
+    audio_readahead_t* ra = audio_readahead_open("/a.bin");
+    TEST_ASSERT_NOT_NULL(ra);
+
+    uint64_t pos = 0;
+    const uint8_t* data = nullptr;
+    uint32_t n;
+    while ((n = audio_readahead_acquire(ra, &data)) > 0) {
+        if (n > 4096) n = 4096;
+        TEST_ASSERT_EQUAL(pattern(pos), data[0]);
+        TEST_ASSERT_EQUAL(pattern(pos + n - 1), data[n - 1]);
+        audio_readahead_release(ra, n);
+        pos += n;
+        hal_system_delay_ms(12);
+    }
+    TEST_ASSERT_EQUAL(16 * 1024 * 12, (uint32_t)pos);
+
+    audio_readahead_stats_t stats;
+    audio_readahead_get_stats(&stats);
+    printf("slow card: %u reads, worst %u us, min fill %u%%, %u stalls\n", (unsigned)stats.reads,
+           (unsigned)stats.worst_read_us, (unsigned)stats.min_fill_percent, (unsigned)stats.stalls);
+    TEST_ASSERT_TRUE(stats.worst_read_us >= 20000);
+    TEST_ASSERT_EQUAL(0, stats.stalls);
+    TEST_ASSERT_TRUE(stats.min_fill_percent > 0);
+    audio_readahead_close(ra);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_readahead_rejects_bad_config);
+    RUN_TEST(test_readahead_reads_whole_file_in_chunks);
+    RUN_TEST(test_readahead_copying_read_crosses_chunks);
+    RUN_TEST(test_readahead_seek_unaligned_and_past_end);
+    RUN_TEST(test_readahead_runs_out_of_slots);
+    RUN_TEST(test_readahead_task_fills_ahead_of_the_decoder);
+    RUN_TEST(test_readahead_rides_out_a_slow_card);
+
+    return UNITY_END();
+}
@@ -0,0 +1,150 @@
+/*
+ * Audio Resampler Tests
+ * Frame accounting, DC/passband gain, stopband rejection and streaming
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+#include "audio/audio_resampler.h"
+
+static audio_resampler_t g_rs;
+
+void setUp(void) {
+    memset(&g_rs, 0, sizeof(g_rs));
+}
+
+void tearDown(void) {
+    audio_resampler_deinit(&g_rs);
+}
+
+static std::vector<int16_t> make_sine(uint32_t rate, float hz, float amplitude, uint32_t frames) {
+    std::vector<int16_t> v(frames * 2);
+    for (uint32_t i = 0; i < frames; i++) {
+        int16_t s = (int16_t)lrintf(amplitude * sinf(2.0f * (float)M_PI * hz * i / rate));
+        v[i * 2] = s;
+        v[i * 2 + 1] = (int16_t)-s;
+    }
+    return v;
+}
+
+// Whole stream through process + drain, in chunks of chunk_frames input frames
+static std::vector<int16_t> run_stream(const std::vector<int16_t>& in, uint32_t chunk_frames) {
+    std::vector<int16_t> out;
+    int16_t block[64 * 2];
+    uint32_t frames = (uint32_t)(in.size() / 2);
+    uint32_t pos = 0;
+    while (pos < frames) {
+        uint32_t chunk = frames - pos < chunk_frames ? frames - pos : chunk_frames;
+        uint32_t used_in_chunk = 0;
+        while (used_in_chunk < chunk) {
+            uint32_t consumed = 0;
+            uint32_t n = audio_resampler_process(&g_rs, in.data() + (pos + used_in_chunk) * 2,
+                                                 chunk - used_in_chunk, &consumed, block, 64);
+            out.insert(out.end(), block, block + n * 2);
+            used_in_chunk += consumed;
+        }
+        pos += chunk;
+    }
+    for (uint32_t n; (n = audio_resampler_drain(&g_rs, block, 64)) > 0; ) out.insert(out.end(), block, block + n * 2);
+    return out;
+}
+
+static double rms(const std::vector<int16_t>& v, size_t first_frame, size_t last_frame) {
+    double sum = 0;
+    for (size_t i = first_frame; i < last_frame; i++) sum += (double)v[i * 2] * v[i * 2];
+    return sqrt(sum / (double)(last_frame - first_frame));
+}
+
+void test_resampler_passthrough_is_identity(void) {
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 44100, 44100, AUDIO_RESAMPLER_QUALITY_HIGH));
+    TEST_ASSERT_TRUE(g_rs.passthrough);
+    std::vector<int16_t> in = make_sine(44100, 1000.0f, 20000.0f, 500);
+    std::vector<int16_t> out = run_stream(in, 37);
+    TEST_ASSERT_EQUAL(in.size(), out.size());
+    TEST_ASSERT_EQUAL_INT16_ARRAY(in.data(), out.data(), in.size());
+}
+
+void test_resampler_frame_counts(void) {
+    const uint32_t rates[] = { 8000, 16000, 22050, 32000, 48000, 88200, 96000, 44056 };
+    for (uint32_t rate : rates) {
+        TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, rate, 44100, AUDIO_RESAMPLER_QUALITY_MEDIUM));
+        std::vector<int16_t> in(1000 * 2, 100);
+        std::vector<int16_t> out = run_stream(in, 1000);
+        TEST_ASSERT_EQUAL(audio_resampler_output_frames(&g_rs, 1000), out.size() / 2);
+    }
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 22050, 44100, AUDIO_RESAMPLER_QUALITY_LOW));
+    TEST_ASSERT_EQUAL(600, audio_resampler_output_frames(&g_rs, 300));
+}
+
+void test_resampler_preserves_dc(void) {
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 48000, 44100, AUDIO_RESAMPLER_QUALITY_MEDIUM));
+    std::vector<int16_t> in(4800 * 2);
+    for (size_t i = 0; i < in.size(); i += 2) { in[i] = 12345; in[i + 1] = -32768; }
+    std::vector<int16_t> out = run_stream(in, 480);
+    // Away from the stream edges every phase has unity gain
+    for (size_t i = 100; i < out.size() / 2 - 100; i++) {
+        TEST_ASSERT_INT_WITHIN(1, 12345, out[i * 2]);
+        TEST_ASSERT_INT_WITHIN(1, -32768, out[i * 2 + 1]);
+    }
+}
+
+void test_resampler_passband_gain(void) {
+    const audio_resampler_quality_t tiers[] = {
+        AUDIO_RESAMPLER_QUALITY_LOW, AUDIO_RESAMPLER_QUALITY_MEDIUM, AUDIO_RESAMPLER_QUALITY_HIGH
+    };
+    for (audio_resampler_quality_t q : tiers) {
+        TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 22050, 44100, q));
+        std::vector<int16_t> in = make_sine(22050, 1000.0f, 16000.0f, 22050 / 4);
+        std::vector<int16_t> out = run_stream(in, 256);
+        double expected = 16000.0 / sqrt(2.0);
+        TEST_ASSERT_FLOAT_WITHIN(expected * 0.01, expected, rms(out, 200, out.size() / 2 - 200));
+    }
+}
+
+void test_resampler_rejects_aliases(void) {
+    // 30 kHz at 96 kHz has no place below the 22.05 kHz output Nyquist limit
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 96000, 44100, AUDIO_RESAMPLER_QUALITY_HIGH));
+    std::vector<int16_t> in = make_sine(96000, 30000.0f, 30000.0f, 96000 / 4);
+    std::vector<int16_t> out = run_stream(in, 1024);
+    double level = rms(out, 200, out.size() / 2 - 200);
+    TEST_ASSERT_LESS_THAN(30000.0 / sqrt(2.0) * 0.001, level);     // Better than -60 dB
+}
+
+void test_resampler_chunking_is_bit_exact(void) {
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 32000, 44100, AUDIO_RESAMPLER_QUALITY_MEDIUM));
+    std::vector<int16_t> in = make_sine(32000, 440.0f, 25000.0f, 3000);
+    std::vector<int16_t> whole = run_stream(in, 3000);
+
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 32000, 44100, AUDIO_RESAMPLER_QUALITY_MEDIUM));
+    std::vector<int16_t> pieces = run_stream(in, 7);
+    TEST_ASSERT_EQUAL(whole.size(), pieces.size());
+    TEST_ASSERT_EQUAL_INT16_ARRAY(whole.data(), pieces.data(), whole.size());
+}
+
+void test_resampler_reinit_reuses_design(void) {
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 48000, 44100, AUDIO_RESAMPLER_QUALITY_HIGH));
+    const int16_t* coefs = g_rs.coefs;
+    TEST_ASSERT_EQUAL(147, g_rs.phases);
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 16000, 44100, AUDIO_RESAMPLER_QUALITY_LOW));
+    TEST_ASSERT_EQUAL(441, g_rs.phases);
+    TEST_ASSERT_EQUAL(8, g_rs.taps);
+    TEST_ASSERT_TRUE(coefs == g_rs.coefs);     // 441 * 8 entries fit in the first allocation
+    TEST_ASSERT_TRUE(audio_resampler_init(&g_rs, 44056, 44100, AUDIO_RESAMPLER_QUALITY_LOW));
+    TEST_ASSERT_EQUAL(AUDIO_RESAMPLER_MAX_PHASES, g_rs.phases);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_resampler_passthrough_is_identity);
+    RUN_TEST(test_resampler_frame_counts);
+    RUN_TEST(test_resampler_preserves_dc);
+    RUN_TEST(test_resampler_passband_gain);
+    RUN_TEST(test_resampler_rejects_aliases);
+    RUN_TEST(test_resampler_chunking_is_bit_exact);
+    RUN_TEST(test_resampler_reinit_reuses_design);
+
+    return UNITY_END();
+}
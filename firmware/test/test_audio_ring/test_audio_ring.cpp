@@ -0,0 +1,242 @@
+/*
+ * Audio Ring Buffer Tests
+ * SPSC ring correctness, overrun/underrun accounting and the host audio HAL
+ */
+
+#include <unity.h>
+#include <thread>
+#include "audio/audio_ring_buffer.h"
+#include "hal/hal_audio.h"
+#include "hal/hal_system.h"
+
+static audio_ring_t g_ring;
+
+void setUp(void) {
+    // Set up test environment
+}
+
+void tearDown(void) {
+    audio_ring_deinit(&g_ring);
+}
+
+static void fill_frames(int16_t* buf, uint32_t frames, int16_t first) {
+    for (uint32_t i = 0; i < frames; i++) {
+        buf[i * 2] = (int16_t)(first + i);
+        buf[i * 2 + 1] = (int16_t)-(first + i);
+    }
+}
+
+void test_ring_capacity_rounds_to_power_of_two(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, 1000, false));
+    TEST_ASSERT_EQUAL(1024, g_ring.capacity_frames);
+    TEST_ASSERT_EQUAL(0, audio_ring_used_frames(&g_ring));
+    TEST_ASSERT_EQUAL(1024, audio_ring_free_frames(&g_ring));
+}
+
+void test_ring_rejects_non_power_of_two_storage(void) {
+    int16_t storage[12 * 2];
+    TEST_ASSERT_FALSE(audio_ring_init_with_storage(&g_ring, storage, 12));
+    TEST_ASSERT_TRUE(audio_ring_init_with_storage(&g_ring, storage, 8));
+}
+
+void test_ring_wraps_around(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, 16, false));
+
+    int16_t in[12 * 2];
+    int16_t out[12 * 2];
+    int16_t next = 0;
+
+    // Enough passes to wrap the 16-frame ring several times
+    for (int pass = 0; pass < 10; pass++) {
+        fill_frames(in, 12, next);
+        TEST_ASSERT_EQUAL(12, audio_ring_write(&g_ring, in, 12));
+        TEST_ASSERT_EQUAL(12, audio_ring_used_frames(&g_ring));
+        TEST_ASSERT_EQUAL(12, audio_ring_read(&g_ring, out, 12));
+        TEST_ASSERT_EQUAL_INT16_ARRAY(in, out, 12 * 2);
+        next += 12;
+    }
+    TEST_ASSERT_EQUAL(0, g_ring.overruns.load());
+}
+
+void test_ring_partial_write_when_nearly_full(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, 8, false));
+
+    int16_t in[10 * 2];
+    fill_frames(in, 10, 1);
+    TEST_ASSERT_EQUAL(8, audio_ring_write(&g_ring, in, 10));
+    TEST_ASSERT_EQUAL(0, audio_ring_free_frames(&g_ring));
+
+    // The two frames left over count as dropped, once per short write
+    TEST_ASSERT_EQUAL(1, g_ring.overruns.load());
+    TEST_ASSERT_EQUAL(2, g_ring.frames_dropped.load());
+}
+
+void test_ring_write_all_counts_overruns(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, 8, false));
+
+    int16_t in[6 * 2];
+    fill_frames(in, 6, 1);
+    TEST_ASSERT_TRUE(audio_ring_write_all(&g_ring, in, 6));
+
+    // Not enough room: nothing is written, the attempt is counted
+    TEST_ASSERT_FALSE(audio_ring_write_all(&g_ring, in, 6));
+    TEST_ASSERT_EQUAL(6, audio_ring_used_frames(&g_ring));
+    TEST_ASSERT_EQUAL(1, g_ring.overruns.load());
+    TEST_ASSERT_EQUAL(6, g_ring.frames_dropped.load());
+}
+
+void test_ring_underrun_counted_once_per_dropout(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, 64, false));
+
+    int16_t in[4 * 2];
+    int16_t out[16 * 2];
+    fill_frames(in, 4, 1);
+
+    // Nothing written yet: an idle ring is not an underrun
+    audio_ring_read_padded(&g_ring, out, 16);
+    TEST_ASSERT_EQUAL(0, g_ring.underruns.load());
+
+    audio_ring_write(&g_ring, in, 4);
+    TEST_ASSERT_EQUAL(4, audio_ring_read_padded(&g_ring, out, 16));
+    TEST_ASSERT_EQUAL(0, out[4 * 2]);
+    TEST_ASSERT_EQUAL(1, g_ring.underruns.load());
+
+    // Still starving: same dropout
+    audio_ring_read_padded(&g_ring, out, 16);
+    audio_ring_read_padded(&g_ring, out, 16);
+    TEST_ASSERT_EQUAL(1, g_ring.underruns.load());
+    TEST_ASSERT_EQUAL(12 + 16 + 16, g_ring.frames_padded.load());
+
+    // Recover, then starve again: second dropout
+    audio_ring_write(&g_ring, in, 4);
+    audio_ring_read_padded(&g_ring, out, 4);
+    audio_ring_read_padded(&g_ring, out, 16);
+    TEST_ASSERT_EQUAL(2, g_ring.underruns.load());
+}
+
+void test_ring_end_of_stream_is_not_an_underrun(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, 64, false));
+
+    int16_t in[4 * 2];
+    int16_t out[16 * 2];
+    fill_frames(in, 4, 1);
+
+    audio_ring_write(&g_ring, in, 4);
+    audio_ring_end_stream(&g_ring);
+    TEST_ASSERT_EQUAL(4, audio_ring_read_padded(&g_ring, out, 16));
+    TEST_ASSERT_EQUAL(0, g_ring.underruns.load());
+    TEST_ASSERT_EQUAL(0, g_ring.frames_padded.load());
+}
+
+void test_ring_zero_copy_regions(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, 8, false));
+
+    int16_t in[6 * 2];
+    int16_t out[6 * 2];
+    fill_frames(in, 6, 1);
+    audio_ring_write(&g_ring, in, 6);
+    audio_ring_read(&g_ring, out, 6);
+
+    // Write index sits at 6: only 2 frames are contiguous before the wrap
+    int16_t* wregion = nullptr;
+    TEST_ASSERT_EQUAL(2, audio_ring_acquire_write(&g_ring, &wregion));
+    wregion[0] = 100;
+    wregion[1] = -100;
+    audio_ring_commit_write(&g_ring, 1);
+
+    const int16_t* rregion = nullptr;
+    TEST_ASSERT_EQUAL(1, audio_ring_acquire_read(&g_ring, &rregion));
+    TEST_ASSERT_EQUAL(100, rregion[0]);
+    TEST_ASSERT_EQUAL(-100, rregion[1]);
+    audio_ring_commit_read(&g_ring, 1);
+    TEST_ASSERT_EQUAL(0, audio_ring_used_frames(&g_ring));
+}
+
+void test_ring_threaded_integrity(void) {
+    TEST_ASSERT_TRUE(audio_ring_init(&g_ring, 256, false));
+
+    const uint32_t total = 200000;
+    bool ok = true;
+
+    std::thread consumer([&]() {
+        int16_t out[37 * 2];
+        uint32_t expected = 0;
+        while (expected < total) {
+            uint32_t got = audio_ring_read(&g_ring, out, 37);
+            for (uint32_t i = 0; i < got; i++, expected++) {
+                if (out[i * 2] != (int16_t)expected || out[i * 2 + 1] != (int16_t)~expected) ok = false;
+            }
+            if (got == 0) std::this_thread::yield();
+        }
+    });
+
+    int16_t in[53 * 2];
+    uint32_t sent = 0;
+    while (sent < total) {
+        uint32_t n = total - sent < 53 ? total - sent : 53;
+        for (uint32_t i = 0; i < n; i++) {
+            in[i * 2] = (int16_t)(sent + i);
+            in[i * 2 + 1] = (int16_t)~(sent + i);
+        }
+        uint32_t w = audio_ring_write(&g_ring, in, n);
+        if (w < n) {
+            // Resend only the tail that did not fit
+            for (uint32_t i = w; i < n; i++) {
+                in[(i - w) * 2] = in[i * 2];
+                in[(i - w) * 2 + 1] = in[i * 2 + 1];
+            }
+            std::this_thread::yield();
+        }
+        sent += w;
+    }
+    consumer.join();
+
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL(0, audio_ring_used_frames(&g_ring));
+}
+
+void test_hal_audio_streaming(void) {
+    hal_audio_config_t config = {};
+    config.sample_rate = 44100;
+    config.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+    config.volume = HAL_AUDIO_DEFAULT_VOLUME;
+    config.buffer_size = 1024 * HAL_AUDIO_CHANNELS;
+    TEST_ASSERT_TRUE(hal_audio_init(&config));
+    hal_audio_reset_stats();
+
+    int16_t block[256 * 2];
+    fill_frames(block, 256, 0);
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(hal_audio_wait_for_space(256 * 2, 1000));
+        TEST_ASSERT_TRUE(hal_audio_write_samples(block, 256 * 2));
+    }
+
+    // A write larger than the ring can never fit
+    TEST_ASSERT_FALSE(hal_audio_wait_for_space(4096 * 2, 10));
+
+    hal_system_delay_ms(100);
+    uint32_t played = 0, underruns = 0, overruns = 0;
+    hal_audio_get_stats(&played, &underruns, &overruns);
+    TEST_ASSERT_GREATER_THAN(0, played);
+    TEST_ASSERT_EQUAL(0, overruns);
+
+    hal_audio_flush_buffer();
+    hal_audio_deinit();
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ring_capacity_rounds_to_power_of_two);
+    RUN_TEST(test_ring_rejects_non_power_of_two_storage);
+    RUN_TEST(test_ring_wraps_around);
+    RUN_TEST(test_ring_partial_write_when_nearly_full);
+    RUN_TEST(test_ring_write_all_counts_overruns);
+    RUN_TEST(test_ring_underrun_counted_once_per_dropout);
+    RUN_TEST(test_ring_end_of_stream_is_not_an_underrun);
+    RUN_TEST(test_ring_zero_copy_regions);
+    RUN_TEST(test_ring_threaded_integrity);
+    RUN_TEST(test_hal_audio_streaming);
+
+    return UNITY_END();
+}
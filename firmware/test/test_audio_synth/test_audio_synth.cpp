@@ -0,0 +1,195 @@
+/*
+ * Audio Synth Tests
+ * Pitch, envelope, scheduling, band limiting and voice allocation
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "audio/audio_synth.h"
+
+#define TEST_RATE   44100
+
+static audio_synth_t g_synth;
+
+static audio_synth_note_t make_note(uint32_t hz, uint32_t duration_ms) {
+    audio_synth_note_t note;
+    memset(&note, 0, sizeof(note));
+    note.waveform = AUDIO_SYNTH_SINE;
+    note.frequency_hz = hz;
+    note.volume = 100;
+    note.duration_ms = duration_ms;
+    note.sustain = 100;
+    return note;
+}
+
+// Renders frames of the synth alone in blocks of block_frames
+static std::vector<int16_t> render(uint32_t frames, uint32_t block_frames = 256) {
+    std::vector<int16_t> out(frames * 2, 0);
+    for (uint32_t pos = 0; pos < frames; pos += block_frames) {
+        uint32_t n = frames - pos < block_frames ? frames - pos : block_frames;
+        audio_synth_render(&g_synth, out.data() + pos * 2, n, 32768);
+    }
+    return out;
+}
+
+static int peak_between(const std::vector<int16_t>& out, uint32_t first, uint32_t last) {
+    int peak = 0;
+    for (uint32_t i = first; i < last; i++) {
+        if (abs(out[i * 2]) > peak) peak = abs(out[i * 2]);
+    }
+    return peak;
+}
+
+// Power of the left channel at hz (Goertzel)
+static double power_at(const std::vector<int16_t>& out, uint32_t frames, double hz) {
+    double coeff = 2.0 * cos(2.0 * M_PI * hz / TEST_RATE);
+    double s1 = 0.0, s2 = 0.0;
+    for (uint32_t i = 0; i < frames; i++) {
+        double s = out[i * 2] + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s;
+    }
+    return s1 * s1 + s2 * s2 - coeff * s1 * s2;
+}
+
+void setUp(void) {
+    TEST_ASSERT_TRUE(audio_synth_init(&g_synth, TEST_RATE, 0));
+}
+
+void tearDown(void) {
+    audio_synth_deinit(&g_synth);
+}
+
+void test_synth_sine_pitch_and_level(void) {
+    audio_synth_note_t note = make_note(1000, 100);
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, &note, 1));
+    std::vector<int16_t> out = render(4410);
+
+    int crossings = 0;
+    for (uint32_t i = 1; i < 4410; i++) {
+        TEST_ASSERT_EQUAL(out[i * 2], out[i * 2 + 1]);
+        if (out[(i - 1) * 2] < 0 && out[i * 2] >= 0) crossings++;
+    }
+    // 100 periods; centred at equal power, so each side peaks at -3 dB
+    TEST_ASSERT_INT_WITHIN(1, 100, crossings);
+    TEST_ASSERT_INT_WITHIN(300, 22627, peak_between(out, 0, 4410));
+}
+
+void test_synth_adsr_shape(void) {
+    audio_synth_note_t note = make_note(2000, 50);
+    note.attack_ms = 10;
+    note.decay_ms = 10;
+    note.sustain = 50;
+    note.release_ms = 20;
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, &note, 1));
+    std::vector<int16_t> out = render(TEST_RATE / 10, 100);
+    const uint32_t ms = TEST_RATE / 1000;
+
+    int full = 22627;
+    TEST_ASSERT_INT_WITHIN(full / 8, full / 4, peak_between(out, 2 * ms, 3 * ms));      // Rising
+    TEST_ASSERT_INT_WITHIN(full / 20, full, peak_between(out, 9 * ms, 11 * ms));        // Peak
+    TEST_ASSERT_INT_WITHIN(full / 20, full / 2, peak_between(out, 25 * ms, 45 * ms));   // Sustain
+    TEST_ASSERT_INT_WITHIN(full / 20, full / 4, peak_between(out, 60 * ms, 61 * ms));   // Half released
+    TEST_ASSERT_EQUAL(0, peak_between(out, 71 * ms, 100 * ms));
+    TEST_ASSERT_FALSE(audio_synth_is_active(&g_synth));
+}
+
+void test_synth_notes_of_one_call_keep_their_spacing(void) {
+    audio_synth_note_t notes[2] = { make_note(1000, 30), make_note(1000, 30) };
+    notes[0].pan = -100;
+    notes[1].pan = 100;
+    notes[1].delay_ms = 10;
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, notes, 2));
+    // Odd block sizes: the start must not snap to a block edge
+    std::vector<int16_t> out = render(2000, 37);
+
+    uint32_t first_left = 0, first_right = 0;
+    while (first_left < 2000 && out[first_left * 2] == 0) first_left++;
+    while (first_right < 2000 && out[first_right * 2 + 1] == 0) first_right++;
+    // Sine starts at zero phase: the first non-zero sample is one in
+    TEST_ASSERT_EQUAL(1, first_left);
+    TEST_ASSERT_EQUAL(441 + 1, first_right);
+    for (uint32_t i = 0; i < 2000; i++) {
+        if (i < 441) TEST_ASSERT_EQUAL(0, out[i * 2 + 1]);
+    }
+}
+
+void test_synth_square_is_band_limited(void) {
+    audio_synth_note_t note = make_note(5000, 200);
+    note.waveform = AUDIO_SYNTH_SQUARE;
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, &note, 1));
+    std::vector<int16_t> out = render(4410);
+
+    double fundamental = power_at(out, 4410, 5000.0);
+    // The third harmonic fits below Nyquist; the fifth (25 kHz) would fold to 19.1 kHz
+    TEST_ASSERT_TRUE(power_at(out, 4410, 15000.0) > fundamental * 0.01);
+    TEST_ASSERT_TRUE(power_at(out, 4410, 19100.0) < fundamental * 1e-5);
+}
+
+void test_synth_steals_the_quietest_voice(void) {
+    audio_synth_deinit(&g_synth);
+    TEST_ASSERT_TRUE(audio_synth_init(&g_synth, TEST_RATE, 2));
+    audio_synth_note_t notes[2] = { make_note(440, 1000), make_note(660, 1000) };
+    notes[1].volume = 30;
+    notes[1].release_ms = 500;
+    notes[1].duration_ms = 10;
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, notes, 2));
+    render(TEST_RATE / 20);
+    TEST_ASSERT_EQUAL(2, g_synth.active_voices);
+
+    // The releasing voice goes, though the sustained one started first
+    audio_synth_note_t third = make_note(880, 1000);
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, &third, 1));
+    render(64);
+    TEST_ASSERT_EQUAL(2, g_synth.active_voices);
+    TEST_ASSERT_EQUAL(1, g_synth.voice_steals);
+    TEST_ASSERT_EQUAL(AUDIO_SYNTH_STAGE_SUSTAIN, g_synth.voices[0].stage);
+    TEST_ASSERT_EQUAL(AUDIO_SYNTH_STAGE_SUSTAIN, g_synth.voices[1].stage);
+}
+
+void test_synth_mix_saturates(void) {
+    audio_synth_deinit(&g_synth);
+    TEST_ASSERT_TRUE(audio_synth_init(&g_synth, TEST_RATE, AUDIO_SYNTH_MAX_VOICES));
+    std::vector<audio_synth_note_t> notes(AUDIO_SYNTH_MAX_VOICES, make_note(100, 100));
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, notes.data(), notes.size()));
+
+    std::vector<int16_t> out(441 * 2, 30000);
+    audio_synth_render(&g_synth, out.data(), 441, 32768);
+    int16_t lowest = 32767;
+    for (uint32_t i = 0; i < 441 * 2; i++) {
+        if (out[i] < lowest) lowest = out[i];
+    }
+    // 16 voices at -3 dB on top of 30000: clipped at the positive peak, never wrapped
+    TEST_ASSERT_EQUAL(32767, out[110 * 2]);
+    TEST_ASSERT_EQUAL(-32768, lowest);
+}
+
+void test_synth_queue_takes_whole_calls_only(void) {
+    std::vector<audio_synth_note_t> notes(AUDIO_SYNTH_QUEUE_LENGTH + 1, make_note(440, 10));
+    TEST_ASSERT_FALSE(audio_synth_post(&g_synth, notes.data(), notes.size()));
+    TEST_ASSERT_FALSE(audio_synth_is_active(&g_synth));
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, notes.data(), AUDIO_SYNTH_QUEUE_LENGTH));
+    TEST_ASSERT_FALSE(audio_synth_post(&g_synth, notes.data(), 1));
+    TEST_ASSERT_TRUE(audio_synth_is_active(&g_synth));
+
+    audio_synth_stop_all(&g_synth);
+    TEST_ASSERT_FALSE(audio_synth_is_active(&g_synth));
+    TEST_ASSERT_TRUE(audio_synth_post(&g_synth, notes.data(), 1));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_synth_sine_pitch_and_level);
+    RUN_TEST(test_synth_adsr_shape);
+    RUN_TEST(test_synth_notes_of_one_call_keep_their_spacing);
+    RUN_TEST(test_synth_square_is_band_limited);
+    RUN_TEST(test_synth_steals_the_quietest_voice);
+    RUN_TEST(test_synth_mix_saturates);
+    RUN_TEST(test_synth_queue_takes_whole_calls_only);
+
+    return UNITY_END();
+}
@@ -0,0 +1,252 @@
+/*
+ * Host Audio HAL Tests
+ * Null, memory and WAV file sinks, offline rendering through the engine task,
+ * the playback clock the engine reads its position from and the deadline monitor
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include "audio/audio_engine.h"
+#include "hal/hal_audio.h"
+#include "hal/hal_storage.h"
+#include "hal/hal_system.h"
+#include "../wav_test_writer.h"
+
+// Writes a 16-bit PCM WAV whose left channel is a ramp and right is its negation
+static void write_ramp_wav(const char* card_path, uint16_t channels, uint32_t rate, uint32_t frames) {
+    wav_test_format_t format;
+    format.channels = channels;
+    format.rate = rate;
+    std::vector<int16_t> pcm = wav_test_ramp(channels, frames);
+    TEST_ASSERT_TRUE(wav_test_save(card_path, wav_test_pcm16(format, pcm.data(), pcm.size())));
+}
+
+static void start_output(bool offline, hal_audio_host_sink_t sink, const char* wav_path) {
+    TEST_ASSERT_TRUE(hal_audio_host_set_sink(sink, wav_path));
+    hal_audio_host_set_offline(offline);
+    hal_audio_config_t config = {};
+    config.sample_rate = 44100;
+    config.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+    config.volume = HAL_AUDIO_DEFAULT_VOLUME;
+    TEST_ASSERT_TRUE(hal_audio_init(&config));
+
+    audio_engine_config_t engine_config = {};
+    engine_config.start_task = true;
+    TEST_ASSERT_TRUE(audio_engine_init(&engine_config));
+    audio_engine_set_volume(100);
+}
+
+// Plays a card file on the engine task and waits until the sink has every frame
+static void play_to_end(const char* card_path) {
+    TEST_ASSERT_TRUE(audio_engine_play_file(card_path));
+    for (int i = 0; i < 100 && audio_engine_get_state() != HAL_AUDIO_STATE_PLAYING; i++) {
+        hal_system_delay_ms(1);
+    }
+    for (int i = 0; i < 1000 && audio_engine_get_state() != HAL_AUDIO_STATE_STOPPED; i++) {
+        hal_system_delay_ms(5);
+    }
+    TEST_ASSERT_EQUAL(HAL_AUDIO_STATE_STOPPED, audio_engine_get_state());
+    TEST_ASSERT_TRUE(hal_audio_host_wait_drained(2000));
+}
+
+void setUp(void) {
+    std::string root = (std::filesystem::temp_directory_path() / "izod_test_hal_audio_host").string();
+    hal_storage_host_set_root(root.c_str());
+    hal_storage_init();
+    hal_storage_create_dir("/Music");
+}
+
+void tearDown(void) {
+    audio_engine_deinit();
+    hal_audio_deinit();
+    hal_audio_host_set_sink(HAL_AUDIO_HOST_SINK_NULL, nullptr);
+    hal_audio_host_clear_memory();
+    hal_audio_host_set_offline(false);
+    std::filesystem::remove_all(hal_storage_host_get_root());
+    hal_storage_deinit();
+}
+
+void test_host_memory_sink_captures_every_frame_offline(void) {
+    write_ramp_wav("/Music/ramp.wav", 2, 44100, 20000);
+    start_output(true, HAL_AUDIO_HOST_SINK_MEMORY, nullptr);
+    TEST_ASSERT_EQUAL(HAL_AUDIO_HOST_SINK_MEMORY, hal_audio_host_get_sink());
+    TEST_ASSERT_TRUE(hal_audio_host_is_offline());
+    play_to_end("/Music/ramp.wav");
+
+    // Offline never pads: exactly the track, bit for bit at full volume
+    TEST_ASSERT_EQUAL(20000 * 2, hal_audio_host_get_memory_samples());
+    static int16_t out[20000 * 2];
+    TEST_ASSERT_EQUAL(20000 * 2, hal_audio_host_copy_memory(out, 0, 20000 * 2));
+    for (int i = 0; i < 20000; i++) {
+        TEST_ASSERT_EQUAL(i % 30000, out[i * 2]);
+        TEST_ASSERT_EQUAL(-(i % 30000), out[i * 2 + 1]);
+    }
+    TEST_ASSERT_EQUAL(0, hal_audio_host_copy_memory(out, 20000 * 2, 16));
+
+    uint32_t played = 0, underruns = 0, overruns = 0;
+    hal_audio_get_stats(&played, &underruns, &overruns);
+    TEST_ASSERT_EQUAL(20000, played);
+    TEST_ASSERT_EQUAL(0, underruns);
+    TEST_ASSERT_EQUAL(0, overruns);
+}
+
+void test_host_offline_renders_faster_than_real_time(void) {
+    // Five seconds at 22.05 kHz mono: decode, upmix and resample on every block
+    write_ramp_wav("/Music/long.wav", 1, 22050, 22050 * 5);
+    start_output(true, HAL_AUDIO_HOST_SINK_NULL, nullptr);
+    const float bands[10] = {3, 0, -3, 0, 6, 0, 0, -6, 0, 2};
+    hal_audio_set_equalizer(bands, 10);
+
+    auto start = std::chrono::steady_clock::now();
+    play_to_end("/Music/long.wav");
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("offline: 5 s of audio in %.3f s (%.0fx real time)\n", secs, 5.0 / secs);
+    TEST_ASSERT_TRUE(secs < 2.5);
+
+    uint32_t played = 0, underruns = 0, overruns = 0;
+    hal_audio_get_stats(&played, &underruns, &overruns);
+    TEST_ASSERT_INT_WITHIN(4, 44100 * 5, played);
+    TEST_ASSERT_EQUAL(0, underruns);
+}
+
+void test_host_wav_sink_writes_a_playable_file(void) {
+    std::string wav_path = std::string(hal_storage_host_get_root()) + "/out.wav";
+    write_ramp_wav("/Music/ramp.wav", 2, 44100, 5000);
+    start_output(true, HAL_AUDIO_HOST_SINK_WAV_FILE, wav_path.c_str());
+    play_to_end("/Music/ramp.wav");
+    TEST_ASSERT_FALSE(hal_audio_host_set_sink(HAL_AUDIO_HOST_SINK_WAV_FILE, ""));
+    TEST_ASSERT_EQUAL(HAL_AUDIO_HOST_SINK_WAV_FILE, hal_audio_host_get_sink());
+
+    // Deinit finalizes the header and returns to the null sink
+    audio_engine_deinit();
+    hal_audio_deinit();
+    TEST_ASSERT_EQUAL(HAL_AUDIO_HOST_SINK_NULL, hal_audio_host_get_sink());
+
+    audio_probe_t probe;
+    TEST_ASSERT_TRUE(audio_decoder_probe_file("/out.wav", &probe));
+    TEST_ASSERT_EQUAL(44100, probe.info.sample_rate);
+    TEST_ASSERT_EQUAL(2, probe.info.channels);
+    TEST_ASSERT_EQUAL(5000, (uint32_t)probe.info.total_frames);
+
+    // And it plays back to the same samples
+    audio_engine_config_t config = {};
+    config.start_task = false;
+    TEST_ASSERT_TRUE(audio_engine_init(&config));
+    audio_engine_set_volume(100);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/out.wav"));
+    static int16_t out[6000 * 2];
+    TEST_ASSERT_EQUAL(5000, audio_engine_render(out, 6000));
+    for (int i = 0; i < 5000; i++) TEST_ASSERT_EQUAL(i, out[i * 2]);
+}
+
+void test_host_real_time_sink_keeps_the_sample_clock(void) {
+    TEST_ASSERT_TRUE(hal_audio_host_set_sink(HAL_AUDIO_HOST_SINK_MEMORY, nullptr));
+    hal_audio_config_t config = {};
+    config.sample_rate = 44100;
+    config.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+    TEST_ASSERT_TRUE(hal_audio_init(&config));
+    TEST_ASSERT_FALSE(hal_audio_host_is_offline());
+
+    // 90 ms of audio takes about 90 ms to play
+    static int16_t block[4000 * 2];
+    for (int i = 0; i < 4000 * 2; i++) block[i] = 100;
+    auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(hal_audio_write_samples(block, 4000 * 2));
+    hal_audio_end_stream();
+    TEST_ASSERT_TRUE(hal_audio_host_wait_drained(1000));
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT_TRUE(secs > 0.06);
+
+    // The last period is padded with silence, as the DAC would play it
+    size_t samples = hal_audio_host_get_memory_samples();
+    TEST_ASSERT_EQUAL(0, samples % (256 * 2));
+    TEST_ASSERT_TRUE(samples >= 4000 * 2);
+    int16_t first = 0;
+    hal_audio_host_copy_memory(&first, 0, 1);
+    TEST_ASSERT_EQUAL(100, first);
+}
+
+void test_host_deadline_monitor_counts_one_miss_per_dropout(void) {
+    TEST_ASSERT_TRUE(hal_audio_host_set_sink(HAL_AUDIO_HOST_SINK_NULL, nullptr));
+    hal_audio_config_t config = {};
+    config.sample_rate = 44100;
+    config.format = HAL_AUDIO_FORMAT_PCM_16BIT_STEREO;
+    TEST_ASSERT_TRUE(hal_audio_init(&config));
+
+    // Four periods, a 60 ms stall with the stream still live, four more
+    static int16_t block[1024 * 2];
+    TEST_ASSERT_TRUE(hal_audio_write_samples(block, 1024 * 2));
+    hal_system_delay_ms(60);
+    TEST_ASSERT_TRUE(hal_audio_write_samples(block, 1024 * 2));
+    hal_audio_end_stream();
+    TEST_ASSERT_TRUE(hal_audio_host_wait_drained(1000));
+
+    hal_audio_deadline_stats_t stats;
+    hal_audio_get_deadline_stats(&stats);
+    TEST_ASSERT_EQUAL(5804, stats.period_us);
+    TEST_ASSERT_EQUAL(8, stats.periods);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+    // The late refill counts as no slack; the last of each burst had one period left
+    TEST_ASSERT_EQUAL(0, stats.min_slack_us);
+    TEST_ASSERT_EQUAL(1, stats.slack_bins[0]);
+    TEST_ASSERT_EQUAL(2, stats.slack_bins[5]);
+    TEST_ASSERT_TRUE(stats.max_interval_us > 30000);
+    uint32_t intervals = 0;
+    for (int i = 0; i < HAL_AUDIO_DEADLINE_BINS; i++) intervals += stats.interval_bins[i];
+    TEST_ASSERT_EQUAL(7, intervals);
+
+    uint32_t played = 0, underruns = 0, overruns = 0;
+    hal_audio_get_stats(&played, &underruns, &overruns);
+    TEST_ASSERT_EQUAL(1, underruns);
+
+    hal_audio_reset_deadline_stats();
+    hal_audio_get_deadline_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.periods);
+    TEST_ASSERT_EQUAL(0, stats.misses);
+}
+
+void test_host_position_follows_the_sink_not_the_decoder(void) {
+    write_ramp_wav("/Music/clock.wav", 2, 44100, 44100 * 2);
+    start_output(false, HAL_AUDIO_HOST_SINK_NULL, nullptr);
+    TEST_ASSERT_TRUE(audio_engine_play_file("/Music/clock.wav"));
+    hal_system_delay_ms(150);
+
+    // The engine keeps the ring full ahead of the sink
+    uint32_t played = audio_engine_get_frames_played();
+    uint32_t queued = hal_audio_get_frames_written() - hal_audio_get_frames_played();
+    TEST_ASSERT_TRUE(queued > 256);
+    TEST_ASSERT_TRUE(queued <= HAL_AUDIO_DEFAULT_BUFFER_FRAMES);
+    uint32_t position_ms = audio_engine_get_position_ms();
+    TEST_ASSERT_INT_WITHIN(20, played * 1000ull / 44100, position_ms);
+    TEST_ASSERT_TRUE(position_ms < 400);
+    TEST_ASSERT_EQUAL(2000, hal_audio_get_duration_ms());
+
+    // A seek drops the queued frames; they count as played and the clock restarts there
+    TEST_ASSERT_TRUE(hal_audio_seek_to_ms(1000));
+    hal_system_delay_ms(50);
+    position_ms = hal_audio_get_position_ms();
+    TEST_ASSERT_TRUE(position_ms >= 1000 && position_ms < 1150);
+    TEST_ASSERT_FLOAT_WITHIN(0.08f, 0.5f, hal_audio_get_progress());
+
+    hal_audio_stop();
+    hal_system_delay_ms(20);
+    TEST_ASSERT_EQUAL(0, hal_audio_get_position_ms());
+    TEST_ASSERT_EQUAL(hal_audio_get_frames_written(), hal_audio_get_frames_played());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_host_memory_sink_captures_every_frame_offline);
+    RUN_TEST(test_host_offline_renders_faster_than_real_time);
+    RUN_TEST(test_host_wav_sink_writes_a_playable_file);
+    RUN_TEST(test_host_real_time_sink_keeps_the_sample_clock);
+    RUN_TEST(test_host_deadline_monitor_counts_one_miss_per_dropout);
+    RUN_TEST(test_host_position_follows_the_sink_not_the_decoder);
+
+    return UNITY_END();
+}
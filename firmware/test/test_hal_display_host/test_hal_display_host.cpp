@@ -0,0 +1,136 @@
+/*
+ * Host Display HAL Tests
+ * The tiled path against the in-memory panel: what lands on it, when, and the bytes each frame sends
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include "hal/hal_display.h"
+
+#define TEST_PANEL  (HAL_DISPLAY_WIDTH * HAL_DISPLAY_HEIGHT)
+
+static std::vector<uint16_t> copy_panel(void) {
+    std::vector<uint16_t> panel(hal_display_host_copy_panel(NULL, 0));
+    hal_display_host_copy_panel(panel.data(), panel.size());
+    return panel;
+}
+
+// Every panel pixel is what the recorded calls say it should be
+static void assert_panel_matches_calls(void) {
+    std::vector<uint16_t> panel = copy_panel();
+    uint16_t width = hal_display_get_width();
+    TEST_ASSERT_EQUAL(TEST_PANEL, panel.size());
+    for (size_t i = 0; i < panel.size(); i++) {
+        if (panel[i] != hal_display_get_pixel(i % width, i / width)) {
+            TEST_FAIL_MESSAGE("panel differs from the recorded calls");
+        }
+    }
+}
+
+static void draw_status_screen(uint32_t frame) {
+    hal_display_clear(HAL_COLOR_BLACK);
+    hal_display_fill_rect(0, 0, HAL_DISPLAY_WIDTH, 24, HAL_COLOR_BLUE);
+    hal_display_draw_text_aligned(0, 4, HAL_DISPLAY_WIDTH, "Now Playing", HAL_COLOR_WHITE,
+                                  HAL_FONT_SIZE_MEDIUM, HAL_TEXT_ALIGN_CENTER);
+    hal_display_draw_circle(120, 160, 40, HAL_COLOR_GREEN);
+    hal_display_fill_triangle(100, 140, 100, 180, 145, 160, HAL_COLOR_YELLOW);
+    hal_display_set_text_size(HAL_FONT_SIZE_SMALL);
+    hal_display_set_text_color(HAL_COLOR_WHITE);
+    hal_display_set_text_background(HAL_COLOR_GRAY);
+    hal_display_set_cursor(10, 300);
+    hal_display_printf("Frame: %lu", (unsigned long)frame);
+}
+
+void setUp(void) {
+    TEST_ASSERT_TRUE(hal_display_init());
+    hal_display_reset_tile_stats();
+}
+
+void tearDown(void) {
+    hal_display_deinit();
+}
+
+void test_nothing_reaches_the_panel_before_update(void) {
+    hal_display_vsync();
+    std::vector<uint16_t> before = copy_panel();
+    draw_status_screen(1);
+    hal_display_vsync();
+    TEST_ASSERT_TRUE(before == copy_panel());
+    TEST_ASSERT_EQUAL_HEX16(HAL_COLOR_BLUE, hal_display_get_pixel(5, 5));   // Recorded all the same
+
+    hal_display_update();
+    TEST_ASSERT_TRUE(hal_display_is_busy());                // Last tiles still in flight
+    hal_display_vsync();
+    TEST_ASSERT_FALSE(hal_display_is_busy());
+    assert_panel_matches_calls();
+    TEST_ASSERT_EQUAL_HEX16(HAL_COLOR_GRAY, copy_panel()[302 * HAL_DISPLAY_WIDTH + 15]);  // Cell spacing, opaque
+}
+
+void test_redrawn_frames_send_only_what_changed(void) {
+    hal_display_tile_stats_t stats;
+    draw_status_screen(1);
+    hal_display_update();
+    hal_display_get_tile_stats(&stats);
+    TEST_ASSERT_EQUAL(TEST_PANEL * 2, stats.last_frame_bytes);
+    TEST_ASSERT_EQUAL((TEST_PANEL + HAL_DISPLAY_WIDTH * HAL_DISPLAY_TILE_ROWS - 1) /
+                      (HAL_DISPLAY_WIDTH * HAL_DISPLAY_TILE_ROWS), stats.tiles);
+
+    // Cleared and drawn again the same: nothing to send
+    draw_status_screen(1);
+    hal_display_update();
+    hal_display_get_tile_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.frames);
+
+    // Only the frame counter moved
+    draw_status_screen(2);
+    hal_display_update();
+    hal_display_vsync();
+    hal_display_get_tile_stats(&stats);
+    printf("counter tick: %lu bytes (%.2f%% of a full frame)\n", (unsigned long)stats.last_frame_bytes,
+           stats.last_frame_bytes * 100.0 / (TEST_PANEL * 2));
+    TEST_ASSERT_EQUAL(2, stats.frames);
+    TEST_ASSERT_EQUAL(8 * 6 * 8 * 2, stats.last_frame_bytes);
+    TEST_ASSERT_EQUAL((uint64_t)(TEST_PANEL * 2 + 8 * 6 * 8 * 2), stats.bytes);
+    assert_panel_matches_calls();
+}
+
+void test_calls_past_the_list_capacity_are_counted(void) {
+    hal_display_clear(HAL_COLOR_BLACK);
+    for (int i = 0; i < 300; i++) {
+        hal_display_draw_line(0, i, i % HAL_DISPLAY_WIDTH, i, HAL_COLOR_WHITE);
+    }
+    hal_display_tile_stats_t stats;
+    hal_display_get_tile_stats(&stats);
+    TEST_ASSERT_EQUAL(300 - 255, stats.dropped_ops);        // The clear holds one slot
+}
+
+void test_rotation_swaps_dimensions_and_repaints(void) {
+    draw_status_screen(1);
+    hal_display_update();
+    hal_display_vsync();
+
+    hal_display_set_rotation(HAL_DISPLAY_ROTATION_90);
+    TEST_ASSERT_EQUAL(HAL_DISPLAY_HEIGHT, hal_display_get_width());
+    TEST_ASSERT_EQUAL(HAL_DISPLAY_WIDTH, hal_display_get_height());
+    hal_display_reset_tile_stats();
+    hal_display_update();
+    hal_display_vsync();
+
+    hal_display_tile_stats_t stats;
+    hal_display_get_tile_stats(&stats);
+    TEST_ASSERT_EQUAL(TEST_PANEL * 2, stats.last_frame_bytes);
+    assert_panel_matches_calls();
+    hal_display_set_rotation(HAL_DISPLAY_ROTATION_0);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_nothing_reaches_the_panel_before_update);
+    RUN_TEST(test_redrawn_frames_send_only_what_changed);
+    RUN_TEST(test_calls_past_the_list_capacity_are_counted);
+    RUN_TEST(test_rotation_swaps_dimensions_and_repaints);
+
+    return UNITY_END();
+}
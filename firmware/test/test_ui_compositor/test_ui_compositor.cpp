@@ -0,0 +1,186 @@
+/*
+ * UI Compositor Tests
+ * Damage merging, clipped band drawing and the band-by-band push to the panel
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <vector>
+#include "ui/ui_compositor.h"
+
+#define TEST_WIDTH   320
+#define TEST_HEIGHT  240
+
+// In-memory panel the compositor pushes to
+static std::vector<uint16_t> g_panel;
+static uint32_t g_pushes;
+
+static void push_to_panel(const ui_rect_t* rect, const uint16_t* pixels, void* user_data) {
+    (void)user_data;
+    for (int16_t row = 0; row < rect->h; row++) {
+        memcpy(&g_panel[(rect->y + row) * TEST_WIDTH + rect->x], pixels + row * rect->w, rect->w * sizeof(uint16_t));
+    }
+    g_pushes++;
+}
+
+static uint16_t panel_at(int x, int y) {
+    return g_panel[y * TEST_WIDTH + x];
+}
+
+// A box whose color the test changes, over a striped background
+static uint16_t g_box_color;
+
+static void paint_scene(ui_canvas_t* canvas, void* user_data) {
+    (void)user_data;
+    for (int16_t y = 0; y < TEST_HEIGHT; y += 4) ui_canvas_hline(canvas, 0, y, TEST_WIDTH, 0x1111);
+    ui_canvas_fill_rect(canvas, 100, 100, 40, 20, g_box_color);
+    ui_canvas_text(canvas, 10, 10, "Hi", 0xFFFF, 2);
+}
+
+void setUp(void) {
+    g_panel.assign(TEST_WIDTH * TEST_HEIGHT, 0xDEAD);
+    g_pushes = 0;
+    g_box_color = 0xF800;
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+void test_damage_merges_overlapping_and_keeps_distant_rects(void) {
+    ui_damage_t damage;
+    ui_damage_init(&damage, TEST_WIDTH, TEST_HEIGHT);
+
+    ui_damage_add(&damage, ui_rect_t{10, 10, 20, 10});
+    ui_damage_add(&damage, ui_rect_t{20, 10, 20, 10});     // Overlaps: one window
+    TEST_ASSERT_EQUAL(1, damage.count);
+    TEST_ASSERT_EQUAL(300, ui_damage_area(&damage));
+
+    ui_damage_add(&damage, ui_rect_t{200, 150, 10, 10});   // Far away: its own window
+    TEST_ASSERT_EQUAL(2, damage.count);
+    ui_damage_add(&damage, ui_rect_t{12, 12, 5, 5});       // Already covered
+    TEST_ASSERT_EQUAL(2, damage.count);
+    TEST_ASSERT_EQUAL(400, ui_damage_area(&damage));
+
+    // Clipped to the screen, and nothing for an empty or off-screen rect
+    ui_damage_add(&damage, ui_rect_t{310, 230, 50, 50});
+    ui_damage_add(&damage, ui_rect_t{-40, 0, 20, 20});
+    ui_damage_add(&damage, ui_rect_t{50, 50, 0, 10});
+    TEST_ASSERT_EQUAL(3, damage.count);
+    TEST_ASSERT_EQUAL(500, ui_damage_area(&damage));
+
+    ui_damage_add_screen(&damage);
+    TEST_ASSERT_EQUAL(1, damage.count);
+    TEST_ASSERT_EQUAL(TEST_WIDTH * TEST_HEIGHT, ui_damage_area(&damage));
+}
+
+void test_damage_never_exceeds_its_window_budget(void) {
+    ui_damage_t damage;
+    ui_damage_init(&damage, TEST_WIDTH, TEST_HEIGHT);
+    // A grid of small, well separated rects: more than the list holds
+    for (int16_t y = 0; y < 200; y += 40) {
+        for (int16_t x = 0; x < 300; x += 40) ui_damage_add(&damage, ui_rect_t{x, y, 4, 4});
+    }
+    TEST_ASSERT_EQUAL(UI_DAMAGE_MAX_RECTS, damage.count);
+
+    // Still covers every one of them
+    for (int16_t y = 0; y < 200; y += 40) {
+        for (int16_t x = 0; x < 300; x += 40) {
+            bool covered = false;
+            for (uint32_t i = 0; i < damage.count; i++) {
+                ui_rect_t hit = ui_rect_intersect(damage.rects[i], ui_rect_t{x, y, 4, 4});
+                covered |= ui_rect_area(hit) == 16;
+            }
+            TEST_ASSERT_TRUE(covered);
+        }
+    }
+}
+
+void test_canvas_clips_to_its_band(void) {
+    uint16_t pixels[20 * 4];
+    ui_canvas_t canvas;
+    ui_canvas_init(&canvas, pixels, ui_rect_t{100, 50, 20, 4});
+    ui_canvas_fill(&canvas, 0);
+
+    ui_canvas_fill_rect(&canvas, 90, 40, 15, 11, 0xAAAA);  // Covers only (100..104, 50)
+    ui_canvas_vline(&canvas, 119, 0, 240, 0xBBBB);
+    ui_canvas_rect(&canvas, 0, 0, 320, 240, 0xCCCC);       // Screen border: outside the band
+
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 20; x++) {
+            uint16_t expected = x == 19 ? 0xBBBB : (y == 0 && x < 5) ? 0xAAAA : 0;
+            TEST_ASSERT_EQUAL_HEX16(expected, pixels[y * 20 + x]);
+        }
+    }
+}
+
+void test_canvas_text_matches_the_classic_font(void) {
+    uint16_t pixels[12 * 8];
+    ui_canvas_t canvas;
+    ui_canvas_init(&canvas, pixels, ui_rect_t{0, 0, 12, 8});
+    ui_canvas_fill(&canvas, 0);
+
+    TEST_ASSERT_EQUAL(12, ui_canvas_text(&canvas, 0, 0, "1-", 1, 1));
+    // '1' is 0x00 0x42 0x7F 0x40 0x00: column 2 is solid for seven rows
+    for (int y = 0; y < 7; y++) TEST_ASSERT_EQUAL(1, pixels[y * 12 + 2]);
+    TEST_ASSERT_EQUAL(0, pixels[7 * 12 + 2]);
+    // '-' is row 3 across its five columns, nothing in the spacing column
+    for (int x = 6; x < 11; x++) TEST_ASSERT_EQUAL(1, pixels[3 * 12 + x]);
+    TEST_ASSERT_EQUAL(0, pixels[3 * 12 + 11]);
+
+    ui_rect_t bounds = ui_text_bounds(10, 20, "Vol: 50%\nnext", 2);
+    TEST_ASSERT_EQUAL(8 * 12, bounds.w);
+    TEST_ASSERT_EQUAL(16, bounds.h);
+}
+
+void test_compositor_pushes_only_the_damage(void) {
+    ui_compositor_t compositor;
+    const ui_panel_t panel = {push_to_panel, NULL, NULL};
+    TEST_ASSERT_TRUE(ui_compositor_init(&compositor, TEST_WIDTH, TEST_HEIGHT, UI_COMPOSITOR_BAND_ROWS,
+                                        0x0000, &panel));
+    TEST_ASSERT_FALSE(ui_compositor_is_dirty(&compositor));
+    TEST_ASSERT_EQUAL(0, ui_compositor_flush(&compositor, paint_scene, NULL));
+
+    // The first frame covers the panel in full-width bands
+    ui_compositor_invalidate_all(&compositor);
+    TEST_ASSERT_EQUAL(TEST_WIDTH * TEST_HEIGHT, ui_compositor_flush(&compositor, paint_scene, NULL));
+    TEST_ASSERT_EQUAL(TEST_HEIGHT / UI_COMPOSITOR_BAND_ROWS, g_pushes);
+    TEST_ASSERT_EQUAL_HEX16(0x1111, panel_at(0, 4));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, panel_at(0, 5));
+    TEST_ASSERT_EQUAL_HEX16(0xF800, panel_at(120, 110));
+
+    // Then the box alone: one narrow window, the rest of the panel untouched
+    g_box_color = 0x001F;
+    g_panel[0] = 0xDEAD;
+    ui_compositor_invalidate(&compositor, ui_rect_t{100, 100, 40, 20});
+    g_pushes = 0;
+    TEST_ASSERT_EQUAL(800, ui_compositor_flush(&compositor, paint_scene, NULL));
+    TEST_ASSERT_EQUAL(1, g_pushes);
+    TEST_ASSERT_EQUAL_HEX16(0x001F, panel_at(120, 110));
+    TEST_ASSERT_EQUAL_HEX16(0xDEAD, panel_at(0, 0));
+    TEST_ASSERT_FALSE(ui_compositor_is_dirty(&compositor));
+
+    ui_compositor_stats_t stats;
+    ui_compositor_get_stats(&compositor, &stats);
+    TEST_ASSERT_EQUAL(2, stats.frames);
+    TEST_ASSERT_EQUAL(TEST_HEIGHT / UI_COMPOSITOR_BAND_ROWS + 1, stats.windows);
+    TEST_ASSERT_EQUAL(TEST_WIDTH * TEST_HEIGHT + 800, stats.pixels);
+    TEST_ASSERT_EQUAL(800, stats.last_pixels);
+    ui_compositor_reset_stats(&compositor);
+    ui_compositor_get_stats(&compositor, &stats);
+    TEST_ASSERT_EQUAL(0, stats.pixels);
+
+    ui_compositor_deinit(&compositor);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_damage_merges_overlapping_and_keeps_distant_rects);
+    RUN_TEST(test_damage_never_exceeds_its_window_budget);
+    RUN_TEST(test_canvas_clips_to_its_band);
+    RUN_TEST(test_canvas_text_matches_the_classic_font);
+    RUN_TEST(test_compositor_pushes_only_the_damage);
+
+    return UNITY_END();
+}
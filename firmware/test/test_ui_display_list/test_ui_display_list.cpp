@@ -0,0 +1,205 @@
+/*
+ * UI Display List Tests
+ * Replay against direct drawing, call-by-call damage, and tiled updates through an asynchronous panel
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <deque>
+#include "ui/ui_tiled_display.h"
+
+#define TEST_WIDTH   240
+#define TEST_HEIGHT  320
+#define TEST_PANEL   (TEST_WIDTH * TEST_HEIGHT)
+#define TEST_TILE_ROWS  32
+
+static ui_display_list_t g_list;
+static ui_display_list_t g_shown;
+
+static const uint8_t k_arrow[] = {0x18, 0x3C, 0x7E, 0xFF, 0x18, 0x18, 0x18, 0x18};
+
+static void record_scene(ui_display_list_t* list, const char* status) {
+    ui_display_list_clear(list, 0x0010);
+    ui_display_list_fill_rect(list, 10, 10, 100, 40, 0xF800);
+    ui_display_list_rect(list, 5, 5, 110, 50, 0xFFFF);
+    ui_display_list_line(list, 0, 319, 239, 60, 0x07E0);
+    ui_display_list_circle(list, 160, 120, 30, 0xFFE0, false);
+    ui_display_list_circle(list, 160, 120, 12, 0x07FF, true);
+    ui_display_list_triangle(list, 20, 200, 100, 150, 60, 260, 0xF81F, true);
+    ui_display_list_triangle(list, 120, 200, 200, 280, 130, 300, 0x8410, false);
+    ui_display_list_bitmap(list, 200, 20, k_arrow, 8, 8, 0xFFFF);
+    ui_display_list_text(list, 12, 300, status, 0xFFFF, 2);
+}
+
+static std::vector<uint16_t> paint_full(const ui_display_list_t* list) {
+    std::vector<uint16_t> pixels(TEST_PANEL, 0);
+    ui_canvas_t canvas;
+    ui_canvas_init(&canvas, pixels.data(), ui_rect_t{0, 0, TEST_WIDTH, TEST_HEIGHT});
+    ui_display_list_paint(list, &canvas);
+    return pixels;
+}
+
+static bool damage_covers(const ui_damage_t* damage, ui_rect_t rect) {
+    for (uint32_t i = 0; i < damage->count; i++) {
+        if (ui_rect_area(ui_rect_intersect(damage->rects[i], rect)) == ui_rect_area(rect)) return true;
+    }
+    return false;
+}
+
+void setUp(void) {
+    TEST_ASSERT_TRUE(ui_display_list_init(&g_list, UI_DISPLAY_LIST_MAX_OPS, UI_DISPLAY_LIST_TEXT_BYTES));
+    TEST_ASSERT_TRUE(ui_display_list_init(&g_shown, UI_DISPLAY_LIST_MAX_OPS, 0));
+}
+
+void tearDown(void) {
+    ui_display_list_deinit(&g_list);
+    ui_display_list_deinit(&g_shown);
+}
+
+void test_replay_matches_direct_drawing(void) {
+    record_scene(&g_list, "Vol 50");
+    std::vector<uint16_t> replayed = paint_full(&g_list);
+
+    std::vector<uint16_t> direct(TEST_PANEL, 0);
+    ui_canvas_t canvas;
+    ui_canvas_init(&canvas, direct.data(), ui_rect_t{0, 0, TEST_WIDTH, TEST_HEIGHT});
+    ui_canvas_fill(&canvas, 0x0010);
+    ui_canvas_fill_rect(&canvas, 10, 10, 100, 40, 0xF800);
+    ui_canvas_rect(&canvas, 5, 5, 110, 50, 0xFFFF);
+    ui_canvas_line(&canvas, 0, 319, 239, 60, 0x07E0);
+    ui_canvas_circle(&canvas, 160, 120, 30, 0xFFE0);
+    ui_canvas_fill_circle(&canvas, 160, 120, 12, 0x07FF);
+    ui_canvas_fill_triangle(&canvas, 20, 200, 100, 150, 60, 260, 0xF81F);
+    ui_canvas_triangle(&canvas, 120, 200, 200, 280, 130, 300, 0x8410);
+    ui_canvas_bitmap(&canvas, 200, 20, k_arrow, 8, 8, 0xFFFF);
+    ui_canvas_text(&canvas, 12, 300, "Vol 50", 0xFFFF, 2);
+    TEST_ASSERT_TRUE(direct == replayed);
+
+    // Painting a tile at a time gives the same pixels
+    std::vector<uint16_t> tiled(TEST_PANEL, 0);
+    for (int16_t y = 0; y < TEST_HEIGHT; y += TEST_TILE_ROWS) {
+        ui_canvas_init(&canvas, &tiled[y * TEST_WIDTH], ui_rect_t{0, y, TEST_WIDTH, TEST_TILE_ROWS});
+        ui_display_list_paint(&g_list, &canvas);
+    }
+    TEST_ASSERT_TRUE(direct == tiled);
+}
+
+void test_diff_damages_only_the_calls_that_changed(void) {
+    ui_damage_t damage;
+    ui_damage_init(&damage, TEST_WIDTH, TEST_HEIGHT);
+
+    record_scene(&g_list, "Vol 50");
+    ui_display_list_snapshot(&g_list, &g_shown);
+    record_scene(&g_list, "Vol 50");                        // Cleared and redrawn the same
+    ui_display_list_diff(&g_shown, &g_list, &damage);
+    TEST_ASSERT_TRUE(ui_damage_is_empty(&damage));
+
+    record_scene(&g_list, "Vol 52");
+    ui_display_list_diff(&g_shown, &g_list, &damage);
+    TEST_ASSERT_EQUAL(1, damage.count);
+    TEST_ASSERT_EQUAL(6 * UI_FONT_CELL_W * 2 * UI_FONT_CELL_H * 2, ui_damage_area(&damage));
+
+    // A call that is gone damages where it was
+    ui_damage_clear(&damage);
+    ui_display_list_snapshot(&g_list, &g_shown);
+    ui_display_list_clear(&g_list, 0x0010);
+    ui_display_list_fill_rect(&g_list, 10, 10, 100, 40, 0xF800);
+    ui_display_list_diff(&g_shown, &g_list, &damage);
+    TEST_ASSERT_TRUE(damage_covers(&damage, ui_rect_t{200, 20, 8, 8}));      // The arrow
+    TEST_ASSERT_TRUE(damage_covers(&damage, ui_rect_t{130, 90, 61, 61}));    // The outer circle
+}
+
+void test_full_list_drops_calls_and_covered_calls_retire(void) {
+    ui_display_list_clear(&g_list, 0);
+    uint32_t dropped = 0;
+    for (int i = 0; i < UI_DISPLAY_LIST_MAX_OPS + 10; i++) {
+        if (!ui_display_list_line(&g_list, 0, i % TEST_HEIGHT, 10, i % TEST_HEIGHT, 0xFFFF)) dropped++;
+    }
+    TEST_ASSERT_EQUAL(11, dropped);                         // The clear holds one slot
+    TEST_ASSERT_EQUAL(11, g_list.dropped);
+    ui_display_list_clear(&g_list, 0);
+    TEST_ASSERT_EQUAL(0, g_list.dropped);
+
+    // An overlay redrawn in place without a clear stays a few calls, text included
+    for (int frame = 0; frame < 1000; frame++) {
+        char counter[16];
+        snprintf(counter, sizeof(counter), "%d", frame);
+        TEST_ASSERT_TRUE(ui_display_list_fill_rect(&g_list, 199, 4, 38, 18, 0));
+        TEST_ASSERT_TRUE(ui_display_list_text(&g_list, 200, 5, counter, 0xFFFF, 2));
+    }
+    TEST_ASSERT_EQUAL(3, g_list.count);
+    TEST_ASSERT_EQUAL(0, g_list.dropped);
+    TEST_ASSERT_EQUAL_STRING("999", (const char*)g_list.ops[2].data);
+}
+
+// Asynchronous panel: a pushed tile lands only when the renderer waits for it
+struct test_tile {
+    ui_rect_t rect;
+    const uint16_t* pixels;
+};
+static std::vector<uint16_t> g_panel;
+static std::deque<test_tile> g_in_flight;
+static uint32_t g_max_in_flight;
+
+static void push_tile(const ui_rect_t* rect, const uint16_t* pixels, void* user_data) {
+    (void)user_data;
+    g_in_flight.push_back(test_tile{*rect, pixels});
+    if (g_in_flight.size() > g_max_in_flight) g_max_in_flight = g_in_flight.size();
+}
+
+static void wait_tile(void* user_data) {
+    (void)user_data;
+    TEST_ASSERT_FALSE(g_in_flight.empty());
+    test_tile tile = g_in_flight.front();
+    g_in_flight.pop_front();
+    for (int16_t row = 0; row < tile.rect.h; row++) {
+        memcpy(&g_panel[(tile.rect.y + row) * TEST_WIDTH + tile.rect.x], tile.pixels + row * tile.rect.w,
+               tile.rect.w * sizeof(uint16_t));
+    }
+}
+
+void test_tiled_updates_match_a_full_repaint(void) {
+    g_panel.assign(TEST_PANEL, 0xDEAD);
+    g_in_flight.clear();
+    g_max_in_flight = 0;
+    ui_tiled_display_t display;
+    const ui_panel_t panel = {push_tile, wait_tile, NULL};
+    TEST_ASSERT_TRUE(ui_tiled_display_init(&display, TEST_WIDTH, TEST_HEIGHT, TEST_TILE_ROWS, &panel));
+
+    record_scene(&display.frame, "Vol 50");
+    TEST_ASSERT_EQUAL(TEST_PANEL, ui_tiled_display_update(&display));
+    TEST_ASSERT_EQUAL(2, g_max_in_flight);                  // Double-buffered
+    ui_tiled_display_sync(&display);
+    TEST_ASSERT_TRUE(g_in_flight.empty());
+    TEST_ASSERT_TRUE(paint_full(&display.frame) == g_panel);
+
+    record_scene(&display.frame, "Vol 50");
+    TEST_ASSERT_EQUAL(0, ui_tiled_display_update(&display));
+
+    record_scene(&display.frame, "Vol 9");
+    uint32_t pixels = ui_tiled_display_update(&display);
+    TEST_ASSERT_EQUAL(6 * UI_FONT_CELL_W * 2 * UI_FONT_CELL_H * 2, pixels);
+    ui_tiled_display_sync(&display);
+    TEST_ASSERT_TRUE(paint_full(&display.frame) == g_panel);
+    TEST_ASSERT_EQUAL_HEX16(0xF800, ui_tiled_display_pixel(&display, 12, 20));
+
+    // A rotation repaints the whole panel
+    TEST_ASSERT_TRUE(ui_tiled_display_resize(&display, TEST_WIDTH, TEST_HEIGHT));
+    TEST_ASSERT_EQUAL(TEST_PANEL, ui_tiled_display_update(&display));
+
+    ui_tiled_display_deinit(&display);                      // Waits for the last tiles
+    TEST_ASSERT_TRUE(g_in_flight.empty());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_replay_matches_direct_drawing);
+    RUN_TEST(test_diff_damages_only_the_calls_that_changed);
+    RUN_TEST(test_full_list_drops_calls_and_covered_calls_retire);
+    RUN_TEST(test_tiled_updates_match_a_full_repaint);
+
+    return UNITY_END();
+}
@@ -0,0 +1,265 @@
+/*
+ * UI Font Tests
+ * Packed alpha blitting, blending, band clipping and the text run cache
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "ui/ui_font.h"
+#include "ui/ui_text_cache.h"
+
+#define TEST_WIDTH   320
+#define TEST_HEIGHT  64
+#define TEST_BG      0x0000
+
+static std::vector<uint16_t> g_pixels;
+static ui_canvas_t g_canvas;
+
+static uint16_t pixel_at(int x, int y) {
+    return g_pixels[y * TEST_WIDTH + x];
+}
+
+// The full test area filled with a color
+static void reset_canvas(uint16_t color) {
+    g_pixels.assign(TEST_WIDTH * TEST_HEIGHT, color);
+    ui_canvas_init(&g_canvas, g_pixels.data(), ui_rect_t{0, 0, TEST_WIDTH, TEST_HEIGHT});
+}
+
+// Paints the test area a band at a time, each band starting from the background
+typedef void (*paint_fn)(ui_canvas_t* canvas, void* user_data);
+
+static std::vector<uint16_t> paint_in_bands(paint_fn paint, void* user_data, int16_t band_rows, int16_t band_cols) {
+    std::vector<uint16_t> out(TEST_WIDTH * TEST_HEIGHT, TEST_BG);
+    for (int16_t y = 0; y < TEST_HEIGHT; y += band_rows) {
+        for (int16_t x = 0; x < TEST_WIDTH; x += band_cols) {
+            ui_rect_t rect = {x, y, band_cols, band_rows};
+            if (x + rect.w > TEST_WIDTH) rect.w = TEST_WIDTH - x;
+            if (y + rect.h > TEST_HEIGHT) rect.h = TEST_HEIGHT - y;
+            std::vector<uint16_t> band(rect.w * rect.h, TEST_BG);
+            ui_canvas_t canvas;
+            ui_canvas_init(&canvas, band.data(), rect);
+            paint(&canvas, user_data);
+            for (int16_t row = 0; row < rect.h; row++) {
+                memcpy(&out[(y + row) * TEST_WIDTH + x], &band[row * rect.w], rect.w * sizeof(uint16_t));
+            }
+        }
+    }
+    return out;
+}
+
+void setUp(void) {
+    reset_canvas(TEST_BG);
+}
+
+void tearDown(void) {
+    // Clean up test environment
+}
+
+void test_span_blitter_draws_each_alpha_depth(void) {
+    // One glyph per depth, 4x2 ink at (1, 2) in its cell: a row of clear, partial, partial, full
+    // and a row of full, full, clear, full
+    static const uint8_t bits1[] = {0x10, 0xD0};                      // 0 0 0 1 / 1 1 0 1
+    static const uint8_t bits2[] = {0x1B, 0xF3};                      // 0 1 2 3 / 3 3 0 3
+    static const uint8_t bits4[] = {0x05, 0xAF, 0xFF, 0x0F};          // 0 5 10 15 / 15 15 0 15
+    static const ui_glyph_t glyph1[] = {{0, 4, 2, 1, 2, 6}};
+    static const ui_glyph_t glyph2[] = {{0, 4, 2, 1, 2, 6}};
+    static const ui_glyph_t glyph4[] = {{0, 4, 2, 1, 2, 6}};
+    const ui_font_t fonts[] = {
+        {bits1, glyph1, '?', '?', 1, 8, 6},
+        {bits2, glyph2, '?', '?', 2, 8, 6},
+        {bits4, glyph4, '?', '?', 4, 8, 6},
+    };
+
+    const uint16_t color = 0xFFFF, under = 0x18E3;
+    for (const ui_font_t& font : fonts) {
+        reset_canvas(under);
+        // Characters outside the font draw its '?'
+        TEST_ASSERT_EQUAL(22, ui_font_draw(&g_canvas, 10, 20, "?A", &font, color));
+
+        const uint32_t levels = (1u << font.bpp) - 1;
+        const uint32_t partial[] = {0, font.bpp == 1 ? 0 : 1 * levels / 3, font.bpp == 1 ? 0 : 2 * levels / 3};
+        for (int glyph = 0; glyph < 2; glyph++) {
+            int16_t x = 11 + glyph * 6, y = 22;
+            TEST_ASSERT_EQUAL_HEX16(under, pixel_at(x, y));
+            for (int col = 1; col < 3; col++) {
+                uint32_t alpha = font.bpp == 4 ? col * 5 : partial[col];
+                uint16_t expected = alpha ? ui_blend565(color, under, (alpha * 32 + levels / 2) / levels) : under;
+                TEST_ASSERT_EQUAL_HEX16(expected, pixel_at(x + col, y));
+            }
+            TEST_ASSERT_EQUAL_HEX16(color, pixel_at(x + 3, y));
+            TEST_ASSERT_EQUAL_HEX16(color, pixel_at(x, y + 1));
+            TEST_ASSERT_EQUAL_HEX16(color, pixel_at(x + 1, y + 1));
+            TEST_ASSERT_EQUAL_HEX16(under, pixel_at(x + 2, y + 1));
+            TEST_ASSERT_EQUAL_HEX16(color, pixel_at(x + 3, y + 1));
+            TEST_ASSERT_EQUAL_HEX16(under, pixel_at(x, y - 1));              // Nothing outside the ink
+            TEST_ASSERT_EQUAL_HEX16(under, pixel_at(x + 4, y));
+        }
+    }
+}
+
+void test_blend_is_within_one_step_of_exact(void) {
+    srand(23);
+    for (int i = 0; i < 20000; i++) {
+        uint16_t fg = (uint16_t)rand(), bg = (uint16_t)rand();
+        uint32_t alpha = (uint32_t)(rand() % 33);
+        uint16_t got = ui_blend565(fg, bg, alpha);
+        const int shifts[] = {11, 5, 0}, masks[] = {0x1F, 0x3F, 0x1F};
+        for (int c = 0; c < 3; c++) {
+            int f = (fg >> shifts[c]) & masks[c], b = (bg >> shifts[c]) & masks[c];
+            double exact = b + (f - b) * (double)alpha / 32.0;
+            int channel = (got >> shifts[c]) & masks[c];
+            TEST_ASSERT_TRUE(channel >= exact - 1.0 && channel <= exact + 1.0);
+        }
+    }
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ui_blend565(0xFFFF, 0x1234, 0));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, ui_blend565(0xFFFF, 0x1234, 32));
+}
+
+static void paint_atlas_text(ui_canvas_t* canvas, void* user_data) {
+    (void)user_data;
+    ui_canvas_text(canvas, -7, 3, "Clipped at the edge", 0xFFE0, 2);
+    ui_canvas_text(canvas, 40, 25, "Now Playing gy|", 0x07FF, 3);
+    ui_canvas_text(canvas, 250, 50, "Right edge", 0xF81F, 2);
+}
+
+void test_atlas_text_clips_to_any_band(void) {
+    // Small bands, split mid-glyph in both directions, make the same pixels as one big canvas
+    std::vector<uint16_t> whole = paint_in_bands(paint_atlas_text, NULL, TEST_HEIGHT, TEST_WIDTH);
+    std::vector<uint16_t> bands = paint_in_bands(paint_atlas_text, NULL, 5, 37);
+    TEST_ASSERT_TRUE(whole == bands);
+
+    // Glyphs land in the classic cells: nothing outside them
+    ui_rect_t cells = ui_text_bounds(40, 25, "Now Playing gy|", 3);
+    uint32_t inside = 0;
+    for (int y = 0; y < TEST_HEIGHT; y++) {
+        for (int x = 0; x < TEST_WIDTH; x++) {
+            if (whole[y * TEST_WIDTH + x] != 0x07FF) continue;
+            TEST_ASSERT_TRUE(x >= cells.x && x < cells.x + cells.w && y >= cells.y && y < cells.y + cells.h);
+            inside++;
+        }
+    }
+    TEST_ASSERT_TRUE(inside > 100);
+}
+
+// Cached and direct drawing of the same strings, which must not overlap: cached runs fill their gaps
+struct text_scene {
+    ui_text_cache_t* cache;                 // NULL to draw directly
+};
+
+static const struct {
+    int16_t x, y;
+    const char* text;
+    uint16_t color;
+    uint8_t size;
+} k_strings[] = {
+    {-5, 0, "Home", 0xFFFF, 2},
+    {20, 18, "Artists", 0xFBE0, 1},
+    {20, 30, "Now Playing", 0x07E0, 3},
+    {300, 40, "0:42", 0xFFFF, 1},
+    {100, 56, "Wider than it fits: wraps nowhere", 0xFFFF, 1},
+    {0, 56, "line one\nline two", 0xFFFF, 1},
+};
+
+static void paint_text_scene(ui_canvas_t* canvas, void* user_data) {
+    ui_text_cache_t* cache = ((text_scene*)user_data)->cache;
+    for (const auto& s : k_strings) {
+        int16_t end = cache ? ui_text_cache_draw(cache, canvas, s.x, s.y, s.text, s.color, TEST_BG, s.size)
+                            : ui_canvas_text(canvas, s.x, s.y, s.text, s.color, s.size);
+        TEST_ASSERT_EQUAL(ui_canvas_text(NULL, s.x, s.y, s.text, s.color, s.size), end);
+    }
+}
+
+void test_cached_text_matches_direct_drawing(void) {
+    ui_text_cache_t cache;
+    TEST_ASSERT_TRUE(ui_text_cache_init(&cache, UI_TEXT_CACHE_BYTES));
+    text_scene direct = {NULL}, cached = {&cache};
+
+    std::vector<uint16_t> expected = paint_in_bands(paint_text_scene, &direct, 16, TEST_WIDTH);
+    // The first pass fills the cache, the others copy from it, through bands clipped both ways
+    TEST_ASSERT_TRUE(expected == paint_in_bands(paint_text_scene, &cached, 16, TEST_WIDTH));
+    TEST_ASSERT_TRUE(expected == paint_in_bands(paint_text_scene, &cached, 7, 50));
+    TEST_ASSERT_TRUE(expected == paint_in_bands(paint_text_scene, &cached, TEST_HEIGHT, TEST_WIDTH));
+
+    ui_text_cache_stats_t stats;
+    ui_text_cache_get_stats(&cache, &stats);
+    TEST_ASSERT_EQUAL(6, stats.misses);
+    TEST_ASSERT_EQUAL(0, stats.evictions);
+    TEST_ASSERT_EQUAL(0, stats.uncached);
+    TEST_ASSERT_TRUE(stats.hits > 6 * 4);
+    TEST_ASSERT_TRUE(stats.bytes > 0 && stats.bytes <= UI_TEXT_CACHE_BYTES);
+
+    // Too long for a key: drawn directly
+    char long_text[UI_TEXT_CACHE_TEXT_MAX + 4];
+    memset(long_text, 'x', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+    ui_text_cache_draw(&cache, &g_canvas, 0, 0, long_text, 0xFFFF, TEST_BG, 1);
+    ui_text_cache_get_stats(&cache, &stats);
+    TEST_ASSERT_EQUAL(1, stats.uncached);
+
+    ui_text_cache_deinit(&cache);
+}
+
+static bool draw_hits(ui_text_cache_t* cache, const char* text) {
+    ui_text_cache_stats_t before, after;
+    ui_text_cache_get_stats(cache, &before);
+    ui_text_cache_draw(cache, &g_canvas, 0, 0, text, 0xFFFF, TEST_BG, 2);
+    ui_text_cache_get_stats(cache, &after);
+    return after.hits > before.hits;
+}
+
+void test_cache_evicts_least_recently_used(void) {
+    ui_text_cache_t cache;
+    TEST_ASSERT_TRUE(ui_text_cache_init(&cache, UI_TEXT_CACHE_BYTES));
+    TEST_ASSERT_FALSE(draw_hits(&cache, "Music"));
+    ui_text_cache_stats_t stats;
+    ui_text_cache_get_stats(&cache, &stats);
+    const uint32_t entry_bytes = stats.bytes;
+    ui_text_cache_deinit(&cache);
+
+    // Room for three strings of the same size
+    TEST_ASSERT_TRUE(ui_text_cache_init(&cache, entry_bytes * 3 + entry_bytes / 2));
+    TEST_ASSERT_FALSE(draw_hits(&cache, "Music"));
+    TEST_ASSERT_FALSE(draw_hits(&cache, "Songs"));
+    TEST_ASSERT_FALSE(draw_hits(&cache, "Menus"));
+    TEST_ASSERT_TRUE(draw_hits(&cache, "Music"));              // Now "Songs" is the oldest
+    TEST_ASSERT_FALSE(draw_hits(&cache, "Mucus"));
+    ui_text_cache_get_stats(&cache, &stats);
+    TEST_ASSERT_EQUAL(1, stats.evictions);
+    TEST_ASSERT_TRUE(stats.bytes <= entry_bytes * 3 + entry_bytes / 2);
+    TEST_ASSERT_TRUE(draw_hits(&cache, "Music"));
+    TEST_ASSERT_TRUE(draw_hits(&cache, "Menus"));
+    TEST_ASSERT_FALSE(draw_hits(&cache, "Songs"));
+
+    // And once every entry is taken, the oldest goes even with bytes to spare
+    ui_text_cache_deinit(&cache);
+    TEST_ASSERT_TRUE(ui_text_cache_init(&cache, UI_TEXT_CACHE_BYTES * 16));
+    char text[12];
+    for (int i = 0; i <= UI_TEXT_CACHE_ENTRIES; i++) {
+        snprintf(text, sizeof(text), "%d", i);
+        TEST_ASSERT_FALSE(draw_hits(&cache, text));
+    }
+    ui_text_cache_get_stats(&cache, &stats);
+    TEST_ASSERT_EQUAL(1, stats.evictions);
+    TEST_ASSERT_FALSE(draw_hits(&cache, "0"));
+    TEST_ASSERT_TRUE(draw_hits(&cache, "2"));
+
+    ui_text_cache_clear(&cache);
+    ui_text_cache_get_stats(&cache, &stats);
+    TEST_ASSERT_EQUAL(0, stats.bytes);
+    ui_text_cache_deinit(&cache);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_span_blitter_draws_each_alpha_depth);
+    RUN_TEST(test_blend_is_within_one_step_of_exact);
+    RUN_TEST(test_atlas_text_clips_to_any_band);
+    RUN_TEST(test_cached_text_matches_direct_drawing);
+    RUN_TEST(test_cache_evicts_least_recently_used);
+
+    return UNITY_END();
+}
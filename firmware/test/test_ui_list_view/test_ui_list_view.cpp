@@ -0,0 +1,199 @@
+/*
+ * UI List View Tests
+ * Lazy fetch, the row buffer ring, scroll clamping and what a scroll costs
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "ui/ui_widget.h"
+
+#define TEST_WIDTH   320
+#define TEST_HEIGHT  240
+#define TEST_PANEL   (TEST_WIDTH * TEST_HEIGHT)
+#define TEST_BG      0x0000
+#define TEST_ROWS    10000
+#define VIEW_X       6
+#define VIEW_Y       48
+#define VIEW_W       140
+#define VIEW_H       176                    // Eight rows
+#define ROW_H        22
+
+static std::vector<uint16_t> g_panel;
+static uint32_t g_asked;
+static uint32_t g_last_asked;
+
+static void push_to_panel(const ui_rect_t* rect, const uint16_t* pixels, void* user_data) {
+    std::vector<uint16_t>* panel = (std::vector<uint16_t>*)user_data;
+    for (int16_t row = 0; row < rect->h; row++) {
+        memcpy(&(*panel)[(rect->y + row) * TEST_WIDTH + rect->x], pixels + row * rect->w, rect->w * sizeof(uint16_t));
+    }
+}
+
+static void format_row(uint32_t index, char* text) {
+    snprintf(text, UI_LIST_VIEW_TEXT_MAX, "Track %05lu", (unsigned long)index);
+}
+
+static void synthetic_source(uint32_t index, char* text, void* user_data) {
+    (void)user_data;
+    format_row(index, text);
+    g_asked++;
+    g_last_asked = index;
+}
+
+static ui_compositor_t g_compositor;
+static ui_list_view_t g_view;
+static ui_widget_t g_root, g_list;
+static ui_tree_t g_tree;
+
+static void init_view(ui_list_view_t* view) {
+    TEST_ASSERT_TRUE(ui_list_view_init(view, VIEW_W, VIEW_H, ROW_H, UI_LIST_VIEW_OVERSCAN, 0xFFFF, 0xFBE0, TEST_BG));
+    view->marker_w = 3;
+    view->marker_h = 12;
+    view->text_x = 6;
+    view->text_y = 2;
+    ui_list_view_set_source(view, synthetic_source, NULL, TEST_ROWS);
+}
+
+void setUp(void) {
+    g_asked = 0;
+    g_panel.assign(TEST_PANEL, 0xDEAD);
+    const ui_panel_t panel = {push_to_panel, NULL, &g_panel};
+    TEST_ASSERT_TRUE(ui_compositor_init(&g_compositor, TEST_WIDTH, TEST_HEIGHT, UI_COMPOSITOR_BAND_ROWS, TEST_BG,
+                                        &panel));
+    init_view(&g_view);
+    ui_widget_box(&g_root, ui_rect_t{0, 0, TEST_WIDTH, TEST_HEIGHT}, UI_LAYOUT_FIXED);
+    ui_widget_list_view(&g_list, ui_rect_t{VIEW_X, VIEW_Y, 0, 0}, &g_view);
+    ui_widget_add(&g_root, &g_list);
+    ui_tree_init(&g_tree, &g_root, &g_compositor, NULL);
+    ui_compositor_invalidate_all(&g_compositor);
+}
+
+void tearDown(void) {
+    ui_list_view_deinit(&g_view);
+    ui_compositor_deinit(&g_compositor);
+}
+
+// A plain list of the rows in view, drawn afresh on a panel of its own
+static void assert_panel_matches_plain_list(void) {
+    static char texts[VIEW_H / ROW_H][UI_LIST_VIEW_TEXT_MAX];
+    const char* items[VIEW_H / ROW_H];
+    for (int i = 0; i < VIEW_H / ROW_H; i++) {
+        format_row(g_view.top + i, texts[i]);
+        items[i] = texts[i];
+    }
+
+    std::vector<uint16_t> fresh(TEST_PANEL, 0xDEAD);
+    const ui_panel_t panel = {push_to_panel, NULL, &fresh};
+    ui_compositor_t compositor;
+    TEST_ASSERT_TRUE(ui_compositor_init(&compositor, TEST_WIDTH, TEST_HEIGHT, UI_COMPOSITOR_BAND_ROWS, TEST_BG,
+                                        &panel));
+    ui_widget_t root, list;
+    ui_tree_t tree;
+    ui_widget_box(&root, ui_rect_t{0, 0, TEST_WIDTH, TEST_HEIGHT}, UI_LAYOUT_FIXED);
+    ui_widget_list(&list, ui_rect_t{VIEW_X, VIEW_Y, VIEW_W, 0}, ROW_H, 0xFFFF, 0xFBE0);
+    list.list.marker_w = 3;
+    list.list.marker_h = 12;
+    list.list.text_x = 6;
+    list.list.text_y = 2;
+    ui_widget_set_items(&list, items, VIEW_H / ROW_H);
+    ui_widget_set_selected(&list, (int)(g_view.selected - g_view.top));
+    ui_widget_add(&root, &list);
+    ui_tree_init(&tree, &root, &compositor, NULL);
+    ui_compositor_invalidate_all(&compositor);
+    ui_tree_update(&tree);
+    ui_compositor_deinit(&compositor);
+    TEST_ASSERT_TRUE(fresh == g_panel);
+}
+
+void test_only_the_window_is_fetched(void) {
+    ui_tree_update(&g_tree);
+    ui_list_view_stats_t stats;
+    ui_list_view_get_stats(&g_view, &stats);
+    TEST_ASSERT_EQUAL(VIEW_H / ROW_H, g_asked);         // Out of ten thousand
+    TEST_ASSERT_EQUAL(VIEW_H / ROW_H, stats.renders);
+    TEST_ASSERT_EQUAL(VIEW_H / ROW_H - 1, g_last_asked);
+
+    // The overscan below; there is none above the first row
+    ui_list_view_prefetch(&g_view);
+    TEST_ASSERT_EQUAL(VIEW_H / ROW_H + UI_LIST_VIEW_OVERSCAN, g_asked);
+    ui_list_view_prefetch(&g_view);
+    TEST_ASSERT_EQUAL(VIEW_H / ROW_H + UI_LIST_VIEW_OVERSCAN, g_asked);
+    TEST_ASSERT_EQUAL(0, ui_tree_update(&g_tree));
+}
+
+void test_one_row_scroll_renders_only_the_incoming_row(void) {
+    ui_widget_list_view_select(&g_list, 7);            // Bottom row, no scroll
+    ui_tree_update(&g_tree);
+    assert_panel_matches_plain_list();
+
+    ui_list_view_reset_stats(&g_view);
+    g_asked = 0;
+    ui_widget_list_view_select(&g_list, 8);
+    uint32_t pixels = ui_tree_update(&g_tree);
+    ui_list_view_stats_t stats;
+    ui_list_view_get_stats(&g_view, &stats);
+    TEST_ASSERT_EQUAL(1, g_view.top);
+    TEST_ASSERT_EQUAL(VIEW_W * VIEW_H, pixels);          // The view shifts as a whole
+    TEST_ASSERT_EQUAL(1, g_asked);                       // Row 10, entering the overscan
+    TEST_ASSERT_EQUAL(10, g_last_asked);
+    TEST_ASSERT_EQUAL(3, stats.renders);                 // That row, and the selection leaving 7 for 8
+    TEST_ASSERT_EQUAL(1, stats.scrolls);
+    assert_panel_matches_plain_list();
+
+    // Back up: row 0 still sits in the overscan above
+    g_asked = 0;
+    ui_widget_list_view_select(&g_list, 0);
+    ui_tree_update(&g_tree);
+    TEST_ASSERT_EQUAL(0, g_view.top);
+    TEST_ASSERT_EQUAL(0, g_asked);
+    assert_panel_matches_plain_list();
+}
+
+void test_selection_in_view_repaints_two_rows(void) {
+    ui_widget_list_view_select(&g_list, 2);
+    ui_tree_update(&g_tree);
+    ui_widget_list_view_select(&g_list, 3);
+    TEST_ASSERT_EQUAL(2 * VIEW_W * ROW_H, ui_tree_update(&g_tree));
+    assert_panel_matches_plain_list();
+}
+
+void test_scrolling_clamps_to_the_last_row(void) {
+    ui_widget_list_view_select(&g_list, TEST_ROWS - 1);
+    ui_tree_update(&g_tree);
+    TEST_ASSERT_EQUAL(TEST_ROWS - VIEW_H / ROW_H, g_view.top);
+    assert_panel_matches_plain_list();
+
+    ui_widget_list_view_scroll(&g_list, UINT32_MAX);
+    TEST_ASSERT_EQUAL(TEST_ROWS - VIEW_H / ROW_H, g_view.top);
+    TEST_ASSERT_EQUAL(0, ui_tree_update(&g_tree));
+
+    // Past the end is no selection
+    TEST_ASSERT_FALSE(ui_list_view_select(&g_view, TEST_ROWS));
+    TEST_ASSERT_EQUAL(UI_LIST_VIEW_NO_ROW, g_view.selected);
+}
+
+void test_short_list_leaves_the_rest_blank(void) {
+    ui_list_view_set_source(&g_view, synthetic_source, NULL, 3);
+    ui_widget_list_view_reload(&g_list);
+    ui_widget_list_view_select(&g_list, 1);
+    ui_tree_update(&g_tree);
+    ui_widget_list_view_scroll(&g_list, 2);
+    TEST_ASSERT_EQUAL(0, g_view.top);
+    for (int y = VIEW_Y + 3 * ROW_H; y < VIEW_Y + VIEW_H; y++) {
+        for (int x = VIEW_X; x < VIEW_X + VIEW_W; x++) TEST_ASSERT_EQUAL_HEX16(TEST_BG, g_panel[y * TEST_WIDTH + x]);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_only_the_window_is_fetched);
+    RUN_TEST(test_one_row_scroll_renders_only_the_incoming_row);
+    RUN_TEST(test_selection_in_view_repaints_two_rows);
+    RUN_TEST(test_scrolling_clamps_to_the_last_row);
+    RUN_TEST(test_short_list_leaves_the_rest_blank);
+
+    return UNITY_END();
+}
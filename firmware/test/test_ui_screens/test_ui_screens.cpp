@@ -0,0 +1,152 @@
+/*
+ * UI Screens Tests
+ * Pixels pushed per interaction, and incremental frames matching a full repaint
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "ui/ui_screens.h"
+
+#define TEST_WIDTH   320                    // Landscape ST7789
+#define TEST_HEIGHT  240
+#define TEST_PANEL   (TEST_WIDTH * TEST_HEIGHT)
+
+// In-memory panel the compositor pushes to
+static std::vector<uint16_t> g_panel;
+static ui_compositor_t g_compositor;
+static ui_screens_t g_screens;
+static ui_screen_model_t g_model;
+
+static void push_to_panel(const ui_rect_t* rect, const uint16_t* pixels, void* user_data) {
+    std::vector<uint16_t>* panel = (std::vector<uint16_t>*)user_data;
+    for (int16_t row = 0; row < rect->h; row++) {
+        memcpy(&(*panel)[(rect->y + row) * TEST_WIDTH + rect->x], pixels + row * rect->w, rect->w * sizeof(uint16_t));
+    }
+}
+
+// What a full repaint of the model would put on the panel
+static void assert_panel_matches_full_repaint(const ui_screen_model_t* model) {
+    std::vector<uint16_t> fresh(TEST_PANEL, 0xDEAD);
+    ui_compositor_t compositor;
+    ui_screens_t screens;
+    const ui_panel_t panel = {push_to_panel, NULL, &fresh};
+    TEST_ASSERT_TRUE(ui_compositor_init(&compositor, TEST_WIDTH, TEST_HEIGHT, UI_COMPOSITOR_BAND_ROWS,
+                                        UI_COLOR_BG, &panel));
+    ui_screens_init(&screens, &compositor);
+    TEST_ASSERT_EQUAL(TEST_PANEL, ui_screens_show(&screens, model));
+    ui_screens_deinit(&screens);
+    ui_compositor_deinit(&compositor);
+    TEST_ASSERT_TRUE(fresh == g_panel);
+}
+
+static uint32_t show(void) {
+    return ui_screens_show(&g_screens, &g_model);
+}
+
+static void report(const char* interaction, uint32_t pixels) {
+    printf("%-16s %6lu px  (%.2f%% of the panel)\n", interaction, (unsigned long)pixels, pixels * 100.0 / TEST_PANEL);
+}
+
+void setUp(void) {
+    g_panel.assign(TEST_PANEL, 0xDEAD);
+    const ui_panel_t panel = {push_to_panel, NULL, &g_panel};
+    TEST_ASSERT_TRUE(ui_compositor_init(&g_compositor, TEST_WIDTH, TEST_HEIGHT, UI_COMPOSITOR_BAND_ROWS,
+                                        UI_COLOR_BG, &panel));
+    ui_screens_init(&g_screens, &g_compositor);
+    memset(&g_model, 0, sizeof(g_model));
+}
+
+void tearDown(void) {
+    ui_screens_deinit(&g_screens);
+    ui_compositor_deinit(&g_compositor);
+}
+
+void test_first_show_and_screen_changes_repaint_everything(void) {
+    g_model.screen = UI_SCREEN_HOME;
+    TEST_ASSERT_EQUAL(TEST_PANEL, show());
+    TEST_ASSERT_EQUAL(0, show());                           // Nothing changed, nothing sent
+
+    g_model.screen = UI_SCREEN_MUSIC;
+    TEST_ASSERT_EQUAL(TEST_PANEL, show());
+    assert_panel_matches_full_repaint(&g_model);
+}
+
+void test_menu_step_pushes_two_rows(void) {
+    g_model.screen = UI_SCREEN_MUSIC;
+    show();
+
+    uint32_t worst = 0;
+    for (int sel = 1; sel < 4; sel++) {
+        g_model.selected = sel;
+        uint32_t pixels = show();
+        if (pixels > worst) worst = pixels;
+        assert_panel_matches_full_repaint(&g_model);
+    }
+    report("menu step", worst);
+    TEST_ASSERT_LESS_THAN(TEST_PANEL / 20, worst);         // Well under 5%
+    TEST_ASSERT_LESS_THAN(TEST_PANEL / 50, worst);
+}
+
+void test_volume_change_pushes_the_toast_only(void) {
+    g_model.screen = UI_SCREEN_NOW_PLAYING;
+    ui_screens_set_text(g_model.title, "Song");
+    show();
+
+    ui_screens_set_text(g_model.toast, "Vol: 50%");
+    show();
+    ui_screens_set_text(g_model.toast, "Vol: 52%");
+    uint32_t pixels = show();
+    report("volume change", pixels);
+    TEST_ASSERT_EQUAL(8 * UI_FONT_CELL_W * UI_FONT_CELL_H, pixels);
+    assert_panel_matches_full_repaint(&g_model);
+
+    // A shorter toast still clears the longer one's tail
+    ui_screens_set_text(g_model.toast, "Next track");
+    show();
+    ui_screens_set_text(g_model.toast, "Vol: 9%");
+    show();
+    assert_panel_matches_full_repaint(&g_model);
+}
+
+void test_progress_tick_pushes_time_and_bar_growth(void) {
+    g_model.screen = UI_SCREEN_NOW_PLAYING;
+    ui_screens_set_text(g_model.title, "Song");
+    ui_screens_set_text(g_model.artist, "Artist");
+    g_model.duration_s = 180;
+    g_model.elapsed_s = 61;
+    g_model.progress = 61.0f / 180.0f;
+    show();
+
+    // One second at 216 px for 180 s: the time and one column of the bar
+    g_model.elapsed_s = 62;
+    g_model.progress = 62.0f / 180.0f;
+    uint32_t pixels = show();
+    report("progress tick", pixels);
+    TEST_ASSERT_LESS_OR_EQUAL(5 * UI_FONT_CELL_W * UI_FONT_CELL_H + 2 * 8, pixels);
+    assert_panel_matches_full_repaint(&g_model);
+
+    // Back to the start of the track shrinks the fill
+    g_model.elapsed_s = 0;
+    g_model.progress = 0.0f;
+    show();
+    assert_panel_matches_full_repaint(&g_model);
+
+    // A new track repaints its title and artist lines
+    ui_screens_set_text(g_model.title, "A much longer song title");
+    ui_screens_set_text(g_model.artist, "X");
+    show();
+    assert_panel_matches_full_repaint(&g_model);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_first_show_and_screen_changes_repaint_everything);
+    RUN_TEST(test_menu_step_pushes_two_rows);
+    RUN_TEST(test_volume_change_pushes_the_toast_only);
+    RUN_TEST(test_progress_tick_pushes_time_and_bar_growth);
+
+    return UNITY_END();
+}
@@ -0,0 +1,286 @@
+/*
+ * UI Widget Tests
+ * Layout, incremental relayout, what a change repaints, and golden images of a headless tree
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "ui/ui_widget.h"
+
+#define TEST_WIDTH   320
+#define TEST_HEIGHT  240
+#define TEST_PANEL   (TEST_WIDTH * TEST_HEIGHT)
+#define TEST_BG      0x0000
+
+// In-memory panel the compositor pushes to
+static std::vector<uint16_t> g_panel;
+
+static void push_to_panel(const ui_rect_t* rect, const uint16_t* pixels, void* user_data) {
+    std::vector<uint16_t>* panel = (std::vector<uint16_t>*)user_data;
+    for (int16_t row = 0; row < rect->h; row++) {
+        memcpy(&(*panel)[(rect->y + row) * TEST_WIDTH + rect->x], pixels + row * rect->w, rect->w * sizeof(uint16_t));
+    }
+}
+
+// A scene with every widget type
+static const char* const k_items[] = {"Artists", "Albums", "Songs", "Podcasts"};
+static uint16_t g_cover[32 * 32];
+
+struct scene {
+    ui_widget_t root, status, body, list, side, cover, cover_label, progress, column, first, second, third;
+};
+
+static void build_scene(scene* s) {
+    ui_widget_box(&s->root, ui_rect_t{0, 0, TEST_WIDTH, TEST_HEIGHT}, UI_LAYOUT_COLUMN);
+    s->root.padding = 4;
+    s->root.spacing = 6;
+    ui_widget_status_bar(&s->status, ui_rect_t{0, 0, 0, 24}, 0xFFFF, 0x07E0);
+    ui_widget_set_text(&s->status, "Library");
+    ui_widget_set_info(&s->status, "87%");
+    ui_widget_box(&s->body, ui_rect_t{0, 0, 0, 150}, UI_LAYOUT_ROW);
+    s->body.spacing = 10;
+    ui_widget_list(&s->list, ui_rect_t{0, 0, 150, 0}, 20, 0xFFFF, 0xFBE0);
+    s->list.list.marker_w = 3;
+    s->list.list.marker_h = 12;
+    s->list.list.text_x = 6;
+    s->list.list.text_y = 2;
+    ui_widget_set_items(&s->list, k_items, 4);
+    ui_widget_set_selected(&s->list, 1);
+    ui_widget_box(&s->side, ui_rect_t{0, 0, 140, 0}, UI_LAYOUT_FIXED);
+    s->side.box.outlined = true;
+    s->side.box.color = 0x7BEF;
+    s->side.padding = 8;
+    ui_widget_image(&s->cover, ui_rect_t{0, 0, 0, 0}, g_cover, 32, 32, 0xFFFF);
+    s->cover.align = UI_ALIGN_CENTER;
+    ui_widget_label(&s->cover_label, ui_rect_t{2, 12, 0, 0}, "LP", 0xFFFF, 1);
+    ui_widget_progress(&s->progress, ui_rect_t{0, 0, 0, 10}, 0xFFFF, 0x07E0);
+    ui_widget_set_progress(&s->progress, 0.25f);
+    ui_widget_box(&s->column, ui_rect_t{0, 40, 0, 94}, UI_LAYOUT_COLUMN);    // Below the cover, not over it
+    s->column.spacing = 2;
+    ui_widget_label(&s->first, ui_rect_t{0, 0, 0, 0}, "first", 0xFFFF, 1);
+    ui_widget_label(&s->second, ui_rect_t{0, 0, 0, 0}, "second", 0xFFE0, 2);
+    ui_widget_label(&s->third, ui_rect_t{0, 0, 0, 0}, "third", 0xFFFF, 1);
+    s->third.align = UI_ALIGN_END;
+
+    ui_widget_add(&s->root, &s->status);
+    ui_widget_add(&s->root, &s->body);
+    ui_widget_add(&s->body, &s->list);
+    ui_widget_add(&s->body, &s->side);
+    ui_widget_add(&s->side, &s->cover);
+    ui_widget_add(&s->cover, &s->cover_label);
+    ui_widget_add(&s->side, &s->column);
+    ui_widget_add(&s->column, &s->first);
+    ui_widget_add(&s->column, &s->second);
+    ui_widget_add(&s->column, &s->third);
+    ui_widget_add(&s->root, &s->progress);
+}
+
+static ui_compositor_t g_compositor;
+static ui_text_cache_t g_cache;
+static ui_tree_t g_tree;
+static scene g_scene;
+
+// The same scene, shown once on a fresh panel
+static void assert_panel_matches_fresh_tree(void (*change)(scene* s)) {
+    std::vector<uint16_t> fresh(TEST_PANEL, 0xDEAD);
+    ui_compositor_t compositor;
+    ui_tree_t tree;
+    scene s;
+    const ui_panel_t panel = {push_to_panel, NULL, &fresh};
+    TEST_ASSERT_TRUE(ui_compositor_init(&compositor, TEST_WIDTH, TEST_HEIGHT, UI_COMPOSITOR_BAND_ROWS, TEST_BG,
+                                        &panel));
+    build_scene(&s);
+    if (change) change(&s);
+    ui_tree_init(&tree, &s.root, &compositor, NULL);
+    ui_compositor_invalidate_all(&compositor);
+    TEST_ASSERT_EQUAL(TEST_PANEL, ui_tree_update(&tree));
+    ui_compositor_deinit(&compositor);
+    TEST_ASSERT_TRUE(fresh == g_panel);
+}
+
+static uint32_t fnv1a(const std::vector<uint16_t>& pixels) {
+    uint32_t hash = 2166136261u;
+    for (uint16_t p : pixels) {
+        hash = (hash ^ (p & 0xFF)) * 16777619u;
+        hash = (hash ^ (p >> 8)) * 16777619u;
+    }
+    return hash;
+}
+
+// A mismatch leaves the frame as <name>.ppm to look at
+static void assert_golden(const char* name, uint32_t expected) {
+    uint32_t actual = fnv1a(g_panel);
+    if (actual != expected) {
+        char path[64];
+        snprintf(path, sizeof(path), "%s.ppm", name);
+        FILE* f = fopen(path, "wb");
+        if (f) {
+            fprintf(f, "P6\n%d %d\n255\n", TEST_WIDTH, TEST_HEIGHT);
+            for (uint16_t p : g_panel) {
+                const uint8_t rgb[3] = {(uint8_t)((p >> 8) & 0xF8), (uint8_t)((p >> 3) & 0xFC), (uint8_t)(p << 3)};
+                fwrite(rgb, 1, 3, f);
+            }
+            fclose(f);
+        }
+        printf("%s: frame hash %08lx, golden %08lx; wrote %s\n", name, (unsigned long)actual,
+               (unsigned long)expected, path);
+    }
+    TEST_ASSERT_EQUAL_UINT32(expected, actual);
+}
+
+void setUp(void) {
+    for (int i = 0; i < 32 * 32; i++) g_cover[i] = (uint16_t)(((i % 32) << 11) | ((i / 32) << 6) | 0x0010);
+    g_panel.assign(TEST_PANEL, 0xDEAD);
+    const ui_panel_t panel = {push_to_panel, NULL, &g_panel};
+    TEST_ASSERT_TRUE(ui_compositor_init(&g_compositor, TEST_WIDTH, TEST_HEIGHT, UI_COMPOSITOR_BAND_ROWS, TEST_BG,
+                                        &panel));
+    TEST_ASSERT_TRUE(ui_text_cache_init(&g_cache, UI_TEXT_CACHE_BYTES));
+    build_scene(&g_scene);
+    ui_tree_init(&g_tree, &g_scene.root, &g_compositor, &g_cache);
+    ui_compositor_invalidate_all(&g_compositor);
+}
+
+void tearDown(void) {
+    ui_text_cache_deinit(&g_cache);
+    ui_compositor_deinit(&g_compositor);
+}
+
+static bool rect_is(ui_rect_t r, int16_t x, int16_t y, int16_t w, int16_t h) {
+    return r.x == x && r.y == y && r.w == w && r.h == h;
+}
+
+void test_layout_places_columns_rows_and_alignment(void) {
+    TEST_ASSERT_EQUAL(TEST_PANEL, ui_tree_update(&g_tree));
+    scene* s = &g_scene;
+    TEST_ASSERT_TRUE(rect_is(s->status.bounds, 4, 4, 312, 24));            // Padding, then filled across
+    TEST_ASSERT_TRUE(rect_is(s->body.bounds, 4, 34, 312, 150));            // Spacing below the status bar
+    TEST_ASSERT_TRUE(rect_is(s->list.bounds, 4, 34, 150, 80));             // Four 20 px rows
+    TEST_ASSERT_TRUE(rect_is(s->side.bounds, 164, 34, 140, 150));          // Row spacing, height filled
+    TEST_ASSERT_TRUE(rect_is(s->cover.bounds, 218, 42, 32, 32));           // Centered in the padded side box
+    TEST_ASSERT_TRUE(rect_is(s->cover_label.bounds, 220, 54, 12, 8));
+    TEST_ASSERT_TRUE(rect_is(s->column.bounds, 172, 82, 124, 94));
+    TEST_ASSERT_TRUE(rect_is(s->first.bounds, 172, 82, 30, 8));
+    TEST_ASSERT_TRUE(rect_is(s->second.bounds, 172, 92, 72, 16));
+    TEST_ASSERT_TRUE(rect_is(s->third.bounds, 266, 110, 30, 8));            // Against the right edge
+    TEST_ASSERT_TRUE(rect_is(s->progress.bounds, 4, 190, 312, 10));
+}
+
+static void grow_second(scene* s) {
+    ui_widget_set_text(&s->second, "second, longer");
+}
+
+void test_text_change_lays_out_only_its_subtree(void) {
+    ui_tree_update(&g_tree);
+    ui_tree_reset_stats(&g_tree);
+
+    // Same size: nothing is placed again, only the text repaints
+    ui_widget_set_text(&g_scene.first, "fresh");
+    uint32_t pixels = ui_tree_update(&g_tree);
+    ui_tree_stats_t stats;
+    ui_tree_get_stats(&g_tree, &stats);
+    TEST_ASSERT_EQUAL(0, stats.layouts);
+    TEST_ASSERT_EQUAL(5 * UI_FONT_CELL_W * UI_FONT_CELL_H, pixels);
+
+    // Wider: the column places its three labels again and nothing else
+    ui_tree_reset_stats(&g_tree);
+    grow_second(&g_scene);
+    ui_tree_update(&g_tree);
+    ui_tree_get_stats(&g_tree, &stats);
+    TEST_ASSERT_EQUAL(3, stats.layouts);
+    TEST_ASSERT_EQUAL(1, stats.moved);
+    TEST_ASSERT_TRUE(rect_is(g_scene.third.bounds, 266, 110, 30, 8));
+    assert_panel_matches_fresh_tree([](scene* s) {
+        ui_widget_set_text(&s->first, "fresh");
+        grow_second(s);
+    });
+
+    // Taller: the labels after it move down
+    ui_tree_reset_stats(&g_tree);
+    g_scene.second.label.size = 3;
+    ui_widget_set_frame(&g_scene.second, ui_rect_t{0, 0, 0, 0});
+    ui_widget_set_text(&g_scene.second, "tall");
+    ui_tree_update(&g_tree);
+    ui_tree_get_stats(&g_tree, &stats);
+    TEST_ASSERT_EQUAL(3, stats.layouts);
+    TEST_ASSERT_EQUAL(2, stats.moved);
+    TEST_ASSERT_TRUE(rect_is(g_scene.third.bounds, 266, 118, 30, 8));
+}
+
+void test_hidden_widgets_leave_and_come_back(void) {
+    ui_tree_update(&g_tree);
+    ui_widget_set_visible(&g_scene.side, false);
+    ui_tree_update(&g_tree);
+    TEST_ASSERT_TRUE(ui_rect_is_empty(g_scene.cover_label.bounds));
+    assert_panel_matches_fresh_tree([](scene* s) { ui_widget_set_visible(&s->side, false); });
+
+    ui_widget_set_visible(&g_scene.side, true);
+    ui_tree_update(&g_tree);
+    TEST_ASSERT_TRUE(rect_is(g_scene.cover_label.bounds, 220, 54, 12, 8));
+    assert_panel_matches_fresh_tree(NULL);
+}
+
+void test_only_invalidated_widgets_repaint(void) {
+    ui_tree_update(&g_tree);
+    ui_tree_stats_t stats;
+    ui_tree_get_stats(&g_tree, &stats);
+    const uint32_t full_paints = stats.last_paints;
+
+    // A selection step: the two rows, painted by the list alone
+    ui_widget_set_selected(&g_scene.list, 2);
+    uint32_t pixels = ui_tree_update(&g_tree);
+    ui_tree_get_stats(&g_tree, &stats);
+    ui_rect_t rows = ui_rect_union(ui_widget_list_row_bounds(&g_scene.list, 1),
+                                   ui_widget_list_row_bounds(&g_scene.list, 2));
+    printf("selection step   %6lu px, %lu of %lu widget paints\n", (unsigned long)pixels,
+           (unsigned long)stats.last_paints, (unsigned long)full_paints);
+    TEST_ASSERT_TRUE(pixels <= ui_rect_area(rows));
+    // The list and the two boxes it sits in, once per band the rows cross
+    const int bands = (rows.y + rows.h - 1) / UI_COMPOSITOR_BAND_ROWS - rows.y / UI_COMPOSITOR_BAND_ROWS + 1;
+    TEST_ASSERT_LESS_OR_EQUAL(3 * bands, stats.last_paints);
+
+    // A progress tick: one column of the fill
+    ui_widget_set_progress(&g_scene.progress, 0.254f);
+    pixels = ui_tree_update(&g_tree);
+    ui_tree_get_stats(&g_tree, &stats);
+    TEST_ASSERT_EQUAL(1 * 6, pixels);
+    TEST_ASSERT_LESS_OR_EQUAL(2, stats.last_paints);
+
+    // Nothing changed, nothing painted
+    TEST_ASSERT_EQUAL(0, ui_tree_update(&g_tree));
+    assert_panel_matches_fresh_tree([](scene* s) {
+        ui_widget_set_selected(&s->list, 2);
+        ui_widget_set_progress(&s->progress, 0.254f);
+    });
+}
+
+void test_headless_frames_match_golden_images(void) {
+    ui_tree_update(&g_tree);
+    assert_golden("widget_scene", 0x08b8224du);
+
+    ui_widget_set_info(&g_scene.status, "12%");
+    ui_widget_set_selected(&g_scene.list, 3);
+    ui_widget_set_progress(&g_scene.progress, 0.8f);
+    ui_widget_set_pixels(&g_scene.cover, NULL);
+    ui_tree_update(&g_tree);
+    assert_golden("widget_scene_changed", 0x43782869u);
+    assert_panel_matches_fresh_tree([](scene* s) {
+        ui_widget_set_info(&s->status, "12%");
+        ui_widget_set_selected(&s->list, 3);
+        ui_widget_set_progress(&s->progress, 0.8f);
+        ui_widget_set_pixels(&s->cover, NULL);
+    });
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_layout_places_columns_rows_and_alignment);
+    RUN_TEST(test_text_change_lays_out_only_its_subtree);
+    RUN_TEST(test_hidden_widgets_leave_and_come_back);
+    RUN_TEST(test_only_invalidated_widgets_repaint);
+    RUN_TEST(test_headless_frames_match_golden_images);
+
+    return UNITY_END();
+}
@@ -0,0 +1,111 @@
+/*
+ * WAV Test Writer
+ * RIFF/WAVE fixtures for the audio tests and benchmarks
+ *
+ * Builds the file bytes around caller-supplied sample data: plain PCM or
+ * float fmt chunks, WAVE_FORMAT_EXTENSIBLE with the format tag in its
+ * sub-format GUID, and an optional LIST chunk before the data, as taggers
+ * write them. Sample data is never checked against the format, so tests can
+ * build files the decoder must reject.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "hal/hal_storage.h"
+
+struct wav_test_format_t {
+    uint16_t format_tag = 1;            // 1 PCM, 3 IEEE float
+    uint16_t channels = 2;
+    uint16_t bits = 16;
+    uint32_t rate = 44100;
+    bool extensible = false;            // fmt as WAVE_FORMAT_EXTENSIBLE carrying format_tag
+    uint32_t speaker_mask = 0;          // Extensible only
+    uint32_t list_bytes = 0;            // LIST chunk before the data, "INFO" then zeros; 0 for none
+};
+
+static inline void wav_test_le16(std::vector<uint8_t>& v, uint16_t x) {
+    v.push_back(x & 0xFF);
+    v.push_back(x >> 8);
+}
+
+static inline void wav_test_le32(std::vector<uint8_t>& v, uint32_t x) {
+    for (int i = 0; i < 4; i++) v.push_back((x >> (8 * i)) & 0xFF);
+}
+
+// Every byte before the samples, for a data chunk of data_bytes
+static inline std::vector<uint8_t> wav_test_header(const wav_test_format_t& format, uint32_t data_bytes) {
+    std::vector<uint8_t> v;
+    uint16_t block_align = (uint16_t)(format.channels * format.bits / 8);
+    uint32_t fmt_len = format.extensible ? 40 : 16;
+    uint32_t list_len = format.list_bytes ? 8 + format.list_bytes : 0;
+    v.insert(v.end(), {'R', 'I', 'F', 'F'});
+    wav_test_le32(v, 4 + 8 + fmt_len + list_len + 8 + data_bytes);
+    v.insert(v.end(), {'W', 'A', 'V', 'E'});
+    v.insert(v.end(), {'f', 'm', 't', ' '});
+    wav_test_le32(v, fmt_len);
+    wav_test_le16(v, format.extensible ? 0xFFFE : format.format_tag);
+    wav_test_le16(v, format.channels);
+    wav_test_le32(v, format.rate);
+    wav_test_le32(v, format.rate * block_align);
+    wav_test_le16(v, block_align);
+    wav_test_le16(v, format.bits);
+    if (format.extensible) {
+        wav_test_le16(v, 22);
+        wav_test_le16(v, format.bits);
+        wav_test_le32(v, format.speaker_mask);
+        wav_test_le16(v, format.format_tag);
+        v.insert(v.end(), {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00,
+                           0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71});
+    }
+    if (format.list_bytes) {
+        v.insert(v.end(), {'L', 'I', 'S', 'T'});
+        wav_test_le32(v, format.list_bytes);
+        size_t start = v.size();
+        v.resize(start + format.list_bytes, 0);
+        const char info[4] = {'I', 'N', 'F', 'O'};
+        for (uint32_t i = 0; i < 4 && i < format.list_bytes; i++) v[start + i] = (uint8_t)info[i];
+    }
+    v.insert(v.end(), {'d', 'a', 't', 'a'});
+    wav_test_le32(v, data_bytes);
+    return v;
+}
+
+// A whole file around raw sample bytes
+static inline std::vector<uint8_t> wav_test_file(const wav_test_format_t& format, const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> v = wav_test_header(format, (uint32_t)data.size());
+    v.insert(v.end(), data.begin(), data.end());
+    return v;
+}
+
+// A whole 16-bit file around interleaved samples
+static inline std::vector<uint8_t> wav_test_pcm16(const wav_test_format_t& format, const int16_t* samples,
+                                                  size_t count) {
+    std::vector<uint8_t> v = wav_test_header(format, (uint32_t)(count * 2));
+    for (size_t i = 0; i < count; i++) wav_test_le16(v, (uint16_t)samples[i]);
+    return v;
+}
+
+// Left channel a ramp (first + step * frame index, wrapping at 16 bits), right its negation
+static inline std::vector<int16_t> wav_test_ramp(uint16_t channels, uint32_t frames, int16_t first = 0,
+                                                 int32_t step = 1) {
+    std::vector<int16_t> pcm;
+    pcm.reserve((size_t)frames * channels);
+    for (uint32_t i = 0; i < frames; i++) {
+        int32_t x = first + step * (int32_t)i;
+        pcm.push_back((int16_t)x);
+        if (channels == 2) pcm.push_back((int16_t)-x);
+    }
+    return pcm;
+}
+
+// Writes the bytes to a card path; false when the file could not be written whole
+static inline bool wav_test_save(const char* card_path, const std::vector<uint8_t>& bytes) {
+    hal_storage_file_t f = hal_storage_open(card_path, HAL_STORAGE_MODE_WRITE);
+    if (!f) return false;
+    bool ok = hal_storage_write(f, bytes.data(), bytes.size()) == bytes.size();
+    hal_storage_close(f);
+    return ok;
+}
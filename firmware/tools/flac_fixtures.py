@@ -0,0 +1,315 @@
+#!/usr/bin/env python3
+"""
+Izod Mini FLAC Fixture Builder
+Encodes the FLAC decoder's reference fixtures with real encoders
+
+Every fixture is one short generated signal run through libFLAC (through
+libsndfile, at its -0 and -8 presets) or FFmpeg's FLAC encoder (for what
+the libFLAC presets never write: LPC order 32 and a forced fixed order 4).
+Each file is decoded again by libFLAC and must give back the signal
+exactly; the checksum of that decode, as the firmware decoder hands it out
+(16-bit stereo, mono duplicated), goes into the generated header with a note
+of what the file's frames and subframes actually use.
+
+Needs the soundfile module and an ffmpeg binary. Example (the checked-in
+fixtures):
+
+    tools/flac_fixtures.py --ffmpeg ffmpeg \\
+        -o test/test_audio_decoder_flac/fixtures \\
+        --header test/test_audio_decoder_flac/flac_fixtures.h
+"""
+
+import argparse
+import math
+import os
+import subprocess
+import sys
+import tempfile
+import textwrap
+
+import numpy
+import soundfile
+
+# name, encoder, rate, channels, bits, frames, options, what it is for
+FIXTURES = [
+    ("libflac_8", "libflac", 44100, 2, 16, 9000, {"level": 8},
+     "flac -8: LPC up to order 12, adaptive stereo"),
+    ("libflac_0", "libflac", 44100, 2, 16, 5000, {"level": 0, "silent_block": 0},
+     "flac -0: fixed predictors only, after a frame of digital silence"),
+    ("libflac_24", "libflac", 48000, 2, 24, 9000, {"level": 8, "loud_block": 0, "wasted_block": 1},
+     "24-bit; a loud first frame needs 5-bit Rice parameters, the second carries 16-bit audio"),
+    ("libflac_8bit_mono", "libflac", 22050, 1, 8, 5000, {"level": 5},
+     "8-bit mono"),
+    ("ffmpeg_lpc32", "ffmpeg", 44100, 2, 16, 9000,
+     {"args": ["-lpc_type", "cholesky", "-min_prediction_order", "32", "-max_prediction_order", "32",
+               "-exact_rice_parameters", "1", "-ch_mode", "left_side", "-frame_size", "4096",
+               "-strict", "experimental"]},
+     "--lax: LPC order 32 (outside the subset), left/side"),
+    ("ffmpeg_fixed4", "ffmpeg", 44100, 2, 16, 5000,
+     {"args": ["-lpc_type", "fixed", "-min_prediction_order", "4", "-max_prediction_order", "4",
+               "-ch_mode", "right_side", "-frame_size", "1152"]},
+     "fixed order 4, right/side"),
+]
+BLOCK = 4096            # libFLAC's block size from -3 up; -0 to -2 use 1152
+
+
+def make_signal(rate, channels, bits, frames, options):
+    """Tones with a little deterministic noise, at about a quarter of full scale;
+    the right channel follows the left closely, as in most music"""
+    scale = (1 << (bits - 1)) * 0.22
+    seed = 2024
+    out = numpy.zeros((frames, channels), dtype=numpy.int64)
+    for i in range(frames):
+        t = i / rate
+        loud = i // BLOCK == options.get("loud_block")
+        noise_bits = bits - 6 if loud else max(bits - 13, 1)
+        x = math.sin(2 * math.pi * 220 * t) + 0.5 * math.sin(2 * math.pi * 1375 * t)
+        for c in range(channels):
+            seed = (seed * 1664525 + 1013904223) & 0xFFFFFFFF
+            noise = ((seed >> 8) & ((1 << noise_bits) - 1)) - (1 << (noise_bits - 1))
+            y = x if c == 0 else 0.9 * x + 0.1 * math.sin(2 * math.pi * 330 * t)
+            out[i, c] = int(round(y * scale)) + noise
+    block = options.get("silent_block")
+    if block is not None:
+        out[block * 1152:(block + 1) * 1152] = 0
+    block = options.get("wasted_block")
+    if block is not None:
+        # 16-bit audio in one frame, as a padded 16-bit master would be
+        out[block * BLOCK:(block + 1) * BLOCK] = (out[block * BLOCK:(block + 1) * BLOCK] >> 8) << 8
+    return out
+
+
+def encode_libflac(path, signal, rate, bits, options):
+    subtype = {8: "PCM_S8", 16: "PCM_16", 24: "PCM_24"}[bits]
+    with soundfile.SoundFile(path, "w", rate, signal.shape[1], subtype, format="FLAC",
+                             compression_level=options["level"] / 8.0) as f:
+        # libsndfile scales int32 input down to the file's width
+        f.write((signal << (32 - bits)).astype(numpy.int32))
+
+
+def encode_ffmpeg(path, signal, rate, bits, options, ffmpeg):
+    with tempfile.NamedTemporaryFile(suffix=".raw") as raw:
+        raw.write(signal.astype("<i2").tobytes())
+        raw.flush()
+        subprocess.run([ffmpeg, "-hide_banner", "-loglevel", "error", "-y", "-f", "s16le", "-ar", str(rate),
+                        "-ac", str(signal.shape[1]), "-i", raw.name, "-c:a", "flac"] + options["args"] + [path],
+                       check=True)
+
+
+def fnv1a(samples):
+    h = 0x811C9DC5
+    for b in samples.astype("<i2").tobytes():
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+class Bits:
+    def __init__(self, data, pos):
+        self.data = data
+        self.bit = pos * 8
+
+    def read(self, n):
+        v = 0
+        for _ in range(n):
+            v = (v << 1) | ((self.data[self.bit >> 3] >> (7 - (self.bit & 7))) & 1)
+            self.bit += 1
+        return v
+
+    def unary(self):
+        q = 0
+        while self.read(1) == 0:
+            q += 1
+        return q
+
+
+def crc8(data):
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def survey(path):
+    """What the frames and subframes of a file use, parsed from the bitstream"""
+    with open(path, "rb") as f:
+        data = f.read()
+    pos = 4
+    while True:
+        last, length = data[pos] & 0x80, int.from_bytes(data[pos + 1:pos + 4], "big")
+        if data[pos] & 0x7F == 0:
+            stream_bits = ((data[pos + 4 + 12] & 1) << 4 | data[pos + 4 + 13] >> 4) + 1
+        pos += 4 + length
+        if last:
+            break
+
+    found = {"frames": 0, "variable": False, "block_sizes": set(), "kinds": set(), "wasted": 0,
+             "rice2": False, "escaped": 0, "modes": set()}
+    while pos < len(data):
+        b = Bits(data, pos)
+        assert b.read(15) == 0x7FFC, "lost sync at %d" % pos
+        variable = b.read(1)
+        bs_code, rate_code, mode, size_code = b.read(4), b.read(4), b.read(4), b.read(3)
+        b.read(1)
+        first = b.read(8)
+        extra = 0
+        while first & (0x80 >> extra):
+            extra += 1
+        for _ in range(max(extra - 1, 0)):
+            b.read(8)
+        if bs_code == 1:
+            block = 192
+        elif bs_code <= 5:
+            block = 576 << (bs_code - 2)
+        elif bs_code == 6:
+            block = b.read(8) + 1
+        elif bs_code == 7:
+            block = b.read(16) + 1
+        else:
+            block = 256 << (bs_code - 8)
+        b.read({12: 8, 13: 16, 14: 16}.get(rate_code, 0))
+        header_end = b.bit // 8
+        assert crc8(data[pos:header_end]) == b.read(8)
+        bits = {0: stream_bits, 1: 8, 2: 12, 4: 16, 5: 20, 6: 24, 7: 32}[size_code]
+
+        found["frames"] += 1
+        found["variable"] |= bool(variable)
+        found["block_sizes"].add(block)
+        found["modes"].add(mode)
+        channels = mode + 1 if mode < 8 else 2
+        for ch in range(channels):
+            side = (mode == 8 and ch == 1) or (mode == 9 and ch == 0) or (mode == 10 and ch == 1)
+            sub_bits = bits + side
+            b.read(1)
+            kind = b.read(6)
+            if b.read(1):
+                wasted = b.unary() + 1
+                sub_bits -= wasted
+                found["wasted"] = max(found["wasted"], wasted)
+            if kind == 0:
+                found["kinds"].add("constant")
+                b.read(sub_bits)
+                continue
+            if kind == 1:
+                found["kinds"].add("verbatim")
+                b.read(sub_bits * block)
+                continue
+            if 8 <= kind <= 12:
+                order = kind - 8
+                found["kinds"].add("fixed %d" % order)
+                b.read(sub_bits * order)
+            else:
+                order = kind - 31
+                found["kinds"].add("lpc %d" % order)
+                b.read(sub_bits * order)
+                precision = b.read(4) + 1
+                b.read(5)
+                b.read(precision * order)
+            method = b.read(2)
+            found["rice2"] |= method == 1
+            param_bits, escape = (4, 15) if method == 0 else (5, 31)
+            partition_order = b.read(4)
+            for p in range(1 << partition_order):
+                n = (block >> partition_order) - (order if p == 0 else 0)
+                param = b.read(param_bits)
+                if param == escape:
+                    found["escaped"] += 1
+                    b.read(b.read(5) * n)
+                else:
+                    for _ in range(n):
+                        b.unary()
+                        b.read(param)
+        b.bit = (b.bit + 7) & ~7
+        b.read(16)
+        pos = b.bit // 8
+    return found
+
+
+def describe(found):
+    def order_key(kind):
+        name, _, order = kind.partition(" ")
+        return (name, int(order) if order else 0)
+
+    kinds = sorted(found["kinds"], key=order_key)
+    modes = {8: "left/side", 9: "right/side", 10: "mid/side"}
+    notes = ["%d %s frames of %s" % (found["frames"], "variable" if found["variable"] else "fixed",
+                                     "/".join(str(s) for s in sorted(found["block_sizes"])))]
+    notes.append(", ".join(kinds))
+    stereo = [modes[m] for m in sorted(found["modes"]) if m in modes]
+    if stereo:
+        notes.append(", ".join(stereo))
+    if found["wasted"]:
+        notes.append("up to %d wasted bits" % found["wasted"])
+    if found["rice2"]:
+        notes.append("5-bit Rice parameters")
+    if found["escaped"]:
+        notes.append("%d escaped partitions" % found["escaped"])
+    return "; ".join(notes)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--ffmpeg", default="ffmpeg", help="ffmpeg binary")
+    parser.add_argument("-o", "--output", required=True, help="Directory for the .flac files")
+    parser.add_argument("--header", required=True, help="Generated C++ header")
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    encoders = {"libflac": "libFLAC in libsndfile %s" % soundfile.__libsndfile_version__,
+                "ffmpeg": subprocess.run([args.ffmpeg, "-version"], capture_output=True, text=True,
+                                         check=True).stdout.split()[2]}
+    rows = []
+    for name, encoder, rate, channels, bits, frames, options, purpose in FIXTURES:
+        path = os.path.join(args.output, name + ".flac")
+        signal = make_signal(rate, channels, bits, frames, options)
+        if encoder == "libflac":
+            encode_libflac(path, signal, rate, bits, options)
+        else:
+            encode_ffmpeg(path, signal, rate, bits, options, args.ffmpeg)
+
+        # The reference decode must give the signal back exactly
+        decoded, decoded_rate = soundfile.read(path, dtype="int32", always_2d=True)
+        assert decoded_rate == rate and decoded.shape == signal.shape, name
+        assert numpy.array_equal(decoded.astype(numpy.int64) >> (32 - bits), signal), name + " is not lossless"
+
+        # As the firmware decoder hands it out: the top 16 bits, mono duplicated
+        pcm = decoded >> 16
+        if channels == 1:
+            pcm = numpy.repeat(pcm, 2, axis=1)
+        found = survey(path)
+        rows.append((name, rate, channels, bits, frames, fnv1a(pcm.reshape(-1)), "%s, %s" % (encoder, purpose),
+                     describe(found)))
+        print("%-18s %6d bytes  %s" % (name, os.path.getsize(path), describe(found)))
+
+    with open(args.header, "w") as f:
+        f.write("/*\n")
+        f.write(" * FLAC Reference Fixtures\n")
+        f.write(" * Generated by tools/flac_fixtures.py; do not edit\n")
+        f.write(" *\n")
+        about = ("Files in fixtures/, encoded by %s and FFmpeg %s. Checksums are FNV-1a over the "
+                 "libFLAC decode, as 16-bit little-endian stereo samples." % (encoders["libflac"], encoders["ffmpeg"]))
+        for line in textwrap.wrap(about, 74):
+            f.write(" * %s\n" % line)
+        f.write(" */\n\n")
+        f.write("#pragma once\n\n")
+        f.write("#include <stdint.h>\n\n")
+        f.write("struct flac_fixture_t {\n")
+        f.write("    const char* file;\n")
+        f.write("    uint32_t sample_rate;\n")
+        f.write("    uint32_t channels;\n")
+        f.write("    uint32_t bits;\n")
+        f.write("    uint32_t frames;\n")
+        f.write("    uint32_t checksum;\n")
+        f.write("};\n\n")
+        f.write("static const flac_fixture_t k_flac_fixtures[] = {\n")
+        for name, rate, channels, bits, frames, checksum, purpose, notes in rows:
+            f.write("    // %s\n" % purpose)
+            f.write("    // %s\n" % notes)
+            f.write("    {\"%s.flac\", %d, %d, %d, %d, 0x%08X},\n" % (name, rate, channels, bits, frames, checksum))
+        f.write("};\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
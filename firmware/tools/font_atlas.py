@@ -0,0 +1,408 @@
+#!/usr/bin/env python3
+"""
+Izod Mini Font Atlas Builder
+Rasterizes a TrueType font into a packed alpha glyph atlas for ui/ui_font.h
+
+Glyphs are rendered with exact horizontal coverage over 16 sub-scanlines
+per pixel, trimmed to their ink, and packed at 1, 2 or 4 bits per pixel,
+each row starting on a byte. With --cell, every glyph is placed in a fixed
+cell (advance and line height) with the baseline at --baseline, and clipped
+to it, so the font can stand in for the classic font at a text size.
+
+No dependencies beyond the standard library, so it runs wherever the
+firmware builds. Example (the checked-in fonts):
+
+    tools/font_atlas.py /usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf \\
+        --name mono_16 --size 16 --cell 12x16 --baseline 12 --bpp 4 \\
+        --license src/ui/fonts/LICENSE-DejaVu.txt -o src/ui/fonts/ui_font_mono_16.cpp
+
+The font's copyright notice goes into every generated file, and --license
+writes the license text the font carries, which must ship alongside.
+"""
+
+import argparse
+import math
+import os
+import struct
+import sys
+import textwrap
+
+SUBSAMPLES = 16         # Sub-scanlines per pixel row
+CURVE_STEPS = 8         # Line segments per quadratic curve
+
+
+class TrueTypeFont:
+    """The tables needed to outline glyphs: cmap, hmtx and glyf"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        num_tables = struct.unpack_from(">H", self.data, 4)[0]
+        self.tables = {}
+        for i in range(num_tables):
+            tag, _, offset, length = struct.unpack_from(">4sIII", self.data, 12 + 16 * i)
+            self.tables[tag.decode("latin-1")] = (offset, length)
+
+        head = self.tables["head"][0]
+        self.units_per_em = struct.unpack_from(">H", self.data, head + 18)[0]
+        self.long_loca = struct.unpack_from(">h", self.data, head + 50)[0] == 1
+        hhea = self.tables["hhea"][0]
+        self.ascender, self.descender = struct.unpack_from(">hh", self.data, hhea + 4)
+        self.num_hmetrics = struct.unpack_from(">H", self.data, hhea + 34)[0]
+        self.num_glyphs = struct.unpack_from(">H", self.data, self.tables["maxp"][0] + 4)[0]
+        self.cmap = self._read_cmap()
+
+    def name(self, name_id):
+        """A string from the name table (0 copyright, 4 full name, 13 license), or None"""
+        if "name" not in self.tables:
+            return None
+        base = self.tables["name"][0]
+        count, strings = struct.unpack_from(">HH", self.data, base + 2)
+        found = None
+        for i in range(count):
+            platform, encoding, _, nid, length, offset = struct.unpack_from(">HHHHHH", self.data, base + 6 + 12 * i)
+            if nid != name_id:
+                continue
+            raw = self.data[base + strings + offset:base + strings + offset + length]
+            if platform == 3 or platform == 0:
+                return raw.decode("utf-16-be")
+            if platform == 1 and found is None:
+                found = raw.decode("latin-1")
+        return found
+
+    def _read_cmap(self):
+        base = self.tables["cmap"][0]
+        count = struct.unpack_from(">H", self.data, base + 2)[0]
+        for i in range(count):
+            platform, encoding, offset = struct.unpack_from(">HHI", self.data, base + 4 + 8 * i)
+            if (platform, encoding) in ((3, 1), (0, 3), (0, 4)):
+                sub = base + offset
+                if struct.unpack_from(">H", self.data, sub)[0] == 4:
+                    return self._read_cmap4(sub)
+        raise ValueError("no Unicode BMP cmap (format 4)")
+
+    def _read_cmap4(self, sub):
+        segs = struct.unpack_from(">H", self.data, sub + 6)[0] // 2
+        ends = struct.unpack_from(">%dH" % segs, self.data, sub + 14)
+        starts = struct.unpack_from(">%dH" % segs, self.data, sub + 16 + 2 * segs)
+        deltas = struct.unpack_from(">%dh" % segs, self.data, sub + 16 + 4 * segs)
+        range_base = sub + 16 + 6 * segs
+        ranges = struct.unpack_from(">%dH" % segs, self.data, range_base)
+        cmap = {}
+        for s in range(segs):
+            for code in range(starts[s], min(ends[s], 0x7E) + 1):
+                if ranges[s] == 0:
+                    glyph = (code + deltas[s]) & 0xFFFF
+                else:
+                    at = range_base + 2 * s + ranges[s] + 2 * (code - starts[s])
+                    glyph = struct.unpack_from(">H", self.data, at)[0]
+                    if glyph:
+                        glyph = (glyph + deltas[s]) & 0xFFFF
+                cmap[code] = glyph
+        return cmap
+
+    def advance(self, glyph):
+        hmtx = self.tables["hmtx"][0]
+        index = min(glyph, self.num_hmetrics - 1)
+        return struct.unpack_from(">H", self.data, hmtx + 4 * index)[0]
+
+    def _glyph_range(self, glyph):
+        loca = self.tables["loca"][0]
+        if self.long_loca:
+            start, end = struct.unpack_from(">II", self.data, loca + 4 * glyph)
+        else:
+            start, end = (2 * v for v in struct.unpack_from(">HH", self.data, loca + 2 * glyph))
+        return self.tables["glyf"][0] + start, end - start
+
+    def contours(self, glyph, depth=0):
+        """Closed outlines in font units, each a list of (x, y, on_curve)"""
+        offset, length = self._glyph_range(glyph)
+        if length == 0:
+            return []
+        num_contours = struct.unpack_from(">h", self.data, offset)[0]
+        if num_contours >= 0:
+            return self._simple_contours(offset, num_contours)
+        if depth > 8:
+            raise ValueError("composite glyphs nested too deep")
+        return self._composite_contours(offset, depth)
+
+    def _simple_contours(self, offset, num_contours):
+        p = offset + 10
+        ends = struct.unpack_from(">%dH" % num_contours, self.data, p)
+        p += 2 * num_contours
+        p += 2 + struct.unpack_from(">H", self.data, p)[0]      # Skip the instructions
+        num_points = ends[-1] + 1 if ends else 0
+
+        flags = []
+        while len(flags) < num_points:
+            flag = self.data[p]
+            p += 1
+            flags.append(flag)
+            if flag & 8:
+                flags.extend([flag] * self.data[p])
+                p += 1
+
+        def coords(short_bit, same_bit):
+            nonlocal p
+            values, value = [], 0
+            for flag in flags:
+                if flag & short_bit:
+                    delta = self.data[p]
+                    p += 1
+                    value += delta if flag & same_bit else -delta
+                elif not flag & same_bit:
+                    value += struct.unpack_from(">h", self.data, p)[0]
+                    p += 2
+                values.append(value)
+            return values
+
+        xs = coords(2, 16)
+        ys = coords(4, 32)
+        contours, first = [], 0
+        for end in ends:
+            contours.append([(xs[i], ys[i], bool(flags[i] & 1)) for i in range(first, end + 1)])
+            first = end + 1
+        return contours
+
+    def _composite_contours(self, offset, depth):
+        p = offset + 10
+        contours = []
+        while True:
+            flags, glyph = struct.unpack_from(">HH", self.data, p)
+            p += 4
+            if flags & 1:
+                dx, dy = struct.unpack_from(">hh", self.data, p)
+                p += 4
+            else:
+                dx, dy = struct.unpack_from(">bb", self.data, p)
+                p += 2
+            if not flags & 2:
+                dx = dy = 0                 # Point matching: not used by Latin fonts
+            a, b, c, d = 1.0, 0.0, 0.0, 1.0
+            if flags & 8:
+                a = d = struct.unpack_from(">h", self.data, p)[0] / 16384.0
+                p += 2
+            elif flags & 0x40:
+                a, d = (v / 16384.0 for v in struct.unpack_from(">hh", self.data, p))
+                p += 4
+            elif flags & 0x80:
+                a, b, c, d = (v / 16384.0 for v in struct.unpack_from(">hhhh", self.data, p))
+                p += 8
+            for contour in self.contours(glyph, depth + 1):
+                contours.append([(a * x + c * y + dx, b * x + d * y + dy, on) for x, y, on in contour])
+            if not flags & 0x20:
+                return contours
+
+
+def flatten(contour, scale, origin_x, baseline):
+    """Outline in pixels (y down) as a closed polyline"""
+    points = [(origin_x + x * scale, baseline - y * scale, on) for x, y, on in contour]
+    # Two off-curve points in a row imply an on-curve point between them
+    expanded = []
+    for i, point in enumerate(points):
+        prev = points[i - 1]
+        if not point[2] and not prev[2]:
+            expanded.append(((prev[0] + point[0]) / 2, (prev[1] + point[1]) / 2, True))
+        expanded.append(point)
+    start = next((i for i, pt in enumerate(expanded) if pt[2]), None)
+    if start is None:
+        return []
+    expanded = expanded[start:] + expanded[:start]
+
+    line = [expanded[0][:2]]
+    i = 1
+    while i <= len(expanded):
+        point = expanded[i % len(expanded)]
+        if point[2]:
+            line.append(point[:2])
+            i += 1
+            continue
+        p0 = line[-1]
+        p2 = expanded[(i + 1) % len(expanded)][:2]
+        for step in range(1, CURVE_STEPS + 1):
+            t = step / CURVE_STEPS
+            u = 1 - t
+            line.append((u * u * p0[0] + 2 * u * t * point[0] + t * t * p2[0],
+                         u * u * p0[1] + 2 * u * t * point[1] + t * t * p2[1]))
+        i += 2
+    return line
+
+
+def rasterize(lines, width, height):
+    """Nonzero-winding coverage, 0.0-1.0, of width x height pixels"""
+    coverage = [[0.0] * width for _ in range(height)]
+    edges = []
+    for line in lines:
+        for (x0, y0), (x1, y1) in zip(line, line[1:] + line[:1]):
+            if y0 != y1:
+                edges.append((x0, y0, x1, y1))
+
+    for row in range(height):
+        cells = coverage[row]
+        for sub in range(SUBSAMPLES):
+            y = row + (sub + 0.5) / SUBSAMPLES
+            crossings = []
+            for x0, y0, x1, y1 in edges:
+                if (y0 <= y < y1) or (y1 <= y < y0):
+                    x = x0 + (y - y0) * (x1 - x0) / (y1 - y0)
+                    crossings.append((x, 1 if y1 > y0 else -1))
+            crossings.sort()
+            winding = 0
+            for (x, direction), nxt in zip(crossings, crossings[1:] + [None]):
+                winding += direction
+                if winding == 0 or nxt is None:
+                    continue
+                add_span(cells, x, nxt[0], width)
+        for col in range(width):
+            cells[col] = min(1.0, cells[col] / SUBSAMPLES)
+    return coverage
+
+
+def add_span(cells, left, right, width):
+    """Adds exact horizontal coverage of [left, right) on one sub-scanline"""
+    left = max(left, 0.0)
+    right = min(right, float(width))
+    if right <= left:
+        return
+    first, last = int(math.floor(left)), int(math.floor(right))
+    if first == last:
+        cells[first] += right - left
+        return
+    cells[first] += first + 1 - left
+    for col in range(first + 1, min(last, width)):
+        cells[col] += 1.0
+    if last < width:
+        cells[last] += right - last
+
+
+def build_glyph(font, code, args, scale):
+    glyph = font.cmap.get(code, 0)
+    natural = font.advance(glyph) * scale
+    advance = args.cell_w if args.cell_w else int(round(natural))
+    origin = (advance - natural) / 2 if args.cell_w else 0.0
+    lines = [flatten(c, scale, origin, args.baseline) for c in font.contours(glyph)]
+    lines = [line for line in lines if len(line) > 2]
+
+    box_w, box_h = advance, args.cell_h
+    levels = (1 << args.bpp) - 1
+    coverage = rasterize(lines, box_w, box_h) if lines else [[0.0] * box_w for _ in range(box_h)]
+    alpha = [[int(round(v * levels)) for v in row] for row in coverage]
+
+    # Trim to the ink
+    rows = [y for y in range(box_h) if any(alpha[y])]
+    cols = [x for x in range(box_w) if any(alpha[y][x] for y in range(box_h))]
+    if not rows:
+        return {"w": 0, "h": 0, "x": 0, "y": 0, "advance": advance, "bits": b""}
+    top, bottom, left, right = rows[0], rows[-1] + 1, cols[0], cols[-1] + 1
+    packed = bytearray()
+    for y in range(top, bottom):
+        byte, used = 0, 0
+        for x in range(left, right):
+            byte = (byte << args.bpp) | alpha[y][x]
+            used += args.bpp
+            if used == 8:
+                packed.append(byte)
+                byte, used = 0, 0
+        if used:
+            packed.append(byte << (8 - used))
+    return {"w": right - left, "h": bottom - top, "x": left, "y": top, "advance": advance, "bits": bytes(packed)}
+
+
+def write_license(font, path):
+    """The font's own license text, which has to travel with data derived from it"""
+    text = font.name(13)
+    if not text:
+        raise ValueError("the font carries no license text (name ID 13)")
+    out = ["%s, used by the glyph atlases in this directory" % (font.name(4) or "Font"), ""]
+    for paragraph in text.replace("\r\n", "\n").split("\n"):
+        out.extend(textwrap.wrap(" ".join(paragraph.split()), 78) or [""])
+    with open(path, "w") as f:
+        f.write("\n".join(out).rstrip("\n") + "\n")
+
+
+def emit(font, font_path, args, glyphs):
+    symbol = "ui_font_" + args.name
+    bitmap, table, offset = [], [], 0
+    for code, g in zip(range(args.first, args.last + 1), glyphs):
+        bitmap.append((code, g["bits"]))
+        table.append("    {%5d, %2d, %2d, %3d, %3d, %2d},   // '%s'" %
+                     (offset, g["w"], g["h"], g["x"], g["y"], g["advance"],
+                      chr(code).replace("\\", "\\\\").replace("'", "\\'")))
+        offset += len(g["bits"])
+    if offset > 0xFFFF:
+        raise ValueError("atlas over 64 KB; offsets are 16-bit")
+
+    out = []
+    out.append("/*")
+    out.append(" * UI Font: %s" % args.name)
+    out.append(" * Generated by tools/font_atlas.py from %s; do not edit" % os.path.basename(font_path))
+    out.append(" *")
+    for line in (font.name(0) or "").splitlines():
+        if line.strip():
+            out.append(" * " + line.strip())
+    if args.license:
+        out.append(" * Glyph data derived from the font; its license is in %s" % os.path.basename(args.license))
+    out.append(" *")
+    out.append(" * %d px, %d-bit alpha, %s, baseline at row %d" %
+               (args.size, args.bpp, "%dx%d cells" % (args.cell_w, args.cell_h) if args.cell_w else
+                "proportional, %d px lines" % args.cell_h, args.baseline))
+    out.append(" * tools/font_atlas.py %s" % " ".join(args.argv))
+    out.append(" */")
+    out.append("")
+    out.append('#include "ui/ui_font.h"')
+    out.append("")
+    out.append("static const uint8_t kBitmap[] = {")
+    for code, bits in bitmap:
+        if bits:
+            hexes = ", ".join("0x%02X" % b for b in bits)
+            out.append("    " + hexes + ",")
+    out.append("};")
+    out.append("")
+    out.append("static const ui_glyph_t kGlyphs[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("")
+    out.append("extern const ui_font_t %s = {" % symbol)
+    out.append("    kBitmap, kGlyphs, %d, %d, %d, %d, %d" %
+               (args.first, args.last, args.bpp, args.cell_h, args.baseline))
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Rasterize a TrueType font into a UI glyph atlas")
+    parser.add_argument("font", help="TrueType (.ttf) file")
+    parser.add_argument("--name", required=True, help="Symbol suffix: ui_font_<name>")
+    parser.add_argument("--size", type=int, required=True, help="Em size in pixels")
+    parser.add_argument("--bpp", type=int, choices=(1, 2, 4), default=4)
+    parser.add_argument("--cell", help="Fixed WxH cell, e.g. 12x16; otherwise proportional")
+    parser.add_argument("--baseline", type=int, help="Baseline row from the top of the line")
+    parser.add_argument("--first", type=int, default=32)
+    parser.add_argument("--last", type=int, default=126)
+    parser.add_argument("--license", help="Also write the font's license text to this file")
+    parser.add_argument("-o", "--output", required=True)
+    args = parser.parse_args()
+    args.argv = [a for a in sys.argv[1:] if a != args.font]
+    args.argv.insert(0, os.path.basename(args.font))
+
+    font = TrueTypeFont(args.font)
+    scale = args.size / font.units_per_em
+    if args.cell:
+        args.cell_w, args.cell_h = (int(v) for v in args.cell.lower().split("x"))
+    else:
+        args.cell_w = 0
+        args.cell_h = int(math.ceil((font.ascender - font.descender) * scale))
+    if args.baseline is None:
+        args.baseline = int(round(font.ascender * scale))
+
+    glyphs = [build_glyph(font, code, args, scale) for code in range(args.first, args.last + 1)]
+    with open(args.output, "w") as f:
+        f.write(emit(font, args.font, args, glyphs))
+    if args.license:
+        write_license(font, args.license)
+    size = sum(len(g["bits"]) for g in glyphs)
+    print("%s: %d glyphs, %d bitmap bytes" % (args.output, len(glyphs), size))
+
+
+if __name__ == "__main__":
+    main()